@@ -9,6 +9,8 @@ namespace bs
 {
 	void AnimationCurves::addPositionCurve(const String& name, const TAnimationCurve<Vector3>& curve)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(position.begin(), position.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != position.end())
@@ -19,6 +21,8 @@ namespace bs
 
 	void AnimationCurves::addRotationCurve(const String& name, const TAnimationCurve<Quaternion>& curve)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(rotation.begin(), rotation.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != rotation.end())
@@ -29,6 +33,8 @@ namespace bs
 
 	void AnimationCurves::addScaleCurve(const String& name, const TAnimationCurve<Vector3>& curve)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(scale.begin(), scale.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != scale.end())
@@ -49,6 +55,8 @@ namespace bs
 
 	void AnimationCurves::removePositionCurve(const String& name)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(position.begin(), position.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != position.end())
@@ -57,6 +65,8 @@ namespace bs
 
 	void AnimationCurves::removeRotationCurve(const String& name)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(rotation.begin(), rotation.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != rotation.end())
@@ -65,6 +75,8 @@ namespace bs
 
 	void AnimationCurves::removeScaleCurve(const String& name)
 	{
+		decompress();
+
 		auto iterFind = std::find_if(scale.begin(), scale.end(), [&](auto x) { return x.name == name; });
 
 		if (iterFind != scale.end())
@@ -79,6 +91,30 @@ namespace bs
 			generic.erase(iterFind);
 	}
 
+	void AnimationCurves::compress(UINT32 sampleRate, float tolerance)
+	{
+		decompress();
+		compressed = CompressedAnimationCurves::create(*this, sampleRate, tolerance);
+
+		for (auto& entry : position)
+			entry.curve = TAnimationCurve<Vector3>();
+
+		for (auto& entry : rotation)
+			entry.curve = TAnimationCurve<Quaternion>();
+
+		for (auto& entry : scale)
+			entry.curve = TAnimationCurve<Vector3>();
+	}
+
+	void AnimationCurves::decompress()
+	{
+		if (compressed.isEmpty())
+			return;
+
+		compressed.decompress(*this);
+		compressed = CompressedAnimationCurves();
+	}
+
 	AnimationClip::AnimationClip()
 		: Resource(false), mVersion(0), mCurves(bs_shared_ptr_new<AnimationCurves>())
 		, mRootMotion(bs_shared_ptr_new<RootMotion>()), mIsAdditive(false), mLength(0.0f), mSampleRate(1)
@@ -166,6 +202,8 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		mLength = std::max(mLength, mCurves->compressed.getLength());
 	}
 
 	void AnimationClip::buildNameMapping()
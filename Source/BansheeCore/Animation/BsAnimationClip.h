@@ -7,6 +7,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 
 namespace bs
 {
@@ -78,6 +79,64 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:RemoveGenericCurve)
 		void removeGenericCurve(const String& name);
 
+		/**
+		 * Compresses the position, rotation and scale curves. Keyframes of the compressed curves are released and the
+		 * curves will be evaluated from the compressed data instead. Curve names and flags are kept.
+		 *
+		 * @param[in]	sampleRate	Number of samples per second to sample the curves at when determining which keys can be
+		 *							removed.
+		 * @param[in]	tolerance	Maximum error allowed when removing keys. 
+		 *
+		 * @see		CompressedAnimationCurves::create
+		 */
+		void compress(UINT32 sampleRate, float tolerance);
+
+		/**
+		 * Restores the keyframes of compressed position, rotation and scale curves, and releases the compressed data.
+		 * Does nothing if the curves are not compressed. Restored curves use the keys and tangents of the compressed
+		 * curves.
+		 */
+		void decompress();
+
+		/** Checks are the position, rotation and scale curves stored in compressed form. */
+		bool isCompressed() const { return !compressed.isEmpty(); }
+
+		/**
+		 * Evaluates a position curve, from compressed data if the curves are compressed.
+		 *
+		 * @param[in]	curveIdx	Index of the curve in @p position.
+		 * @param[in]	time		Time to evaluate the curve at.
+		 * @param[in]	cache		Cached data from previous requests, used for speeding up sequential evaluations.
+		 * @param[in]	loop		If true the curve will loop when it goes past the end or beggining. Otherwise the curve
+		 *							value will be clamped.
+		 * @return					Interpolated value from the curve at provided time.
+		 */
+		Vector3 evaluatePosition(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache, bool loop) const
+		{
+			if (isCompressed())
+				return compressed.evaluatePosition(curveIdx, time, cache, loop);
+
+			return position[curveIdx].curve.evaluate(time, cache, loop);
+		}
+
+		/** @copydoc evaluatePosition */
+		Quaternion evaluateRotation(UINT32 curveIdx, float time, const TCurveCache<Quaternion>& cache, bool loop) const
+		{
+			if (isCompressed())
+				return compressed.evaluateRotation(curveIdx, time, cache, loop);
+
+			return rotation[curveIdx].curve.evaluate(time, cache, loop);
+		}
+
+		/** @copydoc evaluatePosition */
+		Vector3 evaluateScale(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache, bool loop) const
+		{
+			if (isCompressed())
+				return compressed.evaluateScale(curveIdx, time, cache, loop);
+
+			return scale[curveIdx].curve.evaluate(time, cache, loop);
+		}
+
 		/** Curves for animating scene object's position. */
 		Vector<TNamedAnimationCurve<Vector3>> position;
 
@@ -89,6 +148,12 @@ namespace bs
 
 		/** Curves for animating generic component properties. */
 		Vector<TNamedAnimationCurve<float>> generic;
+
+		/** 
+		 * Compressed data of the position, rotation and scale curves, if compress() was called. When present the curves
+		 * in @p position, @p rotation and @p scale contain no keyframes.
+		 */
+		CompressedAnimationCurves compressed;
 	};
 
 	/** Contains a set of animation curves used for moving and rotating the root bone. */
@@ -104,6 +104,9 @@ namespace bs
 		/** Returns the length of the animation curve, from time zero to last keyframe. */
 		float getLength() const { return mEnd; }
 
+		/** Returns the time range over which the curve is evaluated. Time outside of this range is looped or clamped. */
+		std::pair<float, float> getTimeRange() const { return std::make_pair(mStart, mEnd); }
+
 		/** Returns the total number of key-frames in the curve. */
 		UINT32 getNumKeyFrames() const { return (UINT32)mKeyframes.size(); }
 
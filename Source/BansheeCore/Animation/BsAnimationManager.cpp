@@ -10,6 +10,7 @@
 #include "Animation/BsMorphShapes.h"
 #include "Mesh/BsMeshData.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs
 {
@@ -88,13 +89,13 @@ namespace bs
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
 		{
-			bool isOverlayCamera = entry.second.camera->getRenderSettings()->overlayOnly;
+			bool isOverlayCamera = entry.camera->getRenderSettings()->overlayOnly;
 			if (isOverlayCamera)
 				continue;
 
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
-			mCullFrustums.push_back(entry.second.camera->getWorldFrustum());
+			mCullFrustums.push_back(entry.camera->getWorldFrustum());
 		}
 
 		// Make sure thread finishes writing all changes to the anim proxies as they will be read by the animation thread
@@ -117,13 +118,6 @@ namespace bs
 		// No need for locking, as we are sure that only postUpdate() writes to the proxy buffer, and increments the write
 		// buffer index. And it's called sequentially ensuring previous call to evaluate finishes.
 
-		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
-		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
-		}
-
 		RendererAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS - 1) % CoreThread::NUM_SYNC_BUFFERS;
@@ -131,10 +125,12 @@ namespace bs
 		
 		mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % CoreThread::NUM_SYNC_BUFFERS;
 
-		renderData.transforms.resize(totalNumBones);
-		renderData.infos.clear();
+		gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("evaluateAnimation"));
 
-		UINT32 curBoneIdx = 0;
+		// Cull the proxies and assign each visible one a range in the output transform buffer, so they can be evaluated
+		// in parallel without writing to the same memory
+		UINT32 totalNumBones = 0;
+		mEvaluatedProxies.clear();
 		for(auto& anim : mProxies)
 		{
 			if(anim->mCullEnabled)
@@ -153,163 +149,228 @@ namespace bs
 					continue;
 			}
 
-			RendererAnimationData::AnimInfo animInfo;
-			bool hasAnimInfo = false;
+			EvaluatedProxy entry;
+			entry.proxy = anim.get();
+			entry.boneStartIdx = totalNumBones;
+			entry.hasAnimInfo = false;
 
-			// Evaluate skeletal animation
 			if (anim->skeleton != nullptr)
-			{
-				UINT32 numBones = anim->skeleton->getNumBones();
+				totalNumBones += anim->skeleton->getNumBones();
 
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = curBoneIdx;
-				poseInfo.numBones = numBones;
+			mEvaluatedProxies.push_back(entry);
+		}
 
-				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-				Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
+		renderData.transforms.resize(totalNumBones);
+		renderData.infos.clear();
 
-				// Copy transforms from mapped scene objects
-				UINT32 boneTfrmIdx = 0;
-				for(UINT32 i = 0; i < anim->numSceneObjects; i++)
-				{
-					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+		// Evaluate the proxies, potentially using multiple threads
+		TaskScheduler::instance().parallelFor(0, (UINT32)mEvaluatedProxies.size(), 1, 
+			[this, &renderData, &prevRenderData](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				evaluateProxy(mEvaluatedProxies[i], renderData, prevRenderData);
+		});
 
-					if (soInfo.boneIdx == -1)
-						continue;
+		for(auto& entry : mEvaluatedProxies)
+		{
+			if (entry.hasAnimInfo)
+				renderData.infos[entry.proxy->id] = entry.animInfo;
+		}
 
-					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
-					anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
-					boneTfrmIdx++;
-				}
+		gProfilerCPU().endSample(PROFILE_SAMPLE_ID("evaluateAnimation"));
 
-				// Animate bones
-				anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+		// Increments counter and ensures all writes are recorded
+		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
+		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+	}
 
-				curBoneIdx += numBones;
-				hasAnimInfo = true;
-			}
-			else
-			{
-				RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
-				poseInfo.animId = anim->id;
-				poseInfo.startIdx = 0;
-				poseInfo.numBones = 0;
-			}
+	void AnimationManager::evaluateProxy(EvaluatedProxy& entry, RendererAnimationData& renderData, 
+		const RendererAnimationData& prevRenderData)
+	{
+		AnimationProxy* anim = entry.proxy;
+		RendererAnimationData::AnimInfo& animInfo = entry.animInfo;
 
-			// Reset mapped SO transform
-			for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
-			{
-				anim->sceneObjectPose.positions[i] = Vector3::ZERO;
-				anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
-				anim->sceneObjectPose.scales[i] = Vector3::ONE;
-			}
+		// Evaluate skeletal animation
+		if (anim->skeleton != nullptr)
+		{
+			UINT32 numBones = anim->skeleton->getNumBones();
 
-			// Update mapped scene objects
-			memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = entry.boneStartIdx;
+			poseInfo.numBones = numBones;
 
-			// Update scene object transforms
+			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
+			Matrix4* boneDst = renderData.transforms.data() + entry.boneStartIdx;
+
+			// Copy transforms from mapped scene objects
+			UINT32 boneTfrmIdx = 0;
 			for(UINT32 i = 0; i < anim->numSceneObjects; i++)
 			{
 				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-				// We already evaluated bones
-				if (soInfo.boneIdx != -1)
+				if (soInfo.boneIdx == -1)
 					continue;
 
-				if (soInfo.layerIdx == (UINT32)-1 || soInfo.stateIdx == (UINT32)-1)
-					continue;
+				boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+				anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
+				boneTfrmIdx++;
+			}
 
-				const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
-				if (state.disabled)
-					continue;
+			// Animate bones
+			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
 
+			entry.hasAnimInfo = true;
+		}
+		else
+		{
+			RendererAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
+			poseInfo.animId = anim->id;
+			poseInfo.startIdx = 0;
+			poseInfo.numBones = 0;
+		}
+
+		// Reset mapped SO transform
+		for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		{
+			anim->sceneObjectPose.positions[i] = Vector3::ZERO;
+			anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
+			anim->sceneObjectPose.scales[i] = Vector3::ONE;
+		}
+
+		// Update mapped scene objects
+		memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+
+		// Update scene object transforms
+		for(UINT32 i = 0; i < anim->numSceneObjects; i++)
+		{
+			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+
+			// We already evaluated bones
+			if (soInfo.boneIdx != -1)
+				continue;
+
+			if (soInfo.layerIdx == (UINT32)-1 || soInfo.stateIdx == (UINT32)-1)
+				continue;
+
+			const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
+			if (state.disabled)
+				continue;
+
+			{
+				UINT32 curveIdx = soInfo.curveIndices.position;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.position;
-					if (curveIdx != (UINT32)-1)
-					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
-					}
+					anim->sceneObjectPose.positions[curveIdx] = state.curves->evaluatePosition(curveIdx, state.time,
+						state.positionCaches[curveIdx], state.loop);
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.rotation;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.rotation;
-					if (curveIdx != (UINT32)-1)
-					{
-						const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-						anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.rotations[curveIdx].normalize();
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
-					}
+					anim->sceneObjectPose.rotations[curveIdx] = state.curves->evaluateRotation(curveIdx, state.time,
+						state.rotationCaches[curveIdx], state.loop);
+					anim->sceneObjectPose.rotations[curveIdx].normalize();
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
+			}
 
+			{
+				UINT32 curveIdx = soInfo.curveIndices.scale;
+				if (curveIdx != (UINT32)-1)
 				{
-					UINT32 curveIdx = soInfo.curveIndices.scale;
-					if (curveIdx != (UINT32)-1)
-					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
-						anim->sceneObjectPose.hasOverride[curveIdx] = false;
-					}
+					anim->sceneObjectPose.scales[curveIdx] = state.curves->evaluateScale(curveIdx, state.time,
+						state.scaleCaches[curveIdx], state.loop);
+					anim->sceneObjectPose.hasOverride[curveIdx] = false;
 				}
 			}
+		}
 
-			// Update generic curves
-			// Note: No blending for generic animations, just use first animation
-			if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		// Update generic curves
+		// Note: No blending for generic animations, just use first animation
+		if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
+		{
+			const AnimationState& state = anim->layers[0].states[0];
+			if (!state.disabled)
 			{
-				const AnimationState& state = anim->layers[0].states[0];
-				if (!state.disabled)
+				UINT32 numCurves = (UINT32)state.curves->generic.size();
+				for (UINT32 i = 0; i < numCurves; i++)
 				{
-					UINT32 numCurves = (UINT32)state.curves->generic.size();
-					for (UINT32 i = 0; i < numCurves; i++)
-					{
-						const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
-						anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
-					}
+					const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
+					anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
 				}
 			}
+		}
 
-			// Update morph shapes
-			if(anim->numMorphShapes > 0)
+		// Update morph shapes
+		if(anim->numMorphShapes > 0)
+		{
+			auto iterFind = prevRenderData.infos.find(anim->id);
+			if (iterFind != prevRenderData.infos.end())
+				animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+			else
+				animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
+
+			// Recalculate weights if curves are present
+			bool hasMorphCurves = false;
+			for(UINT32 i = 0; i < anim->numMorphChannels; i++)
 			{
-				auto iterFind = prevRenderData.infos.find(anim->id);
-				if (iterFind != prevRenderData.infos.end())
-					animInfo.morphShapeInfo = iterFind->second.morphShapeInfo;
+				MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
+				if(channelInfo.weightCurveIdx != (UINT32)-1)
+				{
+					channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
+					hasMorphCurves = true;
+				}
+
+				float frameWeight;
+				if (channelInfo.frameCurveIdx != (UINT32)-1)
+				{
+					frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
+					hasMorphCurves = true;
+				}
 				else
-					animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
+					frameWeight = 0.0f;
 
-				// Recalculate weights if curves are present
-				bool hasMorphCurves = false;
-				for(UINT32 i = 0; i < anim->numMorphChannels; i++)
+				if(channelInfo.shapeCount == 1)
 				{
-					MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
-					if(channelInfo.weightCurveIdx != (UINT32)-1)
-					{
-						channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
-						hasMorphCurves = true;
-					}
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
 
-					float frameWeight;
-					if (channelInfo.frameCurveIdx != (UINT32)-1)
+					// Blend between base shape and the only available frame
+					float relative = frameWeight - shapeInfo.frameWeight;
+					if (relative <= 0.0f)
 					{
-						frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
-						hasMorphCurves = true;
+						float diff = shapeInfo.frameWeight;
+						if (diff > 0.0f)
+						{
+							float t = -relative / diff;
+							shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
+						}
+						else
+							shapeInfo.finalWeight = 1.0f;
 					}
-					else
-						frameWeight = 0.0f;
-
-					if(channelInfo.shapeCount == 1)
+					else // If past the final frame we clamp
+						shapeInfo.finalWeight = 1.0f;
+				}
+				else if(channelInfo.shapeCount > 1)
+				{
+					for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
 					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
+						float prevShapeWeight;
+						if (j > 0)
+							prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
+						else
+							prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
+
+						float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
 
-						// Blend between base shape and the only available frame
 						float relative = frameWeight - shapeInfo.frameWeight;
 						if (relative <= 0.0f)
 						{
-							float diff = shapeInfo.frameWeight;
+							float diff = shapeInfo.frameWeight - prevShapeWeight;
 							if (diff > 0.0f)
 							{
 								float t = -relative / diff;
@@ -318,157 +379,121 @@ namespace bs
 							else
 								shapeInfo.finalWeight = 1.0f;
 						}
-						else // If past the final frame we clamp
-							shapeInfo.finalWeight = 1.0f;
-					}
-					else if(channelInfo.shapeCount > 1)
-					{
-						for(UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
+						else
 						{
-							float prevShapeWeight;
-							if (j > 0)
-								prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
-							else
-								prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
-
-							float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
-
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+							float diff = nextShapeWeight - shapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = relative / diff;
+								shapeInfo.finalWeight = std::min(t, 1.0f);
 							}
 							else
-							{
-								float diff = nextShapeWeight - shapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = relative / diff;
-									shapeInfo.finalWeight = std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 0.0f;
-							}
+								shapeInfo.finalWeight = 0.0f;
 						}
+					}
 
-						// Last frame
-						{
-							UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
-							MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
-							MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
+					// Last frame
+					{
+						UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
+						MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
+						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
 
-							float relative = frameWeight - shapeInfo.frameWeight;
-							if (relative <= 0.0f)
+						float relative = frameWeight - shapeInfo.frameWeight;
+						if (relative <= 0.0f)
+						{
+							float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
+							if (diff > 0.0f)
 							{
-								float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
-								if (diff > 0.0f)
-								{
-									float t = -relative / diff;
-									shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-								}
-								else
-									shapeInfo.finalWeight = 1.0f;
+								float t = -relative / diff;
+								shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
 							}
-							else // If past the final frame we clamp
+							else
 								shapeInfo.finalWeight = 1.0f;
 						}
-					}
-
-					for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
-					{
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
-						shapeInfo.finalWeight *= channelInfo.weight;
+						else // If past the final frame we clamp
+							shapeInfo.finalWeight = 1.0f;
 					}
 				}
 
-				// Generate morph shape vertices
-				if(anim->morphChannelWeightsDirty || hasMorphCurves)
+				for(UINT32 j = 0; j < channelInfo.shapeCount; j++)
 				{
-					SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
-
-					UINT8* bufferData = meshData->getData();
-					memset(bufferData, 0, meshData->getSize());
-
-					UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
-					UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
-					memset(tempData, 0, tempDataSize);
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
+					shapeInfo.finalWeight *= channelInfo.weight;
+				}
+			}
 
-					Vector3* tempNormals = (Vector3*)tempData;
-					float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
+			// Generate morph shape vertices
+			if(anim->morphChannelWeightsDirty || hasMorphCurves)
+			{
+				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
 
-					UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
-					UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
+				UINT8* bufferData = meshData->getData();
+				memset(bufferData, 0, meshData->getSize());
 
-					UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
+				UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
+				UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
+				memset(tempData, 0, tempDataSize);
 
-					for(UINT32 i = 0; i < anim->numMorphShapes; i++)
-					{
-						const MorphShapeInfo& info = anim->morphShapeInfos[i];
-						float absWeight = Math::abs(info.finalWeight);
+				Vector3* tempNormals = (Vector3*)tempData;
+				float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
 
-						if (absWeight < 0.0001f)
-							continue;
+				UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
+				UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
 
-						const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
-						UINT32 numVertices = (UINT32)morphVertices.size();
-						for(UINT32 j = 0; j < numVertices; j++)
-						{
-							const MorphVertex& vertex = morphVertices[j];
+				UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
 
-							Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
-							*destPos += vertex.deltaPosition * info.finalWeight;
+				for(UINT32 i = 0; i < anim->numMorphShapes; i++)
+				{
+					const MorphShapeInfo& info = anim->morphShapeInfos[i];
+					float absWeight = Math::abs(info.finalWeight);
 
-							tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
-							accumulatedWeight[vertex.sourceIdx] += absWeight;
-						}
-					}
+					if (absWeight < 0.0001f)
+						continue;
 
-					for(UINT32 i = 0; i < anim->numMorphVertices; i++)
+					const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
+					UINT32 numVertices = (UINT32)morphVertices.size();
+					for(UINT32 j = 0; j < numVertices; j++)
 					{
-						PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
+						const MorphVertex& vertex = morphVertices[j];
 
-						if (accumulatedWeight[i] > 0.0001f)
-						{
-							Vector3 normal = tempNormals[i] / accumulatedWeight[i];
-							normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
+						Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
+						*destPos += vertex.deltaPosition * info.finalWeight;
 
-							MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
-							destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
-						}
-						else
-						{
-							*destNrm = { 127, 127, 127, 0 };
-						}
+						tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
+						accumulatedWeight[vertex.sourceIdx] += absWeight;
 					}
+				}
 
-					bs_stack_free(tempData);
+				for(UINT32 i = 0; i < anim->numMorphVertices; i++)
+				{
+					PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
 
-					animInfo.morphShapeInfo.meshData = meshData;
+					if (accumulatedWeight[i] > 0.0001f)
+					{
+						Vector3 normal = tempNormals[i] / accumulatedWeight[i];
+						normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
 
-					animInfo.morphShapeInfo.version++;
-					anim->morphChannelWeightsDirty = false;
+						MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
+						destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
+					}
+					else
+					{
+						*destNrm = { 127, 127, 127, 0 };
+					}
 				}
 
-				hasAnimInfo = true;
+				bs_stack_free(tempData);
+
+				animInfo.morphShapeInfo.meshData = meshData;
+
+				animInfo.morphShapeInfo.version++;
+				anim->morphChannelWeightsDirty = false;
 			}
-			else
-				animInfo.morphShapeInfo.version = 1;
 
-			if (hasAnimInfo)
-				renderData.infos[anim->id] = animInfo;
+			entry.hasAnimInfo = true;
 		}
-
-		// Increments counter and ensures all writes are recorded
-		mWorkerState.store(WorkerState::DataReady, std::memory_order_release);
-		mDataReadyCount.fetch_add(1, std::memory_order_acq_rel);
+		else
+			animInfo.morphShapeInfo.version = 1;
 	}
 
 	void AnimationManager::waitUntilComplete()
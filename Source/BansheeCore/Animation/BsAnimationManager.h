@@ -110,6 +110,16 @@ namespace bs
 			DataReady
 		};
 
+		/** Information about a single animation proxy that is to be evaluated during an animation update. */
+		struct EvaluatedProxy
+		{
+			AnimationProxy* proxy;
+			UINT32 boneStartIdx; /**< First entry in RendererAnimationData::transforms the proxy will write its pose to. */
+
+			RendererAnimationData::AnimInfo animInfo;
+			bool hasAnimInfo;
+		};
+
 		/** 
 		 * Registers a new animation and returns a unique ID for it. Must be called whenever an Animation is constructed. 
 		 */
@@ -118,9 +128,20 @@ namespace bs
 		/** Unregisters an animation with the specified ID. Must be called before an Animation is destroyed. */
 		void unregisterAnimation(UINT64 id);
 
-		/** Worker method ran on the animation thread that evaluates all animation at the provided time. */
+		/** 
+		 * Worker method ran on the animation thread that evaluates all animation at the provided time. Visible proxies are
+		 * split into jobs that are evaluated in parallel on the task scheduler.
+		 */
 		void evaluateAnimation();
 
+		/** 
+		 * Evaluates a single animation proxy, writing its skeleton pose into its range of the transform buffer and its
+		 * remaining output into @p entry. Safe to call on multiple threads at once, as long as each thread operates on
+		 * a different proxy.
+		 */
+		void evaluateProxy(EvaluatedProxy& entry, RendererAnimationData& renderData, 
+			const RendererAnimationData& prevRenderData);
+
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
 		
@@ -137,6 +158,7 @@ namespace bs
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<EvaluatedProxy> mEvaluatedProxies;
 		RendererAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS];
 
 		UINT32 mPoseReadBufferIdx;
@@ -0,0 +1,816 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationCurve.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Largest value of a quantized key time, or a quantized position or scale component. */
+	static const float MAX_QUANTIZED_VALUE = 65535.0f;
+
+	/** Largest value of a quantized rotation component. Top bit is reserved for the index of the omitted component. */
+	static const float MAX_QUANTIZED_ROTATION = 32767.0f;
+
+	/** Largest possible absolute value of a component that is not the largest component in a unit quaternion. */
+	static const float MAX_SMALLEST_COMPONENT = 0.707106781f;
+
+	/** Calculates the largest difference between any component of the two values. */
+	float getCompressionError(const Vector3& a, const Vector3& b)
+	{
+		Vector3 diff = a - b;
+		return std::max(std::max(Math::abs(diff.x), Math::abs(diff.y)), Math::abs(diff.z));
+	}
+
+	float getCompressionError(const Quaternion& a, const Quaternion& b)
+	{
+		// Both quaternions represent the same rotation as their negatives
+		float error = 0.0f;
+		float negatedError = 0.0f;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			error = std::max(error, Math::abs(a[i] - b[i]));
+			negatedError = std::max(negatedError, Math::abs(a[i] + b[i]));
+		}
+
+		return std::min(error, negatedError);
+	}
+
+	/** Returns the number of float components in the value. */
+	UINT32 getNumComponents(const Vector3& value) { return 3; }
+	UINT32 getNumComponents(const Quaternion& value) { return 4; }
+
+	/**
+	 * Interpolates between two keys as a cubic Hermite spline, the same way as the compressed curves do during
+	 * evaluation.
+	 *
+	 * @param[in]	t			Interpolation factor in [0, 1] range.
+	 * @param[in]	length		Time between the two keys, in seconds.
+	 * @param[in]	a			Value of the left key.
+	 * @param[in]	tangentA	Tangent of the left key, per second.
+	 * @param[in]	b			Value of the right key.
+	 * @param[in]	tangentB	Tangent of the right key, per second.
+	 * @return					Interpolated value.
+	 */
+	Vector3 interpolateCompressed(float t, float length, const Vector3& a, const Vector3& tangentA, const Vector3& b,
+		const Vector3& tangentB)
+	{
+		return Math::cubicHermite(t, a, b, tangentA * length, tangentB * length);
+	}
+
+	Quaternion interpolateCompressed(float t, float length, const Quaternion& a, const Quaternion& tangentA,
+		const Quaternion& b, const Quaternion& tangentB)
+	{
+		// Interpolate along the shortest path, negating a quaternion also negates its tangent
+		float flip = a.dot(b) >= 0.0f ? 1.0f : -1.0f;
+
+		Quaternion output = Math::cubicHermite(t, a, flip * b, tangentA * length, tangentB * (flip * length));
+		output.normalize();
+
+		return output;
+	}
+
+	/** Value and tangent of a curve at a point in time. */
+	template<class T>
+	struct CurveSample
+	{
+		float time;
+		T value;
+		T tangent;
+	};
+
+	/**
+	 * Evaluates the value and the tangent of the curve, approaching the provided time either from the left or from the
+	 * right. The two differ at keyframes with different in and out tangents, or with a step on either side. Outside of
+	 * the keyframe range the curve is constant.
+	 */
+	template<class T>
+	void evaluateCurveSide(const Vector<TKeyframe<T>>& keyframes, float time, bool fromLeft, T& value, T& tangent)
+	{
+		auto iterRight = fromLeft ?
+			std::lower_bound(keyframes.begin(), keyframes.end(), time,
+				[](const TKeyframe<T>& key, float time) { return key.time < time; }) :
+			std::upper_bound(keyframes.begin(), keyframes.end(), time,
+				[](float time, const TKeyframe<T>& key) { return time < key.time; });
+
+		UINT32 rightIdx = (UINT32)(iterRight - keyframes.begin());
+		if (rightIdx == 0 || rightIdx == (UINT32)keyframes.size())
+		{
+			value = rightIdx == 0 ? keyframes.front().value : keyframes.back().value;
+			tangent = T(BsZero);
+			return;
+		}
+
+		const TKeyframe<T>& lhs = keyframes[rightIdx - 1];
+		const TKeyframe<T>& rhs = keyframes[rightIdx];
+
+		float length = rhs.time - lhs.time;
+		float t = (time - lhs.time) / length;
+
+		T leftTangent = lhs.outTangent * length;
+		T rightTangent = rhs.inTangent * length;
+
+		value = Math::cubicHermite(t, lhs.value, rhs.value, leftTangent, rightTangent);
+		tangent = Math::cubicHermiteD1(t, lhs.value, rhs.value, leftTangent, rightTangent) * (1.0f / length);
+
+		// Step components keep the value of the left key over the entire segment
+		for (UINT32 i = 0; i < getNumComponents(value); i++)
+		{
+			if (lhs.outTangent[i] != std::numeric_limits<float>::infinity() &&
+				rhs.inTangent[i] != std::numeric_limits<float>::infinity())
+				continue;
+
+			value[i] = lhs.value[i];
+			tangent[i] = 0.0f;
+		}
+	}
+
+	/** Checks are the two tangents equal, ignoring the precision lost when scaling them by the segment length. */
+	template<class T>
+	bool isTangentEqual(const T& a, const T& b)
+	{
+		for (UINT32 i = 0; i < getNumComponents(a); i++)
+		{
+			if (Math::abs(a[i] - b[i]) > 1e-4f * std::max(1.0f, Math::abs(a[i])))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Samples the curve at its keys and at evenly spaced times in-between. Keys at which the curve has a discontinuous
+	 * value or tangent are sampled twice, first approaching from the left and then from the right.
+	 *
+	 * @param[in]	curve		Curve to sample.
+	 * @param[in]	sampleRate	Number of evenly spaced samples per second.
+	 * @param[out]	samples		Samples sorted by time.
+	 */
+	template<class T>
+	void sampleCurve(const TAnimationCurve<T>& curve, UINT32 sampleRate, Vector<CurveSample<T>>& samples)
+	{
+		const Vector<TKeyframe<T>>& keyframes = curve.getKeyFrames();
+		std::pair<float, float> range = curve.getTimeRange();
+
+		Vector<float> times;
+		UINT32 numSamples = (UINT32)std::ceil((range.second - range.first) * sampleRate);
+		for (UINT32 i = 0; i < numSamples; i++)
+			times.push_back(range.first + i / (float)sampleRate);
+
+		for (auto& entry : keyframes)
+		{
+			if (entry.time >= range.first && entry.time <= range.second)
+				times.push_back(entry.time);
+		}
+
+		times.push_back(range.second);
+
+		std::sort(times.begin(), times.end());
+		times.erase(std::unique(times.begin(), times.end()), times.end());
+
+		UINT32 keyIdx = 0;
+		for (UINT32 i = 0; i < (UINT32)times.size(); i++)
+		{
+			CurveSample<T> sample;
+			sample.time = times[i];
+			evaluateCurveSide(keyframes, sample.time, false, sample.value, sample.tangent);
+
+			while (keyIdx < (UINT32)keyframes.size() && keyframes[keyIdx].time < sample.time)
+				keyIdx++;
+
+			// The curve is smooth in-between keyframes, and the value before the start is never evaluated
+			bool isKey = keyIdx < (UINT32)keyframes.size() && keyframes[keyIdx].time == sample.time;
+			if (i > 0 && isKey)
+			{
+				CurveSample<T> leftSample;
+				leftSample.time = sample.time;
+				evaluateCurveSide(keyframes, sample.time, true, leftSample.value, leftSample.tangent);
+
+				bool isLast = i == (UINT32)times.size() - 1;
+				if (leftSample.value != sample.value || (!isLast && !isTangentEqual(leftSample.tangent, sample.tangent)))
+					samples.push_back(leftSample);
+
+				// The curve is constant past the end, only the incoming tangent is relevant
+				if (isLast)
+					sample.tangent = leftSample.tangent;
+			}
+
+			samples.push_back(sample);
+		}
+	}
+
+	/**
+	 * Finds the smallest set of samples required for reconstructing all the other samples within the provided error
+	 * tolerance, by interpolating between the kept samples using their tangents.
+	 *
+	 * @param[in]	samples		Samples sorted by time. Samples sharing the same time are always kept.
+	 * @param[in]	tolerance	Maximum allowed difference between a sample and its reconstructed value.
+	 * @param[out]	output		Indices of the samples to keep.
+	 */
+	template<class T>
+	void reduceSamples(const Vector<CurveSample<T>>& samples, float tolerance, Vector<UINT32>& output)
+	{
+		UINT32 numSamples = (UINT32)samples.size();
+
+		output.push_back(0);
+		if (numSamples == 1)
+			return;
+
+		// Extend the segment from the last kept sample as far as possible, until one of the samples it spans can no
+		// longer be reconstructed
+		UINT32 start = 0;
+		for (UINT32 end = 1; end < numSamples; end++)
+		{
+			const CurveSample<T>& left = samples[start];
+			const CurveSample<T>& right = samples[end];
+
+			if (right.time == samples[end - 1].time)
+			{
+				if (end - 1 != start)
+					output.push_back(end - 1);
+
+				output.push_back(end);
+				start = end;
+				continue;
+			}
+
+			float length = right.time - left.time;
+			for (UINT32 i = start + 1; i < end; i++)
+			{
+				float t = (samples[i].time - left.time) / length;
+				T value = interpolateCompressed(t, length, left.value, left.tangent, right.value, right.tangent);
+
+				if (getCompressionError(value, samples[i].value) > tolerance)
+				{
+					start = end - 1;
+					output.push_back(start);
+					break;
+				}
+			}
+		}
+
+		// Constant curves only need a single key
+		if (output.size() == 1)
+		{
+			bool isConstant = true;
+			for (UINT32 i = 1; i < numSamples; i++)
+				isConstant &= getCompressionError(samples[0].value, samples[i].value) <= tolerance;
+
+			if (isConstant)
+				return;
+		}
+
+		if (output.back() != numSamples - 1)
+			output.push_back(numSamples - 1);
+	}
+
+	/** Quantizes the time to the [0, 65535] range over the time range of the curve. */
+	UINT16 quantizeKeyTime(float time, const CompressedAnimationCurveInfo& info)
+	{
+		float length = info.end - info.start;
+		if (length <= 0.0f)
+			return 0;
+
+		return (UINT16)Math::clamp(Math::round((time - info.start) / length * MAX_QUANTIZED_VALUE), 0.0f,
+			MAX_QUANTIZED_VALUE);
+	}
+
+	/** Returns the time in seconds between two neighbouring quantized key times. */
+	float getKeyTimeStep(const CompressedAnimationCurveInfo& info)
+	{
+		return (info.end - info.start) / MAX_QUANTIZED_VALUE;
+	}
+
+	/** Finds the start and the step of the range the values need to be quantized over. */
+	void getQuantizationRange(const Vector<Vector3>& values, Vector3& rangeStart, Vector3& rangeStep)
+	{
+		Vector3 min = values[0];
+		Vector3 max = values[0];
+		for (auto& entry : values)
+		{
+			min = Vector3::min(min, entry);
+			max = Vector3::max(max, entry);
+		}
+
+		rangeStart = min;
+		rangeStep = (max - min) / MAX_QUANTIZED_VALUE;
+	}
+
+	/** Quantizes each component of the value over the range starting at @p rangeStart. */
+	void quantizeRange(const Vector3& value, const Vector3& rangeStart, const Vector3& rangeStep, UINT16 (&output)[3])
+	{
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			float quantized = 0.0f;
+			if (rangeStep[i] > 0.0f)
+				quantized = Math::round((value[i] - rangeStart[i]) / rangeStep[i]);
+
+			output[i] = (UINT16)Math::clamp(quantized, 0.0f, MAX_QUANTIZED_VALUE);
+		}
+	}
+
+	/** Decodes a value quantized with quantizeRange(). */
+	Vector3 dequantizeRange(const UINT16 (&input)[3], const Vector3& rangeStart, const Vector3& rangeStep)
+	{
+		return Vector3(
+			rangeStart.x + input[0] * rangeStep.x,
+			rangeStart.y + input[1] * rangeStep.y,
+			rangeStart.z + input[2] * rangeStep.z);
+	}
+
+	/** Decodes a position or scale key value. */
+	Vector3 decodeVectorKey(const CompressedAnimationCurveInfo& info, const CompressedAnimationKey& key)
+	{
+		return dequantizeRange(key.value, info.rangeStart, info.rangeStep);
+	}
+
+	/** Decodes a position or scale key tangent. */
+	Vector3 decodeVectorTangent(const CompressedAnimationCurveInfo& info, const CompressedAnimationKey& key)
+	{
+		return dequantizeRange(key.tangent, info.tangentRangeStart, info.tangentRangeStep);
+	}
+
+	/** Returns the index of the largest component of a quaternion, the one omitted when encoding it. */
+	UINT32 getLargestComponent(const Quaternion& value)
+	{
+		UINT32 largestIdx = 0;
+		for (UINT32 i = 1; i < 4; i++)
+		{
+			if (Math::abs(value[i]) > Math::abs(value[largestIdx]))
+				largestIdx = i;
+		}
+
+		return largestIdx;
+	}
+
+	/** Encodes a unit quaternion using its three smallest components. */
+	void encodeRotationKey(const Quaternion& value, CompressedAnimationKey& key)
+	{
+		UINT32 largestIdx = getLargestComponent(value);
+
+		// Make the omitted component positive, so it can be reconstructed from the other three
+		float sign = value[largestIdx] < 0.0f ? -1.0f : 1.0f;
+
+		UINT32 outputIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			float normalized = (value[i] * sign + MAX_SMALLEST_COMPONENT) / (2.0f * MAX_SMALLEST_COMPONENT);
+			key.value[outputIdx++] = (UINT16)Math::clamp(Math::round(normalized * MAX_QUANTIZED_ROTATION), 0.0f,
+				MAX_QUANTIZED_ROTATION);
+		}
+
+		key.value[0] |= (largestIdx & 0x1) << 15;
+		key.value[1] |= (largestIdx >> 1) << 15;
+	}
+
+	/**
+	 * Returns the tangent components stored for a rotation key, matching the components stored by encodeRotationKey().
+	 * The tangent is negated along with the value if the value's largest component is negative.
+	 */
+	Vector3 getRotationKeyTangent(const Quaternion& value, const Quaternion& tangent)
+	{
+		UINT32 largestIdx = getLargestComponent(value);
+		float sign = value[largestIdx] < 0.0f ? -1.0f : 1.0f;
+
+		Vector3 output;
+		UINT32 outputIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i != largestIdx)
+				output[outputIdx++] = tangent[i] * sign;
+		}
+
+		return output;
+	}
+
+	/** Decodes a rotation encoded with encodeRotationKey(). */
+	Quaternion decodeRotationKey(const CompressedAnimationKey& key)
+	{
+		UINT32 largestIdx = (key.value[0] >> 15) | ((key.value[1] >> 15) << 1);
+
+		Quaternion output;
+		float sqrdSum = 0.0f;
+
+		UINT32 inputIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			float normalized = (key.value[inputIdx++] & 0x7FFF) / MAX_QUANTIZED_ROTATION;
+			output[i] = normalized * (2.0f * MAX_SMALLEST_COMPONENT) - MAX_SMALLEST_COMPONENT;
+
+			sqrdSum += output[i] * output[i];
+		}
+
+		output[largestIdx] = Math::sqrt(std::max(0.0f, 1.0f - sqrdSum));
+		return output;
+	}
+
+	/** Decodes the tangent of a rotation key whose value, as returned by decodeRotationKey(), is @p value. */
+	Quaternion decodeRotationTangent(const CompressedAnimationCurveInfo& info, const CompressedAnimationKey& key,
+		const Quaternion& value)
+	{
+		UINT32 largestIdx = (key.value[0] >> 15) | ((key.value[1] >> 15) << 1);
+		Vector3 storedTangent = dequantizeRange(key.tangent, info.tangentRangeStart, info.tangentRangeStep);
+
+		Quaternion output;
+		float dot = 0.0f;
+
+		UINT32 inputIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			output[i] = storedTangent[inputIdx++];
+			dot += output[i] * value[i];
+		}
+
+		// Tangent of a unit quaternion curve is perpendicular to the quaternion. The largest component is at least 0.5.
+		output[largestIdx] = -dot / value[largestIdx];
+		return output;
+	}
+
+	/** Returns the time of the key, in the same units as the source curve. */
+	float decodeKeyTime(const CompressedAnimationCurveInfo& info, const CompressedAnimationKey& key)
+	{
+		return info.start + key.time * getKeyTimeStep(info);
+	}
+
+	/**
+	 * Returns a factor in [0, 1] range determining how much to interpolate between the two keys. Keys at the same time
+	 * are only interpolated between when clamping to the end of the curve, in which case the right key is used.
+	 */
+	float getKeyInterpolationFactor(const CompressedAnimationKey& left, const CompressedAnimationKey& right, float time)
+	{
+		float length = (float)(right.time - left.time);
+		if (length <= 0.0f)
+			return 1.0f;
+
+		return Math::clamp01((time - left.time) / length);
+	}
+
+	/** Creates the curve information for a curve, without any keys. */
+	template<class T>
+	CompressedAnimationCurveInfo createCurveInfo(const TAnimationCurve<T>& curve, UINT32 firstKey)
+	{
+		std::pair<float, float> range = curve.getTimeRange();
+
+		CompressedAnimationCurveInfo info;
+		info.firstKey = firstKey;
+		info.numKeys = 0;
+		info.start = range.first;
+		info.end = range.second;
+		info.rangeStart = Vector3::ZERO;
+		info.rangeStep = Vector3::ZERO;
+		info.tangentRangeStart = Vector3::ZERO;
+		info.tangentRangeStep = Vector3::ZERO;
+
+		return info;
+	}
+
+	/** Compresses a single position or scale curve and appends its keys to @p keys. */
+	CompressedAnimationCurveInfo compressVectorCurve(const TAnimationCurve<Vector3>& curve, UINT32 sampleRate,
+		float tolerance, Vector<CompressedAnimationKey>& keys)
+	{
+		CompressedAnimationCurveInfo info = createCurveInfo(curve, (UINT32)keys.size());
+		if (curve.getNumKeyFrames() == 0)
+			return info;
+
+		Vector<CurveSample<Vector3>> samples;
+		sampleCurve(curve, sampleRate, samples);
+
+		Vector<UINT32> keptSamples;
+		reduceSamples(samples, tolerance, keptSamples);
+
+		Vector<Vector3> values;
+		Vector<Vector3> tangents;
+		for (auto& entry : keptSamples)
+		{
+			values.push_back(samples[entry].value);
+			tangents.push_back(samples[entry].tangent);
+		}
+
+		info.numKeys = (UINT32)keptSamples.size();
+		getQuantizationRange(values, info.rangeStart, info.rangeStep);
+		getQuantizationRange(tangents, info.tangentRangeStart, info.tangentRangeStep);
+
+		for (UINT32 i = 0; i < info.numKeys; i++)
+		{
+			CompressedAnimationKey key;
+			key.time = quantizeKeyTime(samples[keptSamples[i]].time, info);
+			quantizeRange(values[i], info.rangeStart, info.rangeStep, key.value);
+			quantizeRange(tangents[i], info.tangentRangeStart, info.tangentRangeStep, key.tangent);
+
+			keys.push_back(key);
+		}
+
+		return info;
+	}
+
+	/** Compresses a single rotation curve and appends its keys to @p keys. */
+	CompressedAnimationCurveInfo compressRotationCurve(const TAnimationCurve<Quaternion>& curve, UINT32 sampleRate,
+		float tolerance, Vector<CompressedAnimationKey>& keys)
+	{
+		CompressedAnimationCurveInfo info = createCurveInfo(curve, (UINT32)keys.size());
+		if (curve.getNumKeyFrames() == 0)
+			return info;
+
+		Vector<CurveSample<Quaternion>> samples;
+		sampleCurve(curve, sampleRate, samples);
+
+		// Compress the normalized curve, whose tangent is the part of the source tangent perpendicular to the value
+		for (auto& entry : samples)
+		{
+			float length = entry.value.normalize();
+			if (length > 0.0f)
+				entry.tangent = (entry.tangent - entry.value * entry.value.dot(entry.tangent)) * (1.0f / length);
+		}
+
+		Vector<UINT32> keptSamples;
+		reduceSamples(samples, tolerance, keptSamples);
+
+		Vector<Vector3> tangents;
+		for (auto& entry : keptSamples)
+			tangents.push_back(getRotationKeyTangent(samples[entry].value, samples[entry].tangent));
+
+		info.numKeys = (UINT32)keptSamples.size();
+		getQuantizationRange(tangents, info.tangentRangeStart, info.tangentRangeStep);
+
+		for (UINT32 i = 0; i < info.numKeys; i++)
+		{
+			CompressedAnimationKey key;
+			key.time = quantizeKeyTime(samples[keptSamples[i]].time, info);
+			encodeRotationKey(samples[keptSamples[i]].value, key);
+			quantizeRange(tangents[i], info.tangentRangeStart, info.tangentRangeStep, key.tangent);
+
+			keys.push_back(key);
+		}
+
+		return info;
+	}
+
+	/**
+	 * Creates keyframes from decoded compressed keys. Keys stored twice at the same time are merged into a single
+	 * keyframe, with step tangents for the components whose value changes at the key.
+	 */
+	template<class T>
+	Vector<TKeyframe<T>> createKeyframes(const Vector<float>& times, const Vector<T>& values, const Vector<T>& tangents)
+	{
+		UINT32 numKeys = (UINT32)values.size();
+
+		Vector<TKeyframe<T>> output;
+		for (UINT32 i = 0; i < numKeys; i++)
+		{
+			TKeyframe<T> keyframe;
+			keyframe.time = times[i];
+			keyframe.value = values[i];
+			keyframe.inTangent = tangents[i];
+			keyframe.outTangent = tangents[i];
+
+			if ((i + 1) < numKeys && times[i + 1] == times[i])
+			{
+				keyframe.value = values[i + 1];
+				keyframe.outTangent = tangents[i + 1];
+
+				for (UINT32 j = 0; j < getNumComponents(keyframe.value); j++)
+				{
+					if (values[i][j] != values[i + 1][j])
+						keyframe.inTangent[j] = std::numeric_limits<float>::infinity();
+				}
+
+				i++;
+			}
+
+			output.push_back(keyframe);
+		}
+
+		return output;
+	}
+
+	const UINT32 CompressedAnimationCurves::CACHE_LOOKAHEAD = 3;
+
+	CompressedAnimationCurves CompressedAnimationCurves::create(const AnimationCurves& curves, UINT32 sampleRate,
+		float tolerance)
+	{
+		CompressedAnimationCurves output;
+		sampleRate = std::max(sampleRate, 1U);
+
+		for (auto& entry : curves.position)
+			output.mPositionInfos.push_back(compressVectorCurve(entry.curve, sampleRate, tolerance, output.mKeys));
+
+		for (auto& entry : curves.rotation)
+			output.mRotationInfos.push_back(compressRotationCurve(entry.curve, sampleRate, tolerance, output.mKeys));
+
+		for (auto& entry : curves.scale)
+			output.mScaleInfos.push_back(compressVectorCurve(entry.curve, sampleRate, tolerance, output.mKeys));
+
+		return output;
+	}
+
+	Vector3 CompressedAnimationCurves::evaluatePosition(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache,
+		bool loop) const
+	{
+		return evaluateVector(mPositionInfos[curveIdx], time, cache, loop);
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateScale(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache,
+		bool loop) const
+	{
+		return evaluateVector(mScaleInfos[curveIdx], time, cache, loop);
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(UINT32 curveIdx, float time,
+		const TCurveCache<Quaternion>& cache, bool loop) const
+	{
+		const CompressedAnimationCurveInfo& info = mRotationInfos[curveIdx];
+		if (info.numKeys == 0)
+			return Quaternion(BsZero);
+
+		const CompressedAnimationKey* keys = &mKeys[info.firstKey];
+		if (info.numKeys == 1)
+			return decodeRotationKey(keys[0]);
+
+		float keyTime = toKeyTime(info, time, loop);
+		UINT32 leftKeyIdx = findKey(keys, info.numKeys, keyTime, cache.cachedKey);
+
+		const CompressedAnimationKey& leftKey = keys[leftKeyIdx];
+		const CompressedAnimationKey& rightKey = keys[leftKeyIdx + 1];
+
+		float t = getKeyInterpolationFactor(leftKey, rightKey, keyTime);
+		float length = (rightKey.time - leftKey.time) * getKeyTimeStep(info);
+
+		Quaternion leftValue = decodeRotationKey(leftKey);
+		Quaternion rightValue = decodeRotationKey(rightKey);
+
+		return interpolateCompressed(t, length, leftValue, decodeRotationTangent(info, leftKey, leftValue), rightValue,
+			decodeRotationTangent(info, rightKey, rightValue));
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateVector(const CompressedAnimationCurveInfo& info, float time,
+		const TCurveCache<Vector3>& cache, bool loop) const
+	{
+		if (info.numKeys == 0)
+			return Vector3::ZERO;
+
+		const CompressedAnimationKey* keys = &mKeys[info.firstKey];
+		if (info.numKeys == 1)
+			return decodeVectorKey(info, keys[0]);
+
+		float keyTime = toKeyTime(info, time, loop);
+		UINT32 leftKeyIdx = findKey(keys, info.numKeys, keyTime, cache.cachedKey);
+
+		const CompressedAnimationKey& leftKey = keys[leftKeyIdx];
+		const CompressedAnimationKey& rightKey = keys[leftKeyIdx + 1];
+
+		float t = getKeyInterpolationFactor(leftKey, rightKey, keyTime);
+		float length = (rightKey.time - leftKey.time) * getKeyTimeStep(info);
+
+		return interpolateCompressed(t, length, decodeVectorKey(info, leftKey), decodeVectorTangent(info, leftKey),
+			decodeVectorKey(info, rightKey), decodeVectorTangent(info, rightKey));
+	}
+
+	void CompressedAnimationCurves::decompress(AnimationCurves& curves) const
+	{
+		auto decompressVectorCurves = [&](const Vector<CompressedAnimationCurveInfo>& infos,
+			Vector<TNamedAnimationCurve<Vector3>>& output)
+		{
+			UINT32 numCurves = std::min((UINT32)infos.size(), (UINT32)output.size());
+			for (UINT32 i = 0; i < numCurves; i++)
+			{
+				const CompressedAnimationCurveInfo& info = infos[i];
+
+				Vector<float> times(info.numKeys);
+				Vector<Vector3> values(info.numKeys);
+				Vector<Vector3> tangents(info.numKeys);
+				for (UINT32 j = 0; j < info.numKeys; j++)
+				{
+					const CompressedAnimationKey& key = mKeys[info.firstKey + j];
+
+					times[j] = decodeKeyTime(info, key);
+					values[j] = decodeVectorKey(info, key);
+					tangents[j] = decodeVectorTangent(info, key);
+				}
+
+				output[i].curve = TAnimationCurve<Vector3>(createKeyframes(times, values, tangents));
+			}
+		};
+
+		decompressVectorCurves(mPositionInfos, curves.position);
+		decompressVectorCurves(mScaleInfos, curves.scale);
+
+		UINT32 numCurves = std::min((UINT32)mRotationInfos.size(), (UINT32)curves.rotation.size());
+		for (UINT32 i = 0; i < numCurves; i++)
+		{
+			const CompressedAnimationCurveInfo& info = mRotationInfos[i];
+
+			Vector<float> times(info.numKeys);
+			Vector<Quaternion> values(info.numKeys);
+			Vector<Quaternion> tangents(info.numKeys);
+			for (UINT32 j = 0; j < info.numKeys; j++)
+			{
+				const CompressedAnimationKey& key = mKeys[info.firstKey + j];
+
+				times[j] = decodeKeyTime(info, key);
+				values[j] = decodeRotationKey(key);
+				tangents[j] = decodeRotationTangent(info, key, values[j]);
+
+				// Keep neighbouring keys in the same hemisphere, so interpolation takes the shortest path
+				if (j > 0 && values[j].dot(values[j - 1]) < 0.0f)
+				{
+					values[j] = -values[j];
+					tangents[j] = -tangents[j];
+				}
+			}
+
+			curves.rotation[i].curve = TAnimationCurve<Quaternion>(createKeyframes(times, values, tangents));
+		}
+	}
+
+	float CompressedAnimationCurves::getLength() const
+	{
+		float length = 0.0f;
+
+		for (auto& entry : mPositionInfos)
+			length = std::max(length, entry.end);
+
+		for (auto& entry : mRotationInfos)
+			length = std::max(length, entry.end);
+
+		for (auto& entry : mScaleInfos)
+			length = std::max(length, entry.end);
+
+		return length;
+	}
+
+	UINT32 CompressedAnimationCurves::getMemorySize() const
+	{
+		UINT32 numInfos = (UINT32)(mPositionInfos.size() + mRotationInfos.size() + mScaleInfos.size());
+
+		return numInfos * sizeof(CompressedAnimationCurveInfo) + (UINT32)mKeys.size() * sizeof(CompressedAnimationKey);
+	}
+
+	float CompressedAnimationCurves::toKeyTime(const CompressedAnimationCurveInfo& info, float time, bool loop)
+	{
+		float length = info.end - info.start;
+		if (length <= 0.0f)
+			return 0.0f;
+
+		// Same wrapping as TAnimationCurve::evaluate
+		AnimationUtility::wrapTime(time, info.start, info.end, loop);
+
+		return Math::clamp((time - info.start) * (MAX_QUANTIZED_VALUE / length), 0.0f, MAX_QUANTIZED_VALUE);
+	}
+
+	UINT32 CompressedAnimationCurves::findKey(const CompressedAnimationKey* keys, UINT32 numKeys, float time,
+		UINT32& cachedKey)
+	{
+		UINT32 lastKey = numKeys - 2;
+
+		// Check nearby keys first if there is cached data
+		UINT32 key = cachedKey;
+		if (key <= lastKey && time >= keys[key].time)
+		{
+			UINT32 end = std::min(lastKey, key + CACHE_LOOKAHEAD);
+			while (key < end && time >= keys[key + 1].time)
+				key++;
+
+			if (key == lastKey || time < keys[key + 1].time)
+			{
+				cachedKey = key;
+				return key;
+			}
+		}
+
+		// Cannot find nearby ones, search all keys
+		INT32 start = 0;
+		INT32 searchLength = (INT32)numKeys;
+
+		while (searchLength > 0)
+		{
+			INT32 half = searchLength >> 1;
+			INT32 mid = start + half;
+
+			if (time < keys[mid].time)
+			{
+				searchLength = half;
+			}
+			else
+			{
+				start = mid + 1;
+				searchLength -= (half + 1);
+			}
+		}
+
+		key = std::min((UINT32)std::max(0, start - 1), lastKey);
+		cachedKey = key;
+
+		return key;
+	}
+}
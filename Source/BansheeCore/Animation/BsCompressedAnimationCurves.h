@@ -0,0 +1,146 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Animation/BsCurveCache.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	struct AnimationCurves;
+
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/** Single keyframe of a compressed animation curve. */
+	struct CompressedAnimationKey
+	{
+		/** Time of the key, quantized to [0, 65535] range over the length of the curve. */
+		UINT16 time;
+
+		/**
+		 * Quantized value of the key. For position and scale curves each component is quantized over the value range of
+		 * the curve. For rotation curves contains the three smallest quaternion components, with the index of the omitted
+		 * (largest) component stored in the top bits of the first two values.
+		 */
+		UINT16 value[3];
+
+		/**
+		 * Quantized tangent of the curve at the key, in value units per second. Each component is quantized over the
+		 * tangent range of the curve. For rotation curves contains the tangents of the three stored quaternion
+		 * components. The tangent of the omitted component is reconstructed from the other three, since the tangent of a
+		 * unit quaternion curve is perpendicular to the quaternion.
+		 */
+		UINT16 tangent[3];
+	};
+
+	/** Information about a single curve stored in CompressedAnimationCurves. */
+	struct CompressedAnimationCurveInfo
+	{
+		UINT32 firstKey; /**< Index of the first key of the curve. */
+		UINT32 numKeys; /**< Number of keys in the curve. */
+		float start; /**< Time at which the curve starts, and which key time 0 maps to. */
+		float end; /**< Time at which the curve ends, and which key time 65535 maps to. */
+		Vector3 rangeStart; /**< Minimum value of the curve. Not used for rotation curves. */
+		Vector3 rangeStep; /**< Difference in value between two neighbouring quantized values. Not used for rotation curves. */
+		Vector3 tangentRangeStart; /**< Minimum value of each stored tangent component. */
+		Vector3 tangentRangeStep; /**< Difference in value between two neighbouring quantized tangent components. */
+	};
+
+	/**
+	 * Stores position, rotation and scale animation curves in a compact form. Keys that can be reconstructed from their
+	 * neighbours within an error tolerance are removed, and the remaining keys are quantized to 16 bits per component.
+	 * Rotations are stored using their three smallest components. Each key also stores the curve tangent, and values
+	 * in-between keys are evaluated as cubic Hermite splines, the same as TAnimationCurve (normalized for rotations).
+	 * Keys at which the source curve has a discontinuous tangent or a step are stored twice at the same time, first with
+	 * the incoming and then with the outgoing value and tangent.
+	 *
+	 * Curves are stored in the same order as in the AnimationCurves object they were created from, meaning the same curve
+	 * indices and curve caches can be used with both.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves
+	{
+	public:
+		/**
+		 * Compresses the position, rotation and scale curves in the provided curve set. Generic curves are ignored.
+		 *
+		 * @param[in]	curves		Curves to compress.
+		 * @param[in]	sampleRate	Number of samples per second to sample the curves at when determining which keys can be
+		 *							removed. Should be at least the rate at which the animation was authored.
+		 * @param[in]	tolerance	Maximum error allowed when removing keys. In units of the curve value for position and
+		 *							scale curves, and in units of quaternion components for rotation curves (approximately
+		 *							half of the angular error, in radians).
+		 * @return					Compressed curves.
+		 */
+		static CompressedAnimationCurves create(const AnimationCurves& curves, UINT32 sampleRate, float tolerance);
+
+		/**
+		 * Evaluates a compressed position curve.
+		 *
+		 * @param[in]	curveIdx	Index of the curve to evaluate.
+		 * @param[in]	time		Time to evaluate the curve at.
+		 * @param[in]	cache		Cached data from previous requests, used for speeding up sequential evaluations.
+		 * @param[in]	loop		If true the curve will loop when it goes past the end or beggining. Otherwise the curve
+		 *							value will be clamped.
+		 * @return					Interpolated value from the curve at provided time.
+		 */
+		Vector3 evaluatePosition(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache, bool loop = true) const;
+
+		/** @copydoc evaluatePosition */
+		Quaternion evaluateRotation(UINT32 curveIdx, float time, const TCurveCache<Quaternion>& cache,
+			bool loop = true) const;
+
+		/** @copydoc evaluatePosition */
+		Vector3 evaluateScale(UINT32 curveIdx, float time, const TCurveCache<Vector3>& cache, bool loop = true) const;
+
+		/**
+		 * Restores the keyframes of the curves in the provided curve set from the compressed data. The curve set must
+		 * contain the same curves as the set the data was compressed from. Keys stored twice are merged into a single
+		 * keyframe, using step tangents for components whose value changes at the key.
+		 */
+		void decompress(AnimationCurves& curves) const;
+
+		/** Returns the length of the longest compressed curve. */
+		float getLength() const;
+
+		/** Returns the number of bytes used for storing the compressed curves. */
+		UINT32 getMemorySize() const;
+
+		/** Checks does the object contain any compressed curves. */
+		bool isEmpty() const { return mPositionInfos.empty() && mRotationInfos.empty() && mScaleInfos.empty(); }
+
+	private:
+		friend struct RTTIPlainType<CompressedAnimationCurves>;
+
+		/** Evaluates a position or a scale curve. */
+		Vector3 evaluateVector(const CompressedAnimationCurveInfo& info, float time, const TCurveCache<Vector3>& cache,
+			bool loop) const;
+
+		/**
+		 * Finds the key to interpolate from, so that the key at the next index can be used as the key to interpolate to.
+		 * Keys near the key from the previous call are checked first.
+		 *
+		 * @param[in]		keys		Keys of the curve to search.
+		 * @param[in]		numKeys		Number of keys in the curve. Must be at least two.
+		 * @param[in]		time		Time to search for, in the quantized key time range.
+		 * @param[in, out]	cachedKey	Key found by the previous call, or -1 if none. Updated with the found key.
+		 * @return						Index of the key to interpolate from.
+		 */
+		static UINT32 findKey(const CompressedAnimationKey* keys, UINT32 numKeys, float time, UINT32& cachedKey);
+
+		/** Converts the curve time into the quantized time range used by the keys. */
+		static float toKeyTime(const CompressedAnimationCurveInfo& info, float time, bool loop);
+
+		static const UINT32 CACHE_LOOKAHEAD;
+
+		Vector<CompressedAnimationCurveInfo> mPositionInfos;
+		Vector<CompressedAnimationCurveInfo> mRotationInfos;
+		Vector<CompressedAnimationCurveInfo> mScaleInfos;
+		Vector<CompressedAnimationKey> mKeys;
+	};
+
+	/** @} */
+}
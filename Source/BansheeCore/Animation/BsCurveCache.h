@@ -6,6 +6,8 @@
 
 namespace bs
 {
+	class CompressedAnimationCurves;
+
 	/** @addtogroup Animation-Internal
 	 *  @{
 	 */
@@ -25,6 +27,7 @@ namespace bs
 
 	private:
 		friend class TAnimationCurve<T>;
+		friend class CompressedAnimationCurves;
 
 		mutable UINT32 cachedKey; /**< Left-most key the curve was last evaluated at. -1 if no cached data. */
 		mutable float cachedCurveStart; /**< Time relative to the animation curve, at which the cached data starts. */
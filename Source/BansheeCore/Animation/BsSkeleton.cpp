@@ -5,6 +5,10 @@
 #include "Animation/BsSkeletonMask.h"
 #include "RTTI/BsSkeletonRTTI.h"
 
+#if BS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace bs
 {
 	LocalSkeletonPose::LocalSkeletonPose()
@@ -84,6 +88,433 @@ namespace bs
 		return *this;
 	}
 
+	/** Number of bones processed at once by the vectorized pose evaluation code. */
+	static const UINT32 POSE_GROUP_SIZE = 4;
+
+	/** 
+	 * Local translation, rotation and scale of all bones in a skeleton, stored in structure-of-arrays form so that
+	 * multiple bones can be processed at once. Each array holds one component for every bone.
+	 */
+	struct PoseStreams
+	{
+		float* position[3];
+		float* rotation[4]; // x, y, z, w
+		float* scale[3];
+	};
+
+	/** 
+	 * Per-bone weights of a single animation state. Zero for bones that aren't animated by the state, or are disabled
+	 * by the skeleton mask.
+	 */
+	struct PoseWeights
+	{
+		float* position;
+		float* rotation;
+		float* scale;
+	};
+
+	/** Number of float arrays required for the accumulated pose, a sampled pose and pose weights. */
+	static const UINT32 POSE_NUM_STREAMS = 10 + 10 + 3;
+
+	/** Assigns @p numLanes long arrays from the provided buffer to all the pose streams. Returns the remaining buffer. */
+	static float* assignPoseStreams(PoseStreams& streams, float* buffer, UINT32 numLanes)
+	{
+		for (UINT32 i = 0; i < 3; i++, buffer += numLanes)
+			streams.position[i] = buffer;
+
+		for (UINT32 i = 0; i < 4; i++, buffer += numLanes)
+			streams.rotation[i] = buffer;
+
+		for (UINT32 i = 0; i < 3; i++, buffer += numLanes)
+			streams.scale[i] = buffer;
+
+		return buffer;
+	}
+
+	/** Accumulates weighted sampled positions into the pose. */
+	static void blendPositions(const PoseStreams& pose, const PoseStreams& sample, const PoseWeights& weights, UINT32 numLanes)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		for (; i < numLanes; i += POSE_GROUP_SIZE)
+		{
+			__m128 weight = _mm_loadu_ps(weights.position + i);
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				__m128 value = _mm_mul_ps(_mm_loadu_ps(sample.position[j] + i), weight);
+				_mm_storeu_ps(pose.position[j] + i, _mm_add_ps(_mm_loadu_ps(pose.position[j] + i), value));
+			}
+		}
+#endif
+
+		for (; i < numLanes; i++)
+		{
+			for (UINT32 j = 0; j < 3; j++)
+				pose.position[j][i] += sample.position[j][i] * weights.position[i];
+		}
+	}
+
+	/** Multiplies the pose scale with weighted sampled scale, for every bone with a non-zero weight. */
+	static void blendScales(const PoseStreams& pose, const PoseStreams& sample, const PoseWeights& weights, UINT32 numLanes)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < numLanes; i += POSE_GROUP_SIZE)
+		{
+			__m128 weight = _mm_loadu_ps(weights.scale + i);
+			__m128 isAnimated = _mm_cmpneq_ps(weight, _mm_setzero_ps());
+
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				__m128 value = _mm_mul_ps(_mm_loadu_ps(sample.scale[j] + i), weight);
+				value = _mm_or_ps(_mm_and_ps(isAnimated, value), _mm_andnot_ps(isAnimated, one));
+
+				_mm_storeu_ps(pose.scale[j] + i, _mm_mul_ps(_mm_loadu_ps(pose.scale[j] + i), value));
+			}
+		}
+#endif
+
+		for (; i < numLanes; i++)
+		{
+			if (weights.scale[i] == 0.0f)
+				continue;
+
+			for (UINT32 j = 0; j < 3; j++)
+				pose.scale[j][i] *= sample.scale[j][i] * weights.scale[i];
+		}
+	}
+
+	/** 
+	 * Accumulates weighted sampled rotations into the pose. Sampled rotations are flipped if required so they lie in the
+	 * same hemisphere as the accumulated rotation. Result is not normalized.
+	 */
+	static void blendRotations(const PoseStreams& pose, const PoseStreams& sample, const PoseWeights& weights, UINT32 numLanes)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		for (; i < numLanes; i += POSE_GROUP_SIZE)
+		{
+			__m128 weight = _mm_loadu_ps(weights.rotation + i);
+
+			__m128 value[4];
+			__m128 current[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				value[j] = _mm_mul_ps(_mm_loadu_ps(sample.rotation[j] + i), weight);
+				current[j] = _mm_loadu_ps(pose.rotation[j] + i);
+			}
+
+			__m128 dot = _mm_mul_ps(value[3], current[3]);
+			for (UINT32 j = 0; j < 3; j++)
+				dot = _mm_add_ps(dot, _mm_mul_ps(value[j], current[j]));
+
+			__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signBit);
+			for (UINT32 j = 0; j < 4; j++)
+				_mm_storeu_ps(pose.rotation[j] + i, _mm_add_ps(current[j], _mm_xor_ps(value[j], flip)));
+		}
+#endif
+
+		for (; i < numLanes; i++)
+		{
+			Quaternion value(
+				sample.rotation[3][i] * weights.rotation[i], 
+				sample.rotation[0][i] * weights.rotation[i],
+				sample.rotation[1][i] * weights.rotation[i],
+				sample.rotation[2][i] * weights.rotation[i]);
+
+			Quaternion current(pose.rotation[3][i], pose.rotation[0][i], pose.rotation[1][i], pose.rotation[2][i]);
+
+			if (value.dot(current) < 0.0f)
+				value = -value;
+
+			current += value;
+
+			pose.rotation[0][i] = current.x;
+			pose.rotation[1][i] = current.y;
+			pose.rotation[2][i] = current.z;
+			pose.rotation[3][i] = current.w;
+		}
+	}
+
+#if BS_SSE2
+	/** Normalizes four quaternions at once. */
+	static void normalize4(__m128 (&q)[4])
+	{
+		__m128 length = _mm_mul_ps(q[3], q[3]);
+		for (UINT32 j = 0; j < 3; j++)
+			length = _mm_add_ps(length, _mm_mul_ps(q[j], q[j]));
+
+		__m128 factor = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(length));
+		for (UINT32 j = 0; j < 4; j++)
+			q[j] = _mm_mul_ps(q[j], factor);
+	}
+
+	/** 
+	 * Performs normalized linear interpolation between four pairs of quaternions at once, taking the shortest path. 
+	 * Equivalent to Quaternion::lerp().
+	 */
+	static void nlerp4(__m128 t, const __m128 (&a)[4], const __m128 (&b)[4], __m128 (&output)[4])
+	{
+		__m128 dot = _mm_mul_ps(a[3], b[3]);
+		for (UINT32 j = 0; j < 3; j++)
+			dot = _mm_add_ps(dot, _mm_mul_ps(a[j], b[j]));
+
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+		__m128 weightA = _mm_xor_ps(_mm_sub_ps(one, t), flip);
+
+		for (UINT32 j = 0; j < 4; j++)
+			output[j] = _mm_add_ps(_mm_mul_ps(weightA, a[j]), _mm_mul_ps(t, b[j]));
+
+		normalize4(output);
+	}
+
+	/** Multiplies four pairs of quaternions at once. Equivalent to Quaternion::operator*(). */
+	static void multiply4(const __m128 (&a)[4], const __m128 (&b)[4], __m128 (&output)[4])
+	{
+		const __m128& ax = a[0]; const __m128& ay = a[1]; const __m128& az = a[2]; const __m128& aw = a[3];
+		const __m128& bx = b[0]; const __m128& by = b[1]; const __m128& bz = b[2]; const __m128& bw = b[3];
+
+		output[3] = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), 
+			_mm_mul_ps(az, bz));
+		output[0] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), 
+			_mm_mul_ps(az, by));
+		output[1] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)), 
+			_mm_mul_ps(ax, bz));
+		output[2] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)), 
+			_mm_mul_ps(ay, bx));
+	}
+#endif
+
+	/** 
+	 * Applies weighted sampled rotations on top of the rotations in the pose, for every bone with a non-zero weight. 
+	 * Each sampled rotation is interpolated from identity using the weight before being applied.
+	 */
+	static void blendRotationsAdditive(const PoseStreams& pose, const PoseStreams& sample, const PoseWeights& weights, 
+		UINT32 numLanes)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 identity[4] = { zero, zero, zero, _mm_set1_ps(1.0f) };
+
+		for (; i < numLanes; i += POSE_GROUP_SIZE)
+		{
+			__m128 weight = _mm_loadu_ps(weights.rotation + i);
+			__m128 isAnimated = _mm_cmpneq_ps(weight, zero);
+			if (_mm_movemask_ps(isAnimated) == 0)
+				continue;
+
+			__m128 value[4];
+			__m128 current[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				value[j] = _mm_loadu_ps(sample.rotation[j] + i);
+				current[j] = _mm_loadu_ps(pose.rotation[j] + i);
+			}
+
+			// Rotations that weren't assigned yet start off as identity
+			__m128 isAssigned = _mm_cmpneq_ps(current[3], zero);
+			for (UINT32 j = 0; j < 4; j++)
+				current[j] = _mm_or_ps(_mm_and_ps(isAssigned, current[j]), _mm_andnot_ps(isAssigned, identity[j]));
+
+			nlerp4(weight, identity, value, value);
+
+			__m128 result[4];
+			multiply4(current, value, result);
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				__m128 original = _mm_loadu_ps(pose.rotation[j] + i);
+				result[j] = _mm_or_ps(_mm_and_ps(isAnimated, result[j]), _mm_andnot_ps(isAnimated, original));
+
+				_mm_storeu_ps(pose.rotation[j] + i, result[j]);
+			}
+		}
+#endif
+
+		for (; i < numLanes; i++)
+		{
+			if (weights.rotation[i] == 0.0f)
+				continue;
+
+			Quaternion current(pose.rotation[3][i], pose.rotation[0][i], pose.rotation[1][i], pose.rotation[2][i]);
+			if (current.w == 0.0f)
+				current = Quaternion::IDENTITY;
+
+			Quaternion value(sample.rotation[3][i], sample.rotation[0][i], sample.rotation[1][i], sample.rotation[2][i]);
+			value = Quaternion::lerp(weights.rotation[i], Quaternion::IDENTITY, value);
+
+			current *= value;
+
+			pose.rotation[0][i] = current.x;
+			pose.rotation[1][i] = current.y;
+			pose.rotation[2][i] = current.z;
+			pose.rotation[3][i] = current.w;
+		}
+	}
+
+	/** Normalizes all rotations in the pose. Rotations that were never assigned are set to identity. */
+	static void normalizeRotations(const PoseStreams& pose, UINT32 numLanes)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; i < numLanes; i += POSE_GROUP_SIZE)
+		{
+			__m128 rotation[4];
+			for (UINT32 j = 0; j < 4; j++)
+				rotation[j] = _mm_loadu_ps(pose.rotation[j] + i);
+
+			__m128 isAssigned = _mm_cmpneq_ps(rotation[3], zero);
+
+			// Avoid dividing by zero for unassigned rotations, they get replaced below
+			rotation[3] = _mm_or_ps(_mm_and_ps(isAssigned, rotation[3]), _mm_andnot_ps(isAssigned, one));
+			normalize4(rotation);
+
+			for (UINT32 j = 0; j < 3; j++)
+				_mm_storeu_ps(pose.rotation[j] + i, _mm_and_ps(isAssigned, rotation[j]));
+
+			_mm_storeu_ps(pose.rotation[3] + i, _mm_or_ps(_mm_and_ps(isAssigned, rotation[3]), 
+				_mm_andnot_ps(isAssigned, one)));
+		}
+#endif
+
+		for (; i < numLanes; i++)
+		{
+			Quaternion rotation(pose.rotation[3][i], pose.rotation[0][i], pose.rotation[1][i], pose.rotation[2][i]);
+			if (rotation.w == 0.0f)
+				rotation = Quaternion::IDENTITY;
+			else
+				rotation.normalize();
+
+			pose.rotation[0][i] = rotation.x;
+			pose.rotation[1][i] = rotation.y;
+			pose.rotation[2][i] = rotation.z;
+			pose.rotation[3][i] = rotation.w;
+		}
+	}
+
+	/** 
+	 * Builds local transform matrices of all bones in the pose, except for bones with overriden transforms. Equivalent to
+	 * Matrix4::TRS(). 
+	 */
+	static void buildLocalMatrices(const PoseStreams& pose, const bool* hasOverride, UINT32 numBones, Matrix4* output)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; (i + POSE_GROUP_SIZE) <= numBones; i += POSE_GROUP_SIZE)
+		{
+			__m128 x = _mm_loadu_ps(pose.rotation[0] + i);
+			__m128 y = _mm_loadu_ps(pose.rotation[1] + i);
+			__m128 z = _mm_loadu_ps(pose.rotation[2] + i);
+			__m128 w = _mm_loadu_ps(pose.rotation[3] + i);
+
+			__m128 tx = _mm_add_ps(x, x);
+			__m128 ty = _mm_add_ps(y, y);
+			__m128 tz = _mm_add_ps(z, z);
+			__m128 twx = _mm_mul_ps(tx, w);
+			__m128 twy = _mm_mul_ps(ty, w);
+			__m128 twz = _mm_mul_ps(tz, w);
+			__m128 txx = _mm_mul_ps(tx, x);
+			__m128 txy = _mm_mul_ps(ty, x);
+			__m128 txz = _mm_mul_ps(tz, x);
+			__m128 tyy = _mm_mul_ps(ty, y);
+			__m128 tyz = _mm_mul_ps(tz, y);
+			__m128 tzz = _mm_mul_ps(tz, z);
+
+			__m128 scaleX = _mm_loadu_ps(pose.scale[0] + i);
+			__m128 scaleY = _mm_loadu_ps(pose.scale[1] + i);
+			__m128 scaleZ = _mm_loadu_ps(pose.scale[2] + i);
+
+			// Each register holds a single matrix element, for four different bones
+			__m128 rows[3][4];
+			rows[0][0] = _mm_mul_ps(scaleX, _mm_sub_ps(one, _mm_add_ps(tyy, tzz)));
+			rows[0][1] = _mm_mul_ps(scaleY, _mm_sub_ps(txy, twz));
+			rows[0][2] = _mm_mul_ps(scaleZ, _mm_add_ps(txz, twy));
+			rows[0][3] = _mm_loadu_ps(pose.position[0] + i);
+
+			rows[1][0] = _mm_mul_ps(scaleX, _mm_add_ps(txy, twz));
+			rows[1][1] = _mm_mul_ps(scaleY, _mm_sub_ps(one, _mm_add_ps(txx, tzz)));
+			rows[1][2] = _mm_mul_ps(scaleZ, _mm_sub_ps(tyz, twx));
+			rows[1][3] = _mm_loadu_ps(pose.position[1] + i);
+
+			rows[2][0] = _mm_mul_ps(scaleX, _mm_sub_ps(txz, twy));
+			rows[2][1] = _mm_mul_ps(scaleY, _mm_add_ps(tyz, twx));
+			rows[2][2] = _mm_mul_ps(scaleZ, _mm_sub_ps(one, _mm_add_ps(txx, tyy)));
+			rows[2][3] = _mm_loadu_ps(pose.position[2] + i);
+
+			// Transpose so each register holds a full matrix row of a single bone
+			for (UINT32 j = 0; j < 3; j++)
+				_MM_TRANSPOSE4_PS(rows[j][0], rows[j][1], rows[j][2], rows[j][3]);
+
+			const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+			for (UINT32 j = 0; j < POSE_GROUP_SIZE; j++)
+			{
+				if (hasOverride[i + j])
+					continue;
+
+				Matrix4& matrix = output[i + j];
+				_mm_storeu_ps(&matrix[0].x, rows[0][j]);
+				_mm_storeu_ps(&matrix[1].x, rows[1][j]);
+				_mm_storeu_ps(&matrix[2].x, rows[2][j]);
+				_mm_storeu_ps(&matrix[3].x, lastRow);
+			}
+		}
+#endif
+
+		for (; i < numBones; i++)
+		{
+			if (hasOverride[i])
+				continue;
+
+			Vector3 position(pose.position[0][i], pose.position[1][i], pose.position[2][i]);
+			Quaternion rotation(pose.rotation[3][i], pose.rotation[0][i], pose.rotation[1][i], pose.rotation[2][i]);
+			Vector3 scale(pose.scale[0][i], pose.scale[1][i], pose.scale[2][i]);
+
+			output[i] = Matrix4::TRS(position, rotation, scale);
+		}
+	}
+
+	/** Multiplies two matrices and writes the result in @p output, which may alias either input. */
+	static void multiplyMatrix(const Matrix4& lhs, const Matrix4& rhs, Matrix4& output)
+	{
+#if BS_SSE2
+		__m128 rhsRows[4];
+		for (UINT32 j = 0; j < 4; j++)
+			rhsRows[j] = _mm_loadu_ps(&rhs[j].x);
+
+		__m128 rows[4];
+		for (UINT32 j = 0; j < 4; j++)
+		{
+			const float* lhsRow = &lhs[j].x;
+
+			__m128 row = _mm_mul_ps(_mm_set1_ps(lhsRow[0]), rhsRows[0]);
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhsRow[1]), rhsRows[1]));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhsRow[2]), rhsRows[2]));
+			rows[j] = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhsRow[3]), rhsRows[3]));
+		}
+
+		for (UINT32 j = 0; j < 4; j++)
+			_mm_storeu_ps(&output[j].x, rows[j]);
+#else
+		output = lhs * rhs;
+#endif
+	}
+
 	Skeleton::Skeleton()
 		:mInvBindPoses(nullptr), mBoneInfo(nullptr), mNumBones(0)
 	{ }
@@ -155,17 +586,38 @@ namespace bs
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
+		// Bones are evaluated in groups, round up so the last group doesn't need special handling
+		UINT32 numLanes = ((mNumBones + POSE_GROUP_SIZE - 1) / POSE_GROUP_SIZE) * POSE_GROUP_SIZE;
+
+		UINT32 streamBytes = sizeof(float) * numLanes * POSE_NUM_STREAMS;
+		float* streamBuffer = (float*)bs_stack_alloc(streamBytes);
+
+		// Lanes past the last bone are never sampled but still go through the vectorized blend, so make sure they don't
+		// hold garbage (potentially NaNs or denormals)
+		memset(streamBuffer, 0, streamBytes);
+
+		PoseStreams localStreams;
+		PoseStreams sampleStreams;
+		PoseWeights weights;
+
+		float* buffer = assignPoseStreams(localStreams, streamBuffer, numLanes);
+		buffer = assignPoseStreams(sampleStreams, buffer, numLanes);
+
+		weights.position = buffer;
+		weights.rotation = buffer + numLanes;
+		weights.scale = buffer + numLanes * 2;
+
+		for (UINT32 i = 0; i < 3; i++)
 		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
+			std::fill(localStreams.position[i], localStreams.position[i] + numLanes, 0.0f);
+			std::fill(localStreams.scale[i], localStreams.scale[i] + numLanes, 1.0f);
 		}
 
+		for (UINT32 i = 0; i < 4; i++)
+			std::fill(localStreams.rotation[i], localStreams.rotation[i] + numLanes, 0.0f);
+
 		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
 		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
 		// as well.
@@ -197,139 +649,123 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				// Sample all the curves of the state first, and then blend the samples with the pose for multiple bones at
+				// once. Bones without a curve get a zero weight, and their sample is left at a neutral value.
+				memset(weights.position, 0, sizeof(float) * numLanes * 3);
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
-					if (!mask.isEnabled(k))
-						continue;
-
 					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.position;
+					bool isEnabled = mask.isEnabled(k);
+
+					UINT32 curveIdx = isEnabled ? mapping.position : (UINT32)-1;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value = state.curves->evaluatePosition(curveIdx, state.time, state.positionCaches[curveIdx], state.loop);
+
+						for (UINT32 l = 0; l < 3; l++)
+							sampleStreams.position[l][k] = value[l];
 
+						weights.position[k] = normWeight;
 						localPose.hasOverride[k] = false;
 					}
-				}
-
-				for (UINT32 k = 0; k < mNumBones; k++)
-				{
-					if (!mask.isEnabled(k))
-						continue;
+					else
+					{
+						for (UINT32 l = 0; l < 3; l++)
+							sampleStreams.position[l][k] = 0.0f;
+					}
 
-					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-					UINT32 curveIdx = mapping.scale;
+					curveIdx = isEnabled ? mapping.scale : (UINT32)-1;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value = state.curves->evaluateScale(curveIdx, state.time, state.scaleCaches[curveIdx], state.loop);
+
+						for (UINT32 l = 0; l < 3; l++)
+							sampleStreams.scale[l][k] = value[l];
 
+						weights.scale[k] = normWeight;
 						localPose.hasOverride[k] = false;
 					}
-				}
-
-				if(layer.additive)
-				{
-					for (UINT32 k = 0; k < mNumBones; k++)
+					else
 					{
-						if (!mask.isEnabled(k))
-							continue;
-
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
+						for (UINT32 l = 0; l < 3; l++)
+							sampleStreams.scale[l][k] = 1.0f;
+					}
 
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+					curveIdx = isEnabled ? mapping.rotation : (UINT32)-1;
+					if (curveIdx != (UINT32)-1)
+					{
+						Quaternion value = state.curves->evaluateRotation(curveIdx, state.time, state.rotationCaches[curveIdx], state.loop);
 
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+						for (UINT32 l = 0; l < 4; l++)
+							sampleStreams.rotation[l][k] = value[l];
 
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-						}
+						weights.rotation[k] = normWeight;
+						localPose.hasOverride[k] = false;
 					}
-				}
-				else
-				{
-					for (UINT32 k = 0; k < mNumBones; k++)
+					else
 					{
-						if (!mask.isEnabled(k))
-							continue;
-
-						const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
-						UINT32 curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
-
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
-							
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
-						}
+						for (UINT32 l = 0; l < 3; l++)
+							sampleStreams.rotation[l][k] = 0.0f;
+
+						sampleStreams.rotation[3][k] = 1.0f;
 					}
 				}
+
+				blendPositions(localStreams, sampleStreams, weights, numLanes);
+				blendScales(localStreams, sampleStreams, weights, numLanes);
+
+				if (layer.additive)
+					blendRotationsAdditive(localStreams, sampleStreams, weights, numLanes);
+				else
+					blendRotations(localStreams, sampleStreams, weights, numLanes);
 			}
 		}
 
+		normalizeRotations(localStreams, numLanes);
+
+		for (UINT32 i = 0; i < mNumBones; i++)
+		{
+			localPose.positions[i] = Vector3(localStreams.position[0][i], localStreams.position[1][i], 
+				localStreams.position[2][i]);
+			localPose.rotations[i] = Quaternion(localStreams.rotation[3][i], localStreams.rotation[0][i], 
+				localStreams.rotation[1][i], localStreams.rotation[2][i]);
+			localPose.scales[i] = Vector3(localStreams.scale[0][i], localStreams.scale[1][i], localStreams.scale[2][i]);
+		}
+
 		// Calculate local pose matrices
+		buildLocalMatrices(localStreams, localPose.hasOverride, mNumBones, pose);
+
+		// Calculate global poses. Root bones, and bones whose transform was overriden, are already in global space.
 		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
 		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
+		for (UINT32 i = 0; i < mNumBones; i++)
+			isGlobal[i] = localPose.hasOverride[i] || mBoneInfo[i].parent == (UINT32)-1;
+
+		UINT32* boneChain = (UINT32*)bs_stack_alloc(sizeof(UINT32) * mNumBones);
+		for (UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
+			// Find all bones between this one and the first parent already in global space, and transform them starting
+			// from the top-most one
+			UINT32 chainLength = 0;
+			for (UINT32 boneIdx = i; !isGlobal[boneIdx]; boneIdx = mBoneInfo[boneIdx].parent)
+				boneChain[chainLength++] = boneIdx;
 
-			if (localPose.hasOverride[i])
+			while (chainLength > 0)
 			{
-				isGlobal[i] = true;
-				continue;
-			}
-
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
-		}
+				UINT32 boneIdx = boneChain[--chainLength];
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
-		{
-			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
-			if (parentBoneIdx == (UINT32)-1)
-			{
+				multiplyMatrix(pose[mBoneInfo[boneIdx].parent], pose[boneIdx], pose[boneIdx]);
 				isGlobal[boneIdx] = true;
-				return;
 			}
-
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
-
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
-
-		for (UINT32 i = 0; i < mNumBones; i++)
-		{
-			if (!isGlobal[i])
-				calcGlobal(i);
 		}
 
 		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+			multiplyMatrix(pose[i], mInvBindPoses[i], pose[i]);
 
+		bs_stack_free(boneChain);
 		bs_stack_free(isGlobal);
+		bs_stack_free(streamBuffer);
 	}
 
 	UINT32 Skeleton::getRootBoneIndex() const
@@ -1,28 +1,288 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Audio/BsAudioUtility.h"
+#include "Math/BsMath.h"
+
+#if BS_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace bs
 {
+	/**
+	 * Reads a single signed integer sample and returns it as a 32-bit integer, with the sample value in the most
+	 * significant bits.
+	 *
+	 * @tparam	BYTES	Size of the sample in bytes.
+	 */
+	template<UINT32 BYTES>
+	INT32 readSample(const UINT8* input);
+
+	template<>
+	INT32 readSample<1>(const UINT8* input)
+	{
+		return (INT32)*(INT8*)input << 24;
+	}
+
+	template<>
+	INT32 readSample<2>(const UINT8* input)
+	{
+		return (INT32)*(INT16*)input << 16;
+	}
+
+	template<>
+	INT32 readSample<3>(const UINT8* input)
+	{
+		return AudioUtility::convert24To32Bits(input);
+	}
+
+	template<>
+	INT32 readSample<4>(const UINT8* input)
+	{
+		return *(INT32*)input;
+	}
+
+	/**
+	 * Writes a single signed integer sample, provided as a 32-bit integer with the sample value in the most significant
+	 * bits. Least significant bits that don't fit in the output sample are discarded.
+	 *
+	 * @tparam	BYTES	Size of the sample in bytes.
+	 */
+	template<UINT32 BYTES>
+	void writeSample(INT32 value, UINT8* output);
+
+	template<>
+	void writeSample<1>(INT32 value, UINT8* output)
+	{
+		*(INT8*)output = (INT8)(value >> 24);
+	}
+
+	template<>
+	void writeSample<2>(INT32 value, UINT8* output)
+	{
+		*(INT16*)output = (INT16)(value >> 16);
+	}
+
+	template<>
+	void writeSample<3>(INT32 value, UINT8* output)
+	{
+		UINT32 valToEncode = (UINT32)value;
+		output[0] = (valToEncode >> 8) & 0x000000FF;
+		output[1] = (valToEncode >> 16) & 0x000000FF;
+		output[2] = (valToEncode >> 24) & 0x000000FF;
+	}
+
+	template<>
+	void writeSample<4>(INT32 value, UINT8* output)
+	{
+		*(INT32*)output = value;
+	}
+
+	/** Converts samples directly from one bit depth to another, without an intermediate buffer. */
+	template<UINT32 IN_BYTES, UINT32 OUT_BYTES>
+	void convertSamples(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		for (UINT32 i = 0; i < numSamples; i++)
+		{
+			writeSample<OUT_BYTES>(readSample<IN_BYTES>(input), output);
+
+			input += IN_BYTES;
+			output += OUT_BYTES;
+		}
+	}
+
+#if BS_SSE2
+	template<>
+	void convertSamples<1, 2>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			__m128i samples = _mm_loadu_si128((const __m128i*)(input + i));
+
+			// Placing the sample in the upper byte is equivalent to shifting it left by eight bits
+			_mm_storeu_si128((__m128i*)(output + i * 2), _mm_unpacklo_epi8(zero, samples));
+			_mm_storeu_si128((__m128i*)(output + i * 2 + 16), _mm_unpackhi_epi8(zero, samples));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<2>(readSample<1>(input + i), output + i * 2);
+	}
+
+	template<>
+	void convertSamples<2, 1>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			__m128i samples0 = _mm_srai_epi16(_mm_loadu_si128((const __m128i*)(input + i * 2)), 8);
+			__m128i samples1 = _mm_srai_epi16(_mm_loadu_si128((const __m128i*)(input + i * 2 + 16)), 8);
+
+			_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi16(samples0, samples1));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<1>(readSample<2>(input + i * 2), output + i);
+	}
+
+	template<>
+	void convertSamples<2, 4>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			__m128i samples = _mm_loadu_si128((const __m128i*)(input + i * 2));
+
+			_mm_storeu_si128((__m128i*)(output + i * 4), _mm_unpacklo_epi16(zero, samples));
+			_mm_storeu_si128((__m128i*)(output + i * 4 + 16), _mm_unpackhi_epi16(zero, samples));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<4>(readSample<2>(input + i * 2), output + i * 4);
+	}
+
+	template<>
+	void convertSamples<4, 2>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			__m128i samples0 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4)), 16);
+			__m128i samples1 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4 + 16)), 16);
+
+			_mm_storeu_si128((__m128i*)(output + i * 2), _mm_packs_epi32(samples0, samples1));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<2>(readSample<4>(input + i * 4), output + i * 2);
+	}
+
+	template<>
+	void convertSamples<1, 4>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			__m128i samples = _mm_loadu_si128((const __m128i*)(input + i));
+			__m128i samples16Lo = _mm_unpacklo_epi8(zero, samples);
+			__m128i samples16Hi = _mm_unpackhi_epi8(zero, samples);
+
+			_mm_storeu_si128((__m128i*)(output + i * 4), _mm_unpacklo_epi16(zero, samples16Lo));
+			_mm_storeu_si128((__m128i*)(output + i * 4 + 16), _mm_unpackhi_epi16(zero, samples16Lo));
+			_mm_storeu_si128((__m128i*)(output + i * 4 + 32), _mm_unpacklo_epi16(zero, samples16Hi));
+			_mm_storeu_si128((__m128i*)(output + i * 4 + 48), _mm_unpackhi_epi16(zero, samples16Hi));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<4>(readSample<1>(input + i), output + i * 4);
+	}
+
+	template<>
+	void convertSamples<4, 1>(const UINT8* input, UINT8* output, UINT32 numSamples)
+	{
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			__m128i samples0 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4)), 24);
+			__m128i samples1 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4 + 16)), 24);
+			__m128i samples2 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4 + 32)), 24);
+			__m128i samples3 = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(input + i * 4 + 48)), 24);
+
+			__m128i samples16Lo = _mm_packs_epi32(samples0, samples1);
+			__m128i samples16Hi = _mm_packs_epi32(samples2, samples3);
+
+			_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi16(samples16Lo, samples16Hi));
+		}
+
+		for (; i < numSamples; i++)
+			writeSample<1>(readSample<4>(input + i * 4), output + i);
+	}
+#endif
+
+	typedef void(*SampleConversionFunc)(const UINT8*, UINT8*, UINT32);
+
+	/** Returns a function that converts samples of the specified size to the provided bit depth. */
+	template<UINT32 IN_BYTES>
+	SampleConversionFunc getSampleConversionFunc(UINT32 outBitDepth)
+	{
+		switch (outBitDepth)
+		{
+		case 8: return &convertSamples<IN_BYTES, 1>;
+		case 16: return &convertSamples<IN_BYTES, 2>;
+		case 24: return &convertSamples<IN_BYTES, 3>;
+		case 32: return &convertSamples<IN_BYTES, 4>;
+		default: return nullptr;
+		}
+	}
+
+	/** Returns a function that converts samples directly between the provided bit depths. */
+	SampleConversionFunc getSampleConversionFunc(UINT32 inBitDepth, UINT32 outBitDepth)
+	{
+		switch (inBitDepth)
+		{
+		case 8: return getSampleConversionFunc<1>(outBitDepth);
+		case 16: return getSampleConversionFunc<2>(outBitDepth);
+		case 24: return getSampleConversionFunc<3>(outBitDepth);
+		case 32: return getSampleConversionFunc<4>(outBitDepth);
+		default: return nullptr;
+		}
+	}
+
 	void convertToMono8(const INT8* input, UINT8* output, UINT32 numSamples, UINT32 numChannels)
 	{
 		for (UINT32 i = 0; i < numSamples; i++)
 		{
-			INT16 sum = 0;
+			INT32 sum = 0;
 			for (UINT32 j = 0; j < numChannels; j++)
 			{
 				sum += *input;
 				++input;
 			}
 
-			*output = sum / numChannels;
+			*output = (UINT8)(INT8)(sum / (INT32)numChannels);
 			++output;
 		}
 	}
 
 	void convertToMono16(const INT16* input, INT16* output, UINT32 numSamples, UINT32 numChannels)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+
+#if BS_SSE2
+		if (numChannels == 2)
+		{
+			for (; i + 8 <= numSamples; i += 8)
+			{
+				__m128i samples0 = _mm_loadu_si128((const __m128i*)(input + i * 2));
+				__m128i samples1 = _mm_loadu_si128((const __m128i*)(input + i * 2 + 8));
+
+				// Sign extend left and right channel samples to 32 bits, and add them
+				__m128i left0 = _mm_srai_epi32(_mm_slli_epi32(samples0, 16), 16);
+				__m128i left1 = _mm_srai_epi32(_mm_slli_epi32(samples1, 16), 16);
+				__m128i right0 = _mm_srai_epi32(samples0, 16);
+				__m128i right1 = _mm_srai_epi32(samples1, 16);
+
+				__m128i sum0 = _mm_add_epi32(left0, right0);
+				__m128i sum1 = _mm_add_epi32(left1, right1);
+
+				// Divide by two, rounding towards zero
+				sum0 = _mm_srai_epi32(_mm_add_epi32(sum0, _mm_srli_epi32(sum0, 31)), 1);
+				sum1 = _mm_srai_epi32(_mm_add_epi32(sum1, _mm_srli_epi32(sum1, 31)), 1);
+
+				_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi32(sum0, sum1));
+			}
+
+			input += i * 2;
+		}
+#endif
+
+		for (; i < numSamples; i++)
 		{
 			INT32 sum = 0;
 			for (UINT32 j = 0; j < numChannels; j++)
@@ -31,19 +291,10 @@ namespace bs
 				++input;
 			}
 
-			*output = sum / numChannels;
-			++output;
+			output[i] = sum / (INT32)numChannels;
 		}
 	}
 
-	void convert32To24Bits(const INT32 input, UINT8* output)
-	{
-		UINT32 valToEncode = *(UINT32*)&input;
-		output[0] = (valToEncode >> 8) & 0x000000FF;
-		output[1] = (valToEncode >> 16) & 0x000000FF;
-		output[2] = (valToEncode >> 24) & 0x000000FF;
-	}
-
 	void convertToMono24(const UINT8* input, UINT8* output, UINT32 numSamples, UINT32 numChannels)
 	{
 		for (UINT32 i = 0; i < numSamples; i++)
@@ -56,7 +307,7 @@ namespace bs
 			}
 
 			INT32 avg = (INT32)(sum / numChannels);
-			convert32To24Bits(avg, output);
+			writeSample<3>(avg, output);
 			output += 3;
 		}
 	}
@@ -77,50 +328,109 @@ namespace bs
 		}
 	}
 
-	void convert8To32Bits(const INT8* input, INT32* output, UINT32 numSamples)
+	/** Converts signed integer samples to floating point samples, by multiplying them with the provided scale. */
+	template<UINT32 BYTES>
+	void convertSamplesToFloat(const UINT8* input, float* output, UINT32 numSamples, float scale)
 	{
 		for (UINT32 i = 0; i < numSamples; i++)
 		{
-			INT8 val = input[i];
-			output[i] = val << 24;
+			output[i] = readSample<BYTES>(input) * scale;
+			input += BYTES;
 		}
 	}
 
-	void convert16To32Bits(const INT16* input, INT32* output, UINT32 numSamples)
+#if BS_SSE2
+	template<>
+	void convertSamplesToFloat<2>(const UINT8* input, float* output, UINT32 numSamples, float scale)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
-			output[i] = input[i] << 16;
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 scaleVec = _mm_set1_ps(scale);
+
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			__m128i samples = _mm_loadu_si128((const __m128i*)(input + i * 2));
+			__m128i samplesLo = _mm_unpacklo_epi16(zero, samples);
+			__m128i samplesHi = _mm_unpackhi_epi16(zero, samples);
+
+			_mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(samplesLo), scaleVec));
+			_mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(samplesHi), scaleVec));
+		}
+
+		for (; i < numSamples; i++)
+			output[i] = readSample<2>(input + i * 2) * scale;
 	}
 
-	void convert24To32Bits(const UINT8* input, INT32* output, UINT32 numSamples)
+	template<>
+	void convertSamplesToFloat<4>(const UINT8* input, float* output, UINT32 numSamples, float scale)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		const __m128 scaleVec = _mm_set1_ps(scale);
+
+		UINT32 i = 0;
+		for (; i + 4 <= numSamples; i += 4)
 		{
-			output[i] = AudioUtility::convert24To32Bits(input);
-			input += 3;
+			__m128i samples = _mm_loadu_si128((const __m128i*)(input + i * 4));
+			_mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scaleVec));
 		}
+
+		for (; i < numSamples; i++)
+			output[i] = readSample<4>(input + i * 4) * scale;
 	}
+#endif
 
-	void convert32To8Bits(const INT32* input, UINT8* output, UINT32 numSamples)
+	/**
+	 * Converts a floating point sample in range [-1, 1] to a signed integer sample. Sample is scaled to the range of
+	 * the output sample size, clamped and rounded to nearest. Returned value is in the most significant bits.
+	 *
+	 * @tparam	BYTES	Size of the output sample in bytes.
+	 */
+	template<UINT32 BYTES>
+	INT32 floatToSample(float input)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
-			output[i] = (INT8)(input[i] >> 24);
+		// Largest float smaller than 2^31 is used for 32-bit samples, so the conversion doesn't overflow
+		const float maxValue = BYTES == 4 ? 2147483520.0f : (float)((1LL << (BYTES * 8 - 1)) - 1);
+
+		float value = Math::clamp(input * maxValue, -maxValue, maxValue);
+		INT32 sample = (INT32)std::lrint(value);
+
+		return (INT32)((UINT32)sample << ((4 - BYTES) * 8));
 	}
 
-	void convert32To16Bits(const INT32* input, INT16* output, UINT32 numSamples)
+	/** Converts floating point samples in range [-1, 1] to signed integer samples. */
+	template<UINT32 BYTES>
+	void convertSamplesFromFloat(const float* input, UINT8* output, UINT32 numSamples)
 	{
 		for (UINT32 i = 0; i < numSamples; i++)
-			output[i] = (INT16)(input[i] >> 16);
+		{
+			writeSample<BYTES>(floatToSample<BYTES>(input[i]), output);
+			output += BYTES;
+		}
 	}
 
-	void convert32To24Bits(const INT32* input, UINT8* output, UINT32 numSamples)
+#if BS_SSE2
+	template<>
+	void convertSamplesFromFloat<2>(const float* input, UINT8* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		const __m128 maxValue = _mm_set1_ps(32767.0f);
+		const __m128 minValue = _mm_set1_ps(-32767.0f);
+
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
 		{
-			convert32To24Bits(input[i], output);
-			output += 3;
+			__m128 values0 = _mm_mul_ps(_mm_loadu_ps(input + i), maxValue);
+			__m128 values1 = _mm_mul_ps(_mm_loadu_ps(input + i + 4), maxValue);
+
+			values0 = _mm_min_ps(_mm_max_ps(values0, minValue), maxValue);
+			values1 = _mm_min_ps(_mm_max_ps(values1, minValue), maxValue);
+
+			__m128i samples = _mm_packs_epi32(_mm_cvtps_epi32(values0), _mm_cvtps_epi32(values1));
+			_mm_storeu_si128((__m128i*)(output + i * 2), samples);
 		}
+
+		for (; i < numSamples; i++)
+			writeSample<2>(floatToSample<2>(input[i]), output + i * 2);
 	}
+#endif
 
 	void AudioUtility::convertToMono(const UINT8* input, UINT8* output, UINT32 bitDepth, UINT32 numSamples, UINT32 numChannels)
 	{
@@ -146,110 +456,200 @@ namespace bs
 
 	void AudioUtility::convertBitDepth(const UINT8* input, UINT32 inBitDepth, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
 	{
-		INT32* srcBuffer = nullptr;
-
-		bool needTempBuffer = inBitDepth != 32;
-		if (needTempBuffer)
-			srcBuffer = (INT32*)bs_stack_alloc(numSamples * sizeof(INT32));
-		else
-			srcBuffer = (INT32*)input;
+		if (inBitDepth == outBitDepth)
+		{
+			memcpy(output, input, numSamples * (inBitDepth / 8));
+			return;
+		}
 
-		// Note: I convert to a temporary 32-bit buffer and then use that to convert to actual requested bit depth. 
-		//       It would be more efficient to convert directly from source to requested depth without a temporary buffer,
-		//       at the cost of additional complexity. If this method ever becomes a performance issue consider that.
-		switch (inBitDepth)
+		auto convertFunc = getSampleConversionFunc(inBitDepth, outBitDepth);
+		if (convertFunc == nullptr)
 		{
-		case 8:
-			convert8To32Bits((INT8*)input, srcBuffer, numSamples);
-			break;
-		case 16:
-			convert16To32Bits((INT16*)input, srcBuffer, numSamples);
-			break;
-		case 24:
-			bs::convert24To32Bits(input, srcBuffer, numSamples);
-			break;
-		case 32:
-			// Do nothing
-			break;
-		default:
 			assert(false);
-			break;
+			return;
 		}
 
+		convertFunc(input, output, numSamples);
+	}
+
+	void AudioUtility::convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
+	{
+		// Samples are read with their value in the most significant bits, so the scale accounts for the shift
+		if (inBitDepth == 8)
+			convertSamplesToFloat<1>(input, output, numSamples, 1.0f / (127.0f * (1 << 24)));
+		else if (inBitDepth == 16)
+			convertSamplesToFloat<2>(input, output, numSamples, 1.0f / (32767.0f * (1 << 16)));
+		else if (inBitDepth == 24)
+			convertSamplesToFloat<3>(input, output, numSamples, 1.0f / 2147483647.0f);
+		else if (inBitDepth == 32)
+			convertSamplesToFloat<4>(input, output, numSamples, 1.0f / 2147483647.0f);
+		else
+			assert(false);
+	}
+
+	void AudioUtility::convertFromFloat(const float* input, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
+	{
 		switch (outBitDepth)
 		{
 		case 8:
-			convert32To8Bits(srcBuffer, output, numSamples);
+			convertSamplesFromFloat<1>(input, output, numSamples);
 			break;
 		case 16:
-			convert32To16Bits(srcBuffer, (INT16*)output, numSamples);
+			convertSamplesFromFloat<2>(input, output, numSamples);
 			break;
 		case 24:
-			convert32To24Bits(srcBuffer, output, numSamples);
+			convertSamplesFromFloat<3>(input, output, numSamples);
 			break;
 		case 32:
-			memcpy(output, srcBuffer, numSamples * sizeof(INT32));
+			convertSamplesFromFloat<4>(input, output, numSamples);
 			break;
 		default:
 			assert(false);
 			break;
 		}
+	}
 
-		if (needTempBuffer)
+	void AudioUtility::convertUnsigned8ToSigned(UINT8* samples, UINT32 numSamples)
+	{
+		// Subtracting 128 from an unsigned 8-bit value yields the same bits as flipping its top bit
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128i signBit = _mm_set1_epi8((char)0x80);
+		for (; i + 16 <= numSamples; i += 16)
 		{
-			bs_stack_free(srcBuffer);
-			srcBuffer = nullptr;
+			__m128i values = _mm_loadu_si128((const __m128i*)(samples + i));
+			_mm_storeu_si128((__m128i*)(samples + i), _mm_xor_si128(values, signBit));
 		}
+#endif
+
+		for (; i < numSamples; i++)
+			samples[i] ^= 0x80;
 	}
 
-	void AudioUtility::convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
+	void AudioUtility::interleave(const INT32* const* input, UINT8* output, UINT32 bitDepth, UINT32 numChannels,
+		UINT32 numFrames)
 	{
-		if (inBitDepth == 8)
+		UINT32 bytesPerSample = bitDepth / 8;
+		assert(bytesPerSample >= 1 && bytesPerSample <= 4);
+
+		UINT32 i = 0;
+
+#if BS_SSE2
+		if (numChannels == 2 && bytesPerSample == 2)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			INT16* output16 = (INT16*)output;
+			for (; i + 8 <= numFrames; i += 8)
 			{
-				INT8 sample = *(INT8*)input;
-				output[i] = sample / 127.0f;
+				__m128i left0 = _mm_loadu_si128((const __m128i*)(input[0] + i));
+				__m128i left1 = _mm_loadu_si128((const __m128i*)(input[0] + i + 4));
+				__m128i right0 = _mm_loadu_si128((const __m128i*)(input[1] + i));
+				__m128i right1 = _mm_loadu_si128((const __m128i*)(input[1] + i + 4));
 
-				input++;
+				__m128i frames0 = _mm_packs_epi32(_mm_unpacklo_epi32(left0, right0), _mm_unpackhi_epi32(left0, right0));
+				__m128i frames1 = _mm_packs_epi32(_mm_unpacklo_epi32(left1, right1), _mm_unpackhi_epi32(left1, right1));
+
+				_mm_storeu_si128((__m128i*)(output16 + i * 2), frames0);
+				_mm_storeu_si128((__m128i*)(output16 + i * 2 + 8), frames1);
 			}
+
+			output += i * 2 * bytesPerSample;
 		}
-		else if (inBitDepth == 16)
+#endif
+
+		for (; i < numFrames; i++)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			for (UINT32 j = 0; j < numChannels; j++)
 			{
-				INT16 sample = *(INT16*)input;
-				output[i] = sample / 32767.0f;
-
-				input += 2;
+				memcpy(output, &input[j][i], bytesPerSample);
+				output += bytesPerSample;
 			}
 		}
-		else if (inBitDepth == 24)
+	}
+
+	void AudioUtility::interleave(const float* const* input, float* output, UINT32 numChannels, UINT32 numFrames)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		if (numChannels == 2)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			for (; i + 4 <= numFrames; i += 4)
 			{
-				INT32 sample = convert24To32Bits(input);
-				output[i] = sample / 2147483647.0f;
+				__m128 left = _mm_loadu_ps(input[0] + i);
+				__m128 right = _mm_loadu_ps(input[1] + i);
 
-				input += 3;
+				_mm_storeu_ps(output + i * 2, _mm_unpacklo_ps(left, right));
+				_mm_storeu_ps(output + i * 2 + 4, _mm_unpackhi_ps(left, right));
 			}
 		}
-		else if (inBitDepth == 32)
+#endif
+
+		for (; i < numFrames; i++)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			for (UINT32 j = 0; j < numChannels; j++)
+				output[i * numChannels + j] = input[j][i];
+		}
+	}
+
+	void AudioUtility::deinterleave(const float* input, float* const* output, UINT32 numChannels, UINT32 numFrames)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		if (numChannels == 2)
+		{
+			for (; i + 4 <= numFrames; i += 4)
 			{
-				INT32 sample = *(INT32*)input;
-				output[i] = sample / 2147483647.0f;
+				__m128 frames0 = _mm_loadu_ps(input + i * 2);
+				__m128 frames1 = _mm_loadu_ps(input + i * 2 + 4);
 
-				input += 4;
+				_mm_storeu_ps(output[0] + i, _mm_shuffle_ps(frames0, frames1, _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(output[1] + i, _mm_shuffle_ps(frames0, frames1, _MM_SHUFFLE(3, 1, 3, 1)));
 			}
 		}
-		else
-			assert(false);
+#endif
+
+		for (; i < numFrames; i++)
+		{
+			for (UINT32 j = 0; j < numChannels; j++)
+				output[j][i] = input[i * numChannels + j];
+		}
+	}
+
+	void AudioUtility::applyGain(float* samples, float gain, UINT32 numSamples)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 gainVec = _mm_set1_ps(gain);
+		for (; i + 4 <= numSamples; i += 4)
+			_mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), gainVec));
+#endif
+
+		for (; i < numSamples; i++)
+			samples[i] *= gain;
+	}
+
+	void AudioUtility::mix(const float* input, float* output, float gain, UINT32 numSamples)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		const __m128 gainVec = _mm_set1_ps(gain);
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			__m128 value = _mm_mul_ps(_mm_loadu_ps(input + i), gainVec);
+			_mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), value));
+		}
+#endif
+
+		for (; i < numSamples; i++)
+			output[i] += input[i] * gain;
 	}
 
 	INT32 AudioUtility::convert24To32Bits(const UINT8* input)
 	{
 		return (input[2] << 24) | (input[1] << 16) | (input[0] << 8);
 	}
-}
\ No newline at end of file
+}
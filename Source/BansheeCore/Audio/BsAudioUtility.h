@@ -53,6 +53,85 @@ namespace bs
 		 */
 		static void convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples);
 
+		/**
+		 * Converts a set of floating point samples in range [-1, 1] to a set of signed integer samples of a certain bit
+		 * depth. Values outside of the range are clamped.
+		 *
+		 * @param[in]	input		A set of input samples. Total size of the buffer should be @p numSamples *
+		 *							sizeof(float).
+		 * @param[out]	output		Pre-allocated buffer to store the output samples in. Total size of the buffer should be
+		 *							@p numSamples * @p outBitDepth / 8.
+		 * @param[in]	outBitDepth	Size of a single sample in the @p output array, in bits.
+		 * @param[in]	numSamples	Total number of samples to process.
+		 */
+		static void convertFromFloat(const float* input, UINT8* output, UINT32 outBitDepth, UINT32 numSamples);
+
+		/**
+		 * Converts a set of unsigned 8-bit samples (as stored in some file formats) into signed 8-bit samples used by
+		 * the engine. Conversion is done in-place.
+		 *
+		 * @param[in, out]	samples		Samples to convert.
+		 * @param[in]		numSamples	Total number of samples to process.
+		 */
+		static void convertUnsigned8ToSigned(UINT8* samples, UINT32 numSamples);
+
+		/**
+		 * Interleaves samples stored in separate per-channel buffers into a single buffer.
+		 *
+		 * @param[in]	input		Array of @p numChannels buffers, each containing @p numFrames samples of a single
+		 *							channel. Samples are stored as 32-bit signed integers, with the sample value in the
+		 *							lower @p bitDepth bits (as output by most decoders).
+		 * @param[out]	output		Pre-allocated buffer to store the interleaved samples in. Total size of the buffer
+		 *							should be @p numFrames * @p numChannels * @p bitDepth / 8.
+		 * @param[in]	bitDepth	Size of a single sample in the @p output array, in bits.
+		 * @param[in]	numChannels	Number of channels in the input data.
+		 * @param[in]	numFrames	Number of samples per a single channel.
+		 */
+		static void interleave(const INT32* const* input, UINT8* output, UINT32 bitDepth, UINT32 numChannels,
+			UINT32 numFrames);
+
+		/**
+		 * Interleaves floating point samples stored in separate per-channel buffers into a single buffer.
+		 *
+		 * @param[in]	input		Array of @p numChannels buffers, each containing @p numFrames samples of a single
+		 *							channel.
+		 * @param[out]	output		Pre-allocated buffer to store the interleaved samples in. Should be able to hold
+		 *							@p numFrames * @p numChannels samples.
+		 * @param[in]	numChannels	Number of channels in the input data.
+		 * @param[in]	numFrames	Number of samples per a single channel.
+		 */
+		static void interleave(const float* const* input, float* output, UINT32 numChannels, UINT32 numFrames);
+
+		/**
+		 * Splits interleaved floating point samples into separate per-channel buffers.
+		 *
+		 * @param[in]	input		Interleaved samples. Should contain @p numFrames * @p numChannels samples.
+		 * @param[out]	output		Array of @p numChannels pre-allocated buffers, each able to hold @p numFrames
+		 *							samples.
+		 * @param[in]	numChannels	Number of channels in the input data.
+		 * @param[in]	numFrames	Number of samples per a single channel.
+		 */
+		static void deinterleave(const float* input, float* const* output, UINT32 numChannels, UINT32 numFrames);
+
+		/**
+		 * Multiplies a set of floating point samples with a constant.
+		 *
+		 * @param[in, out]	samples		Samples to modify.
+		 * @param[in]		gain		Value to multiply the samples with.
+		 * @param[in]		numSamples	Total number of samples to process.
+		 */
+		static void applyGain(float* samples, float gain, UINT32 numSamples);
+
+		/**
+		 * Adds a set of floating point samples multiplied by a constant to the samples in the output buffer.
+		 *
+		 * @param[in]		input		Samples to mix in.
+		 * @param[in, out]	output		Samples to mix with. Must contain @p numSamples samples.
+		 * @param[in]		gain		Value to multiply the input samples with before adding them to the output.
+		 * @param[in]		numSamples	Total number of samples to process.
+		 */
+		static void mix(const float* input, float* output, float gain, UINT32 numSamples);
+
 		/** 
 		 * Converts a 24-bit signed integer into a 32-bit signed integer. 
 		 *
@@ -128,7 +128,11 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
+		// Task scheduler workers hold on to their pool threads permanently, so leave room for all of them on top of the
+		// threads used by other systems (e.g. the core thread)
+		UINT32 maxPoolThreads = TaskScheduler::MAX_WORKERS + 16;
+
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, maxPoolThreads);
 		TaskScheduler::startUp();
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
@@ -0,0 +1,41 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCorePrerequisites.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Testing/BsResourceArchiveBenchmarkSuite.h"
+#include "Testing/BsCommandQueueBenchmarkSuite.h"
+#include "Testing/BsSkeletonBenchmarkSuite.h"
+#include "Testing/BsPixelConversionBenchmarkSuite.h"
+#include "Testing/BsAudioUtilityBenchmarkSuite.h"
+#include "Testing/BsResourceSerializationBenchmarkSuite.h"
+#include "Testing/BsResourceLoadBenchmarkSuite.h"
+#include "Testing/BsResourcesBenchmarkSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(TaskScheduler::MAX_WORKERS + 16);
+	TaskScheduler::startUp();
+
+	SPtr<TestSuite> benchmarks = ResourceArchiveBenchmarkSuite::create<ResourceArchiveBenchmarkSuite>();
+	benchmarks->add(SkeletonBenchmarkSuite::create<SkeletonBenchmarkSuite>());
+	benchmarks->add(CommandQueueBenchmarkSuite::create<CommandQueueBenchmarkSuite>());
+	benchmarks->add(PixelConversionBenchmarkSuite::create<PixelConversionBenchmarkSuite>());
+	benchmarks->add(AudioUtilityBenchmarkSuite::create<AudioUtilityBenchmarkSuite>());
+	benchmarks->add(ResourceSerializationBenchmarkSuite::create<ResourceSerializationBenchmarkSuite>());
+	benchmarks->add(ResourceLoadBenchmarkSuite::create<ResourceLoadBenchmarkSuite>());
+	benchmarks->add(ResourcesBenchmarkSuite::create<ResourcesBenchmarkSuite>());
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
@@ -79,6 +79,10 @@
  *  Managing scene objects and their hierarchy.
  */
 
+/** @defgroup Testing-Core Testing
+ *  Contains core layer benchmarks.
+ */
+
 /** @defgroup Text Text
  *  Generating text geometry.
  */
@@ -354,6 +358,9 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourceLoader;
+	class ResourceArchive;
+	class SavedResourceData;
 	class Texture;
 	class Mesh;
 	class MeshBase;
@@ -575,6 +582,7 @@ namespace bs
 		TID_LightProbeVolume = 1136,
 		TID_SavedLightProbeInfo = 1137,
 		TID_CLightProbeVolume = 1138,
+		TID_CompressedAnimationCurves = 1139,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
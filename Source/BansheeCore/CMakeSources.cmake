@@ -80,6 +80,7 @@ set(BS_BANSHEECORE_INC_SCENE
 	"Scene/BsPrefab.h"
 	"Scene/BsPrefabDiff.h"
 	"Scene/BsPrefabUtility.h"
+	"Scene/BsTransformHierarchy.h"
 )
 
 set(BS_BANSHEECORE_INC_INPUT
@@ -201,6 +202,8 @@ set(BS_BANSHEECORE_INC_MATERIAL
 
 set(BS_BANSHEECORE_INC_RESOURCES
 	"Resources/BsResources.h"
+	"Resources/BsResourceLoader.h"
+	"Resources/BsResourceArchive.h"
 	"Resources/BsResourceManifest.h"
 	"Resources/BsResourceHandle.h"
 	"Resources/BsResource.h"
@@ -224,6 +227,7 @@ set(BS_BANSHEECORE_INC_IMAGE
 	"Image/BsPixelData.h"
 	"Image/BsPixelUtil.h"
 	"Image/BsPixelVolume.h"
+	"Image/BsBlockCompression.h"
 )
 
 set(BS_BANSHEECORE_SRC_UTILITY
@@ -354,6 +358,7 @@ set(BS_BANSHEECORE_INC_RTTI
 	"RTTI/BsCAudioListenerRTTI.h"
 	"RTTI/BsAnimationClipRTTI.h"
 	"RTTI/BsAnimationCurveRTTI.h"
+	"RTTI/BsCompressedAnimationCurvesRTTI.h"
 	"RTTI/BsSkeletonRTTI.h"
 	"RTTI/BsCCameraRTTI.h"
 	"RTTI/BsCameraRTTI.h"
@@ -395,6 +400,8 @@ set(BS_BANSHEECORE_SRC_RESOURCES
 	"Resources/BsResourceHandle.cpp"
 	"Resources/BsResourceManifest.cpp"
 	"Resources/BsResources.cpp"
+	"Resources/BsResourceLoader.cpp"
+	"Resources/BsResourceArchive.cpp"
 	"Resources/BsResourceMetaData.cpp"
 	"Resources/BsSavedResourceData.cpp"
 	"Resources/BsIResourceListener.cpp"
@@ -413,6 +420,7 @@ set(BS_BANSHEECORE_SRC_IMAGE
 	"Image/BsPixelData.cpp"
 	"Image/BsTexture.cpp"
 	"Image/BsPixelUtil.cpp"
+	"Image/BsBlockCompression.cpp"
 )
 
 set(BS_BANSHEECORE_SRC_MATERIAL
@@ -529,6 +537,7 @@ set(BS_BANSHEECORE_SRC_SCENE
 	"Scene/BsPrefab.cpp"
 	"Scene/BsPrefabDiff.cpp"
 	"Scene/BsPrefabUtility.cpp"
+	"Scene/BsTransformHierarchy.cpp"
 )
 
 set(BS_BANSHEECORE_INC_AUDIO
@@ -561,6 +570,7 @@ set(BS_BANSHEECORE_INC_ANIMATION
 	"Animation/BsAnimationUtility.h"
 	"Animation/BsSkeletonMask.h"
 	"Animation/BsMorphShapes.h"
+	"Animation/BsCompressedAnimationCurves.h"
 )
 
 set(BS_BANSHEECORE_SRC_ANIMATION
@@ -572,6 +582,7 @@ set(BS_BANSHEECORE_SRC_ANIMATION
 	"Animation/BsAnimationUtility.cpp"
 	"Animation/BsSkeletonMask.cpp"
 	"Animation/BsMorphShapes.cpp"
+	"Animation/BsCompressedAnimationCurves.cpp"
 )
 
 set(BS_BANSHEECORE_INC_PLATFORM
@@ -602,6 +613,28 @@ if(WIN32)
 	list(APPEND BS_BANSHEECORE_SRC_PLATFORM ${BS_BANSHEECORE_SRC_PLATFORM_WIN32})
 endif()
 
+set(BS_BANSHEECORE_INC_TESTING
+	"Testing/BsAudioUtilityBenchmarkSuite.h"
+	"Testing/BsCommandQueueBenchmarkSuite.h"
+	"Testing/BsPixelConversionBenchmarkSuite.h"
+	"Testing/BsResourceArchiveBenchmarkSuite.h"
+	"Testing/BsResourceLoadBenchmarkSuite.h"
+	"Testing/BsResourceSerializationBenchmarkSuite.h"
+	"Testing/BsResourcesBenchmarkSuite.h"
+	"Testing/BsSkeletonBenchmarkSuite.h"
+)
+
+set(BS_BANSHEECORE_SRC_TESTING
+	"Testing/BsAudioUtilityBenchmarkSuite.cpp"
+	"Testing/BsCommandQueueBenchmarkSuite.cpp"
+	"Testing/BsPixelConversionBenchmarkSuite.cpp"
+	"Testing/BsResourceArchiveBenchmarkSuite.cpp"
+	"Testing/BsResourceLoadBenchmarkSuite.cpp"
+	"Testing/BsResourceSerializationBenchmarkSuite.cpp"
+	"Testing/BsResourcesBenchmarkSuite.cpp"
+	"Testing/BsSkeletonBenchmarkSuite.cpp"
+)
+
 source_group("Header Files\\Components" FILES ${BS_BANSHEECORE_INC_COMPONENTS})
 source_group("Header Files\\Physics" FILES ${BS_BANSHEECORE_INC_PHYSICS})
 source_group("Header Files\\CoreThread" FILES ${BS_BANSHEECORE_INC_CORETHREAD})
@@ -646,6 +679,8 @@ source_group("Header Files\\Image" FILES ${BS_BANSHEECORE_INC_IMAGE})
 source_group("Source Files\\Image" FILES ${BS_BANSHEECORE_SRC_IMAGE})
 source_group("Header Files\\Mesh" FILES ${BS_BANSHEECORE_INC_MESH})
 source_group("Source Files\\Mesh" FILES ${BS_BANSHEECORE_SRC_MESH})
+source_group("Header Files\\Testing" FILES ${BS_BANSHEECORE_INC_TESTING})
+source_group("Source Files\\Testing" FILES ${BS_BANSHEECORE_SRC_TESTING})
 
 set(BS_BANSHEECORE_SRC
 	${BS_BANSHEECORE_INC_COMPONENTS}
@@ -692,4 +727,6 @@ set(BS_BANSHEECORE_SRC
 	${BS_BANSHEECORE_SRC_IMAGE}
 	${BS_BANSHEECORE_INC_MESH}
 	${BS_BANSHEECORE_SRC_MESH}
+	${BS_BANSHEECORE_INC_TESTING}
+	${BS_BANSHEECORE_SRC_TESTING}
 )
\ No newline at end of file
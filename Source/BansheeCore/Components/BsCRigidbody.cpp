@@ -4,6 +4,7 @@
 #include "Scene/BsSceneObject.h"
 #include "Components/BsCCollider.h"
 #include "Components/BsCJoint.h"
+#include "Physics/BsPhysics.h"
 #include "RTTI/BsCRigidbodyRTTI.h"
 
 using namespace std::placeholders;
@@ -482,6 +483,11 @@ namespace bs
 #endif
 		}
 
+		// Don't update the transform if it's due to Physics update, as it was set from the simulation results (which
+		// might also have been interpolated)
+		if (gPhysics()._isUpdateInProgress())
+			return;
+
 		mInternal->setTransform(SO()->getWorldPosition(), SO()->getWorldRotation());
 
 		if (mParentJoint != nullptr)
@@ -7,12 +7,34 @@
 
 namespace bs
 {
+	/** Allocates a new command queue chunk, able to hold @p size bytes of commands. */
+	static CommandQueueChunk* createCommandQueueChunk(UINT32 size)
+	{
+		CommandQueueChunk* chunk = bs_new<CommandQueueChunk>();
+		chunk->data = (UINT8*)bs_alloc_aligned16(size);
+		chunk->next = chunk;
+		chunk->committed.store(0, std::memory_order_relaxed);
+		chunk->sealedSize = 0;
+
+		return chunk;
+	}
+
+	/** Frees a chunk allocated with createCommandQueueChunk(). */
+	static void destroyCommandQueueChunk(CommandQueueChunk* chunk)
+	{
+		bs_free_aligned16(chunk->data);
+		bs_delete(chunk);
+	}
+
 #if BS_DEBUG_MODE
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId), mMaxDebugIdx(0)
+		:mWritePos(0), mReadPos(0), mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
+
+		mWriteChunk = createCommandQueueChunk(CHUNK_SIZE);
+		mFlushChunk = mWriteChunk;
+		mReadChunk.store(mWriteChunk, std::memory_order_relaxed);
 
 		{
 			Lock lock(CommandQueueBreakpointMutex);
@@ -22,140 +44,188 @@ namespace bs
 	}
 #else
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId)
+		:mWritePos(0), mReadPos(0), mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
+
+		mWriteChunk = createCommandQueueChunk(CHUNK_SIZE);
+		mFlushChunk = mWriteChunk;
+		mReadChunk.store(mWriteChunk, std::memory_order_relaxed);
 	}
 #endif
 
 	CommandQueueBase::~CommandQueueBase()
 	{
-		if(mCommands != nullptr)
-			bs_delete(mCommands);
+		// Destroy commands that never got executed
+		cancelAll();
+		executeCommands(std::function<void(UINT32)>(), false);
 
-		while(!mEmptyCommandQueues.empty())
+		CommandQueueChunk* chunk = mWriteChunk;
+		do
 		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
-		}
+			CommandQueueChunk* next = chunk->next;
+			destroyCommandQueueChunk(chunk);
+
+			chunk = next;
+		} while (chunk != mWriteChunk);
 	}
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	UINT8* CommandQueueBase::allocCommand(UINT32 size, CommandExecuteFunc execute, bool notifyWhenComplete, 
+		UINT32 callbackId)
 	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
+		UINT32 commandSize = HEADER_SIZE + ((size + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1));
+		assert(commandSize + HEADER_SIZE <= CHUNK_SIZE);
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#endif
+		// Always leave enough room for the end of chunk marker
+		if(mWritePos + commandSize + HEADER_SIZE > CHUNK_SIZE)
+			advanceWriteChunk();
+
+		QueuedCommand* command = (QueuedCommand*)(mWriteChunk->data + mWritePos);
+		command->execute = execute;
+		command->size = commandSize;
+		command->callbackId = callbackId;
+		command->notifyWhenComplete = notifyWhenComplete;
 
-		mCommands->push(newCommand);
+#if BS_DEBUG_MODE
+		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
 
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
+		command->debugId = mMaxDebugIdx++;
 #endif
 
-		return newCommand.asyncOp;
+		mWritePos += commandSize;
+		return (UINT8*)command + HEADER_SIZE;
 	}
 
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	void CommandQueueBase::advanceWriteChunk()
 	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
+		// Mark the end of the chunk so the executing thread knows to move on to the next one
+		QueuedCommand* marker = (QueuedCommand*)(mWriteChunk->data + mWritePos);
+		marker->execute = nullptr;
+		marker->size = HEADER_SIZE;
+		marker->callbackId = 0;
+		marker->notifyWhenComplete = false;
+
+		mWriteChunk->sealedSize = mWritePos + HEADER_SIZE;
+
+		// Chunks following the current one have been fully executed and can be reused, unless we reached the chunk that 
+		// still contains unflushed commands, or the chunk that's currently being executed
+		CommandQueueChunk* nextChunk = mWriteChunk->next;
+		if(nextChunk == mFlushChunk || nextChunk == mReadChunk.load(std::memory_order_acquire))
+		{
+			CommandQueueChunk* newChunk = createCommandQueueChunk(CHUNK_SIZE);
+			newChunk->next = nextChunk;
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
-#endif
+			mWriteChunk->next = newChunk;
+			nextChunk = newChunk;
+		}
 
-		mCommands->push(newCommand);
+		// Executing thread will only see the new value once the current chunk is flushed
+		nextChunk->committed.store(0, std::memory_order_relaxed);
+		nextChunk->sealedSize = 0;
 
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
+		mWriteChunk = nextChunk;
+		mWritePos = 0;
 	}
 
-	bs::Queue<QueuedCommand>* CommandQueueBase::flush()
+	void CommandQueueBase::flush()
 	{
-		bs::Queue<QueuedCommand>* oldCommands = mCommands;
-
-		if(!mEmptyCommandQueues.empty())
+		// Chunks that were filled up since the last flush need to be made visible in order, as the executing thread
+		// moves to the next chunk only after it reaches the end of the previous one
+		while(mFlushChunk != mWriteChunk)
 		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
-		}
-		else
-		{
-			mCommands = bs_new<bs::Queue<QueuedCommand>>();
+			mFlushChunk->committed.store(mFlushChunk->sealedSize, std::memory_order_release);
+			mFlushChunk = mFlushChunk->next;
 		}
 
-		return oldCommands;
+		mWriteChunk->committed.store(mWritePos, std::memory_order_release);
 	}
 
-	void CommandQueueBase::playbackWithNotify(bs::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	UINT32 CommandQueueBase::playbackWithNotify(std::function<void(UINT32)> notifyCallback)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
-		if(commands == nullptr)
-			return;
+		return executeCommands(notifyCallback, true);
+	}
 
-		while(!commands->empty())
+	void CommandQueueBase::playback()
+	{
+		playbackWithNotify(std::function<void(UINT32)>());
+	}
+
+	UINT32 CommandQueueBase::executeCommands(const std::function<void(UINT32)>& notifyCallback, bool execute)
+	{
+		UINT32 numCommands = 0;
+		while(true)
 		{
-			QueuedCommand& command = commands->front();
+			CommandQueueChunk* chunk = mReadChunk.load(std::memory_order_relaxed);
+			UINT32 committed = chunk->committed.load(std::memory_order_acquire);
 
-			if(command.returnsValue)
-			{
-				AsyncOp& op = command.asyncOp;
-				command.callbackWithReturnValue(op);
-
-				if(!command.asyncOp.hasCompleted())
-				{
-					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
-						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp._completeOperation(nullptr);
-				}
-			}
-			else
-			{
-				command.callback();
-			}
+			if(mReadPos >= committed)
+				break;
 
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
+			QueuedCommand* command = (QueuedCommand*)(chunk->data + mReadPos);
+			if(command->execute == nullptr)
 			{
-				notifyCallback(command.callbackId);
+				// Reached the end of the chunk. Once we move on the queuing thread is free to reuse it.
+				mReadPos = 0;
+				mReadChunk.store(chunk->next, std::memory_order_release);
+
+				continue;
 			}
 
-			commands->pop();
-		}
+			// Advance before executing, in case the command ends up executing the queue recursively
+			mReadPos += command->size;
 
-		mEmptyCommandQueues.push(commands);
-	}
+			command->execute((UINT8*)command + HEADER_SIZE, execute);
 
-	void CommandQueueBase::playback(bs::Queue<QueuedCommand>* commands)
-	{
-		playbackWithNotify(commands, std::function<void(UINT32)>());
+			if(execute && command->notifyWhenComplete && notifyCallback != nullptr)
+				notifyCallback(command->callbackId);
+
+			numCommands++;
+		}
+
+		return numCommands;
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		bs::Queue<QueuedCommand>* commands = flush();
+		CommandQueueChunk* chunk = mFlushChunk;
+		UINT32 readPos = chunk->committed.load(std::memory_order_relaxed);
 
-		while(!commands->empty())
-			commands->pop();
+		while(true)
+		{
+			UINT32 writePos = chunk == mWriteChunk ? mWritePos : chunk->sealedSize;
+			while(readPos < writePos)
+			{
+				QueuedCommand* command = (QueuedCommand*)(chunk->data + readPos);
+				if(command->execute != nullptr)
+					command->execute((UINT8*)command + HEADER_SIZE, false);
 
-		mEmptyCommandQueues.push(commands);
+				readPos += command->size;
+			}
+
+			if(chunk == mWriteChunk)
+				break;
+
+			chunk = chunk->next;
+			readPos = 0;
+		}
+
+		mWriteChunk = mFlushChunk;
+		mWritePos = mFlushChunk->committed.load(std::memory_order_relaxed);
 	}
 
-	bool CommandQueueBase::isEmpty()
+	bool CommandQueueBase::isEmpty() const
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
-			return false;
+		CommandQueueChunk* chunk = mReadChunk.load(std::memory_order_relaxed);
+		return mReadPos >= chunk->committed.load(std::memory_order_acquire);
+	}
 
-		return true;
+	void CommandQueueBase::_resolveUnresolvedOp(AsyncOp& asyncOp)
+	{
+		LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+			"Make sure to complete the operation before returning from the command callback method.");
+		asyncOp._completeOperation(nullptr);
 	}
 
 	void CommandQueueBase::throwInvalidThreadException(const String& message) const
@@ -4,7 +4,9 @@
 
 #include "BsCorePrerequisites.h"
 #include "Threading/BsAsyncOp.h"
+#include "Threading/BsSpinLock.h"
 #include <functional>
+#include <atomic>
 
 namespace bs
 {
@@ -33,14 +35,13 @@ namespace bs
 
 	/**
 	 * Command queue policy that provides synchonization. Should be used with command queues that are used on multiple 
-	 * threads.
+	 * threads. Only the threads queuing commands are synchronized between each other, the thread executing the commands
+	 * never needs to acquire the lock.
 	 */
 	class CommandQueueSync
 	{
 	public:
-		CommandQueueSync()
-			:mLock(mCommandQueueMutex, std::defer_lock)
-		{ }
+		CommandQueueSync() { }
 		virtual ~CommandQueueSync() {}
 
 		bool isValidThread(ThreadId ownerThread) const
@@ -59,83 +60,92 @@ namespace bs
 		}
 
 	private:
-		Mutex mCommandQueueMutex;
-		Lock mLock;
+		SpinLock mLock;
 	};
 
 	/**
-	 * Represents a single queued command in the command list. Contains all the data for executing the command and checking 
-	 * up on the command status.
+	 * Function that executes (optionally) and then destroys a command stored in the command queue.
+	 *
+	 * @param[in]	data		Memory the command was constructed in.
+	 * @param[in]	execute		If true the command will be executed before it is destroyed.
+	 */
+	typedef void(*CommandExecuteFunc)(UINT8* data, bool execute);
+
+	/**
+	 * Header of a single queued command in the command queue. Command data immediately follows the header in queue's 
+	 * memory.
 	 */
 	struct QueuedCommand
 	{
-#if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: debugId(_debugId), callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true)
-			, callbackId(_callbackId), notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		/** Executes and destroys the command data. Null for the marker at the end of a queue chunk. */
+		CommandExecuteFunc execute;
 
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:debugId(_debugId), callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		/** Size of the header and the command data following it, in bytes. */
+		UINT32 size;
+		UINT32 callbackId;
+		bool notifyWhenComplete;
 
+#if BS_DEBUG_MODE
 		UINT32 debugId;
-#else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callbackWithReturnValue(_callback), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), 
-			callbackId(_callbackId), asyncOp(asyncOpSyncData)
-		{ }
-
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callback(_callback), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(AsyncOpEmpty())
-		{ }
 #endif
+	};
 
-		~QueuedCommand()
+	/** Data of a queued command that doesn't return a value. */
+	template<class T>
+	struct CommandPayload
+	{
+		template<class F>
+		CommandPayload(F&& callback)
+			:callback(std::forward<F>(callback))
 		{ }
 
-		QueuedCommand(const QueuedCommand& source)
+		void operator()()
 		{
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
-			asyncOp = source.asyncOp;
-			returnsValue = source.returnsValue;
-			callbackId = source.callbackId;
-			notifyWhenComplete = source.notifyWhenComplete;
-
-#if BS_DEBUG_MODE
-			debugId = source.debugId;
-#endif
+			callback();
 		}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
-		{
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
-			asyncOp = rhs.asyncOp;
-			returnsValue = rhs.returnsValue;
-			callbackId = rhs.callbackId;
-			notifyWhenComplete = rhs.notifyWhenComplete;
-			
-#if BS_DEBUG_MODE
-			debugId = rhs.debugId;
-#endif
+		T callback;
+	};
 
-			return *this;
-		}
+	/** Data of a queued command that returns a value through an AsyncOp. */
+	template<class T>
+	struct ReturnCommandPayload
+	{
+		template<class F>
+		ReturnCommandPayload(F&& callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData)
+			:callback(std::forward<F>(callback)), asyncOp(asyncOpSyncData)
+		{ }
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
+		void operator()();
+
+		T callback;
 		AsyncOp asyncOp;
-		bool returnsValue;
-		UINT32 callbackId;
-		bool notifyWhenComplete;
 	};
 
-	/** Manages a list of commands that can be queued for later execution on the core thread. */
+	/** 
+	 * Block of memory that queued commands are stored in. Chunks used by a command queue are linked in a ring and reused
+	 * once all of their commands execute.
+	 */
+	struct CommandQueueChunk
+	{
+		UINT8* data;
+		CommandQueueChunk* next;
+
+		/** Number of bytes in the chunk that were flushed and are ready to be executed. */
+		std::atomic<UINT32> committed;
+
+		/** Number of bytes written to the chunk before it was filled up. Only accessed by the queuing thread. */
+		UINT32 sealedSize;
+	};
+
+	/** 
+	 * Manages a list of commands that can be queued for later execution on the core thread. 
+	 *
+	 * Commands are stored in-place in a ring of memory chunks, meaning no allocations are made when queuing commands
+	 * once the queue reaches its working size. Commands become visible to the executing thread once flush() is called,
+	 * after which they can be executed using playback(). A single thread may queue commands while another executes them
+	 * without requiring any locks.
+	 */
 	class BS_CORE_EXPORT CommandQueueBase
 	{
 	public:
@@ -156,16 +166,17 @@ namespace bs
 		ThreadId getThreadId() const { return mMyThreadId; }
 
 		/**
-		 * Executes all provided commands one by one in order. To get the commands you should call flush().
+		 * Executes all flushed commands one by one in order. Commands can be executed on a different thread than the one
+		 * they were queued on.
 		 *
-		 * @param[in]	commands			Commands to execute.
 		 * @param[in]	notifyCallback  	Callback that will be called if a command that has @p notifyOnComplete flag set.
 		 * 									The callback will receive @p callbackId of the command.
+		 * @return							Number of executed commands.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		UINT32 playbackWithNotify(std::function<void(UINT32)> notifyCallback);
 
-		/** Executes all provided commands one by one in order. To get the commands you should call flush(). */
-		void playback(Queue<QueuedCommand>* commands);
+		/** Executes all flushed commands one by one in order. */
+		void playback();
 
 		/**
 		 * Allows you to set a breakpoint that will trigger when the specified command is executed.		
@@ -186,7 +197,8 @@ namespace bs
 		 * Last parameter must be unbound and of AsyncOp& type. This is used to signal that the command is completed, and 
 		 * also for storing the return value.		
 		 *
-		 * @param[in]	commandCallback		Command to queue for execution.
+		 * @param[in]	commandCallback		Command to queue for execution. Any callable object, stored in the queue by
+		 *									value.
 		 * @param[in]	_notifyWhenComplete	(optional) Call the notify method (provided in the call to playback())
 		 * 									when the command is complete.
 		 * @param[in]	_callbackId			(optional) Identifier for the callback so you can then later find it
@@ -200,32 +212,68 @@ namespace bs
 		 * Callback method also needs to call AsyncOp::markAsResolved once it is done processing. (If it doesn't it will 
 		 * still be called automatically, but the return value will default to nullptr)
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class F>
+		AsyncOp queueReturn(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef ReturnCommandPayload<typename std::decay<F>::type> Payload;
+
+			Payload* payload = emplaceCommand<Payload>(_notifyWhenComplete, _callbackId, 
+				std::forward<F>(commandCallback), mAsyncOpSyncData);
+			AsyncOp asyncOp = payload->asyncOp;
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			flush();
+			playback();
+#endif
+
+			return asyncOp;
+		}
 
 		/**
 		 * Queue up a new command to execute. Make sure the provided function has all of its parameters properly bound. 
 		 * Provided command is not expected to return a value. If you wish to return a value from the callback use the 
 		 * queueReturn() which accepts an AsyncOp parameter.
 		 *
-		 * @param[in]	commandCallback		Command to queue for execution.
+		 * @param[in]	commandCallback		Command to queue for execution. Any callable object, stored in the queue by
+		 *									value.
 		 * @param[in]	_notifyWhenComplete	(optional) Call the notify method (provided in the call to playback())
 		 * 									when the command is complete.
 		 * @param[in]	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 									it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class F>
+		void queue(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef CommandPayload<typename std::decay<F>::type> Payload;
+
+			emplaceCommand<Payload>(_notifyWhenComplete, _callbackId, std::forward<F>(commandCallback));
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			flush();
+			playback();
+#endif
+		}
 
 		/**
-		 * Returns a copy of all queued commands and makes room for new ones. Must be called from the thread that created 
-		 * the command queue. Returned commands must be passed to playback() method.
+		 * Makes all commands queued so far available for execution by playback(). Must be called from the thread that 
+		 * queues the commands.
 		 */
-		Queue<QueuedCommand>* flush();
+		void flush();
 
-		/** Cancels all currently queued commands. */
+		/** Cancels all queued commands that haven't been flushed yet. */
 		void cancelAll();
 
-		/**	Returns true if no commands are queued. */
-		bool isEmpty();
+		/**
+		 * Returns true if there are no flushed commands waiting to be executed. Should be called from the thread that
+		 * executes the commands.
+		 */
+		bool isEmpty() const;
+
+		/** 
+		 * Resolves the async operation of a command that didn't resolve it itself. Used primarily so we can avoid
+		 * including debug includes in this header.
+		 */
+		static void _resolveUnresolvedOp(AsyncOp& asyncOp);
 
 	protected:
 		/**
@@ -235,8 +283,101 @@ namespace bs
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		Queue<QueuedCommand>* mCommands;
-		Stack<Queue<QueuedCommand>*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
+		/** Size of a single chunk of memory commands are stored in, in bytes. */
+		static const UINT32 CHUNK_SIZE = 64 * 1024;
+
+		/** Alignment of all commands stored in the queue. */
+		static const UINT32 COMMAND_ALIGNMENT = 16;
+
+		/** Size of the command header, including padding required for the command data that follows. */
+		static const UINT32 HEADER_SIZE = (sizeof(QueuedCommand) + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+
+		/** Commands with data larger than this will be allocated separately, and only a pointer stored in the queue. */
+		static const UINT32 MAX_INLINE_COMMAND_SIZE = CHUNK_SIZE / 4;
+
+		/** Constructs a new command of the provided type at the end of the queue. */
+		template<class T, class... Args>
+		T* emplaceCommand(bool notifyWhenComplete, UINT32 callbackId, Args&&... args)
+		{
+			static const bool isInline = sizeof(T) <= MAX_INLINE_COMMAND_SIZE && alignof(T) <= COMMAND_ALIGNMENT;
+
+			if(isInline)
+			{
+				UINT8* data = allocCommand(sizeof(T), &executeCommand<T>, notifyWhenComplete, callbackId);
+				return new (data) T(std::forward<Args>(args)...);
+			}
+			else
+			{
+				UINT8* data = allocCommand(sizeof(T*), &executeIndirectCommand<T>, notifyWhenComplete, callbackId);
+
+				T* command = bs_new<T>(std::forward<Args>(args)...);
+				memcpy(data, &command, sizeof(T*));
+
+				return command;
+			}
+		}
+
+		/** 
+		 * Allocates room for a command at the end of the queue and initializes its header.
+		 *
+		 * @param[in]	size				Size of the command data, in bytes.
+		 * @param[in]	execute				Function that executes and destroys the command data.
+		 * @param[in]	notifyWhenComplete	Should the notify callback be triggered when the command completes.
+		 * @param[in]	callbackId			Identifier passed to the notify callback.
+		 * @return							Memory to construct the command data in.
+		 */
+		UINT8* allocCommand(UINT32 size, CommandExecuteFunc execute, bool notifyWhenComplete, UINT32 callbackId);
+
+		/**
+		 * Executes or destroys all flushed commands.
+		 *
+		 * @param[in]	notifyCallback		Callback to trigger for commands that have the notify flag set.
+		 * @param[in]	execute				If false the commands will be destroyed without executing them.
+		 * @return							Number of processed commands.
+		 */
+		UINT32 executeCommands(const std::function<void(UINT32)>& notifyCallback, bool execute);
+
+		/** 
+		 * Fills up the chunk commands are currently being written to, and moves on to the next one. Allocates a new 
+		 * chunk if no free chunks are available.
+		 */
+		void advanceWriteChunk();
+
+		/** Executes and destroys a command stored in the queue. */
+		template<class T>
+		static void executeCommand(UINT8* data, bool execute)
+		{
+			T* command = (T*)data;
+
+			if(execute)
+				(*command)();
+
+			command->~T();
+		}
+
+		/** Executes and destroys a command stored outside of the queue. */
+		template<class T>
+		static void executeIndirectCommand(UINT8* data, bool execute)
+		{
+			T* command;
+			memcpy(&command, data, sizeof(T*));
+
+			if(execute)
+				(*command)();
+
+			bs_delete(command);
+		}
+
+		// Only accessed by the thread queuing commands
+		CommandQueueChunk* mWriteChunk;
+		UINT32 mWritePos;
+		CommandQueueChunk* mFlushChunk; /**< First chunk containing commands that haven't been flushed yet. */
+
+		// Only accessed by the thread executing commands
+		UINT32 mReadPos;
+
+		/** Chunk currently being executed. Written by the executing thread, read by the queuing thread. */
+		std::atomic<CommandQueueChunk*> mReadChunk;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 		ThreadId mMyThreadId;
@@ -280,6 +421,15 @@ namespace bs
 #endif
 	};
 
+	template<class T>
+	void ReturnCommandPayload<T>::operator()()
+	{
+		callback(asyncOp);
+
+		if(!asyncOp.hasCompleted())
+			CommandQueueBase::_resolveUnresolvedOp(asyncOp);
+	}
+
 	/**
 	 * @copydoc CommandQueueBase
 	 * 			
@@ -299,7 +449,8 @@ namespace bs
 		{ }
 
 		/** @copydoc CommandQueueBase::queueReturn */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class F>
+		AsyncOp queueReturn(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -309,14 +460,16 @@ namespace bs
 #endif
 
 			this->lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
+			AsyncOp asyncOp = CommandQueueBase::queueReturn(std::forward<F>(commandCallback), _notifyWhenComplete, 
+				_callbackId);
 			this->unlock();
 
 			return asyncOp;
 		}
 
 		/** @copydoc CommandQueueBase::queue */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class F>
+		void queue(F&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -326,12 +479,12 @@ namespace bs
 #endif
 
 			this->lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
+			CommandQueueBase::queue(std::forward<F>(commandCallback), _notifyWhenComplete, _callbackId);
 			this->unlock();
 		}
 
 		/** @copydoc CommandQueueBase::flush */
-		bs::Queue<QueuedCommand>* flush()
+		void flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -341,10 +494,8 @@ namespace bs
 #endif
 
 			this->lock();
-			bs::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
+			CommandQueueBase::flush();
 			this->unlock();
-
-			return commands;
 		}
 
 		/** @copydoc CommandQueueBase::cancelAll */
@@ -362,22 +513,6 @@ namespace bs
 			this->unlock();
 		}
 
-		/** @copydoc CommandQueueBase::isEmpty */
-		bool isEmpty()
-		{
-#if BS_DEBUG_MODE
-#if BS_THREAD_SUPPORT != 0
-			if(!this->isValidThread(getThreadId()))
-				throwInvalidThreadException("Command queue accessed outside of its creation thread.");
-#endif
-#endif
-
-			this->lock();
-			bool empty = CommandQueueBase::isEmpty();
-			this->unlock();
-
-			return empty;
-		}
 	};
 
 	/** @} */
@@ -150,6 +150,7 @@ namespace bs
 		volatile UINT8 mFlags;
 		UINT32 mCoreDirtyFlags;
 		UINT64 mInternalID; // ID == 0 is not a valid ID
+		UINT32 mManagerIdx; // Index of the object's slot in CoreObjectManager
 		std::weak_ptr<CoreObject> mThis;
 
 		/**
@@ -21,7 +21,7 @@ namespace bs
 #if BS_DEBUG_MODE
 		Lock lock(mObjectsMutex);
 
-		if(mObjects.size() > 0)
+		if(mObjects.size() > mFreeSlots.size())
 		{
 			// All objects MUST be destroyed at this point, otherwise there might be memory corruption.
 			// (Reason: This is called on application shutdown and at that point we also unload any dynamic libraries, 
@@ -39,8 +39,23 @@ namespace bs
 
 		Lock lock(mObjectsMutex);
 
-		mObjects[mNextAvailableID] = object;
-		mDirtyObjects[mNextAvailableID] = { object, -1 };
+		UINT32 slotIdx;
+		if(!mFreeSlots.empty())
+		{
+			slotIdx = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+		else
+		{
+			slotIdx = (UINT32)mObjects.size();
+			mObjects.push_back(ObjectSlot());
+		}
+
+		mObjects[slotIdx].object = object;
+		object->mManagerIdx = slotIdx;
+		object->mInternalID = mNextAvailableID;
+
+		addDirtyObject(object);
 
 		return mNextAvailableID++;
 	}
@@ -54,10 +69,15 @@ namespace bs
 		// If dirty, we generate sync data before it is destroyed
 		{
 			Lock lock(mObjectsMutex);
-			bool isDirty = object->isCoreDirty() || (mDirtyObjects.find(internalId) != mDirtyObjects.end());
+
+			ObjectSlot& slot = mObjects[object->mManagerIdx];
+			bool isDirty = object->isCoreDirty() || slot.dirtyIdx != -1;
 
 			if (isDirty)
 			{
+				addDirtyObject(object);
+				DirtyObjectData& dirtyObjData = mDirtyObjects[slot.dirtyIdx];
+
 				SPtr<ct::CoreObject> coreObject = object->getCore();
 				if (coreObject != nullptr)
 				{
@@ -65,19 +85,17 @@ namespace bs
 				
 					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
 
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
 					dirtyObjData.object = nullptr;
 				}
 				else
 				{
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = -1;
 					dirtyObjData.object = nullptr;
 				}
-			}
 
-			mObjects.erase(internalId);
+				slot.dirtyIdx = -1;
+			}
 		}
 
 		updateDependencies(object, nullptr);
@@ -86,40 +104,70 @@ namespace bs
 		{
 			Lock lock(mObjectsMutex);
 
-			auto iterFind = mDependants.find(internalId);
-			if (iterFind != mDependants.end())
+			ObjectSlot& slot = mObjects[object->mManagerIdx];
+			for (auto& entry : slot.dependants)
 			{
-				Vector<CoreObject*>& dependants = iterFind->second;
-				for (auto& entry : dependants)
-				{
-					auto iterFind2 = mDependencies.find(entry->getInternalID());
-					if (iterFind2 != mDependencies.end())
-					{
-						Vector<CoreObject*>& dependencies = iterFind2->second;
-						auto iterFind3 = std::find(dependencies.begin(), dependencies.end(), object);
-
-						if (iterFind3 != dependencies.end())
-							dependencies.erase(iterFind3);
-
-						if (dependencies.size() == 0)
-							mDependencies.erase(iterFind2);
-					}
-				}
+				ObjectSlot* dependantSlot = getSlot(entry);
+				if (dependantSlot == nullptr)
+					continue;
+
+				Vector<CoreObject*>& dependencies = dependantSlot->dependencies;
+				auto iterFind = std::find(dependencies.begin(), dependencies.end(), object);
 
-				mDependants.erase(iterFind);
+				if (iterFind != dependencies.end())
+					dependencies.erase(iterFind);
 			}
 
-			mDependencies.erase(internalId);
+			slot.object = nullptr;
+			slot.dirtyIdx = -1;
+			slot.dependencies.clear();
+			slot.dependants.clear();
+
+			mFreeSlots.push_back(object->mManagerIdx);
 		}
 	}
 
 	void CoreObjectManager::notifyCoreDirty(CoreObject* object)
 	{
-		UINT64 id = object->getInternalID();
-
 		Lock lock(mObjectsMutex);
 
-		mDirtyObjects[id] = { object, -1 };
+		addDirtyObject(object);
+	}
+
+	void CoreObjectManager::addDirtyObject(CoreObject* object)
+	{
+		ObjectSlot& slot = mObjects[object->mManagerIdx];
+		if (slot.dirtyIdx != -1)
+			return;
+
+		slot.dirtyIdx = (INT32)mDirtyObjects.size();
+		mDirtyObjects.push_back({ object, -1, object->getInternalID() });
+	}
+
+	void CoreObjectManager::removeDirtyObject(CoreObject* object)
+	{
+		ObjectSlot& slot = mObjects[object->mManagerIdx];
+		if (slot.dirtyIdx == -1)
+			return;
+
+		// Leave the entry in the list so other indices remain valid, it will be skipped during sync
+		DirtyObjectData& dirtyObjData = mDirtyObjects[slot.dirtyIdx];
+		dirtyObjData.object = nullptr;
+		dirtyObjData.syncDataId = -1;
+
+		slot.dirtyIdx = -1;
+	}
+
+	CoreObjectManager::ObjectSlot* CoreObjectManager::getSlot(CoreObject* object)
+	{
+		if (object->mManagerIdx >= (UINT32)mObjects.size())
+			return nullptr;
+
+		ObjectSlot& slot = mObjects[object->mManagerIdx];
+		if (slot.object != object)
+			return nullptr;
+
+		return &slot;
 	}
 
 	void CoreObjectManager::notifyDependenciesDirty(CoreObject* object)
@@ -132,8 +180,6 @@ namespace bs
 
 	void CoreObjectManager::updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies)
 	{
-		UINT64 id = object->getInternalID();
-
 		bs_frame_mark();
 		{
 			FrameVector<CoreObject*> toRemove;
@@ -141,70 +187,54 @@ namespace bs
 
 			Lock lock(mObjectsMutex);
 
-			// Add dependencies and clear old dependencies from dependants
+			ObjectSlot* slot = getSlot(object);
+			if (slot != nullptr)
 			{
+				// Add dependencies and clear old dependencies from dependants
 				if (dependencies != nullptr)
 					std::sort(dependencies->begin(), dependencies->end());
 
-				auto iterFind = mDependencies.find(id);
-				if (iterFind != mDependencies.end())
+				const Vector<CoreObject*>& oldDependencies = slot->dependencies;
+				if (dependencies != nullptr)
 				{
-					const Vector<CoreObject*>& oldDependencies = iterFind->second;
-
-					if (dependencies != nullptr)
-					{
-						std::set_difference(oldDependencies.begin(), oldDependencies.end(),
-							dependencies->begin(), dependencies->end(), std::inserter(toRemove, toRemove.begin()));
-
-						std::set_difference(dependencies->begin(), dependencies->end(),
-							oldDependencies.begin(), oldDependencies.end(), std::inserter(toAdd, toAdd.begin()));
-					}
-					else
-					{
-						for (auto& dependency : oldDependencies)
-							toRemove.push_back(dependency);
-					}
-
-					for (auto& dependency : toRemove)
-					{
-						UINT64 dependencyId = dependency->getInternalID();
-						auto iterFind2 = mDependants.find(dependencyId);
-
-						if (iterFind2 != mDependants.end())
-						{
-							Vector<CoreObject*>& dependants = iterFind2->second;
-							auto findIter3 = std::find(dependants.begin(), dependants.end(), object);
-							dependants.erase(findIter3);
-
-							if (dependants.size() == 0)
-								mDependants.erase(iterFind2);
-						}
-					}
-
-					if (dependencies != nullptr && dependencies->size() > 0)
-						mDependencies[id] = *dependencies;
-					else
-						mDependencies.erase(id);
+					std::set_difference(oldDependencies.begin(), oldDependencies.end(),
+						dependencies->begin(), dependencies->end(), std::inserter(toRemove, toRemove.begin()));
+
+					std::set_difference(dependencies->begin(), dependencies->end(),
+						oldDependencies.begin(), oldDependencies.end(), std::inserter(toAdd, toAdd.begin()));
 				}
 				else
 				{
-					if (dependencies != nullptr && dependencies->size() > 0)
-					{
-						for (auto& dependency : *dependencies)
-							toAdd.push_back(dependency);
+					for (auto& dependency : oldDependencies)
+						toRemove.push_back(dependency);
+				}
+
+				for (auto& dependency : toRemove)
+				{
+					ObjectSlot* dependencySlot = getSlot(dependency);
+					if (dependencySlot == nullptr)
+						continue;
 
-						mDependencies[id] = *dependencies;
-					}
+					Vector<CoreObject*>& dependants = dependencySlot->dependants;
+					auto findIter = std::find(dependants.begin(), dependants.end(), object);
+
+					if (findIter != dependants.end())
+						dependants.erase(findIter);
 				}
-			}
 
-			// Register dependants
-			{
+				if (dependencies != nullptr)
+					slot->dependencies = *dependencies;
+				else
+					slot->dependencies.clear();
+
+				// Register dependants
 				for (auto& dependency : toAdd)
 				{
-					UINT64 dependencyId = dependency->getInternalID();
-					Vector<CoreObject*>& dependants = mDependants[dependencyId];
-					dependants.push_back(object);
+					ObjectSlot* dependencySlot = getSlot(dependency);
+					if (dependencySlot == nullptr)
+						continue;
+
+					dependencySlot->dependants.push_back(object);
 				}
 			}
 		}
@@ -240,13 +270,10 @@ namespace bs
 			// Note: I don't check for recursion. Possible infinite loop if two objects
 			// are dependent on one another.
 
-			UINT64 id = curObj->getInternalID();
-			auto iterFind = mDependencies.find(id);
-
-			if (iterFind != mDependencies.end())
+			ObjectSlot* slot = getSlot(curObj);
+			if (slot != nullptr)
 			{
-				const Vector<CoreObject*>& dependencies = iterFind->second;
-				for (auto& dependency : dependencies)
+				for (auto& dependency : slot->dependencies)
 					syncObject(dependency);
 			}
 
@@ -254,7 +281,7 @@ namespace bs
 			if (objectCore == nullptr)
 			{
 				curObj->markCoreClean();
-				mDirtyObjects.erase(id);
+				removeDirtyObject(curObj);
 				return;
 			}
 
@@ -265,7 +292,7 @@ namespace bs
 			data.syncData = curObj->syncToCore(allocator);
 
 			curObj->markCoreClean();
-			mDirtyObjects.erase(id);
+			removeDirtyObject(curObj);
 		};
 
 		syncObject(object);
@@ -300,81 +327,71 @@ namespace bs
 		syncData.alloc = allocator;
 		
 		// Add all objects dependant on the dirty objects
-		bs_frame_mark();
+		UINT32 numDirtyObjects = (UINT32)mDirtyObjects.size();
+		for (UINT32 i = 0; i < numDirtyObjects; i++)
 		{
-			FrameSet<CoreObject*> dirtyDependants;
-			for (auto& objectData : mDirtyObjects)
+			CoreObject* object = mDirtyObjects[i].object;
+			if (object == nullptr)
+				continue;
+
+			const ObjectSlot& slot = mObjects[object->mManagerIdx];
+			for (auto& dependant : slot.dependants)
 			{
-				auto iterFind = mDependants.find(objectData.first);
-				if (iterFind != mDependants.end())
+				if (!dependant->isCoreDirty())
 				{
-					const Vector<CoreObject*>& dependants = iterFind->second;
-					for (auto& dependant : dependants)
-					{
-						if (!dependant->isCoreDirty())
-						{
-							dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
-							dirtyDependants.insert(dependant);
-						}
-					}
+					dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
+					addDirtyObject(dependant);
 				}
 			}
-
-			for (auto& dirtyDependant : dirtyDependants)
-			{
-				UINT64 id = dirtyDependant->getInternalID();
-
-				mDirtyObjects[id] = { dirtyDependant, -1 };
-			}
 		}
 
-		bs_frame_clear();
-		
 		// Order in which objects are recursed in matters, ones with lower ID will have been created before
 		// ones with higher ones and should be updated first.
-		for (auto& objectData : mDirtyObjects)
-		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
-			{
-				if (!curObj->isCoreDirty())
-					return; // We already processed it as some other object's dependency
-
-				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
-				UINT64 id = curObj->getInternalID();
-				auto iterFind = mDependencies.find(id);
+		std::sort(mDirtyObjects.begin(), mDirtyObjects.end(), 
+			[](const DirtyObjectData& a, const DirtyObjectData& b) { return a.internalId < b.internalId; });
 
-				if (iterFind != mDependencies.end())
-				{
-					const Vector<CoreObject*>& dependencies = iterFind->second;
-					for (auto& dependency : dependencies)
-						syncObject(dependency);
-				}
+		std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+		{
+			if (!curObj->isCoreDirty())
+				return; // We already processed it as some other object's dependency
 
-				SPtr<ct::CoreObject> objectCore = curObj->getCore();
-				if (objectCore == nullptr)
-				{
-					curObj->markCoreClean();
-					return;
-				}
+			// Sync dependencies before dependants
+			// Note: I don't check for recursion. Possible infinite loop if two objects
+			// are dependent on one another.
+			ObjectSlot* slot = getSlot(curObj);
+			if (slot != nullptr)
+			{
+				for (auto& dependency : slot->dependencies)
+					syncObject(dependency);
+			}
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
+			SPtr<ct::CoreObject> objectCore = curObj->getCore();
+			if (objectCore == nullptr)
+			{
 				curObj->markCoreClean();
+				return;
+			}
+
+			CoreSyncData objSyncData = curObj->syncToCore(allocator);
+			curObj->markCoreClean();
 
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
-			};
+			syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
+				curObj->getInternalID(), objSyncData));
+		};
 
-			CoreObject* object = objectData.second.object;
+		for (auto& objectData : mDirtyObjects)
+		{
+			CoreObject* object = objectData.object;
 			if (object != nullptr)
+			{
 				syncObject(object);
+				mObjects[object->mManagerIdx].dirtyIdx = -1;
+			}
 			else
 			{
 				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+				if (objectData.syncDataId != -1)
+					syncData.entries.push_back(mDestroyedSyncData[objectData.syncDataId]);
 			}
 		}
 
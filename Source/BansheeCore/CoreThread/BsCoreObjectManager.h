@@ -55,8 +55,18 @@ namespace bs
 		/** Contains information about a dirty CoreObject that requires syncing to the core thread. */	
 		struct DirtyObjectData
 		{
-			CoreObject* object;
+			CoreObject* object; /**< Dirty object, or null if the object was destroyed or already synced. */
 			INT32 syncDataId;
+			UINT64 internalId;
+		};
+
+		/** Contains information about a single registered CoreObject. */
+		struct ObjectSlot
+		{
+			CoreObject* object = nullptr;
+			INT32 dirtyIdx = -1; /**< Index of the object's entry in the dirty object list, or -1 if not dirty. */
+			Vector<CoreObject*> dependencies; /**< Objects this object depends on, sorted by address. */
+			Vector<CoreObject*> dependants; /**< Objects depending on this object. */
 		};
 
 	public:
@@ -121,11 +131,19 @@ namespace bs
 		 */
 		void updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies);
 
+		/** Adds the object to the dirty object list, unless already present. */
+		void addDirtyObject(CoreObject* object);
+
+		/** Removes the object from the dirty object list, if present. */
+		void removeDirtyObject(CoreObject* object);
+
+		/** Returns the slot of a registered object, or null if the object isn't registered. */
+		ObjectSlot* getSlot(CoreObject* object);
+
 		UINT64 mNextAvailableID;
-		Map<UINT64, CoreObject*> mObjects;
-		Map<UINT64, DirtyObjectData> mDirtyObjects;
-		Map<UINT64, Vector<CoreObject*>> mDependencies;
-		Map<UINT64, Vector<CoreObject*>> mDependants;
+		Vector<ObjectSlot> mObjects;
+		Vector<UINT32> mFreeSlots;
+		Vector<DirtyObjectData> mDirtyObjects;
 
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
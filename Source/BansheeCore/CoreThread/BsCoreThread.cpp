@@ -16,6 +16,7 @@ namespace bs
 	CoreThread::CoreThread()
 		: mActiveFrameAlloc(0)
 		, mCoreThreadShutdown(false)
+		, mCoreThreadSleeping(false)
 		, mCoreThreadStarted(false)
 		, mCommandQueue(nullptr)
 		, mMaxCommandNotifyId(0)
@@ -93,29 +94,30 @@ namespace bs
 
 		while(true)
 		{
-			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
-			{
-				Lock lock(mCommandQueueMutex);
+			// Play commands
+			if(mCommandQueue->playbackWithNotify(std::bind(&CoreThread::commandCompletedNotify, this, _1)) > 0)
+				continue;
 
-				while(mCommandQueue->isEmpty())
+			// Wait until we get some ready commands. Queuing threads only signal us once we're marked as sleeping.
+			Lock lock(mCommandQueueMutex);
+
+			mCoreThreadSleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			while(mCommandQueue->isEmpty())
+			{
+				if(mCoreThreadShutdown)
 				{
-					if(mCoreThreadShutdown)
-					{
-						TaskScheduler::instance().addWorker();
-						return;
-					}
-
-					TaskScheduler::instance().addWorker(); // Do something else while we wait, otherwise this core will be unused
-					mCommandReadyCondition.wait(lock);
-					TaskScheduler::instance().removeWorker();
+					TaskScheduler::instance().addWorker();
+					return;
 				}
 
-				commands = mCommandQueue->flush();
+				TaskScheduler::instance().addWorker(); // Do something else while we wait, otherwise this core will be unused
+				mCommandReadyCondition.wait(lock);
+				TaskScheduler::instance().removeWorker();
 			}
 
-			// Play commands
-			mCommandQueue->playbackWithNotify(commands, std::bind(&CoreThread::commandCompletedNotify, this, _1)); 
+			mCoreThreadSleeping.store(false, std::memory_order_relaxed);
 		}
 #endif
 	}
@@ -184,67 +186,23 @@ namespace bs
 		getQueue()->submitToCoreThread(blockUntilComplete);
 	}
 
-	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
+	void CoreThread::submitInternalCommands(bool blockUntilComplete, UINT32 commandId)
 	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+		mCommandQueue->flush();
 
-		if (!flags.isSet(CTQF_InternalQueue))
-			return getQueue()->queueReturnCommand(commandCallback);
-		else
+		// Only wake the core thread if it went to sleep, otherwise it will pick up the commands on its own
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (mCoreThreadSleeping.load(std::memory_order_relaxed))
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			AsyncOp op;
-			UINT32 commandId = -1;
 			{
 				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
-				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
 			}
 
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-
-			return op;
+			mCommandReadyCondition.notify_one();
 		}
-	}
-
-	void CoreThread::queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
-	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			getQueue()->queueCommand(commandCallback);
-		else
-		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
 
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
-				}
-				else
-					mCommandQueue->queue(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-		}
+		if (blockUntilComplete)
+			blockUntilCommandCompleted(commandId);
 	}
 
 	void CoreThread::update()
@@ -53,7 +53,9 @@ namespace bs
 	 *    - Commands queued on the per-thread queues are submitted to the internal command queue by calling submit(), at
 	 *      which point they are made visible to the core thread, and will begin executing.
 	 * 	  - Commands can also be submitted directly to the internal command queue (via a special flag), but with a 
-	 * 	    performance cost due to extra synchronization required.
+	 * 	    performance cost due to extra synchronization required between the queuing threads.
+	 *   - Commands are stored in-place in the queues, and the core thread reads them without locking. The core thread
+	 *     only needs to be signaled when it runs out of commands and goes to sleep.
 	 */
 	class BS_CORE_EXPORT CoreThread : public Module<CoreThread>
 	{
@@ -96,7 +98,32 @@ namespace bs
 		 * @see		CommandQueue::queueReturn()
 		 * @note	Thread safe
 		 */
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class F>
+		AsyncOp queueReturnCommand(F&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && 
+				"Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				return getQueue()->queueReturnCommand(std::forward<F>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				AsyncOp op;
+				UINT32 commandId = -1;
+				if (blockUntilComplete)
+				{
+					commandId = mMaxCommandNotifyId.fetch_add(1, std::memory_order_relaxed);
+					op = mCommandQueue->queueReturn(std::forward<F>(commandCallback), true, commandId);
+				}
+				else
+					op = mCommandQueue->queueReturn(std::forward<F>(commandCallback));
+
+				submitInternalCommands(blockUntilComplete, commandId);
+				return op;
+			}
+		}
 
 		/**
 		 * Queues a new command that will be added to the global command queue. 
@@ -107,7 +134,30 @@ namespace bs
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class F>
+		void queueCommand(F&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && 
+				"Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				getQueue()->queueCommand(std::forward<F>(commandCallback));
+			else
+			{
+				bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+
+				UINT32 commandId = -1;
+				if (blockUntilComplete)
+				{
+					commandId = mMaxCommandNotifyId.fetch_add(1, std::memory_order_relaxed);
+					mCommandQueue->queue(std::forward<F>(commandCallback), true, commandId);
+				}
+				else
+					mCommandQueue->queue(std::forward<F>(commandCallback));
+
+				submitInternalCommands(blockUntilComplete, commandId);
+			}
+		}
 
 		/**
 		 * Called once every frame.
@@ -153,6 +203,7 @@ namespace bs
 		Vector<ThreadQueueContainer*> mAllQueues;
 
 		volatile bool mCoreThreadShutdown;
+		std::atomic<bool> mCoreThreadSleeping; /**< True if the core thread is waiting for commands to be queued. */
 
 		HThread mCoreThread;
 		bool mCoreThreadStarted;
@@ -168,7 +219,7 @@ namespace bs
 
 		CommandQueue<CommandQueueSync>* mCommandQueue;
 
-		UINT32 mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
+		std::atomic<UINT32> mMaxCommandNotifyId; /**< ID assigned to the next command with a notifier callback. */
 		Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
 
 		/** Starts the core thread worker method. Should only be called once. */
@@ -183,6 +234,16 @@ namespace bs
 		/** Creates or retrieves a queue for the calling thread. */
 		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
 
+		/**
+		 * Makes the commands queued on the internal command queue visible to the core thread, and wakes it up if it is 
+		 * waiting for commands.
+		 *
+		 * @param[in]	blockUntilComplete	If true the calling thread will block until the command with @p commandId
+		 *									completes.
+		 * @param[in]	commandId			Notify identifier of the last queued command.
+		 */
+		void submitInternalCommands(bool blockUntilComplete, UINT32 commandId);
+
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID 
 		 * actually exists, otherwise this will block forever.
@@ -0,0 +1,596 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Image/BsBlockCompression.h"
+#include "Image/BsPixelData.h"
+#include "Math/BsMath.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/** Minimum number of blocks compressed by a single job when compressing large images on multiple threads. */
+	static constexpr UINT32 BLOCK_COMPRESSION_BLOCKS_PER_JOB = 256;
+
+	/** Maximum number of least squares refinement passes performed on color endpoints. */
+	static constexpr UINT32 BLOCK_COMPRESSION_REFINE_PASSES = 2;
+
+	/** Converts a color with channels in [0, 255] range into the 5:6:5 format. */
+	static UINT16 packColor565(const float* color)
+	{
+		INT32 r = Math::clamp((INT32)(color[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+		INT32 g = Math::clamp((INT32)(color[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+		INT32 b = Math::clamp((INT32)(color[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+
+		return (UINT16)((r << 11) | (g << 5) | b);
+	}
+
+	/** Expands a color in the 5:6:5 format into eight bits per channel. */
+	static void unpackColor565(UINT16 packed, INT32* color)
+	{
+		INT32 r = (packed >> 11) & 0x1F;
+		INT32 g = (packed >> 5) & 0x3F;
+		INT32 b = packed & 0x1F;
+
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	/**
+	 * Determines initial endpoints for a color block.
+	 *
+	 * @param[in]	pixels			16 RGBA8 pixels.
+	 * @param[in]	transparent		Flags for each pixel determining should the pixel be ignored.
+	 * @param[in]	principalAxis	If true the endpoints are found along the principal axis of the block colors.
+	 *								Otherwise the block bounding box is used.
+	 * @param[out]	color0			First endpoint.
+	 * @param[out]	color1			Second endpoint.
+	 */
+	static void findColorEndpoints(const UINT8* pixels, const bool* transparent, bool principalAxis, float* color0,
+		float* color1)
+	{
+		float minColor[3] = { 255.0f, 255.0f, 255.0f };
+		float maxColor[3] = { 0.0f, 0.0f, 0.0f };
+		float mean[3] = { 0.0f, 0.0f, 0.0f };
+		UINT32 numColors = 0;
+
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+				continue;
+
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				float value = (float)pixels[i * 4 + j];
+
+				minColor[j] = std::min(minColor[j], value);
+				maxColor[j] = std::max(maxColor[j], value);
+				mean[j] += value;
+			}
+
+			numColors++;
+		}
+
+		if (!principalAxis)
+		{
+			// Inset the bounding box slightly, as the extremes are rarely the best fit
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				float inset = (maxColor[i] - minColor[i]) / 16.0f;
+
+				color0[i] = maxColor[i] - inset;
+				color1[i] = minColor[i] + inset;
+			}
+
+			return;
+		}
+
+		for (UINT32 i = 0; i < 3; i++)
+			mean[i] /= numColors;
+
+		// Covariance matrix: rr, rg, rb, gg, gb, bb
+		float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+				continue;
+
+			float r = pixels[i * 4 + 0] - mean[0];
+			float g = pixels[i * 4 + 1] - mean[1];
+			float b = pixels[i * 4 + 2] - mean[2];
+
+			cov[0] += r * r;
+			cov[1] += r * g;
+			cov[2] += r * b;
+			cov[3] += g * g;
+			cov[4] += g * b;
+			cov[5] += b * b;
+		}
+
+		// Find the principal axis using power iteration, starting with the bounding box diagonal
+		float axis[3] = { maxColor[0] - minColor[0], maxColor[1] - minColor[1], maxColor[2] - minColor[2] };
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			float x = axis[0] * cov[0] + axis[1] * cov[1] + axis[2] * cov[2];
+			float y = axis[0] * cov[1] + axis[1] * cov[3] + axis[2] * cov[4];
+			float z = axis[0] * cov[2] + axis[1] * cov[4] + axis[2] * cov[5];
+
+			float length = std::max(fabs(x), std::max(fabs(y), fabs(z)));
+			if (length < 1e-6f)
+				break;
+
+			axis[0] = x / length;
+			axis[1] = y / length;
+			axis[2] = z / length;
+		}
+
+		// Use the colors with the largest and smallest projections on the axis as endpoints
+		float minDot = std::numeric_limits<float>::max();
+		float maxDot = -std::numeric_limits<float>::max();
+		UINT32 minIdx = 0;
+		UINT32 maxIdx = 0;
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+				continue;
+
+			float dot = pixels[i * 4 + 0] * axis[0] + pixels[i * 4 + 1] * axis[1] + pixels[i * 4 + 2] * axis[2];
+			if (dot < minDot)
+			{
+				minDot = dot;
+				minIdx = i;
+			}
+
+			if (dot > maxDot)
+			{
+				maxDot = dot;
+				maxIdx = i;
+			}
+		}
+
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			color0[i] = (float)pixels[maxIdx * 4 + i];
+			color1[i] = (float)pixels[minIdx * 4 + i];
+		}
+	}
+
+	/**
+	 * Quantizes the provided endpoints and finds the best palette index for each pixel of a color block.
+	 *
+	 * @param[in]	pixels			16 RGBA8 pixels.
+	 * @param[in]	transparent		Flags for each pixel determining should the pixel be encoded as transparent.
+	 * @param[in]	threeColorMode	If true the block is encoded using three colors and a transparent index. Otherwise
+	 *								four colors are used.
+	 * @param[in]	color0			First endpoint.
+	 * @param[in]	color1			Second endpoint.
+	 * @param[out]	endpoints		Quantized endpoints, ordered as required by the block mode.
+	 * @param[out]	indices			Two bit palette indices for all pixels.
+	 * @return						Sum of squared differences between the source and the encoded colors.
+	 */
+	static UINT32 encodeColors(const UINT8* pixels, const bool* transparent, bool threeColorMode, const float* color0,
+		const float* color1, UINT16* endpoints, UINT32& indices)
+	{
+		endpoints[0] = packColor565(color0);
+		endpoints[1] = packColor565(color1);
+
+		// Endpoint order selects the block mode
+		if (threeColorMode ? endpoints[0] > endpoints[1] : endpoints[0] < endpoints[1])
+			std::swap(endpoints[0], endpoints[1]);
+
+		INT32 palette[4][3];
+		unpackColor565(endpoints[0], palette[0]);
+		unpackColor565(endpoints[1], palette[1]);
+
+		UINT32 numColors;
+		if (!threeColorMode && endpoints[0] != endpoints[1])
+		{
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+				palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+			}
+
+			numColors = 4;
+		}
+		else
+		{
+			// Equal endpoints are always decoded using three colors
+			for (UINT32 i = 0; i < 3; i++)
+				palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+
+			numColors = 3;
+		}
+
+		UINT32 error = 0;
+		indices = 0;
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+			{
+				indices |= 3U << (i * 2);
+				continue;
+			}
+
+			const UINT8* pixel = pixels + i * 4;
+
+			UINT32 bestIdx = 0;
+			UINT32 bestError = std::numeric_limits<UINT32>::max();
+			for (UINT32 j = 0; j < numColors; j++)
+			{
+				INT32 r = pixel[0] - palette[j][0];
+				INT32 g = pixel[1] - palette[j][1];
+				INT32 b = pixel[2] - palette[j][2];
+
+				UINT32 curError = (UINT32)(r * r + g * g + b * b);
+				if (curError < bestError)
+				{
+					bestError = curError;
+					bestIdx = j;
+				}
+			}
+
+			indices |= bestIdx << (i * 2);
+			error += bestError;
+		}
+
+		return error;
+	}
+
+	/**
+	 * Calculates endpoints that minimize the squared error of the color block for the provided palette indices, using
+	 * least squares fitting.
+	 *
+	 * @return	False if the endpoints cannot be determined (e.g. all pixels use the same index).
+	 */
+	static bool refineColorEndpoints(const UINT8* pixels, const bool* transparent, bool threeColorMode, UINT32 indices,
+		float* color0, float* color1)
+	{
+		static const float WEIGHTS_4[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		static const float WEIGHTS_3[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+		const float* weights = threeColorMode ? WEIGHTS_3 : WEIGHTS_4;
+
+		float aa = 0.0f;
+		float bb = 0.0f;
+		float ab = 0.0f;
+		float ax[3] = { 0.0f, 0.0f, 0.0f };
+		float bx[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			if (transparent[i])
+				continue;
+
+			float a = weights[(indices >> (i * 2)) & 3];
+			float b = 1.0f - a;
+
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				ax[j] += a * pixels[i * 4 + j];
+				bx[j] += b * pixels[i * 4 + j];
+			}
+		}
+
+		float det = aa * bb - ab * ab;
+		if (fabs(det) < 1e-6f)
+			return false;
+
+		float invDet = 1.0f / det;
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			color0[i] = (ax[i] * bb - bx[i] * ab) * invDet;
+			color1[i] = (bx[i] * aa - ax[i] * ab) * invDet;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Encodes the color portion of a BC1, BC2 or BC3 block.
+	 *
+	 * @param[in]	pixels				16 RGBA8 pixels.
+	 * @param[out]	output				8 byte buffer to write the encoded data to.
+	 * @param[in]	allowTransparency	If true, pixels with alpha lower than 128 will be encoded as transparent.
+	 * @param[in]	ignoreInvisible		If true, colors of pixels with zero alpha are ignored when fitting the endpoints,
+	 *									as they're never visible. Used when alpha is stored separately from the color.
+	 * @param[in]	refine				If true, initial endpoints are found along the principal axis and then
+	 *									refined using least squares fitting. Otherwise they are determined from the
+	 *									bounding box.
+	 */
+	static void compressColorBlock(const UINT8* pixels, UINT8* output, bool allowTransparency, bool ignoreInvisible,
+		bool refine)
+	{
+		bool transparent[16];
+		UINT32 numOpaque = 0;
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			UINT8 alpha = pixels[i * 4 + 3];
+
+			transparent[i] = (allowTransparency && alpha < 128) || (ignoreInvisible && alpha == 0);
+			if (!transparent[i])
+				numOpaque++;
+		}
+
+		UINT16 endpoints[2] = { 0, 0 };
+		UINT32 indices = 0xFFFFFFFF;
+
+		if (numOpaque > 0)
+		{
+			// Ignored pixels of blocks with separate alpha get an arbitrary color, as such blocks always use four colors
+			bool threeColorMode = allowTransparency && numOpaque < 16;
+
+			float color0[3];
+			float color1[3];
+			findColorEndpoints(pixels, transparent, refine, color0, color1);
+
+			UINT32 error = encodeColors(pixels, transparent, threeColorMode, color0, color1, endpoints, indices);
+			for (UINT32 i = 0; refine && i < BLOCK_COMPRESSION_REFINE_PASSES && error > 0; i++)
+			{
+				if (!refineColorEndpoints(pixels, transparent, threeColorMode, indices, color0, color1))
+					break;
+
+				UINT16 newEndpoints[2];
+				UINT32 newIndices;
+				UINT32 newError = encodeColors(pixels, transparent, threeColorMode, color0, color1, newEndpoints,
+					newIndices);
+
+				if (newError >= error)
+					break;
+
+				endpoints[0] = newEndpoints[0];
+				endpoints[1] = newEndpoints[1];
+				indices = newIndices;
+				error = newError;
+			}
+		}
+		// Else equal endpoints select the three color mode, in which index 3 is transparent
+
+		output[0] = (UINT8)(endpoints[0] & 0xFF);
+		output[1] = (UINT8)(endpoints[0] >> 8);
+		output[2] = (UINT8)(endpoints[1] & 0xFF);
+		output[3] = (UINT8)(endpoints[1] >> 8);
+
+		for (UINT32 i = 0; i < 4; i++)
+			output[4 + i] = (UINT8)(indices >> (i * 8));
+	}
+
+	/**
+	 * Finds the best palette index for each value of a single channel block, as used by BC3 alpha and BC4/BC5 channels.
+	 *
+	 * @param[in]	values		16 values to encode.
+	 * @param[in]	value0		First endpoint. If larger than the second endpoint the eight value mode is used,
+	 *							otherwise the six value mode (with explicit 0 and 255 values) is used.
+	 * @param[in]	value1		Second endpoint.
+	 * @param[out]	indices		Three bit palette indices for all values.
+	 * @return					Sum of squared differences between the source and the encoded values.
+	 */
+	static UINT32 encodeChannel(const UINT8* values, UINT8 value0, UINT8 value1, UINT64& indices)
+	{
+		INT32 palette[8];
+		palette[0] = value0;
+		palette[1] = value1;
+
+		if (value0 > value1)
+		{
+			for (INT32 i = 1; i < 7; i++)
+				palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+		}
+		else
+		{
+			for (INT32 i = 1; i < 5; i++)
+				palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		UINT32 error = 0;
+		indices = 0;
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			UINT32 bestIdx = 0;
+			UINT32 bestError = std::numeric_limits<UINT32>::max();
+			for (UINT32 j = 0; j < 8; j++)
+			{
+				INT32 diff = values[i] - palette[j];
+
+				UINT32 curError = (UINT32)(diff * diff);
+				if (curError < bestError)
+				{
+					bestError = curError;
+					bestIdx = j;
+				}
+			}
+
+			indices |= (UINT64)bestIdx << (i * 3);
+			error += bestError;
+		}
+
+		return error;
+	}
+
+	/**
+	 * Encodes a single channel block, as used for BC3 alpha and BC4/BC5 channels.
+	 *
+	 * @param[in]	pixels		16 RGBA8 pixels.
+	 * @param[in]	channel		Index of the channel to encode.
+	 * @param[out]	output		8 byte buffer to write the encoded data to.
+	 * @param[in]	refine		If true, the six value mode is evaluated as well, and used if it results in lower error.
+	 */
+	static void compressChannelBlock(const UINT8* pixels, UINT32 channel, UINT8* output, bool refine)
+	{
+		UINT8 values[16];
+		UINT8 minValue = 255;
+		UINT8 maxValue = 0;
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			values[i] = pixels[i * 4 + channel];
+
+			minValue = std::min(minValue, values[i]);
+			maxValue = std::max(maxValue, values[i]);
+		}
+
+		UINT8 value0 = maxValue;
+		UINT8 value1 = minValue;
+
+		UINT64 indices;
+		UINT32 error = encodeChannel(values, value0, value1, indices);
+
+		if (refine && error > 0)
+		{
+			// Six value mode encodes 0 and 255 exactly, so only the remaining values determine the endpoints
+			UINT8 innerMin = 255;
+			UINT8 innerMax = 0;
+			for (UINT32 i = 0; i < 16; i++)
+			{
+				if (values[i] == 0 || values[i] == 255)
+					continue;
+
+				innerMin = std::min(innerMin, values[i]);
+				innerMax = std::max(innerMax, values[i]);
+			}
+
+			if (innerMin > innerMax)
+				innerMin = innerMax = 0;
+
+			UINT64 sixValueIndices;
+			UINT32 sixValueError = encodeChannel(values, innerMin, innerMax, sixValueIndices);
+			if (sixValueError < error)
+			{
+				value0 = innerMin;
+				value1 = innerMax;
+				indices = sixValueIndices;
+			}
+		}
+
+		output[0] = value0;
+		output[1] = value1;
+
+		for (UINT32 i = 0; i < 6; i++)
+			output[2 + i] = (UINT8)(indices >> (i * 8));
+	}
+
+	/** Encodes the alpha portion of a BC2 block, storing four bits of alpha per pixel. */
+	static void compressExplicitAlphaBlock(const UINT8* pixels, UINT8* output)
+	{
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			UINT32 alpha0 = (pixels[(i * 2 + 0) * 4 + 3] * 15 + 127) / 255;
+			UINT32 alpha1 = (pixels[(i * 2 + 1) * 4 + 3] * 15 + 127) / 255;
+
+			output[i] = (UINT8)(alpha0 | (alpha1 << 4));
+		}
+	}
+
+	bool BlockCompression::isSupported(const CompressionOptions& options)
+	{
+		switch (options.format)
+		{
+		case PF_BC1:
+		case PF_BC1a:
+		case PF_BC2:
+		case PF_BC3:
+			// Normal maps stored in color formats are compressed differently by the external encoder
+			return !options.isNormalMap;
+		case PF_BC4:
+		case PF_BC5:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void BlockCompression::compressBlock(const UINT8* pixels, UINT8* output, const CompressionOptions& options)
+	{
+		bool refine = options.quality != CompressionQuality::Fastest;
+		bool ignoreInvisible = options.alphaMode == AlphaMode::Transparency;
+
+		switch (options.format)
+		{
+		case PF_BC1:
+			compressColorBlock(pixels, output, false, false, refine);
+			break;
+		case PF_BC1a:
+			compressColorBlock(pixels, output, true, false, refine);
+			break;
+		case PF_BC2:
+			compressExplicitAlphaBlock(pixels, output);
+			compressColorBlock(pixels, output + 8, false, ignoreInvisible, refine);
+			break;
+		case PF_BC3:
+			compressChannelBlock(pixels, 3, output, refine);
+			compressColorBlock(pixels, output + 8, false, ignoreInvisible, refine);
+			break;
+		case PF_BC4:
+			compressChannelBlock(pixels, 0, output, refine);
+			break;
+		case PF_BC5:
+			compressChannelBlock(pixels, 0, output, refine);
+			compressChannelBlock(pixels, 1, output + 8, refine);
+			break;
+		default:
+			assert(false);
+			break;
+		}
+	}
+
+	void BlockCompression::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
+	{
+		if (src.getFormat() != PF_RGBA8 || dst.getFormat() != options.format || !isSupported(options))
+		{
+			LOGERR("Block compression failed. Unsupported source or destination format.");
+			return;
+		}
+
+		assert(src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight());
+
+		UINT32 width = src.getWidth();
+		UINT32 height = src.getHeight();
+		if (width == 0 || height == 0)
+			return;
+
+		PixelFormat format = options.format;
+		UINT32 numBlocksX = (width + 3) / 4;
+		UINT32 numBlocksY = (height + 3) / 4;
+		UINT32 blockSize = PixelUtil::getMemorySize(4, 4, 1, format);
+
+		const UINT8* srcData = src.getData();
+		UINT8* dstData = dst.getData();
+		UINT32 srcRowPitch = src.getRowPitch() * 4;
+
+		auto compressRows = [=](UINT32 rowBegin, UINT32 rowEnd)
+		{
+			UINT8 pixels[16 * 4];
+			for (UINT32 blockY = rowBegin; blockY < rowEnd; blockY++)
+			{
+				UINT8* output = dstData + blockY * numBlocksX * blockSize;
+				for (UINT32 blockX = 0; blockX < numBlocksX; blockX++)
+				{
+					// Blocks extending past the image edge are padded by repeating the edge pixels
+					for (UINT32 y = 0; y < 4; y++)
+					{
+						UINT32 srcY = std::min(blockY * 4 + y, height - 1);
+						for (UINT32 x = 0; x < 4; x++)
+						{
+							UINT32 srcX = std::min(blockX * 4 + x, width - 1);
+							memcpy(pixels + (y * 4 + x) * 4, srcData + srcY * srcRowPitch + srcX * 4, 4);
+						}
+					}
+
+					compressBlock(pixels, output, options);
+					output += blockSize;
+				}
+			}
+		};
+
+		UINT32 rowsPerJob = std::max(1U, BLOCK_COMPRESSION_BLOCKS_PER_JOB / numBlocksX);
+		if (numBlocksY > rowsPerJob && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor(0, numBlocksY, rowsPerJob, compressRows);
+		else
+			compressRows(0, numBlocksY);
+	}
+}
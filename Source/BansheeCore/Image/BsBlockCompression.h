@@ -0,0 +1,56 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Core-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Built-in encoder for BC1, BC2, BC3, BC4 and BC5 block compressed formats. Trades quality for speed compared to
+	 * the external encoder used by PixelUtil::compress(), which only uses this encoder for the Fastest quality level.
+	 *
+	 * @note
+	 * Alpha modes are respected by ignoring the color of invisible pixels, when alpha is stored separately from the
+	 * color. Gamma correction has no effect on compression, as colors are encoded as stored, the same as with the
+	 * external encoder.
+	 */
+	class BS_CORE_EXPORT BlockCompression
+	{
+	public:
+		/**
+		 * Checks can data be compressed with the provided options using the built-in encoder. Normal maps are only
+		 * supported for single and two channel formats.
+		 */
+		static bool isSupported(const CompressionOptions& options);
+
+		/**
+		 * Compresses the provided image. Image is split into rows of blocks which are compressed on multiple threads,
+		 * if the task scheduler is running.
+		 *
+		 * @param[in]	src		Uncompressed image in PF_RGBA8 format.
+		 * @param[in]	dst		Buffer to write the compressed data to. Must have the same size as the source image
+		 *						and be in the format specified by @p options.
+		 * @param[in]	options	Options that control the compression. Must be supported by the encoder. Any quality level
+		 *						other than Fastest spends more time on finding the optimal block endpoints.
+		 */
+		static void compress(const PixelData& src, PixelData& dst, const CompressionOptions& options);
+
+		/**
+		 * Compresses a single 4x4 block of pixels.
+		 *
+		 * @param[in]	pixels	16 pixels in PF_RGBA8 format, in row-major order.
+		 * @param[out]	output	Buffer to write the compressed block to. Must be 8 bytes large for BC1 and BC4 formats,
+		 *						and 16 bytes large for other formats.
+		 * @param[in]	options	Options that control the compression. Must be supported by the encoder.
+		 */
+		static void compressBlock(const UINT8* pixels, UINT8* output, const CompressionOptions& options);
+	};
+
+	/** @} */
+}
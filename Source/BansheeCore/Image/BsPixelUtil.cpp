@@ -4,12 +4,40 @@
 #include "Utility/BsBitwise.h"
 #include "Image/BsColor.h"
 #include "Math/BsMath.h"
+#include "Math/BsVector3.h"
 #include "Error/BsException.h"
 #include "Image/BsTexture.h"
+#include "Image/BsBlockCompression.h"
+#include "Threading/BsTaskScheduler.h"
 #include <nvtt.h>
 
+#if BS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace bs 
 {
+	/** Minimum number of pixels processed by a single job when resampling large images on multiple threads. */
+	static constexpr UINT32 RESAMPLE_PIXELS_PER_JOB = 16 * 1024;
+
+	/**
+	 * Executes the provided callable over rows in range [0, @p numRows). If the task scheduler is running and there are
+	 * enough rows, the range is split between multiple threads.
+	 *
+	 * @param[in]	numRows		Number of rows to process.
+	 * @param[in]	rowWidth	Number of pixels in a single row. Used for determining how many rows to process per job.
+	 * @param[in]	func		Callable with signature void(UINT32 rowBegin, UINT32 rowEnd).
+	 */
+	template<class F>
+	static void processRows(UINT32 numRows, UINT32 rowWidth, const F& func)
+	{
+		UINT32 rowsPerJob = std::max(1U, RESAMPLE_PIXELS_PER_JOB / std::max(1U, rowWidth));
+		if (numRows > rowsPerJob && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor(0, numRows, rowsPerJob, func);
+		else
+			func(0, numRows);
+	}
+
 	/**
 	 * Performs pixel data resampling using the point filter (nearest neighbor). Does not perform format conversions.
 	 *
@@ -152,12 +180,25 @@ namespace bs
 	struct LinearResampler_Float32 
 	{
 		static void scale(const PixelData& source, const PixelData& dest) 
+		{
+			if (source.getDepth() > 1 || dest.getDepth() > 1)
+			{
+				scaleRows(source, dest, 0, dest.getHeight());
+				return;
+			}
+
+			processRows(dest.getHeight(), dest.getWidth(), 
+				[&source, &dest](UINT32 rowBegin, UINT32 rowEnd) { scaleRows(source, dest, rowBegin, rowEnd); });
+		}
+
+		/** Resamples rows in range [@p rowBegin, @p rowEnd) of every slice of the destination data. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 rowBegin, UINT32 rowEnd)
 		{
 			UINT32 numSourceChannels = PixelUtil::getNumElemBytes(source.getFormat()) / sizeof(float);
 			UINT32 numDestChannels = PixelUtil::getNumElemBytes(dest.getFormat()) / sizeof(float);
 
 			float* sourceData = (float*)source.getData();
-			float* destPtr = (float*)dest.getData();
+			float* destData = (float*)dest.getData();
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -171,7 +212,7 @@ namespace bs
 			UINT32 temp = 0;
 
 			UINT64 curZ = (stepZ >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 z = dest.getFront(); z < dest.getBack(); z++, curZ += stepZ) 
+			for (UINT32 z = 0; z < dest.getDepth(); z++, curZ += stepZ) 
 			{
 				temp = (UINT32)(curZ >> 32);
 				temp = (temp > 0x8000)? temp - 0x8000 : 0;
@@ -179,9 +220,11 @@ namespace bs
 				UINT32 sampleCoordZ2 = std::min(sampleCoordZ1 + 1, (UINT32)source.getDepth() - 1);
 				float sampleWeightZ = (temp & 0xFFFF) / 65536.0f;
 
-				UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-				for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY) 
+				UINT64 curY = (stepY >> 1) - 1 + rowBegin * stepY; // Offset half a pixel to start at pixel center
+				for (UINT32 y = rowBegin; y < rowEnd; y++, curY += stepY) 
 				{
+					float* destPtr = destData + (z * dest.getSlicePitch() + y * dest.getRowPitch()) * numDestChannels;
+
 					temp = (UINT32)(curY >> 32);
 					temp = (temp > 0x8000)? temp - 0x8000 : 0;
 					UINT32 sampleCoordY1 = temp >> 16;
@@ -246,11 +289,7 @@ namespace bs
 
 						destPtr += numDestChannels;
 					}
-
-					destPtr += numDestChannels*dest.getRowSkip();
 				}
-
-				destPtr += numDestChannels*dest.getSliceSkip();
 			}
 		}
 	};
@@ -280,8 +319,15 @@ namespace bs
 				return;
 			}
 
+			processRows(dest.getHeight(), dest.getWidth(), 
+				[&source, &dest](UINT32 rowBegin, UINT32 rowEnd) { scaleRows(source, dest, rowBegin, rowEnd); });
+		}
+
+		/** Resamples rows in range [@p rowBegin, @p rowEnd) of the destination data. */
+		static void scaleRows(const PixelData& source, const PixelData& dest, UINT32 rowBegin, UINT32 rowEnd)
+		{
 			UINT8* sourceData = (UINT8*)source.getData();
-			UINT8* destPtr = (UINT8*)dest.getData();
+			UINT8* destPtr = (UINT8*)dest.getData() + rowBegin * dest.getRowPitch() * channels;
 
 			// Get steps for traversing source data in 16/48 fixed point precision format
 			UINT64 stepX = ((UINT64)source.getWidth() << 48) / dest.getWidth();
@@ -293,8 +339,8 @@ namespace bs
 			// that will be used for determining the blend amount.
 			UINT32 temp;
 
-			UINT64 curY = (stepY >> 1) - 1; // Offset half a pixel to start at pixel center
-			for (UINT32 y = dest.getTop(); y < dest.getBottom(); y++, curY += stepY)
+			UINT64 curY = (stepY >> 1) - 1 + rowBegin * stepY; // Offset half a pixel to start at pixel center
+			for (UINT32 y = rowBegin; y < rowEnd; y++, curY += stepY)
 			{
 				temp = (UINT32)(curY >> 36);
 				temp = (temp > 0x800)? temp - 0x800: 0;
@@ -1198,43 +1244,6 @@ namespace bs
 		UINT8* bufferEnd;
 	};
 
-	/**	Handles output from NVTT library for a mip-map chain. */
-	struct NVTTMipmapOutputHandler : public nvtt::OutputHandler
-	{
-		NVTTMipmapOutputHandler(const Vector<SPtr<PixelData>>& buffers)
-			:buffers(buffers), bufferWritePos(nullptr), bufferEnd(nullptr)
-		{ }
-
-		virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel)
-		{ 
-			assert(miplevel >= 0 && miplevel < (int)buffers.size());
-			assert(size == buffers[miplevel]->getConsecutiveSize());
-
-			activeBuffer = buffers[miplevel];
-
-			bufferWritePos = activeBuffer->getData();
-			bufferEnd = bufferWritePos + activeBuffer->getConsecutiveSize();
-		}
-
-		virtual bool writeData(const void* data, int size)
-		{
-			assert((bufferWritePos + size) <= bufferEnd);
-			memcpy(bufferWritePos, data, size);
-			bufferWritePos += size;
-
-			return true;
-		}
-
-		void endImage() override
-		{ }
-
-		Vector<SPtr<PixelData>> buffers;
-		SPtr<PixelData> activeBuffer;
-
-		UINT8* bufferWritePos;
-		UINT8* bufferEnd;
-	};
-
 	nvtt::Format toNVTTFormat(PixelFormat format)
 	{
 		switch (format)
@@ -1294,22 +1303,6 @@ namespace bs
 		return nvtt::AlphaMode_None;
 	}
 
-	nvtt::WrapMode toNVTTWrapMode(MipMapWrapMode wrapMode)
-	{
-		switch (wrapMode)
-		{
-		case MipMapWrapMode::Clamp:
-			return nvtt::WrapMode_Clamp;
-		case MipMapWrapMode::Mirror:
-			return nvtt::WrapMode_Mirror;
-		case MipMapWrapMode::Repeat:
-			return nvtt::WrapMode_Repeat;
-		}
-
-		// Unknown alpha mode
-		return nvtt::WrapMode_Mirror;
-	}
-
 	UINT32 PixelUtil::getNumElemBytes(PixelFormat format)
 	{
 		return getDescriptionFor(format).elemBytes;
@@ -1866,6 +1859,245 @@ namespace bs
 		}
 	}
 
+	/** 
+	 * Pixel format whose components are stored as 8-bit unsigned normalized values at fixed byte offsets. Offset of -1 
+	 * signifies a missing component.
+	 */
+	template<PixelFormat Format, UINT32 Size, int R, int G, int B, int A>
+	struct PixelFormatUNorm8
+	{
+		static const PixelFormat FORMAT = Format;
+		static const UINT32 SIZE = Size;
+		static const bool IS_UNORM8 = true;
+
+		static void load(const UINT8* src, UINT8 (&output)[4])
+		{
+			output[0] = R >= 0 ? src[R] : 0;
+			output[1] = G >= 0 ? src[G] : 0;
+			output[2] = B >= 0 ? src[B] : 0;
+			output[3] = A >= 0 ? src[A] : 255;
+		}
+
+		static void store(const UINT8 (&input)[4], UINT8* dst)
+		{
+			UINT8 value[Size] = { };
+			if (R >= 0) value[R] = input[0];
+			if (G >= 0) value[G] = input[1];
+			if (B >= 0) value[B] = input[2];
+			if (A >= 0) value[A] = input[3];
+
+			memcpy(dst, value, Size);
+		}
+
+		static void load(const UINT8* src, float (&output)[4])
+		{
+			UINT8 value[4];
+			load(src, value);
+
+			for (UINT32 i = 0; i < 4; i++)
+				output[i] = Bitwise::uintToUnorm(value[i], 8);
+
+			// Missing components need to be exact, regardless of the conversion above
+			if (B < 0) output[2] = 0.0f;
+			if (A < 0) output[3] = 1.0f;
+		}
+
+		static void store(const float (&input)[4], UINT8* dst)
+		{
+			UINT8 value[4];
+			for (UINT32 i = 0; i < 4; i++)
+				value[i] = (UINT8)Bitwise::unormToUint(input[i], 8);
+
+			store(value, dst);
+		}
+	};
+
+	/** Pixel format whose components are stored as 32-bit floating point values. */
+	template<PixelFormat Format, UINT32 NumComponents>
+	struct PixelFormatFloat32
+	{
+		static const PixelFormat FORMAT = Format;
+		static const UINT32 SIZE = NumComponents * sizeof(float);
+		static const bool IS_UNORM8 = false;
+
+		static void load(const UINT8* src, float (&output)[4])
+		{
+			output[1] = 0.0f;
+			output[2] = 0.0f;
+			output[3] = 1.0f;
+
+			memcpy(output, src, SIZE);
+		}
+
+		static void store(const float (&input)[4], UINT8* dst)
+		{
+			memcpy(dst, input, SIZE);
+		}
+	};
+
+	/** Pixel format whose components are stored as 16-bit floating point values. */
+	template<PixelFormat Format, UINT32 NumComponents>
+	struct PixelFormatFloat16
+	{
+		static const PixelFormat FORMAT = Format;
+		static const UINT32 SIZE = NumComponents * sizeof(UINT16);
+		static const bool IS_UNORM8 = false;
+
+		static void load(const UINT8* src, float (&output)[4])
+		{
+			UINT16 value[NumComponents];
+			memcpy(value, src, SIZE);
+
+			output[1] = 0.0f;
+			output[2] = 0.0f;
+			output[3] = 1.0f;
+
+			for (UINT32 i = 0; i < NumComponents; i++)
+				output[i] = Bitwise::halfToFloat(value[i]);
+		}
+
+		static void store(const float (&input)[4], UINT8* dst)
+		{
+			UINT16 value[NumComponents];
+			for (UINT32 i = 0; i < NumComponents; i++)
+				value[i] = Bitwise::floatToHalf(input[i]);
+
+			memcpy(dst, value, SIZE);
+		}
+	};
+
+	typedef PixelFormatUNorm8<PF_R8, 1, 0, -1, -1, -1> PixelFormatR8;
+	typedef PixelFormatUNorm8<PF_RG8, 2, 0, 1, -1, -1> PixelFormatRG8;
+	typedef PixelFormatUNorm8<PF_RGB8, 4, 0, 1, 2, -1> PixelFormatRGB8;
+	typedef PixelFormatUNorm8<PF_BGR8, 4, 2, 1, 0, -1> PixelFormatBGR8;
+	typedef PixelFormatUNorm8<PF_RGBA8, 4, 0, 1, 2, 3> PixelFormatRGBA8;
+	typedef PixelFormatUNorm8<PF_BGRA8, 4, 2, 1, 0, 3> PixelFormatBGRA8;
+	typedef PixelFormatFloat16<PF_R16F, 1> PixelFormatR16F;
+	typedef PixelFormatFloat16<PF_RG16F, 2> PixelFormatRG16F;
+	typedef PixelFormatFloat16<PF_RGBA16F, 4> PixelFormatRGBA16F;
+	typedef PixelFormatFloat32<PF_R32F, 1> PixelFormatR32F;
+	typedef PixelFormatFloat32<PF_RG32F, 2> PixelFormatRG32F;
+	typedef PixelFormatFloat32<PF_RGB32F, 3> PixelFormatRGB32F;
+	typedef PixelFormatFloat32<PF_RGBA32F, 4> PixelFormatRGBA32F;
+
+	/** 
+	 * Converts rows of pixels between two pixel formats known at compile time. Formats storing 8-bit unsigned
+	 * normalized values are converted directly, and all others through 32-bit floating point values. Produces the same
+	 * output as PixelUtil::unpackColor() followed by PixelUtil::packColor().
+	 */
+	template<class SRC, class DST>
+	struct PixelRowConverter
+	{
+		typedef typename std::conditional<SRC::IS_UNORM8 && DST::IS_UNORM8, UINT8, float>::type ComponentType;
+
+		static void convert(const UINT8* src, UINT8* dst, UINT32 count)
+		{
+			for (UINT32 i = 0; i < count; i++)
+			{
+				ComponentType components[4];
+				SRC::load(src, components);
+				DST::store(components, dst);
+
+				src += SRC::SIZE;
+				dst += DST::SIZE;
+			}
+		}
+	};
+
+	/** Converts a row of RGBA8 pixels into BGRA8 pixels, or vice versa, by swapping the red and blue channels. */
+	template<>
+	struct PixelRowConverter<PixelFormatRGBA8, PixelFormatBGRA8>
+	{
+		static void convert(const UINT8* src, UINT8* dst, UINT32 count)
+		{
+			UINT32 i = 0;
+
+#if BS_SSE2
+			const __m128i alphaGreenMask = _mm_set1_epi32(0xFF00FF00);
+			const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				__m128i alphaGreen = _mm_and_si128(value, alphaGreenMask);
+				__m128i redBlue = _mm_and_si128(value, redBlueMask);
+
+				// Red and blue are in separate 16-bit halves, so rotating by 16 bits swaps them
+				redBlue = _mm_or_si128(_mm_srli_epi32(redBlue, 16), _mm_slli_epi32(redBlue, 16));
+
+				_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(alphaGreen, redBlue));
+			}
+#endif
+
+			for (; i < count; i++)
+			{
+				UINT32 value;
+				memcpy(&value, src + i * 4, sizeof(value));
+
+				value = (value & 0xFF00FF00) | ((value >> 16) & 0x000000FF) | ((value & 0x000000FF) << 16);
+				memcpy(dst + i * 4, &value, sizeof(value));
+			}
+		}
+	};
+
+	template<>
+	struct PixelRowConverter<PixelFormatBGRA8, PixelFormatRGBA8> : PixelRowConverter<PixelFormatRGBA8, PixelFormatBGRA8>
+	{ };
+
+	/** Converts a row of @p count pixels from one pixel format into another. */
+	typedef void(*PixelRowConversionFunc)(const UINT8* src, UINT8* dst, UINT32 count);
+
+	/** Lookup table containing specialized row conversion methods for pairs of commonly used pixel formats. */
+	class PixelConversionTable
+	{
+	public:
+		PixelConversionTable()
+		{
+			memset(mFuncs, 0, sizeof(mFuncs));
+
+			registerFormats<PixelFormatR8, PixelFormatRG8, PixelFormatRGB8, PixelFormatBGR8, PixelFormatRGBA8, 
+				PixelFormatBGRA8, PixelFormatR16F, PixelFormatRG16F, PixelFormatRGBA16F, PixelFormatR32F, 
+				PixelFormatRG32F, PixelFormatRGB32F, PixelFormatRGBA32F>();
+		}
+
+		/** Returns a row conversion method for the provided formats, or null if the pair isn't supported. */
+		PixelRowConversionFunc get(PixelFormat src, PixelFormat dst) const
+		{
+			if (src >= PF_COUNT || dst >= PF_COUNT || src == dst)
+				return nullptr;
+
+			return mFuncs[src][dst];
+		}
+
+		static const PixelConversionTable& instance()
+		{
+			static PixelConversionTable inst;
+			return inst;
+		}
+
+	private:
+		/** Registers conversion methods for all pairs of the provided formats. */
+		template<class... FORMATS>
+		void registerFormats()
+		{
+			int dummy[] = { 0, (registerConversions<FORMATS, FORMATS...>(), 0)... };
+			(void)dummy;
+		}
+
+		/** Registers conversion methods from the @p SRC format into all the provided formats. */
+		template<class SRC, class... DSTS>
+		void registerConversions()
+		{
+			int dummy[] = { 0, (mFuncs[SRC::FORMAT][DSTS::FORMAT] = &PixelRowConverter<SRC, DSTS>::convert, 0)... };
+			(void)dummy;
+		}
+
+		PixelRowConversionFunc mFuncs[PF_COUNT][PF_COUNT];
+	};
+
+	/** Minimum number of pixels converted by a single job when converting large images on multiple threads. */
+	static constexpr UINT32 PIXEL_CONVERSION_PIXELS_PER_JOB = 64 * 1024;
+
 	void PixelUtil::bulkPixelConversion(const PixelData &src, PixelData &dst)
 	{
 		assert(src.getWidth() == dst.getWidth() &&
@@ -1955,6 +2187,40 @@ namespace bs
 		UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
 			+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
 
+		// Use a specialized conversion method if one exists, converting multiple rows in parallel for large images
+		PixelRowConversionFunc convertRow = PixelConversionTable::instance().get(src.getFormat(), dst.getFormat());
+		if (convertRow != nullptr)
+		{
+			const UINT32 width = src.getWidth();
+			const UINT32 height = src.getHeight();
+			const UINT32 numRows = height * src.getDepth();
+
+			const UINT32 srcRowPitchBytes = src.getRowPitch() * srcPixelSize;
+			const UINT32 srcSlicePitchBytes = src.getSlicePitch() * srcPixelSize;
+			const UINT32 dstRowPitchBytes = dst.getRowPitch() * dstPixelSize;
+			const UINT32 dstSlicePitchBytes = dst.getSlicePitch() * dstPixelSize;
+
+			auto convertRows = [&](UINT32 begin, UINT32 end)
+			{
+				for (UINT32 i = begin; i < end; i++)
+				{
+					UINT32 z = i / height;
+					UINT32 y = i % height;
+
+					convertRow(srcptr + z * srcSlicePitchBytes + y * srcRowPitchBytes,
+						dstptr + z * dstSlicePitchBytes + y * dstRowPitchBytes, width);
+				}
+			};
+
+			UINT32 rowsPerJob = std::max(1U, PIXEL_CONVERSION_PIXELS_PER_JOB / std::max(1U, width));
+			if (numRows > rowsPerJob && TaskScheduler::isStarted())
+				TaskScheduler::instance().parallelFor(0, numRows, rowsPerJob, convertRows);
+			else
+				convertRows(0, numRows);
+
+			return;
+		}
+
 		// Calculate pitches+skips in bytes
 		UINT32 srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
 		UINT32 srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
@@ -2397,6 +2663,18 @@ namespace bs
 			return;
 		}
 
+		// Built-in encoder is considerably faster but of lower quality, so it's only used when speed is requested
+		if (options.quality == CompressionQuality::Fastest && BlockCompression::isSupported(options))
+		{
+			PixelData rgbaData(src.getWidth(), src.getHeight(), 1, PF_RGBA8);
+			rgbaData.allocateInternalBuffer();
+			bulkPixelConversion(src, rgbaData);
+
+			BlockCompression::compress(rgbaData, dst, options);
+			rgbaData.freeInternalBuffer();
+			return;
+		}
+
 		PixelFormat interimFormat = options.format == PF_BC6H ? PF_RGBA32F : PF_BGRA8;
 
 		PixelData interimData(src.getWidth(), src.getHeight(), 1, interimFormat);
@@ -2442,6 +2720,325 @@ namespace bs
 		}	
 	}
 
+	AsyncOp PixelUtil::compressAsync(const SPtr<PixelData>& src, const SPtr<PixelData>& dst,
+		const CompressionOptions& options)
+	{
+		AsyncOp op(bs_shared_ptr_new<AsyncOpSyncData>());
+
+		if (!TaskScheduler::isStarted())
+		{
+			compress(*src, *dst, options);
+			op._completeOperation();
+
+			return op;
+		}
+
+		SPtr<Task> task = Task::create("CompressPixelData", [src, dst, options, op]() mutable
+		{
+			compress(*src, *dst, options);
+			op._completeOperation();
+		});
+
+		TaskScheduler::instance().addTask(task);
+		return op;
+	}
+
+	/** Evaluates the zero-order modified Bessel function of the first kind. */
+	static float bessel0(float x)
+	{
+		const float halfX = x * 0.5f;
+
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (UINT32 k = 1; k < 32; k++)
+		{
+			float factor = halfX / k;
+			term *= factor * factor;
+			sum += term;
+
+			if (term <= sum * 1e-8f)
+				break;
+		}
+
+		return sum;
+	}
+
+	/** Evaluates the normalized sinc function. */
+	static float sinc(float x)
+	{
+		if (fabs(x) < 1e-6f)
+			return 1.0f;
+
+		float piX = Math::PI * x;
+		return std::sin(piX) / piX;
+	}
+
+	/** Returns the distance from the center at which the provided mip-map filter reaches zero, in destination pixels. */
+	static float getMipMapFilterWidth(MipMapFilter filter)
+	{
+		switch (filter)
+		{
+		default:
+		case MipMapFilter::Box:
+			return 0.5f;
+		case MipMapFilter::Triangle:
+			return 1.0f;
+		case MipMapFilter::Kaiser:
+		case MipMapFilter::Lanczos:
+			return 3.0f;
+		}
+	}
+
+	/** Evaluates the provided mip-map filter at distance @p x from its center, in destination pixels. */
+	static float evaluateMipMapFilter(MipMapFilter filter, float x)
+	{
+		x = fabs(x);
+
+		switch (filter)
+		{
+		default:
+		case MipMapFilter::Box:
+			return x <= 0.5f ? 1.0f : 0.0f;
+		case MipMapFilter::Triangle:
+			return std::max(0.0f, 1.0f - x);
+		case MipMapFilter::Kaiser:
+		{
+			// Kaiser windowed sinc, using the same width and alpha as NVTT
+			const float width = 3.0f;
+			const float alpha = 4.0f;
+
+			float t = x / width;
+			if (t >= 1.0f)
+				return 0.0f;
+
+			return sinc(x) * bessel0(alpha * std::sqrt(1.0f - t * t)) / bessel0(alpha);
+		}
+		case MipMapFilter::Lanczos:
+			if (x >= 3.0f)
+				return 0.0f;
+
+			return sinc(x) * sinc(x / 3.0f);
+		}
+	}
+
+	/** Maps a (possibly out of range) pixel coordinate into the [0, size) range according to the wrap mode. */
+	static UINT32 wrapMipMapCoord(INT32 coord, UINT32 size, MipMapWrapMode wrapMode)
+	{
+		INT32 iSize = (INT32)size;
+		if (coord >= 0 && coord < iSize)
+			return (UINT32)coord;
+
+		switch (wrapMode)
+		{
+		case MipMapWrapMode::Repeat:
+			return (UINT32)(((coord % iSize) + iSize) % iSize);
+		case MipMapWrapMode::Mirror:
+		{
+			// Reflects around the edge pixels, without repeating them
+			if (iSize == 1)
+				return 0;
+
+			INT32 period = 2 * (iSize - 1);
+			coord = abs(coord) % period;
+
+			return (UINT32)(coord < iSize ? coord : period - coord);
+		}
+		default:
+		case MipMapWrapMode::Clamp:
+			return (UINT32)Math::clamp(coord, 0, iSize - 1);
+		}
+	}
+
+	/**
+	 * Separable filter used for halving the size of an image along a single axis. Destination pixel @p i is centered
+	 * between source pixels 2i and 2i + 1, and receives contributions from source pixels in range
+	 * [2i + firstTap, 2i + firstTap + numTaps).
+	 */
+	struct MipMapKernel
+	{
+		MipMapKernel(MipMapFilter filter)
+		{
+			float width = getMipMapFilterWidth(filter);
+
+			// Two source pixels per destination pixel on each side of the center
+			numTaps = (UINT32)Math::ceilToInt(width * 2.0f) * 2;
+			firstTap = 1 - (INT32)numTaps / 2;
+
+			float sum = 0.0f;
+			for (UINT32 i = 0; i < numTaps; i++)
+			{
+				// Distance between the source pixel center and the destination pixel center, in destination pixels
+				float distance = ((firstTap + (INT32)i) - 0.5f) * 0.5f;
+
+				weights[i] = evaluateMipMapFilter(filter, distance);
+				sum += weights[i];
+			}
+
+			for (UINT32 i = 0; i < numTaps; i++)
+				weights[i] /= sum;
+		}
+
+		/**
+		 * Calculates indices of source pixels read by each destination pixel, taking into account the wrap mode. Indices
+		 * for destination pixel @p i are stored at [i * numTaps, (i + 1) * numTaps).
+		 */
+		Vector<UINT32> getSourceIndices(UINT32 srcSize, MipMapWrapMode wrapMode) const
+		{
+			UINT32 dstSize = std::max(1U, srcSize / 2);
+
+			Vector<UINT32> indices(dstSize * numTaps);
+			for (UINT32 i = 0; i < dstSize; i++)
+			{
+				for (UINT32 j = 0; j < numTaps; j++)
+					indices[i * numTaps + j] = wrapMipMapCoord(2 * i + firstTap + (INT32)j, srcSize, wrapMode);
+			}
+
+			return indices;
+		}
+
+		static const UINT32 MAX_TAPS = 12;
+
+		float weights[MAX_TAPS];
+		UINT32 numTaps;
+		INT32 firstTap;
+	};
+
+	/**
+	 * Filters rows of an RGBA32F image horizontally, halving their width.
+	 *
+	 * @param[in]	src			Source image data.
+	 * @param[in]	dst			Destination image data, of the same height as the source and half the width.
+	 * @param[in]	srcWidth	Width of the source image, in pixels.
+	 * @param[in]	kernel		Filter to downsample with.
+	 * @param[in]	indices		Source pixel indices, as returned by MipMapKernel::getSourceIndices().
+	 * @param[in]	rowBegin	First row to process.
+	 * @param[in]	rowEnd		One past the last row to process.
+	 */
+	static void downsampleMipRowsHorizontal(const float* src, float* dst, UINT32 srcWidth, const MipMapKernel& kernel,
+		const UINT32* indices, UINT32 rowBegin, UINT32 rowEnd)
+	{
+		UINT32 dstWidth = std::max(1U, srcWidth / 2);
+		UINT32 numTaps = kernel.numTaps;
+
+		for (UINT32 y = rowBegin; y < rowEnd; y++)
+		{
+			const float* srcRow = src + y * srcWidth * 4;
+			float* dstRow = dst + y * dstWidth * 4;
+
+			for (UINT32 x = 0; x < dstWidth; x++)
+			{
+				const UINT32* pixelIndices = indices + x * numTaps;
+
+#if BS_SSE2
+				__m128 accum = _mm_setzero_ps();
+				for (UINT32 i = 0; i < numTaps; i++)
+				{
+					__m128 pixel = _mm_loadu_ps(srcRow + pixelIndices[i] * 4);
+					accum = _mm_add_ps(accum, _mm_mul_ps(pixel, _mm_set1_ps(kernel.weights[i])));
+				}
+
+				_mm_storeu_ps(dstRow + x * 4, accum);
+#else
+				float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				for (UINT32 i = 0; i < numTaps; i++)
+				{
+					const float* pixel = srcRow + pixelIndices[i] * 4;
+					float weight = kernel.weights[i];
+
+					accum[0] += pixel[0] * weight;
+					accum[1] += pixel[1] * weight;
+					accum[2] += pixel[2] * weight;
+					accum[3] += pixel[3] * weight;
+				}
+
+				memcpy(dstRow + x * 4, accum, sizeof(accum));
+#endif
+			}
+		}
+	}
+
+	/**
+	 * Filters columns of an RGBA32F image vertically, halving their height.
+	 *
+	 * @param[in]	src			Source image data.
+	 * @param[in]	dst			Destination image data, of the same width as the source and half the height.
+	 * @param[in]	width		Width of the source and destination images, in pixels.
+	 * @param[in]	kernel		Filter to downsample with.
+	 * @param[in]	indices		Source row indices, as returned by MipMapKernel::getSourceIndices().
+	 * @param[in]	rowBegin	First destination row to process.
+	 * @param[in]	rowEnd		One past the last destination row to process.
+	 */
+	static void downsampleMipRowsVertical(const float* src, float* dst, UINT32 width, const MipMapKernel& kernel,
+		const UINT32* indices, UINT32 rowBegin, UINT32 rowEnd)
+	{
+		UINT32 numFloats = width * 4;
+		UINT32 numTaps = kernel.numTaps;
+
+		for (UINT32 y = rowBegin; y < rowEnd; y++)
+		{
+			const UINT32* rowIndices = indices + y * numTaps;
+			float* dstRow = dst + y * numFloats;
+
+			// Whole rows are accumulated at once, so the source rows are read sequentially
+			for (UINT32 i = 0; i < numTaps; i++)
+			{
+				const float* srcRow = src + rowIndices[i] * numFloats;
+				float weight = kernel.weights[i];
+				bool first = i == 0;
+
+#if BS_SSE2
+				__m128 weightVec = _mm_set1_ps(weight);
+				for (UINT32 j = 0; j < numFloats; j += 4)
+				{
+					__m128 value = _mm_mul_ps(_mm_loadu_ps(srcRow + j), weightVec);
+					if (!first)
+						value = _mm_add_ps(value, _mm_loadu_ps(dstRow + j));
+
+					_mm_storeu_ps(dstRow + j, value);
+				}
+#else
+				for (UINT32 j = 0; j < numFloats; j++)
+					dstRow[j] = first ? srcRow[j] * weight : dstRow[j] + srcRow[j] * weight;
+#endif
+			}
+		}
+	}
+
+	/** Converts a gamma corrected (sRGB) color value into linear space. */
+	static float gammaToLinear(float value)
+	{
+		if (value <= 0.04045f)
+			return value / 12.92f;
+
+		return std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	/** Converts a linear color value into gamma corrected (sRGB) space. */
+	static float linearToGamma(float value)
+	{
+		if (value <= 0.0031308f)
+			return std::max(0.0f, value * 12.92f);
+
+		return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	/** Applies the provided function to the RGB channels of all pixels in an RGBA32F image. Alpha is left untouched. */
+	template<class F>
+	static void transformMipColors(PixelData& data, const F& func)
+	{
+		float* pixels = (float*)data.getData();
+		UINT32 width = data.getWidth();
+
+		processRows(data.getHeight(), width, [pixels, width, &func](UINT32 rowBegin, UINT32 rowEnd)
+		{
+			float* pixel = pixels + rowBegin * width * 4;
+			float* end = pixels + rowEnd * width * 4;
+
+			for (; pixel != end; pixel += 4)
+				func(pixel);
+		});
+	}
+
 	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
 	{
 		Vector<SPtr<PixelData>> outputMipBuffers;
@@ -2464,99 +3061,128 @@ namespace bs
 			return outputMipBuffers;
 		}
 
-		PixelFormat interimFormat = isFloatingPoint(src.getFormat()) ? PF_RGBA32F : PF_BGRA8;
-
-		PixelData interimData(src.getWidth(), src.getHeight(), 1, interimFormat);
-		interimData.allocateInternalBuffer();
-		bulkPixelConversion(src, interimData);
-		
-		if (interimFormat != PF_RGBA32F)
-			flipComponentOrder(interimData);
+		// Base level is returned as is
+		SPtr<PixelData> baseLevel = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		baseLevel->allocateInternalBuffer();
+		bulkPixelConversion(src, *baseLevel);
 
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(true);
-		io.setNormalMap(options.isNormalMap);
-		io.setNormalizeMipmaps(options.normalizeMipmaps);
-		io.setWrapMode(toNVTTWrapMode(options.wrapMode));
+		outputMipBuffers.push_back(baseLevel);
 
-		if (interimFormat == PF_RGBA32F)
-			io.setFormat(nvtt::InputFormat_RGBA_32F);
-		else
-			io.setFormat(nvtt::InputFormat_BGRA_8UB);
+		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		if (numMips == 0)
+			return outputMipBuffers;
 
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
+		// Normal maps don't store colors, so they are never gamma corrected
+		bool gammaCorrect = options.isSRGB && !options.isNormalMap;
+		bool normalize = options.isNormalMap && options.normalizeMipmaps;
 
-		io.setMipmapData(interimData.getData(), src.getWidth(), src.getHeight());
+		// All levels are filtered in linear space, using four floats per pixel
+		SPtr<PixelData> prevLevel = bs_shared_ptr_new<PixelData>(src.getWidth(), src.getHeight(), 1, PF_RGBA32F);
+		prevLevel->allocateInternalBuffer();
+		bulkPixelConversion(src, *prevLevel);
 
-		nvtt::CompressionOptions co;
-		co.setFormat(nvtt::Format_RGBA);
-		
-		if (interimFormat == PF_RGBA32F)
-		{
-			co.setPixelType(nvtt::PixelType_Float);
-			co.setPixelFormat(32, 32, 32, 32);
-		}
-		else
+		if (gammaCorrect)
 		{
-			co.setPixelType(nvtt::PixelType_UnsignedNorm);
-			co.setPixelFormat(32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF);
+			transformMipColors(*prevLevel, [](float* pixel)
+			{
+				for (UINT32 i = 0; i < 3; i++)
+					pixel[i] = gammaToLinear(pixel[i]);
+			});
 		}
 
-		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
+		MipMapKernel kernel(options.filter);
 
-		Vector<SPtr<PixelData>> rgbaMipBuffers;
+		// Holds the horizontally filtered image, before it's filtered vertically
+		PixelData tempData(std::max(1U, src.getWidth() / 2), src.getHeight(), 1, PF_RGBA32F);
+		tempData.allocateInternalBuffer();
 
-		// Note: This can be done more effectively without creating so many temp buffers
-		// and working with the original formats directly, but it would complicate the code
-		// too much at the moment.
-		UINT32 curWidth = src.getWidth();
-		UINT32 curHeight = src.getHeight();
 		for (UINT32 i = 0; i < numMips; i++)
 		{
-			rgbaMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-			rgbaMipBuffers.back()->allocateInternalBuffer();
+			UINT32 srcWidth = prevLevel->getWidth();
+			UINT32 srcHeight = prevLevel->getHeight();
+			UINT32 dstWidth = std::max(1U, srcWidth / 2);
+			UINT32 dstHeight = std::max(1U, srcHeight / 2);
 
-			if (curWidth > 1) 
-				curWidth = curWidth / 2;
+			const float* srcPixels = (const float*)prevLevel->getData();
+			float* tempPixels = (float*)tempData.getData();
 
-			if (curHeight > 1)
-				curHeight = curHeight / 2;
-		}
+			// Horizontal pass, reduces the width
+			const float* horzPixels = srcPixels;
+			if (srcWidth > 1)
+			{
+				Vector<UINT32> indices = kernel.getSourceIndices(srcWidth, options.wrapMode);
+				const UINT32* indicesPtr = indices.data();
 
-		rgbaMipBuffers.push_back(bs_shared_ptr_new<PixelData>(curWidth, curHeight, 1, interimFormat));
-		rgbaMipBuffers.back()->allocateInternalBuffer();
+				processRows(srcHeight, srcWidth, [&](UINT32 rowBegin, UINT32 rowEnd)
+				{
+					downsampleMipRowsHorizontal(srcPixels, tempPixels, srcWidth, kernel, indicesPtr, rowBegin, rowEnd);
+				});
 
-		NVTTMipmapOutputHandler outputHandler(rgbaMipBuffers);
+				horzPixels = tempPixels;
+			}
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
+			// Vertical pass, reduces the height
+			SPtr<PixelData> level = bs_shared_ptr_new<PixelData>(dstWidth, dstHeight, 1, PF_RGBA32F);
+			level->allocateInternalBuffer();
 
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-		{
-			LOGERR("Mipmap generation failed. Internal error.");
-			return outputMipBuffers;
-		}
+			float* dstPixels = (float*)level->getData();
+			if (srcHeight > 1)
+			{
+				Vector<UINT32> indices = kernel.getSourceIndices(srcHeight, options.wrapMode);
+				const UINT32* indicesPtr = indices.data();
 
-		interimData.freeInternalBuffer();
+				processRows(dstHeight, dstWidth, [&](UINT32 rowBegin, UINT32 rowEnd)
+				{
+					downsampleMipRowsVertical(horzPixels, dstPixels, dstWidth, kernel, indicesPtr, rowBegin, rowEnd);
+				});
+			}
+			else
+				memcpy(dstPixels, horzPixels, dstWidth * 4 * sizeof(float));
 
-		for (UINT32 i = 0; i < (UINT32)rgbaMipBuffers.size(); i++)
-		{
-			SPtr<PixelData> argbBuffer = rgbaMipBuffers[i];
-			SPtr<PixelData> outputBuffer = bs_shared_ptr_new<PixelData>(argbBuffer->getWidth(), argbBuffer->getHeight(), 1, src.getFormat());
-			outputBuffer->allocateInternalBuffer();
+			if (normalize)
+			{
+				transformMipColors(*level, [](float* pixel)
+				{
+					Vector3 normal(pixel[0] * 2.0f - 1.0f, pixel[1] * 2.0f - 1.0f, pixel[2] * 2.0f - 1.0f);
+					normal.normalize();
 
-			bulkPixelConversion(*argbBuffer, *outputBuffer);
-			argbBuffer->freeInternalBuffer();
+					pixel[0] = normal.x * 0.5f + 0.5f;
+					pixel[1] = normal.y * 0.5f + 0.5f;
+					pixel[2] = normal.z * 0.5f + 0.5f;
+				});
+			}
+
+			prevLevel->freeInternalBuffer();
+			prevLevel = level;
+
+			// Linear values are needed for generating the next level, so the output is converted from a copy
+			SPtr<PixelData> outputLevel = bs_shared_ptr_new<PixelData>(dstWidth, dstHeight, 1, src.getFormat());
+			outputLevel->allocateInternalBuffer();
 
-			outputMipBuffers.push_back(outputBuffer);
+			if (gammaCorrect)
+			{
+				PixelData gammaData(dstWidth, dstHeight, 1, PF_RGBA32F);
+				gammaData.allocateInternalBuffer();
+				memcpy(gammaData.getData(), level->getData(), level->getConsecutiveSize());
+
+				transformMipColors(gammaData, [](float* pixel)
+				{
+					for (UINT32 j = 0; j < 3; j++)
+						pixel[j] = linearToGamma(pixel[j]);
+				});
+
+				bulkPixelConversion(gammaData, *outputLevel);
+				gammaData.freeInternalBuffer();
+			}
+			else
+				bulkPixelConversion(*level, *outputLevel);
+
+			outputMipBuffers.push_back(outputLevel);
 		}
 
+		prevLevel->freeInternalBuffer();
+		tempData.freeInternalBuffer();
+
 		return outputMipBuffers;
 	}
 }
@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Image/BsPixelData.h"
+#include "Threading/BsAsyncOp.h"
 
 namespace bs 
 {
@@ -41,7 +42,8 @@ namespace bs
 	{
 		Box,
 		Triangle,
-		Kaiser
+		Kaiser,
+		Lanczos
 	};
 
 	/** Determines on which axes to mirror an image. */
@@ -244,12 +246,31 @@ namespace bs
 		/** Flips the order of components in each individual pixel. For example RGBA -> ABGR. */
 		static void flipComponentOrder(PixelData& data);
 
-		/** Compresses the provided data using the specified compression options.  */
+		/**
+		 * Compresses the provided data using the specified compression options. BC1 to BC5 formats are compressed using
+		 * a faster built-in encoder for the Fastest quality level, unless compressing a normal map into a color format.
+		 */
 		static void compress(const PixelData& src, PixelData& dst, const CompressionOptions& options);
 
+		/**
+		 * Compresses the provided data on the task scheduler, without blocking the calling thread. Formats handled by
+		 * the built-in encoder are compressed using multiple threads. If the task scheduler isn't running the data is
+		 * compressed before the method returns.
+		 *
+		 * @param[in]	src		Data to compress. Must not be modified until the operation completes.
+		 * @param[in]	dst		Buffer to write the compressed data to. Must have an allocated buffer of the same size as
+		 *						the source data, in the compressed format specified by @p options.
+		 * @param[in]	options	Options that control the compression.
+		 * @return				Object that can be used for checking when the operation completes. Has no return value.
+		 */
+		static AsyncOp compressAsync(const SPtr<PixelData>& src, const SPtr<PixelData>& dst,
+			const CompressionOptions& options);
+
 		/**
 		 * Generates mip-maps from the provided source data using the specified compression options. Returned list includes
-		 * the base level.
+		 * the base level. Each level is produced from the previous one using a separable filter. Filtering is performed
+		 * in linear space if the source data is gamma corrected. Large images are processed on multiple threads if the
+		 * task scheduler is running.
 		 *
 		 * @return	A list of calculated mip-map data. First entry is the largest mip and other follow in order from 
 		 *			largest to smallest.
@@ -27,7 +27,8 @@ namespace bs
 
 	MeshImportOptions::MeshImportOptions()
 		: mCPUCached(false), mImportNormals(true), mImportTangents(true), mImportBlendShapes(false), mImportSkin(false)
-		, mImportAnimation(false), mReduceKeyFrames(true), mImportRootMotion(false), mImportScale(1.0f)
+		, mImportAnimation(false), mReduceKeyFrames(true), mImportRootMotion(false), mCompressAnimation(false)
+		, mAnimationCompressionTolerance(0.001f), mImportScale(1.0f)
 		, mCollisionMeshType(CollisionMeshType::None)
 	{ }
 
@@ -162,6 +162,36 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**	
+		 * Enables or disables animation compression. When enabled, position, rotation and scale curves of imported
+		 * animation clips will be stored in a compressed form, with keyframes that can be reconstructed from their
+		 * neighbours removed and the remaining keyframes quantized. This significantly reduces the memory used by the clip,
+		 * at the cost of small errors in the animation.
+		 */
+		void setAnimationCompression(bool enabled) { mCompressAnimation = enabled; }
+
+		/**	
+		 * Checks is animation compression enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		bool getAnimationCompression() const { return mCompressAnimation; }
+
+		/**
+		 * Determines the maximum error allowed when compressing animation curves. Higher values result in smaller clips
+		 * but less accurate animation. Only relevant if animation compression is enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		void setAnimationCompressionTolerance(float tolerance) { mAnimationCompressionTolerance = tolerance; }
+
+		/**	
+		 * Returns the maximum error allowed when compressing animation curves.
+		 *
+		 * @see	setAnimationCompressionTolerance
+		 */
+		float getAnimationCompressionTolerance() const { return mAnimationCompressionTolerance; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -174,6 +204,8 @@ namespace bs
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
+		bool mCompressAnimation;
+		float mAnimationCompressionTolerance;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
@@ -3,10 +3,63 @@
 #include "Physics/BsPhysics.h"
 #include "Physics/BsRigidbody.h"
 #include "Math/BsRay.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsCapsule.h"
 #include "Components/BsCCollider.h"
 
 namespace bs
 {
+	PhysicsQueryShape PhysicsQueryShape::box(const AABox& box, const Quaternion& rotation)
+	{
+		PhysicsQueryShape output;
+		output.type = PhysicsQueryShapeType::Box;
+		output.position = box.getCenter();
+		output.rotation = rotation;
+		output.size = box.getHalfSize();
+
+		return output;
+	}
+
+	PhysicsQueryShape PhysicsQueryShape::sphere(const Sphere& sphere)
+	{
+		PhysicsQueryShape output;
+		output.type = PhysicsQueryShapeType::Sphere;
+		output.position = sphere.getCenter();
+		output.size = Vector3(sphere.getRadius(), 0.0f, 0.0f);
+
+		return output;
+	}
+
+	PhysicsQueryShape PhysicsQueryShape::capsule(const Capsule& capsule, const Quaternion& rotation)
+	{
+		PhysicsQueryShape output;
+		output.type = PhysicsQueryShapeType::Capsule;
+		output.position = capsule.getCenter();
+		output.rotation = rotation;
+		output.size = Vector3(capsule.getRadius(), capsule.getHeight() * 0.5f, 0.0f);
+
+		return output;
+	}
+
+	void PhysicsStepInterpolation::addStep(float endTime)
+	{
+		for (UINT32 i = 1; i < NUM_STEPS; i++)
+			stepTimes[i - 1] = stepTimes[i];
+
+		stepTimes[NUM_STEPS - 1] = endTime;
+	}
+
+	float PhysicsStepInterpolation::evaluate(float frameTime, float stepSize, UINT32& first) const
+	{
+		// A step is launched once the frame time passes its end time, and completes during the next frame. So the most
+		// recent completed step ends at most two steps before the frame time, or at most one if no step is running.
+		float displayTime = frameTime - 2.0f * stepSize;
+
+		first = displayTime >= stepTimes[1] ? 1 : 0;
+		return Math::lerp01(displayTime, stepTimes[first], stepTimes[first + 1]);
+	}
+
 	Physics::Physics(const PHYSICS_INIT_DESC& init)
 	{
 		memset(mCollisionMap, 1, CollisionMapSize * CollisionMapSize * sizeof(bool));
@@ -46,7 +46,16 @@ namespace bs
 		 * Enables continous collision detection. This will prevent fast-moving objects from tunneling through each other.
 		 * You must also enable CCD for individual Rigidbodies. This option can have a significant performance impact.
 		 */
-		CCD_Enable = 1<<3
+		CCD_Enable = 1<<3,
+		/**
+		 * Runs the physics simulation in parallel with the rest of the frame, instead of blocking until it completes.
+		 * Results of the simulation are retrieved during the next physics update, and rigidbody transforms are
+		 * interpolated between the results of recent simulation steps. This reduces the time the main thread spends
+		 * waiting on the simulation, at the cost of displaying rigidbodies two simulation steps behind the frame
+		 * time (see PhysicsStepInterpolation). Changes made to physics objects
+		 * while the simulation is running are buffered and applied once it completes.
+		 */
+		AsyncSimulation = 1<<4
 	};
 
 	/** @copydoc CharacterCollisionFlag */
@@ -401,6 +410,55 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/**
+		 * Casts multiple rays into the scene and returns the closest found hit for each, if any. Queries are split into
+		 * chunks that are executed in parallel, and no memory is allocated.
+		 *
+		 * @param[in]	queries		Array of @p numQueries rays to cast.
+		 * @param[in]	numQueries	Number of queries in the batch.
+		 * @param[out]	hits		Pre-allocated array of @p numQueries entries that will receive the closest hit for
+		 *							each query. PhysicsQueryHit::colliderRaw is null for queries that didn't hit anything.
+		 * @param[in]	layer		Layers to consider for the queries. This allows you to ignore certain groups of
+		 *							objects.
+		 * @return					Number of queries that hit something.
+		 */
+		virtual UINT32 rayCastBatch(const PhysicsRayQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const = 0;
+
+		/**
+		 * Performs multiple sweeps into the scene and returns the closest found hit for each, if any. Queries are split
+		 * into chunks that are executed in parallel, and no memory is allocated.
+		 *
+		 * @param[in]	queries		Array of @p numQueries sweeps to perform.
+		 * @param[in]	numQueries	Number of queries in the batch.
+		 * @param[out]	hits		Pre-allocated array of @p numQueries entries that will receive the closest hit for
+		 *							each query. PhysicsQueryHit::colliderRaw is null for queries that didn't hit anything.
+		 * @param[in]	layer		Layers to consider for the queries. This allows you to ignore certain groups of
+		 *							objects.
+		 * @return					Number of queries that hit something.
+		 */
+		virtual UINT32 sweepBatch(const PhysicsSweepQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const = 0;
+
+		/**
+		 * Finds all colliders overlapping each of the provided shapes. Queries are split into chunks that are executed
+		 * in parallel, and no memory is allocated.
+		 *
+		 * @param[in]	shapes					Array of @p numQueries shapes to check for overlap.
+		 * @param[in]	numQueries				Number of queries in the batch.
+		 * @param[out]	colliders				Pre-allocated array of @p numQueries * @p maxCollidersPerQuery entries.
+		 *										Colliders overlapping the shape at index i are written starting at index
+		 *										i * @p maxCollidersPerQuery. Colliders over the limit are ignored.
+		 * @param[in]	maxCollidersPerQuery	Maximum number of colliders to output for a single query.
+		 * @param[out]	numColliders			Pre-allocated array of @p numQueries entries that will receive the number
+		 *										of colliders written for each query.
+		 * @param[in]	layer					Layers to consider for the queries. This allows you to ignore certain
+		 *										groups of objects.
+		 * @return								Total number of colliders written.
+		 */
+		virtual UINT32 overlapBatch(const PhysicsQueryShape* shapes, UINT32 numQueries, HCollider* colliders,
+			UINT32 maxCollidersPerQuery, UINT32* numColliders, UINT64 layer = BS_ALL_LAYERS) const = 0;
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
@@ -570,6 +628,16 @@ namespace bs
 		Vector3 gravity = Vector3(0.0f, -9.81f, 0.0f); /**< Initial gravity. */
 		bool initCooking = true; /**< Determines should the cooking library be initialized. */
 		float timeStep = 1.0f / 60.0f; /**< Determines using what interval should the physics update happen. */
+		/**
+		 * Number of threads dedicated to running the physics simulation. If zero, a thread will be used for each logical
+		 * CPU core, except for the one running the main thread.
+		 */
+		UINT32 numWorkerThreads = 0;
+		/**
+		 * Maximum number of simulation tasks that can be queued on a single worker thread. Tasks over the limit are
+		 * executed on the thread that submitted them.
+		 */
+		UINT32 taskQueueSize = 1024;
 		/** Flags that control global physics option. */
 		PhysicsFlags flags = PhysicsFlag::CCT_OverlapRecovery | PhysicsFlag::CCT_PreciseSweeps | PhysicsFlag::CCD_Enable;
 	};
@@ -5,6 +5,8 @@
 #include "BsCorePrerequisites.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
+#include "Math/BsQuaternion.h"
+#include <cfloat>
 
 namespace bs
 {
@@ -79,5 +81,79 @@ namespace bs
 		HCollider collider;
 	};
 
+	/** Type of geometry used by a batched physics query. */
+	enum class PhysicsQueryShapeType
+	{
+		Box, /**< Oriented box. */
+		Sphere, /**< Sphere. */
+		Capsule /**< Oriented capsule. */
+	};
+
+	/** Geometry used by a batched sweep or overlap physics query. */
+	struct BS_CORE_EXPORT PhysicsQueryShape
+	{
+		PhysicsQueryShapeType type = PhysicsQueryShapeType::Sphere; /**< Type of the geometry. */
+		Vector3 position = Vector3::ZERO; /**< Center of the geometry in world space. */
+		Quaternion rotation = Quaternion::IDENTITY; /**< Orientation of the geometry. Ignored for spheres. */
+		/**
+		 * Size of the geometry. Boxes use all three components as half-extents. Spheres use the x component as the
+		 * radius. Capsules use the x component as the radius and the y component as half of the capsule's height.
+		 */
+		Vector3 size = Vector3::ZERO;
+
+		/** Creates a query shape from a box and its orientation. */
+		static PhysicsQueryShape box(const AABox& box, const Quaternion& rotation);
+
+		/** Creates a query shape from a sphere. */
+		static PhysicsQueryShape sphere(const Sphere& sphere);
+
+		/** Creates a query shape from a capsule and its orientation. */
+		static PhysicsQueryShape capsule(const Capsule& capsule, const Quaternion& rotation);
+	};
+
+	/** Ray cast executed as a part of a batch of physics queries. */
+	struct PhysicsRayQuery
+	{
+		Vector3 origin; /**< Origin of the ray to cast into the scene. */
+		Vector3 unitDir; /**< Unit direction of the ray to cast into the scene. */
+		float max = FLT_MAX; /**< Maximum distance at which to perform the query. */
+	};
+
+	/** Sweep executed as a part of a batch of physics queries. */
+	struct PhysicsSweepQuery
+	{
+		PhysicsQueryShape shape; /**< Geometry to sweep through the scene, at its starting position. */
+		Vector3 unitDir; /**< Unit direction towards which to perform the sweep. */
+		float max = FLT_MAX; /**< Maximum distance at which to perform the query. */
+	};
+
+	/**
+	 * Keeps track of when the most recent simulation steps ended, and determines how to interpolate between their results
+	 * when the simulation runs asynchronously. Displayed state lags two steps behind the frame time, so both steps to
+	 * interpolate between have completed regardless of whether a step is currently running.
+	 */
+	struct BS_CORE_EXPORT PhysicsStepInterpolation
+	{
+		/** Number of most recent steps whose results need to be kept for interpolation. */
+		static const UINT32 NUM_STEPS = 3;
+
+		/** Registers a newly completed simulation step that ended at the provided simulation time. */
+		void addStep(float endTime);
+
+		/**
+		 * Determines how to interpolate between the results of the recorded steps for the provided frame time.
+		 *
+		 * @param[in]	frameTime	Time of the current frame, on the same timeline as step end times.
+		 * @param[in]	stepSize	Length of a single simulation step.
+		 * @param[out]	first		Index of the older of the two steps to interpolate between. The newer one is at index
+		 *							@p first + 1.
+		 * @return					Interpolation factor between the two steps, in [0, 1] range.
+		 */
+		float evaluate(float frameTime, float stepSize, UINT32& first) const;
+
+		/** End times of the most recent simulation steps, ordered from oldest to newest. */
+		float stepTimes[NUM_STEPS] = { 0.0f, 0.0f, 0.0f };
+	};
+
 	/** @} */
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "Profiling/BsProfilerCPU.h"
 #include "Debug/BsDebug.h"
 #include "Platform/BsPlatform.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsMath.h"
 #include <chrono>
 
 #if BS_COMPILER == BS_COMPILER_MSVC
@@ -101,183 +105,225 @@ namespace bs
 #endif		
 	}
 
-	ProfilerCPU::ProfileData::ProfileData(FrameAlloc* alloc)
-		:samples(alloc)
-	{ }
-
-	void ProfilerCPU::ProfileData::beginSample()
+	/** Hasher for profiler strings. */
+	struct ProfilerStringHash
 	{
-		memAllocs = MemoryCounter::getNumAllocs();
-		memFrees = MemoryCounter::getNumFrees();
+		size_t operator()(const ProfilerString& value) const
+		{
+			// FNV-1a
+			size_t hash = 2166136261U;
+			for (auto& entry : value)
+			{
+				hash ^= (size_t)(UINT8)entry;
+				hash *= 16777619U;
+			}
 
-		timer.reset();
-		timer.start();
-	}
+			return hash;
+		}
+	};
 
-	void ProfilerCPU::ProfileData::endSample()
+	/** Global registry of sample names, shared by all profiler instances for the lifetime of the application. */
+	struct ProfilerSampleNames
 	{
-		timer.stop();
+		/** Returns the ID of the sample with the provided name, registering it if required. */
+		ProfilerCPU::SampleId getId(const char* name, const char** internedName)
+		{
+			Lock lock(mutex);
+
+			auto iterFind = ids.find(ProfilerString(name));
+			if (iterFind == ids.end())
+			{
+				ProfilerCPU::SampleId id = (ProfilerCPU::SampleId)names.size();
+				iterFind = ids.insert(std::make_pair(ProfilerString(name), id)).first;
+
+				// Map nodes never move, so the key can be referenced directly
+				names.push_back(iterFind->first.c_str());
+			}
 
-		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
-		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+			if (internedName != nullptr)
+				*internedName = iterFind->first.c_str();
+
+			return iterFind->second;
+		}
 
-		samples.push_back(ProfileSample(timer.time, numAllocs, numFrees));
+		/** Returns the name of the sample with the provided ID. */
+		const char* getName(ProfilerCPU::SampleId id)
+		{
+			Lock lock(mutex);
+
+			if (id >= (ProfilerCPU::SampleId)names.size())
+				return "Unknown";
+
+			return names[id];
+		}
+
+		static ProfilerSampleNames& instance()
+		{
+			static ProfilerSampleNames inst;
+			return inst;
+		}
+
+		Mutex mutex;
+		UnorderedMap<ProfilerString, ProfilerCPU::SampleId, ProfilerStringHash, std::equal_to<ProfilerString>,
+			StdAlloc<std::pair<const ProfilerString, ProfilerCPU::SampleId>, ProfilerAlloc>> ids;
+		ProfilerVector<const char*> names;
+	};
+
+	/** Returns the current value of the monotonic clock, in nanoseconds. */
+	static UINT64 getCurrentTimeNs()
+	{
+		return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 	}
 
-	void ProfilerCPU::ProfileData::resumeLastSample()
+	/** Writes the provided string to a JSON stream as a quoted string, escaping any special characters. */
+	static void writeJSONString(StringStream& stream, const char* value)
 	{
-		timer.start();
-		samples.erase(samples.end() - 1);
+		stream << '"';
+		for (const char* iter = value; *iter != '\0'; ++iter)
+		{
+			if (*iter == '"' || *iter == '\\')
+				stream << '\\' << *iter;
+			else if ((UINT8)*iter < 0x20)
+				stream << ' ';
+			else
+				stream << *iter;
+		}
+		stream << '"';
 	}
 
-	ProfilerCPU::PreciseProfileData::PreciseProfileData(FrameAlloc* alloc)
-		:samples(alloc)
+	ProfilerCPU::ProfiledBlock::ProfiledBlock(SampleId sampleId)
+		: sampleId(sampleId), numCalls(0), totalTimeMs(0.0), maxTimeMs(0.0), memAllocs(0), memFrees(0)
+		, numPreciseCalls(0), totalCycles(0), maxCycles(0), preciseMemAllocs(0), preciseMemFrees(0)
 	{ }
 
-	void ProfilerCPU::PreciseProfileData::beginSample()
+	UINT32 ProfilerCPU::ProfiledBlock::findChild(const ProfilerVector<ProfiledBlock>& blocks, SampleId sampleId) const
 	{
-		memAllocs = MemoryCounter::getNumAllocs();
-		memFrees = MemoryCounter::getNumFrees();
+		for(auto& child : children)
+		{
+			if(blocks[child].sampleId == sampleId)
+				return child;
+		}
 
-		timer.reset();
-		timer.start();
+		return (UINT32)-1;
 	}
 
-	void ProfilerCPU::PreciseProfileData::endSample()
-	{
-		timer.stop();
+	const UINT32 ProfilerCPU::ThreadInfo::EVENT_BUFFER_SIZE = 32768;
+	BS_THREADLOCAL ProfilerCPU::ThreadInfo* ProfilerCPU::ThreadInfo::activeThread = nullptr;
 
-		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
-		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
+	ProfilerCPU::ThreadInfo::ThreadInfo(UINT32 id)
+		: id(id), nameId(ProfilerCPU::getSampleId("Unknown")), isActive(false), isReporting(false), pendingStart(0)
+		, events(nullptr), writePos(0), readPos(0), numDropped(0)
+	{
+		static_assert((EVENT_BUFFER_SIZE & (EVENT_BUFFER_SIZE - 1)) == 0, "Event buffer size must be a power of two.");
 
-		samples.push_back(PreciseProfileSample(timer.cycles, numAllocs, numFrees));
+		events = bs_newN<Event, ProfilerAlloc>(EVENT_BUFFER_SIZE);
 	}
 
-	void ProfilerCPU::PreciseProfileData::resumeLastSample()
+	ProfilerCPU::ThreadInfo::~ThreadInfo()
 	{
-		timer.start();
-		samples.erase(samples.end() - 1);
+		bs_deleteN<Event, ProfilerAlloc>(events, EVENT_BUFFER_SIZE);
 	}
 
-	BS_THREADLOCAL ProfilerCPU::ThreadInfo* ProfilerCPU::ThreadInfo::activeThread = nullptr;
-
-	ProfilerCPU::ThreadInfo::ThreadInfo()
-		:isActive(false), rootBlock(nullptr), frameAlloc(1024 * 512), activeBlocks(nullptr)
+	void ProfilerCPU::ThreadInfo::record(EventType type, SampleId sampleId)
 	{
+		UINT32 write = writePos.load(std::memory_order_relaxed);
+		UINT32 read = readPos.load(std::memory_order_acquire);
 
-	}
-
-	void ProfilerCPU::ThreadInfo::begin(const char* _name)
-	{
-		if(isActive)
+		if((write - read) >= EVENT_BUFFER_SIZE)
 		{
-			LOGWRN("Profiler::beginThread called on a thread that was already being sampled");
+			numDropped.fetch_add(1, std::memory_order_relaxed);
 			return;
 		}
 
-		if(rootBlock == nullptr)
-			rootBlock = getBlock(_name);
+		Event& event = events[write & (EVENT_BUFFER_SIZE - 1)];
+		event.sampleId = sampleId;
+		event.type = type;
 
-		activeBlock = ActiveBlock(ActiveSamplingType::Basic, rootBlock);
-		if (activeBlocks == nullptr)
-			activeBlocks = frameAlloc.alloc<Stack<ActiveBlock, StdFrameAlloc<ActiveBlock>>>(&frameAlloc);
+		// Read the counters as close to the measured code as possible
+		if(type == EventType::EndSamplePrecise)
+		{
+			event.cycles = TimerPrecise::getNumCycles();
+			event.time = getCurrentTimeNs();
+			event.numAllocs = MemoryCounter::getNumAllocs();
+			event.numFrees = MemoryCounter::getNumFrees();
+		}
+		else
+		{
+			event.numAllocs = MemoryCounter::getNumAllocs();
+			event.numFrees = MemoryCounter::getNumFrees();
+			event.time = getCurrentTimeNs();
+			event.cycles = type == EventType::BeginSamplePrecise ? TimerPrecise::getNumCycles() : 0;
+		}
 
-		activeBlocks->push(activeBlock);
-		
-		rootBlock->basic.beginSample();
-		isActive = true;
+		writePos.store(write + 1, std::memory_order_release);
 	}
 
-	void ProfilerCPU::ThreadInfo::end()
+	void ProfilerCPU::ThreadInfo::drain(bool captureTrace)
 	{
-		if(activeBlock.type == ActiveSamplingType::Basic)
-			activeBlock.block->basic.endSample();
-		else
-			activeBlock.block->precise.endSample();
+		UINT32 read = readPos.load(std::memory_order_relaxed);
+		UINT32 write = writePos.load(std::memory_order_acquire);
 
-		activeBlocks->pop();
+		if(pendingEvents.empty())
+			pendingStart = read;
 
-		if(!isActive)
-			LOGWRN("Profiler::endThread called on a thread that isn't being sampled.");
-
-		if (activeBlocks->size() > 0)
+		if(isReporting || captureTrace)
 		{
-			LOGWRN("Profiler::endThread called but not all sample pairs were closed. Sampling data will not be valid.");
-
-			while (activeBlocks->size() > 0)
+			UINT32 dropped = numDropped.exchange(0, std::memory_order_relaxed);
+			if(dropped > 0)
 			{
-				ActiveBlock& curBlock = activeBlocks->top();
-				if(curBlock.type == ActiveSamplingType::Basic)
-					curBlock.block->basic.endSample();
-				else
-					curBlock.block->precise.endSample();
-
-				activeBlocks->pop();
+				LOGWRN("Profiler event buffer overflow, " + toString(dropped) + " events were dropped. Sampling data "
+					"will not be valid.");
 			}
-		}
 
-		isActive = false;
-		activeBlock = ActiveBlock();
+			// Copy in at most two contiguous ranges, as the events can wrap around the end of the buffer
+			UINT32 count = write - read;
+			UINT32 start = read & (EVENT_BUFFER_SIZE - 1);
+			UINT32 firstCount = std::min(count, EVENT_BUFFER_SIZE - start);
 
-		frameAlloc.dealloc(activeBlocks);
-		activeBlocks = nullptr;
-	}
-
-	void ProfilerCPU::ThreadInfo::reset()
-	{
-		if(isActive)
-			end();
+			if(isReporting)
+			{
+				pendingEvents.insert(pendingEvents.end(), events + start, events + start + firstCount);
+				pendingEvents.insert(pendingEvents.end(), events, events + (count - firstCount));
+			}
 
-		if(rootBlock != nullptr)
-			releaseBlock(rootBlock);
+			if(captureTrace)
+			{
+				traceEvents.insert(traceEvents.end(), events + start, events + start + firstCount);
+				traceEvents.insert(traceEvents.end(), events, events + (count - firstCount));
+			}
+		}
+		else
+			numDropped.store(0, std::memory_order_relaxed);
 
-		rootBlock = nullptr;
-		frameAlloc.clear(); // Note: This never actually frees memory
+		readPos.store(write, std::memory_order_release);
 	}
 
-	ProfilerCPU::ProfiledBlock* ProfilerCPU::ThreadInfo::getBlock(const char* name)
+	void ProfilerCPU::ThreadInfo::takePending(UINT32 end, ProfilerVector<Event>& output)
 	{
-		ProfiledBlock* block = frameAlloc.alloc<ProfiledBlock>(&frameAlloc);
-		block->name = (char*)frameAlloc.alloc(((UINT32)strlen(name) + 1) * sizeof(char));
-		strcpy(block->name, name);
+		INT32 count = Math::clamp((INT32)(end - pendingStart), 0, (INT32)pendingEvents.size());
 
-		return block;
+		output.assign(pendingEvents.begin(), pendingEvents.begin() + count);
+		pendingEvents.erase(pendingEvents.begin(), pendingEvents.begin() + count);
+		pendingStart += count;
 	}
 
-	void ProfilerCPU::ThreadInfo::releaseBlock(ProfiledBlock* block)
+	ProfilerCPU::SampleId ProfilerCPU::ThreadInfo::getSampleId(const char* name)
 	{
-		frameAlloc.dealloc((UINT8*)block->name);
-		frameAlloc.dealloc(block);
-	}
-
-	ProfilerCPU::ProfiledBlock::ProfiledBlock(FrameAlloc* alloc)
-		:basic(alloc), precise(alloc), children(alloc)
-	{ }
-
-	ProfilerCPU::ProfiledBlock::~ProfiledBlock()
-	{
-		ThreadInfo* thread = ThreadInfo::activeThread;
-
-		for(auto& child : children)
-			thread->releaseBlock(child);
-
-		children.clear();
-	}
+		// Names are cached by address, so make sure the contents match in case the memory was re-used
+		auto iterFind = nameCache.find(name);
+		if(iterFind != nameCache.end() && strcmp(iterFind->second.name, name) == 0)
+			return iterFind->second.id;
 
-	ProfilerCPU::ProfiledBlock* ProfilerCPU::ProfiledBlock::findChild(const char* name) const
-	{
-		for(auto& child : children)
-		{
-			if(strcmp(child->name, name) == 0)
-				return child;
-		}
+		CachedSampleName cachedName;
+		cachedName.id = ProfilerSampleNames::instance().getId(name, &cachedName.name);
 
-		return nullptr;
+		nameCache[name] = cachedName;
+		return cachedName.id;
 	}
 
 	ProfilerCPU::ProfilerCPU()
 		: mBasicTimerOverhead(0.0), mPreciseTimerOverhead(0), mBasicSamplingOverheadMs(0.0), mPreciseSamplingOverheadMs(0.0)
-		, mBasicSamplingOverheadCycles(0), mPreciseSamplingOverheadCycles(0)
+		, mBasicSamplingOverheadCycles(0), mPreciseSamplingOverheadCycles(0), mCaptureTrace(false)
 	{
 		// TODO - We only estimate overhead on program start. It might be better to estimate it each time beginThread is called,
 		// and keep separate values per thread.
@@ -294,262 +340,360 @@ namespace bs
 			bs_delete<ThreadInfo, ProfilerAlloc>(threadInfo);
 	}
 
-	void ProfilerCPU::beginThread(const char* name)
+	ProfilerCPU::SampleId ProfilerCPU::getSampleId(const char* name)
 	{
-		ThreadInfo* thread = ThreadInfo::activeThread;
-		if(thread == nullptr)
-		{
-			ThreadInfo::activeThread = bs_new<ThreadInfo, ProfilerAlloc>();
-			thread = ThreadInfo::activeThread;
-
-			{
-				Lock lock(mThreadSync);
-
-				mActiveThreads.push_back(thread);
-			}
-		}
-
-		thread->begin(name);
+		return ProfilerSampleNames::instance().getId(name, nullptr);
 	}
 
-	void ProfilerCPU::endThread()
+	const char* ProfilerCPU::getSampleName(SampleId id)
 	{
-		// I don't do a nullcheck where on purpose, so endSample can be called ASAP
-		ThreadInfo::activeThread->end();
+		return ProfilerSampleNames::instance().getName(id);
 	}
 
-	void ProfilerCPU::beginSample(const char* name)
+	ProfilerCPU::ThreadInfo* ProfilerCPU::getThread()
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
-		if(thread == nullptr || !thread->isActive)
+		if(thread == nullptr)
 		{
-			beginThread("Unknown");
-			thread = ThreadInfo::activeThread;
-		}
+			Lock lock(mThreadSync);
 
-		ProfiledBlock* parent = thread->activeBlock.block;
-		ProfiledBlock* block = nullptr;
-		
-		if(parent != nullptr)
-			block = parent->findChild(name);
+			thread = bs_new<ThreadInfo, ProfilerAlloc>((UINT32)mActiveThreads.size());
+			mActiveThreads.push_back(thread);
 
-		if(block == nullptr)
-		{
-			block = thread->getBlock(name);
-
-			if(parent != nullptr)
-				parent->children.push_back(block);
-			else
-				thread->rootBlock->children.push_back(block);
+			ThreadInfo::activeThread = thread;
 		}
 
-		thread->activeBlock = ActiveBlock(ActiveSamplingType::Basic, block);
-		thread->activeBlocks->push(thread->activeBlock);
-
-		block->basic.beginSample();
+		return thread;
 	}
 
-	void ProfilerCPU::endSample(const char* name)
+	void ProfilerCPU::record(EventType type, SampleId id)
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
-		ProfiledBlock* block = thread->activeBlock.block;
+		if(thread == nullptr)
+			thread = getThread();
 
-#if BS_DEBUG_MODE
-		if(block == nullptr)
-		{
-			LOGWRN("Mismatched CPUProfiler::endSample. No beginSample was called.");
-			return;
-		}
+		thread->record(type, id);
+	}
 
-		if(thread->activeBlock.type == ActiveSamplingType::Precise)
+	void ProfilerCPU::beginThread(const char* name)
+	{
+		ThreadInfo* thread = getThread();
+		if(thread->isActive)
 		{
-			LOGWRN("Mismatched CPUProfiler::endSample. Was expecting Profiler::endSamplePrecise.");
+			LOGWRN("Profiler::beginThread called on a thread that was already being sampled");
 			return;
 		}
 
-		if(strcmp(block->name, name) != 0)
+		thread->nameId = thread->getSampleId(name);
+		thread->isActive = true;
+		thread->record(EventType::ThreadBegin, thread->nameId);
+	}
+
+	void ProfilerCPU::endThread()
+	{
+		ThreadInfo* thread = getThread();
+		if(!thread->isActive)
 		{
-			LOGWRN("Mismatched CPUProfiler::endSample. Was expecting \"" + String(block->name) + 
-				"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
+			LOGWRN("Profiler::endThread called on a thread that isn't being sampled.");
 			return;
 		}
-#endif
 
-		block->basic.endSample();
+		thread->record(EventType::ThreadEnd, thread->nameId);
+		thread->isActive = false;
+	}
+
+	void ProfilerCPU::beginSample(const char* name)
+	{
+		ThreadInfo* thread = getThread();
+		thread->record(EventType::BeginSample, thread->getSampleId(name));
+	}
+
+	void ProfilerCPU::beginSample(SampleId id)
+	{
+		record(EventType::BeginSample, id);
+	}
 
-		thread->activeBlocks->pop();
+	void ProfilerCPU::endSample(const char* name)
+	{
+		ThreadInfo* thread = getThread();
+		thread->record(EventType::EndSample, thread->getSampleId(name));
+	}
 
-		if (!thread->activeBlocks->empty())
-			thread->activeBlock = thread->activeBlocks->top();
-		else
-			thread->activeBlock = ActiveBlock();
+	void ProfilerCPU::endSample(SampleId id)
+	{
+		record(EventType::EndSample, id);
 	}
 
 	void ProfilerCPU::beginSamplePrecise(const char* name)
 	{
 		// Note: There is a (small) possibility a context switch will happen during this measurement in which case result will be skewed. 
 		// Increasing thread priority might help. This is generally only a problem with code that executes a long time (10-15+ ms - depending on OS quant length)
-		
-		ThreadInfo* thread = ThreadInfo::activeThread;
-		if(thread == nullptr || !thread->isActive)
-			beginThread("Unknown");
 
-		ProfiledBlock* parent = thread->activeBlock.block;
-		ProfiledBlock* block = nullptr;
-		
-		if(parent != nullptr)
-			block = parent->findChild(name);
+		ThreadInfo* thread = getThread();
+		thread->record(EventType::BeginSamplePrecise, thread->getSampleId(name));
+	}
 
-		if(block == nullptr)
-		{
-			block = thread->getBlock(name);
+	void ProfilerCPU::beginSamplePrecise(SampleId id)
+	{
+		record(EventType::BeginSamplePrecise, id);
+	}
 
-			if(parent != nullptr)
-				parent->children.push_back(block);
-			else
-				thread->rootBlock->children.push_back(block);
-		}
+	void ProfilerCPU::endSamplePrecise(const char* name)
+	{
+		ThreadInfo* thread = getThread();
+		thread->record(EventType::EndSamplePrecise, thread->getSampleId(name));
+	}
 
-		thread->activeBlock = ActiveBlock(ActiveSamplingType::Precise, block);
-		thread->activeBlocks->push(thread->activeBlock);
+	void ProfilerCPU::endSamplePrecise(SampleId id)
+	{
+		record(EventType::EndSamplePrecise, id);
+	}
 
-		block->precise.beginSample();
+	void ProfilerCPU::reset()
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr)
+			return;
+
+		if(thread->isActive)
+			endThread();
+
+		Lock lock(thread->consumerMutex);
+		thread->drain(mCaptureTrace);
+		thread->pendingEvents.clear();
 	}
 
-	void ProfilerCPU::endSamplePrecise(const char* name)
+	CPUProfilerReport ProfilerCPU::generateReport()
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
-		ProfiledBlock* block = thread->activeBlock.block;
+		if(thread == nullptr)
+			return CPUProfilerReport();
 
-#if BS_DEBUG_MODE
-		if(block == nullptr)
+		UINT32 end = captureEvents(thread);
+
+		ProfilerVector<Event> events;
 		{
-			LOGWRN("Mismatched Profiler::endSamplePrecise. No beginSamplePrecise was called.");
-			return;
+			Lock lock(thread->consumerMutex);
+
+			thread->drain(mCaptureTrace);
+			thread->takePending(end, events);
 		}
 
-		if(thread->activeBlock.type == ActiveSamplingType::Basic)
+		return buildReport(thread->nameId, events);
+	}
+
+	SPtr<Task> ProfilerCPU::generateReportAsync(const std::function<void(CPUProfilerReport&)>& onComplete)
+	{
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread == nullptr || !TaskScheduler::isStarted())
 		{
-			LOGWRN("Mismatched CPUProfiler::endSamplePrecise. Was expecting Profiler::endSample.");
-			return;
+			CPUProfilerReport report = generateReport();
+			onComplete(report);
+
+			return nullptr;
 		}
 
-		if (strcmp(block->name, name) != 0)
+		// Only mark the end of the reported events on the profiled thread. Moving the events out of the thread's 
+		// buffer and aggregating them is left to the worker.
+		UINT32 end = captureEvents(thread);
+		SampleId threadNameId = thread->nameId;
+
+		auto buildReportWorker = [this, thread, end, threadNameId, onComplete]()
 		{
-			LOGWRN("Mismatched Profiler::endSamplePrecise. Was expecting \"" + String(block->name) + 
-				"\" but got \"" + String(name) + "\". Sampling data will not be valid.");
-			return;
-		}
-#endif
+			ProfilerVector<Event> events;
+			{
+				Lock lock(thread->consumerMutex);
 
-		block->precise.endSample();
+				thread->drain(mCaptureTrace);
+				thread->takePending(end, events);
+			}
 
-		thread->activeBlocks->pop();
+			CPUProfilerReport report = buildReport(threadNameId, events);
+			onComplete(report);
+		};
 
-		if (!thread->activeBlocks->empty())
-			thread->activeBlock = thread->activeBlocks->top();
-		else
-			thread->activeBlock = ActiveBlock();
+		SPtr<Task> task = Task::create("ProfilerReport", buildReportWorker, TaskPriority::Low);
+		TaskScheduler::instance().addTask(task);
+
+		return task;
 	}
 
-	void ProfilerCPU::reset()
+	UINT32 ProfilerCPU::captureEvents(ThreadInfo* thread)
 	{
-		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(thread->isActive)
+			endThread();
+
+		if(!thread->isReporting)
+		{
+			Lock lock(thread->consumerMutex);
+			thread->isReporting = true;
+		}
 
-		if(thread != nullptr)
-			thread->reset();
+		return thread->writePos.load(std::memory_order_relaxed);
 	}
 
-	CPUProfilerReport ProfilerCPU::generateReport()
+	CPUProfilerReport ProfilerCPU::buildReport(SampleId threadNameId, const ProfilerVector<Event>& events) const
 	{
 		CPUProfilerReport report;
-
-		ThreadInfo* thread = ThreadInfo::activeThread;
-		if(thread == nullptr)
+		if(events.empty())
 			return report;
 
-		if(thread->isActive)
-			thread->end();
+		// Build the block hierarchy from the recorded events. Children are always added after their parents.
+		ProfilerVector<ProfiledBlock> blocks;
+		blocks.push_back(ProfiledBlock(threadNameId));
 
-		// We need to separate out basic and precise data and form two separate hierarchies
-		if(thread->rootBlock == nullptr)
-			return report;
+		struct OpenSample
+		{
+			UINT32 blockIdx;
+			const Event* begin;
+		};
 
-		struct TempEntry
+		ProfilerVector<OpenSample> openSamples;
+
+		auto closeSample = [&blocks, &openSamples](const Event& end)
 		{
-			TempEntry(ProfiledBlock* _parentBlock, UINT32 _entryIdx)
-				:parentBlock(_parentBlock), entryIdx(_entryIdx)
-			{ }
+			OpenSample openSample = openSamples.back();
+			openSamples.pop_back();
 
-			ProfiledBlock* parentBlock;
-			UINT32 entryIdx;
-			ProfilerVector<UINT32> childIndexes;
-		};
+			ProfiledBlock& block = blocks[openSample.blockIdx];
+			const Event& begin = *openSample.begin;
 
-		ProfilerVector<CPUProfilerBasicSamplingEntry> basicEntries;
-		ProfilerVector<CPUProfilerPreciseSamplingEntry> preciseEntries;	
+			UINT64 numAllocs = end.numAllocs - begin.numAllocs;
+			UINT64 numFrees = end.numFrees - begin.numFrees;
 
-		// Fill up flatHierarchy array in a way so we always process children before parents
-		ProfilerStack<UINT32> todo;
-		ProfilerVector<TempEntry> flatHierarchy;
+			if(begin.type == EventType::BeginSamplePrecise)
+			{
+				UINT64 cycles = end.cycles - begin.cycles;
 
-		UINT32 entryIdx = 0;
-		todo.push(entryIdx);
-		flatHierarchy.push_back(TempEntry(thread->rootBlock, entryIdx));
+				block.numPreciseCalls++;
+				block.totalCycles += cycles;
+				block.maxCycles = std::max(block.maxCycles, cycles);
+				block.preciseMemAllocs += numAllocs;
+				block.preciseMemFrees += numFrees;
+			}
+			else
+			{
+				double timeMs = (end.time - begin.time) * 0.000001;
 
-		entryIdx++;
-		while(!todo.empty())
+				block.numCalls++;
+				block.totalTimeMs += timeMs;
+				block.maxTimeMs = std::max(block.maxTimeMs, timeMs);
+				block.memAllocs += numAllocs;
+				block.memFrees += numFrees;
+			}
+		};
+
+		for(auto& event : events)
 		{
-			UINT32 curDataIdx = todo.top();
-			ProfiledBlock* curBlock = flatHierarchy[curDataIdx].parentBlock;
+			switch(event.type)
+			{
+			case EventType::ThreadBegin:
+				if(openSamples.empty())
+				{
+					blocks[0].sampleId = event.sampleId;
+					openSamples.push_back({ 0, &event });
+				}
+				break;
+			case EventType::ThreadEnd:
+				if(openSamples.empty() || openSamples[0].begin->type != EventType::ThreadBegin)
+					break;
 
-			todo.pop();
+				if(openSamples.size() > 1)
+				{
+					LOGWRN("Profiler::endThread called but not all sample pairs were closed. Sampling data will not be "
+						"valid.");
+				}
 
-			for(auto& child : curBlock->children)
-			{
-				flatHierarchy[curDataIdx].childIndexes.push_back(entryIdx);
+				while(!openSamples.empty())
+					closeSample(event);
+				break;
+			case EventType::BeginSample:
+			case EventType::BeginSamplePrecise:
+				{
+					UINT32 parentIdx = openSamples.empty() ? 0 : openSamples.back().blockIdx;
+					UINT32 blockIdx = blocks[parentIdx].findChild(blocks, event.sampleId);
 
-				todo.push(entryIdx);
-				flatHierarchy.push_back(TempEntry(child, entryIdx));
+					if(blockIdx == (UINT32)-1)
+					{
+						blockIdx = (UINT32)blocks.size();
+						blocks.push_back(ProfiledBlock(event.sampleId));
+						blocks[parentIdx].children.push_back(blockIdx);
+					}
 
-				entryIdx++;
+					openSamples.push_back({ blockIdx, &event });
+				}
+				break;
+			case EventType::EndSample:
+			case EventType::EndSamplePrecise:
+				{
+					EventType beginType = event.type == EventType::EndSample ? EventType::BeginSample :
+						EventType::BeginSamplePrecise;
+
+					if(openSamples.empty() || openSamples.back().begin->type != beginType)
+					{
+						LOGWRN("Mismatched CPUProfiler::endSample. No matching beginSample was called for \"" + 
+							String(getSampleName(event.sampleId)) + "\".");
+						break;
+					}
+
+					const OpenSample& openSample = openSamples.back();
+					if(blocks[openSample.blockIdx].sampleId != event.sampleId)
+					{
+						LOGWRN("Mismatched CPUProfiler::endSample. Was expecting \"" + 
+							String(getSampleName(blocks[openSample.blockIdx].sampleId)) + "\" but got \"" + 
+							String(getSampleName(event.sampleId)) + "\". Sampling data will not be valid.");
+						break;
+					}
+
+					closeSample(event);
+				}
+				break;
 			}
 		}
-		
-		// Calculate sampling data for all entries
-		basicEntries.resize(flatHierarchy.size());
-		preciseEntries.resize(flatHierarchy.size());
 
-		for(auto iter = flatHierarchy.rbegin(); iter != flatHierarchy.rend(); ++iter)
+		// Terminate any samples that were never ended
+		while(!openSamples.empty())
+			closeSample(events.back());
+
+		struct TempEntry
 		{
-			TempEntry& curData = *iter;
-			ProfiledBlock* curBlock = curData.parentBlock;
+			TempEntry(UINT32 _entryIdx)
+				:entryIdx(_entryIdx)
+			{ }
 
-			CPUProfilerBasicSamplingEntry* entryBasic = &basicEntries[curData.entryIdx];
-			CPUProfilerPreciseSamplingEntry* entryPrecise = &preciseEntries[curData.entryIdx];
+			UINT32 entryIdx;
+			ProfilerVector<UINT32> childIndexes;
+		};
 
-			// Calculate basic data
-			entryBasic->data.name = String(curBlock->name);
+		ProfilerVector<CPUProfilerBasicSamplingEntry> basicEntries;
+		ProfilerVector<CPUProfilerPreciseSamplingEntry> preciseEntries;	
 
-			entryBasic->data.memAllocs = 0;
-			entryBasic->data.memFrees = 0;
-			entryBasic->data.totalTimeMs = 0.0;
-			entryBasic->data.maxTimeMs = 0.0;
-			for(auto& sample : curBlock->basic.samples)
-			{
-				entryBasic->data.totalTimeMs += sample.time;
-				entryBasic->data.maxTimeMs = std::max(entryBasic->data.maxTimeMs, sample.time);
-				entryBasic->data.memAllocs += sample.numAllocs;
-				entryBasic->data.memFrees += sample.numFrees;
-			}
+		// Calculate sampling data for all entries, processing children before parents
+		basicEntries.resize(blocks.size());
+		preciseEntries.resize(blocks.size());
+
+		for(UINT32 i = (UINT32)blocks.size(); i-- > 0;)
+		{
+			const ProfiledBlock& curBlock = blocks[i];
+			String name = getSampleName(curBlock.sampleId);
+
+			CPUProfilerBasicSamplingEntry* entryBasic = &basicEntries[i];
+			CPUProfilerPreciseSamplingEntry* entryPrecise = &preciseEntries[i];
 
-			entryBasic->data.numCalls = (UINT32)curBlock->basic.samples.size();
+			// Calculate basic data
+			entryBasic->data.name = name;
+
+			entryBasic->data.memAllocs = curBlock.memAllocs;
+			entryBasic->data.memFrees = curBlock.memFrees;
+			entryBasic->data.totalTimeMs = curBlock.totalTimeMs;
+			entryBasic->data.maxTimeMs = curBlock.maxTimeMs;
+			entryBasic->data.numCalls = curBlock.numCalls;
 
 			if(entryBasic->data.numCalls > 0)
 				entryBasic->data.avgTimeMs = entryBasic->data.totalTimeMs / entryBasic->data.numCalls;
 
 			double totalChildTime = 0.0;
-			for(auto& childIdx : curData.childIndexes)
+			for(auto& childIdx : curBlock.children)
 			{
 				CPUProfilerBasicSamplingEntry* childEntry = &basicEntries[childIdx];
 				totalChildTime += childEntry->data.totalTimeMs;
@@ -558,8 +702,8 @@ namespace bs
 				entryBasic->data.estimatedOverheadMs += childEntry->data.estimatedOverheadMs;
 			}
 
-			entryBasic->data.estimatedOverheadMs += curBlock->basic.samples.size() * mBasicSamplingOverheadMs;
-			entryBasic->data.estimatedOverheadMs += curBlock->precise.samples.size() * mPreciseSamplingOverheadMs;
+			entryBasic->data.estimatedOverheadMs += curBlock.numCalls * mBasicSamplingOverheadMs;
+			entryBasic->data.estimatedOverheadMs += curBlock.numPreciseCalls * mPreciseSamplingOverheadMs;
 
 			entryBasic->data.totalSelfTimeMs = entryBasic->data.totalTimeMs - totalChildTime;
 
@@ -569,27 +713,19 @@ namespace bs
 			entryBasic->data.estimatedSelfOverheadMs = mBasicTimerOverhead;
 
 			// Calculate precise data
-			entryPrecise->data.name = String(curBlock->name);
+			entryPrecise->data.name = name;
 
-			entryPrecise->data.memAllocs = 0;
-			entryPrecise->data.memFrees = 0;
-			entryPrecise->data.totalCycles = 0;
-			entryPrecise->data.maxCycles = 0;
-			for(auto& sample : curBlock->precise.samples)
-			{
-				entryPrecise->data.totalCycles += sample.cycles;
-				entryPrecise->data.maxCycles = std::max(entryPrecise->data.maxCycles, sample.cycles);
-				entryPrecise->data.memAllocs += sample.numAllocs;
-				entryPrecise->data.memFrees += sample.numFrees;
-			}
-
-			entryPrecise->data.numCalls = (UINT32)curBlock->precise.samples.size();
+			entryPrecise->data.memAllocs = curBlock.preciseMemAllocs;
+			entryPrecise->data.memFrees = curBlock.preciseMemFrees;
+			entryPrecise->data.totalCycles = curBlock.totalCycles;
+			entryPrecise->data.maxCycles = curBlock.maxCycles;
+			entryPrecise->data.numCalls = curBlock.numPreciseCalls;
 
 			if(entryPrecise->data.numCalls > 0)
 				entryPrecise->data.avgCycles = entryPrecise->data.totalCycles / entryPrecise->data.numCalls;
 
 			UINT64 totalChildCycles = 0;
-			for(auto& childIdx : curData.childIndexes)
+			for(auto& childIdx : curBlock.children)
 			{
 				CPUProfilerPreciseSamplingEntry* childEntry = &preciseEntries[childIdx];
 				totalChildCycles += childEntry->data.totalCycles;
@@ -598,8 +734,8 @@ namespace bs
 				entryPrecise->data.estimatedOverhead += childEntry->data.estimatedOverhead;
 			}
 
-			entryPrecise->data.estimatedOverhead += curBlock->precise.samples.size() * mPreciseSamplingOverheadCycles;
-			entryPrecise->data.estimatedOverhead += curBlock->basic.samples.size() * mBasicSamplingOverheadCycles;
+			entryPrecise->data.estimatedOverhead += curBlock.numPreciseCalls * mPreciseSamplingOverheadCycles;
+			entryPrecise->data.estimatedOverhead += curBlock.numCalls * mBasicSamplingOverheadCycles;
 
 			entryPrecise->data.totalSelfCycles = entryPrecise->data.totalCycles - totalChildCycles;
 
@@ -616,9 +752,9 @@ namespace bs
 
 		finalBasicHierarchyTodo.push(0);
 
-		entryIdx = 0;
+		UINT32 entryIdx = 0;
 		parentBasicEntryIndexes.push(entryIdx);
-		newBasicEntries.push_back(TempEntry(nullptr, entryIdx));
+		newBasicEntries.push_back(TempEntry(entryIdx));
 
 		entryIdx++;
 
@@ -628,17 +764,17 @@ namespace bs
 			parentBasicEntryIndexes.pop();
 
 			UINT32 curEntryIdx = finalBasicHierarchyTodo.top();
-			TempEntry& curEntry = flatHierarchy[curEntryIdx];
+			const ProfiledBlock& curBlock = blocks[curEntryIdx];
 			finalBasicHierarchyTodo.pop();
 
-			for(auto& childIdx : curEntry.childIndexes)
+			for(auto& childIdx : curBlock.children)
 			{
 				finalBasicHierarchyTodo.push(childIdx);
 
 				CPUProfilerBasicSamplingEntry& basicEntry = basicEntries[childIdx];
 				if(basicEntry.data.numCalls > 0)
 				{
-					newBasicEntries.push_back(TempEntry(nullptr, childIdx));
+					newBasicEntries.push_back(TempEntry(childIdx));
 					newBasicEntries[parentEntryIdx].childIndexes.push_back(entryIdx);
 
 					parentBasicEntryIndexes.push(entryIdx);
@@ -692,7 +828,7 @@ namespace bs
 
 		entryIdx = 0;
 		parentPreciseEntryIndexes.push(entryIdx);
-		newPreciseEntries.push_back(TempEntry(nullptr, entryIdx));
+		newPreciseEntries.push_back(TempEntry(entryIdx));
 
 		entryIdx++;
 
@@ -702,17 +838,17 @@ namespace bs
 			parentPreciseEntryIndexes.pop();
 
 			UINT32 curEntryIdx = finalPreciseHierarchyTodo.top();
-			TempEntry& curEntry = flatHierarchy[curEntryIdx];
+			const ProfiledBlock& curBlock = blocks[curEntryIdx];
 			finalPreciseHierarchyTodo.pop();
 
-			for(auto& childIdx : curEntry.childIndexes)
+			for(auto& childIdx : curBlock.children)
 			{
 				finalPreciseHierarchyTodo.push(childIdx);
 
 				CPUProfilerPreciseSamplingEntry& preciseEntry = preciseEntries[childIdx];
 				if(preciseEntry.data.numCalls > 0)
 				{
-					newPreciseEntries.push_back(TempEntry(nullptr, childIdx));
+					newPreciseEntries.push_back(TempEntry(childIdx));
 					newPreciseEntries[parentEntryIdx].childIndexes.push_back(entryIdx);
 
 					parentPreciseEntryIndexes.push(entryIdx);
@@ -760,6 +896,108 @@ namespace bs
 		return report;
 	}
 
+	void ProfilerCPU::beginTraceCapture()
+	{
+		Lock lock(mThreadSync);
+
+		for(auto& thread : mActiveThreads)
+		{
+			Lock threadLock(thread->consumerMutex);
+
+			thread->drain(false);
+			thread->traceEvents.clear();
+		}
+
+		mCaptureTrace = true;
+	}
+
+	void ProfilerCPU::endTraceCapture()
+	{
+		_collectTrace();
+
+		mCaptureTrace = false;
+	}
+
+	void ProfilerCPU::_collectTrace()
+	{
+		if(!mCaptureTrace)
+			return;
+
+		Lock lock(mThreadSync);
+
+		for(auto& thread : mActiveThreads)
+		{
+			Lock threadLock(thread->consumerMutex);
+			thread->drain(true);
+		}
+	}
+
+	void ProfilerCPU::saveTrace(const Path& path)
+	{
+		_collectTrace();
+
+		StringStream stream;
+		stream.precision(3);
+		stream << std::fixed;
+
+		stream << "{\"traceEvents\":[";
+
+		{
+			Lock lock(mThreadSync);
+
+			// Display times relative to the first captured event
+			UINT64 startTime = std::numeric_limits<UINT64>::max();
+			for(auto& thread : mActiveThreads)
+			{
+				Lock threadLock(thread->consumerMutex);
+
+				if(!thread->traceEvents.empty())
+					startTime = std::min(startTime, thread->traceEvents[0].time);
+			}
+
+			bool first = true;
+			for(auto& thread : mActiveThreads)
+			{
+				Lock threadLock(thread->consumerMutex);
+
+				if(!first)
+					stream << ",";
+
+				first = false;
+
+				stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread->id;
+				stream << ",\"args\":{\"name\":";
+				writeJSONString(stream, getSampleName(thread->nameId));
+				stream << "}}";
+
+				for(auto& event : thread->traceEvents)
+				{
+					bool isBegin = event.type == EventType::ThreadBegin || event.type == EventType::BeginSample || 
+						event.type == EventType::BeginSamplePrecise;
+
+					stream << ",{\"name\":";
+					writeJSONString(stream, getSampleName(event.sampleId));
+					stream << ",\"ph\":\"" << (isBegin ? "B" : "E") << "\",\"pid\":0,\"tid\":" << thread->id;
+					stream << ",\"ts\":" << (event.time - startTime) * 0.001 << "}";
+				}
+			}
+		}
+
+		stream << "]}";
+
+		String output = stream.str();
+
+		SPtr<DataStream> fileStream = FileSystem::createAndOpenFile(path);
+		if(fileStream == nullptr)
+		{
+			LOGWRN("Unable to save profiler trace to: " + path.toString());
+			return;
+		}
+
+		fileStream->write(output.data(), output.size());
+		fileStream->close();
+	}
+
 	void ProfilerCPU::estimateTimerOverhead()
 	{
 		// Get an idea of how long timer calls and RDTSC takes
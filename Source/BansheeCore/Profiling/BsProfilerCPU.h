@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Allocators/BsFrameAlloc.h"
+#include <atomic>
 
 namespace bs
 {
@@ -16,11 +17,20 @@ namespace bs
 
 	/**
 	 * Provides various performance measuring methods.
+	 *
+	 * Sampling methods only record a timestamped event into a lock-free buffer owned by the calling thread. Events are
+	 * aggregated into a hierarchy of profiling blocks only when a report is generated, and can optionally be captured
+	 * from all threads and exported in the Chrome trace event format.
 	 * 			
 	 * @note	Thread safe. Matching begin* \ end* calls must belong to the same thread though.
 	 */
 	class BS_CORE_EXPORT ProfilerCPU : public Module<ProfilerCPU>
 	{
+	public:
+		/** Unique identifier of a named sample. @see getSampleId() */
+		typedef UINT32 SampleId;
+
+	private:
 		/**	Timer class responsible for tracking elapsed time. */
 		class Timer
 		{
@@ -60,188 +70,136 @@ namespace bs
 			/**	Resets the cycle count to zero. */
 			void reset();
 
-			UINT64 cycles;
-		private:
-			UINT64 startCycles;
-
 			/** Queries the CPU for the current number of CPU cycles executed since the program was started. */
 			static inline UINT64 getNumCycles();
-		};
-
-		/**
-		 * Contains data about a single profiler sample (counting time in milliseconds).
-		 *	
-		 * @note	
-		 * A sample is created whenever a named profile block is entered. For example if you have a function you are
-		 * profiling, and it gets called 10 times, there will be 10 samples.
-		 */
-		struct ProfileSample
-		{
-			ProfileSample(double _time, UINT64 _numAllocs, UINT64 _numFrees)
-				:time(_time), numAllocs(_numAllocs), numFrees(_numFrees)
-			{ }
-
-			double time;
-			UINT64 numAllocs;
-			UINT64 numFrees;
-		};
-
-		/**
-		 * Contains data about a single precise profiler sample (counting CPU cycles).
-		 *
-		 * @note	
-		 * A sample is created whenever a named profile block is entered. For example if you have a function you are
-		 * profiling, and it gets called 10 times, there will be 10 samples.
-		 */
-		struct PreciseProfileSample
-		{
-			PreciseProfileSample(UINT64 _cycles, UINT64 _numAllocs, UINT64 _numFrees)
-				:cycles(_cycles), numAllocs(_numAllocs), numFrees(_numFrees)
-			{ }
 
 			UINT64 cycles;
-			UINT64 numAllocs;
-			UINT64 numFrees;
+		private:
+			UINT64 startCycles;
 		};
 
-		/**	Contains basic (time based) profiling data contained in a profiling block. */
-		struct ProfileData
+		/**	Types of events recorded by the profiler. */
+		enum class EventType : UINT32
 		{
-			ProfileData(FrameAlloc* alloc);
-
-			/** Begins a new sample and records current sample state. Previous sample must not be active. */
-			void beginSample();
-
-			/**
-			 * Records current sample state and creates a new sample based on start and end state. Adds the sample to the 
-			 * sample list.
-			 */
-			void endSample();
-
-			/**
-			 * Removes the last added sample from the sample list and makes it active again. You must call endSample() 
-			 * when done as if you called beginSample().
-			 */
-			void resumeLastSample();
-
-			Vector<ProfileSample, StdFrameAlloc<ProfileSample>> samples;
-			Timer timer;
-
-			UINT64 memAllocs;
-			UINT64 memFrees;
+			ThreadBegin, /**< Profiling of the thread started. Sample ID contains the thread name. */
+			ThreadEnd, /**< Profiling of the thread ended. */
+			BeginSample, /**< Basic (time based) sample started. */
+			EndSample, /**< Basic (time based) sample ended. */
+			BeginSamplePrecise, /**< Precise (CPU cycle based) sample started. */
+			EndSamplePrecise /**< Precise (CPU cycle based) sample ended. */
 		};
 
-		/**	Contains precise (CPU cycle based) profiling data contained in a profiling block. */
-		struct PreciseProfileData
+		/** Single event recorded by a profiled thread. */
+		struct Event
 		{
-			PreciseProfileData(FrameAlloc* alloc);
-
-			/** Begins a new sample and records current sample state. Previous sample must not be active. */
-			void beginSample();
-
-			/**
-			 * Records current sample state and creates a new sample based on start and end state. Adds the sample to the 
-			 * sample list.
-			 */
-			void endSample();
-
-			/**
-			 * Removes the last added sample from the sample list and makes it active again. You must call endSample() 
-			 * when done as if you called beginSample.
-			 */
-			void resumeLastSample();
-
-			Vector<PreciseProfileSample, StdFrameAlloc<ProfileSample>> samples;
-			TimerPrecise timer;
-
-			UINT64 memAllocs;
-			UINT64 memFrees;
+			UINT64 time; /**< Time at which the event was recorded, in nanoseconds. */
+			UINT64 cycles; /**< Value of the CPU cycle counter. Only recorded by precise samples. */
+			UINT64 numAllocs; /**< Number of memory allocations at the time of the event. */
+			UINT64 numFrees; /**< Number of memory deallocations at the time of the event. */
+			SampleId sampleId;
+			EventType type;
 		};
 
 		/**
-		 * Contains all sampling information about a single named profiling block. Each block has its own sampling 
-		 * information and optionally child blocks.
+		 * Contains all sampling information about a single named profiling block. Blocks are created from recorded 
+		 * events when a report is generated. Each block has its own sampling information and optionally child blocks.
 		 */
 		struct ProfiledBlock
 		{
-			ProfiledBlock(FrameAlloc* alloc);
-			~ProfiledBlock();
+			ProfiledBlock(SampleId sampleId);
 
-			/**	Attempts to find a child block with the specified name. Returns null if not found. */
-			ProfiledBlock* findChild(const char* name) const;
+			/**	Attempts to find a child block with the specified sample ID. Returns -1 if not found. */
+			UINT32 findChild(const ProfilerVector<ProfiledBlock>& blocks, SampleId sampleId) const;
 
-			char* name;
-			
-			ProfileData basic;
-			PreciseProfileData precise;
+			SampleId sampleId;
 
-			Vector<ProfiledBlock*, StdFrameAlloc<ProfiledBlock*>> children;
-		};
+			UINT32 numCalls;
+			double totalTimeMs;
+			double maxTimeMs;
+			UINT64 memAllocs;
+			UINT64 memFrees;
 
-		/**	CPU sampling type. */
-		enum class ActiveSamplingType
-		{
-			Basic, /**< Sample using milliseconds. */
-			Precise /**< Sample using CPU cycles. */
+			UINT32 numPreciseCalls;
+			UINT64 totalCycles;
+			UINT64 maxCycles;
+			UINT64 preciseMemAllocs;
+			UINT64 preciseMemFrees;
+
+			ProfilerVector<UINT32> children;
 		};
 
-		/**	Contains data about the currently active profiling block. */
-		struct ActiveBlock
+		/** Sample name as cached by a profiled thread. */
+		struct CachedSampleName
 		{
-			ActiveBlock()
-				:type(ActiveSamplingType::Basic), block(nullptr)
-			{ }
-
-			ActiveBlock(ActiveSamplingType _type, ProfiledBlock* _block)
-				:type(_type), block(_block)
-			{ }
-
-			ActiveSamplingType type;
-			ProfiledBlock* block;
+			SampleId id;
+			const char* name;
 		};
 
-		/** Contains data about an active profiling thread. */
+		/** Contains data about a profiled thread. */
 		struct ThreadInfo
 		{
-			ThreadInfo();
+			ThreadInfo(UINT32 id);
+			~ThreadInfo();
 
-			/**
-			 * Starts profiling on the thread. New primary profiling block is created with the given name.
-			 */
-			void begin(const char* _name);
+			/** Records a new event into the thread's event buffer. Must only be called from the owning thread. */
+			void record(EventType type, SampleId sampleId);
 
 			/**
-			 * Ends profiling on the thread. You should end all samples before calling this, but if you don't they will be 
-			 * terminated automatically.
+			 * Moves all events from the event buffer into the pending event list if the thread generates reports, and
+			 * into the trace event list if @p captureTrace is true. Events are discarded otherwise. Caller must hold 
+			 * the consumer mutex.
 			 */
-			void end();
+			void drain(bool captureTrace);
 
 			/**
-			 * 	Deletes all internal profiling data and makes the object ready for another iteration. Should be called 
-			 * after end in order to delete any existing data.
+			 * Moves pending events recorded before the provided event buffer position into @p output. Caller must hold
+			 * the consumer mutex, and should drain the event buffer first.
 			 */
-			void reset();
+			void takePending(UINT32 end, ProfilerVector<Event>& output);
 
-			/**	Gets the primary profiling block used by the thread. */
-			ProfiledBlock* getBlock(const char* name);
-			
-			/** Deletes the provided block. */
-			void releaseBlock(ProfiledBlock* block);
+			/** 
+			 * Returns an ID of a sample with the provided name, using a per-thread cache to avoid the global name 
+			 * lookup. Must only be called from the owning thread.
+			 */
+			SampleId getSampleId(const char* name);
 
+			static const UINT32 EVENT_BUFFER_SIZE;
 			static BS_THREADLOCAL ThreadInfo* activeThread;
+
+			UINT32 id;
+			SampleId nameId;
 			bool isActive;
+			bool isReporting;
+			UINT32 pendingStart;
+
+			Event* events;
+			std::atomic<UINT32> writePos;
+			std::atomic<UINT32> readPos;
+			std::atomic<UINT32> numDropped;
 
-			ProfiledBlock* rootBlock;
+			Mutex consumerMutex;
+			ProfilerVector<Event> pendingEvents;
+			ProfilerVector<Event> traceEvents;
 
-			FrameAlloc frameAlloc;
-			ActiveBlock activeBlock;
-			Stack<ActiveBlock, StdFrameAlloc<ActiveBlock>>* activeBlocks;
+			UnorderedMap<const char*, CachedSampleName, HashType<const char*>, std::equal_to<const char*>,
+				StdAlloc<std::pair<const char* const, CachedSampleName>, ProfilerAlloc>> nameCache;
 		};
 
 	public:
 		ProfilerCPU();
 		~ProfilerCPU();
 
+		/**
+		 * Returns a unique identifier for a sample with the provided name. Calling this method with the same name always
+		 * returns the same identifier. Identifiers remain valid for the lifetime of the application, and should be
+		 * retrieved once and then re-used (e.g. by using PROFILE_SAMPLE_ID), as sampling with an identifier avoids any
+		 * name lookups.
+		 */
+		static SampleId getSampleId(const char* name);
+
+		/** Returns the name of a sample with the provided identifier. */
+		static const char* getSampleName(SampleId id);
+
 		/**
 		 * Registers a new thread we will be doing sampling in. This needs to be called before any beginSample* \ endSample* 
 		 * calls are made in that thread.
@@ -260,6 +218,9 @@ namespace bs
 		 */
 		void beginSample(const char* name);
 
+		/** @copydoc beginSample(const char*) */
+		void beginSample(SampleId id);
+
 		/**
 		 * Ends sample measurement.
 		 *
@@ -271,6 +232,9 @@ namespace bs
 		 */
 		void endSample(const char* name);
 
+		/** @copydoc endSample(const char*) */
+		void endSample(SampleId id);
+
 		/**
 		 * Begins precise sample measurement. Must be followed by endSamplePrecise(). 
 		 *
@@ -283,6 +247,9 @@ namespace bs
 		 */
 		void beginSamplePrecise(const char* name);
 
+		/** @copydoc beginSamplePrecise(const char*) */
+		void beginSamplePrecise(SampleId id);
+
 		/**
 		 * Ends precise sample measurement.
 		 *
@@ -294,6 +261,9 @@ namespace bs
 		 */
 		void endSamplePrecise(const char* name);
 
+		/** @copydoc endSamplePrecise(const char*) */
+		void endSamplePrecise(SampleId id);
+
 		/** Clears all sampling data, and ends any unfinished sampling blocks. */
 		void reset();
 
@@ -305,7 +275,77 @@ namespace bs
 		 */
 		CPUProfilerReport generateReport();
 
+		/**
+		 * Same as generateReport(), except only the end of the sampled data is marked on the calling thread, while
+		 * collecting the data and building the report from it is done on a worker thread. This keeps the cost of
+		 * report generation out of the profiled thread. If the task scheduler isn't running the report is generated
+		 * immediately instead.
+		 *
+		 * @param[in]	onComplete	Callback to trigger with the generated report. Triggered on the thread that
+		 *							generated the report.
+		 * @return					Task generating the report, or null if the report was generated immediately.
+		 *
+		 * @note
+		 * Reports for the same thread should be generated in order, so wait on the previous task before requesting a
+		 * new report. Calling reset() before the task completes discards the data it was going to report.
+		 */
+		SPtr<Task> generateReportAsync(const std::function<void(CPUProfilerReport&)>& onComplete);
+
+		/**
+		 * Starts capturing events from all profiled threads, for later export with saveTrace(). Any previously captured
+		 * events are discarded.
+		 */
+		void beginTraceCapture();
+
+		/** Stops capturing events started with beginTraceCapture(). Events captured so far are kept. */
+		void endTraceCapture();
+
+		/** Checks is event capture started with beginTraceCapture() currently active. */
+		bool isCapturingTrace() const { return mCaptureTrace; }
+
+		/**
+		 * Saves all events captured since the last call to beginTraceCapture() in the Chrome trace event format (as
+		 * viewable in chrome://tracing). Each profiled thread is displayed as a separate track on the same timeline.
+		 *
+		 * @param[in]	path	Path to the file to save the trace to. Existing file will be overwritten.
+		 */
+		void saveTrace(const Path& path);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Moves events recorded by all threads into the trace capture, if capture is active. Should be called regularly
+		 * (e.g. once per frame) so that event buffers of threads that never generate reports don't overflow.
+		 */
+		void _collectTrace();
+
+		/** @} */
+
 	private:
+		/** Returns the profiling information about the calling thread, registering the thread if required. */
+		ThreadInfo* getThread();
+
+		/** Records a sample begin or end event on the calling thread. */
+		void record(EventType type, SampleId id);
+
+		/**
+		 * Ends sampling on the provided thread if still active, and enables reporting for it. Returns the event buffer
+		 * position marking the end of all events sampled so far. Must be called from the thread the events belong to.
+		 */
+		UINT32 captureEvents(ThreadInfo* thread);
+
+		/**
+		 * Aggregates events captured from a profiled thread into a hierarchy of profiling blocks and returns a report
+		 * containing them. Can be called from any thread.
+		 *
+		 * @param[in]	threadNameId	Sample ID containing the name of the thread the events were captured from.
+		 * @param[in]	events			Events captured from the thread, in the order they were recorded.
+		 * @return						Report containing the aggregated sampling data.
+		 */
+		CPUProfilerReport buildReport(SampleId threadNameId, const ProfilerVector<Event>& events) const;
+
 		/**
 		 * Calculates overhead that the timing and sampling methods themselves introduce so we might get more accurate 
 		 * measurements when creating reports.
@@ -323,6 +363,7 @@ namespace bs
 
 		ProfilerVector<ThreadInfo*> mActiveThreads;
 		Mutex mThreadSync;
+		std::atomic<bool> mCaptureTrace;
 	};
 
 	/** Profiling entry containing information about a single CPU profiling block containing timing information. */
@@ -414,11 +455,22 @@ namespace bs
 	/** Provides global access to ProfilerCPU instance. */
 	BS_CORE_EXPORT ProfilerCPU& gProfilerCPU();
 
+	/** 
+	 * Returns a ProfilerCPU::SampleId for a sample with the provided name. The ID is looked up only the first time the
+	 * call site is executed. Name must be a string literal.
+	 */
+#define PROFILE_SAMPLE_ID(name)														\
+	([]()																			\
+	{																				\
+		static const bs::ProfilerCPU::SampleId sampleId = bs::ProfilerCPU::getSampleId(name);	\
+		return sampleId;															\
+	}())
+
 	/** Shortcut for profiling a single function call. */
 #define PROFILE_CALL(call, name)							\
-	bs::gProfilerCPU().beginSample(name);		\
+	bs::gProfilerCPU().beginSample(PROFILE_SAMPLE_ID(name));		\
 	call;													\
-	bs::gProfilerCPU().endSample(name);
+	bs::gProfilerCPU().endSample(PROFILE_SAMPLE_ID(name));
 
 	/** @} */
 }
\ No newline at end of file
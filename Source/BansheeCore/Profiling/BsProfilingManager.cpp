@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Profiling/BsProfilingManager.h"
 #include "Math/BsMath.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -27,23 +28,38 @@ namespace bs
 	void ProfilingManager::_update()
 	{
 #if BS_PROFILING_ENABLED
-		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		// Reports are built on a worker. Make sure the previous one is done so they are always saved in order.
+		if(mSimReportTask != nullptr)
+			mSimReportTask->wait();
 
-		gProfilerCPU().reset();
+		auto saveReport = [this](CPUProfilerReport& report)
+		{
+			Lock lock(mSync);
+			mSavedSimReports[mNextSimReportIdx].cpuReport = std::move(report);
+
+			mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
+		};
 
-		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
+		mSimReportTask = gProfilerCPU().generateReportAsync(saveReport);
+		gProfilerCPU()._collectTrace();
 #endif
 	}
 
 	void ProfilingManager::_updateCore()
 	{
 #if BS_PROFILING_ENABLED
-		Lock lock(mSync);
-		mSavedCoreReports[mNextCoreReportIdx].cpuReport = gProfilerCPU().generateReport();
+		if(mCoreReportTask != nullptr)
+			mCoreReportTask->wait();
+
+		auto saveReport = [this](CPUProfilerReport& report)
+		{
+			Lock lock(mSync);
+			mSavedCoreReports[mNextCoreReportIdx].cpuReport = std::move(report);
 
-		gProfilerCPU().reset();
+			mNextCoreReportIdx = (mNextCoreReportIdx + 1) % NUM_SAVED_FRAMES;
+		};
 
-		mNextCoreReportIdx = (mNextCoreReportIdx + 1) % NUM_SAVED_FRAMES;
+		mCoreReportTask = gProfilerCPU().generateReportAsync(saveReport);
 #endif
 	}
 
@@ -51,10 +67,9 @@ namespace bs
 	{
 		idx = Math::clamp(idx, 0U, (UINT32)(NUM_SAVED_FRAMES - 1));
 
+		Lock lock(mSync);
 		if(thread == ProfiledThread::Core)
 		{
-			Lock lock(mSync);
-
 			UINT32 reportIdx = mNextCoreReportIdx + (UINT32)((INT32)NUM_SAVED_FRAMES - ((INT32)idx + 1));
 			reportIdx = (reportIdx) % NUM_SAVED_FRAMES;
 
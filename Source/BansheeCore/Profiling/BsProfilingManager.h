@@ -56,7 +56,7 @@ namespace bs
 		 *
 		 * @note	
 		 * Profiler reports get updated every frame. Oldest reports that no longer fit in the saved reports buffer are 
-		 * discarded.
+		 * discarded. Reports are built on a worker thread so the latest report can lag behind by a frame.
 		 */
 		const ProfilerReport& getReport(ProfiledThread thread, UINT32 idx = 0) const;
 
@@ -68,6 +68,9 @@ namespace bs
 		ProfilerReport* mSavedCoreReports;
 		UINT32 mNextCoreReportIdx;
 
+		SPtr<Task> mSimReportTask;
+		SPtr<Task> mCoreReportTask;
+
 		mutable Mutex mSync;
 	};
 
@@ -17,6 +17,9 @@ namespace bs
 	{
 		enum { id = TID_KeyFrame }; enum { hasDynamicSize = 0 };
 
+		// Members are written in declaration order with no padding in between, matching the in-memory layout
+		enum { allowMemcpy = sizeof(TKeyframe<T>) == sizeof(T) * 3 + sizeof(float) };
+
 		/** @copydoc RTTIPlainType::toMemory */
 		static void toMemory(const TKeyframe<T>& data, char* memory)
 		{
@@ -0,0 +1,75 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedAnimationKey)
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedAnimationCurveInfo)
+
+	template<> struct RTTIPlainType<CompressedAnimationCurves>
+	{
+		enum { id = TID_CompressedAnimationCurves }; enum { hasDynamicSize = 1 };
+
+		/** @copydoc RTTIPlainType::toMemory */
+		static void toMemory(const CompressedAnimationCurves& data, char* memory)
+		{
+			UINT32 size = sizeof(UINT32);
+			char* memoryStart = memory;
+			memory += sizeof(UINT32);
+
+			UINT32 version = 1; // In case the data structure changes
+			memory = rttiWriteElem(version, memory, size);
+			memory = rttiWriteElem(data.mPositionInfos, memory, size);
+			memory = rttiWriteElem(data.mRotationInfos, memory, size);
+			memory = rttiWriteElem(data.mScaleInfos, memory, size);
+			memory = rttiWriteElem(data.mKeys, memory, size);
+
+			memcpy(memoryStart, &size, sizeof(UINT32));
+		}
+
+		/** @copydoc RTTIPlainType::fromMemory */
+		static UINT32 fromMemory(CompressedAnimationCurves& data, char* memory)
+		{
+			UINT32 size = 0;
+			memory = rttiReadElem(size, memory);
+
+			UINT32 version;
+			memory = rttiReadElem(version, memory);
+			assert(version == 1);
+
+			memory = rttiReadElem(data.mPositionInfos, memory);
+			memory = rttiReadElem(data.mRotationInfos, memory);
+			memory = rttiReadElem(data.mScaleInfos, memory);
+			memory = rttiReadElem(data.mKeys, memory);
+
+			return size;
+		}
+
+		/** @copydoc RTTIPlainType::getDynamicSize */
+		static UINT32 getDynamicSize(const CompressedAnimationCurves& data)
+		{
+			UINT64 dataSize = sizeof(UINT32) + sizeof(UINT32);
+			dataSize += rttiGetElemSize(data.mPositionInfos);
+			dataSize += rttiGetElemSize(data.mRotationInfos);
+			dataSize += rttiGetElemSize(data.mScaleInfos);
+			dataSize += rttiGetElemSize(data.mKeys);
+
+			assert(dataSize <= std::numeric_limits<UINT32>::max());
+
+			return (UINT32)dataSize;
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
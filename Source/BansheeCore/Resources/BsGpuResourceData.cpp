@@ -4,6 +4,7 @@
 #include "RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -18,6 +19,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedStream = copy.mMappedStream;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -30,6 +32,7 @@ namespace bs
 		mData = rhs.mData;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedStream = rhs.mMappedStream;
 
 		return *this;
 	}
@@ -70,6 +73,14 @@ namespace bs
 
 	void GpuResourceData::freeInternalBuffer()
 	{
+		// Data points into the mapping, which may be unmapped once the stream is released
+		if(mMappedStream != nullptr)
+		{
+			mMappedStream = nullptr;
+			mData = nullptr;
+			return;
+		}
+
 		if(mData == nullptr || !mOwnsData)
 			return;
 
@@ -101,6 +112,28 @@ namespace bs
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::readInternalBuffer(const SPtr<DataStream>& stream, UINT32 size)
+	{
+		if(stream->isMemoryMapped())
+		{
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+			UINT8* mappedData = memStream->getCurrentPtr();
+
+			// Unaligned data would break code that accesses the buffer as an array of 32-bit values
+			if(((uintptr_t)mappedData & (sizeof(UINT32) - 1)) == 0 && (stream->tell() + size) <= stream->size())
+			{
+				setExternalBuffer(mappedData);
+				mMappedStream = stream;
+
+				stream->skip(size);
+				return;
+			}
+		}
+
+		allocateInternalBuffer(size);
+		stream->read(mData, size);
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
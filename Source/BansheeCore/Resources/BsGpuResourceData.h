@@ -52,7 +52,8 @@ namespace bs
 		void allocateInternalBuffer(UINT32 size);
 
 		/**
-		 * Frees the internal buffer that was allocated using allocateInternalBuffer(). Called automatically when the 
+		 * Frees the internal buffer that was allocated using allocateInternalBuffer(). If the buffer references a memory
+		 * mapped file, the reference is released and the data pointer is cleared instead. Called automatically when the
 		 * instance of the class is destroyed.
 		 */
 		void freeInternalBuffer();
@@ -66,6 +67,20 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Reads the internal buffer from the current position of the provided stream, and advances the stream by @p size
+		 * bytes. If the stream is a memory mapped file the internal data pointer is made to point to the mapped memory
+		 * instead of copying the data, and the stream is kept alive for as long as it is referenced. This requires the data
+		 * to be aligned, which is the case for data blocks written by BinarySerializer. Data from files saved before data
+		 * blocks were aligned may be misaligned, in which case it is copied.
+		 *
+		 * @param[in]	stream	Stream to read the data from.
+		 * @param[in]	size	Size of the data to read, in bytes.
+		 *
+		 * @note	If any internal data is allocated, it is freed.
+		 */
+		void readInternalBuffer(const SPtr<DataStream>& stream, UINT32 size);
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -86,6 +101,7 @@ namespace bs
 		UINT8* mData;
 		bool mOwnsData;
 		mutable bool mLocked;
+		SPtr<DataStream> mMappedStream;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -28,7 +28,11 @@ namespace bs
 		/**	Retrieves meta-data containing various information describing a resource. */
 		SPtr<ResourceMetaData> getMetaData() const { return mMetaData; }
 
-		/**	Returns whether or not this resource is allowed to be asynchronously loaded. */
+		/**
+		 * Returns whether or not this resource is allowed to be asynchronously loaded. Only respected for resources
+		 * loaded from a resource archive, whose index stores the flag. Standalone files are only read once the load
+		 * reaches an I/O thread, so an asynchronous load of a standalone file is always decoded on a worker thread.
+		 */
 		virtual bool allowAsyncLoading() const { return true; }
 
 	protected:
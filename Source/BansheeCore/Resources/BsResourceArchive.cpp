@@ -0,0 +1,436 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Resources/BsResourceArchive.h"
+#include "Resources/BsSavedResourceData.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Utility/BsCompression.h"
+#include "Utility/BsBitwise.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/*
+	 * Archive layout:
+	 *  - Header
+	 *  - Resource data, each entry starting at an aligned offset. Same layout as a standalone resource file.
+	 *  - Index, starting at Header::indexOffset:
+	 *		- EntryRecord for each resource, sorted by UUID
+	 *		- StringRecord for each dependency, referenced by EntryRecord::firstDependency/numDependencies
+	 *		- String table, referenced by EntryRecord::uuid and StringRecord
+	 */
+
+	static const UINT32 ARCHIVE_MAGIC = 0x41525342; // "BSRA"
+	static const UINT32 ARCHIVE_VERSION = 1;
+
+	/** Flag set in EntryRecord::flags if the resource is allowed to be loaded asynchronously. */
+	static const UINT32 ENTRY_FLAG_ALLOW_ASYNC = 1 << 0;
+
+	/** Header at the start of the archive file. */
+	struct ArchiveHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 numEntries;
+		UINT32 numDependencies;
+		UINT64 indexOffset;
+		UINT64 indexSize;
+	};
+
+	/** Reference to a string in the index string table. */
+	struct StringRecord
+	{
+		UINT32 offset;
+		UINT32 length;
+	};
+
+	/** Information about a single resource, as stored in the archive index. */
+	struct EntryRecord
+	{
+		UINT64 offset;
+		UINT64 size;
+		StringRecord uuid;
+		UINT32 firstDependency;
+		UINT32 numDependencies;
+		UINT32 flags;
+		UINT32 padding;
+	};
+
+	static_assert(sizeof(ArchiveHeader) == 32, "Archive header layout must not change.");
+	static_assert(sizeof(EntryRecord) == 40, "Archive entry layout must not change.");
+
+	/** Returns the string referenced by @p record, or false if the reference is outside of the string table. */
+	static bool readString(const StringRecord& record, const char* strings, UINT64 stringsSize, String& output)
+	{
+		if ((UINT64)record.offset + record.length > stringsSize)
+			return false;
+
+		output.assign(strings + record.offset, record.length);
+		return true;
+	}
+
+	ResourceArchive::ResourceArchive(const ConstructPrivately& dummy, const Path& path,
+		const SPtr<MappedFileDataStream>& stream)
+		:mPath(path), mStream(stream)
+	{ }
+
+	const ResourceArchive::Entry* ResourceArchive::findEntry(const String& uuid) const
+	{
+		auto iterFind = std::lower_bound(mEntries.begin(), mEntries.end(), uuid,
+			[](const Entry& entry, const String& value) { return entry.uuid < value; });
+
+		if (iterFind == mEntries.end() || iterFind->uuid != uuid)
+			return nullptr;
+
+		return &*iterFind;
+	}
+
+	Vector<String> ResourceArchive::getDependencies(const Entry& entry) const
+	{
+		auto start = mDependencies.begin() + entry.firstDependency;
+		return Vector<String>(start, start + entry.numDependencies);
+	}
+
+	SPtr<DataStream> ResourceArchive::readEntry(const Entry& entry, bool memoryMap) const
+	{
+		if (memoryMap)
+			return bs_shared_ptr_new<MappedFileDataStream>(mStream, (size_t)entry.offset, (size_t)entry.size);
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>((size_t)entry.size);
+		memcpy(stream->getPtr(), mStream->getPtr() + entry.offset, (size_t)entry.size);
+
+		return stream;
+	}
+
+	SPtr<ResourceArchive> ResourceArchive::open(const Path& path)
+	{
+		SPtr<DataStream> fileStream = FileSystem::openMappedFile(path);
+		if (fileStream == nullptr)
+			return nullptr;
+
+		SPtr<MappedFileDataStream> stream = std::static_pointer_cast<MappedFileDataStream>(fileStream);
+		const UINT8* data = stream->getPtr();
+		UINT64 fileSize = stream->size();
+
+		ArchiveHeader header;
+		if (fileSize >= sizeof(header))
+			memcpy(&header, data, sizeof(header));
+
+		if (fileSize < sizeof(header) || header.magic != ARCHIVE_MAGIC || header.version != ARCHIVE_VERSION)
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\". File is not a valid resource archive.");
+			return nullptr;
+		}
+
+		UINT64 recordsSize = header.numEntries * (UINT64)sizeof(EntryRecord) +
+			header.numDependencies * (UINT64)sizeof(StringRecord);
+
+		if (header.indexOffset > fileSize || header.indexSize > fileSize - header.indexOffset ||
+			recordsSize > header.indexSize)
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\". Archive index is corrupt.");
+			return nullptr;
+		}
+
+		const UINT8* entryRecords = data + header.indexOffset;
+		const UINT8* dependencyRecords = entryRecords + header.numEntries * sizeof(EntryRecord);
+		const char* strings = (const char*)(entryRecords + recordsSize);
+		UINT64 stringsSize = header.indexSize - recordsSize;
+
+		SPtr<ResourceArchive> archive = bs_shared_ptr_new<ResourceArchive>(ConstructPrivately(), path, stream);
+
+		archive->mDependencies.resize(header.numDependencies);
+		for (UINT32 i = 0; i < header.numDependencies; i++)
+		{
+			StringRecord record;
+			memcpy(&record, dependencyRecords + i * sizeof(StringRecord), sizeof(record));
+
+			if (!readString(record, strings, stringsSize, archive->mDependencies[i]))
+			{
+				LOGERR("Unable to open resource archive \"" + path.toString() + "\". Archive index is corrupt.");
+				return nullptr;
+			}
+		}
+
+		archive->mEntries.resize(header.numEntries);
+		for (UINT32 i = 0; i < header.numEntries; i++)
+		{
+			EntryRecord record;
+			memcpy(&record, entryRecords + i * sizeof(EntryRecord), sizeof(record));
+
+			Entry& entry = archive->mEntries[i];
+			entry.offset = record.offset;
+			entry.size = record.size;
+			entry.firstDependency = record.firstDependency;
+			entry.numDependencies = record.numDependencies;
+			entry.allowAsync = (record.flags & ENTRY_FLAG_ALLOW_ASYNC) != 0;
+
+			bool isValid = readString(record.uuid, strings, stringsSize, entry.uuid);
+			isValid &= record.offset <= header.indexOffset && record.size <= header.indexOffset - record.offset;
+			isValid &= (UINT64)record.firstDependency + record.numDependencies <= header.numDependencies;
+
+			if (!isValid)
+			{
+				LOGERR("Unable to open resource archive \"" + path.toString() + "\". Archive index is corrupt.");
+				return nullptr;
+			}
+		}
+
+		auto compareUUID = [](const Entry& a, const Entry& b) { return a.uuid < b.uuid; };
+		if (!std::is_sorted(archive->mEntries.begin(), archive->mEntries.end(), compareUUID))
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\". Archive index is not sorted.");
+			return nullptr;
+		}
+
+		return archive;
+	}
+
+	ResourceArchiveBuilder::ResourceArchiveBuilder(UINT32 alignment)
+		:mAlignment(alignment)
+	{
+		if (mAlignment == 0 || !Bitwise::isPow2(mAlignment))
+		{
+			LOGWRN("Resource archive alignment must be a power of two. Rounding " + toString(mAlignment) + " up.");
+			mAlignment = Bitwise::nextPow2(std::max(mAlignment, 1U));
+		}
+
+		// Entries are copied as is, so their data blocks only remain aligned if the entries are at least as aligned
+		mAlignment = std::max(mAlignment, (UINT32)BinarySerializer::DATA_BLOCK_ALIGNMENT);
+	}
+
+	void ResourceArchiveBuilder::addFile(const String& uuid, const Path& filePath, bool compress)
+	{
+		mFiles.push_back({ uuid, filePath, compress });
+	}
+
+	bool ResourceArchiveBuilder::build(const Path& outputPath)
+	{
+		/** Information about a resource written to the archive. */
+		struct WrittenEntry
+		{
+			String uuid;
+			UINT64 offset;
+			UINT64 size;
+			Vector<String> dependencies;
+			bool allowAsync;
+		};
+
+		Vector<WrittenEntry> writtenEntries;
+		writtenEntries.reserve(mFiles.size());
+
+		// Check for duplicates before doing any work
+		{
+			UnorderedSet<String> uuids;
+			for (auto& file : mFiles)
+			{
+				if (!uuids.insert(file.uuid).second)
+				{
+					LOGERR("Unable to build resource archive \"" + outputPath.toString() + "\". Resource with UUID \"" +
+						file.uuid + "\" was added more than once.");
+					return false;
+				}
+			}
+		}
+
+		Path parentDir = outputPath.getDirectory();
+		if (!FileSystem::exists(parentDir))
+			FileSystem::createDir(parentDir);
+
+		// Write to a temporary file first, so a failed build doesn't leave a truncated archive at the output path
+		Path tempPath = outputPath;
+		tempPath.setFilename(outputPath.getWFilename() + L".tmp");
+
+		std::ofstream stream;
+		stream.open(tempPath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+		if (stream.fail())
+		{
+			LOGERR("Unable to build resource archive \"" + outputPath.toString() + "\". Error: " +
+				strerror(errno) + ".");
+			return false;
+		}
+
+		auto discardOutput = [&]()
+		{
+			stream.close();
+			FileSystem::remove(tempPath);
+		};
+
+		// Header is written once the index location is known
+		ArchiveHeader header;
+		memset(&header, 0, sizeof(header));
+		stream.write((char*)&header, sizeof(header));
+
+		UINT64 offset = sizeof(header);
+		static const UINT8 PADDING[256] = { 0 };
+
+		auto writePadding = [&](UINT64 alignment)
+		{
+			UINT64 alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+			while (offset < alignedOffset)
+			{
+				UINT64 padding = std::min(alignedOffset - offset, (UINT64)sizeof(PADDING));
+				stream.write((char*)PADDING, (std::streamsize)padding);
+				offset += padding;
+			}
+		};
+
+		for (auto& file : mFiles)
+		{
+			SPtr<DataStream> fileStream = FileSystem::openFile(file.filePath, true);
+			if (fileStream == nullptr)
+			{
+				LOGERR("Unable to build resource archive \"" + outputPath.toString() + "\". Cannot read resource "
+					"file: \"" + file.filePath.toString() + "\".");
+				discardOutput();
+				return false;
+			}
+
+			// Resource file layout: metadata size, metadata, object size, object data
+			SPtr<MemoryDataStream> fileData = bs_shared_ptr_new<MemoryDataStream>(fileStream);
+			fileStream->close();
+
+			UINT8* data = fileData->getPtr();
+			UINT64 dataSize = fileData->size();
+
+			UINT32 metaDataSize = 0;
+			if (dataSize >= sizeof(UINT32))
+				memcpy(&metaDataSize, data, sizeof(UINT32));
+
+			UINT64 objectStart = sizeof(UINT32) + (UINT64)metaDataSize;
+			SPtr<SavedResourceData> metaData;
+			if (objectStart + sizeof(UINT32) <= dataSize)
+			{
+				MemorySerializer ms;
+				SPtr<IReflectable> decoded = ms.decode(data + sizeof(UINT32), metaDataSize);
+
+				if (decoded != nullptr && decoded->getTypeId() == TID_ResourceDependencies)
+					metaData = std::static_pointer_cast<SavedResourceData>(decoded);
+			}
+
+			if (metaData == nullptr)
+			{
+				LOGERR("Unable to build resource archive \"" + outputPath.toString() + "\". File is not a valid resource "
+					"file: \"" + file.filePath.toString() + "\".");
+				discardOutput();
+				return false;
+			}
+
+			writePadding(mAlignment);
+
+			WrittenEntry entry;
+			entry.uuid = file.uuid;
+			entry.offset = offset;
+			entry.dependencies = metaData->getDependencies();
+			entry.allowAsync = metaData->allowAsyncLoading();
+
+			// Compress the object data, keeping the original if compression doesn't help
+			SPtr<MemoryDataStream> compressedData;
+			if (file.compress && metaData->getCompressionMethod() == 0)
+			{
+				UINT8* objectData = data + objectStart + sizeof(UINT32);
+				UINT64 objectSize = dataSize - objectStart - sizeof(UINT32);
+
+				SPtr<DataStream> objectStream =
+					bs_shared_ptr_new<MemoryDataStream>(objectData, (size_t)objectSize, false);
+				compressedData = Compression::compress(objectStream);
+
+				if (compressedData != nullptr && compressedData->size() >= objectSize)
+					compressedData = nullptr;
+			}
+
+			if (compressedData != nullptr)
+			{
+				SavedResourceData compressedMetaData(entry.dependencies, entry.allowAsync, 1);
+
+				MemorySerializer ms;
+				UINT32 numBytes = 0;
+				UINT8* bytes = ms.encode(&compressedMetaData, numBytes);
+
+				stream.write((char*)&numBytes, sizeof(numBytes));
+				stream.write((char*)bytes, numBytes);
+				bs_free(bytes);
+
+				// Object size remains the uncompressed size, same as in compressed resource files
+				stream.write((char*)data + objectStart, sizeof(UINT32));
+				stream.write((char*)compressedData->getPtr(), compressedData->size());
+
+				entry.size = sizeof(numBytes) + numBytes + sizeof(UINT32) + compressedData->size();
+			}
+			else
+			{
+				stream.write((char*)data, (std::streamsize)dataSize);
+				entry.size = dataSize;
+			}
+
+			offset += entry.size;
+			writtenEntries.push_back(std::move(entry));
+		}
+
+		// Build the index
+		std::sort(writtenEntries.begin(), writtenEntries.end(),
+			[](const WrittenEntry& a, const WrittenEntry& b) { return a.uuid < b.uuid; });
+
+		Vector<EntryRecord> entryRecords;
+		Vector<StringRecord> dependencyRecords;
+		String strings;
+
+		auto addString = [&](const String& value)
+		{
+			StringRecord record;
+			record.offset = (UINT32)strings.size();
+			record.length = (UINT32)value.size();
+
+			strings += value;
+			return record;
+		};
+
+		for (auto& entry : writtenEntries)
+		{
+			EntryRecord record;
+			memset(&record, 0, sizeof(record));
+			record.offset = entry.offset;
+			record.size = entry.size;
+			record.uuid = addString(entry.uuid);
+			record.firstDependency = (UINT32)dependencyRecords.size();
+			record.numDependencies = (UINT32)entry.dependencies.size();
+			record.flags = entry.allowAsync ? ENTRY_FLAG_ALLOW_ASYNC : 0;
+
+			for (auto& dependency : entry.dependencies)
+				dependencyRecords.push_back(addString(dependency));
+
+			entryRecords.push_back(record);
+		}
+
+		writePadding(sizeof(UINT64));
+
+		header.magic = ARCHIVE_MAGIC;
+		header.version = ARCHIVE_VERSION;
+		header.numEntries = (UINT32)entryRecords.size();
+		header.numDependencies = (UINT32)dependencyRecords.size();
+		header.indexOffset = offset;
+		header.indexSize = entryRecords.size() * sizeof(EntryRecord) + dependencyRecords.size() * sizeof(StringRecord) +
+			strings.size();
+
+		stream.write((char*)entryRecords.data(), entryRecords.size() * sizeof(EntryRecord));
+		stream.write((char*)dependencyRecords.data(), dependencyRecords.size() * sizeof(StringRecord));
+		stream.write(strings.data(), strings.size());
+
+		stream.seekp(0);
+		stream.write((char*)&header, sizeof(header));
+
+		if (stream.fail())
+		{
+			LOGERR("Unable to build resource archive \"" + outputPath.toString() + "\". Failed writing to the file.");
+			discardOutput();
+			return false;
+		}
+
+		stream.close();
+		FileSystem::move(tempPath, outputPath, true);
+
+		return true;
+	}
+}
@@ -0,0 +1,130 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Provides access to a resource archive, a single file packing together the contents of many resource files.
+	 * Resources in the archive are looked up by their UUID, and their dependencies are stored in the archive index so
+	 * they can be determined without reading the resources themselves.
+	 *
+	 * @note
+	 * The archive file is memory mapped for as long as the archive or any of the streams returned by readEntry() are
+	 * alive. The file must not be modified during that time.
+	 * @note
+	 * Archives are created using ResourceArchiveBuilder, and used for loading by registering them with
+	 * Resources::registerResourceArchive().
+	 * @note
+	 * Thread safe.
+	 */
+	class BS_CORE_EXPORT ResourceArchive
+	{
+		struct ConstructPrivately {};
+
+	public:
+		/** Information about a single resource stored in the archive. */
+		struct Entry
+		{
+			String uuid;
+			UINT64 offset; /**< Offset of the resource data from the start of the archive, in bytes. */
+			UINT64 size; /**< Size of the resource data, in bytes. */
+			UINT32 firstDependency; /**< Index of the first dependency of the resource in the dependency table. */
+			UINT32 numDependencies; /**< Number of dependencies of the resource. */
+			bool allowAsync; /**< True if the resource is allowed to be loaded asynchronously. */
+		};
+
+		ResourceArchive(const ConstructPrivately& dummy, const Path& path, const SPtr<MappedFileDataStream>& stream);
+
+		/** Returns the path of the archive file. */
+		const Path& getPath() const { return mPath; }
+
+		/** Returns the number of resources in the archive. */
+		UINT32 getNumEntries() const { return (UINT32)mEntries.size(); }
+
+		/** Returns information about a resource in the archive. Entries are sorted by their UUID. */
+		const Entry& getEntry(UINT32 idx) const { return mEntries[idx]; }
+
+		/** Attempts to find the resource with the provided UUID in the archive. Returns null if not found. */
+		const Entry* findEntry(const String& uuid) const;
+
+		/** Returns UUIDs of all the resources the provided resource depends on. */
+		Vector<String> getDependencies(const Entry& entry) const;
+
+		/**
+		 * Returns a stream containing the data of the provided resource. The data has the same layout as a resource file
+		 * saved by Resources::save().
+		 *
+		 * @param[in]	entry		Resource whose data to return.
+		 * @param[in]	memoryMap	If true the returned stream references the mapped archive memory directly, and
+		 *							its contents are read from the disk on demand as they are accessed. Otherwise
+		 *							the data is copied into a new buffer.
+		 */
+		SPtr<DataStream> readEntry(const Entry& entry, bool memoryMap) const;
+
+		/** Opens a previously built resource archive. Returns null if the archive cannot be opened or is invalid. */
+		static SPtr<ResourceArchive> open(const Path& path);
+
+	private:
+		Path mPath;
+		SPtr<MappedFileDataStream> mStream;
+		Vector<Entry> mEntries;
+		Vector<String> mDependencies;
+	};
+
+	/**
+	 * Packs resource files saved by Resources::save() into a single resource archive.
+	 *
+	 * @note
+	 * Resource data is stored in the order the resources were added in, so resources that are usually loaded together
+	 * should be added one after another. The archive index is sorted by UUID.
+	 */
+	class BS_CORE_EXPORT ResourceArchiveBuilder
+	{
+		/** Information about a resource to be added to the archive. */
+		struct FileEntry
+		{
+			String uuid;
+			Path filePath;
+			bool compress;
+		};
+
+	public:
+		/**
+		 * Constructs a new builder.
+		 *
+		 * @param[in]	alignment	Alignment of resource data in the archive, in bytes. Must be a power of two. Values
+		 *						smaller than BinarySerializer::DATA_BLOCK_ALIGNMENT are raised to it.
+		 */
+		ResourceArchiveBuilder(UINT32 alignment = 16);
+
+		/**
+		 * Queues a resource file to be added to the archive. The file isn't read until build() is called.
+		 *
+		 * @param[in]	uuid		UUID of the resource stored in the file.
+		 * @param[in]	filePath	Path to a resource file saved by Resources::save().
+		 * @param[in]	compress	If true the resource is compressed in the archive, unless it is already compressed or
+		 *							compression doesn't reduce its size.
+		 */
+		void addFile(const String& uuid, const Path& filePath, bool compress = false);
+
+		/**
+		 * Builds the archive from all the added files and writes it to the specified location, overwriting any existing
+		 * file. Returns false if the archive couldn't be built, in which case the reason is logged and any existing file
+		 * at the output location is left untouched.
+		 */
+		bool build(const Path& outputPath);
+
+	private:
+		UINT32 mAlignment;
+		Vector<FileEntry> mFiles;
+	};
+
+	/** @} */
+}
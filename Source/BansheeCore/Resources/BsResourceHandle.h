@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Reflection/BsIReflectable.h"
+#include <atomic>
 
 namespace bs
 {
@@ -20,7 +21,7 @@ namespace bs
 		SPtr<Resource> mPtr;
 		String mUUID;
 		bool mIsCreated;	
-		UINT32 mRefCount;
+		std::atomic<UINT32> mRefCount; /**< Atomic as handles get copied and released by resource loading threads. */
 	};
 
 	/**
@@ -151,9 +152,7 @@ namespace bs
 		{ 
 			if (mData)
 			{
-				mData->mRefCount--;
-
-				if (mData->mRefCount == 0)
+				if (--mData->mRefCount == 0)
 					destroy();
 			}
 		};
@@ -0,0 +1,403 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Resources/BsResourceLoader.h"
+#include "Threading/BsTaskScheduler.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/**
+	 * Maximum number of loads an I/O thread takes from the queue at once. Larger batches allow more reads to be sorted
+	 * by their location on the disk, but delay higher priority loads queued in the meantime.
+	 */
+	static const UINT32 MAX_BATCH_SIZE = 32;
+
+	ResourceLoader::ResourceLoader(UINT32 numIOThreads)
+		: mNumIOThreads(std::max(numIOThreads, 1U)), mStatsStartUs(0), mNumReading(0), mNumDecoding(0)
+		, mNumRequested(0), mNumCompleted(0), mNumCancelled(0), mNumFailed(0), mBytesRead(0), mReadTimeUs(0)
+		, mDecodeTimeUs(0)
+	{
+		mStatsStartUs = mTimer.getMicroseconds();
+	}
+
+	ResourceLoader::~ResourceLoader()
+	{
+		Vector<Request*> cancelled;
+		{
+			Lock lock(mMutex);
+			mShutdown = true;
+
+			for (auto& queue : mQueues)
+			{
+				cancelled.insert(cancelled.end(), queue.begin(), queue.end());
+				queue.clear();
+			}
+
+			mQueueCond.notify_all();
+		}
+
+		finishCancelled(cancelled);
+
+		for (auto& thread : mIOThreads)
+		{
+			thread->join();
+			bs_delete(thread);
+		}
+
+		// Decode callbacks reference the owner of the loader, so they must complete before it is destroyed
+		Lock lock(mMutex);
+		while (mNumDecoding.load() > 0)
+			mDecodeCompleteCond.wait(lock);
+	}
+
+	void ResourceLoader::queue(const String& name, const Path& filePath, UINT64 offset, UINT64 size, bool memoryMap,
+		ResourceLoadPriority priority, std::function<bool(const SPtr<DataStream>&)> decode,
+		std::function<void(const SPtr<DataStream>&)> onRead)
+	{
+		Request* request = bs_new<Request>();
+		request->name = name;
+		request->filePath = filePath;
+		request->filePathStr = filePath.toString();
+		request->offset = offset;
+		request->size = size;
+		request->memoryMap = memoryMap;
+		request->priority = priority;
+		request->archiveEntry = nullptr;
+		request->decode = std::move(decode);
+		request->onRead = std::move(onRead);
+
+		addRequest(request);
+	}
+
+	void ResourceLoader::queue(const String& name, const SPtr<ResourceArchive>& archive,
+		const ResourceArchive::Entry& entry, bool memoryMap, ResourceLoadPriority priority,
+		std::function<bool(const SPtr<DataStream>&)> decode)
+	{
+		Request* request = bs_new<Request>();
+		request->name = name;
+		request->filePath = archive->getPath();
+		request->filePathStr = request->filePath.toString();
+		request->offset = entry.offset;
+		request->size = entry.size;
+		request->memoryMap = memoryMap;
+		request->priority = priority;
+		request->archive = archive;
+		request->archiveEntry = &entry;
+		request->decode = std::move(decode);
+
+		addRequest(request);
+	}
+
+	bool ResourceLoader::prioritize(const String& name)
+	{
+		Lock lock(mMutex);
+
+		for (auto& queue : mQueues)
+		{
+			auto iterFind = std::find_if(queue.begin(), queue.end(), [&](Request* x) { return x->name == name; });
+			if (iterFind == queue.end())
+				continue;
+
+			Request* request = *iterFind;
+			request->priority = ResourceLoadPriority::Streaming;
+			queue.erase(iterFind);
+
+			mQueues[(UINT32)ResourceLoadPriority::Streaming].push_front(request);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool ResourceLoader::cancel(const String& name)
+	{
+		Request* request = nullptr;
+		{
+			Lock lock(mMutex);
+
+			for (auto& queue : mQueues)
+			{
+				auto iterFind = std::find_if(queue.begin(), queue.end(), [&](Request* x) { return x->name == name; });
+				if (iterFind != queue.end())
+				{
+					request = *iterFind;
+					queue.erase(iterFind);
+					break;
+				}
+			}
+		}
+
+		if (request == nullptr)
+			return false;
+
+		finishCancelled({ request });
+		return true;
+	}
+
+	UINT32 ResourceLoader::cancelAll(ResourceLoadPriority priority)
+	{
+		Vector<Request*> cancelled;
+		{
+			Lock lock(mMutex);
+
+			Deque<Request*>& queue = mQueues[(UINT32)priority];
+			cancelled.assign(queue.begin(), queue.end());
+			queue.clear();
+		}
+
+		finishCancelled(cancelled);
+		return (UINT32)cancelled.size();
+	}
+
+	ResourceLoadStats ResourceLoader::getStats() const
+	{
+		ResourceLoadStats stats;
+		stats.numRequested = mNumRequested.load(std::memory_order_relaxed);
+		stats.numCompleted = mNumCompleted.load(std::memory_order_relaxed);
+		stats.numFailed = mNumFailed.load(std::memory_order_relaxed);
+		stats.numCancelled = mNumCancelled.load(std::memory_order_relaxed);
+		stats.numReading = mNumReading.load(std::memory_order_relaxed);
+		stats.numDecoding = mNumDecoding.load(std::memory_order_relaxed);
+		stats.bytesRead = mBytesRead.load(std::memory_order_relaxed);
+		stats.readTimeUs = mReadTimeUs.load(std::memory_order_relaxed);
+		stats.decodeTimeUs = mDecodeTimeUs.load(std::memory_order_relaxed);
+		stats.elapsedTimeUs = mTimer.getMicroseconds() - mStatsStartUs.load(std::memory_order_relaxed);
+
+		{
+			Lock lock(mMutex);
+
+			for (auto& queue : mQueues)
+				stats.numQueued += (UINT32)queue.size();
+		}
+
+		return stats;
+	}
+
+	void ResourceLoader::resetStats()
+	{
+		// Loads still in flight remain counted as requested, so the progress never reports them as finished
+		UINT32 numInFlight;
+		{
+			Lock lock(mMutex);
+
+			numInFlight = mNumReading.load() + mNumDecoding.load();
+			for (auto& queue : mQueues)
+				numInFlight += (UINT32)queue.size();
+		}
+
+		mNumRequested.store(numInFlight, std::memory_order_relaxed);
+		mNumCompleted.store(0, std::memory_order_relaxed);
+		mNumFailed.store(0, std::memory_order_relaxed);
+		mNumCancelled.store(0, std::memory_order_relaxed);
+		mBytesRead.store(0, std::memory_order_relaxed);
+		mReadTimeUs.store(0, std::memory_order_relaxed);
+		mDecodeTimeUs.store(0, std::memory_order_relaxed);
+		mStatsStartUs.store(mTimer.getMicroseconds(), std::memory_order_relaxed);
+	}
+
+	void ResourceLoader::runIOThread()
+	{
+		Vector<Request*> batch;
+		batch.reserve(MAX_BATCH_SIZE);
+
+		while (true)
+		{
+			batch.clear();
+
+			{
+				Lock lock(mMutex);
+
+				Deque<Request*>* queue = nullptr;
+				while (true)
+				{
+					for (auto& entry : mQueues)
+					{
+						if (!entry.empty())
+						{
+							queue = &entry;
+							break;
+						}
+					}
+
+					if (queue != nullptr || mShutdown)
+						break;
+
+					mQueueCond.wait(lock);
+				}
+
+				if (mShutdown)
+					break;
+
+				UINT32 batchSize = std::min((UINT32)queue->size(), MAX_BATCH_SIZE);
+				batch.assign(queue->begin(), queue->begin() + batchSize);
+				queue->erase(queue->begin(), queue->begin() + batchSize);
+
+				mNumReading.fetch_add(batchSize);
+			}
+
+			// Read loads from the same file in the order they're laid out in, and keep the queue order otherwise
+			std::stable_sort(batch.begin(), batch.end(),
+				[](const Request* a, const Request* b)
+			{
+				if (a->filePathStr != b->filePathStr)
+					return a->filePathStr < b->filePathStr;
+
+				return a->offset < b->offset;
+			});
+
+			for (auto& request : batch)
+			{
+				UINT64 startUs = mTimer.getMicroseconds();
+				SPtr<DataStream> stream = read(*request);
+				mReadTimeUs.fetch_add(mTimer.getMicroseconds() - startUs, std::memory_order_relaxed);
+
+				if (stream != nullptr && request->onRead != nullptr)
+				{
+					size_t position = stream->tell();
+					request->onRead(stream);
+					stream->seek(position);
+				}
+
+				queueDecode(request, stream);
+			}
+		}
+	}
+
+	void ResourceLoader::addRequest(Request* request)
+	{
+		mNumRequested.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			Lock lock(mMutex);
+
+			// Loads can still be queued by callbacks of loads that were in progress when the shutdown started
+			if (mShutdown)
+			{
+				lock.unlock();
+
+				finishCancelled({ request });
+				return;
+			}
+
+			// Start the threads on first use, so applications that never load asynchronously don't pay for them
+			if (mIOThreads.empty())
+			{
+				for (UINT32 i = 0; i < mNumIOThreads; i++)
+					mIOThreads.push_back(bs_new<Thread>(std::bind(&ResourceLoader::runIOThread, this)));
+			}
+
+			mQueues[(UINT32)request->priority].push_back(request);
+		}
+
+		mQueueCond.notify_one();
+	}
+
+	SPtr<DataStream> ResourceLoader::read(const Request& request)
+	{
+		if (request.archive != nullptr)
+		{
+			// Copying from the mapped archive is what actually reads the data from the disk. Large entries are returned
+			// as a view instead, and read during decode.
+			bool memoryMap = request.memoryMap || request.size > MAX_BUFFERED_READ_SIZE;
+
+			mBytesRead.fetch_add(request.size, std::memory_order_relaxed);
+			return request.archive->readEntry(*request.archiveEntry, memoryMap);
+		}
+
+		if (request.memoryMap)
+		{
+			SPtr<DataStream> stream = FileSystem::openMappedFile(request.filePath);
+			if (stream == nullptr)
+				return nullptr;
+
+			// Pages are read on demand during decode, so only account for the requested range
+			UINT64 fileSize = stream->size();
+			UINT64 size = request.size != 0 ? request.size : fileSize - std::min(request.offset, fileSize);
+			mBytesRead.fetch_add(size, std::memory_order_relaxed);
+
+			stream->seek((size_t)request.offset);
+			return stream;
+		}
+
+		SPtr<DataStream> fileStream = FileSystem::openFile(request.filePath, true);
+		if (fileStream == nullptr)
+			return nullptr;
+
+		UINT64 fileSize = fileStream->size();
+		if (request.offset > fileSize || request.size > fileSize - request.offset)
+		{
+			LOGERR("Unable to read resource data at path \"" + request.filePathStr + "\". Requested range is outside "
+				"of the file.");
+			return nullptr;
+		}
+
+		UINT64 size = request.size != 0 ? request.size : fileSize - request.offset;
+
+		// Read large files as they're decoded rather than holding their entire contents in memory at once
+		if (size > MAX_BUFFERED_READ_SIZE)
+		{
+			mBytesRead.fetch_add(size, std::memory_order_relaxed);
+
+			fileStream->seek((size_t)request.offset);
+			return fileStream;
+		}
+
+		SPtr<MemoryDataStream> memStream = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+		fileStream->seek((size_t)request.offset);
+		size_t numRead = fileStream->read(memStream->getPtr(), (size_t)size);
+		fileStream->close();
+
+		if (numRead != size)
+		{
+			LOGERR("Unable to read resource data at path \"" + request.filePathStr + "\".");
+			return nullptr;
+		}
+
+		mBytesRead.fetch_add(size, std::memory_order_relaxed);
+		return memStream;
+	}
+
+	void ResourceLoader::queueDecode(Request* request, const SPtr<DataStream>& stream)
+	{
+		mNumDecoding.fetch_add(1);
+		mNumReading.fetch_sub(1);
+
+		TaskPriority taskPriority = TaskPriority::Normal;
+		if (request->priority == ResourceLoadPriority::Streaming)
+			taskPriority = TaskPriority::High;
+
+		auto decode = [this, request, stream]()
+		{
+			UINT64 startUs = mTimer.getMicroseconds();
+			bool success = request->decode(stream);
+			mDecodeTimeUs.fetch_add(mTimer.getMicroseconds() - startUs, std::memory_order_relaxed);
+
+			// Covers both failed reads (in which case the stream is null) and data that couldn't be decoded
+			if (!success)
+				mNumFailed.fetch_add(1, std::memory_order_relaxed);
+
+			mNumCompleted.fetch_add(1, std::memory_order_relaxed);
+			bs_delete(request);
+
+			Lock lock(mMutex);
+			mNumDecoding.fetch_sub(1);
+			mDecodeCompleteCond.notify_all();
+		};
+
+		SPtr<Task> task = Task::create("Resource decode: " + request->name, decode, taskPriority);
+		TaskScheduler::instance().addTask(task);
+	}
+
+	void ResourceLoader::finishCancelled(const Vector<Request*>& requests)
+	{
+		for (auto& request : requests)
+		{
+			mNumCancelled.fetch_add(1, std::memory_order_relaxed);
+
+			request->decode(nullptr);
+			bs_delete(request);
+		}
+	}
+}
@@ -0,0 +1,170 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResourceArchive.h"
+#include "Utility/BsTimer.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Performs asynchronous resource loads, separating file reads from decoding. Files are read by a small number of
+	 * dedicated I/O threads, after which the data is decoded on the task scheduler's worker threads.
+	 *
+	 * @note
+	 * I/O threads process loads from the highest priority class first. Each thread takes a batch of loads at once and
+	 * sorts it by file and offset, so that loads from the same file are read sequentially. Loads can be cancelled until
+	 * their file starts being read.
+	 * @note
+	 * I/O threads are dedicated threads rather than ThreadPool threads, as they're held for the lifetime of the loader.
+	 * @note
+	 * Thread safe.
+	 */
+	class BS_CORE_EXPORT ResourceLoader
+	{
+		/** Information about a single queued load. */
+		struct Request
+		{
+			String name;
+			Path filePath;
+			String filePathStr;
+			UINT64 offset;
+			UINT64 size;
+			bool memoryMap;
+			ResourceLoadPriority priority;
+			SPtr<ResourceArchive> archive;
+			const ResourceArchive::Entry* archiveEntry;
+			std::function<bool(const SPtr<DataStream>&)> decode;
+			std::function<void(const SPtr<DataStream>&)> onRead;
+		};
+
+	public:
+		/**
+		 * Maximum number of bytes an I/O thread reads into memory for a single load. Larger data is read during decode
+		 * instead, so the entire file isn't kept in memory alongside the resource decoded from it.
+		 */
+		static const UINT64 MAX_BUFFERED_READ_SIZE = 32 * 1024 * 1024;
+
+		/**
+		 * Constructs the loader. I/O threads are started on the first queued load.
+		 *
+		 * @param[in]	numIOThreads	Number of threads dedicated to reading files.
+		 */
+		ResourceLoader(UINT32 numIOThreads);
+
+		/** Cancels all queued loads and waits until the loads currently being read or decoded complete. */
+		~ResourceLoader();
+
+		/**
+		 * Queues a new load.
+		 *
+		 * @param[in]	name		Name used for identifying the load, e.g. the resource UUID. Used for cancelling the
+		 *							load.
+		 * @param[in]	filePath	Path to the file to read.
+		 * @param[in]	offset		Offset in bytes at which the data starts in the file.
+		 * @param[in]	size		Size of the data in bytes. If zero, everything from @p offset to the end of the file
+		 *							is read.
+		 * @param[in]	memoryMap	If true the file is mapped into memory instead of being read into a buffer. In that
+		 *							case the stream provided to @p decode is the entire mapped file, positioned at
+		 *							@p offset. Data larger than MAX_BUFFERED_READ_SIZE isn't read into a buffer
+		 *							either, and is instead provided as a file stream positioned at @p offset, read
+		 *							as it's decoded.
+		 * @param[in]	priority	Priority class of the load.
+		 * @param[in]	decode		Callback triggered on a task scheduler worker once the data is read. Receives a
+		 *							stream containing the data, or null if the read failed or the load was cancelled. In
+		 *							the latter case the callback is triggered on the thread that cancelled the load.
+		 *							Returns false if the data couldn't be decoded, in which case the load is counted as
+		 *							failed.
+		 * @param[in]	onRead		Optional callback triggered on the I/O thread as soon as the data is read, before
+		 *							the decode is queued. Receives the same stream as @p decode, and any reads it
+		 *							performs are undone before the stream is decoded. Must be quick, as it delays the
+		 *							reads of other loads.
+		 */
+		void queue(const String& name, const Path& filePath, UINT64 offset, UINT64 size, bool memoryMap,
+			ResourceLoadPriority priority, std::function<bool(const SPtr<DataStream>&)> decode,
+			std::function<void(const SPtr<DataStream>&)> onRead = nullptr);
+
+		/**
+		 * Queues a new load of an entry in a resource archive.
+		 *
+		 * @param[in]	name		Name used for identifying the load, e.g. the resource UUID. Used for cancelling the
+		 *							load.
+		 * @param[in]	archive		Archive containing the entry.
+		 * @param[in]	entry		Entry to read. Must belong to @p archive.
+		 * @param[in]	memoryMap	If true the stream provided to @p decode references the archive memory directly,
+		 *							instead of the data being copied into a buffer. Entries larger than
+		 *							MAX_BUFFERED_READ_SIZE are always referenced directly.
+		 * @param[in]	priority	Priority class of the load.
+		 * @param[in]	decode		Callback triggered once the data is read. Same as for loads of standalone files.
+		 */
+		void queue(const String& name, const SPtr<ResourceArchive>& archive, const ResourceArchive::Entry& entry,
+			bool memoryMap, ResourceLoadPriority priority, std::function<bool(const SPtr<DataStream>&)> decode);
+
+		/**
+		 * Moves a queued load to the front of the highest priority class. Does nothing if the load isn't queued or is
+		 * already being read. Returns true if the load was found.
+		 */
+		bool prioritize(const String& name);
+
+		/** Cancels a queued load. Returns false if the load isn't queued or is already being read. */
+		bool cancel(const String& name);
+
+		/** Cancels all queued loads of the specified priority class. Returns the number of cancelled loads. */
+		UINT32 cancelAll(ResourceLoadPriority priority);
+
+		/** Returns information about the loads performed since the last call to resetStats(). */
+		ResourceLoadStats getStats() const;
+
+		/** Resets the statistics returned by getStats(). Loads that are still queued or in progress are not affected. */
+		void resetStats();
+
+	private:
+		/** Main method ran by each I/O thread. */
+		void runIOThread();
+
+		/**
+		 * Adds a new load to the queue of its priority class, starting the I/O threads if needed. Loads added while the
+		 * loader is shutting down are cancelled immediately.
+		 */
+		void addRequest(Request* request);
+
+		/** Reads the data of the provided load. Returns null on failure. */
+		SPtr<DataStream> read(const Request& request);
+
+		/** Queues the decode of a load on a task scheduler worker. Takes ownership of the request. */
+		void queueDecode(Request* request, const SPtr<DataStream>& stream);
+
+		/** Triggers the decode callback of the provided cancelled loads on the calling thread, and destroys them. */
+		void finishCancelled(const Vector<Request*>& requests);
+
+		UINT32 mNumIOThreads;
+		Vector<Thread*> mIOThreads;
+		Deque<Request*> mQueues[(UINT32)ResourceLoadPriority::Count];
+		bool mShutdown = false;
+
+		mutable Mutex mMutex;
+		Signal mQueueCond;
+		Signal mDecodeCompleteCond;
+
+		// Stats
+		Timer mTimer;
+		std::atomic<UINT64> mStatsStartUs;
+		std::atomic<UINT32> mNumReading;
+		std::atomic<UINT32> mNumDecoding;
+		std::atomic<UINT32> mNumRequested;
+		std::atomic<UINT32> mNumCompleted;
+		std::atomic<UINT32> mNumCancelled;
+		std::atomic<UINT32> mNumFailed;
+		std::atomic<UINT64> mBytesRead;
+		std::atomic<UINT64> mReadTimeUs;
+		std::atomic<UINT64> mDecodeTimeUs;
+	};
+
+	/** @} */
+}
@@ -30,6 +30,8 @@ namespace bs
 
 	void ResourceManifest::registerResource(const String& uuid, const Path& filePath)
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mUUIDToFilePath.find(uuid);
 
 		if(iterFind != mUUIDToFilePath.end())
@@ -55,6 +57,8 @@ namespace bs
 
 	void ResourceManifest::unregisterResource(const String& uuid)
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mUUIDToFilePath.find(uuid);
 
 		if(iterFind != mUUIDToFilePath.end())
@@ -66,6 +70,8 @@ namespace bs
 
 	bool ResourceManifest::uuidToFilePath(const String& uuid, Path& filePath) const
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mUUIDToFilePath.find(uuid);
 
 		if(iterFind != mUUIDToFilePath.end())
@@ -82,6 +88,8 @@ namespace bs
 
 	bool ResourceManifest::filePathToUUID(const Path& filePath, String& outUUID) const
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mFilePathToUUID.find(filePath);
 
 		if(iterFind != mFilePathToUUID.end())
@@ -98,6 +106,8 @@ namespace bs
 
 	bool ResourceManifest::uuidExists(const String& uuid) const
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mUUIDToFilePath.find(uuid);
 
 		return iterFind != mUUIDToFilePath.end();
@@ -105,6 +115,8 @@ namespace bs
 
 	bool ResourceManifest::filePathExists(const Path& filePath) const
 	{
+		Lock lock(mMutex);
+
 		auto iterFind = mFilePathToUUID.find(filePath);
 
 		return iterFind != mFilePathToUUID.end();
@@ -114,6 +126,7 @@ namespace bs
 	{
 		SPtr<ResourceManifest> copy = create(manifest->mName);
 
+		Lock lock(manifest->mMutex);
 		for(auto& elem : manifest->mFilePathToUUID)
 		{
 			if (!relativePath.includes(elem.first))
@@ -140,6 +153,8 @@ namespace bs
 			copy->mUUIDToFilePath[elem.first] = elementRelativePath;
 		}
 
+		lock.unlock();
+
 		FileEncoder fs(path);
 		fs.encode(copy.get());
 	}
@@ -80,6 +80,7 @@ namespace bs
 		String mName;
 		UnorderedMap<String, Path> mUUIDToFilePath;
 		UnorderedMap<Path, String> mFilePathToUUID;
+		mutable Mutex mMutex;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -3,10 +3,11 @@
 #include "Resources/BsResources.h"
 #include "Resources/BsResource.h"
 #include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourceLoader.h"
+#include "Resources/BsResourceArchive.h"
 #include "Error/BsException.h"
 #include "Serialization/BsFileSerializer.h"
 #include "FileSystem/BsFileSystem.h"
-#include "Threading/BsTaskScheduler.h"
 #include "Utility/BsUUID.h"
 #include "Debug/BsDebug.h"
 #include "Utility/BsUtility.h"
@@ -19,7 +20,14 @@
 
 namespace bs
 {
+	/**
+	 * Number of threads reading resource files during asynchronous loads. Loads are sorted by their location before
+	 * being read, so a second thread keeps an SSD busy without causing much seeking on a hard drive.
+	 */
+	static const UINT32 NUM_IO_THREADS = 2;
+
 	Resources::Resources()
+		: mLoader(bs_new<ResourceLoader>(NUM_IO_THREADS))
 	{
 		mDefaultResourceManifest = ResourceManifest::create("Default");
 		mResourceManifests.push_back(mDefaultResourceManifest);
@@ -27,11 +35,15 @@ namespace bs
 
 	Resources::~Resources()
 	{
+		// Cancel any queued loads and wait for the ones in progress to finish
+		bs_delete(mLoader);
+		mLoader = nullptr;
+
 		// Unload and invalidate all resources
 		UnorderedMap<String, LoadedResourceData> loadedResourcesCopy;
 		
 		{
-			Lock lock(mLoadedResourceMutex);
+			Lock lock(mMutex);
 			loadedResourcesCopy = mLoadedResources;
 		}
 
@@ -41,6 +53,17 @@ namespace bs
 
 	HResource Resources::load(const Path& filePath, ResourceLoadFlags loadFlags)
 	{
+		String uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+
+		// Resources packed in an archive don't need to exist as standalone files
+		if (foundUUID)
+		{
+			SPtr<ResourceArchive> archive = findResourceArchive(uuid);
+			if (archive != nullptr)
+				return loadInternal(uuid, archive->getPath(), archive, true, loadFlags, ResourceLoadPriority::Level);
+		}
+
 		if (!FileSystem::isFile(filePath))
 		{
 			LOGWRN("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
@@ -48,13 +71,10 @@ namespace bs
 			return HResource();
 		}
 
-		String uuid;
-		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
-
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, true, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, true, loadFlags, ResourceLoadPriority::Level);
 	}
 
 	HResource Resources::load(const WeakResourceHandle<Resource>& handle, ResourceLoadFlags loadFlags)
@@ -66,8 +86,19 @@ namespace bs
 		return loadFromUUID(uuid, false, loadFlags);
 	}
 
-	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags)
+	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags, ResourceLoadPriority priority)
 	{
+		String uuid;
+		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
+
+		// Resources packed in an archive don't need to exist as standalone files
+		if (foundUUID)
+		{
+			SPtr<ResourceArchive> archive = findResourceArchive(uuid);
+			if (archive != nullptr)
+				return loadInternal(uuid, archive->getPath(), archive, false, loadFlags, priority);
+		}
+
 		if (!FileSystem::isFile(filePath))
 		{
 			LOGWRN("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
@@ -75,112 +106,170 @@ namespace bs
 			return HResource();
 		}
 
-		String uuid;
-		bool foundUUID = getUUIDFromFilePath(filePath, uuid);
-
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, false, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, false, loadFlags, priority);
 	}
 
-	HResource Resources::loadFromUUID(const String& uuid, bool async, ResourceLoadFlags loadFlags)
+	HResource Resources::loadFromUUID(const String& uuid, bool async, ResourceLoadFlags loadFlags,
+		ResourceLoadPriority priority)
 	{
-		Path filePath;
+		// Archives take priority as they're built from the final version of the resources
+		SPtr<ResourceArchive> archive = findResourceArchive(uuid);
+		if (archive != nullptr)
+			return loadInternal(uuid, archive->getPath(), archive, !async, loadFlags, priority);
 
-		// Default manifest is at 0th index but all other take priority since Default manifest could
-		// contain obsolete data. 
-		for (auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter)
-		{
-			if ((*iter)->uuidToFilePath(uuid, filePath))
-				break;
-		}
+		Path filePath;
+		getFilePathFromUUID(uuid, filePath);
 
-		return loadInternal(uuid, filePath, !async, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, !async, loadFlags, priority);
 	}
 
-	HResource Resources::loadInternal(const String& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags)
+	HResource Resources::loadInternal(const String& UUID, const Path& filePath, const SPtr<ResourceArchive>& archive,
+		bool synchronous, ResourceLoadFlags loadFlags, ResourceLoadPriority priority)
 	{
-		HResource outputResource;
+		const ResourceArchive::Entry* archiveEntry = nullptr;
+		if (archive != nullptr)
+			archiveEntry = archive->findEntry(UUID);
+
+		bool loadDependencies = loadFlags.isSet(ResourceLoadFlag::LoadDependencies);
+		bool keepInternalRef = loadFlags.isSet(ResourceLoadFlag::KeepInternalRef);
+
+		ResourceLoadFlags depLoadFlags = ResourceLoadFlag::LoadDependencies;
+		if (loadFlags.isSet(ResourceLoadFlag::KeepSourceData))
+			depLoadFlags |= ResourceLoadFlag::KeepSourceData;
 
+		if (loadFlags.isSet(ResourceLoadFlag::MemoryMapFile))
+			depLoadFlags |= ResourceLoadFlag::MemoryMapFile;
+
+		// Checked before taking the lock, so other loads aren't blocked on file system access
+		bool fileExists = archiveEntry != nullptr || (!filePath.isEmpty() && FileSystem::isFile(filePath));
+
+		HResource outputResource;
 		bool alreadyLoading = false;
 		bool loadInProgress = false;
+		bool readDependencies = false;
+		Vector<String> dependencies;
+
+		// Look up the resource state, create the handle and register the load in a single critical section
 		{
-			// Check if resource is already being loaded on a worker thread
-			Lock inProgressLock(mInProgressResourcesMutex);
-			auto iterFind2 = mInProgressResources.find(UUID);
-			if (iterFind2 != mInProgressResources.end())
+			Lock lock(mMutex);
+
+			ResourceLoadData* loadData = nullptr;
+			LoadedResourceData* resData = nullptr;
+
+			auto iterFind = mInProgressResources.find(UUID);
+			if (iterFind != mInProgressResources.end()) // Resource is being loaded
+			{
+				loadData = iterFind->second;
+				resData = &loadData->resData;
+
+				alreadyLoading = true;
+				loadInProgress = true;
+			}
+			else
+			{
+				auto iterFind2 = mLoadedResources.find(UUID);
+				if (iterFind2 != mLoadedResources.end()) // Resource is already loaded
+				{
+					resData = &iterFind2->second;
+					alreadyLoading = true;
+				}
+			}
+
+			if (alreadyLoading)
 			{
-				LoadedResourceData& resData = iterFind2->second->resData;
-				outputResource = resData.resource.lock();
+				outputResource = resData->resource.lock();
 
-				if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
+				if (keepInternalRef)
 				{
-					resData.numInternalRefs++;
+					resData->numInternalRefs++;
 					outputResource.addInternalRef();
 				}
 
-				alreadyLoading = true;
-				loadInProgress = true;
-			}
+				// Queue dependencies in case they aren't already loaded
+				if (loadDependencies && fileExists)
+				{
+					if (resData->dependenciesKnown)
+					{
+						if (!resData->dependencies.empty())
+						{
+							if (loadData == nullptr) // Fully loaded, track the dependency loads until they finish
+							{
+								loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 0);
+								loadData->resData.dependencies = resData->dependencies;
+								loadData->resData.dependenciesKnown = true;
+								// Make resource listener trigger before exit if loading synchronously
+								loadData->notifyImmediately = synchronous;
 
-			// Previously being loaded as async but now we want it synced, so we wait
-			if (loadInProgress && synchronous)
-				outputResource.blockUntilLoaded();
+								mInProgressResources[UUID] = loadData;
+							}
 
-			if (!alreadyLoading)
+							registerDependencies(loadData, resData->dependencies);
+							dependencies = resData->dependencies;
+						}
+					}
+					else if (loadData != nullptr) // Dependencies get loaded once the file header is read
+						loadData->loadDependencies = true;
+					else if (archiveEntry == nullptr) // Created in memory rather than loaded from its file
+						readDependencies = true;
+				}
+			}
+			else
 			{
-				Lock loadedLock(mLoadedResourceMutex);
-				auto iterFind = mLoadedResources.find(UUID);
-				if (iterFind != mLoadedResources.end()) // Resource is already loaded
+				auto iterFind3 = mHandles.find(UUID);
+				if (iterFind3 != mHandles.end())
+					outputResource = iterFind3->second.lock();
+				else
+				{
+					outputResource = HResource(UUID);
+					mHandles[UUID] = outputResource.getWeak();
+				}
+
+				if (fileExists)
 				{
-					LoadedResourceData& resData = iterFind->second;
-					outputResource = resData.resource.lock();
+					// Handle might be left over from a previous load that has since been unloaded, in which case it
+					// would still report the resource as created and blockUntilLoaded() wouldn't wait for this load
+					outputResource.mData->mIsCreated = false;
 
-					if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
+					loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 1);
+					// Make resource listener trigger before exit if loading synchronously
+					loadData->notifyImmediately = synchronous;
+					loadData->loadDependencies = loadDependencies;
+
+					if (keepInternalRef)
 					{
-						resData.numInternalRefs++;
+						loadData->resData.numInternalRefs++;
 						outputResource.addInternalRef();
 					}
 
-					alreadyLoading = true;
+					mInProgressResources[UUID] = loadData;
+
+					// Archives store the dependencies in their index, no need to read the resource
+					if (archiveEntry != nullptr)
+					{
+						loadData->resData.dependencies = archive->getDependencies(*archiveEntry);
+						loadData->resData.dependenciesKnown = true;
+
+						if (loadDependencies)
+						{
+							registerDependencies(loadData, loadData->resData.dependencies);
+							dependencies = loadData->resData.dependencies;
+						}
+					}
 				}
 			}
 		}
 
-		// Not loaded and not in progress, start loading of new resource
-		// (or if already loaded or in progress, load any dependencies)
-		if (!alreadyLoading)
-		{
-			// Check if the handle already exists
-			Lock lock(mLoadedResourceMutex);
-			auto iterFind = mHandles.find(UUID);
-			if (iterFind != mHandles.end())
-				outputResource = iterFind->second.lock();
-			else
-			{
-				outputResource = HResource(UUID);
-				mHandles[UUID] = outputResource.getWeak();
-			}			
-		}
-
 		// We have nowhere to load from, warn and complete load if a file path was provided,
 		// otherwise pass through as we might just want to load from memory. 
-		if (filePath.isEmpty())
+		if (!fileExists && (!alreadyLoading || !filePath.isEmpty()))
 		{
-			if (!alreadyLoading)
-			{
+			if (filePath.isEmpty())
 				LOGWRN_VERBOSE("Cannot load resource. Resource with UUID '" + UUID + "' doesn't exist.");
-
-				// Complete the load as that the depedency counter is properly reduced, in case this 
-				// is a dependency of some other resource.
-				loadComplete(outputResource);
-				return outputResource;
-			}
-		}
-		else if (!FileSystem::isFile(filePath))
-		{
-			LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
+			else
+				LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 
 			// Complete the load as that the depedency counter is properly reduced, in case this 
 			// is a dependency of some other resource.
@@ -190,150 +279,89 @@ namespace bs
 			return outputResource;
 		}
 
-		// Load dependency data if a file path is provided
-		SPtr<SavedResourceData> savedResourceData;
-		if (!filePath.isEmpty())
-		{
-			FileDecoder fs(filePath);
-			savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
-		}
+		for (auto& dependency : dependencies)
+			loadFromUUID(dependency, !synchronous, depLoadFlags, priority);
 
-		// If already loading keep the old load operation active, otherwise create a new one
-		if (!alreadyLoading)
+		// Standalone files store their dependencies in their header. Synchronous loads read it right away, while
+		// asynchronous loads read it on an I/O thread along with the rest of the file.
+		bool newLoad = !alreadyLoading && fileExists;
+		if ((newLoad && synchronous && archiveEntry == nullptr) || readDependencies)
 		{
-			{
-				Lock lock(mInProgressResourcesMutex);
-
-				ResourceLoadData* loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 0);
-				mInProgressResources[UUID] = loadData;
-				loadData->resData = outputResource.getWeak();
-
-				if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
-				{
-					loadData->resData.numInternalRefs++;
-					outputResource.addInternalRef();
-				}
+			SPtr<SavedResourceData> savedResourceData;
 
-				loadData->remainingDependencies = 1;
-				loadData->notifyImmediately = synchronous; // Make resource listener trigger before exit if loading synchronously
+			SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+			if (stream != nullptr)
+				savedResourceData = readMetaData(stream);
 
-				// Register dependencies and count them so we know when the resource is fully loaded
-				if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && savedResourceData != nullptr)
-				{
-					for (auto& dependency : savedResourceData->getDependencies())
-					{
-						if (dependency != UUID)
-						{
-							mDependantLoads[dependency].push_back(loadData);
-							loadData->remainingDependencies++;
-						}
-					}
-				}
-			}
+			Vector<String> fileDependencies;
+			if (savedResourceData != nullptr)
+				fileDependencies = savedResourceData->getDependencies();
 
-			if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && savedResourceData != nullptr)
-			{
-				const Vector<String>& dependencyUUIDs = savedResourceData->getDependencies();
-				UINT32 numDependencies = (UINT32)dependencyUUIDs.size();
-				Vector<HResource> dependencies(numDependencies);
+			onDependenciesRead(outputResource, fileDependencies, synchronous, depLoadFlags, priority);
+		}
 
-				ResourceLoadFlags depLoadFlags = ResourceLoadFlag::LoadDependencies;
-				if (loadFlags.isSet(ResourceLoadFlag::KeepSourceData))
-					depLoadFlags |= ResourceLoadFlag::KeepSourceData;
+		// Previously being loaded as async but now we want it synced, so we wait. The wait must happen outside of the
+		// lock, as the load cannot complete without acquiring it. Move the file read to the front of the queue in case
+		// it's still waiting behind other loads.
+		if (loadInProgress && synchronous)
+		{
+			mLoader->prioritize(UUID);
+			outputResource.blockUntilLoaded();
+		}
 
-				for (UINT32 i = 0; i < numDependencies; i++)
-					dependencies[i] = loadFromUUID(dependencyUUIDs[i], !synchronous, depLoadFlags);
+		// Actually start the file read operation if not already loaded or in progress
+		if (newLoad)
+		{
+			bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
+			bool memoryMap = loadFlags.isSet(ResourceLoadFlag::MemoryMapFile) && !keepSourceData;
 
-				// Keep dependencies alive until the parent is done loading
+			// Synchronous or the resource doesn't support async, read the file immediately
+			if (synchronous || (archiveEntry != nullptr && !archiveEntry->allowAsync))
+			{
+				SPtr<Resource> rawResource;
+				if (archiveEntry != nullptr)
 				{
-					Lock lock(mInProgressResourcesMutex);
-
-					// At this point the resource is guaranteed to still be in-progress, so it's safe to update its dependency list
-					mInProgressResources[UUID]->dependencies = dependencies;
+					SPtr<DataStream> stream = archive->readEntry(*archiveEntry, memoryMap);
+					if (stream != nullptr)
+						rawResource = deserialize(stream, filePath, keepSourceData);
 				}
+				else
+					rawResource = loadFromDiskAndDeserialize(filePath, keepSourceData, memoryMap);
+
+				loadComplete(outputResource, true, rawResource);
 			}
-		}
-		else if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && savedResourceData != nullptr) // Queue dependencies in case they aren't already loaded
-		{
-			const Vector<String>& dependencies = savedResourceData->getDependencies();
-			if (!dependencies.empty())
+			else // Asynchronous, read the file on an I/O thread and deserialize it on a worker thread
 			{
+				auto decode = [this, filePath, outputResource, keepSourceData](const SPtr<DataStream>& stream) mutable
 				{
-					Lock lock(mInProgressResourcesMutex);
+					SPtr<Resource> rawResource;
+					if (stream != nullptr)
+						rawResource = deserialize(stream, filePath, keepSourceData);
 
-					ResourceLoadData* loadData = nullptr;
+					loadComplete(outputResource, true, rawResource);
+					return rawResource != nullptr;
+				};
 
-					auto iterFind = mInProgressResources.find(UUID);
-					if (iterFind == mInProgressResources.end()) // Fully loaded
-					{
-						loadData = bs_new<ResourceLoadData>(outputResource.getWeak(), 0);
-						loadData->resData = outputResource.getWeak();
-						loadData->remainingDependencies = 0;
-						loadData->notifyImmediately = synchronous; // Make resource listener trigger before exit if loading synchronously
-
-						mInProgressResources[UUID] = loadData;
-					}
-					else
+				if (archiveEntry != nullptr)
+					mLoader->queue(UUID, archive, *archiveEntry, memoryMap, priority, decode);
+				else
+				{
+					// Dependencies are discovered on the I/O thread, so their loads get queued as soon as the file is
+					// read rather than after it's decoded
+					auto discoverDependencies = [this, outputResource, depLoadFlags, priority](
+						const SPtr<DataStream>& stream) mutable
 					{
-						loadData = iterFind->second;
-					}
+						SPtr<SavedResourceData> savedResourceData = readMetaData(stream);
 
-					// Register dependencies and count them so we know when the resource is fully loaded
-					for (auto& dependency : dependencies)
-					{
-						if (dependency != UUID)
-						{
-							bool registerDependency = true;
+						Vector<String> fileDependencies;
+						if (savedResourceData != nullptr)
+							fileDependencies = savedResourceData->getDependencies();
 
-							auto iterFind2 = mDependantLoads.find(dependency);
-							if (iterFind2 != mDependantLoads.end())
-							{
-								Vector<ResourceLoadData*>& dependantData = iterFind2->second;
-								auto iterFind3 = std::find_if(dependantData.begin(), dependantData.end(),
-									[&](ResourceLoadData* x)
-								{
-									return x->resData.resource.getUUID() == outputResource.getUUID();
-								});
-
-								registerDependency = iterFind3 == dependantData.end();
-							}
+						onDependenciesRead(outputResource, fileDependencies, false, depLoadFlags, priority);
+					};
 
-							if (registerDependency)
-							{
-								mDependantLoads[dependency].push_back(loadData);
-								loadData->remainingDependencies++;
-								loadData->dependencies.push_back(_getResourceHandle(dependency));
-							}
-						}
-					}
+					mLoader->queue(UUID, filePath, 0, 0, memoryMap, priority, decode, discoverDependencies);
 				}
-
-				ResourceLoadFlags depLoadFlags = ResourceLoadFlag::LoadDependencies;
-				if (loadFlags.isSet(ResourceLoadFlag::KeepSourceData))
-					depLoadFlags |= ResourceLoadFlag::KeepSourceData;
-
-				for (auto& dependency : dependencies)
-					loadFromUUID(dependency, !synchronous, depLoadFlags);
-			}
-		}
-
-		// Actually start the file read operation if not already loaded or in progress
-		if (!alreadyLoading && !filePath.isEmpty())
-		{
-			// Synchronous or the resource doesn't support async, read the file immediately
-			if (synchronous || !savedResourceData->allowAsyncLoading())
-			{
-				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
-			}
-			else // Asynchronous, read the file on a worker thread
-			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
-				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
 			}
 		}
 		else // File already loaded or in progress
@@ -347,9 +375,13 @@ namespace bs
 				// In case loading finished in the meantime we cannot be sure at what point ::loadComplete was triggered,
 				// so trigger it manually so that the dependency count is properly decremented in case this resource
 				// is a dependency.
-				Lock lock(mLoadedResourceMutex);
-				auto iterFind = mLoadedResources.find(UUID);
-				if (iterFind != mLoadedResources.end())
+				bool isLoaded;
+				{
+					Lock lock(mMutex);
+					isLoaded = mLoadedResources.find(UUID) != mLoadedResources.end();
+				}
+
+				if (isLoaded)
 					loadComplete(outputResource);
 			}
 		}
@@ -357,16 +389,122 @@ namespace bs
 		return outputResource;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
+	void Resources::onDependenciesRead(HResource& resource, const Vector<String>& dependencies, bool synchronous,
+		ResourceLoadFlags loadFlags, ResourceLoadPriority priority)
 	{
-		// Note: Called asynchronously over multiple resources this will cause performance issues on hard drives as they
-		// work best when they are reading one thing at a time, and it won't have benefits on an SSD either. Think about
-		// executing all file reads on a single thread, while decompression and similar operations can execute on multiple.
+		const String& UUID = resource.getUUID();
+
+		bool loadDependencies = false;
+		{
+			Lock lock(mMutex);
+
+			ResourceLoadData* loadData = nullptr;
+			LoadedResourceData* resData = nullptr;
+
+			auto iterFind = mInProgressResources.find(UUID);
+			if (iterFind != mInProgressResources.end())
+			{
+				loadData = iterFind->second;
+				resData = &loadData->resData;
+			}
+			else
+			{
+				auto iterFind2 = mLoadedResources.find(UUID);
+				if (iterFind2 != mLoadedResources.end())
+					resData = &iterFind2->second;
+			}
+
+			if (resData == nullptr)
+				return;
+
+			resData->dependencies = dependencies;
+			resData->dependenciesKnown = true;
+
+			if (dependencies.empty())
+				return;
+
+			// Resource was loaded without dependencies and a later load requested them
+			if (loadData == nullptr)
+			{
+				loadData = bs_new<ResourceLoadData>(resource.getWeak(), 0);
+				loadData->resData.dependencies = dependencies;
+				loadData->resData.dependenciesKnown = true;
+				loadData->notifyImmediately = synchronous;
+				loadData->loadDependencies = true;
+
+				mInProgressResources[UUID] = loadData;
+			}
+
+			loadDependencies = loadData->loadDependencies;
+			if (loadDependencies)
+				registerDependencies(loadData, dependencies);
+		}
+
+		if (loadDependencies)
+		{
+			for (auto& dependency : dependencies)
+				loadFromUUID(dependency, !synchronous, loadFlags, priority);
+		}
+	}
+
+	void Resources::registerDependencies(ResourceLoadData* loadData, const Vector<String>& dependencies)
+	{
+		const String& UUID = loadData->resData.resource.getUUID();
+
+		// Register dependencies and count them so we know when the resource is fully loaded
+		for (auto& dependency : dependencies)
+		{
+			if (dependency == UUID)
+				continue;
+
+			Vector<ResourceLoadData*>& dependantLoads = mDependantLoads[dependency];
+
+			auto iterFind = std::find(dependantLoads.begin(), dependantLoads.end(), loadData);
+			if (iterFind != dependantLoads.end())
+				continue;
+
+			dependantLoads.push_back(loadData);
+			loadData->remainingDependencies++;
+
+			// Keep dependencies alive until the parent is done loading
+			loadData->dependencies.push_back(getOrCreateHandle(dependency));
+		}
+	}
+
+	SPtr<SavedResourceData> Resources::readMetaData(const SPtr<DataStream>& stream)
+	{
+		if (stream->eof())
+			return nullptr;
+
+		UINT32 metaDataSize = 0;
+		if (stream->read(&metaDataSize, sizeof(metaDataSize)) != sizeof(metaDataSize))
+			return nullptr;
+
+		BinarySerializer bs;
+		SPtr<IReflectable> metaData = bs.decode(stream, metaDataSize);
+		if (metaData == nullptr || metaData->getTypeId() != TID_ResourceDependencies)
+			return nullptr;
+
+		return std::static_pointer_cast<SavedResourceData>(metaData);
+	}
+
+	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData, bool memoryMap)
+	{
+		SPtr<DataStream> stream;
+		if (memoryMap)
+			stream = FileSystem::openMappedFile(filePath);
+		else
+			stream = FileSystem::openFile(filePath, true);
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
 		if (stream == nullptr)
 			return nullptr;
 
+		return deserialize(stream, filePath, loadWithSaveData);
+	}
+
+	SPtr<Resource> Resources::deserialize(const SPtr<DataStream>& fileStream, const Path& filePath, bool loadWithSaveData)
+	{
+		SPtr<DataStream> stream = fileStream;
 		if (stream->size() > std::numeric_limits<UINT32>::max())
 		{
 			BS_EXCEPT(InternalErrorException,
@@ -378,17 +516,7 @@ namespace bs
 			params["keepSourceData"] = 1;
 
 		// Read meta-data
-		SPtr<SavedResourceData> metaData;
-		{
-			if (!stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				BinarySerializer bs;
-				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
-		}
+		SPtr<SavedResourceData> metaData = readMetaData(stream);
 
 		// Read resource data
 		SPtr<IReflectable> loadedData;
@@ -424,35 +552,31 @@ namespace bs
 	{
 		const String& UUID = resource.getUUID();
 
+		bool loadInProgress = false;
 		{
-			bool loadInProgress = false;
-
-			Lock inProgressLock(mInProgressResourcesMutex);
+			Lock lock(mMutex);
 			auto iterFind2 = mInProgressResources.find(UUID);
 			if (iterFind2 != mInProgressResources.end())
 				loadInProgress = true;
+		}
 
-			// Technically we should be able to just cancel a load in progress instead of blocking until it finishes.
-			// However that would mean the last reference could get lost on whatever thread did the loading, which
-			// isn't something that's supported. If this ends up being a problem either make handle counting atomic
-			// or add a separate queue for objects destroyed from the load threads.
-			if (loadInProgress)
-				resource.blockUntilLoaded();
-
-			{
-				Lock loadedLock(mLoadedResourceMutex);
-				auto iterFind = mLoadedResources.find(UUID);
-				if (iterFind != mLoadedResources.end()) // Resource is already loaded
-				{
-					LoadedResourceData& resData = iterFind->second;
-
-					assert(resData.numInternalRefs > 0);
-					resData.numInternalRefs--;
-					resource.removeInternalRef();
+		// Technically we should be able to just cancel a load in progress instead of blocking until it finishes.
+		// However that would mean the last reference could get lost on whatever thread did the loading, which
+		// isn't something that's supported. If this ends up being a problem either make handle counting atomic
+		// or add a separate queue for objects destroyed from the load threads. The wait must happen outside of the
+		// lock, as the load cannot complete without acquiring it.
+		if (loadInProgress)
+			resource.blockUntilLoaded();
+
+		Lock lock(mMutex);
+		auto iterFind = mLoadedResources.find(UUID);
+		if (iterFind != mLoadedResources.end()) // Resource is already loaded
+		{
+			LoadedResourceData& resData = iterFind->second;
 
-					return;
-				}
-			}
+			assert(resData.numInternalRefs > 0);
+			resData.numInternalRefs--;
+			resource.removeInternalRef();
 		}
 	}
 
@@ -461,7 +585,7 @@ namespace bs
 		Vector<HResource> resourcesToUnload;
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			Lock lock(mMutex);
 			for(auto iter = mLoadedResources.begin(); iter != mLoadedResources.end(); ++iter)
 			{
 				const LoadedResourceData& resData = iter->second;
@@ -490,7 +614,7 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
+				Lock lock(mMutex);
 				auto iterFind2 = mInProgressResources.find(uuid);
 				if (iterFind2 != mInProgressResources.end())
 					loadInProgress = true;
@@ -507,7 +631,7 @@ namespace bs
 		resource.mData->mPtr->destroy();
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			Lock lock(mMutex);
 
 			auto iterFind = mLoadedResources.find(uuid);
 			if (iterFind != mLoadedResources.end())
@@ -539,7 +663,7 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
+				Lock lock(mMutex);
 				auto iterFind2 = mInProgressResources.find(resource.getUUID());
 				if (iterFind2 != mInProgressResources.end())
 					loadInProgress = true;
@@ -590,6 +714,7 @@ namespace bs
 			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
 	
 		// Write meta-data
+		UINT32 objectOffset = 0;
 		{
 			MemorySerializer ms;
 			UINT32 numBytes = 0;
@@ -599,13 +724,17 @@ namespace bs
 			stream.write((char*)bytes, numBytes);
 			
 			bs_free(bytes);
+
+			objectOffset = sizeof(numBytes) + numBytes + sizeof(UINT32);
 		}
 
-		// Write object data
+		// Write object data (offset provided so data blocks end up aligned within the file, allowing them to be used
+		// directly when the file is memory mapped)
 		{
 			MemorySerializer ms;
 			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resource.get(), numBytes);
+			UINT8* bytes = ms.encode(resource.get(), numBytes, nullptr, false, UnorderedMap<String, UINT64>(), 
+				objectOffset);
 
 			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
 			if (compressionMethod != 0)
@@ -638,7 +767,7 @@ namespace bs
 		handle.setHandleData(resource, uuid);
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			Lock lock(mMutex);
 			auto iterFind = mLoadedResources.find(uuid);
 			if (iterFind == mLoadedResources.end())
 			{
@@ -668,6 +797,7 @@ namespace bs
 		if(manifest->getName() == "Default")
 			return;
 
+		Lock lock(mLookupMutex);
 		auto findIter = std::find(mResourceManifests.begin(), mResourceManifests.end(), manifest);
 		if(findIter == mResourceManifests.end())
 			mResourceManifests.push_back(manifest);
@@ -680,13 +810,43 @@ namespace bs
 		if (manifest->getName() == "Default")
 			return;
 
+		Lock lock(mLookupMutex);
 		auto findIter = std::find(mResourceManifests.begin(), mResourceManifests.end(), manifest);
 		if (findIter != mResourceManifests.end())
 			mResourceManifests.erase(findIter);
 	}
 
+	void Resources::registerResourceArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mLookupMutex);
+		auto findIter = std::find(mResourceArchives.begin(), mResourceArchives.end(), archive);
+		if (findIter == mResourceArchives.end())
+			mResourceArchives.push_back(archive);
+	}
+
+	void Resources::unregisterResourceArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mLookupMutex);
+		auto findIter = std::find(mResourceArchives.begin(), mResourceArchives.end(), archive);
+		if (findIter != mResourceArchives.end())
+			mResourceArchives.erase(findIter);
+	}
+
+	SPtr<ResourceArchive> Resources::findResourceArchive(const String& uuid) const
+	{
+		Lock lock(mLookupMutex);
+		for (auto iter = mResourceArchives.rbegin(); iter != mResourceArchives.rend(); ++iter)
+		{
+			if ((*iter)->findEntry(uuid) != nullptr)
+				return *iter;
+		}
+
+		return nullptr;
+	}
+
 	SPtr<ResourceManifest> Resources::getResourceManifest(const String& name) const
 	{
+		Lock lock(mLookupMutex);
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if(name == (*iter)->getName())
@@ -700,20 +860,17 @@ namespace bs
 	{
 		if (checkInProgress)
 		{
-			Lock inProgressLock(mInProgressResourcesMutex);
+			Lock lock(mMutex);
 			auto iterFind2 = mInProgressResources.find(uuid);
 			if (iterFind2 != mInProgressResources.end())
 			{
 				return true;
 			}
 
+			auto iterFind = mLoadedResources.find(uuid);
+			if (iterFind != mLoadedResources.end())
 			{
-				Lock loadedLock(mLoadedResourceMutex);
-				auto iterFind = mLoadedResources.find(uuid);
-				if (iterFind != mLoadedResources.end())
-				{
-					return true;
-				}
+				return true;
 			}
 		}
 
@@ -731,7 +888,7 @@ namespace bs
 		HResource newHandle(obj, UUID);
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			Lock lock(mMutex);
 
 			LoadedResourceData& resData = mLoadedResources[UUID];
 			resData.resource = newHandle.getWeak();
@@ -743,7 +900,12 @@ namespace bs
 
 	HResource Resources::_getResourceHandle(const String& uuid)
 	{
-		Lock lock(mLoadedResourceMutex);
+		Lock lock(mMutex);
+		return getOrCreateHandle(uuid);
+	}
+
+	HResource Resources::getOrCreateHandle(const String& uuid)
+	{
 		auto iterFind3 = mHandles.find(uuid);
 		if (iterFind3 != mHandles.end()) // Not loaded, but handle does exist
 		{
@@ -759,6 +921,10 @@ namespace bs
 
 	bool Resources::getFilePathFromUUID(const String& uuid, Path& filePath) const
 	{
+		Lock lock(mLookupMutex);
+
+		// Default manifest is at 0th index but all other take priority since Default manifest could
+		// contain obsolete data. 
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if((*iter)->uuidToFilePath(uuid, filePath))
@@ -774,6 +940,7 @@ namespace bs
 		if (!manifestPath.isAbsolute())
 			manifestPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
 
+		Lock lock(mLookupMutex);
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
 		{
 			if ((*iter)->filePathToUUID(manifestPath, uuid))
@@ -783,7 +950,7 @@ namespace bs
 		return false;
 	}
 
-	void Resources::loadComplete(HResource& resource)
+	void Resources::loadComplete(HResource& resource, bool dataLoaded, const SPtr<Resource>& rawResource)
 	{
 		String uuid = resource.getUUID();
 
@@ -791,12 +958,19 @@ namespace bs
 		bool finishLoad = true;
 		Vector<ResourceLoadData*> dependantLoads;
 		{
-			Lock inProgresslock(mInProgressResourcesMutex);
+			Lock lock(mMutex);
 
 			auto iterFind = mInProgressResources.find(uuid);
 			if (iterFind != mInProgressResources.end())
 			{
 				myLoadData = iterFind->second;
+
+				if (dataLoaded)
+				{
+					myLoadData->loadedData = rawResource;
+					myLoadData->remainingDependencies--;
+				}
+
 				finishLoad = myLoadData->remainingDependencies == 0;
 				
 				if (finishLoad)
@@ -816,8 +990,6 @@ namespace bs
 				// by its dependencies.
 				if (myLoadData != nullptr && myLoadData->loadedData != nullptr)
 				{
-					Lock loadedLock(mLoadedResourceMutex);
-
 					mLoadedResources[uuid] = myLoadData->resData;
 					resource.setHandleData(myLoadData->loadedData, uuid);
 				}
@@ -845,20 +1017,27 @@ namespace bs
 		}
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	bool Resources::cancelLoad(const ResourceHandleBase& resource)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		if (resource.mData == nullptr)
+			return false;
 
-		{
-			Lock lock(mInProgressResourcesMutex);
+		return mLoader->cancel(resource.getUUID());
+	}
 
-			// Check if all my dependencies are loaded
-			ResourceLoadData* myLoadData = mInProgressResources[resource.getUUID()];
-			myLoadData->loadedData = rawResource;
-			myLoadData->remainingDependencies--;
-		}
+	void Resources::cancelLoads(ResourceLoadPriority priority)
+	{
+		mLoader->cancelAll(priority);
+	}
 
-		loadComplete(resource);
+	ResourceLoadStats Resources::getLoadStats() const
+	{
+		return mLoader->getStats();
+	}
+
+	void Resources::resetLoadStats()
+	{
+		mLoader->resetStats();
 	}
 
 	BS_CORE_EXPORT Resources& gResources()
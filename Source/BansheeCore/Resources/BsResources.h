@@ -32,6 +32,13 @@ namespace bs
 		 * use up extra memory. Normally you want to keep this enabled if you plan on saving the resource to disk.
 		 */
 		KeepSourceData = 1 << 2,
+		/**
+		 * If enabled the resource file will be mapped into memory instead of being read through a file stream. Large data
+		 * blocks (e.g. mesh and texture data) then reference the mapped memory directly instead of being copied, and are
+		 * read from the disk on demand as they are accessed. The file must not be modified while the resource is loaded.
+		 * Ignored if KeepSourceData is enabled, as the resource might then be saved over its own file.
+		 */
+		MemoryMapFile = 1 << 3,
 		/** Default set of flags used for resource loading. */
 		Default = LoadDependencies | KeepInternalRef
 	};
@@ -39,6 +46,50 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/** Priority classes of asynchronous resource loads. Loads in a higher priority class are always read first. */
+	enum class ResourceLoadPriority
+	{
+		/** Resources required as soon as possible, e.g. streamed in as the viewer moves through the world. */
+		Streaming,
+		/** Resources loaded in bulk, e.g. when loading a level. */
+		Level,
+		Count // Keep at end
+	};
+
+	/** Information about asynchronous resource loads, used for reporting load progress and throughput. */
+	struct ResourceLoadStats
+	{
+		UINT32 numRequested = 0; /**< Number of loads queued since the stats were reset. */
+		UINT32 numCompleted = 0; /**< Number of loads finished since the stats were reset, including failed ones. */
+		UINT32 numFailed = 0; /**< Number of loads whose data couldn't be read or decoded since the stats were reset. */
+		UINT32 numCancelled = 0; /**< Number of loads cancelled since the stats were reset. */
+		UINT32 numQueued = 0; /**< Number of loads currently waiting for their file to be read. */
+		UINT32 numReading = 0; /**< Number of loads currently having their file read. */
+		UINT32 numDecoding = 0; /**< Number of loads currently being decoded. */
+		UINT64 bytesRead = 0; /**< Number of bytes read since the stats were reset. */
+		UINT64 readTimeUs = 0; /**< Time spent reading files, summed over all I/O threads, in microseconds. */
+		UINT64 decodeTimeUs = 0; /**< Time spent decoding, summed over all workers, in microseconds. */
+		UINT64 elapsedTimeUs = 0; /**< Time elapsed since the stats were reset, in microseconds. */
+
+		/** Returns the portion of the requested loads that finished or were cancelled, in range [0, 1]. */
+		float getProgress() const
+		{
+			if (numRequested == 0)
+				return 1.0f;
+
+			return std::min((numCompleted + numCancelled) / (float)numRequested, 1.0f);
+		}
+
+		/** Returns the average number of bytes read per second since the stats were reset. */
+		double getReadThroughput() const
+		{
+			if (elapsedTimeUs == 0)
+				return 0.0;
+
+			return bytesRead * 1000000.0 / elapsedTimeUs;
+		}
+	};
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -50,22 +101,25 @@ namespace bs
 		struct LoadedResourceData
 		{
 			LoadedResourceData()
-				:numInternalRefs(0)
+				:numInternalRefs(0), dependenciesKnown(false)
 			{ }
 
 			LoadedResourceData(const WeakResourceHandle<Resource>& resource)
-				:resource(resource), numInternalRefs(0)
+				:resource(resource), numInternalRefs(0), dependenciesKnown(false)
 			{ }
 
 			WeakResourceHandle<Resource> resource;
 			UINT32 numInternalRefs;
+			Vector<String> dependencies; /**< UUIDs of resources referenced by the resource, if known. */
+			bool dependenciesKnown; /**< False until the dependency list is read from the resource file. */
 		};
 
 		/** Information about a resource that's currently being loaded. */
 		struct ResourceLoadData
 		{
 			ResourceLoadData(const WeakResourceHandle<Resource>& resource, UINT32 numDependencies)
-				:resData(resource), remainingDependencies(numDependencies)
+				:resData(resource), remainingDependencies(numDependencies), notifyImmediately(false)
+				, loadDependencies(false)
 			{ }
 
 			LoadedResourceData resData;
@@ -73,6 +127,7 @@ namespace bs
 			UINT32 remainingDependencies;
 			Vector<HResource> dependencies;
 			bool notifyImmediately;
+			bool loadDependencies; /**< Should dependencies be loaded once they're read from the resource file. */
 		};
 
 	public:
@@ -119,16 +174,19 @@ namespace bs
 		 *
 		 * @param[in]	filePath	Full pathname of the file.
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Priority class of the load. Dependencies are loaded with the same priority.
 		 *			
 		 * @see		load(const Path&, ResourceLoadFlags)
 		 */
-		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			ResourceLoadPriority priority = ResourceLoadPriority::Level);
 
 		/** @copydoc loadAsync */
 		template <class T>
-		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default)
+		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			ResourceLoadPriority priority = ResourceLoadPriority::Level)
 		{
-			return static_resource_cast<T>(loadAsync(filePath, loadFlags));
+			return static_resource_cast<T>(loadAsync(filePath, loadFlags, priority));
 		}
 
 		/**
@@ -138,10 +196,38 @@ namespace bs
 		 * @param[in]	async		If true resource will be loaded asynchronously. Handle to non-loaded resource will be
 		 *							returned immediately while loading will continue in the background.		
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Priority class of the load, if loading asynchronously.
 		 *													
 		 * @see		load(const Path&, bool)
 		 */
-		HResource loadFromUUID(const String& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadFromUUID(const String& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			ResourceLoadPriority priority = ResourceLoadPriority::Level);
+
+		/**
+		 * Cancels an asynchronous load of the resource, if its file hasn't started being read yet. The resource then
+		 * remains unloaded, the same as if its file failed to load, and must not be waited on. Dependencies of the
+		 * resource that were already queued continue loading.
+		 *
+		 * @param[in]	resource	Handle of the resource whose load to cancel.
+		 * @return					True if the load was cancelled, false if the resource isn't waiting to be read.
+		 */
+		bool cancelLoad(const ResourceHandleBase& resource);
+
+		/**
+		 * Cancels all asynchronous loads of the specified priority class whose files haven't started being read yet.
+		 *
+		 * @see		cancelLoad
+		 */
+		void cancelLoads(ResourceLoadPriority priority);
+
+		/**
+		 * Returns information about the asynchronous loads performed since the last call to resetLoadStats(), such as the
+		 * number of finished loads and the disk throughput.
+		 */
+		ResourceLoadStats getLoadStats() const;
+
+		/** Resets the statistics returned by getLoadStats(), e.g. before starting a level load. */
+		void resetLoadStats();
 
 		/**
 		 * Releases an internal reference to the resource held by the resources system. This allows the resource to be 
@@ -246,6 +332,18 @@ namespace bs
 		 */
 		SPtr<ResourceManifest> getResourceManifest(const String& name) const;
 
+		/**
+		 * Registers a resource archive. Resources are looked up in registered archives before resource manifests, with
+		 * the most recently registered archive taking priority. This includes resources loaded by path, as long as a
+		 * registered manifest maps the path to a UUID, in which case the file at the path doesn't need to exist.
+		 *
+		 * @note	Resources loaded from an archive must not be saved using save(), as they have no file of their own.
+		 */
+		void registerResourceArchive(const SPtr<ResourceArchive>& archive);
+
+		/**	Unregisters a resource archive previously registered with registerResourceArchive(). */
+		void unregisterResourceArchive(const SPtr<ResourceArchive>& archive);
+
 		/** Attempts to retrieve file path from the provided UUID. Returns true if successful, false otherwise. */
 		bool getFilePathFromUUID(const String& uuid, Path& filePath) const;
 
@@ -304,18 +402,62 @@ namespace bs
 		/**
 		 * Starts resource loading or returns an already loaded resource. Both UUID and filePath must match the	same 
 		 * resource, although you may provide an empty path in which case the resource will be retrieved from memory if its
-		 * currently loaded.
+		 * currently loaded. If @p archive is provided the resource is read from the archive, and @p filePath must be the
+		 * path of the archive.
+		 */
+		HResource loadInternal(const String& UUID, const Path& filePath, const SPtr<ResourceArchive>& archive,
+			bool synchronous, ResourceLoadFlags loadFlags, ResourceLoadPriority priority);
+
+		/** Returns the most recently registered archive containing the resource with the provided UUID, or null. */
+		SPtr<ResourceArchive> findResourceArchive(const String& uuid) const;
+
+		/**
+		 * Performs actually reading and deserializing of the resource file. If @p memoryMap is true the file is mapped
+		 * into memory instead of being read through a file stream.
+		 */
+		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData, bool memoryMap);
+
+		/**
+		 * Deserializes a resource from the contents of a resource file. Called from various worker threads.
+		 *
+		 * @param[in]	fileStream			Stream containing the file contents, positioned at the start of the file.
+		 * @param[in]	filePath			Path of the resource file, used for error reporting.
+		 * @param[in]	loadWithSaveData	Should the resource keep its source data.
 		 */
-		HResource loadInternal(const String& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
+		SPtr<Resource> deserialize(const SPtr<DataStream>& fileStream, const Path& filePath, bool loadWithSaveData);
 
-		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
+		/**
+		 * Reads the meta-data at the start of a resource file, containing the resource dependencies. Returns null if
+		 * the meta-data cannot be read.
+		 */
+		SPtr<SavedResourceData> readMetaData(const SPtr<DataStream>& stream);
 
-		/**	Triggered when individual resource has finished loading. */
-		void loadComplete(HResource& resource);
+		/**
+		 * Records the dependencies of a resource once they are read from its file, and starts loading them if any of
+		 * the loads of the resource requested its dependencies. May be called from an I/O thread.
+		 */
+		void onDependenciesRead(HResource& resource, const Vector<String>& dependencies, bool synchronous,
+			ResourceLoadFlags loadFlags, ResourceLoadPriority priority);
 
-		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		/**
+		 * Registers the provided dependencies with an in-progress load, so it doesn't finish before the dependencies
+		 * do. Dependencies already registered with the load are skipped. Must be called with mMutex locked.
+		 */
+		void registerDependencies(ResourceLoadData* loadData, const Vector<String>& dependencies);
+
+		/** Returns an existing handle for the specified UUID if one exists, or creates a new one. Doesn't lock. */
+		HResource getOrCreateHandle(const String& uuid);
+
+		/**
+		 * Triggered when individual resource has finished loading, or when one of its dependencies has.
+		 *
+		 * @param[in]	resource		Handle of the resource.
+		 * @param[in]	dataLoaded		True if the resource data was read and deserialized, in which case the call
+		 *								finishes the load of the resource itself rather than one of its dependencies.
+		 * @param[in]	rawResource		Deserialized resource if @p dataLoaded is true. Null if the load failed or was
+		 *								cancelled.
+		 */
+		void loadComplete(HResource& resource, bool dataLoaded = false, const SPtr<Resource>& rawResource = nullptr);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
@@ -323,9 +465,14 @@ namespace bs
 	private:
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
+		Vector<SPtr<ResourceArchive>> mResourceArchives;
+		ResourceLoader* mLoader;
+
+		// Guards the manifest and archive lists, as dependencies of asynchronous loads are looked up on I/O threads
+		mutable Mutex mLookupMutex;
 
-		Mutex mInProgressResourcesMutex;
-		Mutex mLoadedResourceMutex;
+		// Guards the maps below. Single mutex so each step of a load takes one lock rather than several nested ones.
+		Mutex mMutex;
 
 		UnorderedMap<String, WeakResourceHandle<Resource>> mHandles;
 		UnorderedMap<String, LoadedResourceData> mLoadedResources;
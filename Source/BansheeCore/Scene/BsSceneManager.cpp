@@ -21,6 +21,15 @@ namespace bs
 		UninitializedList = 2
 	};
 
+	enum SceneActorType
+	{
+		RenderableActor = 0,
+		CameraActor = 1,
+		LightActor = 2,
+		ReflectionProbeActor = 3,
+		LightProbeVolumeActor = 4
+	};
+
 	SceneManager::SceneManager()
 	{
 		mRootNode = SceneObject::createInternal("SceneRoot");
@@ -82,37 +91,42 @@ namespace bs
 		mRootNode = root;
 		mRootNode->_setParent(HSceneObject());
 
+		_notifyHierarchyChanged();
+
 		oldRoot->destroy();
 	}
 
 	void SceneManager::_registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so)
 	{
-		mRenderables[renderable.get()] = SceneRenderableData(renderable, so);
+		removeSceneActor(mRenderables, &SceneRenderableData::renderable, renderable.get());
+		addSceneActor(mRenderables, SceneRenderableData(renderable, so), renderable.get(), RenderableActor);
 	}
 
 	void SceneManager::_unregisterRenderable(const SPtr<Renderable>& renderable)
 	{
-		mRenderables.erase(renderable.get());
+		removeSceneActor(mRenderables, &SceneRenderableData::renderable, renderable.get());
 	}
 
 	void SceneManager::_registerLight(const SPtr<Light>& light, const HSceneObject& so)
 	{
-		mLights[light.get()] = SceneLightData(light, so);
+		removeSceneActor(mLights, &SceneLightData::light, light.get());
+		addSceneActor(mLights, SceneLightData(light, so), light.get(), LightActor);
 	}
 
 	void SceneManager::_unregisterLight(const SPtr<Light>& light)
 	{
-		mLights.erase(light.get());
+		removeSceneActor(mLights, &SceneLightData::light, light.get());
 	}
 
 	void SceneManager::_registerCamera(const SPtr<Camera>& camera, const HSceneObject& so)
 	{
-		mCameras[camera.get()] = SceneCameraData(camera, so);
+		removeSceneActor(mCameras, &SceneCameraData::camera, camera.get());
+		addSceneActor(mCameras, SceneCameraData(camera, so), camera.get(), CameraActor);
 	}
 
 	void SceneManager::_unregisterCamera(const SPtr<Camera>& camera)
 	{
-		mCameras.erase(camera.get());
+		removeSceneActor(mCameras, &SceneCameraData::camera, camera.get());
 
 		auto iterFind = std::find_if(mMainCameras.begin(), mMainCameras.end(),
 			[&](const SceneCameraData& x)
@@ -126,22 +140,96 @@ namespace bs
 
 	void SceneManager::_registerReflectionProbe(const SPtr<ReflectionProbe>& probe, const HSceneObject& so)
 	{
-		mReflectionProbes[probe.get()] = SceneReflectionProbeData(probe, so);
+		removeSceneActor(mReflectionProbes, &SceneReflectionProbeData::probe, probe.get());
+		addSceneActor(mReflectionProbes, SceneReflectionProbeData(probe, so), probe.get(), ReflectionProbeActor);
 	}
 
 	void SceneManager::_unregisterReflectionProbe(const SPtr<ReflectionProbe>& probe)
 	{
-		mReflectionProbes.erase(probe.get());
+		removeSceneActor(mReflectionProbes, &SceneReflectionProbeData::probe, probe.get());
 	}
 
 	void SceneManager::_registerLightProbeVolume(const SPtr<LightProbeVolume>& volume, const HSceneObject& so)
 	{
-		mLightProbeVolumes[volume.get()] = SceneLightProbeVolumeData(volume, so);
+		removeSceneActor(mLightProbeVolumes, &SceneLightProbeVolumeData::volume, volume.get());
+		addSceneActor(mLightProbeVolumes, SceneLightProbeVolumeData(volume, so), volume.get(), LightProbeVolumeActor);
 	}
 
 	void SceneManager::_unregisterLightProbeVolume(const SPtr<LightProbeVolume>& volume)
 	{
-		mLightProbeVolumes.erase(volume.get());
+		removeSceneActor(mLightProbeVolumes, &SceneLightProbeVolumeData::volume, volume.get());
+	}
+
+	template<class T>
+	void SceneManager::addSceneActor(Vector<T>& actors, const T& data, void* actor, UINT32 type)
+	{
+		UINT32 idx = (UINT32)actors.size();
+		actors.push_back(data);
+
+		UINT32 id = encodeActorId(idx, type);
+		mActorIds[actor] = id;
+
+		// Make sure the actor gets synced with its scene object on the next update
+		const HSceneObject& so = data.sceneObject;
+		if (!so.isDestroyed())
+		{
+			so->mSceneActorIds.push_back(id);
+			_notifySceneActorsDirty(so);
+		}
+	}
+
+	template<class T, class P>
+	void SceneManager::removeSceneActor(Vector<T>& actors, SPtr<P> T::*actorField, void* actor)
+	{
+		auto iterFind = mActorIds.find(actor);
+		if (iterFind == mActorIds.end())
+			return;
+
+		UINT32 id = iterFind->second;
+		mActorIds.erase(iterFind);
+
+		UINT32 idx;
+		UINT32 type;
+		decodeActorId(id, idx, type);
+
+		assert((actors[idx].*actorField).get() == actor);
+
+		const HSceneObject& so = actors[idx].sceneObject;
+		if (!so.isDestroyed())
+		{
+			Vector<UINT32>& soActorIds = so->mSceneActorIds;
+
+			auto iterFindId = std::find(soActorIds.begin(), soActorIds.end(), id);
+			if (iterFindId != soActorIds.end())
+			{
+				std::swap(*iterFindId, soActorIds.back());
+				soActorIds.erase(soActorIds.end() - 1);
+			}
+		}
+
+		UINT32 lastIdx = (UINT32)actors.size() - 1;
+		if (idx != lastIdx)
+		{
+			std::swap(actors[idx], actors[lastIdx]);
+
+			// Update the id of the actor we just swapped
+			UINT32 oldId = encodeActorId(lastIdx, type);
+			UINT32 newId = encodeActorId(idx, type);
+
+			mActorIds[(actors[idx].*actorField).get()] = newId;
+
+			const HSceneObject& movedSO = actors[idx].sceneObject;
+			if (!movedSO.isDestroyed())
+			{
+				Vector<UINT32>& soActorIds = movedSO->mSceneActorIds;
+
+				auto iterFindId = std::find(soActorIds.begin(), soActorIds.end(), oldId);
+				if (iterFindId != soActorIds.end())
+					*iterFindId = newId;
+			}
+		}
+
+		actors.erase(actors.end() - 1);
 	}
 
 	void SceneManager::_notifyMainCameraStateChanged(const SPtr<Camera>& camera)
@@ -156,7 +244,17 @@ namespace bs
 		if (camera->isMain())
 		{
 			if (iterFind == mMainCameras.end())
-				mMainCameras.push_back(mCameras[camera.get()]);
+			{
+				auto iterFindId = mActorIds.find(camera.get());
+				if (iterFindId != mActorIds.end())
+				{
+					UINT32 idx;
+					UINT32 type;
+					decodeActorId(iterFindId->second, idx, type);
+
+					mMainCameras.push_back(mCameras[idx]);
+				}
+			}
 
 			viewport->setTarget(mMainRT);
 		}
@@ -170,95 +268,140 @@ namespace bs
 		}
 	}
 
-	void SceneManager::_updateCoreObjectTransforms()
+	void SceneManager::_notifySceneActorsDirty(const HSceneObject& so)
 	{
-		for (auto& renderablePair : mRenderables)
-		{
-			SPtr<Renderable> renderable = renderablePair.second.renderable;
-			HSceneObject so = renderablePair.second.sceneObject;
+		if (so->mSceneActorsDirty)
+			return;
 
-			if (so->getMobility() != renderable->getMobility())
-				renderable->setMobility(so->getMobility());
+		so->mSceneActorsDirty = true;
+		mDirtySceneObjects.push_back(so);
+	}
 
-			renderable->_updateTransform(so);
+	void SceneManager::setBatchedTransformUpdates(bool enabled)
+	{
+		if (mBatchedTransformUpdates == enabled)
+			return;
 
-			if (so->getActive() != renderable->getIsActive())
-				renderable->setIsActive(so->getActive());
-		}
+		mBatchedTransformUpdates = enabled;
+		mTransformHierarchy.clear();
+	}
+
+	void SceneManager::_notifyTransformDirty(const SceneObject* so)
+	{
+		if (mBatchedTransformUpdates)
+			mTransformHierarchy.notifyTransformChanged(so);
+	}
 
-		for (auto& cameraPair : mCameras)
+	void SceneManager::_notifyHierarchyChanged()
+	{
+		if (mBatchedTransformUpdates)
+			mTransformHierarchy.notifyHierarchyChanged();
+	}
+
+	void SceneManager::_updateCoreObjectTransforms()
+	{
+		if (mBatchedTransformUpdates)
+			mTransformHierarchy.update(mRootNode);
+
+		for (auto& so : mDirtySceneObjects)
 		{
-			SPtr<Camera> handler = cameraPair.second.camera;
-			HSceneObject so = cameraPair.second.sceneObject;
+			if (so.isDestroyed())
+				continue;
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != handler->_getLastModifiedHash())
+			so->mSceneActorsDirty = false;
+			for (auto& id : so->mSceneActorIds)
 			{
-				handler->setPosition(so->getWorldPosition());
-				handler->setRotation(so->getWorldRotation());
+				UINT32 idx;
+				UINT32 type;
+				decodeActorId(id, idx, type);
 
-				handler->_setLastModifiedHash(curHash);
-			}
+				switch (type)
+				{
+				case RenderableActor:
+				{
+					SPtr<Renderable> renderable = mRenderables[idx].renderable;
 
-			if (so->getActive() != handler->getIsActive())
-			{
-				handler->setIsActive(so->getActive());
-			}
-		}
+					if (so->getMobility() != renderable->getMobility())
+						renderable->setMobility(so->getMobility());
 
-		for (auto& lightPair : mLights)
-		{
-			SPtr<Light> handler = lightPair.second.light;
-			HSceneObject so = lightPair.second.sceneObject;
+					renderable->_updateTransform(so);
 
-			if (so->getMobility() != handler->getMobility())
-				handler->setMobility(so->getMobility());
+					if (so->getActive() != renderable->getIsActive())
+						renderable->setIsActive(so->getActive());
+				}
+					break;
+				case CameraActor:
+				{
+					SPtr<Camera> handler = mCameras[idx].camera;
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != handler->_getLastModifiedHash())
-			{
-				handler->setPosition(so->getWorldPosition());
-				handler->setRotation(so->getWorldRotation());
+					UINT32 curHash = so->getTransformHash();
+					if (curHash != handler->_getLastModifiedHash())
+					{
+						handler->setPosition(so->getWorldPosition());
+						handler->setRotation(so->getWorldRotation());
 
-				handler->_setLastModifiedHash(curHash);
-			}
+						handler->_setLastModifiedHash(curHash);
+					}
 
-			if (so->getActive() != handler->getIsActive())
-			{
-				handler->setIsActive(so->getActive());
-			}
-		}
+					if (so->getActive() != handler->getIsActive())
+						handler->setIsActive(so->getActive());
+				}
+					break;
+				case LightActor:
+				{
+					SPtr<Light> handler = mLights[idx].light;
 
-		for (auto& probePair : mReflectionProbes)
-		{
-			SPtr<ReflectionProbe> probe = probePair.second.probe;
-			HSceneObject so = probePair.second.sceneObject;
+					if (so->getMobility() != handler->getMobility())
+						handler->setMobility(so->getMobility());
 
-			UINT32 curHash = so->getTransformHash();
-			if (curHash != probe->_getLastModifiedHash())
-			{
-				probe->setPosition(so->getWorldPosition());
-				probe->setRotation(so->getWorldRotation());
+					UINT32 curHash = so->getTransformHash();
+					if (curHash != handler->_getLastModifiedHash())
+					{
+						handler->setPosition(so->getWorldPosition());
+						handler->setRotation(so->getWorldRotation());
 
-				probe->_setLastModifiedHash(curHash);
-			}
+						handler->_setLastModifiedHash(curHash);
+					}
 
-			if (so->getActive() != probe->getIsActive())
-			{
-				probe->setIsActive(so->getActive());
-			}
-		}
+					if (so->getActive() != handler->getIsActive())
+						handler->setIsActive(so->getActive());
+				}
+					break;
+				case ReflectionProbeActor:
+				{
+					SPtr<ReflectionProbe> probe = mReflectionProbes[idx].probe;
 
-		for (auto& volumePair : mLightProbeVolumes)
-		{
-			SPtr<LightProbeVolume> volume = volumePair.second.volume;
-			HSceneObject so = volumePair.second.sceneObject;
+					UINT32 curHash = so->getTransformHash();
+					if (curHash != probe->_getLastModifiedHash())
+					{
+						probe->setPosition(so->getWorldPosition());
+						probe->setRotation(so->getWorldRotation());
+
+						probe->_setLastModifiedHash(curHash);
+					}
+
+					if (so->getActive() != probe->getIsActive())
+						probe->setIsActive(so->getActive());
+				}
+					break;
+				case LightProbeVolumeActor:
+				{
+					SPtr<LightProbeVolume> volume = mLightProbeVolumes[idx].volume;
 
-			volume->_updateTransform(so);
+					volume->_updateTransform(so);
 
-			if (so->getActive() != volume->getIsActive())
-				volume->setIsActive(so->getActive());
+					if (so->getActive() != volume->getIsActive())
+						volume->setIsActive(so->getActive());
+				}
+					break;
+				default:
+					assert(false);
+					break;
+				}
+			}
 		}
+
+		mDirtySceneObjects.clear();
 	}
 
 	SceneCameraData SceneManager::getMainCamera() const
@@ -574,6 +717,19 @@ namespace bs
 		type = id >> 30;
 	}
 
+	UINT32 SceneManager::encodeActorId(UINT32 idx, UINT32 type)
+	{
+		assert(idx <= (0x1FFFFFFF));
+
+		return (type << 29) | idx;
+	}
+
+	void SceneManager::decodeActorId(UINT32 id, UINT32& idx, UINT32& type)
+	{
+		idx = id & 0x1FFFFFFF;
+		type = id >> 29;
+	}
+
 	void SceneManager::_update()
 	{
 		// Note: Eventually perform updates based on component types and/or on component priority. Right now we just
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Scene/BsGameObject.h"
+#include "Scene/BsTransformHierarchy.h"
 
 namespace bs
 {
@@ -112,7 +113,7 @@ namespace bs
 		bool isRunning() const { return mComponentState == ComponentState::Running; }
 
 		/** Returns all cameras in the scene. */
-		const Map<Camera*, SceneCameraData>& getAllCameras() const { return mCameras; }
+		const Vector<SceneCameraData>& getAllCameras() const { return mCameras; }
 
 		/**
 		 * Returns the camera in the scene marked as main. Main camera controls the final render surface that is displayed
@@ -126,8 +127,18 @@ namespace bs
 		 */
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
+		/**
+		 * Determines should world transforms of all modified scene objects be recomputed in a single batched pass before
+		 * core object transforms are updated, instead of lazily when first requested. Batched updates are significantly
+		 * faster for scenes with a large number of moving objects.
+		 */
+		void setBatchedTransformUpdates(bool enabled);
+
+		/** @copydoc setBatchedTransformUpdates */
+		bool getBatchedTransformUpdates() const { return mBatchedTransformUpdates; }
+
 		/**	Returns all renderables in the scene. */
-		const Map<Renderable*, SceneRenderableData>& getAllRenderables() const { return mRenderables; }
+		const Vector<SceneRenderableData>& getAllRenderables() const { return mRenderables; }
 
 		/** Notifies the scene manager that a new renderable was created. */
 		void _registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so);
@@ -168,9 +179,25 @@ namespace bs
 		/** Called every frame. Calls update methods on all scene objects and their components. */
 		void _update();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates transforms, mobility and active state of any core objects tied with scene objects that were modified
+		 * since the last call.
+		 */
 		void _updateCoreObjectTransforms();
 
+		/** 
+		 * Notifies the manager that the transform, mobility or active state of a scene object with registered cameras,
+		 * renderables, lights or probes changed. Those objects will be updated on the next call to 
+		 * _updateCoreObjectTransforms().
+		 */
+		void _notifySceneActorsDirty(const HSceneObject& so);
+
+		/** Notifies the manager that the local transform of a scene object in the scene hierarchy changed. */
+		void _notifyTransformDirty(const SceneObject* so);
+
+		/** Notifies the manager that a scene object was added to, removed from, or moved within the scene hierarchy. */
+		void _notifyHierarchyChanged();
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -226,16 +253,54 @@ namespace bs
 		/** Decodes an id encoded with encodeComponentId(). */
 		void decodeComponentId(UINT32 id, UINT32& idx, UINT32& type);
 
+		/** 
+		 * Adds a new scene actor (camera, renderable, light or probe) to the end of the provided actor list and binds it
+		 * to its scene object.
+		 *
+		 * @param[in]	actors	List of actors of the same type as the actor being added.
+		 * @param[in]	data	Actor data, including the scene object the actor is bound to.
+		 * @param[in]	actor	Pointer to the actor, used for identifying it on removal.
+		 * @param[in]	type	Type of the actor, determining which actor list does the actor belong to.
+		 */
+		template<class T>
+		void addSceneActor(Vector<T>& actors, const T& data, void* actor, UINT32 type);
+
+		/** 
+		 * Removes a scene actor added by addSceneActor(). The last actor in the list is moved in its place, keeping the
+		 * list dense. Does nothing if the actor isn't registered.
+		 *
+		 * @param[in]	actors		List the actor was added to.
+		 * @param[in]	actorField	Field of the actor data containing the actor.
+		 * @param[in]	actor		Pointer to the actor to remove.
+		 */
+		template<class T, class P>
+		void removeSceneActor(Vector<T>& actors, SPtr<P> T::*actorField, void* actor);
+
+		/** 
+		 * Encodes an index and a type of a scene actor into a single 32-bit integer. Top 3 bits represent the type, while
+		 * the rest represent the index.
+		 */
+		UINT32 encodeActorId(UINT32 idx, UINT32 type);
+
+		/** Decodes an id encoded with encodeActorId(). */
+		void decodeActorId(UINT32 id, UINT32& idx, UINT32& type);
+
 	protected:
 		HSceneObject mRootNode;
 
-		Map<Camera*, SceneCameraData> mCameras;
+		Vector<SceneCameraData> mCameras;
 		Vector<SceneCameraData> mMainCameras;
 
-		Map<Renderable*, SceneRenderableData> mRenderables;
-		Map<Light*, SceneLightData> mLights;
-		Map<ReflectionProbe*, SceneReflectionProbeData> mReflectionProbes;
-		Map<LightProbeVolume*, SceneLightProbeVolumeData> mLightProbeVolumes;
+		Vector<SceneRenderableData> mRenderables;
+		Vector<SceneLightData> mLights;
+		Vector<SceneReflectionProbeData> mReflectionProbes;
+		Vector<SceneLightProbeVolumeData> mLightProbeVolumes;
+
+		UnorderedMap<void*, UINT32> mActorIds;
+		Vector<HSceneObject> mDirtySceneObjects;
+
+		TransformHierarchy mTransformHierarchy;
+		bool mBatchedTransformUpdates = false;
 
 		Vector<HComponent> mActiveComponents;
 		Vector<HComponent> mInactiveComponents;
@@ -18,8 +18,8 @@ namespace bs
 		: GameObject(), mPrefabHash(0), mFlags(flags), mPosition(Vector3::ZERO), mRotation(Quaternion::IDENTITY)
 		, mScale(Vector3::ONE), mWorldPosition(Vector3::ZERO), mWorldRotation(Quaternion::IDENTITY)
 		, mWorldScale(Vector3::ONE), mCachedLocalTfrm(Matrix4::IDENTITY), mCachedWorldTfrm(Matrix4::IDENTITY)
-		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
-		, mMobility(ObjectMobility::Movable)
+		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mSceneActorsDirty(false), mTransformIdx((UINT32)-1)
+		, mActiveSelf(true), mActiveHierarchy(true), mMobility(ObjectMobility::Movable)
 	{
 		setName(name);
 	}
@@ -460,8 +460,13 @@ namespace bs
 		{
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
+
+			if (mTransformIdx != (UINT32)-1 && SceneManager::isStarted())
+				gSceneManager()._notifyTransformDirty(this);
 		}
 
+		notifySceneActorsDirty();
+
 		// Only send component flags if we haven't removed them all
 		if (componentFlags != 0)
 		{
@@ -485,6 +490,20 @@ namespace bs
 		}
 	}
 
+	void SceneObject::notifySceneActorsDirty() const
+	{
+		if (mSceneActorIds.empty() || mSceneActorsDirty)
+			return;
+
+		gSceneManager()._notifySceneActorsDirty(mThisHandle);
+	}
+
+	void SceneObject::notifyHierarchyChanged() const
+	{
+		if (mTransformIdx != (UINT32)-1 && SceneManager::isStarted())
+			gSceneManager()._notifyHierarchyChanged();
+	}
+
 	void SceneObject::updateWorldTfrm() const
 	{
 		// Don't allow movement from parent when not movable
@@ -614,6 +633,7 @@ namespace bs
 	void SceneObject::addChild(const HSceneObject& object)
 	{
 		mChildren.push_back(object); 
+		notifyHierarchyChanged();
 
 		object->_setFlags(mFlags);
 	}
@@ -623,7 +643,10 @@ namespace bs
 		auto result = find(mChildren.begin(), mChildren.end(), object);
 
 		if(result != mChildren.end())
+		{
 			mChildren.erase(result);
+			notifyHierarchyChanged();
+		}
 		else
 		{
 			BS_EXCEPT(InternalErrorException, 
@@ -689,6 +712,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			notifySceneActorsDirty();
 
 			if (triggerEvents)
 			{
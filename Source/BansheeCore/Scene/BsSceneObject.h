@@ -43,6 +43,7 @@ namespace bs
 		};
 
 		friend class SceneManager;
+		friend class TransformHierarchy;
 		friend class Prefab;
 		friend class PrefabDiff;
 		friend class PrefabUtility;
@@ -358,6 +359,10 @@ namespace bs
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
 
+		Vector<UINT32> mSceneActorIds;
+		mutable bool mSceneActorsDirty;
+		UINT32 mTransformIdx;
+
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
 		 * 
@@ -365,6 +370,18 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/** 
+		 * Notifies the scene manager that cameras, renderables, lights or probes bound to this object need to be updated.
+		 * Does nothing if no such objects are bound.
+		 */
+		void notifySceneActorsDirty() const;
+
+		/** 
+		 * Notifies the scene manager that this object was added, removed or moved within the scene hierarchy. Does nothing
+		 * if this object isn't part of the scene hierarchy.
+		 */
+		void notifyHierarchyChanged() const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
@@ -0,0 +1,390 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Scene/BsTransformHierarchy.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+
+#if BS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace bs
+{
+	const UINT32 TransformHierarchy::PARALLEL_THRESHOLD = 4096;
+	const UINT32 TransformHierarchy::PARALLEL_GRANULARITY = 512;
+
+	static const UINT32 INVALID_INDEX = (UINT32)-1;
+
+#if BS_SSE2
+	/** Multiplies four pairs of quaternions at once. Equivalent to Quaternion::operator*(). */
+	static void multiply4(const __m128 (&a)[4], const __m128 (&b)[4], __m128 (&output)[4])
+	{
+		const __m128& ax = a[0]; const __m128& ay = a[1]; const __m128& az = a[2]; const __m128& aw = a[3];
+		const __m128& bx = b[0]; const __m128& by = b[1]; const __m128& bz = b[2]; const __m128& bw = b[3];
+
+		output[3] = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)),
+			_mm_mul_ps(az, bz));
+		output[0] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)),
+			_mm_mul_ps(az, by));
+		output[1] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)),
+			_mm_mul_ps(ax, bz));
+		output[2] = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)),
+			_mm_mul_ps(ay, bx));
+	}
+
+	/** Converts four quaternions into 3x3 rotation matrices at once. Equivalent to Quaternion::toRotationMatrix(). */
+	static void toRotationMatrix4(const __m128 (&q)[4], __m128 (&output)[3][3])
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128 tx = _mm_add_ps(q[0], q[0]);
+		__m128 ty = _mm_add_ps(q[1], q[1]);
+		__m128 tz = _mm_add_ps(q[2], q[2]);
+		__m128 twx = _mm_mul_ps(tx, q[3]);
+		__m128 twy = _mm_mul_ps(ty, q[3]);
+		__m128 twz = _mm_mul_ps(tz, q[3]);
+		__m128 txx = _mm_mul_ps(tx, q[0]);
+		__m128 txy = _mm_mul_ps(ty, q[0]);
+		__m128 txz = _mm_mul_ps(tz, q[0]);
+		__m128 tyy = _mm_mul_ps(ty, q[1]);
+		__m128 tyz = _mm_mul_ps(tz, q[1]);
+		__m128 tzz = _mm_mul_ps(tz, q[2]);
+
+		output[0][0] = _mm_sub_ps(one, _mm_add_ps(tyy, tzz));
+		output[0][1] = _mm_sub_ps(txy, twz);
+		output[0][2] = _mm_add_ps(txz, twy);
+		output[1][0] = _mm_add_ps(txy, twz);
+		output[1][1] = _mm_sub_ps(one, _mm_add_ps(txx, tzz));
+		output[1][2] = _mm_sub_ps(tyz, twx);
+		output[2][0] = _mm_sub_ps(txz, twy);
+		output[2][1] = _mm_add_ps(tyz, twx);
+		output[2][2] = _mm_sub_ps(one, _mm_add_ps(txx, tyy));
+	}
+#endif
+
+	TransformHierarchy::TransformHierarchy()
+		:mHierarchyDirty(true), mAnyDirty(false), mParallel(true)
+	{ }
+
+	void TransformHierarchy::clear()
+	{
+		mObjects.clear();
+		mParents.clear();
+		mLevelOffsets.clear();
+		mDirty.clear();
+		mDirtyIndices.clear();
+
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			mWorldPosition[i].clear();
+			mWorldScale[i].clear();
+		}
+
+		for (UINT32 i = 0; i < 4; i++)
+			mWorldRotation[i].clear();
+
+		mHierarchyDirty = true;
+		mAnyDirty = false;
+	}
+
+	void TransformHierarchy::notifyTransformChanged(const SceneObject* so)
+	{
+		// Whole hierarchy will be updated after it is rebuilt anyway
+		if (mHierarchyDirty)
+			return;
+
+		// Object might have been removed from the hierarchy since its index was assigned
+		UINT32 idx = so->mTransformIdx;
+		if (idx >= (UINT32)mObjects.size() || mObjects[idx] != so)
+			return;
+
+		mDirty[idx] = 1;
+		mAnyDirty = true;
+	}
+
+	void TransformHierarchy::rebuild(const HSceneObject& root)
+	{
+		mObjects.clear();
+		mParents.clear();
+		mLevelOffsets.clear();
+
+		if (root != nullptr && !root.isDestroyed())
+		{
+			mObjects.push_back(root.get());
+			mParents.push_back(INVALID_INDEX);
+		}
+
+		UINT32 levelStart = 0;
+		while (levelStart < (UINT32)mObjects.size())
+		{
+			mLevelOffsets.push_back(levelStart);
+
+			UINT32 levelEnd = (UINT32)mObjects.size();
+			for (UINT32 i = levelStart; i < levelEnd; i++)
+			{
+				SceneObject* so = mObjects[i];
+				so->mTransformIdx = i;
+
+				for (auto& child : so->mChildren)
+				{
+					mObjects.push_back(child.get());
+					mParents.push_back(i);
+				}
+			}
+
+			levelStart = levelEnd;
+		}
+
+		UINT32 numObjects = (UINT32)mObjects.size();
+		mLevelOffsets.push_back(numObjects);
+
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			mWorldPosition[i].resize(numObjects);
+			mWorldScale[i].resize(numObjects);
+		}
+
+		for (UINT32 i = 0; i < 4; i++)
+			mWorldRotation[i].resize(numObjects);
+
+		// Objects may have moved around in the arrays, so everything needs to be recomputed
+		mDirty.assign(numObjects, 1);
+		mAnyDirty = true;
+
+		mHierarchyDirty = false;
+	}
+
+	void TransformHierarchy::update(const HSceneObject& root)
+	{
+		if (mHierarchyDirty)
+			rebuild(root);
+
+		if (!mAnyDirty)
+			return;
+
+		UINT32 numLevels = (UINT32)mLevelOffsets.size() - 1;
+		for (UINT32 level = 0; level < numLevels; level++)
+		{
+			// Propagate dirty flags from the previous level, and find all objects that need updating
+			mDirtyIndices.clear();
+			for (UINT32 i = mLevelOffsets[level]; i < mLevelOffsets[level + 1]; i++)
+			{
+				UINT32 parent = mParents[i];
+				if (parent != INVALID_INDEX && mDirty[parent])
+					mDirty[i] = 1;
+
+				if (mDirty[i])
+					mDirtyIndices.push_back(i);
+			}
+
+			// All objects in a level only depend on objects in the previous level, so they can be processed in parallel
+			UINT32 numDirty = (UINT32)mDirtyIndices.size();
+			if (mParallel && numDirty >= PARALLEL_THRESHOLD)
+			{
+				const UINT32* indices = mDirtyIndices.data();
+				TaskScheduler::instance().parallelFor(0, numDirty, PARALLEL_GRANULARITY,
+					[this, indices](UINT32 chunkBegin, UINT32 chunkEnd)
+				{
+					updateTransforms(indices + chunkBegin, chunkEnd - chunkBegin);
+				});
+			}
+			else
+				updateTransforms(mDirtyIndices.data(), numDirty);
+		}
+
+		memset(mDirty.data(), 0, mDirty.size());
+		mAnyDirty = false;
+	}
+
+	void TransformHierarchy::updateTransforms(const UINT32* indices, UINT32 count)
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		for (; (i + 4) <= count; i += 4)
+		{
+			// Gather local transforms of four objects, and world transforms of their parents. Parents of root and
+			// immovable objects are treated as identity.
+			float localPos[3][4], localRot[4][4], localScale[3][4];
+			float parentPos[3][4], parentRot[4][4], parentScale[3][4];
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				UINT32 idx = indices[i + j];
+				const SceneObject* so = mObjects[idx];
+
+				localPos[0][j] = so->mPosition.x;
+				localPos[1][j] = so->mPosition.y;
+				localPos[2][j] = so->mPosition.z;
+
+				localRot[0][j] = so->mRotation.x;
+				localRot[1][j] = so->mRotation.y;
+				localRot[2][j] = so->mRotation.z;
+				localRot[3][j] = so->mRotation.w;
+
+				localScale[0][j] = so->mScale.x;
+				localScale[1][j] = so->mScale.y;
+				localScale[2][j] = so->mScale.z;
+
+				UINT32 parent = mParents[idx];
+				if (parent != INVALID_INDEX && so->mMobility == ObjectMobility::Movable)
+				{
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						parentPos[k][j] = mWorldPosition[k][parent];
+						parentScale[k][j] = mWorldScale[k][parent];
+					}
+
+					for (UINT32 k = 0; k < 4; k++)
+						parentRot[k][j] = mWorldRotation[k][parent];
+				}
+				else
+				{
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						parentPos[k][j] = 0.0f;
+						parentScale[k][j] = 1.0f;
+						parentRot[k][j] = 0.0f;
+					}
+
+					parentRot[3][j] = 1.0f;
+				}
+			}
+
+			__m128 pRot[4];
+			__m128 lRot[4];
+			for (UINT32 k = 0; k < 4; k++)
+			{
+				pRot[k] = _mm_loadu_ps(parentRot[k]);
+				lRot[k] = _mm_loadu_ps(localRot[k]);
+			}
+
+			__m128 wRot[4];
+			multiply4(pRot, lRot, wRot);
+
+			__m128 wScale[3];
+			__m128 scaledPos[3];
+			for (UINT32 k = 0; k < 3; k++)
+			{
+				__m128 pScale = _mm_loadu_ps(parentScale[k]);
+
+				wScale[k] = _mm_mul_ps(pScale, _mm_loadu_ps(localScale[k]));
+				scaledPos[k] = _mm_mul_ps(pScale, _mm_loadu_ps(localPos[k]));
+			}
+
+			// Rotate the scaled local position by the parent rotation, and offset by parent position
+			__m128 pRotMat[3][3];
+			toRotationMatrix4(pRot, pRotMat);
+
+			__m128 wPos[3];
+			for (UINT32 k = 0; k < 3; k++)
+			{
+				__m128 rotated = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pRotMat[k][0], scaledPos[0]),
+					_mm_mul_ps(pRotMat[k][1], scaledPos[1])), _mm_mul_ps(pRotMat[k][2], scaledPos[2]));
+
+				wPos[k] = _mm_add_ps(rotated, _mm_loadu_ps(parentPos[k]));
+			}
+
+			// Build the world matrices, equivalent to Matrix4::setTRS()
+			__m128 wRotMat[3][3];
+			toRotationMatrix4(wRot, wRotMat);
+
+			__m128 rows[3][4];
+			for (UINT32 k = 0; k < 3; k++)
+			{
+				rows[k][0] = _mm_mul_ps(wScale[0], wRotMat[k][0]);
+				rows[k][1] = _mm_mul_ps(wScale[1], wRotMat[k][1]);
+				rows[k][2] = _mm_mul_ps(wScale[2], wRotMat[k][2]);
+				rows[k][3] = wPos[k];
+
+				// Transpose so each register holds a full matrix row of a single object
+				_MM_TRANSPOSE4_PS(rows[k][0], rows[k][1], rows[k][2], rows[k][3]);
+			}
+
+			// Scatter the results
+			float worldPos[3][4], worldRot[4][4], worldScale[3][4];
+			for (UINT32 k = 0; k < 3; k++)
+			{
+				_mm_storeu_ps(worldPos[k], wPos[k]);
+				_mm_storeu_ps(worldScale[k], wScale[k]);
+			}
+
+			for (UINT32 k = 0; k < 4; k++)
+				_mm_storeu_ps(worldRot[k], wRot[k]);
+
+			const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				UINT32 idx = indices[i + j];
+				SceneObject* so = mObjects[idx];
+
+				for (UINT32 k = 0; k < 3; k++)
+				{
+					mWorldPosition[k][idx] = worldPos[k][j];
+					mWorldScale[k][idx] = worldScale[k][j];
+				}
+
+				for (UINT32 k = 0; k < 4; k++)
+					mWorldRotation[k][idx] = worldRot[k][j];
+
+				so->mWorldPosition = Vector3(worldPos[0][j], worldPos[1][j], worldPos[2][j]);
+				so->mWorldRotation = Quaternion(worldRot[3][j], worldRot[0][j], worldRot[1][j], worldRot[2][j]);
+				so->mWorldScale = Vector3(worldScale[0][j], worldScale[1][j], worldScale[2][j]);
+
+				Matrix4& matrix = so->mCachedWorldTfrm;
+				_mm_storeu_ps(&matrix[0].x, rows[0][j]);
+				_mm_storeu_ps(&matrix[1].x, rows[1][j]);
+				_mm_storeu_ps(&matrix[2].x, rows[2][j]);
+				_mm_storeu_ps(&matrix[3].x, lastRow);
+
+				so->mDirtyFlags &= ~SceneObject::WorldTfrmDirty;
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			UINT32 idx = indices[i];
+			const SceneObject* so = mObjects[idx];
+
+			UINT32 parent = mParents[idx];
+			if (parent != INVALID_INDEX && so->mMobility == ObjectMobility::Movable)
+			{
+				Vector3 parentPos(mWorldPosition[0][parent], mWorldPosition[1][parent], mWorldPosition[2][parent]);
+				Quaternion parentRot(mWorldRotation[3][parent], mWorldRotation[0][parent], mWorldRotation[1][parent],
+					mWorldRotation[2][parent]);
+				Vector3 parentScale(mWorldScale[0][parent], mWorldScale[1][parent], mWorldScale[2][parent]);
+
+				Vector3 position = parentRot.rotate(parentScale * so->mPosition) + parentPos;
+				writeTransform(idx, position, parentRot * so->mRotation, parentScale * so->mScale);
+			}
+			else
+				writeTransform(idx, so->mPosition, so->mRotation, so->mScale);
+		}
+	}
+
+	void TransformHierarchy::writeTransform(UINT32 idx, const Vector3& position, const Quaternion& rotation,
+		const Vector3& scale)
+	{
+		mWorldPosition[0][idx] = position.x;
+		mWorldPosition[1][idx] = position.y;
+		mWorldPosition[2][idx] = position.z;
+
+		mWorldRotation[0][idx] = rotation.x;
+		mWorldRotation[1][idx] = rotation.y;
+		mWorldRotation[2][idx] = rotation.z;
+		mWorldRotation[3][idx] = rotation.w;
+
+		mWorldScale[0][idx] = scale.x;
+		mWorldScale[1][idx] = scale.y;
+		mWorldScale[2][idx] = scale.z;
+
+		SceneObject* so = mObjects[idx];
+		so->mWorldPosition = position;
+		so->mWorldRotation = rotation;
+		so->mWorldScale = scale;
+		so->mCachedWorldTfrm.setTRS(position, rotation, scale);
+
+		so->mDirtyFlags &= ~SceneObject::WorldTfrmDirty;
+	}
+}
@@ -0,0 +1,85 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Keeps track of transforms of all scene objects in a scene hierarchy, sorted by their depth in the hierarchy and
+	 * stored in contiguous arrays. Allows world transforms of all modified scene objects to be recomputed in a single
+	 * batched pass, one hierarchy level at a time, instead of lazily on a per-object basis.
+	 *
+	 * Scene objects remain the owners of their local transforms. Results of the batched pass are written back into
+	 * cached world transforms of the scene objects, so that scene object transform getters can return them without
+	 * any further computation.
+	 */
+	class BS_CORE_EXPORT TransformHierarchy
+	{
+	public:
+		TransformHierarchy();
+
+		/**
+		 * Recomputes world transforms of all scene objects whose transform was modified since the last call, as well as
+		 * of all their descendants.
+		 *
+		 * @param[in]	root	Root of the scene object hierarchy to update.
+		 */
+		void update(const HSceneObject& root);
+
+		/** Notifies the system that the local transform of the provided scene object was modified. */
+		void notifyTransformChanged(const SceneObject* so);
+
+		/**
+		 * Notifies the system that the structure of the hierarchy was changed (objects were added, removed or
+		 * re-parented). Hierarchy will be rebuilt on the next call to update().
+		 */
+		void notifyHierarchyChanged() { mHierarchyDirty = true; }
+
+		/**
+		 * Determines should the world transforms of hierarchy levels with a large number of modified objects be computed
+		 * on multiple threads, using the task scheduler.
+		 */
+		void setParallel(bool parallel) { mParallel = parallel; }
+
+		/** Clears all tracked objects. */
+		void clear();
+
+	private:
+		/** Rebuilds the depth-sorted object arrays by walking the hierarchy breadth-first, starting at the root. */
+		void rebuild(const HSceneObject& root);
+
+		/**
+		 * Computes world transforms of the objects at the provided indices, and writes them to the world transform
+		 * streams, as well as to the scene objects. Parents of all the objects must have up-to-date world transforms.
+		 */
+		void updateTransforms(const UINT32* indices, UINT32 count);
+
+		/** Writes the provided world transform to the world transform streams and to the scene object at @p idx. */
+		void writeTransform(UINT32 idx, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+		static const UINT32 PARALLEL_THRESHOLD;
+		static const UINT32 PARALLEL_GRANULARITY;
+
+		Vector<SceneObject*> mObjects;
+		Vector<UINT32> mParents;
+		Vector<UINT32> mLevelOffsets;
+		Vector<UINT8> mDirty;
+		Vector<UINT32> mDirtyIndices;
+
+		Vector<float> mWorldPosition[3];
+		Vector<float> mWorldRotation[4];
+		Vector<float> mWorldScale[3];
+
+		bool mHierarchyDirty;
+		bool mAnyDirty;
+		bool mParallel;
+	};
+
+	/** @} */
+}
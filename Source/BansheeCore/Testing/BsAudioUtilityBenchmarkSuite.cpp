@@ -0,0 +1,167 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsAudioUtilityBenchmarkSuite.h"
+#include "Audio/BsAudioUtility.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Ten seconds of stereo audio at 48kHz. */
+	static const UINT32 NUM_FRAMES = 480000;
+	static const UINT32 NUM_CHANNELS = 2;
+	static const UINT32 NUM_SAMPLES = NUM_FRAMES * NUM_CHANNELS;
+	static const UINT32 NUM_RUNS = 20;
+
+	static const UINT32 BIT_DEPTHS[] = { 8, 16, 24, 32 };
+
+	/** Generates interleaved stereo samples of a sine wave at the provided bit depth. */
+	static Vector<UINT8> createSamples(UINT32 bitDepth)
+	{
+		Vector<float> floatSamples(NUM_SAMPLES);
+		for (UINT32 i = 0; i < NUM_SAMPLES; i++)
+			floatSamples[i] = 0.8f * Math::sin((i / NUM_CHANNELS) * 0.0576f + (i % NUM_CHANNELS) * 0.5f);
+
+		Vector<UINT8> samples(NUM_SAMPLES * (bitDepth / 8));
+		AudioUtility::convertFromFloat(floatSamples.data(), samples.data(), bitDepth, NUM_SAMPLES);
+
+		return samples;
+	}
+
+	AudioUtilityBenchmarkSuite::AudioUtilityBenchmarkSuite()
+	{
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkConvertBitDepth);
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkConvertToFloat);
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkConvertFromFloat);
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkConvertToMono);
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkInterleave);
+		BS_ADD_TEST(AudioUtilityBenchmarkSuite::BenchmarkMix);
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkConvertBitDepth()
+	{
+		for (auto inBitDepth : BIT_DEPTHS)
+		{
+			Vector<UINT8> input = createSamples(inBitDepth);
+
+			for (auto outBitDepth : BIT_DEPTHS)
+			{
+				if (inBitDepth == outBitDepth)
+					continue;
+
+				Vector<UINT8> output(NUM_SAMPLES * (outBitDepth / 8));
+				measure(toString(inBitDepth) + " to " + toString(outBitDepth) + " bits", NUM_RUNS, NUM_SAMPLES, [&]()
+				{
+					AudioUtility::convertBitDepth(input.data(), inBitDepth, output.data(), outBitDepth, NUM_SAMPLES);
+				});
+			}
+		}
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkConvertToFloat()
+	{
+		Vector<float> output(NUM_SAMPLES);
+		for (auto bitDepth : BIT_DEPTHS)
+		{
+			Vector<UINT8> input = createSamples(bitDepth);
+
+			measure(toString(bitDepth) + " bits", NUM_RUNS, NUM_SAMPLES, [&]()
+			{
+				AudioUtility::convertToFloat(input.data(), bitDepth, output.data(), NUM_SAMPLES);
+			});
+		}
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkConvertFromFloat()
+	{
+		Vector<float> input(NUM_SAMPLES);
+		AudioUtility::convertToFloat(createSamples(32).data(), 32, input.data(), NUM_SAMPLES);
+
+		for (auto bitDepth : BIT_DEPTHS)
+		{
+			Vector<UINT8> output(NUM_SAMPLES * (bitDepth / 8));
+			measure(toString(bitDepth) + " bits", NUM_RUNS, NUM_SAMPLES, [&]()
+			{
+				AudioUtility::convertFromFloat(input.data(), output.data(), bitDepth, NUM_SAMPLES);
+			});
+		}
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkConvertToMono()
+	{
+		for (auto bitDepth : BIT_DEPTHS)
+		{
+			Vector<UINT8> input = createSamples(bitDepth);
+			Vector<UINT8> output(NUM_FRAMES * (bitDepth / 8));
+
+			measure(toString(bitDepth) + " bits", NUM_RUNS, NUM_SAMPLES, [&]()
+			{
+				AudioUtility::convertToMono(input.data(), output.data(), bitDepth, NUM_FRAMES, NUM_CHANNELS);
+			});
+		}
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkInterleave()
+	{
+		// Per-channel 32-bit samples, as output by the FLAC decoder
+		Vector<INT32> channelSamples[NUM_CHANNELS];
+		const INT32* channels[NUM_CHANNELS];
+		for (UINT32 i = 0; i < NUM_CHANNELS; i++)
+		{
+			channelSamples[i].resize(NUM_FRAMES);
+			for (UINT32 j = 0; j < NUM_FRAMES; j++)
+				channelSamples[i][j] = (INT32)(30000.0f * Math::sin(j * 0.0576f + i * 0.5f));
+
+			channels[i] = channelSamples[i].data();
+		}
+
+		for (auto bitDepth : BIT_DEPTHS)
+		{
+			Vector<UINT8> output(NUM_SAMPLES * (bitDepth / 8));
+			measure(toString(bitDepth) + " bits", NUM_RUNS, NUM_SAMPLES, [&]()
+			{
+				AudioUtility::interleave(channels, output.data(), bitDepth, NUM_CHANNELS, NUM_FRAMES);
+			});
+		}
+
+		Vector<float> interleaved(NUM_SAMPLES);
+		AudioUtility::convertToFloat(createSamples(16).data(), 16, interleaved.data(), NUM_SAMPLES);
+
+		Vector<float> floatChannelSamples[NUM_CHANNELS];
+		float* floatChannels[NUM_CHANNELS];
+		for (UINT32 i = 0; i < NUM_CHANNELS; i++)
+		{
+			floatChannelSamples[i].resize(NUM_FRAMES);
+			floatChannels[i] = floatChannelSamples[i].data();
+		}
+
+		measure("Deinterleave, float", NUM_RUNS, NUM_SAMPLES, [&]()
+		{
+			AudioUtility::deinterleave(interleaved.data(), floatChannels, NUM_CHANNELS, NUM_FRAMES);
+		});
+
+		measure("Interleave, float", NUM_RUNS, NUM_SAMPLES, [&]()
+		{
+			AudioUtility::interleave(floatChannels, interleaved.data(), NUM_CHANNELS, NUM_FRAMES);
+		});
+	}
+
+	void AudioUtilityBenchmarkSuite::BenchmarkMix()
+	{
+		Vector<float> input(NUM_SAMPLES);
+		AudioUtility::convertToFloat(createSamples(16).data(), 16, input.data(), NUM_SAMPLES);
+
+		Vector<float> output = input;
+
+		// Gains alternate so the samples stay in range over all the runs
+		float gain = 0.5f;
+		measure("Apply gain", NUM_RUNS, NUM_SAMPLES, [&]()
+		{
+			AudioUtility::applyGain(output.data(), gain, NUM_SAMPLES);
+		}, [&]() { gain = 1.0f / gain; });
+
+		measure("Mix", NUM_RUNS, NUM_SAMPLES, [&]()
+		{
+			AudioUtility::mix(input.data(), output.data(), gain, NUM_SAMPLES);
+		}, [&]() { gain = -gain; });
+	}
+}
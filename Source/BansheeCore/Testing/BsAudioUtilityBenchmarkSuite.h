@@ -0,0 +1,41 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/** Measures throughput of the AudioUtility sample conversion, interleaving and mixing methods. */
+	class AudioUtilityBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		AudioUtilityBenchmarkSuite();
+
+	private:
+		/** Converts samples between every pair of supported integer bit depths. */
+		void BenchmarkConvertBitDepth();
+
+		/** Converts integer samples of every supported bit depth to floating point samples. */
+		void BenchmarkConvertToFloat();
+
+		/** Converts floating point samples to integer samples of every supported bit depth. */
+		void BenchmarkConvertFromFloat();
+
+		/** Downmixes stereo samples of every supported bit depth to mono. */
+		void BenchmarkConvertToMono();
+
+		/** Interleaves per-channel decoder output and splits interleaved samples back into channels. */
+		void BenchmarkInterleave();
+
+		/** Applies gain to a set of samples and mixes it into another. */
+		void BenchmarkMix();
+	};
+
+	/** @} */
+}
@@ -0,0 +1,90 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsCommandQueueBenchmarkSuite.h"
+#include "CoreThread/BsCommandQueue.h"
+#include "Threading/BsThreadPool.h"
+
+namespace bs
+{
+	static const UINT32 NUM_COMMANDS = 1000000;
+	static const UINT32 NUM_RUNS = 10;
+
+	/** Number of commands queued between flushes, when commands are being executed on another thread. */
+	static const UINT32 COMMANDS_PER_FLUSH = 64;
+
+	CommandQueueBenchmarkSuite::CommandQueueBenchmarkSuite()
+	{
+		BS_ADD_TEST(CommandQueueBenchmarkSuite::BenchmarkQueue);
+		BS_ADD_TEST(CommandQueueBenchmarkSuite::BenchmarkPlayback);
+		BS_ADD_TEST(CommandQueueBenchmarkSuite::BenchmarkConcurrentPlayback);
+	}
+
+	void CommandQueueBenchmarkSuite::BenchmarkQueue()
+	{
+		CommandQueue<CommandQueueSync> queue(BS_THREAD_CURRENT_ID);
+		UINT64 numExecuted = 0;
+
+		measure("Queue", NUM_RUNS, NUM_COMMANDS, [&]()
+		{
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+				queue.queue([&numExecuted]() { numExecuted++; });
+
+			queue.flush();
+		}, [&]() { queue.playback(); });
+
+		queue.playback();
+		BS_TEST_ASSERT(numExecuted == (UINT64)NUM_COMMANDS * NUM_RUNS);
+	}
+
+	void CommandQueueBenchmarkSuite::BenchmarkPlayback()
+	{
+		CommandQueue<CommandQueueSync> queue(BS_THREAD_CURRENT_ID);
+		UINT64 numExecuted = 0;
+
+		measure("Playback", NUM_RUNS, NUM_COMMANDS, [&]()
+		{
+			queue.playback();
+		}, [&]()
+		{
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+				queue.queue([&numExecuted]() { numExecuted++; });
+
+			queue.flush();
+		});
+
+		BS_TEST_ASSERT(numExecuted == (UINT64)NUM_COMMANDS * NUM_RUNS);
+	}
+
+	void CommandQueueBenchmarkSuite::BenchmarkConcurrentPlayback()
+	{
+		CommandQueue<CommandQueueSync> queue(BS_THREAD_CURRENT_ID);
+		UINT64 numExecuted = 0;
+
+		// Time is measured from the first queued command until the executing thread runs the last one
+		measure("Queue and playback on another thread", NUM_RUNS, NUM_COMMANDS, [&]()
+		{
+			bool done = false;
+			HThread consumer = ThreadPool::instance().run("CommandQueueBenchmark", [&]()
+			{
+				while (!done)
+					queue.playback();
+			});
+
+			for (UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				queue.queue([&numExecuted]() { numExecuted++; });
+
+				if ((i % COMMANDS_PER_FLUSH) == (COMMANDS_PER_FLUSH - 1))
+					queue.flush();
+			}
+
+			// Only touched by the executing thread, so it doesn't need to be synchronized
+			queue.queue([&done]() { done = true; });
+			queue.flush();
+
+			consumer.blockUntilComplete();
+		});
+
+		BS_TEST_ASSERT(numExecuted == (UINT64)NUM_COMMANDS * NUM_RUNS);
+	}
+}
@@ -0,0 +1,32 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/** Measures the cost of queuing and executing large numbers of trivial commands through a CommandQueue. */
+	class CommandQueueBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		CommandQueueBenchmarkSuite();
+
+	private:
+		/** Queues and flushes commands, with nothing executing them in the meantime. */
+		void BenchmarkQueue();
+
+		/** Executes commands that were queued and flushed beforehand. */
+		void BenchmarkPlayback();
+
+		/** Queues commands while another thread executes them, the same way the core thread executes its commands. */
+		void BenchmarkConcurrentPlayback();
+	};
+
+	/** @} */
+}
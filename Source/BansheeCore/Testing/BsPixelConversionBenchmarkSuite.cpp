@@ -0,0 +1,67 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsPixelConversionBenchmarkSuite.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsColor.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Large enough for the conversion to be split between multiple jobs, if more than one worker is available. */
+	static const UINT32 IMAGE_SIZE = 512;
+	static const UINT32 NUM_RUNS = 10;
+
+	static const PixelFormat FORMATS[] =
+	{
+		PF_R8, PF_RG8, PF_RGB8, PF_BGR8, PF_RGBA8, PF_BGRA8,
+		PF_R16F, PF_RG16F, PF_RGBA16F,
+		PF_R32F, PF_RG32F, PF_RGB32F, PF_RGBA32F
+	};
+
+	PixelConversionBenchmarkSuite::PixelConversionBenchmarkSuite()
+	{
+		BS_ADD_TEST(PixelConversionBenchmarkSuite::BenchmarkConversion);
+	}
+
+	void PixelConversionBenchmarkSuite::BenchmarkConversion()
+	{
+		const UINT32 numPixels = IMAGE_SIZE * IMAGE_SIZE;
+
+		// Smooth gradients in all channels, so converted values cover the whole range of every format
+		Vector<Color> colors(numPixels);
+		for (UINT32 y = 0; y < IMAGE_SIZE; y++)
+		{
+			for (UINT32 x = 0; x < IMAGE_SIZE; x++)
+			{
+				float u = x / (float)(IMAGE_SIZE - 1);
+				float v = y / (float)(IMAGE_SIZE - 1);
+
+				colors[y * IMAGE_SIZE + x] = Color(u, v, 1.0f - u, 0.5f + 0.5f * Math::sin((u + v) * Math::PI * 4.0f));
+			}
+		}
+
+		PixelData reference(IMAGE_SIZE, IMAGE_SIZE, 1, PF_RGBA32F);
+		reference.allocateInternalBuffer();
+		reference.setColors(colors);
+
+		for (auto srcFormat : FORMATS)
+		{
+			PixelData src(IMAGE_SIZE, IMAGE_SIZE, 1, srcFormat);
+			src.allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(reference, src);
+
+			for (auto dstFormat : FORMATS)
+			{
+				if (srcFormat == dstFormat)
+					continue;
+
+				PixelData dst(IMAGE_SIZE, IMAGE_SIZE, 1, dstFormat);
+				dst.allocateInternalBuffer();
+
+				String name = PixelUtil::getFormatName(srcFormat) + " -> " + PixelUtil::getFormatName(dstFormat);
+				measure(name, NUM_RUNS, numPixels, [&]() { PixelUtil::bulkPixelConversion(src, dst); });
+			}
+		}
+	}
+}
@@ -0,0 +1,26 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/** Measures PixelUtil::bulkPixelConversion() between uncompressed pixel formats. */
+	class PixelConversionBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		PixelConversionBenchmarkSuite();
+
+	private:
+		/** Converts an image between every pair of formats with a specialized conversion kernel. */
+		void BenchmarkConversion();
+	};
+
+	/** @} */
+}
@@ -0,0 +1,183 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsResourceArchiveBenchmarkSuite.h"
+#include "Resources/BsResourceArchive.h"
+#include "Resources/BsSavedResourceData.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	static const UINT32 NUM_RESOURCES = 10000;
+	static const UINT32 NUM_WARM_RUNS = 5;
+	static const UINT32 NUM_COLD_RUNS = 3;
+
+	/** Generates a UUID formatted identifier from an index. Unlike random UUIDs this keeps the runs reproducible. */
+	static String createUUID(UINT32 idx)
+	{
+		UINT32 hashA = idx * 2654435761U;
+		UINT32 hashB = (idx ^ 0x5bd1e995) * 2246822519U;
+
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%08x-%04x-4%03x-8%03x-%08x%04x", hashA, idx & 0xFFFF, hashB & 0xFFF,
+			(hashB >> 12) & 0xFFF, hashA ^ hashB, (hashB >> 16) & 0xFFFF);
+
+		return buffer;
+	}
+
+	ResourceArchiveBenchmarkSuite::ResourceArchiveBenchmarkSuite()
+	{
+		BS_ADD_TEST(ResourceArchiveBenchmarkSuite::BenchmarkLooseFiles);
+		BS_ADD_TEST(ResourceArchiveBenchmarkSuite::BenchmarkArchive);
+	}
+
+	void ResourceArchiveBenchmarkSuite::startUp()
+	{
+		mDirectory = Path::combine(FileSystem::getTempDirectoryPath(), "BansheeBenchmarks/ResourceArchive/");
+		mArchivePath = Path::combine(mDirectory, "resources.archive");
+
+		if (FileSystem::exists(mDirectory))
+			FileSystem::remove(mDirectory);
+
+		FileSystem::createDir(mDirectory);
+
+		// Resource files use the same layout as ones saved by Resources::save(): metadata size, metadata, object size,
+		// object data. Object data is never decoded by the benchmarks, so it's just filler of varying size.
+		SavedResourceData metaData(Vector<String>(), true, 0);
+
+		MemorySerializer ms;
+		UINT32 metaDataSize = 0;
+		UINT8* metaDataBytes = ms.encode(&metaData, metaDataSize);
+
+		Vector<UINT8> objectData(2048);
+		for (UINT32 i = 0; i < (UINT32)objectData.size(); i++)
+			objectData[i] = (UINT8)(i * 31 + (i >> 3));
+
+		ResourceArchiveBuilder builder;
+		for (UINT32 i = 0; i < NUM_RESOURCES; i++)
+		{
+			String uuid = createUUID(i);
+			Path filePath = Path::combine(mDirectory, uuid + ".asset");
+
+			UINT32 objectSize = 256 + (i * 7919) % 1793;
+
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(filePath);
+			stream->write(&metaDataSize, sizeof(metaDataSize));
+			stream->write(metaDataBytes, metaDataSize);
+			stream->write(&objectSize, sizeof(objectSize));
+			stream->write(objectData.data(), objectSize);
+			stream->close();
+
+			builder.addFile(uuid, filePath);
+
+			mUUIDs.push_back(uuid);
+			mFilePaths.push_back(filePath);
+		}
+
+		bs_free(metaDataBytes);
+
+		BS_TEST_ASSERT(builder.build(mArchivePath));
+	}
+
+	void ResourceArchiveBenchmarkSuite::shutDown()
+	{
+		FileSystem::remove(mDirectory);
+	}
+
+	void ResourceArchiveBenchmarkSuite::BenchmarkLooseFiles()
+	{
+		UINT32 numRead = 0;
+		UINT32 checksum = 0;
+
+		auto readAll = [&]()
+		{
+			numRead = 0;
+			for (auto& filePath : mFilePaths)
+			{
+				if (!FileSystem::isFile(filePath))
+					continue;
+
+				SPtr<DataStream> fileStream = FileSystem::openFile(filePath, true);
+				MemoryDataStream data(fileStream);
+				fileStream->close();
+
+				checksum += touchPages(data.getPtr(), data.size());
+				numRead++;
+			}
+		};
+
+		auto evictAll = [&]()
+		{
+			for (auto& filePath : mFilePaths)
+				evictFromFileCache(filePath);
+		};
+
+		measure("Warm", NUM_WARM_RUNS, NUM_RESOURCES, readAll);
+		BS_TEST_ASSERT(numRead == NUM_RESOURCES);
+
+		if (evictFromFileCache(mFilePaths[0]))
+		{
+			measure("Cold", NUM_COLD_RUNS, NUM_RESOURCES, readAll, evictAll);
+			BS_TEST_ASSERT(numRead == NUM_RESOURCES);
+		}
+		else
+			report("Cold", "not supported on this platform");
+
+		BS_TEST_ASSERT(checksum != 0);
+	}
+
+	void ResourceArchiveBenchmarkSuite::BenchmarkArchive()
+	{
+		UINT32 numRead = 0;
+		UINT32 checksum = 0;
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool memoryMap = i == 1;
+
+			// Archive is re-opened every run, so the cost of reading its index is included
+			auto readAll = [&]()
+			{
+				numRead = 0;
+
+				SPtr<ResourceArchive> archive = ResourceArchive::open(mArchivePath);
+				if (archive == nullptr)
+					return;
+
+				for (auto& uuid : mUUIDs)
+				{
+					const ResourceArchive::Entry* entry = archive->findEntry(uuid);
+					if (entry == nullptr)
+						continue;
+
+					SPtr<DataStream> data = archive->readEntry(*entry, memoryMap);
+					SPtr<MemoryDataStream> memoryData = std::static_pointer_cast<MemoryDataStream>(data);
+
+					checksum += touchPages(memoryData->getPtr(), memoryData->size());
+					numRead++;
+				}
+			};
+
+			auto evictAll = [&]()
+			{
+				evictFromFileCache(mArchivePath);
+			};
+
+			String name = memoryMap ? "mapped" : "copied";
+
+			measure("Warm, " + name, NUM_WARM_RUNS, NUM_RESOURCES, readAll);
+			BS_TEST_ASSERT(numRead == NUM_RESOURCES);
+
+			if (evictFromFileCache(mArchivePath))
+			{
+				measure("Cold, " + name, NUM_COLD_RUNS, NUM_RESOURCES, readAll, evictAll);
+				BS_TEST_ASSERT(numRead == NUM_RESOURCES);
+			}
+			else
+				report("Cold, " + name, "not supported on this platform");
+		}
+
+		BS_TEST_ASSERT(checksum != 0);
+	}
+}
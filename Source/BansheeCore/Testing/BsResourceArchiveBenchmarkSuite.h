@@ -0,0 +1,43 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/**
+	 * Compares reading many small resources from separate resource files against reading them from a resource
+	 * archive, with the data both in and out of the OS file cache.
+	 */
+	class ResourceArchiveBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		ResourceArchiveBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Reads all resources from separate resource files, the same way Resources finds and opens them. */
+		void BenchmarkLooseFiles();
+
+		/** Reads all resources from a resource archive, both by copying and by memory mapping their data. */
+		void BenchmarkArchive();
+
+		Path mDirectory;
+		Path mArchivePath;
+		Vector<String> mUUIDs;
+		Vector<Path> mFilePaths;
+	};
+
+	/** @} */
+}
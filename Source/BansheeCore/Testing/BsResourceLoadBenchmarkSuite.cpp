@@ -0,0 +1,242 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsResourceLoadBenchmarkSuite.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsFileSerializer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+	#include <unistd.h>
+#endif
+
+namespace bs
+{
+	static const UINT32 NUM_FILES = 16;
+	static const UINT32 NUM_VERTICES = 250000;
+	static const UINT32 NUM_INDICES = 750000;
+	static const UINT32 NUM_WARM_RUNS = 5;
+	static const UINT32 NUM_COLD_RUNS = 3;
+
+	/**
+	 * Retrieves the amount of resident memory of the process, as well as the part of it that isn't backed by files,
+	 * in bytes. Returns false if not supported on the current platform.
+	 */
+	static bool getResidentMemory(UINT64& resident, UINT64& anonymous)
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		FILE* file = fopen("/proc/self/statm", "r");
+		if (file == nullptr)
+			return false;
+
+		unsigned long totalPages = 0;
+		unsigned long residentPages = 0;
+		unsigned long sharedPages = 0;
+		bool success = fscanf(file, "%lu %lu %lu", &totalPages, &residentPages, &sharedPages) == 3;
+		fclose(file);
+
+		UINT64 pageSize = (UINT64)sysconf(_SC_PAGESIZE);
+		resident = residentPages * pageSize;
+		anonymous = (residentPages - sharedPages) * pageSize;
+
+		return success;
+#else
+		return false;
+#endif
+	}
+
+	/** Converts a difference between two byte counts to a string in megabytes. */
+	static String toMegabytes(UINT64 after, UINT64 before)
+	{
+		StringStream output;
+		output << std::fixed << std::setprecision(1) << ((INT64)(after - before)) / (1024.0 * 1024.0) << " MB";
+
+		return output.str();
+	}
+
+	ResourceLoadBenchmarkSuite::ResourceLoadBenchmarkSuite()
+	{
+		BS_ADD_TEST(ResourceLoadBenchmarkSuite::BenchmarkLoad);
+		BS_ADD_TEST(ResourceLoadBenchmarkSuite::BenchmarkMemory);
+	}
+
+	void ResourceLoadBenchmarkSuite::startUp()
+	{
+		mDirectory = Path::combine(FileSystem::getTempDirectoryPath(), "BansheeBenchmarks/ResourceLoad/");
+
+		if (FileSystem::exists(mDirectory))
+			FileSystem::remove(mDirectory);
+
+		FileSystem::createDir(mDirectory);
+
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+
+		UINT32 vertexDataSize = vertexDesc->getVertexStride(0) * NUM_VERTICES;
+		for (UINT32 i = 0; i < NUM_FILES; i++)
+		{
+			SPtr<MeshData> meshData = MeshData::create(NUM_VERTICES, NUM_INDICES, vertexDesc);
+
+			UINT8* vertices = meshData->getElementData(VES_POSITION);
+			for (UINT32 j = 0; j < vertexDataSize; j++)
+				vertices[j] = (UINT8)(j * 31 + (j >> 7) + i);
+
+			UINT32* indices = meshData->getIndices32();
+			for (UINT32 j = 0; j < NUM_INDICES; j++)
+				indices[j] = (j * 7919 + i) % NUM_VERTICES;
+
+			// Same layout as the object data of files saved by Resources::save(): object size followed by the object
+			Path filePath = Path::combine(mDirectory, "MeshData" + toString(i) + ".asset");
+			{
+				FileEncoder encoder(filePath);
+				encoder.encode(meshData.get());
+			}
+
+			mFilePaths.push_back(filePath);
+		}
+	}
+
+	void ResourceLoadBenchmarkSuite::shutDown()
+	{
+		FileSystem::remove(mDirectory);
+	}
+
+	void ResourceLoadBenchmarkSuite::BenchmarkLoad()
+	{
+		UINT32 checksum = 0;
+
+		auto evictAll = [&]()
+		{
+			for (auto& filePath : mFilePaths)
+				evictFromFileCache(filePath);
+		};
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool memoryMap = i == 1;
+			String name = memoryMap ? "mapped" : "copied";
+
+			Vector<SPtr<MeshData>> meshData;
+			auto loadAndRead = [&]()
+			{
+				meshData = loadAll(memoryMap);
+				checksum += touchAll(meshData);
+			};
+
+			// Loaded data is released before the next run, outside of the measured time
+			auto release = [&]() { meshData.clear(); };
+
+			measure("Warm, " + name, NUM_WARM_RUNS, NUM_FILES, loadAndRead, release);
+
+			bool allLoaded = true;
+			for (auto& entry : meshData)
+				allLoaded &= entry != nullptr && entry->getNumVertices() == NUM_VERTICES;
+
+			BS_TEST_ASSERT(allLoaded);
+
+			// Mapped data is only read from the file when first accessed, so also measure the load alone
+			if (memoryMap)
+			{
+				measure("Warm, " + name + ", data not read", NUM_WARM_RUNS, NUM_FILES,
+					[&]() { meshData = loadAll(memoryMap); }, release);
+			}
+
+			if (evictFromFileCache(mFilePaths[0]))
+			{
+				measure("Cold, " + name, NUM_COLD_RUNS, NUM_FILES, loadAndRead, [&]()
+				{
+					release();
+					evictAll();
+				});
+			}
+			else
+				report("Cold, " + name, "not supported on this platform");
+		}
+
+		BS_TEST_ASSERT(checksum != 0);
+	}
+
+	void ResourceLoadBenchmarkSuite::BenchmarkMemory()
+	{
+		UINT64 startResident = 0;
+		UINT64 startAnonymous = 0;
+		if (!getResidentMemory(startResident, startAnonymous))
+		{
+			report("Resident memory", "not supported on this platform");
+			return;
+		}
+
+		UINT32 checksum = 0;
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool memoryMap = i == 1;
+			String name = memoryMap ? "Mapped" : "Copied";
+
+			Vector<SPtr<MeshData>> meshData = loadAll(memoryMap);
+
+			UINT64 resident = 0;
+			UINT64 anonymous = 0;
+			getResidentMemory(resident, anonymous);
+
+			report(name + ", after load", "resident +" + toMegabytes(resident, startResident) + ", not file backed +" +
+				toMegabytes(anonymous, startAnonymous));
+
+			checksum += touchAll(meshData);
+			getResidentMemory(resident, anonymous);
+
+			report(name + ", after reading all data", "resident +" + toMegabytes(resident, startResident) +
+				", not file backed +" + toMegabytes(anonymous, startAnonymous));
+		}
+
+		BS_TEST_ASSERT(checksum != 0);
+	}
+
+	Vector<SPtr<MeshData>> ResourceLoadBenchmarkSuite::loadAll(bool memoryMap) const
+	{
+		Vector<SPtr<MeshData>> output;
+		output.reserve(mFilePaths.size());
+
+		for (auto& filePath : mFilePaths)
+		{
+			SPtr<DataStream> stream;
+			if (memoryMap)
+				stream = FileSystem::openMappedFile(filePath);
+			else
+				stream = FileSystem::openFile(filePath, true);
+
+			if (stream == nullptr)
+			{
+				output.push_back(nullptr);
+				continue;
+			}
+
+			UINT32 objectSize = 0;
+			stream->read(&objectSize, sizeof(objectSize));
+
+			BinarySerializer bs;
+			output.push_back(std::static_pointer_cast<MeshData>(bs.decode(stream, objectSize)));
+		}
+
+		return output;
+	}
+
+	UINT32 ResourceLoadBenchmarkSuite::touchAll(const Vector<SPtr<MeshData>>& meshData)
+	{
+		UINT32 sum = 0;
+		for (auto& entry : meshData)
+		{
+			if (entry == nullptr)
+				continue;
+
+			UINT32 vertexDataSize = entry->getVertexDesc()->getVertexStride(0) * entry->getNumVertices();
+			sum += touchPages(entry->getElementData(VES_POSITION), vertexDataSize);
+			sum += touchPages((UINT8*)entry->getIndices32(), entry->getNumIndices() * sizeof(UINT32));
+		}
+
+		return sum;
+	}
+}
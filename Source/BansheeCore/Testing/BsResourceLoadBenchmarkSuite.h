@@ -0,0 +1,52 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/**
+	 * Compares loading large mesh data files by reading them into memory against loading them from memory mapped files,
+	 * both in load time and in memory use.
+	 */
+	class ResourceLoadBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		ResourceLoadBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Loads all files and reads all of their data, with the files both in and out of the OS file cache. */
+		void BenchmarkLoad();
+
+		/** Reports how much resident memory grows while all loaded files are kept in memory. */
+		void BenchmarkMemory();
+
+		/**
+		 * Loads all the mesh data files, the same way Resources loads resource data.
+		 *
+		 * @param[in]	memoryMap	If true the files are memory mapped, otherwise they are read into memory.
+		 * @return					Loaded mesh data, one entry per file, or null entries for files that failed to load.
+		 */
+		Vector<SPtr<MeshData>> loadAll(bool memoryMap) const;
+
+		/** Reads a byte from every page of the vertex and index data of all the provided mesh data. */
+		static UINT32 touchAll(const Vector<SPtr<MeshData>>& meshData);
+
+		Path mDirectory;
+		Vector<Path> mFilePaths;
+	};
+
+	/** @} */
+}
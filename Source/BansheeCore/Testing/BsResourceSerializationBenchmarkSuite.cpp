@@ -0,0 +1,168 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsResourceSerializationBenchmarkSuite.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationCurve.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Serialization/BsMemorySerializer.h"
+
+namespace bs
+{
+	static const UINT32 NUM_BONES = 100;
+	static const UINT32 NUM_KEYS = 301;
+	static const UINT32 NUM_VERTICES = 100000;
+	static const UINT32 NUM_INDICES = 300000;
+	static const UINT32 NUM_RUNS = 10;
+
+	/** Checks if both curves have the same keyframes. */
+	template<class T>
+	static bool compareCurves(const Vector<TNamedAnimationCurve<T>>& a, const Vector<TNamedAnimationCurve<T>>& b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (UINT32 i = 0; i < (UINT32)a.size(); i++)
+		{
+			const Vector<TKeyframe<T>>& keysA = a[i].curve.getKeyFrames();
+			const Vector<TKeyframe<T>>& keysB = b[i].curve.getKeyFrames();
+
+			if (a[i].name != b[i].name || keysA.size() != keysB.size())
+				return false;
+
+			for (UINT32 j = 0; j < (UINT32)keysA.size(); j++)
+			{
+				if (keysA[j].time != keysB[j].time || keysA[j].value != keysB[j].value ||
+					keysA[j].inTangent != keysB[j].inTangent || keysA[j].outTangent != keysB[j].outTangent)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	ResourceSerializationBenchmarkSuite::ResourceSerializationBenchmarkSuite()
+	{
+		BS_ADD_TEST(ResourceSerializationBenchmarkSuite::BenchmarkAnimationClip);
+		BS_ADD_TEST(ResourceSerializationBenchmarkSuite::BenchmarkMeshData);
+	}
+
+	void ResourceSerializationBenchmarkSuite::startUp()
+	{
+		// Animation clips are core objects, even though they have no core thread counterpart
+		CoreObjectManager::startUp();
+	}
+
+	void ResourceSerializationBenchmarkSuite::shutDown()
+	{
+		CoreObjectManager::shutDown();
+	}
+
+	void ResourceSerializationBenchmarkSuite::BenchmarkAnimationClip()
+	{
+		// Ten seconds of keys for every bone, baked at 30 frames per second like imported clips
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYS);
+			Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYS);
+			Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYS);
+
+			float frequency = 0.5f + i * 0.05f;
+			for (UINT32 j = 0; j < NUM_KEYS; j++)
+			{
+				float t = j / 30.0f;
+				float wave = Math::sin(t * frequency);
+
+				positionKeys[j].time = t;
+				positionKeys[j].value = Vector3(wave, Math::cos(t * frequency), 0.0f);
+				positionKeys[j].inTangent = Vector3(frequency, 0.0f, 0.0f);
+				positionKeys[j].outTangent = Vector3(frequency, 0.0f, 0.0f);
+
+				rotationKeys[j].time = t;
+				rotationKeys[j].value = Quaternion(Vector3::UNIT_Y, Radian(wave));
+				rotationKeys[j].inTangent = Quaternion::ZERO;
+				rotationKeys[j].outTangent = Quaternion::ZERO;
+
+				scaleKeys[j].time = t;
+				scaleKeys[j].value = Vector3::ONE * (1.0f + 0.1f * wave);
+				scaleKeys[j].inTangent = Vector3::ZERO;
+				scaleKeys[j].outTangent = Vector3::ZERO;
+			}
+
+			String name = "Bone" + toString(i);
+			curves->position.push_back(TNamedAnimationCurve<Vector3>(name, TAnimationCurve<Vector3>(positionKeys)));
+			curves->rotation.push_back(
+				TNamedAnimationCurve<Quaternion>(name, TAnimationCurve<Quaternion>(rotationKeys)));
+			curves->scale.push_back(TNamedAnimationCurve<Vector3>(name, TAnimationCurve<Vector3>(scaleKeys)));
+		}
+
+		SPtr<AnimationClip> clip = AnimationClip::_createPtr(curves, false, 30);
+		SPtr<AnimationClip> output = std::static_pointer_cast<AnimationClip>(
+			measureRoundTrip("Animation clip, 90k keyframes", clip.get(), NUM_BONES * NUM_KEYS * 3));
+
+		SPtr<AnimationCurves> outputCurves = output->getCurves();
+		bool matches = compareCurves(curves->position, outputCurves->position) &&
+			compareCurves(curves->rotation, outputCurves->rotation) && compareCurves(curves->scale, outputCurves->scale);
+
+		BS_TEST_ASSERT_MSG(matches, "Decoded animation curves don't match the encoded ones.");
+	}
+
+	void ResourceSerializationBenchmarkSuite::BenchmarkMeshData()
+	{
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+
+		SPtr<MeshData> meshData = MeshData::create(NUM_VERTICES, NUM_INDICES, vertexDesc);
+
+		// All elements are in a single stream, starting with the position
+		UINT8* vertices = meshData->getElementData(VES_POSITION);
+		UINT32 vertexDataSize = vertexDesc->getVertexStride(0) * NUM_VERTICES;
+		for (UINT32 i = 0; i < vertexDataSize; i++)
+			vertices[i] = (UINT8)(i * 31 + (i >> 7));
+
+		UINT32* indices = meshData->getIndices32();
+		for (UINT32 i = 0; i < NUM_INDICES; i++)
+			indices[i] = (i * 7919) % NUM_VERTICES;
+
+		SPtr<MeshData> output = std::static_pointer_cast<MeshData>(
+			measureRoundTrip("Mesh data, 100k vertices", meshData.get(), NUM_VERTICES));
+
+		bool matches = output->getNumVertices() == NUM_VERTICES && output->getNumIndices() == NUM_INDICES &&
+			memcmp(output->getElementData(VES_POSITION), vertices, vertexDataSize) == 0 &&
+			memcmp(output->getIndices32(), indices, NUM_INDICES * sizeof(UINT32)) == 0;
+
+		BS_TEST_ASSERT_MSG(matches, "Decoded mesh data doesn't match the encoded one.");
+	}
+
+	SPtr<IReflectable> ResourceSerializationBenchmarkSuite::measureRoundTrip(const String& name, IReflectable* object,
+		UINT64 numItems)
+	{
+		MemorySerializer serializer;
+		UINT8* buffer = nullptr;
+		UINT32 bufferSize = 0;
+
+		measure(name + ", encode", NUM_RUNS, numItems, [&]()
+		{
+			buffer = serializer.encode(object, bufferSize, (void*(*)(UINT32))&bs_alloc);
+		}, [&]()
+		{
+			if (buffer != nullptr)
+				bs_free(buffer);
+		});
+
+		report(name + ", encoded size", toString(bufferSize) + " bytes");
+
+		SPtr<IReflectable> output;
+		measure(name + ", decode", NUM_RUNS, numItems, [&]()
+		{
+			output = serializer.decode(buffer, bufferSize);
+		}, [&]() { output = nullptr; });
+
+		bs_free(buffer);
+		return output;
+	}
+}
@@ -0,0 +1,45 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/** Measures binary serialization round trips of resources that mostly consist of large arrays of plain data. */
+	class ResourceSerializationBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		ResourceSerializationBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Encodes and decodes an animation clip with baked keyframes for a hundred bones. */
+		void BenchmarkAnimationClip();
+
+		/** Encodes and decodes mesh data with positions, normals, texture coordinates and 32-bit indices. */
+		void BenchmarkMeshData();
+
+		/**
+		 * Encodes the provided object and decodes it back, measuring each step separately.
+		 *
+		 * @param[in]	name		Name of the serialized object, as displayed in the output.
+		 * @param[in]	object		Object to serialize.
+		 * @param[in]	numItems	Number of items (e.g. keyframes or vertices) in the object.
+		 * @return					Object decoded in the last run.
+		 */
+		SPtr<IReflectable> measureRoundTrip(const String& name, IReflectable* object, UINT64 numItems);
+	};
+
+	/** @} */
+}
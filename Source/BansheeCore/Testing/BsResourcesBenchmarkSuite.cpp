@@ -0,0 +1,151 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsResourcesBenchmarkSuite.h"
+#include "Resources/BsResources.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationCurve.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "Managers/BsResourceListenerManager.h"
+#include "FileSystem/BsFileSystem.h"
+
+namespace bs
+{
+	static const UINT32 NUM_RESOURCES = 20000;
+	static const UINT32 NUM_KEYS = 31;
+	static const UINT32 NUM_WARM_RUNS = 5;
+	static const UINT32 NUM_COLD_RUNS = 3;
+
+	ResourcesBenchmarkSuite::ResourcesBenchmarkSuite()
+	{
+		BS_ADD_TEST(ResourcesBenchmarkSuite::BenchmarkLevelLoad);
+	}
+
+	void ResourcesBenchmarkSuite::startUp()
+	{
+		CoreObjectManager::startUp();
+		Resources::startUp();
+		ResourceListenerManager::startUp();
+
+		mDirectory = Path::combine(FileSystem::getTempDirectoryPath(), "BansheeBenchmarks/Resources/");
+
+		if (FileSystem::exists(mDirectory))
+			FileSystem::remove(mDirectory);
+
+		FileSystem::createDir(mDirectory);
+
+		// Small animation clips stand in for the resources of a level. They need no GPU resources, so they can be
+		// loaded without a render API.
+		for (UINT32 i = 0; i < NUM_RESOURCES; i++)
+		{
+			Vector<TKeyframe<Vector3>> keys(NUM_KEYS);
+			for (UINT32 j = 0; j < NUM_KEYS; j++)
+			{
+				keys[j].time = j / 30.0f;
+				keys[j].value = Vector3((float)i, (float)j, 0.0f);
+				keys[j].inTangent = Vector3::ZERO;
+				keys[j].outTangent = Vector3::ZERO;
+			}
+
+			SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+			curves->position.push_back(TNamedAnimationCurve<Vector3>("Root", TAnimationCurve<Vector3>(keys)));
+
+			Path filePath = Path::combine(mDirectory, "Clip" + toString(i) + ".asset");
+
+			HAnimationClip clip = AnimationClip::create(curves);
+			gResources().save(clip, filePath, true);
+			mFilePaths.push_back(filePath);
+		}
+
+		ResourceListenerManager::instance().update();
+		gResources().unloadAllUnused();
+	}
+
+	void ResourcesBenchmarkSuite::shutDown()
+	{
+		FileSystem::remove(mDirectory);
+
+		ResourceListenerManager::shutDown();
+		Resources::shutDown();
+		CoreObjectManager::shutDown();
+	}
+
+	void ResourcesBenchmarkSuite::BenchmarkLevelLoad()
+	{
+		Vector<HResource> handles;
+		handles.reserve(NUM_RESOURCES);
+
+		auto loadAll = [&]()
+		{
+			for (auto& filePath : mFilePaths)
+				handles.push_back(gResources().loadAsync(filePath));
+
+			for (auto& handle : handles)
+				handle.blockUntilLoaded();
+		};
+
+		auto unloadAll = [&]()
+		{
+			handles.clear();
+
+			// Handles are signalled as loaded slightly before their load callbacks release their references
+			while (true)
+			{
+				ResourceLoadStats stats = gResources().getLoadStats();
+				if ((stats.numQueued + stats.numReading + stats.numDecoding) == 0)
+					break;
+
+				BS_THREAD_SLEEP(1);
+			}
+
+			// Loaded resources are referenced until their listeners are notified, which normally happens every frame
+			ResourceListenerManager::instance().update();
+			gResources().unloadAllUnused();
+			gResources().resetLoadStats();
+		};
+
+		auto checkLoaded = [&]()
+		{
+			bool allLoaded = handles.size() == NUM_RESOURCES;
+			for (auto& handle : handles)
+				allLoaded &= handle.isLoaded(false);
+
+			BS_TEST_ASSERT_MSG(allLoaded, "Not all resources were loaded.");
+		};
+
+		// Load statistics of the last run, e.g. to tell apart time spent reading files and time spent decoding them
+		auto reportStats = [&](const String& name)
+		{
+			ResourceLoadStats stats = gResources().getLoadStats();
+			BS_TEST_ASSERT_MSG(stats.numRequested == NUM_RESOURCES, "Resources weren't unloaded between runs.");
+
+			StringStream output;
+			output << std::fixed << std::setprecision(1) << stats.bytesRead / (1024.0 * 1024.0) << " MB read, "
+				<< stats.getReadThroughput() / (1024.0 * 1024.0) << " MB/s, read time " << stats.readTimeUs / 1000.0
+				<< " ms, decode time " << stats.decodeTimeUs / 1000.0 << " ms";
+
+			report(name + ", load statistics", output.str());
+		};
+
+		measure("Warm", NUM_WARM_RUNS, NUM_RESOURCES, loadAll, unloadAll);
+		checkLoaded();
+		reportStats("Warm");
+
+		if (evictFromFileCache(mFilePaths[0]))
+		{
+			measure("Cold", NUM_COLD_RUNS, NUM_RESOURCES, loadAll, [&]()
+			{
+				unloadAll();
+
+				for (auto& filePath : mFilePaths)
+					evictFromFileCache(filePath);
+			});
+
+			checkLoaded();
+			reportStats("Cold");
+		}
+		else
+			report("Cold", "not supported on this platform");
+
+		unloadAll();
+	}
+}
@@ -0,0 +1,38 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/**
+	 * Measures asynchronous loads of a large number of small resources through Resources, similar to loading a level,
+	 * with the resource files both in and out of the OS file cache.
+	 */
+	class ResourcesBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		ResourcesBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Queues asynchronous loads of all resources and waits until they all finish. */
+		void BenchmarkLevelLoad();
+
+		Path mDirectory;
+		Vector<Path> mFilePaths;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,216 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsSkeletonBenchmarkSuite.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationCurve.h"
+#include "Animation/BsCurveCache.h"
+
+namespace bs
+{
+	static const UINT32 NUM_BONES = 100;
+	static const UINT32 NUM_INSTANCES = 1000;
+	static const UINT32 NUM_CLIPS = 3;
+	static const UINT32 NUM_RUNS = 20;
+
+	/** Number of animation states evaluated per instance. First layer blends two clips, others add one clip each. */
+	static const UINT32 NUM_STATES = 4;
+	static const UINT32 NUM_LAYERS = 3;
+
+	/** Animation states and output poses of a single animated object. */
+	struct BenchmarkInstance
+	{
+		AnimationState states[NUM_STATES];
+		AnimationStateLayer layers[NUM_LAYERS];
+
+		Vector<TCurveCache<Vector3>> positionCaches;
+		Vector<TCurveCache<Quaternion>> rotationCaches;
+		Vector<TCurveCache<Vector3>> scaleCaches;
+
+		LocalSkeletonPose localPose;
+		Vector<Matrix4> pose;
+		float timeOffset = 0.0f;
+	};
+
+	/**
+	 * Creates a two second clip animating every bone, with keys baked at 30 frames per second like imported clips. Each
+	 * bone moves at a different frequency so neighbouring bones don't share key values.
+	 */
+	static SPtr<AnimationCurves> createClip(UINT32 clipIdx)
+	{
+		const UINT32 NUM_KEYS = 61;
+
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYS);
+			Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYS);
+			Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYS);
+
+			float frequency = 0.5f + i * 0.05f + clipIdx * 0.3f;
+			for (UINT32 j = 0; j < NUM_KEYS; j++)
+			{
+				float t = j / 30.0f;
+
+				positionKeys[j].time = t;
+				positionKeys[j].value = Vector3(Math::sin(t * frequency), Math::cos(t * frequency * 1.3f),
+					0.2f * Math::sin(t * 3.0f));
+
+				Vector3 axis = Vector3::normalize(Vector3(1.0f, Math::sin(t * 0.3f), 0.4f));
+				rotationKeys[j].time = t;
+				rotationKeys[j].value = Quaternion(axis, Radian(Math::sin(t * frequency) * 1.5f));
+
+				scaleKeys[j].time = t;
+				scaleKeys[j].value = Vector3::ONE * (1.0f + 0.1f * Math::sin(t * frequency));
+			}
+
+			// Finite difference tangents, same as the ones calculated on import
+			auto calculateTangents = [](auto& keys)
+			{
+				for (UINT32 j = 0; j < NUM_KEYS; j++)
+				{
+					UINT32 prev = j > 0 ? j - 1 : 0;
+					UINT32 next = std::min(j + 1, NUM_KEYS - 1);
+
+					auto tangent = (keys[next].value - keys[prev].value) * (1.0f / (keys[next].time - keys[prev].time));
+					keys[j].inTangent = tangent;
+					keys[j].outTangent = tangent;
+				}
+			};
+
+			calculateTangents(positionKeys);
+			calculateTangents(rotationKeys);
+			calculateTangents(scaleKeys);
+
+			String name = "Bone" + toString(i);
+			curves->position.push_back(TNamedAnimationCurve<Vector3>(name, TAnimationCurve<Vector3>(positionKeys)));
+			curves->rotation.push_back(
+				TNamedAnimationCurve<Quaternion>(name, TAnimationCurve<Quaternion>(rotationKeys)));
+			curves->scale.push_back(TNamedAnimationCurve<Vector3>(name, TAnimationCurve<Vector3>(scaleKeys)));
+		}
+
+		return curves;
+	}
+
+	SkeletonBenchmarkSuite::SkeletonBenchmarkSuite()
+	{
+		BS_ADD_TEST(SkeletonBenchmarkSuite::BenchmarkGetPose);
+	}
+
+	void SkeletonBenchmarkSuite::BenchmarkGetPose()
+	{
+		// Ten chains of ten bones, all attached to the first bone
+		Vector<BONE_DESC> bones(NUM_BONES);
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			bones[i].name = "Bone" + toString(i);
+			bones[i].parent = (i % 10) != 0 ? i - 1 : (i == 0 ? (UINT32)-1 : 0);
+			bones[i].invBindPose = Matrix4::translation(Vector3(0.0f, -(float)(i % 10), 0.0f));
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones.data(), NUM_BONES);
+		SkeletonMask mask(NUM_BONES);
+
+		SPtr<AnimationCurves> clips[NUM_CLIPS];
+		for (UINT32 i = 0; i < NUM_CLIPS; i++)
+			clips[i] = createClip(i);
+
+		// Every clip animates every bone, and bone indices match curve indices
+		Vector<AnimationCurveMapping> mapping(NUM_BONES);
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+			mapping[i] = { i, i, i };
+
+		const UINT32 stateClips[NUM_STATES] = { 0, 1, 2, 0 };
+		const float stateWeights[NUM_STATES] = { 0.7f, 0.3f, 0.5f, 0.25f };
+
+		Vector<BenchmarkInstance> instances(NUM_INSTANCES);
+		for (UINT32 i = 0; i < NUM_INSTANCES; i++)
+		{
+			BenchmarkInstance& instance = instances[i];
+			instance.positionCaches.resize(NUM_STATES * NUM_BONES);
+			instance.rotationCaches.resize(NUM_STATES * NUM_BONES);
+			instance.scaleCaches.resize(NUM_STATES * NUM_BONES);
+			instance.localPose = LocalSkeletonPose(NUM_BONES);
+			for (UINT32 j = 0; j < NUM_BONES; j++)
+				instance.localPose.hasOverride[j] = false;
+
+			instance.pose.resize(NUM_BONES);
+			instance.timeOffset = (i * 0.37f) - Math::floor(i * 0.37f / 2.0f) * 2.0f;
+
+			for (UINT32 j = 0; j < NUM_STATES; j++)
+			{
+				AnimationState& state = instance.states[j];
+				state.curves = clips[stateClips[j]];
+				state.boneToCurveMapping = mapping.data();
+				state.soToCurveMapping = nullptr;
+				state.positionCaches = &instance.positionCaches[j * NUM_BONES];
+				state.rotationCaches = &instance.rotationCaches[j * NUM_BONES];
+				state.scaleCaches = &instance.scaleCaches[j * NUM_BONES];
+				state.genericCaches = nullptr;
+				state.time = instance.timeOffset;
+				state.weight = stateWeights[j];
+				state.loop = true;
+				state.disabled = false;
+			}
+
+			instance.layers[0] = { &instance.states[0], 2, 0, false };
+			instance.layers[1] = { &instance.states[2], 1, 1, true };
+			instance.layers[2] = { &instance.states[3], 1, 2, true };
+		}
+
+		// Every run evaluates the next frame, at 60 frames per second
+		UINT32 frameIdx = 0;
+		auto advanceFrame = [&]()
+		{
+			frameIdx++;
+			for (auto& instance : instances)
+			{
+				for (auto& state : instance.states)
+					state.time = instance.timeOffset + frameIdx / 60.0f;
+			}
+		};
+
+		measure("100 bones, 3 layers, 1000 instances", NUM_RUNS, NUM_INSTANCES, [&]()
+		{
+			for (auto& instance : instances)
+				skeleton->getPose(instance.pose.data(), instance.localPose, mask, instance.layers, NUM_LAYERS);
+		}, advanceFrame);
+
+		// Repeatedly evaluating a single instance keeps its data in cache, showing the computation cost alone
+		BenchmarkInstance& firstInstance = instances[0];
+		measure("100 bones, 3 layers, single instance", NUM_RUNS * 50, 1, [&]()
+		{
+			skeleton->getPose(firstInstance.pose.data(), firstInstance.localPose, mask, firstInstance.layers,
+				NUM_LAYERS);
+		}, advanceFrame);
+
+		float checksum = 0.0f;
+		for (auto& instance : instances)
+			checksum += instance.pose[NUM_BONES - 1][0][3];
+
+		BS_TEST_ASSERT(!std::isnan(checksum));
+
+		// Same curve evaluations as above without blending, to tell apart the cost of sampling and of building the pose
+		measure("Curve sampling only", NUM_RUNS, NUM_INSTANCES, [&]()
+		{
+			for (auto& instance : instances)
+			{
+				for (auto& state : instance.states)
+				{
+					const AnimationCurves& curves = *state.curves;
+					for (UINT32 i = 0; i < NUM_BONES; i++)
+					{
+						Vector3 position = curves.evaluatePosition(i, state.time, state.positionCaches[i], true);
+						Quaternion rotation = curves.evaluateRotation(i, state.time, state.rotationCaches[i], true);
+						Vector3 scale = curves.evaluateScale(i, state.time, state.scaleCaches[i], true);
+
+						checksum += position.x + rotation.w + scale.y;
+					}
+				}
+			}
+		}, advanceFrame);
+
+		BS_TEST_ASSERT(!std::isnan(checksum));
+	}
+}
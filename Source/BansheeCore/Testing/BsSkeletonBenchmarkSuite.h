@@ -0,0 +1,26 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Core
+	 *  @{
+	 */
+
+	/** Measures evaluation of skeleton poses from multiple blended animation layers, for many animated instances. */
+	class SkeletonBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		SkeletonBenchmarkSuite();
+
+	private:
+		/** Samples and blends three animation layers for every instance, and calculates their final bone transforms. */
+		void BenchmarkGetPose();
+	};
+
+	/** @} */
+}
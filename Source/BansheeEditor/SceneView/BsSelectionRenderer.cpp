@@ -43,7 +43,7 @@ namespace bs
 		Vector<SPtr<ct::Renderable>> objects;
 
 		const Vector<HSceneObject>& sceneObjects = Selection::instance().getSceneObjects();
-		const Map<Renderable*, SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
+		const Vector<SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
 
 		for (auto& renderable : renderables)
 		{
@@ -52,11 +52,11 @@ namespace bs
 				if (!so->getActive())
 					continue;
 
-				if (renderable.second.sceneObject != so)
+				if (renderable.sceneObject != so)
 					continue;
 
-				if (renderable.first->getMesh().isLoaded())
-					objects.push_back(renderable.first->getCore());
+				if (renderable.renderable->getMesh().isLoaded())
+					objects.push_back(renderable.renderable->getCore());
 			}
 		}
 
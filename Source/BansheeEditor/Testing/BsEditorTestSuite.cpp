@@ -16,6 +16,17 @@
 #include "Allocators/BsFrameAlloc.h"
 #include "FileSystem/BsFileSystem.h"
 #include "Scene/BsSceneManager.h"
+#include "GUI/BsGUITexture.h"
+#include "GUI/BsGUILayoutData.h"
+#include "Physics/BsPhysicsCommon.h"
+#include "Resources/BsBuiltinResources.h"
+#include "Resources/BsResourceArchive.h"
+#include "FileSystem/BsDataStream.h"
+#include "Resources/BsResourceLoader.h"
+#include "Image/BsBlockCompression.h"
+#include "Image/BsPixelData.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
 
 namespace bs
 {
@@ -414,6 +425,13 @@ namespace bs
 		BS_ADD_TEST(EditorTestSuite::TestPrefabComplex);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabDiff);
 		BS_ADD_TEST(EditorTestSuite::TestFrameAlloc);
+		BS_ADD_TEST(EditorTestSuite::TestGUICachedGeometry);
+		BS_ADD_TEST(EditorTestSuite::TestResourceArchive);
+		BS_ADD_TEST(EditorTestSuite::TestPhysicsInterpolation);
+		BS_ADD_TEST(EditorTestSuite::TestResourceLoader);
+		BS_ADD_TEST(EditorTestSuite::TestSyncLoadDuringAsync);
+		BS_ADD_TEST(EditorTestSuite::TestBlockCompression);
+		BS_ADD_TEST(EditorTestSuite::TestCompressedAnimationCurves);
 	}
 
 	void EditorTestSuite::SceneObjectRecord_UndoRedo()
@@ -808,4 +826,793 @@ namespace bs
 		alloc.dealloc(a13);
 		alloc.clear();
 	}
-}
\ No newline at end of file
+
+	void EditorTestSuite::TestGUICachedGeometry()
+	{
+		GUIElement* texture = GUITexture::create(BuiltinResources::instance().getWhiteSpriteTexture(),
+			TextureScaleMode::StretchToFit);
+
+		GUILayoutData layoutData;
+		layoutData.area = Rect2I(0, 0, 32, 32);
+		layoutData.clipRect = layoutData.area;
+
+		texture->_setLayoutData(layoutData);
+		texture->_updateRenderElements();
+		texture->_updateCachedGeometry();
+
+		BS_TEST_ASSERT(texture->_getNumRenderElements() > 0);
+		BS_TEST_ASSERT(texture->_getCachedGeometry(0).numVertices > 0);
+
+		const Vector2* vertex = (const Vector2*)(texture->_getCachedVertices() +
+			texture->_getCachedGeometry(0).vertexOffset);
+		Vector2 oldPosition = *vertex;
+
+		// Move the element without changing its contents
+		UINT64 oldVersion = texture->_getRenderElementsVersion();
+
+		layoutData.area = Rect2I(100, 50, 32, 32);
+		layoutData.clipRect = layoutData.area;
+		texture->_setLayoutData(layoutData);
+
+		BS_TEST_ASSERT(texture->_getRenderElementsVersion() != oldVersion);
+
+		texture->_updateCachedGeometry();
+
+		vertex = (const Vector2*)(texture->_getCachedVertices() + texture->_getCachedGeometry(0).vertexOffset);
+		BS_TEST_ASSERT(Math::approxEquals(vertex->x, oldPosition.x + 100.0f));
+		BS_TEST_ASSERT(Math::approxEquals(vertex->y, oldPosition.y + 50.0f));
+
+		// Re-applying the same layout must keep the cached geometry
+		oldVersion = texture->_getRenderElementsVersion();
+		texture->_setLayoutData(layoutData);
+
+		BS_TEST_ASSERT(texture->_getRenderElementsVersion() == oldVersion);
+
+		GUIElement::destroy(texture);
+	}
+
+	void EditorTestSuite::TestResourceArchive()
+	{
+		HSceneObject root = SceneObject::create("root");
+		GameObjectHandle<TestComponentC> cmp = root->addComponent<TestComponentC>();
+		cmp->obj.strA = "archived";
+
+		Path tempDirectory = FileSystem::getTempDirectoryPath();
+		Path archivePath = Path::combine(tempDirectory, "testarchive.archive");
+		Path prefabPaths[] =
+		{
+			Path::combine(tempDirectory, "testarchive0.asset"),
+			Path::combine(tempDirectory, "testarchive1.asset")
+		};
+
+		// First resource file is saved uncompressed, second one compressed
+		String uuids[2];
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			HPrefab prefab = Prefab::create(root);
+			gResources().save(prefab, prefabPaths[i], true, i == 1);
+
+			uuids[i] = prefab.getUUID();
+		}
+
+		root->destroy();
+
+		// Prefabs must be loaded from the archive, not returned from memory
+		BS_TEST_ASSERT(!gResources().isLoaded(uuids[0]) && !gResources().isLoaded(uuids[1]));
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool compress = i == 1;
+
+			ResourceArchiveBuilder builder;
+			builder.addFile(uuids[0], prefabPaths[0], compress);
+			builder.addFile(uuids[1], prefabPaths[1], compress);
+
+			BS_TEST_ASSERT(builder.build(archivePath));
+
+			SPtr<ResourceArchive> archive = ResourceArchive::open(archivePath);
+			BS_TEST_ASSERT(archive != nullptr);
+			if (archive == nullptr)
+				continue;
+
+			BS_TEST_ASSERT(archive->getNumEntries() == 2);
+			BS_TEST_ASSERT(archive->findEntry("missing") == nullptr);
+
+			for (UINT32 j = 0; j < 2; j++)
+			{
+				const ResourceArchive::Entry* entry = archive->findEntry(uuids[j]);
+				BS_TEST_ASSERT(entry != nullptr);
+				if (entry == nullptr)
+					continue;
+
+				BS_TEST_ASSERT(entry->uuid == uuids[j]);
+				BS_TEST_ASSERT(archive->getDependencies(*entry) == gResources().getDependencies(prefabPaths[j]));
+
+				SPtr<DataStream> copiedData = archive->readEntry(*entry, false);
+				SPtr<DataStream> mappedData = archive->readEntry(*entry, true);
+
+				BS_TEST_ASSERT(!copiedData->isMemoryMapped() && copiedData->size() == entry->size);
+				BS_TEST_ASSERT(mappedData->isMemoryMapped() && mappedData->size() == entry->size);
+
+				UINT8* copiedBytes = std::static_pointer_cast<MemoryDataStream>(copiedData)->getPtr();
+				UINT8* mappedBytes = std::static_pointer_cast<MemoryDataStream>(mappedData)->getPtr();
+				BS_TEST_ASSERT(memcmp(copiedBytes, mappedBytes, (size_t)entry->size) == 0);
+
+				// Entries that aren't compressed by the builder are stored exactly as they were saved
+				if (!compress || j == 1)
+				{
+					MemoryDataStream fileData(FileSystem::openFile(prefabPaths[j]));
+
+					BS_TEST_ASSERT(fileData.size() == entry->size &&
+						memcmp(fileData.getPtr(), copiedBytes, fileData.size()) == 0);
+				}
+			}
+
+			gResources().registerResourceArchive(archive);
+
+			for (UINT32 j = 0; j < 2; j++)
+			{
+				// Cover both the copied and the memory mapped read paths
+				ResourceLoadFlags loadFlags = ResourceLoadFlag::Default;
+				if (compress)
+					loadFlags |= ResourceLoadFlag::MemoryMapFile;
+
+				HPrefab prefab = static_resource_cast<Prefab>(gResources().loadFromUUID(uuids[j], false, loadFlags));
+				BS_TEST_ASSERT(prefab.isLoaded());
+				if (!prefab.isLoaded())
+					continue;
+
+				HSceneObject instance = prefab->instantiate();
+				GameObjectHandle<TestComponentC> instanceCmp = instance->getComponent<TestComponentC>();
+				BS_TEST_ASSERT(instanceCmp != nullptr && instanceCmp->obj.strA == "archived");
+
+				instance->destroy();
+				gResources().release(prefab);
+			}
+
+			gResources().unregisterResourceArchive(archive);
+		}
+
+		FileSystem::remove(archivePath);
+		FileSystem::remove(prefabPaths[0]);
+		FileSystem::remove(prefabPaths[1]);
+	}
+
+	void EditorTestSuite::TestPhysicsInterpolation()
+	{
+		const float step = 1.0f / 60.0f;
+		const float frameRates[] = { 30.0f, 60.0f, 75.0f, 144.0f, 240.0f };
+
+		for (auto frameRate : frameRates)
+		{
+			PhysicsStepInterpolation interpolation;
+			float simulationTime = 0.0f;
+			bool stepInProgress = false;
+			float lastDisplayTime = 0.0f;
+
+			for (UINT32 i = 1; i <= 1000; i++)
+			{
+				float frameTime = i / frameRate;
+
+				// Same as the asynchronous physics update: the step launched during the previous frame completes first,
+				// then steps up to the frame time are launched, with all but the last one completing immediately
+				if (stepInProgress)
+				{
+					interpolation.addStep(simulationTime);
+					stepInProgress = false;
+				}
+
+				while (frameTime >= simulationTime + step)
+				{
+					if (stepInProgress)
+						interpolation.addStep(simulationTime);
+
+					simulationTime += step;
+					stepInProgress = true;
+				}
+
+				UINT32 first = 0;
+				float t = interpolation.evaluate(frameTime, step, first);
+				BS_TEST_ASSERT(first + 1 < PhysicsStepInterpolation::NUM_STEPS);
+				BS_TEST_ASSERT(t >= 0.0f && t <= 1.0f);
+
+				float startTime = interpolation.stepTimes[first];
+				float displayTime = startTime + t * (interpolation.stepTimes[first + 1] - startTime);
+
+				// Once enough steps completed, displayed time must follow the frame time without ever getting clamped
+				if (frameTime > step * 4.0f)
+				{
+					BS_TEST_ASSERT(displayTime >= lastDisplayTime);
+					BS_TEST_ASSERT(Math::approxEquals(displayTime, frameTime - 2.0f * step, 0.0001f));
+				}
+
+				lastDisplayTime = displayTime;
+			}
+		}
+	}
+
+	void EditorTestSuite::TestResourceLoader()
+	{
+		Path tempDirectory = FileSystem::getTempDirectoryPath();
+		auto getPath = [&](const String& name) { return Path::combine(tempDirectory, "testloader_" + name + ".bin"); };
+
+		// Each file contains its own name
+		const String names[] = { "block", "a", "b", "c", "d", "e" };
+		for (auto& name : names)
+		{
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(getPath(name));
+			stream->write(name.data(), name.size());
+			stream->close();
+		}
+
+		Mutex mutex;
+		Signal signal;
+		bool blockStarted = false;
+		bool blockReleased = false;
+		Vector<String> readOrder;
+		UINT32 numFinished = 0;
+		UINT32 numMismatched = 0;
+		String cancelled;
+
+		auto getReadCallback = [&](const String& name)
+		{
+			return [&, name](const SPtr<DataStream>& stream)
+			{
+				// Reads performed here must not be visible to the decode callback
+				char firstChar = 0;
+				stream->read(&firstChar, 1);
+
+				Lock lock(mutex);
+				readOrder.push_back(name);
+
+				if (name == "block")
+				{
+					blockStarted = true;
+					signal.notify_all();
+
+					while (!blockReleased)
+						signal.wait(lock);
+				}
+			};
+		};
+
+		auto getDecodeCallback = [&](const String& name)
+		{
+			return [&, name](const SPtr<DataStream>& stream)
+			{
+				Lock lock(mutex);
+
+				// File of the "missing" load doesn't exist, so its read fails
+				if (stream == nullptr && name != "missing")
+				{
+					cancelled += name;
+					return false;
+				}
+
+				if (stream != nullptr)
+				{
+					String contents(stream->size() - stream->tell(), '\0');
+					stream->read(&contents[0], contents.size());
+
+					if (contents != name)
+						numMismatched++;
+				}
+
+				numFinished++;
+				signal.notify_all();
+
+				// Decode of "d" fails even though its file was read
+				return stream != nullptr && name != "d";
+			};
+		};
+
+		{
+			ResourceLoader loader(1);
+
+			auto queue = [&](const String& name, ResourceLoadPriority priority)
+			{
+				loader.queue(name, getPath(name), 0, 0, false, priority, getDecodeCallback(name), getReadCallback(name));
+			};
+
+			// Hold the I/O thread so the following loads all end up queued before any of them is read
+			queue("block", ResourceLoadPriority::Level);
+			{
+				Lock lock(mutex);
+				while (!blockStarted)
+					signal.wait(lock);
+			}
+
+			queue("a", ResourceLoadPriority::Level);
+			queue("b", ResourceLoadPriority::Streaming);
+			queue("c", ResourceLoadPriority::Level);
+			queue("d", ResourceLoadPriority::Level);
+			queue("e", ResourceLoadPriority::Level);
+			queue("missing", ResourceLoadPriority::Level);
+
+			BS_TEST_ASSERT(loader.prioritize("c"));
+			BS_TEST_ASSERT(!loader.prioritize("block")); // Already being read
+			BS_TEST_ASSERT(loader.cancel("e"));
+			BS_TEST_ASSERT(!loader.cancel("e"));
+			BS_TEST_ASSERT(!loader.cancel("block"));
+
+			{
+				Lock lock(mutex);
+				BS_TEST_ASSERT(cancelled == "e"); // Cancelled loads are finished on the cancelling thread
+
+				blockReleased = true;
+				signal.notify_all();
+
+				while (numFinished < 6)
+					signal.wait(lock);
+			}
+
+			// Stats are updated once the decode callbacks return
+			while (loader.getStats().numDecoding > 0)
+				BS_THREAD_SLEEP(1);
+
+			ResourceLoadStats stats = loader.getStats();
+			BS_TEST_ASSERT(stats.numRequested == 7);
+			BS_TEST_ASSERT(stats.numCompleted == 6);
+			BS_TEST_ASSERT(stats.numCancelled == 1);
+			BS_TEST_ASSERT(stats.numFailed == 2); // Failed read of "missing" and failed decode of "d"
+			BS_TEST_ASSERT(stats.numQueued == 0);
+			BS_TEST_ASSERT(stats.getProgress() == 1.0f);
+		}
+
+		BS_TEST_ASSERT(numMismatched == 0);
+		BS_TEST_ASSERT(cancelled == "e");
+
+		// Streaming loads are read first, including the prioritized one, then the rest in the order they were queued
+		BS_TEST_ASSERT(readOrder.size() == 5);
+		if (readOrder.size() == 5)
+		{
+			BS_TEST_ASSERT(readOrder[0] == "block");
+			BS_TEST_ASSERT((readOrder[1] == "b" && readOrder[2] == "c") || (readOrder[1] == "c" && readOrder[2] == "b"));
+			BS_TEST_ASSERT((readOrder[3] == "a" && readOrder[4] == "d") || (readOrder[3] == "d" && readOrder[4] == "a"));
+		}
+
+		for (auto& name : names)
+			FileSystem::remove(getPath(name));
+	}
+
+	void EditorTestSuite::TestSyncLoadDuringAsync()
+	{
+		HSceneObject root = SceneObject::create("root");
+		GameObjectHandle<TestComponentC> cmp = root->addComponent<TestComponentC>();
+		cmp->obj.strA = "async";
+
+		Path prefabPath = Path::combine(FileSystem::getTempDirectoryPath(), "testsyncasync.asset");
+
+		String uuid;
+		{
+			HPrefab prefab = Prefab::create(root);
+			gResources().save(prefab, prefabPath, true);
+
+			uuid = prefab.getUUID();
+			gResources().release(prefab);
+		}
+
+		root->destroy();
+		gResources().unloadAllUnused();
+		BS_TEST_ASSERT(!gResources().isLoaded(uuid));
+
+		// Synchronous load must wait for the queued asynchronous load rather than deadlock or return an empty handle
+		gResources().resetLoadStats();
+
+		HPrefab asyncPrefab = gResources().loadAsync<Prefab>(prefabPath);
+		HPrefab syncPrefab = gResources().load<Prefab>(prefabPath);
+
+		BS_TEST_ASSERT(syncPrefab.isLoaded());
+		BS_TEST_ASSERT(asyncPrefab.isLoaded());
+		BS_TEST_ASSERT(syncPrefab.getUUID() == uuid && asyncPrefab.getUUID() == uuid);
+
+		if (syncPrefab.isLoaded())
+		{
+			HSceneObject instance = syncPrefab->instantiate();
+			GameObjectHandle<TestComponentC> instanceCmp = instance->getComponent<TestComponentC>();
+			BS_TEST_ASSERT(instanceCmp != nullptr && instanceCmp->obj.strA == "async");
+
+			instance->destroy();
+		}
+
+		ResourceLoadStats stats = gResources().getLoadStats();
+		BS_TEST_ASSERT(stats.numFailed == 0);
+
+		gResources().release(asyncPrefab);
+		gResources().release(syncPrefab);
+
+		FileSystem::remove(prefabPath);
+	}
+
+	/** Decodes the color portion of a BC1, BC2 or BC3 block into 16 RGBA8 pixels. */
+	static void decodeColorBlock(const UINT8* block, UINT8* pixels, bool allowTransparency)
+	{
+		UINT16 endpoints[2] = { (UINT16)(block[0] | (block[1] << 8)), (UINT16)(block[2] | (block[3] << 8)) };
+
+		INT32 palette[4][4];
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			palette[i][0] = ((endpoints[i] >> 11) & 0x1F) * 255 / 31;
+			palette[i][1] = ((endpoints[i] >> 5) & 0x3F) * 255 / 63;
+			palette[i][2] = (endpoints[i] & 0x1F) * 255 / 31;
+			palette[i][3] = 255;
+		}
+
+		// Blocks with separate alpha are always decoded using four colors
+		bool fourColors = !allowTransparency || endpoints[0] > endpoints[1];
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			if (fourColors)
+			{
+				palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+				palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+			}
+			else
+			{
+				palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+				palette[3][i] = 0;
+			}
+		}
+
+		palette[2][3] = 255;
+		palette[3][3] = fourColors ? 255 : 0;
+
+		UINT32 indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((UINT32)block[7] << 24);
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			UINT32 index = (indices >> (i * 2)) & 3;
+			for (UINT32 j = 0; j < 4; j++)
+				pixels[i * 4 + j] = (UINT8)palette[index][j];
+		}
+	}
+
+	/** Decodes a BC3 alpha or BC4/BC5 channel block into a single channel of 16 RGBA8 pixels. */
+	static void decodeChannelBlock(const UINT8* block, UINT8* pixels, UINT32 channel)
+	{
+		INT32 palette[8];
+		palette[0] = block[0];
+		palette[1] = block[1];
+
+		if (palette[0] > palette[1])
+		{
+			for (INT32 i = 1; i < 7; i++)
+				palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7;
+		}
+		else
+		{
+			for (INT32 i = 1; i < 5; i++)
+				palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		UINT64 indices = 0;
+		for (UINT32 i = 0; i < 6; i++)
+			indices |= (UINT64)block[2 + i] << (i * 8);
+
+		for (UINT32 i = 0; i < 16; i++)
+			pixels[i * 4 + channel] = (UINT8)palette[(indices >> (i * 3)) & 7];
+	}
+
+	/** Decodes an image compressed using one of the formats supported by BlockCompression into RGBA8 pixels. */
+	static void decodeBlockCompressed(const PixelData& src, UINT8* pixels)
+	{
+		PixelFormat format = src.getFormat();
+		UINT32 width = src.getWidth();
+		UINT32 numBlocksX = (width + 3) / 4;
+		UINT32 numBlocksY = (src.getHeight() + 3) / 4;
+		UINT32 blockSize = PixelUtil::getMemorySize(4, 4, 1, format);
+
+		const UINT8* block = src.getData();
+		for (UINT32 blockY = 0; blockY < numBlocksY; blockY++)
+		{
+			for (UINT32 blockX = 0; blockX < numBlocksX; blockX++)
+			{
+				UINT8 blockPixels[16 * 4];
+				memset(blockPixels, 255, sizeof(blockPixels));
+
+				switch (format)
+				{
+				case PF_BC1:
+				case PF_BC1a:
+					decodeColorBlock(block, blockPixels, true);
+					break;
+				case PF_BC2:
+					decodeColorBlock(block + 8, blockPixels, false);
+					for (UINT32 i = 0; i < 16; i++)
+						blockPixels[i * 4 + 3] = (UINT8)(((block[i / 2] >> ((i % 2) * 4)) & 0xF) * 17);
+					break;
+				case PF_BC3:
+					decodeColorBlock(block + 8, blockPixels, false);
+					decodeChannelBlock(block, blockPixels, 3);
+					break;
+				case PF_BC4:
+					decodeChannelBlock(block, blockPixels, 0);
+					break;
+				case PF_BC5:
+					decodeChannelBlock(block, blockPixels, 0);
+					decodeChannelBlock(block + 8, blockPixels, 1);
+					break;
+				default:
+					break;
+				}
+
+				for (UINT32 y = 0; y < 4; y++)
+				{
+					UINT8* row = pixels + ((blockY * 4 + y) * width + blockX * 4) * 4;
+					memcpy(row, blockPixels + y * 16, 16);
+				}
+
+				block += blockSize;
+			}
+		}
+	}
+
+	void EditorTestSuite::TestBlockCompression()
+	{
+		const UINT32 size = 64;
+
+		// Smooth gradients with mild noise, and an alpha channel alternating between smooth and cut-out regions
+		SPtr<PixelData> source = PixelData::create(size, size, 1, PF_RGBA8);
+		UINT8* sourcePixels = source->getData();
+		UINT32 seed = 12345;
+		for (UINT32 y = 0; y < size; y++)
+		{
+			for (UINT32 x = 0; x < size; x++)
+			{
+				seed = seed * 1664525 + 1013904223;
+				INT32 noise = (INT32)((seed >> 24) & 7) - 4;
+
+				UINT8* pixel = sourcePixels + (y * size + x) * 4;
+				pixel[0] = (UINT8)Math::clamp((INT32)(x * 4) + noise, 0, 255);
+				pixel[1] = (UINT8)Math::clamp((INT32)(y * 4) - noise, 0, 255);
+				pixel[2] = (UINT8)Math::clamp((INT32)((x + y) * 2) + noise, 0, 255);
+				pixel[3] = (y < size / 2) ? (UINT8)(x * 4) : (((x / 4 + y / 4) % 2) ? 255 : 0);
+			}
+		}
+
+		struct FormatInfo
+		{
+			PixelFormat format;
+			UINT32 channels[4]; // Non-zero for channels stored in the format
+			float minPSNR;
+		};
+
+		FormatInfo formats[] =
+		{
+			{ PF_BC1, { 1, 1, 1, 0 }, 33.0f },
+			{ PF_BC1a, { 1, 1, 1, 0 }, 33.0f },
+			{ PF_BC2, { 1, 1, 1, 1 }, 33.0f },
+			{ PF_BC3, { 1, 1, 1, 1 }, 33.0f },
+			{ PF_BC4, { 1, 0, 0, 0 }, 45.0f },
+			{ PF_BC5, { 1, 1, 0, 0 }, 45.0f },
+		};
+
+		Vector<UINT8> decoded(size * size * 4);
+		for (auto& entry : formats)
+		{
+			CompressionQuality qualities[] = { CompressionQuality::Fastest, CompressionQuality::Normal };
+			float psnr[2];
+
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				CompressionOptions options;
+				options.format = entry.format;
+				options.quality = qualities[i];
+
+				BS_TEST_ASSERT(BlockCompression::isSupported(options));
+
+				SPtr<PixelData> compressed = PixelData::create(size, size, 1, entry.format);
+				BlockCompression::compress(*source, *compressed, options);
+				decodeBlockCompressed(*compressed, decoded.data());
+
+				UINT64 squaredError = 0;
+				UINT32 numValues = 0;
+				UINT32 numAlphaMismatches = 0;
+				for (UINT32 j = 0; j < size * size; j++)
+				{
+					// Punch-through alpha only stores whether the pixel is visible, and no color for invisible pixels
+					if (entry.format == PF_BC1a)
+					{
+						bool visible = sourcePixels[j * 4 + 3] >= 128;
+						if (visible != (decoded[j * 4 + 3] == 255))
+							numAlphaMismatches++;
+
+						if (!visible)
+							continue;
+					}
+
+					for (UINT32 k = 0; k < 4; k++)
+					{
+						if (entry.channels[k] == 0)
+							continue;
+
+						INT32 diff = (INT32)decoded[j * 4 + k] - (INT32)sourcePixels[j * 4 + k];
+						squaredError += diff * diff;
+						numValues++;
+					}
+				}
+
+				BS_TEST_ASSERT(numAlphaMismatches == 0);
+
+				float mse = std::max(squaredError / (float)numValues, 0.0001f);
+				psnr[i] = 10.0f * log10(255.0f * 255.0f / mse);
+				BS_TEST_ASSERT(psnr[i] >= entry.minPSNR);
+			}
+
+			// Higher quality must never do worse
+			BS_TEST_ASSERT(psnr[1] >= psnr[0] - 0.01f);
+		}
+
+		// Colors of invisible pixels must not affect the visible ones when alpha is stored separately
+		{
+			UINT8 block[16 * 4];
+			for (UINT32 i = 0; i < 16; i++)
+			{
+				bool visible = (i % 2) == 0;
+
+				block[i * 4 + 0] = visible ? (UINT8)(100 + i * 2) : 255;
+				block[i * 4 + 1] = visible ? (UINT8)(100 + i * 2) : 0;
+				block[i * 4 + 2] = visible ? (UINT8)(100 + i * 2) : 255;
+				block[i * 4 + 3] = visible ? 255 : 0;
+			}
+
+			UINT32 errors[2];
+			AlphaMode alphaModes[] = { AlphaMode::None, AlphaMode::Transparency };
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				CompressionOptions options;
+				options.format = PF_BC3;
+				options.quality = CompressionQuality::Fastest;
+				options.alphaMode = alphaModes[i];
+
+				UINT8 output[16];
+				BlockCompression::compressBlock(block, output, options);
+
+				UINT8 blockPixels[16 * 4];
+				decodeColorBlock(output + 8, blockPixels, false);
+
+				errors[i] = 0;
+				for (UINT32 j = 0; j < 16; j += 2)
+				{
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						INT32 diff = (INT32)blockPixels[j * 4 + k] - (INT32)block[j * 4 + k];
+						errors[i] += diff * diff;
+					}
+				}
+			}
+
+			BS_TEST_ASSERT(errors[1] < errors[0]);
+			BS_TEST_ASSERT(errors[1] / 24 < 16); // Average error of visible values below 4
+		}
+
+		// Normal maps in color formats are left to the external encoder, as are formats the encoder doesn't support
+		CompressionOptions normalMapOptions;
+		normalMapOptions.isNormalMap = true;
+
+		normalMapOptions.format = PF_BC3;
+		BS_TEST_ASSERT(!BlockCompression::isSupported(normalMapOptions));
+
+		normalMapOptions.format = PF_BC5;
+		BS_TEST_ASSERT(BlockCompression::isSupported(normalMapOptions));
+
+		CompressionOptions bc7Options;
+		bc7Options.format = PF_BC7;
+		BS_TEST_ASSERT(!BlockCompression::isSupported(bc7Options));
+	}
+	/** Returns the largest absolute difference between any component of the two values. */
+	static float getMaxDifference(const Vector3& a, const Vector3& b)
+	{
+		Vector3 diff = a - b;
+		return std::max(std::max(Math::abs(diff.x), Math::abs(diff.y)), Math::abs(diff.z));
+	}
+
+	void EditorTestSuite::TestCompressedAnimationCurves()
+	{
+		// Smooth keys at irregular times, with a corner (different in and out tangents) and a step in the Y component
+		Vector<TKeyframe<Vector3>> positionKeys;
+		Vector<TKeyframe<Quaternion>> rotationKeys;
+
+		float time = 0.0f;
+		for (UINT32 i = 0; i < 25; i++)
+		{
+			TKeyframe<Vector3> positionKey;
+			positionKey.time = time;
+			positionKey.value = Vector3(Math::sin(time * 2.0f), Math::cos(time * 3.0f), time * time);
+			positionKey.inTangent = Vector3(Math::cos(time * 2.0f) * 2.0f, -Math::sin(time * 3.0f) * 3.0f, time * 2.0f);
+			positionKey.outTangent = positionKey.inTangent;
+
+			if (i == 10)
+				positionKey.outTangent.x = -positionKey.inTangent.x;
+
+			if (i == 15)
+				positionKey.outTangent.y = std::numeric_limits<float>::infinity();
+
+			positionKeys.push_back(positionKey);
+
+			// Rotation around a changing axis, with tangents of the unit quaternion curve
+			const float rate = 1.5f;
+			Vector3 axis = Vector3::normalize(Vector3(1.0f, Math::sin(time * 0.5f) * 0.1f, 0.5f));
+			float angle = time * rate;
+
+			TKeyframe<Quaternion> rotationKey;
+			rotationKey.time = time;
+			rotationKey.value = Quaternion(axis, Radian(angle));
+			rotationKey.inTangent = Quaternion(axis, Radian(angle + Math::PI)) * (rate * 0.5f);
+			rotationKey.outTangent = rotationKey.inTangent;
+
+			rotationKeys.push_back(rotationKey);
+
+			time += 0.1f + (i % 3) * 0.05f;
+		}
+
+		AnimationCurves curves;
+		curves.position.push_back(TNamedAnimationCurve<Vector3>("position", TAnimationCurve<Vector3>(positionKeys)));
+		curves.rotation.push_back(TNamedAnimationCurve<Quaternion>("rotation",
+			TAnimationCurve<Quaternion>(rotationKeys)));
+
+		const TAnimationCurve<Vector3>& positionCurve = curves.position[0].curve;
+		const TAnimationCurve<Quaternion>& rotationCurve = curves.rotation[0].curve;
+
+		const float tolerance = 0.001f;
+		CompressedAnimationCurves compressed = CompressedAnimationCurves::create(curves, 30, tolerance);
+
+		UINT32 uncompressedSize = (UINT32)(positionKeys.size() * sizeof(TKeyframe<Vector3>) +
+			rotationKeys.size() * sizeof(TKeyframe<Quaternion>));
+		BS_TEST_ASSERT(compressed.getMemorySize() < uncompressedSize / 2);
+		BS_TEST_ASSERT(Math::approxEquals(compressed.getLength(), positionCurve.getLength()));
+
+		AnimationCurves decompressed = curves;
+		compressed.decompress(decompressed);
+
+		// Evaluate in-between the sampled times, and outside of the curve range to test looping and clamping
+		float length = positionCurve.getLength();
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool loop = i == 0;
+
+			TCurveCache<Vector3> positionCache;
+			TCurveCache<Quaternion> rotationCache;
+
+			float maxPositionError = 0.0f;
+			float maxRotationError = 0.0f;
+			float maxDecompressedError = 0.0f;
+			for (float t = -length * 0.5f; t < length * 2.0f; t += 1.0f / 240.0f)
+			{
+				Vector3 position = compressed.evaluatePosition(0, t, positionCache, loop);
+				Quaternion rotation = compressed.evaluateRotation(0, t, rotationCache, loop);
+
+				Quaternion expectedRotation = rotationCurve.evaluate(t, loop);
+				expectedRotation.normalize();
+
+				// Quantized key times move the step slightly, don't evaluate right next to it
+				float curveTime = t;
+				AnimationUtility::wrapTime(curveTime, 0.0f, length, loop);
+
+				if (Math::abs(curveTime - positionKeys[16].time) > 0.001f)
+				{
+					maxPositionError = std::max(maxPositionError,
+						getMaxDifference(position, positionCurve.evaluate(t, loop)));
+					maxDecompressedError = std::max(maxDecompressedError,
+						getMaxDifference(position, decompressed.position[0].curve.evaluate(t, loop)));
+				}
+
+				float rotationError = 0.0f;
+				float negatedRotationError = 0.0f;
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					rotationError = std::max(rotationError, Math::abs(rotation[j] - expectedRotation[j]));
+					negatedRotationError = std::max(negatedRotationError, Math::abs(rotation[j] + expectedRotation[j]));
+				}
+
+				maxRotationError = std::max(maxRotationError, std::min(rotationError, negatedRotationError));
+			}
+
+			BS_TEST_ASSERT(maxPositionError <= tolerance * 2.0f);
+			BS_TEST_ASSERT(maxRotationError <= tolerance * 2.0f);
+			BS_TEST_ASSERT(maxDecompressedError <= tolerance * 0.1f);
+		}
+	}
+}
@@ -93,6 +93,42 @@ namespace bs
 
 		/**	Tests the frame allocator. */
 		void TestFrameAlloc();
+
+		/** Tests that cached GUI element geometry is regenerated when the element's layout changes. */
+		void TestGUICachedGeometry();
+
+		/**
+		 * Tests building a resource archive with and without compression, reading its entries back and loading resources
+		 * from it.
+		 */
+		void TestResourceArchive();
+
+		/**
+		 * Tests that rigidbody transforms interpolated during asynchronous physics simulation move forward smoothly 
+		 * across simulation step boundaries, at various frame rates.
+		 */
+		void TestPhysicsInterpolation();
+
+		/**
+		 * Tests asynchronous load ordering by priority class, prioritizing and cancelling queued loads, and the
+		 * reporting of loads that fail to read or decode.
+		 */
+		void TestResourceLoader();
+
+		/** Tests that a synchronous load of a resource that is already being loaded asynchronously completes. */
+		void TestSyncLoadDuringAsync();
+
+		/**
+		 * Tests the built-in block compression encoder by compressing and decoding images in all supported formats,
+		 * and comparing the result against the source image.
+		 */
+		void TestBlockCompression();
+
+		/**
+		 * Tests compressed animation curves by comparing them against the source curves in-between the sampled times,
+		 * across tangent discontinuities and steps, and when looping and clamping.
+		 */
+		void TestCompressedAnimationCurves();
 	};
 
 	/** @} */
@@ -0,0 +1,22 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsApplication.h"
+#include "Testing/BsGUIBenchmarkSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+using namespace bs;
+
+int main()
+{
+	// Benchmarks run outside of the main loop, but GUI still needs a window, a renderer and builtin resources
+	Application::startUp(VideoMode(1280, 720), "Banshee Benchmark", false);
+
+	SPtr<TestSuite> benchmarks = GUIBenchmarkSuite::create<GUIBenchmarkSuite>();
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	Application::shutDown();
+
+	return 0;
+}
@@ -47,6 +47,10 @@
  */
 /** @endcond */
 
+/** @defgroup Testing-Engine Testing
+ *  Contains engine layer benchmarks.
+ */
+
 /** @defgroup Utility-Engine Utility
  *  Various utility methods and types used by the engine layer.
  */
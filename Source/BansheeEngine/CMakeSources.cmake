@@ -181,6 +181,14 @@ set(BS_BANSHEEENGINE_INC_LOCALIZATION
 	"Localization/BsHEString.h"
 )
 
+set(BS_BANSHEEENGINE_INC_TESTING
+	"Testing/BsGUIBenchmarkSuite.h"
+)
+
+set(BS_BANSHEEENGINE_SRC_TESTING
+	"Testing/BsGUIBenchmarkSuite.cpp"
+)
+
 set(BS_BANSHEEENGINE_SRC_RENDERER
 	"Renderer/BsRendererMaterial.cpp"
 	"Renderer/BsRendererMaterialManager.cpp"
@@ -286,6 +294,8 @@ source_group("Source Files\\Debug" FILES ${BS_BANSHEEENGINE_SRC_DEBUG})
 source_group("Header Files\\Debug" FILES ${BS_BANSHEEENGINE_INC_DEBUG})
 source_group("Source Files\\Localization" FILES ${BS_BANSHEEENGINE_SRC_LOCALIZATION})
 source_group("Header Files\\Localization" FILES ${BS_BANSHEEENGINE_INC_LOCALIZATION})
+source_group("Header Files\\Testing" FILES ${BS_BANSHEEENGINE_INC_TESTING})
+source_group("Source Files\\Testing" FILES ${BS_BANSHEEENGINE_SRC_TESTING})
 
 set(BS_BANSHEEENGINE_SRC
 	${BS_BANSHEEENGINE_SRC_RESOURCES}
@@ -312,4 +322,6 @@ set(BS_BANSHEEENGINE_SRC
 	${BS_BANSHEEENGINE_SRC_DEBUG}
 	${BS_BANSHEEENGINE_INC_LOCALIZATION}
 	${BS_BANSHEEENGINE_SRC_LOCALIZATION}
+	${BS_BANSHEEENGINE_INC_TESTING}
+	${BS_BANSHEEENGINE_SRC_TESTING}
 )
\ No newline at end of file
@@ -4,14 +4,16 @@
 #include "GUI/BsGUIWidget.h"
 #include "GUI/BsGUISkin.h"
 #include "GUI/BsGUIManager.h"
+#include "Math/BsVector2.h"
 
 namespace bs
 {
 	const Color GUIElement::DISABLED_COLOR = Color(0.5f, 0.5f, 0.5f, 1.0f);
+	UINT64 GUIElement::NextRenderElementsVersion = 0;
 
 	GUIElement::GUIElement(const String& styleName, const GUIDimensions& dimensions)
 		:GUIElementBase(dimensions), mIsDestroyed(false), mBlockPointerEvents(true), mStyle(&GUISkin::DefaultStyle)
-		, mStyleName(styleName)
+		, mStyleName(styleName), mRenderElementsVersion(NextRenderElementsVersion++), mCachedGeometryVersion((UINT64)-1)
 	{
 		// Style is set to default here, and the proper one is assigned once GUI element
 		// is assigned to a parent (that's when the active GUI skin becomes known)
@@ -25,6 +27,58 @@ namespace bs
 	void GUIElement::_updateRenderElements()
 	{
 		updateRenderElementsInternal();
+
+		mRenderElementsVersion = NextRenderElementsVersion++;
+	}
+
+	void GUIElement::_updateCachedGeometry()
+	{
+		if (mCachedGeometryVersion == mRenderElementsVersion)
+			return;
+
+		UINT32 numRenderElements = _getNumRenderElements();
+		mCachedGeometry.resize(numRenderElements);
+
+		UINT32 numVertexBytes = 0;
+		UINT32 numIndices = 0;
+		for (UINT32 i = 0; i < numRenderElements; i++)
+		{
+			GUIRenderElementGeometry& geometry = mCachedGeometry[i];
+			_getMeshInfo(i, geometry.numVertices, geometry.numIndices, geometry.type);
+
+			geometry.vertexOffset = numVertexBytes;
+			geometry.indexOffset = numIndices;
+
+			numVertexBytes += geometry.numVertices * _getVertexSize(geometry.type);
+			numIndices += geometry.numIndices;
+		}
+
+		mCachedVertices.resize(numVertexBytes);
+		mCachedIndices.resize(numIndices);
+
+		// Each render element is generated as if it was the only one in the buffer, so that its vertices and indices can
+		// later be copied to any location in the batched mesh
+		for (UINT32 i = 0; i < numRenderElements; i++)
+		{
+			const GUIRenderElementGeometry& geometry = mCachedGeometry[i];
+			if (geometry.numVertices == 0 && geometry.numIndices == 0)
+				continue;
+
+			UINT8* vertices = mCachedVertices.data() + geometry.vertexOffset;
+			UINT32* indices = mCachedIndices.data() + geometry.indexOffset;
+
+			_fillBuffer(vertices, indices, 0, 0, geometry.numVertices, geometry.numIndices, i);
+		}
+
+		mCachedGeometryVersion = mRenderElementsVersion;
+	}
+
+	UINT32 GUIElement::_getVertexSize(GUIMeshType type)
+	{
+		if (type == GUIMeshType::Triangle)
+			return sizeof(Vector2) * 2;
+		else // Line
+			return sizeof(Vector2);
 	}
 
 	void GUIElement::updateRenderElementsInternal()
@@ -84,7 +138,11 @@ namespace bs
 
 	void GUIElement::_setElementDepth(UINT8 depth)
 	{
-		mLayoutData.depth = depth | (mLayoutData.depth & 0xFFFFFF00);
+		UINT32 newDepth = depth | (mLayoutData.depth & 0xFFFFFF00);
+		if (newDepth != mLayoutData.depth)
+			mRenderElementsVersion = NextRenderElementsVersion++;
+
+		mLayoutData.depth = newDepth;
 		_markMeshAsDirty();
 	}
 
@@ -98,6 +156,11 @@ namespace bs
 		// Preserve element depth as that is not controlled by layout but is stored
 		// there only for convenience
 		UINT8 elemDepth = _getElementDepth();
+
+		// Geometry generated by _fillBuffer() is positioned and clipped according to the layout
+		if (data.area != mLayoutData.area || data.clipRect != mLayoutData.clipRect)
+			mRenderElementsVersion = NextRenderElementsVersion++;
+
 		GUIElementBase::_setLayoutData(data);
 		_setElementDepth(elemDepth);
 
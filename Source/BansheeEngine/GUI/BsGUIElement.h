@@ -15,6 +15,16 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Describes geometry of a single render element of a GUIElement, as stored in the element's geometry cache. */
+	struct GUIRenderElementGeometry
+	{
+		UINT32 vertexOffset; /**< Offset to the first vertex in the cached vertex buffer, in bytes. */
+		UINT32 indexOffset; /**< Offset to the first index in the cached index buffer. */
+		UINT32 numVertices; /**< Number of vertices used by the render element. */
+		UINT32 numIndices; /**< Number of indices used by the render element. Indices are relative to the first vertex. */
+		GUIMeshType type; /**< Type of mesh the vertices belong to. */
+	};
+
 	/**
 	 * Represents parent class for all visible GUI elements. Contains methods needed for positioning, rendering and
 	 * handling input.
@@ -142,6 +152,38 @@ namespace bs
 		 */
 		void _updateRenderElements();
 
+		/**
+		 * Returns a value that changes whenever the render elements of this element are recreated, or when the element's
+		 * layout area, clip rectangle or depth change. Allows the caller to detect whether geometry previously generated
+		 * by _fillBuffer() is still valid.
+		 */
+		UINT64 _getRenderElementsVersion() const { return mRenderElementsVersion; }
+
+		/**
+		 * Makes sure the geometry cache contains up-to-date geometry of all render elements, as generated by
+		 * _fillBuffer(). Geometry is only re-generated if the render elements version changed since the last call, which
+		 * includes changes to the element's layout area and clip rectangle.
+		 */
+		void _updateCachedGeometry();
+
+		/**
+		 * Returns information about the cached geometry of the specified render element. Only valid after a call to
+		 * _updateCachedGeometry().
+		 */
+		const GUIRenderElementGeometry& _getCachedGeometry(UINT32 renderElementIdx) const 
+		{ 
+			return mCachedGeometry[renderElementIdx]; 
+		}
+
+		/** Returns the cached vertex data of all render elements. Use _getCachedGeometry() to locate a render element. */
+		const UINT8* _getCachedVertices() const { return mCachedVertices.data(); }
+
+		/** Returns the cached index data of all render elements. Use _getCachedGeometry() to locate a render element. */
+		const UINT32* _getCachedIndices() const { return mCachedIndices.data(); }
+
+		/** Returns the size of a single vertex, in bytes, as written by _fillBuffer() for the specified mesh type. */
+		static UINT32 _getVertexSize(GUIMeshType type);
+
 		/** Gets internal element style representing the exact type of GUI element in this object. */
 		virtual ElementType _getElementType() const { return ElementType::Undefined; }
 
@@ -301,12 +343,19 @@ namespace bs
 		
 	private:
 		static const Color DISABLED_COLOR;
+		static UINT64 NextRenderElementsVersion;
 
 		const GUIElementStyle* mStyle;
 		String mStyleName;
 
 		SPtr<GUIContextMenu> mContextMenu;
 		Color mColor;
+		UINT64 mRenderElementsVersion;
+
+		Vector<GUIRenderElementGeometry> mCachedGeometry;
+		Vector<UINT8> mCachedVertices;
+		Vector<UINT32> mCachedIndices;
+		UINT64 mCachedGeometryVersion;
 	};
 
 	/** @} */
@@ -37,6 +37,7 @@
 #include "RenderAPI/BsSamplerState.h"
 #include "Managers/BsRenderStateManager.h"
 #include "Resources/BsBuiltinResources.h"
+#include "Threading/BsTaskScheduler.h"
 
 using namespace std::placeholders;
 
@@ -60,12 +61,136 @@ namespace bs
 		SpriteMaterial* material;
 		SpriteMaterialInfo matInfo;
 		GUIMeshType meshType;
+		GUIWidget* widget;
 		UINT32 numVertices;
 		UINT32 numIndices;
 		UINT32 depth;
 		UINT32 minDepth;
 		Rect2I bounds;
 		Vector<GUIGroupElement> elements;
+		UINT32 queryId;
+	};
+
+	/** Render element queued for batching, along with its depth and world-space bounds. */
+	struct GUIBatchElement
+	{
+		GUIGroupElement elem;
+		UINT32 depth;
+		Rect2I bounds;
+	};
+
+	/** Render element whose cached geometry needs to be copied into a batched GUI mesh. */
+	struct GUIGeometryCopy
+	{
+		GUIElement* element;
+		UINT32 renderElement;
+		UINT8* vertices; /**< Location in the mesh vertex buffer to copy the vertices to. */
+		UINT32* indices; /**< Location in the mesh index buffer to copy the indices to. */
+		UINT32 vertexSize;
+		UINT32 baseVertex; /**< Index of the first vertex of the render element in the mesh. */
+	};
+
+	/** Minimum number of render elements whose geometry is copied into batched meshes by a single job. */
+	static constexpr UINT32 GUI_COPY_ELEMENTS_PER_JOB = 512;
+
+	/**
+	 * Uniform grid over the area covered by GUI elements of a single viewport. Each cell references all material groups
+	 * whose bounds overlap the cell, allowing overlap queries without checking every group. Must be used between
+	 * bs_frame_mark() and bs_frame_clear() calls.
+	 */
+	class GUIGroupGrid
+	{
+	public:
+		/** Creates a grid covering the provided area. All bounds provided to the grid must lie within the area. */
+		GUIGroupGrid(const Rect2I& area)
+			:mArea(area)
+		{
+			UINT32 maxExtent = std::max(area.width, area.height);
+			mCellSize = std::max(MIN_CELL_SIZE, (maxExtent + MAX_CELLS_PER_AXIS - 1) / MAX_CELLS_PER_AXIS);
+
+			mNumCellsX = std::max(1U, (area.width + mCellSize) / mCellSize);
+			mNumCellsY = std::max(1U, (area.height + mCellSize) / mCellSize);
+
+			mCells.resize(mNumCellsX * mNumCellsY);
+		}
+
+		/**
+		 * Registers a group with all the cells its bounds overlap. If the group was registered before, the bounds it was
+		 * registered with should be provided, in which case only the newly overlapped cells are updated. Group bounds
+		 * are only ever expected to grow.
+		 */
+		void insert(UINT32 groupIdx, const Rect2I& bounds, const Rect2I* oldBounds = nullptr)
+		{
+			UINT32 minX, minY, maxX, maxY;
+			getCellRange(bounds, minX, minY, maxX, maxY);
+
+			UINT32 oldMinX = 1, oldMinY = 1, oldMaxX = 0, oldMaxY = 0;
+			if (oldBounds != nullptr)
+				getCellRange(*oldBounds, oldMinX, oldMinY, oldMaxX, oldMaxY);
+
+			for (UINT32 y = minY; y <= maxY; y++)
+			{
+				for (UINT32 x = minX; x <= maxX; x++)
+				{
+					if (x >= oldMinX && x <= oldMaxX && y >= oldMinY && y <= oldMaxY)
+						continue;
+
+					mCells[y * mNumCellsX + x].push_back(groupIdx);
+				}
+			}
+		}
+
+		/**
+		 * Calls the provided visitor for every group registered with a cell overlapping the provided bounds. Groups
+		 * spanning multiple cells will be visited multiple times. Visitor should return true to stop the query.
+		 *
+		 * @return	True if the query was stopped by the visitor.
+		 */
+		template<class F>
+		bool query(const Rect2I& bounds, F visitor) const
+		{
+			UINT32 minX, minY, maxX, maxY;
+			getCellRange(bounds, minX, minY, maxX, maxY);
+
+			for (UINT32 y = minY; y <= maxY; y++)
+			{
+				for (UINT32 x = minX; x <= maxX; x++)
+				{
+					for (auto& groupIdx : mCells[y * mNumCellsX + x])
+					{
+						if (visitor(groupIdx))
+							return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+	private:
+		/** Finds the range of cells covered by the provided bounds, inclusive. */
+		void getCellRange(const Rect2I& bounds, UINT32& minX, UINT32& minY, UINT32& maxX, UINT32& maxY) const
+		{
+			auto toCell = [this](INT32 value, INT32 start, UINT32 numCells)
+			{
+				INT32 cell = (value - start) / (INT32)mCellSize;
+				return (UINT32)Math::clamp(cell, 0, (INT32)numCells - 1);
+			};
+
+			minX = toCell(bounds.x, mArea.x, mNumCellsX);
+			minY = toCell(bounds.y, mArea.y, mNumCellsY);
+			maxX = toCell(bounds.x + (INT32)bounds.width, mArea.x, mNumCellsX);
+			maxY = toCell(bounds.y + (INT32)bounds.height, mArea.y, mNumCellsY);
+		}
+
+		static const UINT32 MIN_CELL_SIZE = 64;
+		static const UINT32 MAX_CELLS_PER_AXIS = 64;
+
+		Rect2I mArea;
+		UINT32 mCellSize;
+		UINT32 mNumCellsX;
+		UINT32 mNumCellsY;
+		FrameVector<FrameVector<UINT32>> mCells;
 	};
 
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
@@ -270,12 +395,12 @@ namespace bs
 		}
 
 		// Update layouts
-		gProfilerCPU().beginSample("UpdateLayout");
+		gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("UpdateLayout"));
 		for(auto& widgetInfo : mWidgets)
 		{
 			widgetInfo.widget->_updateLayout();
 		}
-		gProfilerCPU().endSample("UpdateLayout");
+		gProfilerCPU().endSample(PROFILE_SAMPLE_ID("UpdateLayout"));
 
 		// Destroy all queued elements (and loop in case any new ones get queued during destruction)
 		do
@@ -448,20 +573,12 @@ namespace bs
 
 			bs_frame_mark();
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
-				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
-
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+				gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("GUIBatching"));
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+				FrameVector<GUIBatchElement> allElements;
+				Rect2I area;
+				bool hasArea = false;
 
 				for (auto& widget : renderData.widgets)
 				{
@@ -472,57 +589,83 @@ namespace bs
 						if (!element->_isVisible())
 							continue;
 
+						Rect2I tfrmedBounds = element->_getClippedBounds();
+						tfrmedBounds.transform(element->_getParentWidget()->getWorldTfrm());
+
+						if (hasArea)
+							area.encapsulate(tfrmedBounds);
+						else
+						{
+							area = tfrmedBounds;
+							hasArea = true;
+						}
+
 						UINT32 numRenderElems = element->_getNumRenderElements();
 						for (UINT32 i = 0; i < numRenderElems; i++)
 						{
-							allElements.insert(GUIGroupElement(element, i));
+							GUIBatchElement batchElem;
+							batchElem.elem = GUIGroupElement(element, i);
+							batchElem.depth = element->_getRenderElementDepth(i);
+							batchElem.bounds = tfrmedBounds;
+
+							allElements.push_back(batchElem);
 						}
 					}
 				}
 
+				std::sort(allElements.begin(), allElements.end(), 
+					[](const GUIBatchElement& a, const GUIBatchElement& b)
+				{
+					// Compare pointers just to differentiate between two elements with the same depth, their order 
+					// doesn't really matter, but it needs to be deterministic
+					return (a.depth > b.depth) ||
+						(a.depth == b.depth && a.elem.element > b.elem.element) ||
+						(a.depth == b.depth && a.elem.element == b.elem.element && 
+							a.elem.renderElement > b.elem.renderElement);
+				});
+
 				// Group the elements in such a way so that we end up with a smallest amount of
 				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
-				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+				FrameVector<GUIMaterialGroup> groups;
+				FrameUnorderedMap<UINT64, FrameVector<UINT32>> materialGroups;
+				GUIGroupGrid groupGrid(area);
+				UINT32 queryId = 0;
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+				for (auto& entry : allElements)
+				{
+					GUIElement* guiElem = entry.elem.element;
+					UINT32 renderElemIdx = entry.elem.renderElement;
+					UINT32 elemDepth = entry.depth;
+					const Rect2I& tfrmedBounds = entry.bounds;
 
 					SpriteMaterial* spriteMaterial = nullptr;
 					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
 					assert(spriteMaterial != nullptr);
 
 					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
+					FrameVector<UINT32>& groupsPerMaterial = materialGroups[hash];
 					
 					// Try to find a group this material will fit in:
 					//  - Group that has a depth value same or one below elements depth will always be a match
 					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
 					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+					UINT32 foundGroupIdx = (UINT32)-1;
 
 					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
 					{
+						UINT32 groupIdx = *groupIter;
+						GUIMaterialGroup& group = groups[groupIdx];
+
 						// If we separate meshes by widget, ignore any groups with widget parents other than mine
 						if (mSeparateMeshesByWidget)
 						{
-							if (groupIter->elements.size() > 0)
-							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-									continue;
-							}
+							if (group.widget != guiElem->_getParentWidget())
+								continue;
 						}
 
-						GUIMaterialGroup& group = *groupIter;
-
 						if (group.depth == elemDepth)
 						{
-							foundGroup = &group;
+							foundGroupIdx = groupIdx;
 							break;
 						}
 						else
@@ -533,160 +676,272 @@ namespace bs
 							Rect2I potentialGroupBounds = group.bounds;
 							potentialGroupBounds.encapsulate(tfrmedBounds);
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
+							// Only groups registered in the grid cells the bounds overlap need to be checked
+							queryId++;
+							bool foundOverlap = groupGrid.query(potentialGroupBounds, 
+								[&](UINT32 otherGroupIdx)
 							{
-								for (auto& matGroup : material.second)
+								GUIMaterialGroup& matGroup = groups[otherGroupIdx];
+								if (matGroup.queryId == queryId || otherGroupIdx == groupIdx)
+									return false;
+
+								matGroup.queryId = queryId;
+
+								if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+									|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
 								{
-									if (&matGroup == &group)
-										continue;
-
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
-									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
-									}
+									if (matGroup.bounds.overlaps(potentialGroupBounds))
+										return true;
 								}
-							}
+
+								return false;
+							});
 
 							if (!foundOverlap)
 							{
-								foundGroup = &group;
+								foundGroupIdx = groupIdx;
 								break;
 							}
 						}
 					}
 
-					if (foundGroup == nullptr)
+					if (foundGroupIdx == (UINT32)-1)
 					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
-
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
-
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
+						foundGroupIdx = (UINT32)groups.size();
+						groups.push_back(GUIMaterialGroup());
+						groupsPerMaterial.push_back(foundGroupIdx);
+
+						GUIMaterialGroup& foundGroup = groups[foundGroupIdx];
+						foundGroup.depth = elemDepth;
+						foundGroup.minDepth = elemDepth;
+						foundGroup.bounds = tfrmedBounds;
+						foundGroup.elements.push_back(entry.elem);
+						foundGroup.matInfo = matInfo.clone();
+						foundGroup.material = spriteMaterial;
+						foundGroup.widget = guiElem->_getParentWidget();
+						foundGroup.queryId = 0;
+
+						guiElem->_getMeshInfo(renderElemIdx, foundGroup.numVertices, foundGroup.numIndices, foundGroup.meshType);
+
+						groupGrid.insert(foundGroupIdx, foundGroup.bounds);
 					}
 					else
 					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+						GUIMaterialGroup& foundGroup = groups[foundGroupIdx];
+
+						Rect2I oldBounds = foundGroup.bounds;
+						foundGroup.bounds.encapsulate(tfrmedBounds);
+						foundGroup.elements.push_back(entry.elem);
+						foundGroup.minDepth = std::min(foundGroup.minDepth, elemDepth);
+
+						groupGrid.insert(foundGroupIdx, foundGroup.bounds, &oldBounds);
 						
 						UINT32 numVertices;
 						UINT32 numIndices;
 						GUIMeshType meshType;
 						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
+						assert(meshType == foundGroup.meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
 
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
+						foundGroup.numVertices += numVertices;
+						foundGroup.numIndices += numIndices;
 
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
+						spriteMaterial->merge(foundGroup.matInfo, matInfo);
 					}
 				}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+				// Sort the groups from farthest to nearest (highest depth to lowest)
+				UINT32 numMeshes = (UINT32)groups.size();
+
+				FrameVector<UINT32> sortedGroups(numMeshes);
+				for (UINT32 i = 0; i < numMeshes; i++)
+					sortedGroups[i] = i;
+
+				std::sort(sortedGroups.begin(), sortedGroups.end(), 
+					[&groups](UINT32 a, UINT32 b)
+				{
+					return (groups[a].depth > groups[b].depth) || (groups[a].depth == groups[b].depth && a > b);
+				});
+
+				// Find meshes from the previous update that contain exactly the same render elements, none of which have
+				// changed since. Those can be re-used as is, without re-generating their geometry.
+				auto getMeshKey = [](GUIElement* element, UINT32 renderElement)
 				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
+					size_t key = 0;
+					hash_combine(key, element);
+					hash_combine(key, renderElement);
+
+					return key;
 				};
 
-				UINT32 numMeshes = 0;
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
+				UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
+
+				FrameUnorderedMap<size_t, UINT32> oldMeshLookup;
+				for (UINT32 i = 0; i < oldNumMeshes; i++)
 				{
-					for(auto& group : material.second)
+					const GUIMeshData& oldMesh = renderData.cachedMeshes[i];
+					if (oldMesh.mesh == nullptr || oldMesh.elements.empty())
+						continue;
+
+					const GUIMeshElement& firstElem = oldMesh.elements[0];
+					oldMeshLookup[getMeshKey(firstElem.element, firstElem.renderElement)] = i;
+				}
+
+				FrameVector<bool> isOldMeshUsed(oldNumMeshes, false);
+				FrameVector<UINT32> reusedMeshes(numMeshes, (UINT32)-1);
+				for (UINT32 i = 0; i < numMeshes; i++)
+				{
+					const GUIMaterialGroup& group = groups[sortedGroups[i]];
+					const GUIGroupElement& firstElem = group.elements[0];
+
+					auto iterFind = oldMeshLookup.find(getMeshKey(firstElem.element, firstElem.renderElement));
+					if (iterFind == oldMeshLookup.end() || isOldMeshUsed[iterFind->second])
+						continue;
+
+					const GUIMeshData& oldMesh = renderData.cachedMeshes[iterFind->second];
+					if (oldMesh.isLine != (group.meshType == GUIMeshType::Line) || 
+						oldMesh.elements.size() != group.elements.size())
+						continue;
+
+					bool isMatch = true;
+					for (UINT32 j = 0; j < (UINT32)group.elements.size(); j++)
 					{
-						sortedGroups.insert(&group);
-						numMeshes++;
+						const GUIGroupElement& elem = group.elements[j];
+						const GUIMeshElement& oldElem = oldMesh.elements[j];
+
+						if (elem.element != oldElem.element || elem.renderElement != oldElem.renderElement ||
+							elem.element->_getRenderElementsVersion() != oldElem.version)
+						{
+							isMatch = false;
+							break;
+						}
 					}
+
+					if (!isMatch)
+						continue;
+
+					reusedMeshes[i] = iterFind->second;
+					isOldMeshUsed[iterFind->second] = true;
 				}
 
-				UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
+				// Release meshes that cannot be re-used
 				for (UINT32 i = 0; i < oldNumMeshes; i++)
 				{
+					if (isOldMeshUsed[i] || renderData.cachedMeshes[i].mesh == nullptr)
+						continue;
+
 					if(!renderData.cachedMeshes[i].isLine)
 						mTriangleMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
 					else
 						mLineMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
 				}
 
-				renderData.cachedMeshes.resize(numMeshes);
-				
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				for(auto& group : sortedGroups)
+				gProfilerCPU().endSample(PROFILE_SAMPLE_ID("GUIBatching"));
+				gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("GUIFillBuffers"));
+
+				Vector<GUIMeshData> newMeshes(numMeshes);
+				FrameVector<SPtr<MeshData>> newMeshData(numMeshes);
+				FrameVector<GUIGeometryCopy> geometryCopies;
+
+				// Determine where in the new meshes should geometry of each render element be placed
+				for(UINT32 meshIdx = 0; meshIdx < numMeshes; meshIdx++)
 				{
-					SPtr<MeshData> meshData;
-					GUIWidget* widget;
+					const GUIMaterialGroup* group = &groups[sortedGroups[meshIdx]];
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
+					GUIMeshData& guiMeshData = newMeshes[meshIdx];
+					guiMeshData.matInfo = group->matInfo;
+					guiMeshData.material = group->material;
+					guiMeshData.widget = group->widget;
+					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+
+					guiMeshData.elements.resize(group->elements.size());
+					for (UINT32 i = 0; i < (UINT32)group->elements.size(); i++)
 					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
+						const GUIGroupElement& elem = group->elements[i];
+
+						GUIMeshElement& meshElem = guiMeshData.elements[i];
+						meshElem.element = elem.element;
+						meshElem.renderElement = elem.renderElement;
+						meshElem.version = elem.element->_getRenderElementsVersion();
 					}
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
+					if (reusedMeshes[meshIdx] != (UINT32)-1)
+					{
+						guiMeshData.mesh = renderData.cachedMeshes[reusedMeshes[meshIdx]].mesh;
+						continue;
+					}
 
+					SPtr<MeshData> meshData;
 					if (group->meshType == GUIMeshType::Triangle)
-					{
 						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mTriangleVertexDesc);
-						guiMeshData.isLine = false;
-					}
 					else // Line
-					{
 						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mLineVertexDesc);
-						guiMeshData.isLine = true;
-					}
+
+					newMeshData[meshIdx] = meshData;
 
 					UINT8* vertices = meshData->getElementData(VES_POSITION);
 					UINT32* indices = meshData->getIndices32();
+					UINT32 vertexSize = GUIElement::_getVertexSize(group->meshType);
 
 					UINT32 indexOffset = 0;
 					UINT32 vertexOffset = 0;
 					for(auto& matElement : group->elements)
 					{
-						matElement.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, group->numVertices,
-							group->numIndices, matElement.renderElement);
+						// Only elements whose render elements changed will re-generate their geometry. This must be done
+						// serially as elements can share state used for generating geometry (e.g. the input caret).
+						matElement.element->_updateCachedGeometry();
 
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, numVertices, numIndices, meshType);
+						const GUIRenderElementGeometry& geometry = 
+							matElement.element->_getCachedGeometry(matElement.renderElement);
 
-						UINT32 indexStart = indexOffset;
-						UINT32 indexEnd = indexStart + numIndices;
+						GUIGeometryCopy copy;
+						copy.element = matElement.element;
+						copy.renderElement = matElement.renderElement;
+						copy.vertices = vertices + vertexOffset * vertexSize;
+						copy.indices = indices + indexOffset;
+						copy.vertexSize = vertexSize;
+						copy.baseVertex = vertexOffset;
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[i] += vertexOffset;
+						geometryCopies.push_back(copy);
 
-						indexOffset += numIndices;
-						vertexOffset += numVertices;
+						indexOffset += geometry.numIndices;
+						vertexOffset += geometry.numVertices;
 					}
 
-					if (group->meshType == GUIMeshType::Triangle)
-						guiMeshData.mesh = mTriangleMeshHeap->alloc(meshData);
-					else // Line
-						guiMeshData.mesh = mLineMeshHeap->alloc(meshData, DOT_LINE_LIST);
+					assert(vertexOffset == group->numVertices && indexOffset == group->numIndices);
+				}
+
+				// Assemble the meshes from cached geometry. Each job writes to its own portion of the mesh buffers.
+				TaskScheduler::instance().parallelFor(0, (UINT32)geometryCopies.size(), GUI_COPY_ELEMENTS_PER_JOB, 
+					[&geometryCopies](UINT32 begin, UINT32 end)
+				{
+					for (UINT32 i = begin; i < end; i++)
+					{
+						const GUIGeometryCopy& copy = geometryCopies[i];
+						const GUIRenderElementGeometry& geometry = copy.element->_getCachedGeometry(copy.renderElement);
+
+						const UINT8* srcVertices = copy.element->_getCachedVertices() + geometry.vertexOffset;
+						memcpy(copy.vertices, srcVertices, geometry.numVertices * copy.vertexSize);
 
-					meshIdx++;
+						const UINT32* srcIndices = copy.element->_getCachedIndices() + geometry.indexOffset;
+						for (UINT32 j = 0; j < geometry.numIndices; j++)
+							copy.indices[j] = srcIndices[j] + copy.baseVertex;
+					}
+				});
+
+				for(UINT32 meshIdx = 0; meshIdx < numMeshes; meshIdx++)
+				{
+					if (newMeshData[meshIdx] == nullptr)
+						continue;
+
+					if (!newMeshes[meshIdx].isLine)
+						newMeshes[meshIdx].mesh = mTriangleMeshHeap->alloc(newMeshData[meshIdx]);
+					else
+						newMeshes[meshIdx].mesh = mLineMeshHeap->alloc(newMeshData[meshIdx], DOT_LINE_LIST);
 				}
+
+				gProfilerCPU().endSample(PROFILE_SAMPLE_ID("GUIFillBuffers"));
+
+				renderData.cachedMeshes = std::move(newMeshes);
 			}
 
 			bs_frame_clear();			
@@ -48,6 +48,14 @@ namespace bs
 			Dragging
 		};
 
+		/** Information about a single render element whose geometry is contained in a GUI mesh. */
+		struct GUIMeshElement
+		{
+			GUIElement* element;
+			UINT32 renderElement;
+			UINT64 version;
+		};
+
 		/** Data required for rendering a single GUI mesh. */
 		struct GUIMeshData
 		{
@@ -56,6 +64,13 @@ namespace bs
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
 			bool isLine;
+
+			/** 
+			 * Render elements the mesh was built from, in order. Used for determining if the mesh can be re-used when
+			 * the batches are rebuilt. Element pointers are only compared, never dereferenced, as the elements might have
+			 * been destroyed since.
+			 */
+			Vector<GUIMeshElement> elements;
 		};
 
 		/**	GUI render data for a single viewport. */
@@ -0,0 +1,168 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsGUIBenchmarkSuite.h"
+#include "BsApplication.h"
+#include "Components/BsCCamera.h"
+#include "CoreThread/BsCoreThread.h"
+#include "GUI/BsCGUIWidget.h"
+#include "GUI/BsGUIButton.h"
+#include "GUI/BsGUIContent.h"
+#include "GUI/BsGUILabel.h"
+#include "GUI/BsGUIManager.h"
+#include "GUI/BsGUIPanel.h"
+#include "GUI/BsGUIScrollArea.h"
+#include "Localization/BsHString.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "RenderAPI/BsViewport.h"
+#include "Resources/BsBuiltinResources.h"
+#include "Scene/BsSceneObject.h"
+
+namespace bs
+{
+	/** Number of labels, and separately of buttons, in the scroll area. */
+	static const UINT32 NUM_ELEMENTS = 10000;
+	static const UINT32 NUM_RUNS = 20;
+
+	/** Profiler samples recorded by GUIManager::update() for each of its phases. */
+	static const char* PHASE_SAMPLES[] = { "UpdateLayout", "GUIBatching", "GUIFillBuffers" };
+	static const UINT32 NUM_PHASES = sizeof(PHASE_SAMPLES) / sizeof(PHASE_SAMPLES[0]);
+
+	/** Returns the total time of all samples with the provided name in the sample hierarchy, in milliseconds. */
+	static double findSampleTimeMs(const CPUProfilerBasicSamplingEntry& entry, const char* name)
+	{
+		if (entry.data.name == name)
+			return entry.data.totalTimeMs;
+
+		double totalTimeMs = 0.0;
+		for (auto& child : entry.childEntries)
+			totalTimeMs += findSampleTimeMs(child, name);
+
+		return totalTimeMs;
+	}
+
+	GUIBenchmarkSuite::GUIBenchmarkSuite()
+	{
+		BS_ADD_TEST(GUIBenchmarkSuite::BenchmarkIdle);
+		BS_ADD_TEST(GUIBenchmarkSuite::BenchmarkScroll);
+		BS_ADD_TEST(GUIBenchmarkSuite::BenchmarkTextChange);
+	}
+
+	void GUIBenchmarkSuite::startUp()
+	{
+		mSceneObject = SceneObject::create("GUIBenchmark");
+
+		// Overlay only camera, same as the one used for GUI in the examples
+		HCamera camera = mSceneObject->addComponent<CCamera>(gApplication().getPrimaryWindow());
+		camera->getRenderSettings()->overlayOnly = true;
+		camera->setLayers(0);
+		camera->getViewport()->setRequiresClear(false, false, false);
+
+		HGUIWidget widget = mSceneObject->addComponent<CGUIWidget>(camera);
+		widget->setSkin(BuiltinResources::instance().getGUISkin());
+
+		mScrollArea = GUIScrollArea::create();
+		widget->getPanel()->addElement(mScrollArea);
+
+		GUILayout& layout = mScrollArea->getLayout();
+		mLabels.resize(NUM_ELEMENTS);
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			mLabels[i] = GUILabel::create(HString(L"Benchmark label"));
+			layout.addElement(mLabels[i]);
+			layout.addElement(GUIButton::create(HString(L"Benchmark button")));
+		}
+
+		// First update builds all the geometry, which isn't what the benchmarks are interested in
+		GUIManager::instance().update();
+		gCoreThread().submitAll(true);
+	}
+
+	void GUIBenchmarkSuite::shutDown()
+	{
+		mLabels.clear();
+		mScrollArea = nullptr;
+
+		mSceneObject->destroy(true);
+		gCoreThread().submitAll(true);
+	}
+
+	void GUIBenchmarkSuite::BenchmarkIdle()
+	{
+		measureUpdate("No changes", NUM_RUNS, nullptr);
+	}
+
+	void GUIBenchmarkSuite::BenchmarkScroll()
+	{
+		measureUpdate("Scroll", NUM_RUNS, [&](UINT32 runIdx)
+		{
+			mScrollArea->scrollToVertical((runIdx + 1) / (float)NUM_RUNS);
+		});
+
+		mScrollArea->scrollToVertical(0.0f);
+	}
+
+	void GUIBenchmarkSuite::BenchmarkTextChange()
+	{
+		HString texts[] = { HString(L"Benchmark label"), HString(L"Changed benchmark label") };
+
+		measureUpdate("Text change, 1% of labels", NUM_RUNS, [&](UINT32 runIdx)
+		{
+			// Every run changes a different set of labels
+			const HString& text = texts[(runIdx + 1) % 2];
+			for (UINT32 i = runIdx % 100; i < NUM_ELEMENTS; i += 100)
+				mLabels[i]->setContent(GUIContent(text));
+		});
+	}
+
+	void GUIBenchmarkSuite::measureUpdate(const String& name, UINT32 numRuns,
+		const std::function<void(UINT32)>& change)
+	{
+		Vector<double> phaseTimes[NUM_PHASES];
+
+		UINT32 runIdx = 0;
+		bool profiling = false;
+
+		// Collects the phase timings of the previous run, if any
+		auto endProfiling = [&]()
+		{
+			if (!profiling)
+				return;
+
+			gProfilerCPU().endThread();
+			CPUProfilerReport profilerReport = gProfilerCPU().generateReport();
+
+			for (UINT32 i = 0; i < NUM_PHASES; i++)
+				phaseTimes[i].push_back(findSampleTimeMs(profilerReport.getBasicSamplingData(), PHASE_SAMPLES[i]));
+
+			profiling = false;
+		};
+
+		measure(name, numRuns, NUM_ELEMENTS * 2, []() { GUIManager::instance().update(); }, [&]()
+		{
+			endProfiling();
+
+			if (change)
+				change(runIdx);
+
+			runIdx++;
+
+			// Don't let the core thread queue grow between runs, or the core thread run concurrently with the update
+			gCoreThread().submitAll(true);
+
+			gProfilerCPU().beginThread("GUIBenchmark");
+			profiling = true;
+		});
+
+		endProfiling();
+
+		for (UINT32 i = 0; i < NUM_PHASES; i++)
+		{
+			std::sort(phaseTimes[i].begin(), phaseTimes[i].end());
+
+			StringStream output;
+			output << std::fixed << std::setprecision(1) << "median " << phaseTimes[i][numRuns / 2] * 1000.0 << " us";
+
+			report(name + ", " + PHASE_SAMPLES[i], output.str());
+		}
+	}
+}
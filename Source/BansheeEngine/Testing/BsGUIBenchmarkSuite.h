@@ -0,0 +1,57 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Engine
+	 *  @{
+	 */
+
+	/**
+	 * Measures GUI updates of a widget containing a scroll area with a large number of labels and buttons. Apart from
+	 * the total update time, the time spent in layout, batching and vertex fill is reported separately.
+	 *
+	 * @note	Requires a running Application, as GUI needs a camera, a render target and the builtin GUI skin.
+	 */
+	class GUIBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		GUIBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Updates the GUI without any changes since the last update. */
+		void BenchmarkIdle();
+
+		/** Scrolls the scroll area before every update, moving all of its elements. */
+		void BenchmarkScroll();
+
+		/** Changes the text of one in a hundred labels before every update. */
+		void BenchmarkTextChange();
+
+		/**
+		 * Runs GUIManager::update() multiple times and reports its timings, followed by median times of the layout,
+		 * batching and vertex fill profiler samples.
+		 *
+		 * @param[in]	name		Name of the measured case, as displayed in the output.
+		 * @param[in]	numRuns		Number of updates to measure.
+		 * @param[in]	change		Callback that modifies the GUI before every update, excluded from the measured time.
+		 */
+		void measureUpdate(const String& name, UINT32 numRuns, const std::function<void(UINT32)>& change);
+
+		HSceneObject mSceneObject;
+		GUIScrollArea* mScrollArea = nullptr;
+		Vector<GUILabel*> mLabels;
+	};
+
+	/** @} */
+}
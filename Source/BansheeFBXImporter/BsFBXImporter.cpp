@@ -183,6 +183,9 @@ namespace bs
 			Vector<ImportedAnimationEvents> events = meshImportOptions->getAnimationEvents();
 			for(auto& entry : animationClips)
 			{
+				if (meshImportOptions->getAnimationCompression())
+					entry.curves->compress(entry.sampleRate, meshImportOptions->getAnimationCompressionTolerance());
+
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
 				
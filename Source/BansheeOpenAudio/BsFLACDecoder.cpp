@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsFLACDecoder.h"
 #include "FileSystem/BsDataStream.h"
+#include "Audio/BsAudioUtility.h"
 
 namespace bs
 {
@@ -73,37 +74,43 @@ namespace bs
 			return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 
 		UINT32 bytesPerSample = data->info.bitDepth / 8;
-		
-		// If we received more data than we need, store it in the overflow buffer
-		UINT32 frameSamples = frame->header.blocksize * frame->header.channels;
-		if (data->samplesToRead < frameSamples)
-		{
-			UINT32 numExtraSamples = frameSamples - data->samplesToRead;
-			UINT32 extraBytes = numExtraSamples * bytesPerSample;
-			data->overflow.reserve(extraBytes);
-		}
+		UINT32 numChannels = frame->header.channels;
+		UINT32 numFrames = frame->header.blocksize;
+
+		assert(bytesPerSample <= 4 && numChannels <= FLAC__MAX_CHANNELS);
+
+		// Whole frames that fit in the output are interleaved directly into it
+		UINT32 numOutputFrames = std::min(data->samplesToRead / numChannels, numFrames);
+		AudioUtility::interleave(buffer, data->output, data->info.bitDepth, numChannels, numOutputFrames);
+
+		data->output += numOutputFrames * numChannels * bytesPerSample;
+		data->samplesToRead -= numOutputFrames * numChannels;
+
+		// Remaining frames go to the overflow buffer
+		UINT32 numExtraFrames = numFrames - numOutputFrames;
+		if (numExtraFrames == 0)
+			return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+
+		const FLAC__int32* extraChannels[FLAC__MAX_CHANNELS];
+		for (UINT32 i = 0; i < numChannels; i++)
+			extraChannels[i] = buffer[i] + numOutputFrames;
+
+		UINT32 overflowOffset = (UINT32)data->overflow.size();
+		data->overflow.resize(overflowOffset + numExtraFrames * numChannels * bytesPerSample);
+
+		UINT8* extraData = data->overflow.data() + overflowOffset;
+		AudioUtility::interleave(extraChannels, extraData, data->info.bitDepth, numChannels, numExtraFrames);
 
-		assert(bytesPerSample <= 4);
-		for (UINT32 i = 0; i < frame->header.blocksize; i++)
+		// If the output ends in the middle of a frame, move the frame's first samples from the overflow buffer
+		if (data->samplesToRead > 0)
 		{
-			for (UINT32 j = 0; j < frame->header.channels; j++)
-			{
-				if (data->samplesToRead > 0)
-				{
-					memcpy(data->output, &buffer[j][i], bytesPerSample);
-					
-					data->output += bytesPerSample;
-					data->samplesToRead--;
-				}
-				else
-				{
-					UINT8 sample[4];
-					memcpy(sample, &buffer[j][i], bytesPerSample);
-
-					for(UINT32 k = 0; k < bytesPerSample; k++)
-						data->overflow.push_back(sample[k]);
-				}
-			}
+			UINT32 partialSize = data->samplesToRead * bytesPerSample;
+			memcpy(data->output, extraData, partialSize);
+
+			data->output += partialSize;
+			data->samplesToRead = 0;
+			data->overflow.erase(data->overflow.begin() + overflowOffset,
+				data->overflow.begin() + overflowOffset + partialSize);
 		}
 
 		return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsWaveDecoder.h"
 #include "FileSystem/BsDataStream.h"
+#include "Audio/BsAudioUtility.h"
 
 namespace bs
 {
@@ -51,13 +52,7 @@ namespace bs
 		UINT32 numRead = (UINT32)mStream->read(samples, numSamples * mBytesPerSample);
 
 		if(mBytesPerSample == 1) // 8-bit samples are stored as unsigned, but engine convention is to store all bit depths as signed
-		{
-			for(UINT32 i = 0; i < numRead; i++)
-			{
-				INT8 val = samples[i] - 128;
-				samples[i] = *((UINT8*)&val);
-			}
-		}
+			AudioUtility::convertUnsigned8ToSigned(samples, numRead);
 
 		return numRead;
 	}
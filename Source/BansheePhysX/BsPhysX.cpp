@@ -282,28 +282,6 @@ namespace bs
 		}
 	};
 
-	class PhysXCPUDispatcher : public PxCpuDispatcher
-	{
-	public:
-		void submitTask(PxBaseTask& physxTask) override
-		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
-
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
-
-			TaskScheduler::instance().addTask(task);
-		}
-
-		PxU32 getWorkerCount() const override
-		{
-			return (PxU32)TaskScheduler::instance().getNumWorkers();
-		}
-	};
-
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
 	{
 		void onObjectOutOfBounds(PxShape& shape, PxActor& actor) override
@@ -450,9 +428,61 @@ namespace bs
 		}
 	};
 
+	/** Overlap query callback that outputs components of the found colliders into a caller provided buffer. */
+	struct PhysXOverlapBatchCallback : PxOverlapCallback
+	{
+		static const int MAX_HITS = 32;
+		PxOverlapHit buffer[MAX_HITS];
+
+		HCollider* output;
+		UINT32 capacity;
+		UINT32 count = 0;
+
+		PhysXOverlapBatchCallback(HCollider* output, UINT32 capacity)
+			:PxOverlapCallback(buffer, MAX_HITS), output(output), capacity(capacity)
+		{ }
+
+		PxAgain processTouches(const PxOverlapHit* buffer, PxU32 nbHits) override
+		{
+			for (PxU32 i = 0; i < nbHits && count < capacity; i++)
+			{
+				Collider* collider = (Collider*)buffer[i].shape->userData;
+				if (collider == nullptr)
+					continue;
+
+				CCollider* component = (CCollider*)collider->_getOwner(PhysicsOwnerType::Component);
+				if (component == nullptr)
+					continue;
+
+				output[count++] = component->getHandle();
+			}
+
+			return count < capacity;
+		}
+	};
+
+	/** Converts a shape used by batched queries into PhysX geometry and its transform. */
+	void toPxGeometry(const PhysicsQueryShape& shape, PxGeometryHolder& geometry, PxTransform& transform)
+	{
+		switch (shape.type)
+		{
+		case PhysicsQueryShapeType::Box:
+			geometry.storeAny(PxBoxGeometry(toPxVector(shape.size)));
+			transform = toPxTransform(shape.position, shape.rotation);
+			break;
+		case PhysicsQueryShapeType::Sphere:
+			geometry.storeAny(PxSphereGeometry(shape.size.x));
+			transform = toPxTransform(shape.position, Quaternion::IDENTITY);
+			break;
+		case PhysicsQueryShapeType::Capsule:
+			geometry.storeAny(PxCapsuleGeometry(shape.size.x, shape.size.y));
+			transform = toPxTransform(shape.position, shape.rotation);
+			break;
+		}
+	}
+
 	static PhysXAllocator gPhysXAllocator;
 	static PhysXErrorCallback gPhysXErrorHandler;
-	static PhysXCPUDispatcher gPhysXCPUDispatcher;
 	static PhysXEventCallback gPhysXEventCallback;
 	static PhysXBroadPhaseCallback gPhysXBroadphaseCallback;
 
@@ -460,6 +490,9 @@ namespace bs
 	const UINT32 PhysX::SCRATCH_BUFFER_SIZE = SIZE_16K * 64; // 1MB by default
 	const UINT32 PhysX::MAX_ITERATIONS_PER_FRAME = 4; // At 60 physics updates per second this would mean user is running at 15fps
 
+	/** Minimum number of queries executed by a single job when executing a batch of scene queries. */
+	static const UINT32 QUERY_BATCH_GRANULARITY = 64;
+
 	PhysX::PhysX(const PHYSICS_INIT_DESC& input)
 		:Physics(input)
 	{
@@ -480,9 +513,12 @@ namespace bs
 			mCooking = PxCreateCooking(PX_PHYSICS_VERSION, *mFoundation, cookingParams);
 		}
 
+		mCPUDispatcher = bs_new<PhysXCPUDispatcher>(input.numWorkerThreads, input.taskQueueSize);
+		mScratchBuffer = (UINT8*)bs_alloc_aligned16(SCRATCH_BUFFER_SIZE);
+
 		PxSceneDesc sceneDesc(mScale); // TODO - Test out various other parameters provided by scene desc
 		sceneDesc.gravity = toPxVector(input.gravity);
-		sceneDesc.cpuDispatcher = &gPhysXCPUDispatcher;
+		sceneDesc.cpuDispatcher = mCPUDispatcher;
 		sceneDesc.filterShader = PhysXFilterShader;
 		sceneDesc.simulationEventCallback = &gPhysXEventCallback;
 		sceneDesc.broadPhaseCallback = &gPhysXBroadphaseCallback;
@@ -508,9 +544,17 @@ namespace bs
 
 	PhysX::~PhysX()
 	{
+		waitForSimulation();
+
+		for (auto& entry : mInterpolatedRigidbodies)
+			entry.rigidbody->_setInterpolationIdx((UINT32)-1);
+
 		mCharManager->release();
 		mScene->release();
 
+		bs_delete(mCPUDispatcher);
+		bs_free_aligned16(mScratchBuffer);
+
 		if (mCooking != nullptr)
 			mCooking->release();
 
@@ -525,80 +569,240 @@ namespace bs
 
 		mUpdateInProgress = true;
 
+		bool async = mFlags.isSet(PhysicsFlag::AsyncSimulation);
+		bool hasResults = false;
+
+		// Retrieve the results of the step that was running in parallel with the rest of the previous frame
+		if (mSimulationInProgress)
+		{
+			if (endStep() && async)
+				recordInterpolatedTransforms();
+
+			hasResults = true;
+		}
+
 		float nextFrameTime = mSimulationTime + mSimulationStep;
 		mFrameTime += gTime().getFrameDelta();
 
-		if(mFrameTime < nextFrameTime)
+		if(mFrameTime >= nextFrameTime)
 		{
-			// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
-			return;
-		}
+			float simulationAmount = std::max(mFrameTime - mSimulationTime, mSimulationStep); // At least one step
+			INT32 numIterations = Math::floorToInt(simulationAmount / mSimulationStep);
 
-		float simulationAmount = std::max(mFrameTime - mSimulationTime, mSimulationStep); // At least one step
-		INT32 numIterations = Math::floorToInt(simulationAmount / mSimulationStep);
+			// If too many iterations are required, increase time step. This should only happen in extreme situations (or
+			// when debugging).
+			float step = mSimulationStep;
+			if (numIterations > MAX_ITERATIONS_PER_FRAME)
+				step = (simulationAmount / MAX_ITERATIONS_PER_FRAME) * 0.99f;
 
-		// If too many iterations are required, increase time step. This should only happen in extreme situations (or when
-		// debugging).
-		float step = mSimulationStep;
-		if (numIterations > MAX_ITERATIONS_PER_FRAME) 
-			step = (simulationAmount / MAX_ITERATIONS_PER_FRAME) * 0.99f;
+			while (simulationAmount >= step) // In case we're running really slow multiple updates might be needed
+			{
+				beginStep(step);
+				simulationAmount -= step;
+				mSimulationTime += step;
 
-		UINT32 iterationCount = 0;
-		while (simulationAmount >= step) // In case we're running really slow multiple updates might be needed
-		{
-			// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-			//       able to run parallel to the simulation thread, but at a cost to input latency.
+				// In async mode the last step keeps running in parallel with the rest of the frame, and its results are
+				// retrieved during the next update
+				if (async && simulationAmount < step)
+					break;
+
+				if (endStep())
+				{
+					if (async)
+						recordInterpolatedTransforms();
+
+					hasResults = true;
+				}
+			}
+		}
 
-			bs_frame_mark();
-			UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+		if (async)
+			applyInterpolatedTransforms();
+		else if (!mInterpolatedRigidbodies.empty()) // Async simulation was just turned off
+			clearInterpolatedTransforms();
 
-			mScene->simulate(step, nullptr, scratchBuffer, SCRATCH_BUFFER_SIZE);
-			simulationAmount -= step;
-			mSimulationTime += step;
+		if (!async && hasResults)
+		{
+			// Update rigidbodies with new transforms
+			PxU32 numActiveTransforms;
+			const PxActiveTransform* activeTransforms = mScene->getActiveTransforms(numActiveTransforms);
 
-			UINT32 errorState;
-			if(!mScene->fetchResults(true, &errorState))
+			for (PxU32 i = 0; i < numActiveTransforms; i++)
 			{
-				LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
+				Rigidbody* rigidbody = static_cast<Rigidbody*>(activeTransforms[i].userData);
 
-				bs_frame_free_aligned(scratchBuffer);
-				bs_frame_clear();
+				// Note: This should never happen, as actors gets their userData set to null when they're destroyed.
+				// However in some cases PhysX seems to keep those actors alive for a frame or few, and reports their
+				// state here. Until I find out why I need to perform this check.
+				if(activeTransforms[i].actor->userData == nullptr)
+					continue;
 
-				iterationCount++;
-				continue;
+				const PxTransform& transform = activeTransforms[i].actor2World;
+
+				// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination
+				//       directly, use non-temporal writes
+				rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
 			}
+		}
+
+		mUpdateInProgress = false;
+
+		triggerEvents();
+	}
+
+	void PhysX::beginStep(float step)
+	{
+		mCPUDispatcher->beginStep();
+		mScene->simulate(step, nullptr, mScratchBuffer, SCRATCH_BUFFER_SIZE);
+
+		mSimulationInProgress = true;
+	}
+
+	bool PhysX::endStep()
+	{
+		UINT32 errorState;
+		bool succeeded = mScene->fetchResults(true, &errorState);
 
-			bs_frame_free_aligned(scratchBuffer);
-			bs_frame_clear();
+		mTaskStats = mCPUDispatcher->endStep();
+		mSimulationInProgress = false;
 
-			iterationCount++;
+		if(!succeeded)
+		{
+			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
+			return false;
+		}
+
+		return true;
+	}
+
+	void PhysX::waitForSimulation()
+	{
+		if (!mSimulationInProgress)
+			return;
+
+		// Events and transforms will be sent out during the next update
+		if (endStep() && mFlags.isSet(PhysicsFlag::AsyncSimulation))
+			recordInterpolatedTransforms();
+	}
+
+	void PhysX::recordInterpolatedTransforms()
+	{
+		const UINT32 NUM_STEPS = PhysicsStepInterpolation::NUM_STEPS;
+
+		mStepInterpolation.addStep(mSimulationTime);
+		mNumCompletedSteps++;
+
+		// Rigidbodies that didn't move during this step stay where they were at the end of the previous one
+		for (auto& entry : mInterpolatedRigidbodies)
+		{
+			for (UINT32 i = 1; i < NUM_STEPS; i++)
+			{
+				entry.positions[i - 1] = entry.positions[i];
+				entry.rotations[i - 1] = entry.rotations[i];
+			}
 		}
 
-		// Update rigidbodies with new transforms
 		PxU32 numActiveTransforms;
 		const PxActiveTransform* activeTransforms = mScene->getActiveTransforms(numActiveTransforms);
 
 		for (PxU32 i = 0; i < numActiveTransforms; i++)
 		{
-			Rigidbody* rigidbody = static_cast<Rigidbody*>(activeTransforms[i].userData);
-
-			// Note: This should never happen, as actors gets their userData set to null when they're destroyed. However
-			// in some cases PhysX seems to keep those actors alive for a frame or few, and reports their state here. Until
-			// I find out why I need to perform this check.
-			if(activeTransforms[i].actor->userData == nullptr)
+			// See the note in update() about actors that were already destroyed
+			if (activeTransforms[i].actor->userData == nullptr)
 				continue;
 
+			PhysXRigidbody* rigidbody = static_cast<PhysXRigidbody*>(activeTransforms[i].userData);
 			const PxTransform& transform = activeTransforms[i].actor2World;
 
-			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
-			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+			UINT32 idx = rigidbody->_getInterpolationIdx();
+			if (idx == (UINT32)-1)
+			{
+				idx = (UINT32)mInterpolatedRigidbodies.size();
+				rigidbody->_setInterpolationIdx(idx);
+
+				// Rigidbody just started moving, there is no earlier state to interpolate from
+				InterpolatedRigidbody entry;
+				entry.rigidbody = rigidbody;
+
+				for (UINT32 i = 0; i < NUM_STEPS; i++)
+				{
+					entry.positions[i] = fromPxVector(transform.p);
+					entry.rotations[i] = fromPxQuaternion(transform.q);
+				}
+
+				mInterpolatedRigidbodies.push_back(entry);
+			}
+
+			InterpolatedRigidbody& entry = mInterpolatedRigidbodies[idx];
+			entry.positions[NUM_STEPS - 1] = fromPxVector(transform.p);
+			entry.rotations[NUM_STEPS - 1] = fromPxQuaternion(transform.q);
+			entry.lastActiveStep = mNumCompletedSteps;
 		}
+	}
 
-		// Note: Consider extrapolating for the remaining "simulationAmount" value
-		mUpdateInProgress = false;
+	void PhysX::applyInterpolatedTransforms()
+	{
+		UINT32 first = 0;
+		float t = mStepInterpolation.evaluate(mFrameTime, mSimulationStep, first);
 
-		triggerEvents();
+		UINT32 idx = 0;
+		while (idx < (UINT32)mInterpolatedRigidbodies.size())
+		{
+			const InterpolatedRigidbody& entry = mInterpolatedRigidbodies[idx];
+
+			Vector3 position = Vector3::lerp(t, entry.positions[first], entry.positions[first + 1]);
+			Quaternion rotation = Quaternion::lerp(t, entry.rotations[first], entry.rotations[first + 1]);
+			entry.rigidbody->_setTransform(position, rotation);
+
+			// All recorded transforms are the same if the rigidbody didn't move during any step but the oldest one, so
+			// it has now reached its final transform
+			if ((mNumCompletedSteps - entry.lastActiveStep) >= (PhysicsStepInterpolation::NUM_STEPS - 1))
+				removeInterpolatedRigidbody(idx);
+			else
+				idx++;
+		}
+	}
+
+	void PhysX::clearInterpolatedTransforms()
+	{
+		const UINT32 last = PhysicsStepInterpolation::NUM_STEPS - 1;
+		for (auto& entry : mInterpolatedRigidbodies)
+		{
+			entry.rigidbody->_setTransform(entry.positions[last], entry.rotations[last]);
+			entry.rigidbody->_setInterpolationIdx((UINT32)-1);
+		}
+
+		mInterpolatedRigidbodies.clear();
+	}
+
+	void PhysX::removeInterpolatedRigidbody(UINT32 idx)
+	{
+		mInterpolatedRigidbodies[idx].rigidbody->_setInterpolationIdx((UINT32)-1);
+
+		UINT32 lastIdx = (UINT32)mInterpolatedRigidbodies.size() - 1;
+		if (idx != lastIdx)
+		{
+			mInterpolatedRigidbodies[idx] = mInterpolatedRigidbodies[lastIdx];
+			mInterpolatedRigidbodies[idx].rigidbody->_setInterpolationIdx(idx);
+		}
+
+		mInterpolatedRigidbodies.pop_back();
+	}
+
+	void PhysX::_notifyRigidbodyDestroyed(PhysXRigidbody* rigidbody)
+	{
+		removeInterpolatedRigidbody(rigidbody->_getInterpolationIdx());
+	}
+
+	void PhysX::_notifyRigidbodyTeleported(PhysXRigidbody* rigidbody, const Vector3& position,
+		const Quaternion& rotation)
+	{
+		InterpolatedRigidbody& entry = mInterpolatedRigidbodies[rigidbody->_getInterpolationIdx()];
+		for (UINT32 i = 0; i < PhysicsStepInterpolation::NUM_STEPS; i++)
+		{
+			entry.positions[i] = position;
+			entry.rotations[i] = rotation;
+		}
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -1139,10 +1343,128 @@ namespace bs
 		return output.data;
 	}
 
+	template<class F>
+	UINT32 PhysX::executeQueryBatch(UINT32 numQueries, const F& func) const
+	{
+		if (!TaskScheduler::isStarted() || numQueries <= QUERY_BATCH_GRANULARITY)
+			return func(0, numQueries);
+
+		// Apply any pending changes to the scene query structures up front, so the workers don't contend over them
+		if (!mSimulationInProgress)
+			mScene->flushQueryUpdates();
+
+		std::atomic<UINT32> numResults(0);
+		TaskScheduler::instance().parallelFor(0, numQueries, QUERY_BATCH_GRANULARITY,
+			[&func, &numResults](UINT32 begin, UINT32 end)
+		{
+			numResults.fetch_add(func(begin, end), std::memory_order_relaxed);
+		});
+
+		return numResults.load();
+	}
+
+	UINT32 PhysX::rayCastBatch(const PhysicsRayQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+		UINT64 layer) const
+	{
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		auto executeQueries = [&](UINT32 begin, UINT32 end)
+		{
+			UINT32 numHits = 0;
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const PhysicsRayQuery& query = queries[i];
+				hits[i] = PhysicsQueryHit();
+
+				PxRaycastBuffer output;
+				bool wasHit = mScene->raycast(toPxVector(query.origin), toPxVector(query.unitDir), query.max, output,
+					PxHitFlag::eDEFAULT | PxHitFlag::eUV, filterData);
+
+				if (wasHit)
+				{
+					parseHit(output.block, hits[i]);
+					numHits++;
+				}
+			}
+
+			return numHits;
+		};
+
+		return executeQueryBatch(numQueries, executeQueries);
+	}
+
+	UINT32 PhysX::sweepBatch(const PhysicsSweepQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+		UINT64 layer) const
+	{
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		auto executeQueries = [&](UINT32 begin, UINT32 end)
+		{
+			UINT32 numHits = 0;
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const PhysicsSweepQuery& query = queries[i];
+				hits[i] = PhysicsQueryHit();
+
+				PxGeometryHolder geometry;
+				PxTransform transform;
+				toPxGeometry(query.shape, geometry, transform);
+
+				PxSweepBuffer output;
+				bool wasHit = mScene->sweep(geometry.any(), transform, toPxVector(query.unitDir), query.max, output,
+					PxHitFlag::eDEFAULT | PxHitFlag::eUV, filterData);
+
+				if (wasHit)
+				{
+					parseHit(output.block, hits[i]);
+					numHits++;
+				}
+			}
+
+			return numHits;
+		};
+
+		return executeQueryBatch(numQueries, executeQueries);
+	}
+
+	UINT32 PhysX::overlapBatch(const PhysicsQueryShape* shapes, UINT32 numQueries, HCollider* colliders,
+		UINT32 maxCollidersPerQuery, UINT32* numColliders, UINT64 layer) const
+	{
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		auto executeQueries = [&](UINT32 begin, UINT32 end)
+		{
+			UINT32 numFound = 0;
+			for (UINT32 i = begin; i < end; i++)
+			{
+				PxGeometryHolder geometry;
+				PxTransform transform;
+				toPxGeometry(shapes[i], geometry, transform);
+
+				PhysXOverlapBatchCallback output(colliders + i * maxCollidersPerQuery, maxCollidersPerQuery);
+				if (maxCollidersPerQuery > 0)
+					mScene->overlap(geometry.any(), transform, output, filterData);
+
+				numColliders[i] = output.count;
+				numFound += output.count;
+			}
+
+			return numFound;
+		};
+
+		return executeQueryBatch(numQueries, executeQueries);
+	}
+
 	void PhysX::setFlag(PhysicsFlags flag, bool enabled)
 	{
 		Physics::setFlag(flag, enabled);
 
+		if (!mFlags.isSet(PhysicsFlag::AsyncSimulation))
+			waitForSimulation();
+
 		mCharManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
 		mCharManager->setPreciseSweeps(mFlags.isSet(PhysicsFlag::CCT_PreciseSweeps));
 		mCharManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
@@ -1150,6 +1472,9 @@ namespace bs
 
 	void PhysX::setPaused(bool paused)
 	{
+		if (paused)
+			waitForSimulation();
+
 		mPaused = paused;
 	}
 
@@ -1160,6 +1485,7 @@ namespace bs
 
 	void PhysX::setGravity(const Vector3& gravity)
 	{
+		waitForSimulation();
 		mScene->setGravity(toPxVector(gravity));
 	}
 
@@ -1172,6 +1498,8 @@ namespace bs
 
 	UINT32 PhysX::addBroadPhaseRegion(const AABox& region)
 	{
+		waitForSimulation();
+
 		UINT32 id = mNextRegionIdx++;
 
 		PxBroadPhaseRegion pxRegion;
@@ -1190,12 +1518,15 @@ namespace bs
 		if (iterFind == mBroadPhaseRegionHandles.end())
 			return;
 
+		waitForSimulation();
 		mScene->removeBroadPhaseRegion(iterFind->second);
 		mBroadPhaseRegionHandles.erase(iterFind);
 	}
 
 	void PhysX::clearBroadPhaseRegions()
 	{
+		waitForSimulation();
+
 		for(auto& entry : mBroadPhaseRegionHandles)
 			mScene->removeBroadPhaseRegion(entry.second);
 
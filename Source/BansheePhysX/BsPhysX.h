@@ -5,6 +5,7 @@
 #include "BsPhysXPrerequisites.h"
 #include "Physics/BsPhysics.h"
 #include "Physics/BsPhysicsCommon.h"
+#include "BsPhysXCPUDispatcher.h"
 #include "PxPhysics.h"
 #include "foundation/Px.h"
 #include "characterkinematic\PxControllerManager.h"
@@ -51,6 +52,17 @@ namespace bs
 			Joint* joint; /** Broken joint. */
 		};
 
+		/** Rigidbody whose transform is being interpolated between the results of the most recent simulation steps. */
+		struct InterpolatedRigidbody
+		{
+			PhysXRigidbody* rigidbody; /** Rigidbody whose transform to interpolate. */
+			/** Positions of the rigidbody at the end of the most recent simulation steps, from oldest to newest. */
+			Vector3 positions[PhysicsStepInterpolation::NUM_STEPS];
+			/** Rotations of the rigidbody at the end of the most recent simulation steps, from oldest to newest. */
+			Quaternion rotations[PhysicsStepInterpolation::NUM_STEPS];
+			UINT32 lastActiveStep; /** Index of the last simulation step during which the rigidbody moved. */
+		};
+
 	public:
 		PhysX(const PHYSICS_INIT_DESC& input);
 		~PhysX();
@@ -180,6 +192,18 @@ namespace bs
 		bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const override;
 
+		/** @copydoc Physics::rayCastBatch */
+		UINT32 rayCastBatch(const PhysicsRayQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const override;
+
+		/** @copydoc Physics::sweepBatch */
+		UINT32 sweepBatch(const PhysicsSweepQuery* queries, UINT32 numQueries, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const override;
+
+		/** @copydoc Physics::overlapBatch */
+		UINT32 overlapBatch(const PhysicsQueryShape* shapes, UINT32 numQueries, HCollider* colliders,
+			UINT32 maxCollidersPerQuery, UINT32* numColliders, UINT64 layer = BS_ALL_LAYERS) const override;
+
 		/** @copydoc Physics::setFlag */
 		void setFlag(PhysicsFlags flags, bool enabled) override;
 
@@ -235,6 +259,15 @@ namespace bs
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** Notifies the system that a rigidbody whose transform is being interpolated has been destroyed. */
+		void _notifyRigidbodyDestroyed(PhysXRigidbody* rigidbody);
+
+		/**
+		 * Notifies the system that a rigidbody whose transform is being interpolated has been teleported, so its
+		 * transform is no longer interpolated from the one it had before the teleport.
+		 */
+		void _notifyRigidbodyTeleported(PhysXRigidbody* rigidbody, const Vector3& position, const Quaternion& rotation);
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
@@ -250,12 +283,45 @@ namespace bs
 		/** Returns default scale used in the PhysX scene. */
 		physx::PxTolerancesScale getScale() const { return mScale; }
 
+		/** Returns information about the tasks executed during the last simulation step. */
+		const PhysXTaskStats& getTaskStats() const { return mTaskStats; }
+
 	private:
 		friend class PhysXEventCallback;
 
 		/** Sends out all events recorded during simulation to the necessary physics objects. */
 		void triggerEvents();
 
+		/** Starts simulating a single physics step. Simulation runs on the PhysX worker threads. */
+		void beginStep(float step);
+
+		/**
+		 * Blocks until the simulation step started by beginStep() completes and retrieves its results. Returns false if
+		 * the simulation failed.
+		 */
+		bool endStep();
+
+		/**
+		 * Blocks until the simulation step running in parallel with the rest of the frame completes, if any. Must be
+		 * called before performing operations that cannot be executed while the simulation is running.
+		 */
+		void waitForSimulation();
+
+		/** Records the results of the most recent simulation step for rigidbodies whose transforms are interpolated. */
+		void recordInterpolatedTransforms();
+
+		/**
+		 * Applies transforms interpolated between the results of recent simulation steps to the rigidbodies. Rigidbodies
+		 * that stopped moving are removed from the interpolation list.
+		 */
+		void applyInterpolatedTransforms();
+
+		/** Applies the most recent simulation results to interpolated rigidbodies and clears the interpolation list. */
+		void clearInterpolatedTransforms();
+
+		/** Removes the rigidbody at the specified index from the list of interpolated rigidbodies. */
+		void removeInterpolatedRigidbody(UINT32 idx);
+
 		/**
 		 * Helper method that performs a sweep query by checking if the provided geometry hits any physics objects
 		 * when moved along the specified direction. Returns information about the first hit.
@@ -285,9 +351,24 @@ namespace bs
 		/** Helper method that checks if the provided geometry overlaps any physics object. */
 		inline bool overlapAny(const physx::PxGeometry& geometry, const physx::PxTransform& tfrm, UINT64 layer) const;
 
+		/**
+		 * Executes a batch of queries in parallel chunks on the task scheduler, or on the calling thread if there are
+		 * too few queries to split.
+		 *
+		 * @param[in]	numQueries	Number of queries in the batch.
+		 * @param[in]	func		Callable with signature UINT32(UINT32 begin, UINT32 end) that executes queries in
+		 *							range [begin, end) and returns the number of results they found.
+		 * @return					Sum of the values returned by @p func for all chunks.
+		 */
+		template<class F>
+		UINT32 executeQueryBatch(UINT32 numQueries, const F& func) const;
+
 		float mSimulationStep = 1.0f/60.0f;
 		float mSimulationTime = 0.0f;
 		float mFrameTime = 0.0f;
+		PhysicsStepInterpolation mStepInterpolation;
+		UINT32 mNumCompletedSteps = 0;
+		bool mSimulationInProgress = false;
 		float mTesselationLength = 3.0f;
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
@@ -295,6 +376,7 @@ namespace bs
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
 		Vector<JointBreakEvent> mJointBreakEvents;
+		Vector<InterpolatedRigidbody> mInterpolatedRigidbodies;
 		UnorderedMap<UINT32, UINT32> mBroadPhaseRegionHandles;
 
 		physx::PxFoundation* mFoundation = nullptr;
@@ -302,6 +384,9 @@ namespace bs
 		physx::PxCooking* mCooking = nullptr;
 		physx::PxScene* mScene = nullptr;
 		physx::PxControllerManager* mCharManager = nullptr;
+		PhysXCPUDispatcher* mCPUDispatcher = nullptr;
+		UINT8* mScratchBuffer = nullptr;
+		PhysXTaskStats mTaskStats;
 
 		physx::PxMaterial* mDefaultMaterial = nullptr;
 		physx::PxTolerancesScale mScale;
@@ -0,0 +1,35 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCorePrerequisites.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsDynLibManager.h"
+#include "Physics/BsPhysicsManager.h"
+#include "Testing/BsPhysicsQueryBenchmarkSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(TaskScheduler::MAX_WORKERS + 16);
+	TaskScheduler::startUp();
+	DynLibManager::startUp();
+
+	// The plugin doesn't export its classes, so it's loaded the same way the application loads it
+	PhysicsManager::startUp("BansheePhysX", false);
+
+	SPtr<TestSuite> benchmarks = PhysicsQueryBenchmarkSuite::create<PhysicsQueryBenchmarkSuite>();
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	PhysicsManager::shutDown();
+	DynLibManager::shutDown();
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
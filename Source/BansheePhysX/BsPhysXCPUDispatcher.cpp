@@ -0,0 +1,225 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPhysXCPUDispatcher.h"
+#include "Utility/BsBitwise.h"
+
+using namespace physx;
+
+namespace bs
+{
+	/** Dispatcher owning the worker the current thread is running, if any. */
+	static BS_THREADLOCAL PhysXCPUDispatcher* sCurrentDispatcher = nullptr;
+
+	/** Index of the worker the current thread is running, if any. */
+	static BS_THREADLOCAL UINT32 sCurrentWorkerIdx = (UINT32)-1;
+
+	/**
+	 * Number of times an idle worker checks for new tasks before going to sleep. PhysX submits tasks in bursts as
+	 * earlier tasks complete, so waking up a sleeping thread for each burst would be too costly.
+	 */
+	static const UINT32 MAX_IDLE_SPINS = 256;
+
+	PhysXCPUDispatcher::PhysXCPUDispatcher(UINT32 numWorkers, UINT32 queueSize)
+		: mNextWorkerIdx(0), mNumQueuedTasks(0), mNumSleepingWorkers(0), mNumTasks(0), mNumStolenTasks(0)
+		, mNumOverflowTasks(0), mBusyTimeUs(0)
+	{
+		if (numWorkers == 0)
+			numWorkers = std::max((UINT32)BS_THREAD_HARDWARE_CONCURRENCY, 2U) - 1;
+
+		mNumWorkers = numWorkers;
+		mQueueSize = Bitwise::nextPow2(std::max(queueSize, 1U));
+
+		mWorkers = bs_newN<Worker>(mNumWorkers);
+		for (UINT32 i = 0; i < mNumWorkers; i++)
+			mWorkers[i].tasks = bs_newN<PxBaseTask*>(mQueueSize);
+
+		for (UINT32 i = 0; i < mNumWorkers; i++)
+			mWorkers[i].thread = bs_new<Thread>(std::bind(&PhysXCPUDispatcher::runWorker, this, i));
+	}
+
+	PhysXCPUDispatcher::~PhysXCPUDispatcher()
+	{
+		{
+			Lock lock(mSleepMutex);
+			mShutdown = true;
+			mWakeCond.notify_all();
+		}
+
+		for (UINT32 i = 0; i < mNumWorkers; i++)
+		{
+			mWorkers[i].thread->join();
+			bs_delete(mWorkers[i].thread);
+		}
+
+		for (UINT32 i = 0; i < mNumWorkers; i++)
+			bs_deleteN(mWorkers[i].tasks, mQueueSize);
+
+		bs_deleteN(mWorkers, mNumWorkers);
+	}
+
+	void PhysXCPUDispatcher::submitTask(PxBaseTask& task)
+	{
+		mNumTasks.fetch_add(1, std::memory_order_relaxed);
+
+		// Keep tasks submitted from a worker on the same worker, as they usually operate on the data the parent just
+		// finished processing
+		UINT32 workerIdx;
+		if (sCurrentDispatcher == this)
+			workerIdx = sCurrentWorkerIdx;
+		else
+			workerIdx = mNextWorkerIdx.fetch_add(1, std::memory_order_relaxed) % mNumWorkers;
+
+		// Count the task before it becomes visible, so the counter never underflows when a thief grabs it immediately
+		mNumQueuedTasks.fetch_add(1);
+
+		bool queued = false;
+		for (UINT32 i = 0; i < mNumWorkers && !queued; i++)
+			queued = pushTask((workerIdx + i) % mNumWorkers, &task);
+
+		if (!queued)
+		{
+			// All queues are full, execute on the calling thread rather than growing the queues
+			mNumQueuedTasks.fetch_sub(1);
+			mNumOverflowTasks.fetch_add(1, std::memory_order_relaxed);
+
+			task.run();
+			task.release();
+			return;
+		}
+
+		if (mNumSleepingWorkers.load() > 0)
+		{
+			Lock lock(mSleepMutex);
+			mWakeCond.notify_one();
+		}
+	}
+
+	void PhysXCPUDispatcher::beginStep()
+	{
+		mNumTasks.store(0, std::memory_order_relaxed);
+		mNumStolenTasks.store(0, std::memory_order_relaxed);
+		mNumOverflowTasks.store(0, std::memory_order_relaxed);
+		mBusyTimeUs.store(0, std::memory_order_relaxed);
+
+		mStepStartUs = getTimeUs();
+	}
+
+	PhysXTaskStats PhysXCPUDispatcher::endStep()
+	{
+		PhysXTaskStats stats;
+		stats.numTasks = mNumTasks.load(std::memory_order_relaxed);
+		stats.numStolenTasks = mNumStolenTasks.load(std::memory_order_relaxed);
+		stats.numOverflowTasks = mNumOverflowTasks.load(std::memory_order_relaxed);
+		stats.stepTimeUs = getTimeUs() - mStepStartUs;
+		stats.busyTimeUs = mBusyTimeUs.load(std::memory_order_relaxed);
+
+		UINT64 totalTimeUs = stats.stepTimeUs * mNumWorkers;
+		stats.idleTimeUs = totalTimeUs > stats.busyTimeUs ? totalTimeUs - stats.busyTimeUs : 0;
+
+		return stats;
+	}
+
+	bool PhysXCPUDispatcher::pushTask(UINT32 workerIdx, PxBaseTask* task)
+	{
+		Worker& worker = mWorkers[workerIdx];
+		ScopedSpinLock lock(worker.lock);
+
+		if (worker.count == mQueueSize)
+			return false;
+
+		worker.tasks[(worker.start + worker.count) & (mQueueSize - 1)] = task;
+		worker.count++;
+
+		return true;
+	}
+
+	PxBaseTask* PhysXCPUDispatcher::findTask(UINT32 workerIdx)
+	{
+		// Own queue, most recently queued task first as its data is most likely still in the cache
+		{
+			Worker& worker = mWorkers[workerIdx];
+			ScopedSpinLock lock(worker.lock);
+
+			if (worker.count > 0)
+			{
+				worker.count--;
+				mNumQueuedTasks.fetch_sub(1);
+
+				return worker.tasks[(worker.start + worker.count) & (mQueueSize - 1)];
+			}
+		}
+
+		// Steal the oldest task from other workers, starting with the one after us so thieves spread out
+		for (UINT32 i = 1; i < mNumWorkers; i++)
+		{
+			Worker& victim = mWorkers[(workerIdx + i) % mNumWorkers];
+			ScopedSpinLock lock(victim.lock);
+			if (victim.count == 0)
+				continue;
+
+			PxBaseTask* task = victim.tasks[victim.start];
+			victim.start = (victim.start + 1) & (mQueueSize - 1);
+			victim.count--;
+
+			mNumQueuedTasks.fetch_sub(1);
+			mNumStolenTasks.fetch_add(1, std::memory_order_relaxed);
+
+			return task;
+		}
+
+		return nullptr;
+	}
+
+	void PhysXCPUDispatcher::runWorker(UINT32 workerIdx)
+	{
+		sCurrentDispatcher = this;
+		sCurrentWorkerIdx = workerIdx;
+
+		UINT32 numIdleSpins = 0;
+		while (true)
+		{
+			PxBaseTask* task = findTask(workerIdx);
+			if (task != nullptr)
+			{
+				UINT64 startUs = getTimeUs();
+
+				task->run();
+				task->release();
+
+				mBusyTimeUs.fetch_add(getTimeUs() - startUs, std::memory_order_relaxed);
+				numIdleSpins = 0;
+				continue;
+			}
+
+			if (numIdleSpins < MAX_IDLE_SPINS)
+			{
+				numIdleSpins++;
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Nothing to do, sleep until new tasks are submitted
+			numIdleSpins = 0;
+
+			Lock lock(mSleepMutex);
+			mNumSleepingWorkers.fetch_add(1);
+
+			while (!mShutdown && mNumQueuedTasks.load() == 0)
+				mWakeCond.wait(lock);
+
+			mNumSleepingWorkers.fetch_sub(1);
+
+			if (mShutdown)
+				break;
+		}
+
+		sCurrentDispatcher = nullptr;
+		sCurrentWorkerIdx = (UINT32)-1;
+	}
+
+	UINT64 PhysXCPUDispatcher::getTimeUs()
+	{
+		using namespace std::chrono;
+		return (UINT64)duration_cast<microseconds>(high_resolution_clock::now().time_since_epoch()).count();
+	}
+}
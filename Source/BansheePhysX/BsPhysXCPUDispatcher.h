@@ -0,0 +1,107 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPhysXPrerequisites.h"
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+
+namespace bs
+{
+	/** @addtogroup PhysX
+	 *  @{
+	 */
+
+	/** Information about the tasks executed by PhysXCPUDispatcher during a single simulation step. */
+	struct PhysXTaskStats
+	{
+		UINT32 numTasks = 0; /**< Total number of tasks submitted by PhysX. */
+		UINT32 numStolenTasks = 0; /**< Number of tasks executed by a worker other than the one they were queued on. */
+		UINT32 numOverflowTasks = 0; /**< Number of tasks executed on the submitting thread because all queues were full. */
+		UINT64 stepTimeUs = 0; /**< Time elapsed between the start and the end of the step, in microseconds. */
+		UINT64 busyTimeUs = 0; /**< Time the workers spent executing tasks, summed over all workers, in microseconds. */
+		UINT64 idleTimeUs = 0; /**< Time the workers spent waiting for tasks, summed over all workers, in microseconds. */
+	};
+
+	/**
+	 * Executes tasks submitted by the PhysX simulation on a set of dedicated worker threads.
+	 *
+	 * @note
+	 * Each worker owns a fixed size queue of tasks, allocated up front. Tasks submitted from a worker are queued on its
+	 * own queue, while tasks submitted from other threads are distributed between the workers in a round robin fashion.
+	 * Idle workers steal tasks from other workers' queues. Submitting a task never allocates memory, which makes the
+	 * dispatcher suitable for the hundreds of fine grained tasks PhysX submits every step.
+	 */
+	class PhysXCPUDispatcher : public physx::PxCpuDispatcher
+	{
+		/** Information about a single worker thread. */
+		struct Worker
+		{
+			SpinLock lock;
+			physx::PxBaseTask** tasks = nullptr;
+			UINT32 start = 0;
+			UINT32 count = 0;
+			Thread* thread = nullptr;
+		};
+
+	public:
+		/**
+		 * Creates the dispatcher and starts its worker threads.
+		 *
+		 * @param[in]	numWorkers		Number of worker threads to start. If zero, a worker is started for each logical
+		 *								CPU core, except for the one running the calling thread.
+		 * @param[in]	queueSize		Maximum number of tasks that can be queued on a single worker. Rounded up to the
+		 *								next power of two.
+		 */
+		PhysXCPUDispatcher(UINT32 numWorkers, UINT32 queueSize);
+		~PhysXCPUDispatcher();
+
+		/** @copydoc physx::PxCpuDispatcher::submitTask */
+		void submitTask(physx::PxBaseTask& task) override;
+
+		/** @copydoc physx::PxCpuDispatcher::getWorkerCount */
+		physx::PxU32 getWorkerCount() const override { return mNumWorkers; }
+
+		/** Resets the task statistics. Should be called before the simulation step starts. */
+		void beginStep();
+
+		/** Returns information about the tasks executed since the last call to beginStep(). */
+		PhysXTaskStats endStep();
+
+	private:
+		/** Attempts to push the task onto the queue of the specified worker. Returns false if the queue is full. */
+		bool pushTask(UINT32 workerIdx, physx::PxBaseTask* task);
+
+		/**
+		 * Retrieves a task from the worker's own queue, or steals one from other workers if the queue is empty. Returns
+		 * null if there are no queued tasks.
+		 */
+		physx::PxBaseTask* findTask(UINT32 workerIdx);
+
+		/** Main method ran by each worker thread. */
+		void runWorker(UINT32 workerIdx);
+
+		/** Returns the current value of the high precision clock, in microseconds. */
+		static UINT64 getTimeUs();
+
+		Worker* mWorkers = nullptr;
+		UINT32 mNumWorkers = 0;
+		UINT32 mQueueSize = 0;
+		std::atomic<UINT32> mNextWorkerIdx;
+
+		std::atomic<UINT32> mNumQueuedTasks;
+		std::atomic<UINT32> mNumSleepingWorkers;
+		bool mShutdown = false;
+		Mutex mSleepMutex;
+		Signal mWakeCond;
+
+		// Stats
+		std::atomic<UINT32> mNumTasks;
+		std::atomic<UINT32> mNumStolenTasks;
+		std::atomic<UINT32> mNumOverflowTasks;
+		std::atomic<UINT64> mBusyTimeUs;
+		UINT64 mStepStartUs = 0;
+	};
+
+	/** @} */
+}
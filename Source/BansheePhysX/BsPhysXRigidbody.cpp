@@ -55,6 +55,9 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		if (mInterpolationIdx != (UINT32)-1)
+			gPhysX()._notifyRigidbodyDestroyed(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
@@ -108,6 +111,10 @@ namespace bs
 	void PhysXRigidbody::setTransform(const Vector3& pos, const Quaternion& rot)
 	{
 		mInternal->setGlobalPose(toPxTransform(pos, rot));
+
+		// Don't interpolate from the transform before the teleport
+		if (mInterpolationIdx != (UINT32)-1)
+			gPhysX()._notifyRigidbodyTeleported(this, pos, rot);
 	}
 
 	void PhysXRigidbody::setMass(float mass)
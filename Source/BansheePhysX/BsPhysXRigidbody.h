@@ -157,8 +157,18 @@ namespace bs
 		/** Returns the internal PhysX dynamic actor. */
 		physx::PxRigidDynamic* _getInternal() const { return mInternal; }
 
+		/**
+		 * Sets the index of the rigidbody in the list of rigidbodies whose transforms are being interpolated by the
+		 * physics system. -1 if the rigidbody isn't being interpolated.
+		 */
+		void _setInterpolationIdx(UINT32 idx) { mInterpolationIdx = idx; }
+
+		/** @copydoc _setInterpolationIdx */
+		UINT32 _getInterpolationIdx() const { return mInterpolationIdx; }
+
 	private:
 		physx::PxRigidDynamic* mInternal;
+		UINT32 mInterpolationIdx = (UINT32)-1;
 	};
 
 	/** @} */
@@ -18,6 +18,7 @@ set(BS_BANSHEEPHYSX_INC_NOFILTER
 	"BsPhysXSphericalJoint.h"
 	"BsPhysXD6Joint.h"
 	"BsPhysXCharacterController.h"
+	"BsPhysXCPUDispatcher.h"
 )
 
 set(BS_BANSHEEPHYSX_SRC_NOFILTER
@@ -40,18 +41,31 @@ set(BS_BANSHEEPHYSX_SRC_NOFILTER
 	"BsPhysXSphericalJoint.cpp"
 	"BsPhysXD6Joint.cpp"
 	"BsPhysXCharacterController.cpp"
+	"BsPhysXCPUDispatcher.cpp"
 )
 
 set(BS_BANSHEEPHYSX_INC_RTTI
 	"Rtti/BsPhysXMeshRTTI.h"
 )
 
+set(BS_BANSHEEPHYSX_INC_TESTING
+	"Testing/BsPhysicsQueryBenchmarkSuite.h"
+)
+
+set(BS_BANSHEEPHYSX_SRC_TESTING
+	"Testing/BsPhysicsQueryBenchmarkSuite.cpp"
+)
+
 source_group("Header Files" FILES ${BS_BANSHEEPHYSX_INC_NOFILTER})
 source_group("Source Files" FILES ${BS_BANSHEEPHYSX_SRC_NOFILTER})
 source_group("Header Files\\RTTI" FILES ${BS_BANSHEEPHYSX_INC_RTTI})
+source_group("Header Files\\Testing" FILES ${BS_BANSHEEPHYSX_INC_TESTING})
+source_group("Source Files\\Testing" FILES ${BS_BANSHEEPHYSX_SRC_TESTING})
 
 set(BS_BANSHEEPHYSX_SRC
 	${BS_BANSHEEPHYSX_INC_NOFILTER}
 	${BS_BANSHEEPHYSX_SRC_NOFILTER}
 	${BS_BANSHEEPHYSX_INC_RTTI}
+	${BS_BANSHEEPHYSX_INC_TESTING}
+	${BS_BANSHEEPHYSX_SRC_TESTING}
 )
\ No newline at end of file
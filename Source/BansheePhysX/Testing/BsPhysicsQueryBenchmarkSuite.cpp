@@ -0,0 +1,150 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsPhysicsQueryBenchmarkSuite.h"
+#include "Physics/BsPhysics.h"
+#include "Physics/BsBoxCollider.h"
+#include "Math/BsSphere.h"
+
+namespace bs
+{
+	static const UINT32 NUM_COLLIDERS = 10000;
+	static const UINT32 NUM_QUERIES = 10000;
+	static const UINT32 NUM_RUNS = 20;
+
+	/** Colliders and query origins are placed in a cube of this size, centered at the origin. */
+	static const float SCENE_SIZE = 200.0f;
+
+	/** Deterministic pseudo-random number generator, so all runs query the same scene. */
+	class BenchmarkRandom
+	{
+	public:
+		BenchmarkRandom(UINT32 seed) :mState(seed) { }
+
+		/** Returns a value in range [min, max]. */
+		float get(float min, float max)
+		{
+			mState = mState * 1664525U + 1013904223U;
+			return min + (max - min) * ((mState >> 8) / (float)(1 << 24));
+		}
+
+		/** Returns a random direction of unit length. */
+		Vector3 getDirection()
+		{
+			Vector3 direction;
+			do
+			{
+				direction = Vector3(get(-1.0f, 1.0f), get(-1.0f, 1.0f), get(-1.0f, 1.0f));
+			} while (direction.squaredLength() < 0.01f || direction.squaredLength() > 1.0f);
+
+			return Vector3::normalize(direction);
+		}
+
+	private:
+		UINT32 mState;
+	};
+
+	PhysicsQueryBenchmarkSuite::PhysicsQueryBenchmarkSuite()
+	{
+		BS_ADD_TEST(PhysicsQueryBenchmarkSuite::BenchmarkRayCast);
+		BS_ADD_TEST(PhysicsQueryBenchmarkSuite::BenchmarkSweep);
+	}
+
+	void PhysicsQueryBenchmarkSuite::startUp()
+	{
+		BenchmarkRandom random(NUM_COLLIDERS);
+
+		const float halfSize = SCENE_SIZE * 0.5f;
+		mColliders.resize(NUM_COLLIDERS);
+		for (UINT32 i = 0; i < NUM_COLLIDERS; i++)
+		{
+			Vector3 extents(random.get(0.5f, 2.0f), random.get(0.5f, 2.0f), random.get(0.5f, 2.0f));
+			Vector3 position(random.get(-halfSize, halfSize), random.get(-halfSize, halfSize),
+				random.get(-halfSize, halfSize));
+			Quaternion rotation(random.getDirection(), Radian(random.get(0.0f, Math::PI)));
+
+			mColliders[i] = BoxCollider::create(extents, position, rotation);
+		}
+	}
+
+	void PhysicsQueryBenchmarkSuite::shutDown()
+	{
+		mColliders.clear();
+	}
+
+	void PhysicsQueryBenchmarkSuite::BenchmarkRayCast()
+	{
+		BenchmarkRandom random(NUM_QUERIES);
+
+		const float halfSize = SCENE_SIZE * 0.5f;
+		Vector<PhysicsRayQuery> queries(NUM_QUERIES);
+		for (auto& query : queries)
+		{
+			query.origin = Vector3(random.get(-halfSize, halfSize), random.get(-halfSize, halfSize),
+				random.get(-halfSize, halfSize));
+			query.unitDir = random.getDirection();
+			query.max = SCENE_SIZE * 0.25f;
+		}
+
+		Vector<PhysicsQueryHit> hits(NUM_QUERIES);
+
+		UINT32 numSingleHits = 0;
+		measure("Single queries", NUM_RUNS, NUM_QUERIES, [&]()
+		{
+			numSingleHits = 0;
+			for (UINT32 i = 0; i < NUM_QUERIES; i++)
+			{
+				if (gPhysics().rayCast(queries[i].origin, queries[i].unitDir, hits[i], BS_ALL_LAYERS, queries[i].max))
+					numSingleHits++;
+			}
+		});
+
+		UINT32 numBatchHits = 0;
+		measure("Batch", NUM_RUNS, NUM_QUERIES, [&]()
+		{
+			numBatchHits = gPhysics().rayCastBatch(queries.data(), NUM_QUERIES, hits.data());
+		});
+
+		report("Hits", toString(numBatchHits) + " of " + toString(NUM_QUERIES));
+		BS_TEST_ASSERT(numSingleHits == numBatchHits);
+	}
+
+	void PhysicsQueryBenchmarkSuite::BenchmarkSweep()
+	{
+		BenchmarkRandom random(NUM_QUERIES + 1);
+
+		const float halfSize = SCENE_SIZE * 0.5f;
+		Vector<PhysicsSweepQuery> queries(NUM_QUERIES);
+		for (auto& query : queries)
+		{
+			Vector3 center(random.get(-halfSize, halfSize), random.get(-halfSize, halfSize),
+				random.get(-halfSize, halfSize));
+
+			query.shape = PhysicsQueryShape::sphere(Sphere(center, 0.5f));
+			query.unitDir = random.getDirection();
+			query.max = SCENE_SIZE * 0.25f;
+		}
+
+		Vector<PhysicsQueryHit> hits(NUM_QUERIES);
+
+		UINT32 numSingleHits = 0;
+		measure("Single queries", NUM_RUNS, NUM_QUERIES, [&]()
+		{
+			numSingleHits = 0;
+			for (UINT32 i = 0; i < NUM_QUERIES; i++)
+			{
+				Sphere sphere(queries[i].shape.position, queries[i].shape.size.x);
+				if (gPhysics().sphereCast(sphere, queries[i].unitDir, hits[i], BS_ALL_LAYERS, queries[i].max))
+					numSingleHits++;
+			}
+		});
+
+		UINT32 numBatchHits = 0;
+		measure("Batch", NUM_RUNS, NUM_QUERIES, [&]()
+		{
+			numBatchHits = gPhysics().sweepBatch(queries.data(), NUM_QUERIES, hits.data());
+		});
+
+		report("Hits", toString(numBatchHits) + " of " + toString(NUM_QUERIES));
+		BS_TEST_ASSERT(numSingleHits == numBatchHits);
+	}
+}
@@ -0,0 +1,42 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup PhysX
+	 *  @{
+	 */
+
+	/**
+	 * Measures scene queries against a scene of static box colliders, comparing queries issued one by one against
+	 * the same queries issued as a single batch.
+	 *
+	 * @note	Requires the physics module to be started.
+	 */
+	class PhysicsQueryBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		PhysicsQueryBenchmarkSuite();
+
+	private:
+		/** @copydoc TestSuite::startUp */
+		void startUp() override;
+
+		/** @copydoc TestSuite::shutDown */
+		void shutDown() override;
+
+		/** Casts rays using Physics::rayCast() and Physics::rayCastBatch(). */
+		void BenchmarkRayCast();
+
+		/** Sweeps spheres using Physics::sphereCast() and Physics::sweepBatch(). */
+		void BenchmarkSweep();
+
+		Vector<SPtr<BoxCollider>> mColliders;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,18 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsTaskSchedulerBenchmarkSuite.h"
+#include "Testing/BsSerializationBenchmarkSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> benchmarks = TaskSchedulerBenchmarkSuite::create<TaskSchedulerBenchmarkSuite>();
+	benchmarks->add(SerializationBenchmarkSuite::create<SerializationBenchmarkSuite>());
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	return 0;
+}
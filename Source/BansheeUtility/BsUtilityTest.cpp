@@ -1,6 +1,11 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "Testing/BsFileSystemTestSuite.h"
+#include "Testing/BsTaskSchedulerTestSuite.h"
+#include "Testing/BsBitfieldTestSuite.h"
+#include "Testing/BsAABoxTreeTestSuite.h"
+#include "Testing/BsRTTITestSuite.h"
+#include "Testing/BsDataStreamTestSuite.h"
 #include "Testing/BsConsoleTestOutput.h"
 
 using namespace bs;
@@ -8,6 +13,12 @@ using namespace bs;
 int main()
 {
 	SPtr<TestSuite> tests = FileSystemTestSuite::create<FileSystemTestSuite>();
+	tests->add(TaskSchedulerTestSuite::create<TaskSchedulerTestSuite>());
+	tests->add(BitfieldTestSuite::create<BitfieldTestSuite>());
+	tests->add(AABoxTreeTestSuite::create<AABoxTreeTestSuite>());
+	tests->add(RTTITestSuite::create<RTTITestSuite>());
+	tests->add(DataStreamTestSuite::create<DataStreamTestSuite>());
+
 	ConsoleTestOutput testOutput;
 	tests->run(testOutput);
 
@@ -87,6 +87,7 @@ set(BS_BANSHEEUTILITY_SRC_THREADING
 
 set(BS_BANSHEEUTILITY_INC_UTILITY
 	"Utility/BsAny.h"
+	"Utility/BsBitfield.h"
 	"Utility/BsBitwise.h"
 	"Utility/BsDynLib.h"
 	"Utility/BsDynLibManager.h"
@@ -152,6 +153,7 @@ set(BS_BANSHEEUTILITY_INC_ERROR
 
 set(BS_BANSHEEUTILITY_SRC_MATH
 	"Math/BsAABox.cpp"
+	"Math/BsAABoxTree.cpp"
 	"Math/BsDegree.cpp"
 	"Math/BsMath.cpp"
 	"Math/BsMatrix3.cpp"
@@ -178,14 +180,30 @@ set(BS_BANSHEEUTILITY_SRC_MATH
 
 set(BS_BANSHEEUTILITY_INC_TESTING
 	"Testing/BsFileSystemTestSuite.h"
+	"Testing/BsTaskSchedulerTestSuite.h"
+	"Testing/BsBitfieldTestSuite.h"
+	"Testing/BsAABoxTreeTestSuite.h"
+	"Testing/BsRTTITestSuite.h"
+	"Testing/BsDataStreamTestSuite.h"
+	"Testing/BsTaskSchedulerBenchmarkSuite.h"
+	"Testing/BsSerializationBenchmarkSuite.h"
 	"Testing/BsTestSuite.h"
+	"Testing/BsBenchmarkSuite.h"
 	"Testing/BsTestOutput.h"
 	"Testing/BsConsoleTestOutput.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_TESTING
 	"Testing/BsFileSystemTestSuite.cpp"
+	"Testing/BsTaskSchedulerTestSuite.cpp"
+	"Testing/BsBitfieldTestSuite.cpp"
+	"Testing/BsAABoxTreeTestSuite.cpp"
+	"Testing/BsRTTITestSuite.cpp"
+	"Testing/BsDataStreamTestSuite.cpp"
+	"Testing/BsTaskSchedulerBenchmarkSuite.cpp"
+	"Testing/BsSerializationBenchmarkSuite.cpp"
 	"Testing/BsTestSuite.cpp"
+	"Testing/BsBenchmarkSuite.cpp"
 	"Testing/BsTestOutput.cpp"
 	"Testing/BsConsoleTestOutput.cpp"
 )
@@ -201,6 +219,7 @@ set(BS_BANSHEEUTILITY_SRC_SERIALIZATION
 
 set(BS_BANSHEEUTILITY_INC_MATH
 	"Math/BsAABox.h"
+	"Math/BsAABoxTree.h"
 	"Math/BsDegree.h"
 	"Math/BsMath.h"
 	"Math/BsMatrix3.h"
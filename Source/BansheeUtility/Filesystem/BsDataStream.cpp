@@ -378,6 +378,21 @@ namespace bs
 		}
 	}
 
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath, void* memory, size_t size)
+		: MemoryDataStream(memory, size, false), mPath(filePath)
+	{ }
+
+	MappedFileDataStream::MappedFileDataStream(const SPtr<MappedFileDataStream>& parent, size_t offset, size_t size)
+		: MemoryDataStream(parent->getPtr() + offset, size, false), mPath(parent->mPath), mParent(parent)
+	{
+		assert(offset + size <= parent->size());
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
 	FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
 		: DataStream(accessMode), mPath(path), mFreeOnClose(freeOnClose)
 	{
@@ -50,6 +50,12 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/**
+		 * Checks is the stream a MappedFileDataStream, whose memory may be referenced directly for as long as the stream
+		 * is alive.
+		 */
+		virtual bool isMemoryMapped() const { return false; }
+
         /** Reads data from the buffer and copies it to the specified value. */
         template<typename T> DataStream& operator>>(T& val);
 
@@ -164,7 +170,7 @@ namespace bs
 		/**
 		 * Wrap an existing memory chunk in a stream.
 		 *
-		 * @param[in] 	memory		Memory to wrap the data stream around.
+		 * @param[in]	memory		Memory to wrap the data stream around.
 		 * @param[in]	size		Size of the memory chunk in bytes.
 		 * @param[in]	freeOnClose	Should the memory buffer be freed when the data stream goes out of scope.
 		 */
@@ -228,6 +234,52 @@ namespace bs
 		bool mFreeOnClose;
 	};
 
+	/**
+	 * Data stream for handling data from a file mapped into memory. Contents of the file are read on demand as the memory
+	 * is accessed, and may be referenced directly for as long as the stream is alive. Writes to the memory are private to
+	 * the stream (copy-on-write) and are never written back to the file.
+	 *
+	 * @note	The file must not be truncated or modified while it is mapped. Use FileSystem::openMappedFile() to create
+	 *			the stream.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Wraps an existing file mapping in a stream. The stream takes ownership of the mapping and unmaps it once
+		 * closed.
+		 *
+		 * @param[in]	filePath	Path of the mapped file.
+		 * @param[in]	memory		Start of the mapped memory.
+		 * @param[in]	size		Size of the mapped memory in bytes.
+		 */
+		MappedFileDataStream(const Path& filePath, void* memory, size_t size);
+
+		/**
+		 * Creates a stream referencing a part of the memory mapped by another stream. The other stream is kept alive for
+		 * as long as this stream is open.
+		 *
+		 * @param[in]	parent		Stream whose mapping to reference.
+		 * @param[in]	offset		Offset in bytes from the start of the parent's mapping.
+		 * @param[in]	size		Size of the referenced memory in bytes.
+		 */
+		MappedFileDataStream(const SPtr<MappedFileDataStream>& parent, size_t offset, size_t size);
+		~MappedFileDataStream();
+
+		/** @copydoc DataStream::isMemoryMapped */
+		bool isMemoryMapped() const override { return true; }
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the file mapped by the stream. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
+		SPtr<MappedFileDataStream> mParent;
+	};
+
 	/** Data stream for handling data from standard streams. */
 	class BS_UTILITY_EXPORT FileDataStream : public DataStream
 	{
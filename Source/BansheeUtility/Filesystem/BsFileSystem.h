@@ -22,6 +22,17 @@ namespace bs
 		 */
 		static SPtr<DataStream> openFile(const Path& fullPath, bool readOnly = true);
 
+		/**
+		 * Maps a file into memory and returns a data stream capable of reading from the mapped memory. Unlike openFile()
+		 * the file contents are not copied into intermediate buffers, but are instead read on demand once accessed.
+		 * Returns null if the file cannot be mapped.
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 *
+		 * @see		MappedFileDataStream
+		 */
+		static SPtr<DataStream> openMappedFile(const Path& fullPath);
+
 		/**
 		 * Opens a file and returns a data stream capable of reading and writing to that file. If file doesn't exist new
 		 * one will be created.
@@ -0,0 +1,515 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Math/BsAABoxTree.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	AABoxTree::AABoxTree(float margin)
+		:mMargin(margin)
+	{ }
+
+	UINT32 AABoxTree::add(const AABox& bounds, UINT32 userData)
+	{
+		Vector3 margin(mMargin, mMargin, mMargin);
+
+		UINT32 leafId = allocateNode();
+		Node& leaf = mNodes[leafId];
+		leaf.bounds = AABox(bounds.getMin() - margin, bounds.getMax() + margin);
+		leaf.userData = userData;
+		leaf.height = 0;
+
+		insertLeaf(leafId);
+		mNumLeaves++;
+
+		return leafId;
+	}
+
+	bool AABoxTree::update(UINT32 leafId, const AABox& bounds)
+	{
+		assert(mNodes[leafId].isLeaf());
+
+		if (mNodes[leafId].bounds.contains(bounds))
+			return false;
+
+		Vector3 margin(mMargin, mMargin, mMargin);
+
+		removeLeaf(leafId);
+		mNodes[leafId].bounds = AABox(bounds.getMin() - margin, bounds.getMax() + margin);
+		insertLeaf(leafId);
+
+		return true;
+	}
+
+	void AABoxTree::remove(UINT32 leafId)
+	{
+		assert(mNodes[leafId].isLeaf());
+
+		removeLeaf(leafId);
+		freeNode(leafId);
+		mNumLeaves--;
+	}
+
+	void AABoxTree::rebuild()
+	{
+		if (mNumLeaves < 3)
+			return;
+
+		// Keep the leaves (so their identifiers remain valid) and release all the internal nodes
+		Vector<UINT32> leaves;
+		leaves.reserve(mNumLeaves);
+
+		for (UINT32 i = 0; i < (UINT32)mNodes.size(); i++)
+		{
+			Node& node = mNodes[i];
+			if (node.height < 0)
+				continue;
+
+			if (node.isLeaf())
+				leaves.push_back(i);
+			else
+				freeNode(i);
+		}
+
+		mRoot = build(leaves.data(), (UINT32)leaves.size());
+		mNodes[mRoot].parent = INVALID_NODE;
+	}
+
+	void AABoxTree::clear()
+	{
+		mNodes.clear();
+		mRoot = INVALID_NODE;
+		mFreeList = INVALID_NODE;
+		mNumLeaves = 0;
+	}
+
+	void AABoxTree::query(const ConvexVolume& volume, Vector<UINT32>& intersecting, Vector<UINT32>& contained) const
+	{
+		if (mRoot == INVALID_NODE)
+			return;
+
+		const Vector<Plane>& planes = volume.getPlanes();
+
+		Vector<UINT32> stack;
+		stack.reserve(getStackSize(mRoot));
+
+		stack.push_back(mRoot);
+		while (!stack.empty())
+		{
+			const Node& node = mNodes[stack.back()];
+			stack.pop_back();
+
+			Vector3 center = node.bounds.getCenter();
+			Vector3 extents = node.bounds.getHalfSize();
+
+			bool outside = false;
+			bool inside = true;
+			for (auto& plane : planes)
+			{
+				float dist = center.dot(plane.normal) - plane.d;
+
+				float effectiveRadius = extents.x * Math::abs(plane.normal.x);
+				effectiveRadius += extents.y * Math::abs(plane.normal.y);
+				effectiveRadius += extents.z * Math::abs(plane.normal.z);
+
+				if (dist < -effectiveRadius)
+				{
+					outside = true;
+					break;
+				}
+
+				if (dist < effectiveRadius)
+					inside = false;
+			}
+
+			if (outside)
+				continue;
+
+			if (inside)
+			{
+				// No need to test any further, entire subtree is visible
+				appendLeaves((UINT32)(&node - mNodes.data()), contained);
+				continue;
+			}
+
+			if (node.isLeaf())
+				intersecting.push_back(node.userData);
+			else
+			{
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	UINT32 AABoxTree::getHeight() const
+	{
+		if (mRoot == INVALID_NODE)
+			return 0;
+
+		return (UINT32)mNodes[mRoot].height;
+	}
+
+	UINT32 AABoxTree::allocateNode()
+	{
+		if (mFreeList == INVALID_NODE)
+		{
+			UINT32 nodeId = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+
+			mFreeList = nodeId;
+			mNodes[nodeId].parent = INVALID_NODE;
+		}
+
+		UINT32 nodeId = mFreeList;
+		Node& node = mNodes[nodeId];
+		mFreeList = node.parent;
+
+		node.parent = INVALID_NODE;
+		node.children[0] = INVALID_NODE;
+		node.children[1] = INVALID_NODE;
+		node.height = 0;
+		node.userData = 0;
+
+		return nodeId;
+	}
+
+	void AABoxTree::freeNode(UINT32 nodeId)
+	{
+		Node& node = mNodes[nodeId];
+		node.parent = mFreeList;
+		node.height = -1;
+
+		mFreeList = nodeId;
+	}
+
+	void AABoxTree::insertLeaf(UINT32 leafId)
+	{
+		if (mRoot == INVALID_NODE)
+		{
+			mRoot = leafId;
+			mNodes[leafId].parent = INVALID_NODE;
+			return;
+		}
+
+		// Walk down the tree, picking the child that results in the smallest increase in surface area
+		AABox leafBounds = mNodes[leafId].bounds;
+		UINT32 nodeId = mRoot;
+		while (!mNodes[nodeId].isLeaf())
+		{
+			const Node& node = mNodes[nodeId];
+
+			float area = getSurfaceArea(node.bounds);
+			float combinedArea = getSurfaceArea(merge(node.bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				const Node& child = mNodes[node.children[i]];
+
+				float childArea = getSurfaceArea(merge(child.bounds, leafBounds));
+				if (!child.isLeaf())
+					childArea -= getSurfaceArea(child.bounds);
+
+				childCosts[i] = childArea + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+
+			nodeId = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+		}
+
+		// Create a new parent for the found sibling and the leaf
+		UINT32 siblingId = nodeId;
+		UINT32 oldParentId = mNodes[siblingId].parent;
+		UINT32 newParentId = allocateNode();
+
+		Node& newParent = mNodes[newParentId];
+		newParent.parent = oldParentId;
+		newParent.bounds = merge(leafBounds, mNodes[siblingId].bounds);
+		newParent.height = mNodes[siblingId].height + 1;
+		newParent.children[0] = siblingId;
+		newParent.children[1] = leafId;
+
+		if (oldParentId != INVALID_NODE)
+		{
+			Node& oldParent = mNodes[oldParentId];
+			if (oldParent.children[0] == siblingId)
+				oldParent.children[0] = newParentId;
+			else
+				oldParent.children[1] = newParentId;
+		}
+		else
+			mRoot = newParentId;
+
+		mNodes[siblingId].parent = newParentId;
+		mNodes[leafId].parent = newParentId;
+
+		refit(newParentId);
+	}
+
+	void AABoxTree::removeLeaf(UINT32 leafId)
+	{
+		if (leafId == mRoot)
+		{
+			mRoot = INVALID_NODE;
+			return;
+		}
+
+		UINT32 parentId = mNodes[leafId].parent;
+		UINT32 grandParentId = mNodes[parentId].parent;
+
+		const Node& parent = mNodes[parentId];
+		UINT32 siblingId = parent.children[0] == leafId ? parent.children[1] : parent.children[0];
+
+		// Replace the parent with the sibling
+		if (grandParentId != INVALID_NODE)
+		{
+			Node& grandParent = mNodes[grandParentId];
+			if (grandParent.children[0] == parentId)
+				grandParent.children[0] = siblingId;
+			else
+				grandParent.children[1] = siblingId;
+
+			mNodes[siblingId].parent = grandParentId;
+			freeNode(parentId);
+
+			refit(grandParentId);
+		}
+		else
+		{
+			mRoot = siblingId;
+			mNodes[siblingId].parent = INVALID_NODE;
+			freeNode(parentId);
+		}
+	}
+
+	void AABoxTree::refit(UINT32 nodeId)
+	{
+		while (nodeId != INVALID_NODE)
+		{
+			nodeId = balance(nodeId);
+
+			Node& node = mNodes[nodeId];
+			const Node& child0 = mNodes[node.children[0]];
+			const Node& child1 = mNodes[node.children[1]];
+
+			node.height = 1 + std::max(child0.height, child1.height);
+			node.bounds = merge(child0.bounds, child1.bounds);
+
+			nodeId = node.parent;
+		}
+	}
+
+	UINT32 AABoxTree::balance(UINT32 idA)
+	{
+		Node& a = mNodes[idA];
+		if (a.isLeaf() || a.height < 2)
+			return idA;
+
+		UINT32 idB = a.children[0];
+		UINT32 idC = a.children[1];
+		Node& b = mNodes[idB];
+		Node& c = mNodes[idC];
+
+		INT32 heightDiff = c.height - b.height;
+
+		// Rotate C up
+		if (heightDiff > 1)
+		{
+			UINT32 idF = c.children[0];
+			UINT32 idG = c.children[1];
+			Node& f = mNodes[idF];
+			Node& g = mNodes[idG];
+
+			c.children[0] = idA;
+			c.parent = a.parent;
+			a.parent = idC;
+
+			if (c.parent != INVALID_NODE)
+			{
+				Node& parent = mNodes[c.parent];
+				if (parent.children[0] == idA)
+					parent.children[0] = idC;
+				else
+					parent.children[1] = idC;
+			}
+			else
+				mRoot = idC;
+
+			// Keep the taller of C's children in C, and move the other one to A
+			if (f.height > g.height)
+			{
+				c.children[1] = idF;
+				a.children[1] = idG;
+				g.parent = idA;
+
+				a.bounds = merge(b.bounds, g.bounds);
+				c.bounds = merge(a.bounds, f.bounds);
+
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.children[1] = idG;
+				a.children[1] = idF;
+				f.parent = idA;
+
+				a.bounds = merge(b.bounds, f.bounds);
+				c.bounds = merge(a.bounds, g.bounds);
+
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return idC;
+		}
+
+		// Rotate B up
+		if (heightDiff < -1)
+		{
+			UINT32 idD = b.children[0];
+			UINT32 idE = b.children[1];
+			Node& d = mNodes[idD];
+			Node& e = mNodes[idE];
+
+			b.children[0] = idA;
+			b.parent = a.parent;
+			a.parent = idB;
+
+			if (b.parent != INVALID_NODE)
+			{
+				Node& parent = mNodes[b.parent];
+				if (parent.children[0] == idA)
+					parent.children[0] = idB;
+				else
+					parent.children[1] = idB;
+			}
+			else
+				mRoot = idB;
+
+			// Keep the taller of B's children in B, and move the other one to A
+			if (d.height > e.height)
+			{
+				b.children[1] = idD;
+				a.children[0] = idE;
+				e.parent = idA;
+
+				a.bounds = merge(c.bounds, e.bounds);
+				b.bounds = merge(a.bounds, d.bounds);
+
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.children[1] = idE;
+				a.children[0] = idD;
+				d.parent = idA;
+
+				a.bounds = merge(c.bounds, d.bounds);
+				b.bounds = merge(a.bounds, e.bounds);
+
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return idB;
+		}
+
+		return idA;
+	}
+
+	UINT32 AABoxTree::build(UINT32* leaves, UINT32 count)
+	{
+		if (count == 1)
+			return leaves[0];
+
+		// Split along the longest axis of the leaf centers, at the median
+		AABox centerBounds(mNodes[leaves[0]].bounds.getCenter(), mNodes[leaves[0]].bounds.getCenter());
+		for (UINT32 i = 1; i < count; i++)
+			centerBounds.merge(mNodes[leaves[i]].bounds.getCenter());
+
+		Vector3 size = centerBounds.getSize();
+		UINT32 axis = 0;
+		if (size.y > size[axis])
+			axis = 1;
+
+		if (size.z > size[axis])
+			axis = 2;
+
+		UINT32 half = count / 2;
+		std::nth_element(leaves, leaves + half, leaves + count,
+			[this, axis](UINT32 lhs, UINT32 rhs)
+		{
+			return mNodes[lhs].bounds.getCenter()[axis] < mNodes[rhs].bounds.getCenter()[axis];
+		});
+
+		UINT32 child0 = build(leaves, half);
+		UINT32 child1 = build(leaves + half, count - half);
+
+		UINT32 nodeId = allocateNode();
+		Node& node = mNodes[nodeId];
+		node.children[0] = child0;
+		node.children[1] = child1;
+		node.bounds = merge(mNodes[child0].bounds, mNodes[child1].bounds);
+		node.height = 1 + std::max(mNodes[child0].height, mNodes[child1].height);
+
+		mNodes[child0].parent = nodeId;
+		mNodes[child1].parent = nodeId;
+
+		return nodeId;
+	}
+
+	void AABoxTree::appendLeaves(UINT32 nodeId, Vector<UINT32>& output) const
+	{
+		Vector<UINT32> stack;
+		stack.reserve(getStackSize(nodeId));
+
+		stack.push_back(nodeId);
+		while (!stack.empty())
+		{
+			const Node& node = mNodes[stack.back()];
+			stack.pop_back();
+
+			if (node.isLeaf())
+				output.push_back(node.userData);
+			else
+			{
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	UINT32 AABoxTree::getStackSize(UINT32 nodeId) const
+	{
+		// Each level below the node leaves at most one sibling on the stack, plus the two children of the deepest node
+		return (UINT32)mNodes[nodeId].height + 2;
+	}
+
+	float AABoxTree::getSurfaceArea(const AABox& box)
+	{
+		Vector3 size = box.getSize();
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	AABox AABoxTree::merge(const AABox& a, const AABox& b)
+	{
+		Vector3 min = a.getMin();
+		Vector3 max = a.getMax();
+		min.floor(b.getMin());
+		max.ceil(b.getMax());
+
+		return AABox(min, max);
+	}
+}
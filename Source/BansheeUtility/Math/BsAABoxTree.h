@@ -0,0 +1,148 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Bounding volume hierarchy of axis aligned boxes, used for quickly finding objects that overlap a volume (e.g. a
+	 * camera frustum) without having to test every object individually.
+	 *
+	 * Objects can be added, moved and removed at any time and the tree is updated incrementally, keeping itself balanced.
+	 * Leaf bounds can optionally be enlarged by a margin, so small movements of an object don't require the tree to be
+	 * modified. For objects that rarely change the tree can instead be fully rebuilt, producing a higher quality tree.
+	 *
+	 * @note
+	 * Not thread safe. Multiple threads may query the tree at once, as long as no thread is modifying it.
+	 */
+	class BS_UTILITY_EXPORT AABoxTree
+	{
+	public:
+		/**
+		 * Constructs a new empty tree.
+		 *
+		 * @param[in]	margin	Distance by which the bounds of each leaf are enlarged in each direction. Larger margins
+		 *						mean moving objects need to update the tree less often, but queries will return more
+		 *						false positives.
+		 */
+		AABoxTree(float margin = 0.0f);
+
+		/**
+		 * Adds a new object to the tree.
+		 *
+		 * @param[in]	bounds		World bounds of the object.
+		 * @param[in]	userData	Value returned by queries when the object is found, usually the object's index.
+		 * @return					Identifier of the tree leaf representing the object.
+		 */
+		UINT32 add(const AABox& bounds, UINT32 userData);
+
+		/**
+		 * Updates the bounds of an object previously added with add().
+		 *
+		 * @param[in]	leafId		Identifier returned from add().
+		 * @param[in]	bounds		New world bounds of the object.
+		 * @return					True if the tree was modified, false if the object still fits its current leaf.
+		 */
+		bool update(UINT32 leafId, const AABox& bounds);
+
+		/** Removes an object previously added with add(). */
+		void remove(UINT32 leafId);
+
+		/** Changes the user data value associated with the leaf. */
+		void setUserData(UINT32 leafId, UINT32 userData) { mNodes[leafId].userData = userData; }
+
+		/** Returns the user data value associated with the leaf. */
+		UINT32 getUserData(UINT32 leafId) const { return mNodes[leafId].userData; }
+
+		/** Returns the (possibly enlarged) bounds stored in the leaf. */
+		const AABox& getBounds(UINT32 leafId) const { return mNodes[leafId].bounds; }
+
+		/**
+		 * Rebuilds the hierarchy from scratch by splitting the objects top-down. This is slower than incremental updates
+		 * but results in a better tree. Leaf identifiers remain valid.
+		 */
+		void rebuild();
+
+		/** Removes all objects from the tree. */
+		void clear();
+
+		/**
+		 * Finds all objects whose bounds intersect the provided volume.
+		 *
+		 * @param[in]	volume			Volume to test the objects against.
+		 * @param[out]	intersecting	User data values of objects whose bounds partially intersect the volume. Should
+		 *								be tested against the volume more precisely by the caller.
+		 * @param[out]	contained		User data values of objects whose bounds are fully inside the volume.
+		 */
+		void query(const ConvexVolume& volume, Vector<UINT32>& intersecting, Vector<UINT32>& contained) const;
+
+		/** Returns the number of objects in the tree. */
+		UINT32 getNumLeaves() const { return mNumLeaves; }
+
+		/** Returns the height of the tree, zero for a tree with a single object. */
+		UINT32 getHeight() const;
+
+	private:
+		/** Single node of the tree, either a leaf representing an object, or a parent of two other nodes. */
+		struct Node
+		{
+			bool isLeaf() const { return children[0] == INVALID_NODE; }
+
+			AABox bounds;
+			UINT32 parent; /**< Parent node, or next free node if the node is not in use. */
+			UINT32 children[2];
+			INT32 height; /**< Zero for leaves, -1 for nodes not in use. */
+			UINT32 userData;
+		};
+
+		/** Returns an unused node, growing the node array if needed. */
+		UINT32 allocateNode();
+
+		/** Returns a node allocated with allocateNode() back to the free list. */
+		void freeNode(UINT32 nodeId);
+
+		/** Finds the best place for the leaf in the tree and inserts it. */
+		void insertLeaf(UINT32 leafId);
+
+		/** Removes the leaf from the hierarchy without freeing it. */
+		void removeLeaf(UINT32 leafId);
+
+		/** Refits bounds and heights of all nodes on the path from the provided node to the root, rebalancing them. */
+		void refit(UINT32 nodeId);
+
+		/** Performs a rotation on the node if its subtrees are imbalanced. Returns the new root of the subtree. */
+		UINT32 balance(UINT32 nodeId);
+
+		/** Builds a subtree containing the provided leaves. Returns the root of the subtree. */
+		UINT32 build(UINT32* leaves, UINT32 count);
+
+		/** Outputs user data of all the leaves in the provided subtree. */
+		void appendLeaves(UINT32 nodeId, Vector<UINT32>& output) const;
+
+		/** Returns the maximum number of entries on the stack when traversing the provided subtree depth first. */
+		UINT32 getStackSize(UINT32 nodeId) const;
+
+		/** Returns surface area of the box, used as a heuristic for insertion cost. */
+		static float getSurfaceArea(const AABox& box);
+
+		/** Returns a box enclosing both of the provided boxes. */
+		static AABox merge(const AABox& a, const AABox& b);
+
+		static const UINT32 INVALID_NODE = (UINT32)-1;
+
+		Vector<Node> mNodes;
+		UINT32 mRoot = INVALID_NODE;
+		UINT32 mFreeList = INVALID_NODE;
+		UINT32 mNumLeaves = 0;
+		float mMargin;
+	};
+
+	/** @} */
+}
@@ -54,6 +54,7 @@ namespace bs
 	class Radian;
 	class Ray;
 	class Capsule;
+	class ConvexVolume;
 	class Sphere;
 	class Vector2;
 	class Vector3;
@@ -68,6 +69,7 @@ namespace bs
 	class DataStream;
 	class MemoryDataStream;
 	class FileDataStream;
+	class MappedFileDataStream;
 	class MeshData;
 	class FileSystem;
 	class Timer;
@@ -119,6 +121,13 @@ namespace bs
 		TID_UnorderedSet = 66,
 		TID_SerializedDataBlock = 67,
 		TID_Flags = 68,
-		TID_IReflectable = 69
+		TID_IReflectable = 69,
+		TID_TestRTTIObjectA = 70,
+		TID_TestRTTIObjectB = 71,
+		TID_TestRTTIObjectC = 72,
+		TID_TestRTTIObjectD = 73,
+		TID_BenchmarkNode = 74,
+		TID_BenchmarkDerivedNode = 75,
+		TID_BenchmarkGraph = 76
 	};
 }
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { allowMemcpy = 1 /**< Optional. If present, arrays of the type may be serialized using a single memcpy. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -165,6 +166,7 @@ namespace bs
 #define BS_ALLOW_MEMCPY_SERIALIZATION(type)					\
 	template<> struct RTTIPlainType<type>					\
 	{	enum { id=0 }; enum { hasDynamicSize = 0 };			\
+	enum { allowMemcpy = 1 };								\
 	static void toMemory(const type& data, char* memory)	\
 	{ memcpy(memory, &data, sizeof(type)); }				\
 	static UINT32 fromMemory(type& data, char* memory)		\
@@ -173,6 +175,45 @@ namespace bs
 	{ return sizeof(type); }								\
 	}; 
 
+	/**
+	 * Checks if an array of the provided type may be serialized using a single memcpy, instead of serializing it element
+	 * by element. This is true for types using the default RTTIPlainType implementation or BS_ALLOW_MEMCPY_SERIALIZATION,
+	 * as well as for RTTIPlainType specializations that set the allowMemcpy enum to a non-zero value, guaranteeing their
+	 * memory layout matches their serialized layout.
+	 */
+	template<class T>
+	struct RTTIIsMemcpyType
+	{
+	private:
+		template<class U> static std::integral_constant<bool, RTTIPlainType<U>::allowMemcpy != 0>
+			test(decltype(RTTIPlainType<U>::allowMemcpy)*);
+		template<class U> static std::false_type test(...);
+
+	public:
+		enum { value = decltype(test<T>(nullptr))::value && RTTIPlainType<T>::hasDynamicSize == 0 };
+	};
+
+	/**
+	 * Checks if all elements of the provided container may be serialized using a single memcpy. This requires the element
+	 * type to pass RTTIIsMemcpyType, and the container to store its elements contiguously as actual objects of that type.
+	 * Only std::vector guarantees this, with the exception of std::vector<bool> which packs its elements into bits.
+	 */
+	template<class ContainerType>
+	struct RTTIIsMemcpyContainer
+	{
+		enum { value = 0 };
+	};
+
+	/** @cond SPECIALIZATIONS */
+
+	template<class T, class A>
+	struct RTTIIsMemcpyContainer<std::vector<T, A>>
+	{
+		enum { value = RTTIIsMemcpyType<T>::value && !std::is_same<T, bool>::value };
+	};
+
+	/** @endcond */
+
 	/** @cond SPECIALIZATIONS */
 
 	/**
@@ -196,14 +237,7 @@ namespace bs
 			memory += sizeof(UINT32);
 			size += sizeof(UINT32);
 
-			for(auto iter = data.begin(); iter != data.end(); ++iter)
-			{
-				UINT32 elementSize = rttiGetElemSize(*iter);
-				RTTIPlainType<T>::toMemory(*iter, memory);
-
-				memory += elementSize;
-				size += elementSize;
-			}
+			size += elementsToMemory(data, memory, MemcpyTag());
 
 			memcpy(memoryStart, &size, sizeof(UINT32));
 		}
@@ -219,6 +253,67 @@ namespace bs
 			memcpy(&numElements, memory, sizeof(UINT32)); 
 			memory += sizeof(UINT32);
 
+			elementsFromMemory(data, numElements, memory, MemcpyTag());
+
+			return size;
+		}
+
+		/** @copydoc RTTIPlainType::toMemory */
+		static UINT32 getDynamicSize(const std::vector<T, StdAlloc<T>>& data)	
+		{ 
+			UINT64 dataSize = sizeof(UINT32) * 2 + getElementsSize(data, MemcpyTag());
+
+			assert(dataSize <= std::numeric_limits<UINT32>::max());
+
+			return (UINT32)dataSize;
+		}	
+
+	private:
+		/** Selects between the memcpy and the per-element implementations below, at compile time. */
+		typedef std::integral_constant<bool, RTTIIsMemcpyContainer<std::vector<T, StdAlloc<T>>>::value != 0> MemcpyTag;
+
+		/** Writes all elements of the vector using a single memcpy. Returns the number of bytes written. */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::true_type)
+		{
+			UINT32 dataSize = (UINT32)data.size() * sizeof(T);
+			if(dataSize > 0)
+				memcpy(memory, data.data(), dataSize);
+
+			return dataSize;
+		}
+
+		/** Writes the vector elements one by one. Returns the number of bytes written. */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::false_type)
+		{
+			UINT32 dataSize = 0;
+			for(auto iter = data.begin(); iter != data.end(); ++iter)
+			{
+				UINT32 elementSize = rttiGetElemSize(*iter);
+				RTTIPlainType<T>::toMemory(*iter, memory);
+
+				memory += elementSize;
+				dataSize += elementSize;
+			}
+
+			return dataSize;
+		}
+
+		/** Appends @p numElements elements to the vector using a single memcpy. */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory,
+			std::true_type)
+		{
+			if(numElements == 0)
+				return;
+
+			size_t offset = data.size();
+			data.resize(offset + numElements);
+			memcpy((void*)&data[offset], memory, numElements * sizeof(T));
+		}
+
+		/** Appends @p numElements elements to the vector one by one. */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory,
+			std::false_type)
+		{
 			for(UINT32 i = 0; i < numElements; i++)
 			{
 				T element;
@@ -227,22 +322,23 @@ namespace bs
 
 				memory += elementSize;
 			}
-
-			return size;
 		}
 
-		/** @copydoc RTTIPlainType::toMemory */
-		static UINT32 getDynamicSize(const std::vector<T, StdAlloc<T>>& data)	
-		{ 
-			UINT64 dataSize = sizeof(UINT32) * 2;
+		/** Returns the number of bytes required for storing the vector elements, when written using a single memcpy. */
+		static UINT64 getElementsSize(const std::vector<T, StdAlloc<T>>& data, std::true_type)
+		{
+			return data.size() * sizeof(T);
+		}
 
+		/** Returns the number of bytes required for storing the vector elements, when written one by one. */
+		static UINT64 getElementsSize(const std::vector<T, StdAlloc<T>>& data, std::false_type)
+		{
+			UINT64 dataSize = 0;
 			for (auto iter = data.begin(); iter != data.end(); ++iter)
 				dataSize += rttiGetElemSize(*iter);
 
-			assert(dataSize <= std::numeric_limits<UINT32>::max());
-
-			return (UINT32)dataSize;
-		}	
+			return dataSize;
+		}
 	}; 
 
 	/**
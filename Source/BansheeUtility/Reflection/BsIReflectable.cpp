@@ -7,15 +7,33 @@
 
 namespace bs
 {
+	/**
+	 * Returns a map of all registered non-abstract RTTI types, keyed by their type ID. Types register themselves during
+	 * static initialization, so the map must be constructed on first use.
+	 */
+	static UnorderedMap<UINT32, RTTITypeBase*>& getTypeIdLookup()
+	{
+		static UnorderedMap<UINT32, RTTITypeBase*> lookup;
+		return lookup;
+	}
+
 	void IReflectable::_registerDerivedClass(RTTITypeBase* derivedClass)
 	{
-		if(_isTypeIdDuplicate(derivedClass->getRTTIId()))
+		_registerTypeId(derivedClass);
+		getDerivedClasses().push_back(derivedClass);
+	}
+
+	void IReflectable::_registerTypeId(RTTITypeBase* type)
+	{
+		UINT32 typeId = type->getRTTIId();
+		if(_isTypeIdDuplicate(typeId))
 		{
-			BS_EXCEPT(InternalErrorException, "RTTI type \"" + derivedClass->getRTTIName() + 
-				"\" has a duplicate ID: " + toString(derivedClass->getRTTIId()));
+			BS_EXCEPT(InternalErrorException, "RTTI type \"" + type->getRTTIName() + 
+				"\" has a duplicate ID: " + toString(typeId));
 		}
 
-		getDerivedClasses().push_back(derivedClass);
+		if(typeId != TID_Abstract)
+			getTypeIdLookup()[typeId] = type;
 	}
 
 	SPtr<IReflectable> IReflectable::createInstanceFromTypeId(UINT32 rttiTypeId)
@@ -30,24 +48,11 @@ namespace bs
 
 	RTTITypeBase* IReflectable::_getRTTIfromTypeId(UINT32 rttiTypeId)
 	{
-		Stack<RTTITypeBase*> todo;
-		Vector<RTTITypeBase*>& rootClasses = getDerivedClasses();
-
-		for(auto iter = rootClasses.begin(); iter != rootClasses.end(); ++iter)
-			todo.push(*iter);
-
-		while(!todo.empty())
-		{
-			RTTITypeBase* curType = todo.top();
-			todo.pop();
+		const UnorderedMap<UINT32, RTTITypeBase*>& lookup = getTypeIdLookup();
 
-			if(curType->getRTTIId() == rttiTypeId)
-				return curType;
-
-			Vector<RTTITypeBase*>& derivedClasses = curType->getDerivedClasses();
-			for(auto iter = derivedClasses.begin(); iter != derivedClasses.end(); ++iter)
-				todo.push(*iter);
-		}
+		auto iterFind = lookup.find(rttiTypeId);
+		if(iterFind != lookup.end())
+			return iterFind->second;
 
 		return nullptr;
 	}
@@ -68,6 +68,12 @@ namespace bs
 		/** Checks if the provided type id is unique. */
 		static bool _isTypeIdDuplicate(UINT32 typeId);
 
+		/**
+		 * Adds the type to the global type ID lookup table used by _getRTTIfromTypeId(). Throws an exception if a type with
+		 * the same ID is already registered. Called by the RTTI system when a type is first registered.
+		 */
+		static void _registerTypeId(RTTITypeBase* type);
+
 		/**
 		 * Iterates over all RTTI types and reports any circular references (for example one type having a field referencing
 		 * another type, and that type having a field referencing the first type). Circular references are problematic
@@ -94,6 +94,16 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Returns a pointer to the first element of the array managed by the field, if the array elements are stored 
+		 * contiguously and may be serialized using a single memcpy (see RTTIIsMemcpyContainer). Returns null otherwise, in
+		 * which case the elements must be accessed one by one.
+		 */
+		virtual UINT8* getArrayData(void* object)
+		{
+			return nullptr;
+		}
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -289,6 +299,131 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Represents a plain class field containing a Vector of a specific type. Unlike RTTIPlainField the field accesses the
+	 * vector through an accessor known at compile time, instead of calling type-erased getter and setter callbacks for
+	 * each element.
+	 */
+	template <class ContainerType, class ObjectType, ContainerType& (*Accessor)(ObjectType*)>
+	struct RTTIPlainVectorField : public RTTIPlainFieldBase
+	{
+		typedef typename ContainerType::value_type DataType;
+
+		/**
+		 * Initializes a plain field containing a vector of values.
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. Although name is also a unique identifier we want a 
+		 *							small data type that can be used for efficiently serializing data to disk and similar. 
+		 *							It is primarily used for compatibility between different versions of serialized data.
+		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 */
+		void initArray(const String& name, UINT16 uniqueId, UINT64 flags)
+		{
+			static_assert((RTTIPlainType<DataType>::hasDynamicSize != 0 || (sizeof(DataType) <= 255)), 
+				"Trying to create a plain RTTI field with size larger than 255. In order to use larger sizes for plain types please specialize " \
+				" RTTIPlainType, set hasDynamicSize to true.");
+
+			initAll(nullptr, nullptr, nullptr, nullptr, name, uniqueId, true, SerializableFT_Plain, flags);
+		}
+
+		/** @copydoc RTTIField::getTypeSize */
+		UINT32 getTypeSize() override
+		{
+			return sizeof(DataType);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getTypeId */
+		UINT32 getTypeId() override
+		{
+			return RTTIPlainType<DataType>::id;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::hasDynamicSize */
+		bool hasDynamicSize() override
+		{
+			return RTTIPlainType<DataType>::hasDynamicSize != 0;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getDynamicSize */
+		UINT32 getDynamicSize(void* object) override
+		{
+			checkIsArray(false);
+			return 0;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getArrayElemDynamicSize */
+		UINT32 getArrayElemDynamicSize(void* object, int index) override
+		{
+			ContainerType& container = Accessor(static_cast<ObjectType*>(object));
+			return RTTIPlainType<DataType>::getDynamicSize(container[index]);
+		}
+
+		/** @copydoc RTTIField::getArraySize */
+		UINT32 getArraySize(void* object) override
+		{
+			return (UINT32)Accessor(static_cast<ObjectType*>(object)).size();
+		}
+
+		/** @copydoc RTTIField::setArraySize */
+		void setArraySize(void* object, UINT32 size) override
+		{
+			Accessor(static_cast<ObjectType*>(object)).resize(size);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::toBuffer */
+		void toBuffer(void* object, void* buffer) override
+		{
+			checkIsArray(false);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemToBuffer */
+		void arrayElemToBuffer(void* object, int index, void* buffer) override
+		{
+			ContainerType& container = Accessor(static_cast<ObjectType*>(object));
+			RTTIPlainType<DataType>::toMemory(container[index], (char*)buffer);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::fromBuffer */
+		void fromBuffer(void* object, void* buffer) override
+		{
+			checkIsArray(false);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayElemFromBuffer */
+		void arrayElemFromBuffer(void* object, int index, void* buffer) override
+		{
+			DataType value;
+			RTTIPlainType<DataType>::fromMemory(value, (char*)buffer);
+
+			ContainerType& container = Accessor(static_cast<ObjectType*>(object));
+			container[index] = std::move(value);
+		}
+
+		/** @copydoc RTTIPlainFieldBase::getArrayData */
+		UINT8* getArrayData(void* object) override
+		{
+			ContainerType& container = Accessor(static_cast<ObjectType*>(object));
+			return getArrayData(container, std::integral_constant<bool, RTTIIsMemcpyContainer<ContainerType>::value != 0>());
+		}
+
+	private:
+		/** Returns the storage of a container whose elements may be serialized using a single memcpy. */
+		static UINT8* getArrayData(ContainerType& container, std::true_type)
+		{
+			if(container.empty())
+				return nullptr;
+
+			return (UINT8*)container.data();
+		}
+
+		/** Version of getArrayData() for containers that must be serialized element by element. */
+		static UINT8* getArrayData(ContainerType& container, std::false_type)
+		{
+			return nullptr;
+		}
+	};
+
 	/** @} */
 	/** @} */
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ namespace bs
 			bs_delete(*iter);
 
 		mFields.clear();
+		mFieldsById.clear();
 	}
 
 	RTTIField* RTTITypeBase::findField(const String& name)
@@ -31,12 +32,10 @@ namespace bs
 
 	RTTIField* RTTITypeBase::findField(int uniqueFieldId)
 	{
-		auto foundElement = std::find_if(mFields.begin(), mFields.end(), [&uniqueFieldId](RTTIField* x) { return x->mUniqueId == uniqueFieldId; });
-
-		if(foundElement == mFields.end())
+		if(uniqueFieldId < 0 || uniqueFieldId >= (int)mFieldsById.size())
 			return nullptr;
 
-		return *foundElement;
+		return mFieldsById[uniqueFieldId];
 	}
 
 	void RTTITypeBase::addNewField(RTTIField* field)
@@ -47,10 +46,8 @@ namespace bs
 				"Field argument can't be null.");
 		}
 
-		int uniqueId = field->mUniqueId;
-		auto foundElementById = std::find_if(mFields.begin(), mFields.end(), [uniqueId](RTTIField* x) { return x->mUniqueId == uniqueId; });
-
-		if(foundElementById != mFields.end())
+		UINT32 uniqueId = field->mUniqueId;
+		if(findField((int)uniqueId) != nullptr)
 		{
 			BS_EXCEPT(InternalErrorException, 
 				"Field with the same ID already exists.");
@@ -66,6 +63,12 @@ namespace bs
 		}
 
 		mFields.push_back(field);
+
+		// Field IDs are small and assigned sequentially, so a dense table keeps lookups during decoding O(1)
+		if(uniqueId >= (UINT32)mFieldsById.size())
+			mFieldsById.resize(uniqueId + 1, nullptr);
+
+		mFieldsById[uniqueId] = field;
 	}
 
 	SPtr<IReflectable> rtti_create(UINT32 rttiId)
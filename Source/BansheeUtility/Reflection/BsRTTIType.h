@@ -73,15 +73,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN_ARRAY(name, id)													\
 	META_Entry_##name;																			\
 																								\
-	std::common_type<decltype(OwnerType::name)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->name[idx]; }					\
-	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::name)>::type::value_type& val) { obj->name[idx] = val; }		\
-	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->name.size(); }																		\
-	void setSize##name(OwnerType* obj, UINT32 val) { obj->name.resize(val); }																		\
+	static decltype(OwnerType::name)& get##name(OwnerType* obj) { return obj->name; }				\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainVectorField<OwnerType, decltype(OwnerType::name), &MyType::get##name>(#name, id);		\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -93,15 +90,12 @@ namespace bs
 #define BS_RTTI_MEMBER_PLAIN_ARRAY_NAMED(name, field, id)													\
 	META_Entry_##name;																			\
 																								\
-	std::common_type<decltype(OwnerType::field)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->field[idx]; }					\
-	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::field)>::type::value_type& val) { obj->field[idx] = val; }		\
-	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->field.size(); }																		\
-	void setSize##name(OwnerType* obj, UINT32 val) { obj->field.resize(val); }																		\
+	static decltype(OwnerType::field)& get##name(OwnerType* obj) { return obj->field; }				\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainVectorField<OwnerType, decltype(OwnerType::field), &MyType::get##name>(#name, id);		\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -702,6 +696,7 @@ namespace bs
 
 	private:
 		Vector<RTTIField*> mFields;
+		Vector<RTTIField*> mFieldsById; /**< Fields indexed by their unique ID, null for unused IDs. */
 	};
 
 	/** Used for initializing a certain type as soon as the program is loaded. */
@@ -831,12 +826,7 @@ namespace bs
 		/** @copydoc RTTITypeBase::_registerDerivedClass */
 		void _registerDerivedClass(RTTITypeBase* derivedClass) override
 		{
-			if(IReflectable::_isTypeIdDuplicate(derivedClass->getRTTIId()))
-			{
-				BS_EXCEPT(InternalErrorException, "RTTI type \"" + derivedClass->getRTTIName() + 
-					"\" has a duplicate ID: " + toString(derivedClass->getRTTIId()));
-			}
-
+			IReflectable::_registerTypeId(derivedClass);
 			getDerivedClasses().push_back(derivedClass);
 		}
 
@@ -932,6 +922,29 @@ namespace bs
 				std::function<void(ObjectType*, UINT32)>(setSize), flags);
 		}	
 
+		/**
+		 * Registers a new field containing a Vector of plain values. Unlike addPlainArrayField() the vector is retrieved
+		 * using the @p Accessor function known at compile time, and vectors of types that may be serialized using memcpy
+		 * are serialized as a single block of memory.
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. Although name is also a unique identifier we want a 
+		 *							small data type that can be used for efficiently serializing data to disk and similar. 
+		 *							It is primarily used for compatibility between different versions of serialized data.
+		 * @param[in]	flags		Various flags you can use to specialize how systems handle this field. See RTTIFieldFlag.
+		 */
+		template<class ObjectType, class ContainerType, ContainerType& (*Accessor)(ObjectType*)>
+		void addPlainVectorField(const String& name, UINT32 uniqueId, UINT64 flags = 0)
+		{
+			static_assert(!(std::is_base_of<bs::IReflectable, typename ContainerType::value_type>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			RTTIPlainVectorField<ContainerType, ObjectType, Accessor>* newField = 
+				bs_new<RTTIPlainVectorField<ContainerType, ObjectType, Accessor>>();
+			newField->initArray(name, uniqueId, flags);
+			addNewField(newField);
+		}
+
 		/**
 		 * Registers a new field containg an array of reflectable object values. This field can then be accessed dynamically
 		 * from the RTTI system and used for automatic serialization. See RTTIField for more information about field types.
@@ -41,22 +41,22 @@ buffer += size;															\
 namespace bs
 {
 	BinarySerializer::BinarySerializer()
-		:mLastUsedObjectId(1)
+		:mLastUsedObjectId(1), mTotalBytesWritten(0), mOutputOffset(0)
 	{
 	}
 
 	void BinarySerializer::encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT32* bytesWritten, 
 		std::function<UINT8*(UINT8*, UINT32, UINT32&)> flushBufferCallback, bool shallow, 
-		const UnorderedMap<String, UINT64>& params)
+		const UnorderedMap<String, UINT64>& params, UINT32 outputOffset)
 	{
 		mObjectsToEncode.clear();
 		mObjectAddrToId.clear();
 		mLastUsedObjectId = 1;
 		*bytesWritten = 0;
 		mTotalBytesWritten = 0;
+		mOutputOffset = outputOffset;
 		mParams = params;
 
-		Vector<SPtr<IReflectable>> encodedObjects;
 		UINT32 objectId = findOrCreatePersistentId(object);
 		
 		// Encode primary object and its value types
@@ -67,44 +67,22 @@ namespace bs
 				"Destination buffer is null or not large enough.");
 		}
 
-		// Encode pointed to objects and their value types
-		UnorderedSet<UINT32> serializedObjects;
-		while(true)
+		// Encode pointed to objects and their value types. Each object is registered only once, and encoding an object
+		// can append new ones to the end of the list, so a single pass over the list encodes them all. Objects stay in
+		// the list until encoding is done, ensuring they aren't released. The system assigns unique IDs to IReflectable
+		// objects based on pointer addresses, so if objects got released the same address could be assigned twice.
+		for(size_t i = 0; i < mObjectsToEncode.size(); i++)
 		{
-			auto iter = mObjectsToEncode.begin();
-			bool foundObjectToProcess = false;
-			for(; iter != mObjectsToEncode.end(); ++iter)
-			{
-				auto foundExisting = serializedObjects.find(iter->objectId);
-				if(foundExisting != serializedObjects.end())
-					continue; // Already processed
-
-				SPtr<IReflectable> curObject = iter->object;
-				UINT32 curObjectid = iter->objectId;
-				serializedObjects.insert(curObjectid);
-				mObjectsToEncode.erase(iter);
-
-				buffer = encodeEntry(curObject.get(), curObjectid, buffer, 
-					bufferLength, bytesWritten, flushBufferCallback, shallow);
-				if(buffer == nullptr)
-				{
-					BS_EXCEPT(InternalErrorException, 
-						"Destination buffer is null or not large enough.");
-				}
+			// Copy, as encoding may reallocate the list
+			ObjectToEncode curObject = mObjectsToEncode[i];
 
-				foundObjectToProcess = true;
-
-				// Ensure we keep a reference to the object so it isn't released.
-				// The system assigns unique IDs to IReflectable objects based on pointer 
-				// addresses but if objects get released then same address could be assigned twice.
-				// Note: To get around this I could assign unique IDs to IReflectable objects
-				encodedObjects.push_back(curObject);
-
-				break; // Need to start over as mObjectsToSerialize was possibly modified
+			buffer = encodeEntry(curObject.object.get(), curObject.objectId, buffer, 
+				bufferLength, bytesWritten, flushBufferCallback, shallow);
+			if(buffer == nullptr)
+			{
+				BS_EXCEPT(InternalErrorException, 
+					"Destination buffer is null or not large enough.");
 			}
-
-			if(!foundObjectToProcess) // We're done
-				break;
 		}
 
 		// Final flush
@@ -116,7 +94,6 @@ namespace bs
 
 		*bytesWritten = mTotalBytesWritten;
 
-		encodedObjects.clear();
 		mObjectsToEncode.clear();
 		mObjectAddrToId.clear();
 	}
@@ -289,6 +266,22 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Elements stored with the same layout as their serialized form can be copied all at once
+							UINT8* arrayData = curField->getArrayData(object);
+							if(arrayData != nullptr)
+							{
+								buffer = dataBlockToBuffer(arrayData, arrayNumElems * curField->getTypeSize(), buffer, 
+									bufferLength, bytesWritten, flushBufferCallback);
+
+								if (buffer == nullptr || bufferLength == 0)
+								{
+									si->onSerializationEnded(object, mParams);
+									return nullptr;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -402,6 +395,16 @@ namespace bs
 							// Data block size
 							COPY_TO_BUFFER(&dataBlockSize, sizeof(UINT32))
 
+							// Padding so the data starts at an aligned offset in the output
+							static const UINT8 PADDING[DATA_BLOCK_ALIGNMENT] = { 0 };
+
+							UINT32 dataOffset = mOutputOffset + mTotalBytesWritten + *bytesWritten + sizeof(UINT8);
+							UINT8 paddingSize = (UINT8)((DATA_BLOCK_ALIGNMENT - dataOffset % DATA_BLOCK_ALIGNMENT) % 
+								DATA_BLOCK_ALIGNMENT);
+
+							COPY_TO_BUFFER(&paddingSize, sizeof(UINT8))
+							COPY_TO_BUFFER(PADDING, paddingSize)
+
 							// Data block data
 							UINT8* dataToStore = (UINT8*)bs_stack_alloc(dataBlockSize);
 							blockStream->read(dataToStore, dataBlockSize);
@@ -549,7 +552,9 @@ namespace bs
 			UINT8 fieldSize;
 			bool hasDynamicSize;
 			bool terminator;
-			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+			bool alignedDataBlock;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator, 
+				alignedDataBlock);
 
 			if (terminator)
 			{
@@ -604,6 +609,7 @@ namespace bs
 				{
 					serializedArray = bs_shared_ptr_new<SerializedArray>();
 					serializedArray->numElements = arrayNumElems;
+					serializedArray->entries.reserve(arrayNumElems);
 
 					serializedEntry = serializedArray;
 					hasModification = true;
@@ -828,6 +834,19 @@ namespace bs
 
 					bytesRead += DATA_BLOCK_TYPE_FIELD_SIZE;
 
+					// Alignment padding
+					if (alignedDataBlock)
+					{
+						UINT8 paddingSize = 0;
+						if (data->read(&paddingSize, sizeof(UINT8)) != sizeof(UINT8))
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						data->skip(paddingSize);
+						bytesRead += sizeof(UINT8) + paddingSize;
+					}
+
 					// Data block data
 					if (curField != nullptr)
 					{
@@ -995,12 +1014,19 @@ namespace bs
 					{
 						RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+						// Elements stored with the same layout as their serialized form can be written directly
+						UINT8* elemData = curField->getArrayData(object.get());
+						UINT32 elemSize = curField->getTypeSize();
+
 						for (auto& arrayElem : arrayData->entries)
 						{
 							SPtr<SerializedField> fieldData = std::static_pointer_cast<SerializedField>(arrayElem.second.serialized);
 							if (fieldData != nullptr)
 							{
-								curField->arrayElemFromBuffer(object.get(), arrayElem.first, fieldData->value);
+								if (elemData != nullptr && arrayElem.first < arrayNumElems)
+									memcpy(elemData + arrayElem.first * elemSize, fieldData->value, elemSize);
+								else
+									curField->arrayElemFromBuffer(object.get(), arrayElem.first, fieldData->value);
 							}
 						}
 					}
@@ -1119,7 +1145,7 @@ namespace bs
 		SerializableFieldType type, bool hasDynamicSize, bool terminator)
 	{
 		// If O == 0 - Meta contains field information (Encoded using this method)
-		//// Encoding: IIII IIII IIII IIII SSSS SSSS xTYP DCAO
+		//// Encoding: IIII IIII IIII IIII SSSS SSSS LTYP DCAO
 		//// I - Id
 		//// S - Size
 		//// C - Complex
@@ -1129,6 +1155,7 @@ namespace bs
 		//// O - Object descriptor
 		//// Y - Plain field has dynamic size
 		//// T - Terminator (last field in an object)
+		//// L - Data block contents are preceded by alignment padding
 
 		return (id << 16 | size << 8 | 
 			(array ? 0x02 : 0) | 
@@ -1136,11 +1163,12 @@ namespace bs
 			((type == SerializableFT_Reflectable) ? 0x08 : 0) | 
 			((type == SerializableFT_ReflectablePtr) ? 0x10 : 0) | 
 			(hasDynamicSize ? 0x20 : 0) |
-			(terminator ? 0x40 : 0)); // TODO - Low priority. Technically I could encode this much more tightly, and use var-ints for ID
+			(terminator ? 0x40 : 0) |
+			((type == SerializableFT_DataBlock) ? 0x80 : 0)); // TODO - Low priority. Technically I could encode this much more tightly, and use var-ints for ID
 	}
 
 	void BinarySerializer::decodeFieldMetaData(UINT32 encodedData, UINT16& id, UINT8& size, 
-		bool& array, SerializableFieldType& type, bool& hasDynamicSize, bool& terminator)
+		bool& array, SerializableFieldType& type, bool& hasDynamicSize, bool& terminator, bool& alignedDataBlock)
 	{
 		if(isObjectMetaData(encodedData))
 		{
@@ -1148,6 +1176,7 @@ namespace bs
 				"Meta data represents an object description but is trying to be decoded as a field descriptor.");
 		}
 
+		alignedDataBlock = (encodedData & 0x80) != 0;
 		terminator = (encodedData & 0x40) != 0;
 		hasDynamicSize = (encodedData & 0x20) != 0;
 
@@ -61,10 +61,14 @@ namespace bs
 		 *										encoded as well and restored upon decoding.
 		 * @param[in]	params					Optional parameters to be passed to the serialization callbacks on the
 		 *										objects being serialized.
+		 * @param[in]	outputOffset			Offset at which the encoded data will be placed in its final destination
+		 *										(for example a file). Data blocks are aligned to DATA_BLOCK_ALIGNMENT
+		 *										relative to the start of that destination.
 		 */
 		void encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback,
-			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
+			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>(),
+			UINT32 outputOffset = 0);
 
 		/**
 		 * Decodes an object from binary data.
@@ -77,6 +81,12 @@ namespace bs
 		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, 
 			const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
+		/** 
+		 * Alignment of data block contents in the encoded output, in bytes. Allows data blocks to be referenced directly 
+		 * from memory mapped files instead of being copied.
+		 */
+		static const UINT32 DATA_BLOCK_ALIGNMENT = 16;
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -172,9 +182,12 @@ namespace bs
 		static UINT32 encodeFieldMetaData(UINT16 id, UINT8 size, bool array, 
 			SerializableFieldType type, bool hasDynamicSize, bool terminator);
 
-		/** Decode meta field that was encoded using encodeFieldMetaData().*/
+		/** 
+		 * Decode meta field that was encoded using encodeFieldMetaData(). @p alignedDataBlock is true if the field is a 
+		 * data block whose contents are preceded by alignment padding (data encoded by older versions has no padding).
+		 */
 		static void decodeFieldMetaData(UINT32 encodedData, UINT16& id, UINT8& size, bool& array, 
-			SerializableFieldType& type, bool& hasDynamicSize, bool& terminator);
+			SerializableFieldType& type, bool& hasDynamicSize, bool& terminator, bool& alignedDataBlock);
 
 		/**
 		 * Encodes data required for representing an object identifier, into 8 bytes.
@@ -197,6 +210,7 @@ namespace bs
 		UINT32 mLastUsedObjectId;
 		Vector<ObjectToEncode> mObjectsToEncode;
 		UINT32 mTotalBytesWritten;
+		UINT32 mOutputOffset;
 
 		UnorderedMap<SPtr<SerializedObject>, ObjectToDecode> mObjectMap;
 		UnorderedMap<UINT32, SPtr<SerializedObject>> mInterimObjectMap;
@@ -49,7 +49,7 @@ namespace bs
 		BinarySerializer bs;
 		UINT32 totalBytesWritten = 0;
 		bs.encode(object, mWriteBuffer, WRITE_BUFFER_SIZE, &totalBytesWritten, 
-			std::bind(&FileEncoder::flushBuffer, this, _1, _2, _3), false, params);
+			std::bind(&FileEncoder::flushBuffer, this, _1, _2, _3), false, params, (UINT32)curPos + sizeof(UINT32));
 
 		mOutputStream.seekp(curPos);
 		mOutputStream.write((char*)&totalBytesWritten, sizeof(totalBytesWritten));
@@ -18,7 +18,8 @@ namespace bs
 	{ }
 
 	UINT8* MemorySerializer::encode(IReflectable* object, UINT32& bytesWritten, 
-		std::function<void*(UINT32)> allocator, bool shallow, const UnorderedMap<String, UINT64>& params)
+		std::function<void*(UINT32)> allocator, bool shallow, const UnorderedMap<String, UINT64>& params, 
+		UINT32 outputOffset)
 	{
 		using namespace std::placeholders;
 
@@ -31,7 +32,7 @@ namespace bs
 		mBufferPieces.push_back(piece);
 
 		bs.encode(object, piece.buffer, WRITE_BUFFER_SIZE, &bytesWritten, 
-			std::bind(&MemorySerializer::flushBuffer, this, _1, _2, _3), shallow, params);
+			std::bind(&MemorySerializer::flushBuffer, this, _1, _2, _3), shallow, params, outputOffset);
 
 		UINT8* resultBuffer;
 		if(allocator != nullptr)
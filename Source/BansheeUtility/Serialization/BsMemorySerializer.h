@@ -35,12 +35,15 @@ namespace bs
 		 *								and restored upon decoding.
 		 * @param[in]	params			Optional parameters to be passed to the serialization callbacks on the objects being
 		 *								serialized.
+		 * @param[in]	outputOffset	Offset at which the returned data will be placed in its final destination (for
+		 *								example a file). Used for aligning data blocks, see BinarySerializer::encode.
 		 *
 		 * @return						A buffer containing the encoded object. It is up to the user to release the buffer 
 		 *								memory when no longer needed.
 		 */
 		UINT8* encode(IReflectable* object, UINT32& bytesWritten, std::function<void*(UINT32)> allocator = nullptr, 
-			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
+			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>(),
+			UINT32 outputOffset = 0);
 
 		/** 
 		 * Deserializes an IReflectable object by reading the binary data from the provided memory location. 
@@ -0,0 +1,338 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsAABoxTreeTestSuite.h"
+
+#include "Math/BsAABoxTree.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsPlane.h"
+
+#include <algorithm>
+
+namespace bs
+{
+	/** Deterministic pseudo-random number generator, so failures are reproducible. */
+	class TestRandom
+	{
+	public:
+		TestRandom(UINT32 seed) :mState(seed) { }
+
+		/** Returns a value in range [min, max]. */
+		float get(float min, float max)
+		{
+			mState = mState * 1664525U + 1013904223U;
+			return min + (max - min) * ((mState >> 8) / (float)(1 << 24));
+		}
+
+		/** Returns a box with a random position and size inside a 200 units large cube around the origin. */
+		AABox getBox(float maxSize)
+		{
+			Vector3 min(get(-100.0f, 100.0f), get(-100.0f, 100.0f), get(-100.0f, 100.0f));
+			Vector3 size(get(0.1f, maxSize), get(0.1f, maxSize), get(0.1f, maxSize));
+
+			return AABox(min, min + size);
+		}
+
+	private:
+		UINT32 mState;
+	};
+
+	/** Returns a set of test volumes, both axis aligned and arbitrarily oriented. */
+	Vector<ConvexVolume> getTestVolumes()
+	{
+		Vector<ConvexVolume> volumes;
+
+		// Axis aligned box, planes facing inwards
+		Vector<Plane> boxPlanes =
+		{
+			Plane(Vector3(1.0f, 0.0f, 0.0f), -30.0f),
+			Plane(Vector3(-1.0f, 0.0f, 0.0f), -40.0f),
+			Plane(Vector3(0.0f, 1.0f, 0.0f), -50.0f),
+			Plane(Vector3(0.0f, -1.0f, 0.0f), -20.0f),
+			Plane(Vector3(0.0f, 0.0f, 1.0f), -60.0f),
+			Plane(Vector3(0.0f, 0.0f, -1.0f), -10.0f)
+		};
+		volumes.push_back(ConvexVolume(boxPlanes));
+
+		// Tilted slab
+		Vector3 normal = Vector3::normalize(Vector3(1.0f, 2.0f, -0.5f));
+		Vector<Plane> slabPlanes =
+		{
+			Plane(normal, -15.0f),
+			Plane(-normal, -15.0f)
+		};
+		volumes.push_back(ConvexVolume(slabPlanes));
+
+		// Wedge, similar to a frustum without the far plane
+		Vector<Plane> wedgePlanes =
+		{
+			Plane(Vector3::normalize(Vector3(1.0f, 0.0f, 1.0f)), 0.0f),
+			Plane(Vector3::normalize(Vector3(-1.0f, 0.0f, 1.0f)), 0.0f),
+			Plane(Vector3::normalize(Vector3(0.0f, 1.0f, 1.0f)), 0.0f),
+			Plane(Vector3::normalize(Vector3(0.0f, -1.0f, 1.0f)), 0.0f),
+			Plane(Vector3(0.0f, 0.0f, 1.0f), 5.0f)
+		};
+		volumes.push_back(ConvexVolume(wedgePlanes));
+
+		return volumes;
+	}
+
+	/** Checks if all corners of the box are inside the volume. */
+	bool isContained(const ConvexVolume& volume, const AABox& box)
+	{
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			if (!volume.contains(box.getCorner((AABox::Corner)i), 0.001f))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Queries the tree and compares the results against testing each of the provided boxes against the volume. Boxes with
+	 * zero size are treated as not being in the tree. If @p exact is false the query may return additional objects,
+	 * as happens when leaves are enlarged by a margin.
+	 */
+	bool matchesBruteForce(const AABoxTree& tree, const Vector<AABox>& boxes, const ConvexVolume& volume, bool exact)
+	{
+		Vector<UINT32> intersecting;
+		Vector<UINT32> contained;
+		tree.query(volume, intersecting, contained);
+
+		Vector<UINT32> found = intersecting;
+		found.insert(found.end(), contained.begin(), contained.end());
+		std::sort(found.begin(), found.end());
+
+		// Every object must be reported at most once
+		if (std::adjacent_find(found.begin(), found.end()) != found.end())
+			return false;
+
+		Vector<UINT32> expected;
+		for (UINT32 i = 0; i < (UINT32)boxes.size(); i++)
+		{
+			if (boxes[i].getSize() == Vector3::ZERO)
+				continue;
+
+			if (volume.intersects(boxes[i]))
+				expected.push_back(i);
+		}
+
+		if (exact)
+		{
+			if (found != expected)
+				return false;
+
+			// Objects reported as contained must be fully inside the volume
+			for (auto& entry : contained)
+			{
+				if (!isContained(volume, boxes[entry]))
+					return false;
+			}
+		}
+		else
+		{
+			if (!std::includes(found.begin(), found.end(), expected.begin(), expected.end()))
+				return false;
+		}
+
+		return true;
+	}
+
+	AABoxTreeTestSuite::AABoxTreeTestSuite()
+	{
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_after_update);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_after_remove);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_after_rebuild);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_margin);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_overlapping);
+		BS_ADD_TEST(AABoxTreeTestSuite::testQuery_empty);
+	}
+
+	void AABoxTreeTestSuite::testQuery()
+	{
+		TestRandom random(1);
+		AABoxTree tree;
+
+		Vector<AABox> boxes;
+		for (UINT32 i = 0; i < 2000; i++)
+		{
+			boxes.push_back(random.getBox(10.0f));
+			tree.add(boxes.back(), i);
+		}
+
+		BS_TEST_ASSERT(tree.getNumLeaves() == 2000);
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+	}
+
+	void AABoxTreeTestSuite::testQuery_after_update()
+	{
+		TestRandom random(2);
+		AABoxTree tree;
+
+		Vector<AABox> boxes;
+		Vector<UINT32> leaves;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			boxes.push_back(random.getBox(10.0f));
+			leaves.push_back(tree.add(boxes.back(), i));
+		}
+
+		// Move every other object, some by a small amount and some across the whole scene
+		for (UINT32 i = 0; i < 1000; i += 2)
+		{
+			if (i % 4 == 0)
+			{
+				Vector3 offset(random.get(-1.0f, 1.0f), random.get(-1.0f, 1.0f), random.get(-1.0f, 1.0f));
+				boxes[i] = AABox(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+			}
+			else
+				boxes[i] = random.getBox(10.0f);
+
+			tree.update(leaves[i], boxes[i]);
+		}
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+	}
+
+	void AABoxTreeTestSuite::testQuery_after_remove()
+	{
+		TestRandom random(3);
+		AABoxTree tree;
+
+		Vector<AABox> boxes;
+		Vector<UINT32> leaves;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			boxes.push_back(random.getBox(10.0f));
+			leaves.push_back(tree.add(boxes.back(), i));
+		}
+
+		for (UINT32 i = 0; i < 1000; i += 3)
+		{
+			tree.remove(leaves[i]);
+			boxes[i] = AABox(Vector3::ZERO, Vector3::ZERO);
+		}
+
+		BS_TEST_ASSERT(tree.getNumLeaves() == 1000 - 334);
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+
+		// Removed leaves may be reused by new objects
+		for (UINT32 i = 0; i < 1000; i += 3)
+		{
+			boxes[i] = random.getBox(10.0f);
+			leaves[i] = tree.add(boxes[i], i);
+		}
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+	}
+
+	void AABoxTreeTestSuite::testQuery_after_rebuild()
+	{
+		TestRandom random(4);
+		AABoxTree tree;
+
+		Vector<AABox> boxes;
+		Vector<UINT32> leaves;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			boxes.push_back(random.getBox(10.0f));
+			leaves.push_back(tree.add(boxes.back(), i));
+		}
+
+		tree.rebuild();
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+
+		// Leaf identifiers must remain valid after a rebuild
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			BS_TEST_ASSERT(tree.getUserData(leaves[i]) == i);
+
+			boxes[i] = random.getBox(10.0f);
+			tree.update(leaves[i], boxes[i]);
+		}
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+	}
+
+	void AABoxTreeTestSuite::testQuery_margin()
+	{
+		TestRandom random(5);
+		AABoxTree tree(2.0f);
+
+		Vector<AABox> boxes;
+		Vector<UINT32> leaves;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			boxes.push_back(random.getBox(10.0f));
+			leaves.push_back(tree.add(boxes.back(), i));
+		}
+
+		// Small movements stay within the enlarged leaf bounds, and must still be found
+		UINT32 numModified = 0;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			Vector3 offset(random.get(-1.5f, 1.5f), random.get(-1.5f, 1.5f), random.get(-1.5f, 1.5f));
+			boxes[i] = AABox(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+
+			if (tree.update(leaves[i], boxes[i]))
+				numModified++;
+		}
+
+		BS_TEST_ASSERT(numModified == 0);
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, false));
+	}
+
+	void AABoxTreeTestSuite::testQuery_overlapping()
+	{
+		// Many objects with identical bounds produce a poorly balanced tree, with the traversal stack growing the most
+		AABoxTree tree;
+
+		Vector<AABox> boxes;
+		for (UINT32 i = 0; i < 5000; i++)
+		{
+			float offset = (i % 2) * 0.01f;
+			boxes.push_back(AABox(Vector3(-1.0f + offset, -1.0f, 5.0f), Vector3(1.0f, 1.0f, 7.0f)));
+			tree.add(boxes.back(), i);
+		}
+
+		for (auto& volume : getTestVolumes())
+			BS_TEST_ASSERT(matchesBruteForce(tree, boxes, volume, true));
+	}
+
+	void AABoxTreeTestSuite::testQuery_empty()
+	{
+		AABoxTree tree;
+
+		Vector<UINT32> intersecting;
+		Vector<UINT32> contained;
+		tree.query(getTestVolumes()[0], intersecting, contained);
+
+		BS_TEST_ASSERT(intersecting.empty());
+		BS_TEST_ASSERT(contained.empty());
+
+		UINT32 leaf = tree.add(AABox(Vector3(-5.0f, -5.0f, -5.0f), Vector3(-3.0f, -3.0f, -3.0f)), 7);
+		tree.query(getTestVolumes()[0], intersecting, contained);
+
+		BS_TEST_ASSERT(intersecting.empty());
+		BS_TEST_ASSERT(contained.size() == 1 && contained[0] == 7);
+
+		tree.remove(leaf);
+		contained.clear();
+		tree.query(getTestVolumes()[0], intersecting, contained);
+
+		BS_TEST_ASSERT(tree.getNumLeaves() == 0);
+		BS_TEST_ASSERT(contained.empty());
+	}
+}
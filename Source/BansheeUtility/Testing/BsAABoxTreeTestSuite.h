@@ -0,0 +1,23 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT AABoxTreeTestSuite : public TestSuite
+	{
+	public:
+		AABoxTreeTestSuite();
+
+	private:
+		void testQuery();
+		void testQuery_after_update();
+		void testQuery_after_remove();
+		void testQuery_after_rebuild();
+		void testQuery_margin();
+		void testQuery_overlapping();
+		void testQuery_empty();
+	};
+}
@@ -0,0 +1,85 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsBenchmarkSuite.h"
+#include "Testing/BsTestOutput.h"
+#include "Utility/BsTimer.h"
+#include "FileSystem/BsPath.h"
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace bs
+{
+	double BenchmarkSuite::measure(const String& name, UINT32 numRuns, UINT64 numItems,
+		const std::function<void()>& operation, const std::function<void()>& prepare)
+	{
+		numRuns = std::max(numRuns, 1U);
+
+		Vector<UINT64> runTimes(numRuns);
+		for (UINT32 i = 0; i < numRuns; i++)
+		{
+			if (prepare)
+				prepare();
+
+			Timer timer;
+			operation();
+			runTimes[i] = timer.getMicroseconds();
+		}
+
+		std::sort(runTimes.begin(), runTimes.end());
+
+		double medianUs = (double)runTimes[numRuns / 2];
+		if ((numRuns % 2) == 0)
+			medianUs = (runTimes[numRuns / 2 - 1] + runTimes[numRuns / 2]) * 0.5;
+
+		StringStream output;
+		output << std::fixed << std::setprecision(1) << "median " << medianUs << " us, min " << runTimes[0] << " us";
+
+		if (numItems > 1 && medianUs > 0.0)
+		{
+			double itemNs = medianUs * 1000.0 / numItems;
+			double itemsPerSecond = numItems / (medianUs * 0.000001);
+
+			output << " (" << itemNs << " ns/item, " << std::setprecision(0) << itemsPerSecond << " items/s)";
+		}
+
+		output << ", " << numRuns << " runs";
+
+		report(name, output.str());
+		return medianUs;
+	}
+
+	void BenchmarkSuite::report(const String& name, const String& value)
+	{
+		mOutput->outputResult(name, value, mActiveTestName);
+	}
+
+	bool BenchmarkSuite::evictFromFileCache(const Path& path)
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		int fd = open(path.toPlatformString().c_str(), O_RDONLY);
+		if (fd == -1)
+			return false;
+
+		// Only clean pages can be evicted, so flush any pending writes first
+		fdatasync(fd);
+		bool evicted = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+
+		close(fd);
+		return evicted;
+#else
+		return false;
+#endif
+	}
+
+	UINT32 BenchmarkSuite::touchPages(const UINT8* data, size_t size)
+	{
+		UINT32 sum = 0;
+		for (size_t i = 0; i < size; i += 4096)
+			sum += data[i];
+
+		return sum + data[size - 1];
+	}
+}
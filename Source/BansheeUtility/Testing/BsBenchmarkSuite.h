@@ -0,0 +1,52 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing
+	 *  @{
+	 */
+
+	/**
+	 * Base class for performance benchmarks. Benchmarks are registered and ran the same as unit tests, and use measure()
+	 * to time an operation and report the timings to the test output.
+	 */
+	class BS_UTILITY_EXPORT BenchmarkSuite : public TestSuite
+	{
+	protected:
+		/**
+		 * Runs an operation multiple times and reports the median and minimum time of a single run to the test output.
+		 *
+		 * @param[in]	name		Name of the measured operation, as displayed in the output.
+		 * @param[in]	numRuns		Number of times to run the operation.
+		 * @param[in]	numItems	Number of items processed by a single run of the operation. If larger than one,
+		 *							time per item is reported as well.
+		 * @param[in]	operation	Operation to measure.
+		 * @param[in]	prepare		Optional callback to call before every run, excluded from the measured time.
+		 * @return					Median time of a single run, in microseconds.
+		 */
+		double measure(const String& name, UINT32 numRuns, UINT64 numItems, const std::function<void()>& operation,
+			const std::function<void()>& prepare = nullptr);
+
+		/** Reports a measured value that isn't a timing (e.g. memory use) to the test output. */
+		void report(const String& name, const String& value);
+
+		/**
+		 * Removes the provided file from the OS file cache, so the next read has to go to the disk. Returns false if
+		 * not supported on the current platform.
+		 */
+		static bool evictFromFileCache(const Path& path);
+
+		/**
+		 * Reads a byte from every page of the provided data, making sure it was actually loaded (e.g. from a memory
+		 * mapped file). Returns a checksum of the read bytes, so the reads aren't optimized away.
+		 */
+		static UINT32 touchPages(const UINT8* data, size_t size);
+	};
+
+	/** @} */
+}
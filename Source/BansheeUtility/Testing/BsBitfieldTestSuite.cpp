@@ -0,0 +1,150 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsBitfieldTestSuite.h"
+
+#include "Utility/BsBitfield.h"
+
+namespace bs
+{
+	/** Checks that all bits in the provided range have the provided value. */
+	bool hasValue(const Bitfield& bitfield, UINT32 begin, UINT32 end, bool value)
+	{
+		for (UINT32 i = begin; i < end; i++)
+		{
+			if (bitfield[i] != value)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Checks that bits in the last word past the size of the bitfield are unset. */
+	bool hasClearTail(const Bitfield& bitfield)
+	{
+		UINT32 numUsedBits = bitfield.size() & (Bitfield::BITS_PER_WORD - 1);
+		if (numUsedBits == 0)
+			return true;
+
+		UINT64 lastWord = bitfield.getWords()[bitfield.getNumWords() - 1];
+		return (lastWord >> numUsedBits) == 0;
+	}
+
+	BitfieldTestSuite::BitfieldTestSuite()
+	{
+		BS_ADD_TEST(BitfieldTestSuite::testAssign);
+		BS_ADD_TEST(BitfieldTestSuite::testSet);
+		BS_ADD_TEST(BitfieldTestSuite::testResize_grow);
+		BS_ADD_TEST(BitfieldTestSuite::testResize_shrink);
+		BS_ADD_TEST(BitfieldTestSuite::testOr);
+		BS_ADD_TEST(BitfieldTestSuite::testClear);
+	}
+
+	void BitfieldTestSuite::testAssign()
+	{
+		Bitfield bitfield(100, true);
+
+		BS_TEST_ASSERT(bitfield.size() == 100);
+		BS_TEST_ASSERT(bitfield.getNumWords() == 2);
+		BS_TEST_ASSERT(hasValue(bitfield, 0, 100, true));
+		BS_TEST_ASSERT(hasClearTail(bitfield));
+
+		bitfield.assign(64, false);
+
+		BS_TEST_ASSERT(bitfield.size() == 64);
+		BS_TEST_ASSERT(bitfield.getNumWords() == 1);
+		BS_TEST_ASSERT(hasValue(bitfield, 0, 64, false));
+	}
+
+	void BitfieldTestSuite::testSet()
+	{
+		Bitfield bitfield(130);
+
+		// Bits at word boundaries
+		bitfield.set(0);
+		bitfield.set(63);
+		bitfield.set(64);
+		bitfield.set(129);
+
+		for (UINT32 i = 0; i < 130; i++)
+		{
+			bool expected = i == 0 || i == 63 || i == 64 || i == 129;
+			BS_TEST_ASSERT(bitfield[i] == expected);
+		}
+
+		BS_TEST_ASSERT(bitfield.getWords()[0] == ((1ULL << 63) | 1ULL));
+		BS_TEST_ASSERT(bitfield.getWords()[1] == 1ULL);
+		BS_TEST_ASSERT(bitfield.getWords()[2] == 2ULL);
+
+		bitfield.set(63, false);
+		BS_TEST_ASSERT(!bitfield[63]);
+		BS_TEST_ASSERT(bitfield[0]);
+		BS_TEST_ASSERT(bitfield[64]);
+	}
+
+	void BitfieldTestSuite::testResize_grow()
+	{
+		Bitfield bitfield(10, false);
+		bitfield.set(3);
+
+		// New bits in the partially used word and in new words must both receive the value
+		bitfield.resize(150, true);
+
+		BS_TEST_ASSERT(bitfield.size() == 150);
+		BS_TEST_ASSERT(hasValue(bitfield, 0, 3, false));
+		BS_TEST_ASSERT(bitfield[3]);
+		BS_TEST_ASSERT(hasValue(bitfield, 4, 10, false));
+		BS_TEST_ASSERT(hasValue(bitfield, 10, 150, true));
+		BS_TEST_ASSERT(hasClearTail(bitfield));
+
+		bitfield.resize(200, false);
+		BS_TEST_ASSERT(hasValue(bitfield, 10, 150, true));
+		BS_TEST_ASSERT(hasValue(bitfield, 150, 200, false));
+	}
+
+	void BitfieldTestSuite::testResize_shrink()
+	{
+		Bitfield bitfield(128, true);
+		bitfield.resize(70);
+
+		BS_TEST_ASSERT(bitfield.size() == 70);
+		BS_TEST_ASSERT(bitfield.getNumWords() == 2);
+		BS_TEST_ASSERT(hasValue(bitfield, 0, 70, true));
+		BS_TEST_ASSERT(hasClearTail(bitfield));
+
+		// Bits removed by shrinking must not reappear when growing again
+		bitfield.resize(128, false);
+		BS_TEST_ASSERT(hasValue(bitfield, 70, 128, false));
+	}
+
+	void BitfieldTestSuite::testOr()
+	{
+		Bitfield a(100);
+		Bitfield b(100);
+
+		a.set(1);
+		a.set(70);
+		b.set(2);
+		b.set(70);
+		b.set(99);
+
+		a |= b;
+
+		for (UINT32 i = 0; i < 100; i++)
+		{
+			bool expected = i == 1 || i == 2 || i == 70 || i == 99;
+			BS_TEST_ASSERT(a[i] == expected);
+		}
+	}
+
+	void BitfieldTestSuite::testClear()
+	{
+		Bitfield bitfield(100, true);
+		bitfield.clear();
+
+		BS_TEST_ASSERT(bitfield.size() == 0);
+		BS_TEST_ASSERT(bitfield.getNumWords() == 0);
+
+		bitfield.resize(10, false);
+		BS_TEST_ASSERT(hasValue(bitfield, 0, 10, false));
+	}
+}
@@ -0,0 +1,22 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT BitfieldTestSuite : public TestSuite
+	{
+	public:
+		BitfieldTestSuite();
+
+	private:
+		void testAssign();
+		void testSet();
+		void testResize_grow();
+		void testResize_shrink();
+		void testOr();
+		void testClear();
+	};
+}
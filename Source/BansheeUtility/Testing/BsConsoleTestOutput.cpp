@@ -13,4 +13,9 @@ namespace bs
 	{
 		std::cout << file << ":" << line << ": failure: " << desc << std::endl;
 	}
+
+	void ConsoleTestOutput::outputResult(const String& name, const String& value, const String& function)
+	{
+		std::cout << function << ": " << name << ": " << value << std::endl;
+	}
 }
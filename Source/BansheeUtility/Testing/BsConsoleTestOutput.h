@@ -11,7 +11,7 @@ namespace bs
 	 *  @{
 	 */
 
-	/** Outputs unit test failures to stdout. */
+	/** Outputs unit test failures and measured values to stdout. */
 	class BS_UTILITY_EXPORT ConsoleTestOutput : public TestOutput
 	{
 	public:
@@ -20,6 +20,9 @@ namespace bs
 		                const String& function,
 		                const String& file,
 		                long line) final override;
+
+		/** @copydoc TestOutput::outputResult */
+		void outputResult(const String& name, const String& value, const String& function) final override;
 	};
 
 	/** @} */
@@ -0,0 +1,271 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsDataStreamTestSuite.h"
+
+#include "Debug/BsDebug.h"
+#include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
+
+namespace bs
+{
+	const String dataStreamTestDirectoryName = "DataStreamTestDirectory/";
+
+	/** Size of the test file. Each byte of the file contains its offset, modulo 256. */
+	const UINT32 testFileSize = 1000;
+
+	/** Opens a memory mapped file, returning null if the returned stream isn't a MappedFileDataStream. */
+	SPtr<MappedFileDataStream> openMappedStream(const Path& path)
+	{
+		SPtr<DataStream> stream = FileSystem::openMappedFile(path);
+		if (stream == nullptr || !stream->isMemoryMapped())
+			return nullptr;
+
+		return std::static_pointer_cast<MappedFileDataStream>(stream);
+	}
+
+	/** Checks that the provided bytes match the test file contents starting at the provided offset. */
+	bool matchesTestFile(const UINT8* data, UINT32 offset, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (data[i] != (UINT8)(offset + i))
+				return false;
+		}
+
+		return true;
+	}
+
+	void DataStreamTestSuite::startUp()
+	{
+		mTestDirectory = FileSystem::getWorkingDirectoryPath() + dataStreamTestDirectoryName;
+		if (FileSystem::exists(mTestDirectory))
+		{
+			BS_EXCEPT(InternalErrorException,
+				String("Directory '") + dataStreamTestDirectoryName
+				+ "' should not already exist; you should remove it manually.");
+		}
+
+		FileSystem::createDir(mTestDirectory);
+		BS_TEST_ASSERT_MSG(FileSystem::exists(mTestDirectory), "DataStreamTestSuite::startUp(): test directory creation failed");
+
+		UINT8 contents[testFileSize];
+		for (UINT32 i = 0; i < testFileSize; i++)
+			contents[i] = (UINT8)i;
+
+		mTestFile = mTestDirectory + "test.bin";
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(mTestFile);
+		stream->write(contents, testFileSize);
+		stream->close();
+	}
+
+	void DataStreamTestSuite::shutDown()
+	{
+		FileSystem::remove(mTestDirectory, true);
+		if (FileSystem::exists(mTestDirectory))
+		{
+			LOGERR("DataStreamTestSuite failed to delete '" + mTestDirectory.toString()
+				   + "', you should remove it manually.");
+		}
+	}
+
+	DataStreamTestSuite::DataStreamTestSuite()
+	{
+		BS_ADD_TEST(DataStreamTestSuite::testOpenMappedFile);
+		BS_ADD_TEST(DataStreamTestSuite::testOpenMappedFile_empty);
+		BS_ADD_TEST(DataStreamTestSuite::testOpenMappedFile_missing);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_read);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_offset_read);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_private_write);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_close);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_sub_view);
+		BS_ADD_TEST(DataStreamTestSuite::testMappedFile_sub_view_lifetime);
+	}
+
+	void DataStreamTestSuite::testOpenMappedFile()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		BS_TEST_ASSERT(stream->size() == testFileSize);
+		BS_TEST_ASSERT(stream->tell() == 0);
+		BS_TEST_ASSERT(!stream->eof());
+		BS_TEST_ASSERT(!stream->isFile());
+		BS_TEST_ASSERT(stream->getPath() == mTestFile);
+		BS_TEST_ASSERT(matchesTestFile(stream->getPtr(), 0, testFileSize));
+	}
+
+	void DataStreamTestSuite::testOpenMappedFile_empty()
+	{
+		Path path = mTestDirectory + "empty.bin";
+		FileSystem::createAndOpenFile(path)->close();
+
+		SPtr<MappedFileDataStream> stream = openMappedStream(path);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		UINT8 value = 0;
+		BS_TEST_ASSERT(stream->size() == 0);
+		BS_TEST_ASSERT(stream->eof());
+		BS_TEST_ASSERT(stream->read(&value, 1) == 0);
+	}
+
+	void DataStreamTestSuite::testOpenMappedFile_missing()
+	{
+		BS_TEST_ASSERT(FileSystem::openMappedFile(mTestDirectory + "missing.bin") == nullptr);
+	}
+
+	void DataStreamTestSuite::testMappedFile_read()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		UINT8 buffer[testFileSize + 10];
+		BS_TEST_ASSERT(stream->read(buffer, 100) == 100);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 0, 100));
+		BS_TEST_ASSERT(stream->tell() == 100);
+
+		// Reads past the end of the file are truncated
+		BS_TEST_ASSERT(stream->read(buffer, testFileSize) == testFileSize - 100);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 100, testFileSize - 100));
+		BS_TEST_ASSERT(stream->eof());
+		BS_TEST_ASSERT(stream->read(buffer, 1) == 0);
+	}
+
+	void DataStreamTestSuite::testMappedFile_offset_read()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		UINT8 buffer[64];
+
+		stream->seek(500);
+		BS_TEST_ASSERT(stream->tell() == 500);
+		BS_TEST_ASSERT(stream->getCurrentPtr() == stream->getPtr() + 500);
+		BS_TEST_ASSERT(stream->read(buffer, 64) == 64);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 500, 64));
+
+		stream->skip(36);
+		BS_TEST_ASSERT(stream->tell() == 600);
+		BS_TEST_ASSERT(stream->read(buffer, 1) == 1 && buffer[0] == (UINT8)600);
+
+		// Seek backwards
+		stream->seek(3);
+		BS_TEST_ASSERT(stream->read(buffer, 4) == 4);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 3, 4));
+
+		stream->seek(testFileSize - 8);
+		BS_TEST_ASSERT(stream->read(buffer, 64) == 8);
+		BS_TEST_ASSERT(matchesTestFile(buffer, testFileSize - 8, 8));
+		BS_TEST_ASSERT(stream->eof());
+	}
+
+	void DataStreamTestSuite::testMappedFile_private_write()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		// Writes to the mapped memory are only visible through this mapping
+		stream->getPtr()[10] = 0xFF;
+		BS_TEST_ASSERT(stream->getPtr()[10] == 0xFF);
+
+		SPtr<MappedFileDataStream> otherStream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(otherStream != nullptr && otherStream->getPtr()[10] == 10);
+
+		stream->close();
+
+		SPtr<DataStream> fileStream = FileSystem::openFile(mTestFile);
+		fileStream->seek(10);
+
+		UINT8 value = 0;
+		fileStream->read(&value, 1);
+		BS_TEST_ASSERT(value == 10);
+	}
+
+	void DataStreamTestSuite::testMappedFile_close()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		stream->close();
+		BS_TEST_ASSERT(stream->getPtr() == nullptr);
+		BS_TEST_ASSERT(stream->eof());
+
+		// Closing again is a no-op
+		stream->close();
+		BS_TEST_ASSERT(stream->getPtr() == nullptr);
+	}
+
+	void DataStreamTestSuite::testMappedFile_sub_view()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		SPtr<MappedFileDataStream> view = bs_shared_ptr_new<MappedFileDataStream>(stream, 300, 200);
+		BS_TEST_ASSERT(view->isMemoryMapped());
+		BS_TEST_ASSERT(view->getPath() == mTestFile);
+		BS_TEST_ASSERT(view->size() == 200);
+		BS_TEST_ASSERT(view->tell() == 0);
+
+		// View shares the parent's mapping
+		BS_TEST_ASSERT(view->getPtr() == stream->getPtr() + 300);
+
+		// Offsets are relative to the start of the view, and reads are limited to the view
+		UINT8 buffer[256];
+		view->seek(50);
+		BS_TEST_ASSERT(view->read(buffer, 16) == 16);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 350, 16));
+
+		view->seek(190);
+		BS_TEST_ASSERT(view->read(buffer, 64) == 10);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 490, 10));
+		BS_TEST_ASSERT(view->eof());
+
+		// Position of the view is independent from the position of the parent
+		BS_TEST_ASSERT(stream->tell() == 0);
+
+		// View of a view references the same mapping
+		SPtr<MappedFileDataStream> nestedView = bs_shared_ptr_new<MappedFileDataStream>(view, 100, 100);
+		BS_TEST_ASSERT(nestedView->getPtr() == stream->getPtr() + 400);
+		BS_TEST_ASSERT(nestedView->read(buffer, 100) == 100);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 400, 100));
+	}
+
+	void DataStreamTestSuite::testMappedFile_sub_view_lifetime()
+	{
+		SPtr<MappedFileDataStream> stream = openMappedStream(mTestFile);
+		BS_TEST_ASSERT(stream != nullptr);
+		if (stream == nullptr)
+			return;
+
+		SPtr<MappedFileDataStream> viewA = bs_shared_ptr_new<MappedFileDataStream>(stream, 0, 100);
+		SPtr<MappedFileDataStream> viewB = bs_shared_ptr_new<MappedFileDataStream>(stream, 900, 100);
+
+		// Views keep the mapping alive after the parent stream is released
+		stream = nullptr;
+		BS_TEST_ASSERT(matchesTestFile(viewA->getPtr(), 0, 100));
+
+		// Closing a view doesn't unmap the memory referenced by other views
+		viewA->close();
+		BS_TEST_ASSERT(viewA->getPtr() == nullptr);
+		BS_TEST_ASSERT(matchesTestFile(viewB->getPtr(), 900, 100));
+
+		UINT8 buffer[100];
+		BS_TEST_ASSERT(viewB->read(buffer, 100) == 100);
+		BS_TEST_ASSERT(matchesTestFile(buffer, 900, 100));
+	}
+}
@@ -0,0 +1,30 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT DataStreamTestSuite : public TestSuite
+	{
+	public:
+		DataStreamTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testOpenMappedFile();
+		void testOpenMappedFile_empty();
+		void testOpenMappedFile_missing();
+		void testMappedFile_read();
+		void testMappedFile_offset_read();
+		void testMappedFile_private_write();
+		void testMappedFile_close();
+		void testMappedFile_sub_view();
+		void testMappedFile_sub_view_lifetime();
+
+		Path mTestDirectory;
+		Path mTestFile;
+	};
+}
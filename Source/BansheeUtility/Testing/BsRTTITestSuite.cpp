@@ -0,0 +1,473 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsRTTITestSuite.h"
+
+#include "Reflection/BsRTTIType.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Allocators/BsMemStack.h"
+
+namespace bs
+{
+	struct TestRTTIObjectA : IReflectable
+	{
+		UINT32 intA = 10;
+		String strA = "10";
+		float floatA = 10.0f;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class TestRTTIObjectARTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct TestRTTIObjectB : TestRTTIObjectA
+	{
+		UINT32 intB = 20;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class TestRTTIObjectBRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct TestRTTIObjectC : IReflectable
+	{
+		Vector<float> floats;
+		Vector<UINT32> ints;
+		Vector<bool> bools;
+		Vector<String> strings;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class TestRTTIObjectCRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct TestRTTIObjectD : IReflectable
+	{
+		String name;
+		Vector<UINT8> data;
+		UINT32 dataOffset = 0; // Position of the data block in the stream it was decoded from
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class TestRTTIObjectDRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestRTTIObjectARTTI : public RTTIType<TestRTTIObjectA, IReflectable, TestRTTIObjectARTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(intA, 0)
+			BS_RTTI_MEMBER_PLAIN(strA, 1)
+			BS_RTTI_MEMBER_PLAIN(floatA, 4)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestRTTIObjectARTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestRTTIObjectA";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestRTTIObjectA;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestRTTIObjectA>();
+		}
+	};
+
+	class TestRTTIObjectBRTTI : public RTTIType<TestRTTIObjectB, TestRTTIObjectA, TestRTTIObjectBRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(intB, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestRTTIObjectBRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestRTTIObjectB";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestRTTIObjectB;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestRTTIObjectB>();
+		}
+	};
+
+	class TestRTTIObjectCRTTI : public RTTIType<TestRTTIObjectC, IReflectable, TestRTTIObjectCRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(floats, 0)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(ints, 1)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(bools, 2)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(strings, 3)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestRTTIObjectCRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestRTTIObjectC";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestRTTIObjectC;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestRTTIObjectC>();
+		}
+	};
+
+	class TestRTTIObjectDRTTI : public RTTIType<TestRTTIObjectD, IReflectable, TestRTTIObjectDRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(name, 0)
+		BS_END_RTTI_MEMBERS
+
+		SPtr<DataStream> getData(TestRTTIObjectD* obj, UINT32& size)
+		{
+			size = (UINT32)obj->data.size();
+			return bs_shared_ptr_new<MemoryDataStream>(obj->data.data(), obj->data.size(), false);
+		}
+
+		void setData(TestRTTIObjectD* obj, const SPtr<DataStream>& value, UINT32 size)
+		{
+			obj->dataOffset = (UINT32)value->tell();
+			obj->data.resize(size);
+			value->read(obj->data.data(), size);
+		}
+
+	public:
+		TestRTTIObjectDRTTI()
+			:mInitMembers(this)
+		{
+			addDataBlockField("data", 1, &TestRTTIObjectDRTTI::getData, &TestRTTIObjectDRTTI::setData);
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestRTTIObjectD";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestRTTIObjectD;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestRTTIObjectD>();
+		}
+	};
+
+	RTTITypeBase* TestRTTIObjectA::getRTTIStatic()
+	{
+		return TestRTTIObjectARTTI::instance();
+	}
+
+	RTTITypeBase* TestRTTIObjectA::getRTTI() const
+	{
+		return TestRTTIObjectA::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestRTTIObjectB::getRTTIStatic()
+	{
+		return TestRTTIObjectBRTTI::instance();
+	}
+
+	RTTITypeBase* TestRTTIObjectB::getRTTI() const
+	{
+		return TestRTTIObjectB::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestRTTIObjectC::getRTTIStatic()
+	{
+		return TestRTTIObjectCRTTI::instance();
+	}
+
+	RTTITypeBase* TestRTTIObjectC::getRTTI() const
+	{
+		return TestRTTIObjectC::getRTTIStatic();
+	}
+
+	RTTITypeBase* TestRTTIObjectD::getRTTIStatic()
+	{
+		return TestRTTIObjectDRTTI::instance();
+	}
+
+	RTTITypeBase* TestRTTIObjectD::getRTTI() const
+	{
+		return TestRTTIObjectD::getRTTIStatic();
+	}
+
+	/** Serializes the object into memory and deserializes it into a new object. */
+	SPtr<TestRTTIObjectC> encodeAndDecode(TestRTTIObjectC& object)
+	{
+		MemorySerializer serializer;
+
+		UINT32 bufferSize = 0;
+		UINT8* buffer = serializer.encode(&object, bufferSize, (void*(*)(UINT32))&bs_alloc);
+
+		SPtr<IReflectable> output = serializer.decode(buffer, bufferSize);
+		bs_free(buffer);
+
+		if (output == nullptr || output->getTypeId() != TID_TestRTTIObjectC)
+			return nullptr;
+
+		return std::static_pointer_cast<TestRTTIObjectC>(output);
+	}
+
+	/**
+	 * Writes the value using its RTTIPlainType and reads it back. Returns true if the same value was read back, and if the
+	 * number of written and read bytes matches the reported size.
+	 */
+	template<class T>
+	bool writeAndReadPlainType(const T& value)
+	{
+		UINT32 size = rttiGetElemSize(value);
+		Vector<char> buffer(size + 1, 0);
+
+		char* writeEnd = rttiWriteElem(value, buffer.data());
+
+		T output;
+		char* readEnd = rttiReadElem(output, buffer.data());
+
+		return output == value && writeEnd == buffer.data() + size && readEnd == writeEnd;
+	}
+
+	/** Type ID that no RTTI type is registered with. */
+	static const UINT32 UNUSED_TYPE_ID = 0xFFFFFFFE;
+
+	RTTITestSuite::RTTITestSuite()
+	{
+		BS_ADD_TEST(RTTITestSuite::testTypeLookup);
+		BS_ADD_TEST(RTTITestSuite::testTypeLookup_unknown);
+		BS_ADD_TEST(RTTITestSuite::testCreateInstance);
+		BS_ADD_TEST(RTTITestSuite::testDuplicateTypeId);
+		BS_ADD_TEST(RTTITestSuite::testFieldLookup);
+		BS_ADD_TEST(RTTITestSuite::testFieldLookup_unknown);
+		BS_ADD_TEST(RTTITestSuite::testPlainArray_roundTrip);
+		BS_ADD_TEST(RTTITestSuite::testPlainArray_empty);
+		BS_ADD_TEST(RTTITestSuite::testPlainType_vector);
+		BS_ADD_TEST(RTTITestSuite::testDataBlock_alignment);
+	}
+
+	void RTTITestSuite::startUp()
+	{
+		// Encoding data blocks uses stack allocations
+		MemStack::beginThread();
+	}
+
+	void RTTITestSuite::shutDown()
+	{
+		MemStack::endThread();
+	}
+
+	void RTTITestSuite::testTypeLookup()
+	{
+		RTTITypeBase* typeA = IReflectable::_getRTTIfromTypeId(TID_TestRTTIObjectA);
+		BS_TEST_ASSERT(typeA == TestRTTIObjectA::getRTTIStatic());
+
+		// Types registered as derived classes of another type must be found as well, not only root types
+		RTTITypeBase* typeB = IReflectable::_getRTTIfromTypeId(TID_TestRTTIObjectB);
+		BS_TEST_ASSERT(typeB == TestRTTIObjectB::getRTTIStatic());
+		BS_TEST_ASSERT(typeB->getBaseClass() == typeA);
+	}
+
+	void RTTITestSuite::testTypeLookup_unknown()
+	{
+		BS_TEST_ASSERT(IReflectable::_getRTTIfromTypeId(UNUSED_TYPE_ID) == nullptr);
+	}
+
+	void RTTITestSuite::testCreateInstance()
+	{
+		SPtr<IReflectable> objA = IReflectable::createInstanceFromTypeId(TID_TestRTTIObjectA);
+		BS_TEST_ASSERT(objA != nullptr && objA->getTypeId() == TID_TestRTTIObjectA);
+
+		SPtr<IReflectable> objB = IReflectable::createInstanceFromTypeId(TID_TestRTTIObjectB);
+		BS_TEST_ASSERT(objB != nullptr && objB->getTypeId() == TID_TestRTTIObjectB);
+		BS_TEST_ASSERT(objB != nullptr && objB->isDerivedFrom(TestRTTIObjectA::getRTTIStatic()));
+
+		BS_TEST_ASSERT(IReflectable::createInstanceFromTypeId(UNUSED_TYPE_ID) == nullptr);
+	}
+
+	void RTTITestSuite::testDuplicateTypeId()
+	{
+		BS_TEST_ASSERT(IReflectable::_isTypeIdDuplicate(TID_TestRTTIObjectA));
+		BS_TEST_ASSERT(IReflectable::_isTypeIdDuplicate(TID_TestRTTIObjectB));
+		BS_TEST_ASSERT(!IReflectable::_isTypeIdDuplicate(UNUSED_TYPE_ID));
+
+		// Abstract types all share the same ID
+		BS_TEST_ASSERT(!IReflectable::_isTypeIdDuplicate(TID_Abstract));
+	}
+
+	void RTTITestSuite::testFieldLookup()
+	{
+		RTTITypeBase* typeA = TestRTTIObjectA::getRTTIStatic();
+		BS_TEST_ASSERT(typeA->getNumFields() == 3);
+
+		UINT32 fieldIds[] = { 0, 1, 4 };
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			RTTIField* field = typeA->findField((int)fieldIds[i]);
+			BS_TEST_ASSERT(field != nullptr && field->mUniqueId == fieldIds[i]);
+			BS_TEST_ASSERT(field != nullptr && typeA->findField(field->mName) == field);
+		}
+
+		// Field IDs are local to each type
+		RTTITypeBase* typeB = TestRTTIObjectB::getRTTIStatic();
+		RTTIField* fieldB = typeB->findField(0);
+		BS_TEST_ASSERT(fieldB != nullptr && fieldB->mName == "intB");
+		BS_TEST_ASSERT(typeA->findField(0) != fieldB);
+	}
+
+	void RTTITestSuite::testFieldLookup_unknown()
+	{
+		RTTITypeBase* typeA = TestRTTIObjectA::getRTTIStatic();
+
+		// Gaps in the field ID range
+		BS_TEST_ASSERT(typeA->findField(2) == nullptr);
+		BS_TEST_ASSERT(typeA->findField(3) == nullptr);
+
+		// Outside of the field ID range
+		BS_TEST_ASSERT(typeA->findField(-1) == nullptr);
+		BS_TEST_ASSERT(typeA->findField(5) == nullptr);
+		BS_TEST_ASSERT(typeA->findField(1000) == nullptr);
+
+		RTTITypeBase* typeB = TestRTTIObjectB::getRTTIStatic();
+		BS_TEST_ASSERT(typeB->findField(1) == nullptr);
+	}
+
+	void RTTITestSuite::testPlainArray_roundTrip()
+	{
+		// Floats and integers are serialized as a single block, while bools and strings go through per element encoding
+		TestRTTIObjectC object;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			object.floats.push_back(i * 0.5f);
+			object.ints.push_back(i * 7919);
+			object.bools.push_back(i % 3 == 0);
+		}
+
+		object.strings = { "first", "", "third" };
+
+		SPtr<TestRTTIObjectC> output = encodeAndDecode(object);
+		BS_TEST_ASSERT(output != nullptr);
+		if (output == nullptr)
+			return;
+
+		BS_TEST_ASSERT(output->floats == object.floats);
+		BS_TEST_ASSERT(output->ints == object.ints);
+		BS_TEST_ASSERT(output->bools == object.bools);
+		BS_TEST_ASSERT(output->strings == object.strings);
+	}
+
+	void RTTITestSuite::testPlainArray_empty()
+	{
+		TestRTTIObjectC object;
+		object.ints = { 5 };
+
+		SPtr<TestRTTIObjectC> output = encodeAndDecode(object);
+		BS_TEST_ASSERT(output != nullptr);
+		if (output == nullptr)
+			return;
+
+		BS_TEST_ASSERT(output->floats.empty());
+		BS_TEST_ASSERT(output->ints == object.ints);
+		BS_TEST_ASSERT(output->bools.empty());
+		BS_TEST_ASSERT(output->strings.empty());
+	}
+
+	void RTTITestSuite::testPlainType_vector()
+	{
+		Vector<UINT32> ints = { 1, 2, 3, 0xFFFFFFFF };
+		BS_TEST_ASSERT(writeAndReadPlainType(ints));
+		BS_TEST_ASSERT(writeAndReadPlainType(Vector<UINT32>()));
+
+		Vector<float> floats = { 0.25f, -1.0f, 1000.0f };
+		BS_TEST_ASSERT(writeAndReadPlainType(floats));
+
+		Vector<bool> bools = { true, false, false, true, true };
+		BS_TEST_ASSERT(writeAndReadPlainType(bools));
+
+		Vector<String> strings = { "a", "", "abc" };
+		BS_TEST_ASSERT(writeAndReadPlainType(strings));
+	}
+
+	void RTTITestSuite::testDataBlock_alignment()
+	{
+		// Name length and output offset move the data block around, it must always end up aligned within the output
+		for (UINT32 nameLength = 0; nameLength < 20; nameLength++)
+		{
+			for (UINT32 outputOffset = 0; outputOffset < 20; outputOffset++)
+			{
+				TestRTTIObjectD object;
+				object.name = String(nameLength, 'a');
+				object.data = { 1, 2, 3, 4, 5, 6, 7 };
+
+				MemorySerializer serializer;
+
+				UINT32 bufferSize = 0;
+				UINT8* buffer = serializer.encode(&object, bufferSize, (void*(*)(UINT32))&bs_alloc, false,
+					UnorderedMap<String, UINT64>(), outputOffset);
+
+				SPtr<IReflectable> decoded = serializer.decode(buffer, bufferSize);
+				bs_free(buffer);
+
+				BS_TEST_ASSERT(decoded != nullptr && decoded->getTypeId() == TID_TestRTTIObjectD);
+				if (decoded == nullptr || decoded->getTypeId() != TID_TestRTTIObjectD)
+					return;
+
+				SPtr<TestRTTIObjectD> output = std::static_pointer_cast<TestRTTIObjectD>(decoded);
+				BS_TEST_ASSERT(output->name == object.name);
+				BS_TEST_ASSERT(output->data == object.data);
+				BS_TEST_ASSERT((output->dataOffset + outputOffset) % BinarySerializer::DATA_BLOCK_ALIGNMENT == 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,28 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT RTTITestSuite : public TestSuite
+	{
+	public:
+		RTTITestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testTypeLookup();
+		void testTypeLookup_unknown();
+		void testCreateInstance();
+		void testDuplicateTypeId();
+		void testFieldLookup();
+		void testFieldLookup_unknown();
+		void testPlainArray_roundTrip();
+		void testPlainArray_empty();
+		void testPlainType_vector();
+		void testDataBlock_alignment();
+	};
+}
@@ -0,0 +1,256 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsSerializationBenchmarkSuite.h"
+
+#include "Reflection/BsRTTIType.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Allocators/BsMemStack.h"
+#include "Math/BsVector3.h"
+
+namespace bs
+{
+	static const UINT32 NUM_NODES = 100000;
+	static const UINT32 NUM_RUNS = 5;
+
+	struct BenchmarkNode : IReflectable
+	{
+		UINT32 id = 0;
+		float weight = 0.0f;
+		Vector3 position = Vector3::ZERO;
+		SPtr<BenchmarkNode> link;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class BenchmarkNodeRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct BenchmarkDerivedNode : BenchmarkNode
+	{
+		UINT32 flags = 0;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class BenchmarkDerivedNodeRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	struct BenchmarkGraph : IReflectable
+	{
+		Vector<SPtr<BenchmarkNode>> nodes;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class BenchmarkGraphRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class BenchmarkNodeRTTI : public RTTIType<BenchmarkNode, IReflectable, BenchmarkNodeRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(id, 0)
+			BS_RTTI_MEMBER_PLAIN(weight, 1)
+			BS_RTTI_MEMBER_PLAIN(position, 2)
+			BS_RTTI_MEMBER_REFLPTR(link, 3)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		BenchmarkNodeRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "BenchmarkNode";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_BenchmarkNode;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<BenchmarkNode>();
+		}
+	};
+
+	class BenchmarkDerivedNodeRTTI : public RTTIType<BenchmarkDerivedNode, BenchmarkNode, BenchmarkDerivedNodeRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(flags, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		BenchmarkDerivedNodeRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "BenchmarkDerivedNode";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_BenchmarkDerivedNode;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<BenchmarkDerivedNode>();
+		}
+	};
+
+	class BenchmarkGraphRTTI : public RTTIType<BenchmarkGraph, IReflectable, BenchmarkGraphRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_REFLPTR_ARRAY(nodes, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		BenchmarkGraphRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "BenchmarkGraph";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_BenchmarkGraph;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<BenchmarkGraph>();
+		}
+	};
+
+	RTTITypeBase* BenchmarkNode::getRTTIStatic()
+	{
+		return BenchmarkNodeRTTI::instance();
+	}
+
+	RTTITypeBase* BenchmarkNode::getRTTI() const
+	{
+		return BenchmarkNode::getRTTIStatic();
+	}
+
+	RTTITypeBase* BenchmarkDerivedNode::getRTTIStatic()
+	{
+		return BenchmarkDerivedNodeRTTI::instance();
+	}
+
+	RTTITypeBase* BenchmarkDerivedNode::getRTTI() const
+	{
+		return BenchmarkDerivedNode::getRTTIStatic();
+	}
+
+	RTTITypeBase* BenchmarkGraph::getRTTIStatic()
+	{
+		return BenchmarkGraphRTTI::instance();
+	}
+
+	RTTITypeBase* BenchmarkGraph::getRTTI() const
+	{
+		return BenchmarkGraph::getRTTIStatic();
+	}
+
+	SerializationBenchmarkSuite::SerializationBenchmarkSuite()
+	{
+		BS_ADD_TEST(SerializationBenchmarkSuite::benchmarkObjectGraph);
+	}
+
+	void SerializationBenchmarkSuite::startUp()
+	{
+		// Encoding uses stack allocations
+		MemStack::beginThread();
+	}
+
+	void SerializationBenchmarkSuite::shutDown()
+	{
+		MemStack::endThread();
+	}
+
+	void SerializationBenchmarkSuite::benchmarkObjectGraph()
+	{
+		// Every other node is of a derived type. Nodes form a binary tree through their links, so each node is
+		// referenced by the graph and by two other nodes, without any circular references.
+		BenchmarkGraph graph;
+		graph.nodes.resize(NUM_NODES);
+		for (UINT32 i = 0; i < NUM_NODES; i++)
+		{
+			SPtr<BenchmarkNode> node;
+			if ((i % 2) == 0)
+				node = bs_shared_ptr_new<BenchmarkNode>();
+			else
+			{
+				SPtr<BenchmarkDerivedNode> derivedNode = bs_shared_ptr_new<BenchmarkDerivedNode>();
+				derivedNode->flags = i * 3;
+
+				node = derivedNode;
+			}
+
+			node->id = i;
+			node->weight = i * 0.5f;
+			node->position = Vector3((float)i, (float)(i % 100), (float)(i % 7));
+
+			graph.nodes[i] = node;
+		}
+
+		for (UINT32 i = 1; i < NUM_NODES; i++)
+			graph.nodes[i]->link = graph.nodes[(i - 1) / 2];
+
+		MemorySerializer serializer;
+		UINT8* buffer = nullptr;
+		UINT32 bufferSize = 0;
+
+		measure("Encode 100k objects", NUM_RUNS, NUM_NODES, [&]()
+		{
+			buffer = serializer.encode(&graph, bufferSize, (void*(*)(UINT32))&bs_alloc);
+		}, [&]()
+		{
+			if (buffer != nullptr)
+				bs_free(buffer);
+		});
+
+		report("Encoded size", toString(bufferSize) + " bytes");
+
+		SPtr<BenchmarkGraph> output;
+		measure("Decode 100k objects", NUM_RUNS, NUM_NODES, [&]()
+		{
+			output = std::static_pointer_cast<BenchmarkGraph>(serializer.decode(buffer, bufferSize));
+		}, [&]() { output = nullptr; });
+
+		bs_free(buffer);
+
+		bool matches = output != nullptr && output->nodes.size() == NUM_NODES;
+		for (UINT32 i = 0; matches && i < NUM_NODES; i++)
+		{
+			const SPtr<BenchmarkNode>& node = output->nodes[i];
+			SPtr<BenchmarkNode> expectedLink = i > 0 ? output->nodes[(i - 1) / 2] : nullptr;
+
+			matches = node->id == i && node->getTypeId() == graph.nodes[i]->getTypeId() && node->link == expectedLink;
+		}
+
+		BS_TEST_ASSERT_MSG(matches, "Decoded object graph doesn't match the encoded one.");
+	}
+}
@@ -0,0 +1,20 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** Measures binary serialization of a large graph of small reflectable objects. */
+	class BS_UTILITY_EXPORT SerializationBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		SerializationBenchmarkSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void benchmarkObjectGraph();
+	};
+}
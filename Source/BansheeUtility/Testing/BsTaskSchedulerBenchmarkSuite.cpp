@@ -0,0 +1,95 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsTaskSchedulerBenchmarkSuite.h"
+
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+
+#include <atomic>
+
+namespace bs
+{
+	static const UINT32 NUM_ITEMS = 10000;
+	static const UINT32 NUM_RUNS = 10;
+
+	void TaskSchedulerBenchmarkSuite::startUp()
+	{
+		ThreadPool::startUp<TThreadPool<ThreadNoPolicy>>(4, TaskScheduler::MAX_WORKERS + 16);
+		TaskScheduler::startUp();
+	}
+
+	void TaskSchedulerBenchmarkSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	TaskSchedulerBenchmarkSuite::TaskSchedulerBenchmarkSuite()
+	{
+		BS_ADD_TEST(TaskSchedulerBenchmarkSuite::benchmarkTasks);
+		BS_ADD_TEST(TaskSchedulerBenchmarkSuite::benchmarkJobs);
+		BS_ADD_TEST(TaskSchedulerBenchmarkSuite::benchmarkParallelFor);
+	}
+
+	void TaskSchedulerBenchmarkSuite::benchmarkTasks()
+	{
+		std::atomic<UINT32> numExecuted(0);
+		Vector<SPtr<Task>> tasks(NUM_ITEMS);
+
+		measure("Create, queue and wait on trivial tasks", NUM_RUNS, NUM_ITEMS, [&]()
+		{
+			for (UINT32 i = 0; i < NUM_ITEMS; i++)
+			{
+				tasks[i] = Task::create("Benchmark", [&numExecuted]() { numExecuted.fetch_add(1); });
+				TaskScheduler::instance().addTask(tasks[i]);
+			}
+
+			for (auto& task : tasks)
+				task->wait();
+		});
+
+		BS_TEST_ASSERT(numExecuted == NUM_ITEMS * NUM_RUNS);
+	}
+
+	void TaskSchedulerBenchmarkSuite::benchmarkJobs()
+	{
+		std::atomic<UINT32> numExecuted(0);
+
+		measure("Queue and wait on trivial jobs", NUM_RUNS, NUM_ITEMS, [&]()
+		{
+			TaskGroup group;
+			for (UINT32 i = 0; i < NUM_ITEMS; i++)
+				TaskScheduler::instance().addJob([&numExecuted]() { numExecuted.fetch_add(1); }, &group);
+
+			group.wait();
+		});
+
+		BS_TEST_ASSERT(numExecuted == NUM_ITEMS * NUM_RUNS);
+	}
+
+	void TaskSchedulerBenchmarkSuite::benchmarkParallelFor()
+	{
+		const UINT32 NUM_ELEMENTS = 1000000;
+
+		Vector<float> input(NUM_ELEMENTS);
+		Vector<float> output(NUM_ELEMENTS);
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			input[i] = (float)i;
+
+		auto processRange = [&](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				output[i] = std::sqrt(input[i]) * 0.5f + 1.0f;
+		};
+
+		measure("Serial loop", NUM_RUNS, NUM_ELEMENTS, [&]() { processRange(0, NUM_ELEMENTS); });
+		measure("parallelFor, granularity 1024", NUM_RUNS, NUM_ELEMENTS, [&]()
+		{
+			TaskScheduler::instance().parallelFor(0, NUM_ELEMENTS, 1024, processRange);
+		});
+
+		BS_TEST_ASSERT(output[NUM_ELEMENTS - 1] == std::sqrt(input[NUM_ELEMENTS - 1]) * 0.5f + 1.0f);
+
+		report("Workers", toString(TaskScheduler::instance().getNumWorkers()));
+	}
+}
@@ -0,0 +1,22 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** Measures the overhead of scheduling fine-grained work through the TaskScheduler. */
+	class BS_UTILITY_EXPORT TaskSchedulerBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		TaskSchedulerBenchmarkSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void benchmarkTasks();
+		void benchmarkJobs();
+		void benchmarkParallelFor();
+	};
+}
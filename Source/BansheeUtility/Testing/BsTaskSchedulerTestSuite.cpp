@@ -0,0 +1,269 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsTaskSchedulerTestSuite.h"
+
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+
+#include <atomic>
+
+namespace bs
+{
+	void TaskSchedulerTestSuite::startUp()
+	{
+		// Scheduler workers hold on to their pool threads for as long as the scheduler is running
+		ThreadPool::startUp<TThreadPool<ThreadNoPolicy>>(4, TaskScheduler::MAX_WORKERS + 16);
+		TaskScheduler::startUp();
+	}
+
+	void TaskSchedulerTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	TaskSchedulerTestSuite::TaskSchedulerTestSuite()
+	{
+		BS_ADD_TEST(TaskSchedulerTestSuite::testTask);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testTask_dependency);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testJob);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testJob_nested);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testWait_onlyWaitedWork);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testTask_priorityFromWorker);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelFor);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelFor_small_range);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelFor_empty_range);
+	}
+
+	void TaskSchedulerTestSuite::testTask()
+	{
+		const UINT32 NUM_TASKS = 100;
+
+		std::atomic<UINT32> counter(0);
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 i = 0; i < NUM_TASKS; i++)
+		{
+			SPtr<Task> task = Task::create("Test", [&counter]() { counter.fetch_add(1); });
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+
+		BS_TEST_ASSERT(counter.load() == NUM_TASKS);
+
+		for (auto& task : tasks)
+			BS_TEST_ASSERT(task->isComplete());
+	}
+
+	void TaskSchedulerTestSuite::testTask_dependency()
+	{
+		std::atomic<UINT32> order(0);
+		UINT32 firstOrder = 0;
+		UINT32 secondOrder = 0;
+
+		SPtr<Task> first = Task::create("First", [&]()
+		{
+			BS_THREAD_SLEEP(10);
+			firstOrder = order.fetch_add(1) + 1;
+		});
+
+		SPtr<Task> second = Task::create("Second", [&]()
+		{
+			secondOrder = order.fetch_add(1) + 1;
+		}, TaskPriority::Normal, first);
+
+		// Queue the dependant first, so it's picked up first if the dependency is ignored
+		TaskScheduler::instance().addTask(second);
+		TaskScheduler::instance().addTask(first);
+
+		second->wait();
+
+		BS_TEST_ASSERT(first->isComplete());
+		BS_TEST_ASSERT(firstOrder == 1);
+		BS_TEST_ASSERT(secondOrder == 2);
+	}
+
+	void TaskSchedulerTestSuite::testJob()
+	{
+		const UINT32 NUM_JOBS = 10000;
+
+		std::atomic<UINT32> counter(0);
+		TaskGroup group;
+		for (UINT32 i = 0; i < NUM_JOBS; i++)
+			TaskScheduler::instance().addJob([&counter]() { counter.fetch_add(1); }, &group);
+
+		group.wait();
+
+		BS_TEST_ASSERT(group.isComplete());
+		BS_TEST_ASSERT(group.getNumPending() == 0);
+		BS_TEST_ASSERT(counter.load() == NUM_JOBS);
+	}
+
+	void TaskSchedulerTestSuite::testJob_nested()
+	{
+		const UINT32 NUM_OUTER_JOBS = 64;
+		const UINT32 NUM_INNER_JOBS = 64;
+
+		// Jobs queued from worker threads go to the worker's own queue, and are stolen by the other workers
+		std::atomic<UINT32> counter(0);
+		TaskGroup group;
+		for (UINT32 i = 0; i < NUM_OUTER_JOBS; i++)
+		{
+			TaskScheduler::instance().addJob([&]()
+			{
+				for (UINT32 j = 0; j < NUM_INNER_JOBS; j++)
+					TaskScheduler::instance().addJob([&counter]() { counter.fetch_add(1); }, &group);
+			}, &group);
+		}
+
+		group.wait();
+
+		BS_TEST_ASSERT(counter.load() == NUM_OUTER_JOBS * NUM_INNER_JOBS);
+	}
+
+	void TaskSchedulerTestSuite::testWait_onlyWaitedWork()
+	{
+		TaskScheduler& scheduler = TaskScheduler::instance();
+
+		// Park all workers, so queued work only runs if the waiting thread picks it up
+		UINT32 numWorkers = scheduler.getNumWorkers();
+		for (UINT32 i = 0; i < numWorkers; i++)
+			scheduler.removeWorker();
+
+		BS_THREAD_SLEEP(10);
+
+		std::atomic<bool> otherJobRan(false);
+		std::atomic<bool> otherTaskRan(false);
+
+		TaskGroup otherGroup;
+		scheduler.addJob([&otherJobRan]() { otherJobRan = true; }, &otherGroup);
+
+		SPtr<Task> otherTask = Task::create("Other", [&otherTaskRan]() { otherTaskRan = true; });
+		scheduler.addTask(otherTask);
+
+		bool jobRan = false;
+		TaskGroup group;
+		scheduler.addJob([&jobRan]() { jobRan = true; }, &group);
+		group.wait();
+
+		// Dependency is queued behind the other work, and must be run by the waiting thread as well
+		bool dependencyRan = false;
+		bool taskRan = false;
+		SPtr<Task> dependency = Task::create("Dependency", [&dependencyRan]() { dependencyRan = true; });
+		SPtr<Task> task = Task::create("Task", [&]() { taskRan = dependencyRan; }, TaskPriority::Normal, dependency);
+
+		scheduler.addTask(task);
+		scheduler.addTask(dependency);
+		task->wait();
+
+		BS_TEST_ASSERT(jobRan);
+		BS_TEST_ASSERT(taskRan);
+		BS_TEST_ASSERT(!otherJobRan.load());
+		BS_TEST_ASSERT(!otherTaskRan.load());
+
+		for (UINT32 i = 0; i < numWorkers; i++)
+			scheduler.addWorker();
+
+		otherGroup.wait();
+		otherTask->wait();
+
+		BS_TEST_ASSERT(otherJobRan.load());
+		BS_TEST_ASSERT(otherTaskRan.load());
+	}
+
+	void TaskSchedulerTestSuite::testTask_priorityFromWorker()
+	{
+		TaskScheduler& scheduler = TaskScheduler::instance();
+
+		// Leave a single worker, so the queued tasks run one after another
+		UINT32 numWorkers = scheduler.getNumWorkers();
+		for (UINT32 i = 1; i < numWorkers; i++)
+			scheduler.removeWorker();
+
+		BS_THREAD_SLEEP(10);
+
+		Vector<UINT32> order;
+		TaskPriority priorities[] = { TaskPriority::High, TaskPriority::Normal, TaskPriority::Low };
+
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 i = 0; i < 3; i++)
+			tasks.push_back(Task::create("Test", [&order, i]() { order.push_back(i); }, priorities[i]));
+
+		// Queue in reverse of the expected order of execution, since a worker runs its own jobs last-in first-out
+		TaskGroup group;
+		scheduler.addJob([&]()
+		{
+			for (auto& task : tasks)
+				scheduler.addTask(task);
+		}, &group);
+
+		// Don't wait on the tasks, as that would run them on this thread
+		bool allComplete = false;
+		while (!allComplete)
+		{
+			BS_THREAD_SLEEP(1);
+
+			allComplete = group.isComplete();
+			for (auto& task : tasks)
+				allComplete &= task->isComplete();
+		}
+
+		for (UINT32 i = 1; i < numWorkers; i++)
+			scheduler.addWorker();
+
+		BS_TEST_ASSERT(order.size() == 3);
+		for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+			BS_TEST_ASSERT(order[i] == i);
+	}
+
+	void TaskSchedulerTestSuite::testParallelFor()
+	{
+		const UINT32 BEGIN = 7;
+		const UINT32 END = 100000;
+
+		// Every index must be processed exactly once, so no synchronization is needed for the counts
+		Vector<UINT32> counts(END, 0);
+		TaskScheduler::instance().parallelFor(BEGIN, END, 16, [&counts](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			for (UINT32 i = chunkBegin; i < chunkEnd; i++)
+				counts[i]++;
+		});
+
+		bool allValid = true;
+		for (UINT32 i = 0; i < END; i++)
+		{
+			UINT32 expected = i >= BEGIN ? 1 : 0;
+			if (counts[i] != expected)
+				allValid = false;
+		}
+
+		BS_TEST_ASSERT(allValid);
+	}
+
+	void TaskSchedulerTestSuite::testParallelFor_small_range()
+	{
+		// Range smaller than the granularity is processed as a single chunk on the calling thread
+		UINT32 numChunks = 0;
+		UINT32 numProcessed = 0;
+		TaskScheduler::instance().parallelFor(0, 10, 64, [&](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			numChunks++;
+			numProcessed += chunkEnd - chunkBegin;
+		});
+
+		BS_TEST_ASSERT(numChunks == 1);
+		BS_TEST_ASSERT(numProcessed == 10);
+	}
+
+	void TaskSchedulerTestSuite::testParallelFor_empty_range()
+	{
+		bool called = false;
+		TaskScheduler::instance().parallelFor(5, 5, 1, [&called](UINT32 chunkBegin, UINT32 chunkEnd) { called = true; });
+		TaskScheduler::instance().parallelFor(5, 2, 1, [&called](UINT32 chunkBegin, UINT32 chunkEnd) { called = true; });
+
+		BS_TEST_ASSERT(!called);
+	}
+}
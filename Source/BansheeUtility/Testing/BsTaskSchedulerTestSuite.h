@@ -0,0 +1,27 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT TaskSchedulerTestSuite : public TestSuite
+	{
+	public:
+		TaskSchedulerTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testTask();
+		void testTask_dependency();
+		void testJob();
+		void testJob_nested();
+		void testWait_onlyWaitedWork();
+		void testTask_priorityFromWorker();
+		void testParallelFor();
+		void testParallelFor_small_range();
+		void testParallelFor_empty_range();
+	};
+}
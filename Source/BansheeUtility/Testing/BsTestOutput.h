@@ -25,6 +25,15 @@ namespace bs
 		 * @param[in]	line		Line of code the unit test failed on.
 		 */
 		virtual void outputFail(const String& desc, const String& function, const String& file, long line) = 0;
+
+		/**
+		 * Triggered when a test reports a measured value, such as a benchmark timing. Ignored by default.
+		 *
+		 * @param[in]	name		Name of the measured value.
+		 * @param[in]	value		Measured value, formatted for display.
+		 * @param[in]	function	Name of the function the value was measured in.
+		 */
+		virtual void outputResult(const String& name, const String& value, const String& function) { }
 	};
 
 	/** Outputs unit test results so that failures are reported as exceptions. Success is not reported. */
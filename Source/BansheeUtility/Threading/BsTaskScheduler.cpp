@@ -5,9 +5,18 @@
 
 namespace bs
 {
-	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+	/** Index of the worker the current thread is running, if any. */
+	static BS_THREADLOCAL UINT32 sCurrentWorkerIdx = (UINT32)-1;
+
+	/** Number of times an idle worker checks for new jobs before going to sleep. */
+	static const UINT32 MAX_IDLE_SPINS = 64;
+
+	/** Initial number of entries in the shared job queue. Must be a power of two. */
+	static const UINT32 INITIAL_SHARED_QUEUE_SIZE = 256;
+
+	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
-		:mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mTaskDependency(dependency),
+		:mName(name), mPriority(priority), mTaskWorker(taskWorker), mTaskDependency(dependency), mState(0),
 		mParent(nullptr)
 	{
 
@@ -39,154 +48,584 @@ namespace bs
 		mState.store(3);
 	}
 
+	TaskGroup::TaskGroup()
+		:mNumPending(0)
+	{ }
+
+	void TaskGroup::wait()
+	{
+		TaskScheduler::instance().waitUntilComplete(*this);
+	}
+
+	TaskScheduler::WorkStealingQueue::WorkStealingQueue()
+		:mTop(0), mBottom(0)
+	{ }
+
+	bool TaskScheduler::WorkStealingQueue::push(Job* job)
+	{
+		INT64 bottom = mBottom.load(std::memory_order_relaxed);
+		INT64 top = mTop.load(std::memory_order_acquire);
+
+		if (bottom - top >= (INT64)CAPACITY)
+			return false;
+
+		mJobs[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+		mBottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	TaskScheduler::Job* TaskScheduler::WorkStealingQueue::pop()
+	{
+		INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		mBottom.store(bottom, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 top = mTop.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			// Empty
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = mJobs[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (top == bottom)
+		{
+			// Last element, race against thieves for it
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				job = nullptr;
+
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	TaskScheduler::Job* TaskScheduler::WorkStealingQueue::steal()
+	{
+		INT64 top = mTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		Job* job = mJobs[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr; // Lost the race to the owner or another thief
+
+		return job;
+	}
+
 	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare), mMaxActiveTasks(0), mNextTaskId(0), mShutdown(false)
+		: mNumSpawnedWorkers(0), mNumActiveWorkers(BS_THREAD_HARDWARE_CONCURRENCY), mNumSleepingWorkers(0)
+		, mShutdown(false), mJobPool(nullptr), mFreeJobHead(0), mNumQueuedJobs(0), mNumPendingJobs(0)
+		, mSharedQueue(INITIAL_SHARED_QUEUE_SIZE, nullptr), mSharedQueueStart(0), mSharedQueueSize(0)
+		, mNumHighPriorityJobs(0), mNumCompletionWaiters(0)
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		for (UINT32 i = 0; i < MAX_WORKERS; i++)
+			mWorkers[i] = nullptr;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		mJobPool = bs_newN<Job>(JOB_POOL_SIZE);
+		for (UINT32 i = 0; i < JOB_POOL_SIZE; i++)
+			mJobPool[i].nextFree.store((i + 1) < JOB_POOL_SIZE ? (i + 1) : INVALID_INDEX, std::memory_order_relaxed);
 	}
 
 	TaskScheduler::~TaskScheduler()
 	{
-		// Wait until all tasks complete
+		// Wait until all queued jobs and tasks complete
+		while (mNumPendingJobs.load() > 0)
 		{
-			Lock activeTaskLock(mReadyMutex);
-
-			while (mActiveTasks.size() > 0)
+			Job* job = findJob(getCurrentWorkerIdx());
+			if (job != nullptr)
 			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
-
-				task->wait();
-				activeTaskLock.lock();
+				executeJob(job);
+				continue;
 			}
+
+			Lock lock(mCompleteMutex);
+			mNumCompletionWaiters++;
+
+			while (mNumPendingJobs.load() > 0)
+				mTaskCompleteCond.wait(lock);
+
+			mNumCompletionWaiters--;
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		// Shut down the workers and wait until they exit
+		UINT32 numWorkers = mNumSpawnedWorkers.load();
 		{
-			Lock lock(mReadyMutex);
-
+			Lock lock(mWorkerMutex);
 			mShutdown = true;
+
+			for (UINT32 i = 0; i < numWorkers; i++)
+				mWorkers[i]->wakeCond.notify_one();
 		}
 
-		mTaskReadyCond.notify_one();
+		// Other workers might still be looking through this worker's queue, so only delete them once all have exited
+		for (UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread.blockUntilComplete();
+
+		for (UINT32 i = 0; i < numWorkers; i++)
+			bs_delete(mWorkers[i]);
 
-		mTaskSchedulerThread.blockUntilComplete();
+		bs_deleteN(mJobPool, JOB_POOL_SIZE);
 	}
 
 	void TaskScheduler::addTask(const SPtr<Task>& task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mTaskQueue.insert(task);
+		// If the dependency is still in progress, the task will get queued once the dependency completes
+		const SPtr<Task>& dependency = task->mTaskDependency;
+		if (dependency != nullptr)
+		{
+			Lock lock(mCompleteMutex);
+
+			if (!dependency->isComplete() && !dependency->isCanceled())
+			{
+				dependency->mDependants.push_back(task);
+				return;
+			}
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		queueTask(task);
+	}
+
+	void TaskScheduler::queueTask(const SPtr<Task>& task)
+	{
+		SPtr<Task> taskCopy = task;
+
+		Job* job = createJob([this, taskCopy]() { runTask(taskCopy); }, nullptr);
+		job->task = task.get();
+
+		queueJob(job, task->mPriority);
+		wakeWorkers(1);
+	}
+
+	void TaskScheduler::runTask(const SPtr<Task>& task)
+	{
+		UINT32 inactiveState = 0;
+		if (task->mState.compare_exchange_strong(inactiveState, 1))
+			task->mTaskWorker();
+
+		Vector<SPtr<Task>> dependants;
+		{
+			Lock lock(mCompleteMutex);
+
+			if (task->mState.load() == 1)
+				task->mState.store(2);
+
+			std::swap(dependants, task->mDependants);
+			mTaskCompleteCond.notify_all();
+		}
+
+		for (auto& dependant : dependants)
+			queueTask(dependant);
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
+		{
+			Lock lock(mWorkerMutex);
 
-		mMaxActiveTasks++;
+			// If the worker at this index was parked, wake it up
+			UINT32 workerIdx = mNumActiveWorkers.fetch_add(1);
+			if (workerIdx < mNumSpawnedWorkers.load())
+				mWorkers[workerIdx]->wakeCond.notify_one();
+		}
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		// A spot freed up, start processing queued jobs if they exist
+		UINT32 numQueued = mNumQueuedJobs.load();
+		if (numQueued > 0)
+			wakeWorkers(numQueued);
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
+		Lock lock(mWorkerMutex);
 
-		if(mMaxActiveTasks > 0)
-			mMaxActiveTasks--;
+		UINT32 numActive = mNumActiveWorkers.load();
+		if (numActive > 0)
+			mNumActiveWorkers.store(numActive - 1);
 	}
 
-	void TaskScheduler::runMain()
+	TaskScheduler::Job* TaskScheduler::allocJob()
 	{
-		while(true)
+		UINT64 head = mFreeJobHead.load(std::memory_order_acquire);
+		while (true)
 		{
-			Lock lock(mReadyMutex);
+			UINT32 jobIdx = (UINT32)(head & 0xFFFFFFFF);
+			if (jobIdx == INVALID_INDEX)
+			{
+				// Pool exhausted, fall back to the heap
+				Job* job = bs_new<Job>();
+				job->heapAllocated = true;
 
-			while((mTaskQueue.size() == 0 || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
+				return job;
+			}
 
-			if(mShutdown)
-				break;
+			UINT64 tag = (head >> 32) + 1;
+			UINT32 nextIdx = mJobPool[jobIdx].nextFree.load(std::memory_order_relaxed);
+
+			UINT64 newHead = (tag << 32) | nextIdx;
+			if (mFreeJobHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+				return &mJobPool[jobIdx];
+		}
+	}
 
-			for(UINT32 i = 0; (i < mTaskQueue.size()) && ((UINT32)mActiveTasks.size() < mMaxActiveTasks); i++)
+	void TaskScheduler::freeJob(Job* job)
+	{
+		job->destroy(job);
+
+		if (job->heapAllocated)
+		{
+			bs_delete(job);
+			return;
+		}
+
+		UINT32 jobIdx = (UINT32)(job - mJobPool);
+		UINT64 head = mFreeJobHead.load(std::memory_order_relaxed);
+		UINT64 newHead;
+		do
+		{
+			job->nextFree.store((UINT32)(head & 0xFFFFFFFF), std::memory_order_relaxed);
+
+			UINT64 tag = (head >> 32) + 1;
+			newHead = (tag << 32) | jobIdx;
+		} while (!mFreeJobHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void TaskScheduler::queueJob(Job* job, TaskPriority priority)
+	{
+		// Worker queues are unordered with respect to each other, only the shared queue can honour priorities
+		UINT32 workerIdx = getCurrentWorkerIdx();
+		if (workerIdx == INVALID_INDEX || priority != TaskPriority::Normal || !mWorkers[workerIdx]->queue.push(job))
+		{
+			ScopedSpinLock lock(mSharedQueueLock);
+
+			UINT32 size = mSharedQueueSize.load(std::memory_order_relaxed);
+			UINT32 capacity = (UINT32)mSharedQueue.size();
+			if (size == capacity)
 			{
-				SPtr<Task> curTask = *mTaskQueue.begin();
-				mTaskQueue.erase(mTaskQueue.begin());
+				Vector<Job*> newQueue(capacity * 2, nullptr);
+				for (UINT32 i = 0; i < size; i++)
+					newQueue[i] = mSharedQueue[(mSharedQueueStart + i) & (capacity - 1)];
 
-				if(curTask->isCanceled())
-					continue;
+				mSharedQueue = std::move(newQueue);
+				mSharedQueueStart = 0;
+				capacity *= 2;
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-					continue;
+			if (priority > TaskPriority::Normal)
+			{
+				mSharedQueueStart = (mSharedQueueStart + capacity - 1) & (capacity - 1);
+				mSharedQueue[mSharedQueueStart] = job;
+
+				mNumHighPriorityJobs.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+				mSharedQueue[(mSharedQueueStart + size) & (capacity - 1)] = job;
+
+			mSharedQueueSize.store(size + 1, std::memory_order_relaxed);
+		}
+
+		mNumQueuedJobs.fetch_add(1);
+	}
+
+	void TaskScheduler::wakeWorkers(UINT32 numJobs)
+	{
+		UINT32 numActive = mNumActiveWorkers.load();
+		if (mNumSleepingWorkers.load() == 0 && mNumSpawnedWorkers.load() >= std::min(numActive, (UINT32)MAX_WORKERS))
+			return;
+
+		Lock lock(mWorkerMutex);
+
+		numActive = std::min(mNumActiveWorkers.load(), (UINT32)MAX_WORKERS);
+		UINT32 numSpawned = mNumSpawnedWorkers.load();
+		UINT32 numToWake = numJobs;
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+		for (UINT32 i = 0; i < numSpawned && i < numActive && numToWake > 0; i++)
+		{
+			Worker* worker = mWorkers[i];
+			if (!worker->sleeping)
+				continue;
+
+			worker->sleeping = false;
+			worker->wakeCond.notify_one();
+			numToWake--;
+		}
+
+		// Not enough sleeping workers, start new ones if we're under the limit
+		while (numToWake > 0 && numSpawned < numActive)
+		{
+			Worker* worker = bs_new<Worker>();
+			mWorkers[numSpawned] = worker;
+			mNumSpawnedWorkers.store(numSpawned + 1, std::memory_order_release);
+
+			worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, numSpawned));
+
+			numSpawned++;
+			numToWake--;
+		}
+	}
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+	TaskScheduler::Job* TaskScheduler::findJob(UINT32 workerIdx)
+	{
+		Job* job = nullptr;
+
+		// High priority jobs in the shared queue go before the worker's own jobs
+		if (mNumHighPriorityJobs.load(std::memory_order_relaxed) > 0)
+			job = popSharedJob();
+
+		// Own queue
+		if (job == nullptr && workerIdx != INVALID_INDEX)
+			job = mWorkers[workerIdx]->queue.pop();
+
+		// Shared queue
+		if (job == nullptr && mSharedQueueSize.load(std::memory_order_relaxed) > 0)
+			job = popSharedJob();
+
+		// Steal from other workers, starting with the one after us so thieves spread out
+		if (job == nullptr)
+		{
+			UINT32 numWorkers = mNumSpawnedWorkers.load(std::memory_order_acquire);
+			UINT32 offset = workerIdx != INVALID_INDEX ? workerIdx + 1 : 0;
+
+			for (UINT32 i = 0; i < numWorkers && job == nullptr; i++)
+			{
+				UINT32 victimIdx = (offset + i) % numWorkers;
+				if (victimIdx == workerIdx)
+					continue;
+
+				job = mWorkers[victimIdx]->queue.steal();
 			}
 		}
+
+		if (job != nullptr)
+			mNumQueuedJobs.fetch_sub(1);
+
+		return job;
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	TaskScheduler::Job* TaskScheduler::findWaitedJob(UINT32 workerIdx, const TaskGroup* group, const Task* task)
 	{
-		task->mTaskWorker();
+		auto isWaitedOn = [group, task](const Job* job)
+		{
+			if (group != nullptr && job->group == group)
+				return true;
+
+			// The task can't run before its dependencies, so those are waited on as well
+			for (const Task* entry = task; entry != nullptr; entry = entry->mTaskDependency.get())
+			{
+				if (job->task == entry)
+					return true;
+			}
+
+			return false;
+		};
 
+		// Only the bottom of the own queue can be checked, return the job if it's not the one being waited on
+		if (workerIdx != INVALID_INDEX)
 		{
-			Lock lock(mReadyMutex);
+			WorkStealingQueue& queue = mWorkers[workerIdx]->queue;
+
+			Job* job = queue.pop();
+			if (job != nullptr)
+			{
+				if (isWaitedOn(job))
+				{
+					mNumQueuedJobs.fetch_sub(1);
+					return job;
+				}
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+				queue.push(job);
+			}
 		}
 
+		if (mSharedQueueSize.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		ScopedSpinLock lock(mSharedQueueLock);
+
+		UINT32 size = mSharedQueueSize.load(std::memory_order_relaxed);
+		UINT32 mask = (UINT32)mSharedQueue.size() - 1;
+		for (UINT32 i = 0; i < size; i++)
 		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			Job* job = mSharedQueue[(mSharedQueueStart + i) & mask];
+			if (!isWaitedOn(job))
+				continue;
 
-			mTaskCompleteCond.notify_all();
+			// Close the gap by moving the jobs in front of it back by one, keeping their order
+			for (UINT32 j = i; j > 0; j--)
+				mSharedQueue[(mSharedQueueStart + j) & mask] = mSharedQueue[(mSharedQueueStart + j - 1) & mask];
+
+			mSharedQueueStart = (mSharedQueueStart + 1) & mask;
+			mSharedQueueSize.store(size - 1, std::memory_order_relaxed);
+
+			if (i < mNumHighPriorityJobs.load(std::memory_order_relaxed))
+				mNumHighPriorityJobs.fetch_sub(1, std::memory_order_relaxed);
+
+			mNumQueuedJobs.fetch_sub(1);
+			return job;
 		}
 
-		// Possibly this task was someones dependency, so wake the main scheduler thread
-		mTaskReadyCond.notify_one();
+		return nullptr;
 	}
 
-	void TaskScheduler::waitUntilComplete(const Task* task)
+	TaskScheduler::Job* TaskScheduler::popSharedJob()
 	{
-		if(task->isCanceled())
-			return;
+		ScopedSpinLock lock(mSharedQueueLock);
+
+		UINT32 size = mSharedQueueSize.load(std::memory_order_relaxed);
+		if (size == 0)
+			return nullptr;
 
+		UINT32 capacity = (UINT32)mSharedQueue.size();
+
+		Job* job = mSharedQueue[mSharedQueueStart];
+		mSharedQueueStart = (mSharedQueueStart + 1) & (capacity - 1);
+		mSharedQueueSize.store(size - 1, std::memory_order_relaxed);
+
+		if (mNumHighPriorityJobs.load(std::memory_order_relaxed) > 0)
+			mNumHighPriorityJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	void TaskScheduler::executeJob(Job* job)
+	{
+		job->execute(job);
+
+		TaskGroup* group = job->group;
+		freeJob(job);
+
+		bool notify = false;
+		if (group != nullptr && group->mNumPending.fetch_sub(1) == 1)
+			notify = true;
+
+		if (mNumPendingJobs.fetch_sub(1) == 1)
+			notify = true;
+
+		if (notify && mNumCompletionWaiters.load() > 0)
 		{
 			Lock lock(mCompleteMutex);
-			
-			while(!task->isComplete())
+			mTaskCompleteCond.notify_all();
+		}
+	}
+
+	void TaskScheduler::runWorker(UINT32 workerIdx)
+	{
+		sCurrentWorkerIdx = workerIdx;
+		Worker* worker = mWorkers[workerIdx];
+
+		UINT32 numIdleSpins = 0;
+		while (true)
+		{
+			if (workerIdx < mNumActiveWorkers.load(std::memory_order_relaxed))
 			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
-				removeWorker();
+				Job* job = findJob(workerIdx);
+				if (job != nullptr)
+				{
+					executeJob(job);
+					numIdleSpins = 0;
+					continue;
+				}
+
+				if (numIdleSpins < MAX_IDLE_SPINS)
+				{
+					numIdleSpins++;
+					std::this_thread::yield();
+					continue;
+				}
+			}
+
+			// Nothing to do, or worker was removed, sleep until woken up
+			numIdleSpins = 0;
+
+			Lock lock(mWorkerMutex);
+			worker->sleeping = true;
+			mNumSleepingWorkers.fetch_add(1);
+
+			while (!mShutdown &&
+				(workerIdx >= mNumActiveWorkers.load() || (worker->sleeping && mNumQueuedJobs.load() == 0)))
+			{
+				worker->wakeCond.wait(lock);
+			}
+
+			worker->sleeping = false;
+			mNumSleepingWorkers.fetch_sub(1);
+
+			if (mShutdown)
+				break;
+		}
+
+		sCurrentWorkerIdx = INVALID_INDEX;
+	}
+
+	void TaskScheduler::waitUntilComplete(TaskGroup& group)
+	{
+		UINT32 workerIdx = getCurrentWorkerIdx();
+		while (!group.isComplete())
+		{
+			// Help out with queued jobs from the group while waiting
+			Job* job = findWaitedJob(workerIdx, &group, nullptr);
+			if (job != nullptr)
+			{
+				executeJob(job);
+				continue;
+			}
+
+			// Remaining jobs are executing on other threads, block and lend this core to another worker
+			addWorker();
+			{
+				Lock lock(mCompleteMutex);
+				mNumCompletionWaiters++;
+
+				while (!group.isComplete())
+					mTaskCompleteCond.wait(lock);
+
+				mNumCompletionWaiters--;
 			}
+			removeWorker();
 		}
 	}
 
-	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
+	void TaskScheduler::waitUntilComplete(const Task* task)
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
+		UINT32 workerIdx = getCurrentWorkerIdx();
+		while (!task->isComplete() && !task->isCanceled())
+		{
+			// Run the task, or its dependencies, if they're still queued
+			Job* job = findWaitedJob(workerIdx, nullptr, task);
+			if (job != nullptr)
+			{
+				executeJob(job);
+				continue;
+			}
+
+			// Task is executing on another thread (or waiting on its dependency), block and lend this core to another worker
+			addWorker();
+			{
+				Lock lock(mCompleteMutex);
+				mNumCompletionWaiters++;
 
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		return lhs->mTaskId < rhs->mTaskId;
+				while (!task->isComplete() && !task->isCanceled())
+					mTaskCompleteCond.wait(lock);
+
+				mNumCompletionWaiters--;
+			}
+			removeWorker();
+		}
+	}
+
+	UINT32 TaskScheduler::getCurrentWorkerIdx()
+	{
+		return sCurrentWorkerIdx;
 	}
-}
\ No newline at end of file
+}
@@ -25,7 +25,7 @@ namespace bs
 
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
-	 * 			
+	 *
 	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT Task
@@ -33,7 +33,7 @@ namespace bs
 		struct PrivatelyConstruct {};
 
 	public:
-		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 			TaskPriority priority, SPtr<Task> dependency);
 
 		/**
@@ -45,7 +45,7 @@ namespace bs
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
 		 * 							not be executed until its dependency is complete.
 		 */
-		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal, 
+		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal,
 			SPtr<Task> dependency = nullptr);
 
 		/** Returns true if the task has completed. */
@@ -55,9 +55,12 @@ namespace bs
 		bool isCanceled() const;
 
 		/**
-		 * Blocks the current thread until the task has completed. 
-		 * 
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * Blocks the current thread until the task has completed.
+		 *
+		 * @note
+		 * While waiting the calling thread will execute the task, or any of its dependencies, if they are still queued.
+		 * Other queued work is left to the worker threads, so the caller never ends up running unrelated tasks while
+		 * holding its locks.
 		 */
 		void wait();
 
@@ -69,30 +72,151 @@ namespace bs
 
 		String mName;
 		TaskPriority mPriority;
-		UINT32 mTaskId;
 		std::function<void()> mTaskWorker;
 		SPtr<Task> mTaskDependency;
+		Vector<SPtr<Task>> mDependants;
 		std::atomic<UINT32> mState; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent;
 	};
 
+	/**
+	 * Keeps track of a group of jobs queued in the TaskScheduler, allowing the caller to check or wait until all of them
+	 * complete. Group must outlive all of the jobs queued with it.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT TaskGroup
+	{
+	public:
+		TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		/** Returns true if all the jobs in the group have finished executing. */
+		bool isComplete() const { return mNumPending.load(std::memory_order_acquire) == 0; }
+
+		/** Returns the number of jobs in the group that have been queued but haven't finished executing yet. */
+		UINT32 getNumPending() const { return mNumPending.load(std::memory_order_acquire); }
+
+		/**
+		 * Blocks the current thread until all jobs in the group complete. While waiting the calling thread will help
+		 * execute queued jobs from the group.
+		 */
+		void wait();
+
+	private:
+		friend class TaskScheduler;
+
+		std::atomic<UINT32> mNumPending;
+	};
+
 	/**
 	 * Represents a task scheduler running on multiple threads. You may queue tasks on it from any thread and they will be
 	 * executed in user specified order on any available thread.
-	 * 			
-	 * @note	
+	 *
+	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks 
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially 
-	 * at the cost of flexibility.)
+	 * Each worker thread owns a lock-free work-stealing queue. Jobs of normal priority queued from a worker are pushed
+	 * onto its own queue, while other jobs go into a shared queue protected by a spin lock. Idle workers steal from
+	 * other workers' queues. This makes the scheduler suitable for fine grained jobs (in the order of hundreds or
+	 * thousands per frame) queued through addJob() or parallelFor(). Task objects are still supported but are heavier
+	 * as they require a heap allocation each, and should be used for long running or coarse grained work.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will use as many worker threads as there are logical CPU cores. You may add or remove
+	 * threads using addWorker()/removeWorker() methods. Worker threads are retrieved from the ThreadPool as they are
+	 * first needed, and are kept until the scheduler is destroyed. The pool must therefore be able to hold up to
+	 * MAX_WORKERS threads in addition to any other threads it runs.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
+		/** Single unit of work queued on the scheduler. Stores the job callable inline if it is small enough. */
+		struct Job
+		{
+			static const UINT32 INLINE_STORAGE_SIZE = 64;
+
+			void(*execute)(Job*) = nullptr;
+			void(*destroy)(Job*) = nullptr;
+			TaskGroup* group = nullptr;
+			const Task* task = nullptr; /**< Task run by the job, if any. Only used for identifying the job. */
+			std::atomic<UINT32> nextFree;
+			bool heapAllocated = false;
+
+			std::aligned_storage<INLINE_STORAGE_SIZE>::type storage;
+		};
+
+		/** Helper that constructs, executes and destroys job callables of a specific type stored in Job::storage. */
+		template<class F, bool INLINE = (sizeof(F) <= Job::INLINE_STORAGE_SIZE) &&
+			(alignof(F) <= alignof(std::aligned_storage<Job::INLINE_STORAGE_SIZE>::type))>
+		struct JobCallable
+		{
+			template<class T>
+			static void create(Job* job, T&& func)
+			{
+				new (&job->storage) F(std::forward<T>(func));
+
+				job->execute = &JobCallable::execute;
+				job->destroy = &JobCallable::destroy;
+			}
+
+			static void execute(Job* job) { (*(F*)&job->storage)(); }
+			static void destroy(Job* job) { ((F*)&job->storage)->~F(); }
+		};
+
+		/** Specialization of JobCallable for callables too large to be stored inline. */
+		template<class F>
+		struct JobCallable<F, false>
+		{
+			template<class T>
+			static void create(Job* job, T&& func)
+			{
+				*(F**)&job->storage = bs_new<F>(std::forward<T>(func));
+
+				job->execute = &JobCallable::execute;
+				job->destroy = &JobCallable::destroy;
+			}
+
+			static void execute(Job* job) { (**(F**)&job->storage)(); }
+			static void destroy(Job* job) { bs_delete(*(F**)&job->storage); }
+		};
+
+		/**
+		 * Fixed size double ended queue of jobs. The owner thread pushes and pops jobs from the bottom of the queue, while
+		 * any other thread may steal jobs from the top of the queue. None of the operations lock.
+		 */
+		class WorkStealingQueue
+		{
+		public:
+			static const UINT32 CAPACITY = 1024;
+
+			WorkStealingQueue();
+
+			/** Pushes a job to the bottom of the queue. Returns false if the queue is full. Owner thread only. */
+			bool push(Job* job);
+
+			/** Pops a job from the bottom of the queue. Returns null if the queue is empty. Owner thread only. */
+			Job* pop();
+
+			/** Removes a job from the top of the queue. Returns null if the queue is empty. Callable from any thread. */
+			Job* steal();
+
+		private:
+			std::atomic<INT64> mTop;
+			std::atomic<INT64> mBottom;
+			std::atomic<Job*> mJobs[CAPACITY];
+		};
+
+		/** Information about a single worker thread. */
+		struct Worker
+		{
+			WorkStealingQueue queue;
+			HThread thread;
+			Signal wakeCond;
+			bool sleeping = false;
+		};
+
 	public:
 		TaskScheduler();
 		~TaskScheduler();
@@ -100,6 +224,75 @@ namespace bs
 		/** Queues a new task. */
 		void addTask(const SPtr<Task>& task);
 
+		/**
+		 * Queues a new job. Unlike tasks, jobs don't allocate any memory as long as the callable is small enough (e.g. a
+		 * lambda capturing a few pointers), which makes them suitable for very fine grained work.
+		 *
+		 * @param[in]	func		Callable with signature void() to execute.
+		 * @param[in]	group		(optional) Group to add the job to. Can be used for waiting until the job completes.
+		 * @param[in]	priority	(optional) Jobs with priority above normal are executed before any other queued jobs.
+		 *							Jobs with priority below normal are executed after jobs queued by worker threads.
+		 */
+		template<class F>
+		void addJob(F&& func, TaskGroup* group = nullptr, TaskPriority priority = TaskPriority::Normal)
+		{
+			queueJob(createJob(std::forward<F>(func), group), priority);
+			wakeWorkers(1);
+		}
+
+		/**
+		 * Splits the provided range into chunks and executes them in parallel on the worker threads. The calling thread
+		 * participates in the work and the method returns once the entire range has been processed.
+		 *
+		 * @param[in]	begin		First index of the range.
+		 * @param[in]	end			One past the last index of the range.
+		 * @param[in]	granularity	Minimum number of indices processed by a single job.
+		 * @param[in]	body		Callable with signature void(UINT32 chunkBegin, UINT32 chunkEnd) that processes
+		 *							indices in range [chunkBegin, chunkEnd).
+		 */
+		template<class F>
+		void parallelFor(UINT32 begin, UINT32 end, UINT32 granularity, const F& body)
+		{
+			if (end <= begin)
+				return;
+
+			UINT32 count = end - begin;
+			UINT32 maxChunks = std::max(1U, getNumWorkers() * 4);
+			UINT32 chunkSize = std::max(std::max(granularity, 1U), (count + maxChunks - 1) / maxChunks);
+
+			if (chunkSize >= count)
+			{
+				body(begin, end);
+				return;
+			}
+
+			// Queue all but the first chunk, which is executed on the calling thread
+			TaskGroup group;
+			UINT32 numQueued = 0;
+			UINT32 chunkBegin = begin + chunkSize;
+			while (chunkBegin < end)
+			{
+				UINT32 chunkEnd = chunkBegin + std::min(chunkSize, end - chunkBegin);
+				queueJob(createJob([&body, chunkBegin, chunkEnd]() { body(chunkBegin, chunkEnd); }, &group),
+					TaskPriority::Normal);
+
+				chunkBegin = chunkEnd;
+				numQueued++;
+			}
+
+			wakeWorkers(numQueued);
+
+			body(begin, begin + chunkSize);
+			waitUntilComplete(group);
+		}
+
+		/**
+		 * Blocks the calling thread until all jobs in the group complete. While waiting the calling thread executes
+		 * queued jobs from the group, but no other jobs, so a caller holding locks or deep within a call stack doesn't
+		 * re-enter unrelated work.
+		 */
+		void waitUntilComplete(TaskGroup& group);
+
 		/**	Adds a new worker thread which will be used for executing queued tasks. */
 		void addWorker();
 
@@ -107,34 +300,124 @@ namespace bs
 		void removeWorker();
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
-		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+		UINT32 getNumWorkers() const { return mNumActiveWorkers.load(std::memory_order_relaxed); }
+
+		/**
+		 * Maximum number of worker threads the scheduler will start. Threads blocked waiting on jobs lend their core to
+		 * an extra worker, so the number of workers can grow past the number of logical cores up to this limit.
+		 */
+		static const UINT32 MAX_WORKERS = 64;
+
 	protected:
 		friend class Task;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		static const UINT32 JOB_POOL_SIZE = 4096;
+		static const UINT32 INVALID_INDEX = (UINT32)-1;
+
+		/** Allocates a job from the job pool and initializes it with the provided callable. */
+		template<class F>
+		Job* createJob(F&& func, TaskGroup* group)
+		{
+			Job* job = allocJob();
+			JobCallable<typename std::decay<F>::type>::create(job, std::forward<F>(func));
+			job->group = group;
+			job->task = nullptr;
+
+			if (group != nullptr)
+				group->mNumPending.fetch_add(1, std::memory_order_relaxed);
+
+			mNumPendingJobs.fetch_add(1, std::memory_order_relaxed);
+			return job;
+		}
+
+		/**
+		 * Retrieves a free job from the job pool. If the pool is exhausted a new job is allocated on the heap instead. Job
+		 * callable needs to be initialized by the caller.
+		 */
+		Job* allocJob();
+
+		/** Destroys the job callable and returns the job to the pool. */
+		void freeJob(Job* job);
+
+		/**
+		 * Pushes a job of normal priority onto the current worker's queue. Jobs of other priorities, or jobs queued from
+		 * threads that aren't workers, are pushed to the front (above normal priority) or the back of the shared queue.
+		 * Does not wake up any workers.
+		 */
+		void queueJob(Job* job, TaskPriority priority);
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/** Wakes up sleeping workers (or starts new workers if required) in order to process newly queued jobs. */
+		void wakeWorkers(UINT32 numJobs);
+
+		/**
+		 * Attempts to retrieve a job to execute, first from the worker's own queue, then from the shared queue and finally
+		 * by stealing from other workers. Returns null if no jobs are available.
+		 *
+		 * @param[in]	workerIdx	Index of the worker looking for the job, or INVALID_INDEX if called from a thread that
+		 *							isn't a worker.
+		 */
+		Job* findJob(UINT32 workerIdx);
+
+		/**
+		 * Attempts to retrieve a job that is being waited on, either a job from @p group, or a job running @p task or
+		 * one of its dependencies. Only the bottom of the worker's own queue and the shared queue are searched, jobs in
+		 * other workers' queues are left to those workers. Returns null if no such jobs are available.
+		 *
+		 * @param[in]	workerIdx	Index of the worker looking for the job, or INVALID_INDEX if called from a thread that
+		 *							isn't a worker.
+		 * @param[in]	group		Group whose jobs to look for, or null.
+		 * @param[in]	task		Task whose job, or jobs of its dependencies, to look for, or null.
+		 */
+		Job* findWaitedJob(UINT32 workerIdx, const TaskGroup* group, const Task* task);
+
+		/** Removes the job at the front of the shared queue. Returns null if the queue is empty. */
+		Job* popSharedJob();
+
+		/** Executes the job, releases it, and notifies its group if this was the groups last job. */
+		void executeJob(Job* job);
+
+		/**	Main method ran by each worker thread. */
+		void runWorker(UINT32 workerIdx);
+
+		/** Queues a job that runs the provided task. Task dependency must have completed. */
+		void queueTask(const SPtr<Task>& task);
+
+		/**	Executes the task, marks it as complete and queues any tasks depending on it. */
+		void runTask(const SPtr<Task>& task);
 
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
 
-		/**	Method used for sorting tasks. */
-		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
+		/** Returns the index of the worker the calling thread belongs to, or INVALID_INDEX if it's not a worker thread. */
+		static UINT32 getCurrentWorkerIdx();
 
-		HThread mTaskSchedulerThread;
-		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks;
-		UINT32 mNextTaskId;
+		// Workers
+		Worker* mWorkers[MAX_WORKERS];
+		std::atomic<UINT32> mNumSpawnedWorkers;
+		std::atomic<UINT32> mNumActiveWorkers;
+		std::atomic<UINT32> mNumSleepingWorkers;
 		bool mShutdown;
 
-		Mutex mReadyMutex;
+		Mutex mWorkerMutex;
+
+		// Jobs
+		Job* mJobPool;
+		std::atomic<UINT64> mFreeJobHead; /**< Index of the first free job in low 32 bits, ABA tag in high 32 bits. */
+		std::atomic<UINT32> mNumQueuedJobs;
+		std::atomic<UINT32> mNumPendingJobs;
+
+		// Shared queue for jobs queued from outside of worker threads, as a ring buffer
+		Vector<Job*> mSharedQueue;
+		UINT32 mSharedQueueStart;
+		std::atomic<UINT32> mSharedQueueSize;
+		std::atomic<UINT32> mNumHighPriorityJobs; /**< Number of above normal priority jobs at the shared queue front. */
+		SpinLock mSharedQueueLock;
+
+		// Task & group completion
+		std::atomic<UINT32> mNumCompletionWaiters;
 		Mutex mCompleteMutex;
-		Signal mTaskReadyCond;
 		Signal mTaskCompleteCond;
 	};
 
 	/** @} */
-}
\ No newline at end of file
+}
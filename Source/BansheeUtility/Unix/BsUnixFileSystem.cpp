@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -121,6 +123,12 @@ namespace bs
 	{
 		String pathString = path.toString();
 
+		if (!unix_pathExists(pathString) || !unix_isFile(pathString))
+		{
+			LOGWRN("Attempting to open a file that doesn't exist: " + pathString);
+			return nullptr;
+		}
+
 		DataStream::AccessMode accessMode = DataStream::READ;
 		if (!readOnly)
 			accessMode = (DataStream::AccessMode)(accessMode | (UINT32)DataStream::WRITE);
@@ -128,6 +136,59 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, accessMode, true);
 	}
 
+	SPtr<DataStream> FileSystem::openMappedFile(const Path& path)
+	{
+		String pathString = path.toString();
+
+		int fd = open(pathString.c_str(), O_RDONLY);
+		if (fd == -1)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		struct stat st_buf;
+		if (fstat(fd, &st_buf) != 0)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			close(fd);
+			return nullptr;
+		}
+
+		size_t size = (size_t)st_buf.st_size;
+		void* data = nullptr;
+
+		// Private mapping ensures any writes to the memory are never written back to the file
+		if (size > 0)
+		{
+			data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED)
+			{
+				HANDLE_PATH_ERROR(pathString, errno);
+				close(fd);
+				return nullptr;
+			}
+		}
+
+		// Mapping remains valid after the descriptor is closed
+		close(fd);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(path, data, size);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			// Streams referencing another stream's mapping leave the unmapping to it
+			if (mParent == nullptr)
+				munmap(mData, mSize);
+
+			mParent = nullptr;
+			mData = mPos = mEnd = nullptr;
+		}
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& path)
 	{
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
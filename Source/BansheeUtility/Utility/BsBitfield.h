@@ -0,0 +1,132 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Dynamically sized array of bits. Bits are packed into 64-bit words which can be accessed directly, allowing
+	 * operations on many bits at once. Multiple threads may write to the bitfield at once as long as they write to
+	 * different words.
+	 */
+	class Bitfield
+	{
+	public:
+		static const UINT32 BITS_PER_WORD = 64;
+		static const UINT32 BITS_PER_WORD_LOG2 = 6;
+
+		Bitfield() = default;
+
+		Bitfield(UINT32 count, bool value = false)
+		{
+			assign(count, value);
+		}
+
+		/** Returns the value of the bit at the specified index. */
+		bool operator[](UINT32 idx) const
+		{
+			assert(idx < mNumBits);
+
+			return (mWords[idx >> BITS_PER_WORD_LOG2] & getBitMask(idx)) != 0;
+		}
+
+		/** Sets the bit at the specified index to the provided value. */
+		void set(UINT32 idx, bool value = true)
+		{
+			assert(idx < mNumBits);
+
+			if (value)
+				mWords[idx >> BITS_PER_WORD_LOG2] |= getBitMask(idx);
+			else
+				mWords[idx >> BITS_PER_WORD_LOG2] &= ~getBitMask(idx);
+		}
+
+		/** Resizes the bitfield to @p count bits and sets all of them to the provided value. */
+		void assign(UINT32 count, bool value)
+		{
+			mNumBits = count;
+			mWords.assign(getNumWords(count), value ? ~0ULL : 0ULL);
+
+			clearUnusedBits();
+		}
+
+		/** Resizes the bitfield to @p count bits. If the bitfield grows, new bits are initialized to @p value. */
+		void resize(UINT32 count, bool value = false)
+		{
+			UINT32 oldNumBits = mNumBits;
+
+			mNumBits = count;
+			mWords.resize(getNumWords(count), value ? ~0ULL : 0ULL);
+
+			if (value && count > oldNumBits && (oldNumBits & (BITS_PER_WORD - 1)) != 0)
+				mWords[oldNumBits >> BITS_PER_WORD_LOG2] |= ~0ULL << (oldNumBits & (BITS_PER_WORD - 1));
+
+			clearUnusedBits();
+		}
+
+		/** Removes all bits from the bitfield. */
+		void clear()
+		{
+			mNumBits = 0;
+			mWords.clear();
+		}
+
+		/** Returns the number of bits in the bitfield. */
+		UINT32 size() const { return mNumBits; }
+
+		/** Returns the number of words used for storing the bits. */
+		UINT32 getNumWords() const { return (UINT32)mWords.size(); }
+
+		/**
+		 * Returns the internal words the bits are stored in. Bit with index @p i is stored in word i / BITS_PER_WORD, at
+		 * bit position i % BITS_PER_WORD. Bits past size() in the last word must be left unset.
+		 */
+		UINT64* getWords() { return mWords.data(); }
+
+		/** @copydoc getWords() */
+		const UINT64* getWords() const { return mWords.data(); }
+
+		/** Sets all the bits that are set in @p other. Both bitfields must be of the same size. */
+		Bitfield& operator|=(const Bitfield& other)
+		{
+			assert(mNumBits == other.mNumBits);
+
+			for (UINT32 i = 0; i < (UINT32)mWords.size(); i++)
+				mWords[i] |= other.mWords[i];
+
+			return *this;
+		}
+
+		/** Returns the number of words required for storing the provided number of bits. */
+		static UINT32 getNumWords(UINT32 numBits)
+		{
+			return (numBits + BITS_PER_WORD - 1) >> BITS_PER_WORD_LOG2;
+		}
+
+	private:
+		/** Returns a mask with only the bit at the specified index set, relative to the word the bit is stored in. */
+		static UINT64 getBitMask(UINT32 idx)
+		{
+			return 1ULL << (idx & (BITS_PER_WORD - 1));
+		}
+
+		/** Ensures bits in the last word past the bitfield size are unset. */
+		void clearUnusedBits()
+		{
+			UINT32 numUsedBits = mNumBits & (BITS_PER_WORD - 1);
+			if (numUsedBits != 0)
+				mWords.back() &= (1ULL << numUsedBits) - 1;
+		}
+
+		Vector<UINT64> mWords;
+		UINT32 mNumBits = 0;
+	};
+
+	/** @} */
+}
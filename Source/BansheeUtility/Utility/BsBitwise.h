@@ -4,6 +4,10 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 
+#if BS_COMPILER == BS_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
 namespace bs 
 {
 	/** @addtogroup General
@@ -73,6 +77,28 @@ namespace bs
 			return result - 1;
 		}
 
+		/** Returns the index of the least significant bit set in a value. Value must not be zero. */
+		static UINT32 leastSignificantBitSet(UINT64 value)
+		{
+			assert(value != 0);
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+			unsigned long index;
+#	if BS_ARCH_TYPE == BS_ARCHITECTURE_x86_64
+			_BitScanForward64(&index, value);
+#	else
+			if (!_BitScanForward(&index, (unsigned long)value))
+			{
+				_BitScanForward(&index, (unsigned long)(value >> 32));
+				index += 32;
+			}
+#	endif
+			return (UINT32)index;
+#else
+			return (UINT32)__builtin_ctzll(value);
+#endif
+		}
+
 		/** Returns the power-of-two number greater or equal to the provided value. */
 		static UINT32 nextPow2(UINT32 n)
 		{
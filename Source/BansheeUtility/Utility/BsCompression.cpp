@@ -21,6 +21,8 @@ namespace bs
 
 			if (mStream->isFile())
 				mReadBuffer = (char*)bs_alloc(2048);
+			else // Memory streams are read directly, starting at their current position
+				mBufferOffset = mStream->tell();
 		}
 
 		virtual ~DataStreamSource()
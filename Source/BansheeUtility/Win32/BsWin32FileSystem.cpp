@@ -283,6 +283,70 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, accessMode, true);
 	}
 
+	SPtr<DataStream> FileSystem::openMappedFile(const Path& fullPath)
+	{
+		WString pathWString = fullPath.toWString();
+		const wchar_t* pathString = pathWString.c_str();
+
+		HANDLE fileHandle = CreateFileW(pathString, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize))
+		{
+			win32_handleError(GetLastError(), pathWString);
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+		size_t size = (size_t)fileSize.QuadPart;
+		void* data = nullptr;
+
+		// Copy-on-write mapping ensures any writes to the memory are never written back to the file
+		if (size > 0)
+		{
+			HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if (mappingHandle != nullptr)
+				data = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+
+			if (data == nullptr)
+			{
+				win32_handleError(GetLastError(), pathWString);
+
+				if (mappingHandle != nullptr)
+					CloseHandle(mappingHandle);
+
+				CloseHandle(fileHandle);
+				return nullptr;
+			}
+
+			// View remains valid after the mapping handle is closed
+			CloseHandle(mappingHandle);
+		}
+
+		CloseHandle(fileHandle);
+
+		return bs_shared_ptr_new<MappedFileDataStream>(fullPath, data, size);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			// Streams referencing another stream's mapping leave the unmapping to it
+			if (mParent == nullptr)
+				UnmapViewOfFile(mData);
+
+			mParent = nullptr;
+			mData = mPos = mEnd = nullptr;
+		}
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& fullPath)
 	{
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
@@ -8,6 +8,7 @@
 #include "FileSystem/BsFileSystem.h"
 #include "Resources/BsResources.h"
 #include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourceArchive.h"
 #include "Scene/BsPrefab.h"
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsSceneManager.h"
@@ -141,6 +142,14 @@ void runApplication()
 		gResources().registerResourceManifest(manifest);
 	}
 
+	Path resourceArchivePath = resourcesPath + GAME_RESOURCE_ARCHIVE_NAME;
+	if (FileSystem::exists(resourceArchivePath))
+	{
+		SPtr<ResourceArchive> archive = ResourceArchive::open(resourceArchivePath);
+		if (archive != nullptr)
+			gResources().registerResourceArchive(archive);
+	}
+
 	{
 		HPrefab mainScene = static_resource_cast<Prefab>(gResources().loadFromUUID(gameSettings->mainSceneUUID, 
 			false, ResourceLoadFlag::LoadDependencies));
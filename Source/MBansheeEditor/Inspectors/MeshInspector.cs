@@ -25,6 +25,8 @@ namespace BansheeEditor
         private GUIEnumField collisionMeshTypeField;
         private GUIToggleField keyFrameReductionField;
         private GUIToggleField rootMotionField;
+        private GUIToggleField compressionField;
+        private GUIFloatField compressionToleranceField;
         private GUIArrayField<AnimationSplitInfo, AnimSplitArrayRow> animSplitInfoField;
         private GUIButton reimportButton;
 
@@ -58,6 +60,8 @@ namespace BansheeEditor
             collisionMeshTypeField.Value = (ulong)newImportOptions.CollisionMeshType;
             keyFrameReductionField.Value = newImportOptions.KeyframeReduction;
             rootMotionField.Value = newImportOptions.ImportRootMotion;
+            compressionField.Value = newImportOptions.AnimationCompression;
+            compressionToleranceField.Value = newImportOptions.AnimationCompressionTolerance;
 
             importOptions = newImportOptions;
 
@@ -81,6 +85,8 @@ namespace BansheeEditor
             collisionMeshTypeField = new GUIEnumField(typeof(CollisionMeshType), new LocEdString("Collision mesh"));
             keyFrameReductionField = new GUIToggleField(new LocEdString("Keyframe Reduction"));
             rootMotionField = new GUIToggleField(new LocEdString("Import root motion"));
+            compressionField = new GUIToggleField(new LocEdString("Compress animation"));
+            compressionToleranceField = new GUIFloatField(new LocEdString("Compression tolerance"));
             reimportButton = new GUIButton(new LocEdString("Reimport"));
 
             normalsField.OnChanged += x => importOptions.ImportNormals = x;
@@ -93,6 +99,8 @@ namespace BansheeEditor
             collisionMeshTypeField.OnSelectionChanged += x => importOptions.CollisionMeshType = (CollisionMeshType)x;
             keyFrameReductionField.OnChanged += x => importOptions.KeyframeReduction = x;
             rootMotionField.OnChanged += x => importOptions.ImportRootMotion = x;
+            compressionField.OnChanged += x => importOptions.AnimationCompression = x;
+            compressionToleranceField.OnChanged += x => importOptions.AnimationCompressionTolerance = x;
 
             reimportButton.OnClick += TriggerReimport;
 
@@ -106,6 +114,8 @@ namespace BansheeEditor
             Layout.AddElement(collisionMeshTypeField);
             Layout.AddElement(keyFrameReductionField);
             Layout.AddElement(rootMotionField);
+            Layout.AddElement(compressionField);
+            Layout.AddElement(compressionToleranceField);
 
             splitInfos = importOptions.AnimationClipSplits;
 
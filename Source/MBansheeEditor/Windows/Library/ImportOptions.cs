@@ -298,6 +298,28 @@ namespace BansheeEditor
             set { Internal_SetRootMotion(mCachedPtr, value); }
         }
 
+        /// <summary>
+        /// Determines if animation compression is enabled. When enabled, position, rotation and scale curves of imported
+        /// animation clips will be stored in a compressed form, with keyframes that can be reconstructed from their
+        /// neighbours removed and the remaining keyframes quantized. This significantly reduces the memory used by the
+        /// clip, at the cost of small errors in the animation.
+        /// </summary>
+        public bool AnimationCompression
+        {
+            get { return Internal_GetAnimationCompression(mCachedPtr); }
+            set { Internal_SetAnimationCompression(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Determines the maximum error allowed when compressing animation curves. Higher values result in smaller clips
+        /// but less accurate animation. Only relevant if <see cref="AnimationCompression"/> is enabled.
+        /// </summary>
+        public float AnimationCompressionTolerance
+        {
+            get { return Internal_GetAnimationCompressionTolerance(mCachedPtr); }
+            set { Internal_SetAnimationCompressionTolerance(mCachedPtr, value); }
+        }
+
         /// <summary>
         /// Controls what type (if any) of collision mesh should be imported.
         /// </summary>
@@ -378,6 +400,18 @@ namespace BansheeEditor
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void Internal_SetRootMotion(IntPtr thisPtr, bool value);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_GetAnimationCompression(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetAnimationCompression(IntPtr thisPtr, bool value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern float Internal_GetAnimationCompressionTolerance(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_SetAnimationCompressionTolerance(IntPtr thisPtr, float value);
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern AnimationSplitInfo[] Internal_GetAnimationClipSplits(IntPtr thisPtr);
 
@@ -247,7 +247,8 @@ namespace BansheeEngine
 	{
 		Box,
 		Triangle,
-		Kaiser
+		Kaiser,
+		Lanczos
 	};
 
     /// <summary>
@@ -265,7 +265,7 @@ namespace bs { namespace ct
 		THROW_IF_NOT_CORE_THREAD;
 
 		gProfilerGPU().beginFrame();
-		gProfilerCPU().beginSample("renderAllCore");
+		gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("renderAllCore"));
 
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 
@@ -274,6 +274,9 @@ namespace bs { namespace ct
 		// are actually modified after sync
 		mScene->refreshSamplerOverrides();
 
+		// Rebuild culling hierarchies for static objects, if needed
+		mScene->updateCullingHierarchies();
+
 		// Update global per-frame hardware buffers
 		mObjectRenderer->setParamFrameParams(timings.time);
 
@@ -323,7 +326,7 @@ namespace bs { namespace ct
 				RenderAPI::instance().swapBuffers(rtInfo.target);
 		}
 
-		gProfilerCPU().endSample("renderAllCore");
+		gProfilerCPU().endSample(PROFILE_SAMPLE_ID("renderAllCore"));
 	}
 
 	void RenderBeast::renderViews(RendererViewGroup& viewGroup, const FrameInfo& frameInfo)
@@ -360,7 +363,7 @@ namespace bs { namespace ct
 
 	void RenderBeast::renderView(const RendererViewGroup& viewGroup, RendererView& view, const FrameInfo& frameInfo)
 	{
-		gProfilerCPU().beginSample("Render");
+		gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("Render"));
 
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 		auto& viewProps = view.getProperties();
@@ -405,12 +408,12 @@ namespace bs { namespace ct
 
 		view.endFrame();
 
-		gProfilerCPU().endSample("Render");
+		gProfilerCPU().endSample(PROFILE_SAMPLE_ID("Render"));
 	}
 
 	void RenderBeast::renderOverlay(RendererView& view)
 	{
-		gProfilerCPU().beginSample("RenderOverlay");
+		gProfilerCPU().beginSample(PROFILE_SAMPLE_ID("RenderOverlay"));
 
 		view.getPerViewBuffer()->flushToGPU();
 		view.beginFrame();
@@ -460,7 +463,7 @@ namespace bs { namespace ct
 
 		view.endFrame();
 
-		gProfilerCPU().endSample("RenderOverlay");
+		gProfilerCPU().endSample(PROFILE_SAMPLE_ID("RenderOverlay"));
 	}
 	
 	void RenderBeast::updateReflProbeArray()
@@ -547,6 +550,8 @@ namespace bs { namespace ct
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 		auto& texProps = cubemap->getProperties();
 
+		mScene->updateCullingHierarchies();
+
 		Matrix4 projTransform = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.05f, 1000.0f);
 		ConvexVolume localFrustum(projTransform);
 		RenderAPI::instance().convertProjectionMatrix(projTransform, projTransform);
@@ -0,0 +1,27 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsRenderBeastPrerequisites.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Testing/BsCullBenchmarkSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(TaskScheduler::MAX_WORKERS + 16);
+	TaskScheduler::startUp();
+
+	SPtr<TestSuite> benchmarks = ct::CullBenchmarkSuite::create<ct::CullBenchmarkSuite>();
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
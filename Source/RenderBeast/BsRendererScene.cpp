@@ -109,6 +109,16 @@ namespace bs {	namespace ct
 		updateCameraRenderTargets(camera, true);
 	}
 
+	/** Returns information required for culling the provided radial or spot light. */
+	static CullInfo getLightCullInfo(Light* light)
+	{
+		Sphere sphere = light->getBounds();
+		Vector3 extents(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+		AABox box(sphere.getCenter() - extents, sphere.getCenter() + extents);
+
+		return CullInfo(Bounds(box, sphere), (UINT64)-1, light->getMobility());
+	}
+
 	void RendererScene::registerLight(Light* light)
 	{
 		if (light->getType() == LightType::Directional)
@@ -126,7 +136,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.radialLights.push_back(RendererLight(light));
-				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightWorldBounds.add(getLightCullInfo(light));
 			}
 			else // Spot
 			{
@@ -134,7 +144,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.spotLights.push_back(RendererLight(light));
-				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightWorldBounds.add(getLightCullInfo(light));
 			}
 		}
 	}
@@ -144,9 +154,9 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
-			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			mInfo.radialLightWorldBounds.setBounds(lightId, getLightCullInfo(light).bounds);
 		else if(light->getType() == LightType::Spot)
-			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			mInfo.spotLightWorldBounds.setBounds(lightId, getLightCullInfo(light).bounds);
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -178,14 +188,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.radialLights[lightId], mInfo.radialLights[lastLightId]);
-					std::swap(mInfo.radialLightWorldBounds[lightId], mInfo.radialLightWorldBounds[lastLightId]);
+					mInfo.radialLightWorldBounds.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
-				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightWorldBounds.removeLast();
 			}
 			else // Spot
 			{
@@ -196,14 +206,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.spotLights[lightId], mInfo.spotLights[lastLightId]);
-					std::swap(mInfo.spotLightWorldBounds[lightId], mInfo.spotLightWorldBounds[lastLightId]);
+					mInfo.spotLightWorldBounds.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
-				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightWorldBounds.removeLast();
 			}
 		}
 	}
@@ -215,7 +225,8 @@ namespace bs {	namespace ct
 		renderable->setRendererId(renderableId);
 
 		mInfo.renderables.push_back(bs_new<RendererObject>());
-		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullInfos.add(CullInfo(renderable->getBounds(), renderable->getLayer(), 
+			renderable->getMobility()));
 
 		RendererObject* rendererObject = mInfo.renderables.back();
 		rendererObject->renderable = renderable;
@@ -339,7 +350,7 @@ namespace bs {	namespace ct
 		UINT32 renderableId = renderable->getRendererId();
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
-		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullInfos.setBounds(renderableId, renderable->getBounds());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -372,7 +383,7 @@ namespace bs {	namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
-			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			mInfo.renderableCullInfos.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
 
@@ -382,7 +393,7 @@ namespace bs {	namespace ct
 
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
-		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullInfos.removeLast();
 
 		bs_delete(rendererObject);
 	}
@@ -490,6 +501,13 @@ namespace bs {	namespace ct
 		mInfo.lightProbes.updateProbes();
 	}
 
+	void RendererScene::updateCullingHierarchies()
+	{
+		mInfo.renderableCullInfos.optimize();
+		mInfo.radialLightWorldBounds.optimize();
+		mInfo.spotLightWorldBounds.optimize();
+	}
+
 	void RendererScene::registerSkybox(Skybox* skybox)
 	{
 		mInfo.skybox = skybox;
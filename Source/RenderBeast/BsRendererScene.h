@@ -35,14 +35,14 @@ namespace bs
 		
 		// Renderables
 		Vector<RendererObject*> renderables;
-		Vector<CullInfo> renderableCullInfos;
+		CullInfoArray renderableCullInfos;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
 		Vector<RendererLight> radialLights;
 		Vector<RendererLight> spotLights;
-		Vector<Sphere> radialLightWorldBounds;
-		Vector<Sphere> spotLightWorldBounds;
+		CullInfoArray radialLightWorldBounds;
+		CullInfoArray spotLightWorldBounds;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
@@ -122,6 +122,12 @@ namespace bs
 		 */
 		void updateLightProbes();
 
+		/** 
+		 * Rebuilds hierarchies used for culling static objects, if they changed. Should be called once before culling. If
+		 * no change is detected since the last call, the call does nothing.
+		 */
+		void updateCullingHierarchies();
+
 		/** Registers a new sky texture in the scene. */
 		void registerSkybox(Skybox* skybox);
 
@@ -9,6 +9,12 @@
 #include "BsLightRendering.h"
 #include "Material/BsGpuParamsSet.h"
 #include "BsRendererScene.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsBitwise.h"
+
+#if BS_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace bs { namespace ct
 {
@@ -89,6 +95,338 @@ namespace bs { namespace ct
 		clearStencilValue = src.target.clearStencilValue;
 	}
 
+	/** Distance by which bounds of movable objects are enlarged, to avoid updating the hierarchy on small movements. */
+	static constexpr float DYNAMIC_CULL_TREE_MARGIN = 0.25f;
+
+	/** Minimum number of objects for which to perform precise culling on a single job. */
+	static constexpr UINT32 CULL_OBJECTS_PER_JOB = 1024;
+
+	CullInfoArray::CullInfoArray()
+		:mDynamicTree(DYNAMIC_CULL_TREE_MARGIN)
+	{ }
+
+	void CullInfoArray::add(const CullInfo& cullInfo)
+	{
+		UINT32 idx = size();
+
+		mSphereX.push_back(0.0f);
+		mSphereY.push_back(0.0f);
+		mSphereZ.push_back(0.0f);
+		mSphereRadius.push_back(0.0f);
+
+		mBoxCenterX.push_back(0.0f);
+		mBoxCenterY.push_back(0.0f);
+		mBoxCenterZ.push_back(0.0f);
+		mBoxExtentX.push_back(0.0f);
+		mBoxExtentY.push_back(0.0f);
+		mBoxExtentZ.push_back(0.0f);
+
+		mLayers.push_back(cullInfo.layer);
+
+		bool isStatic = cullInfo.mobility != ObjectMobility::Movable;
+		AABoxTree& tree = isStatic ? mStaticTree : mDynamicTree;
+
+		mTreeLeaves.push_back(tree.add(cullInfo.bounds.getBox(), idx));
+		mIsStatic.push_back(isStatic);
+
+		if (isStatic)
+			mStaticTreeDirty = true;
+
+		setBounds(idx, cullInfo.bounds);
+	}
+
+	void CullInfoArray::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		const Sphere& sphere = bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+
+		mSphereX[idx] = sphereCenter.x;
+		mSphereY[idx] = sphereCenter.y;
+		mSphereZ[idx] = sphereCenter.z;
+		mSphereRadius[idx] = sphere.getRadius();
+
+		const AABox& box = bounds.getBox();
+		Vector3 boxCenter = box.getCenter();
+		Vector3 boxExtents = box.getHalfSize();
+
+		mBoxCenterX[idx] = boxCenter.x;
+		mBoxCenterY[idx] = boxCenter.y;
+		mBoxCenterZ[idx] = boxCenter.z;
+		mBoxExtentX[idx] = Math::abs(boxExtents.x);
+		mBoxExtentY[idx] = Math::abs(boxExtents.y);
+		mBoxExtentZ[idx] = Math::abs(boxExtents.z);
+
+		if (mIsStatic[idx])
+		{
+			if (mStaticTree.update(mTreeLeaves[idx], box))
+				mStaticTreeDirty = true;
+		}
+		else
+			mDynamicTree.update(mTreeLeaves[idx], box);
+	}
+
+	void CullInfoArray::swap(UINT32 idxA, UINT32 idxB)
+	{
+		std::swap(mSphereX[idxA], mSphereX[idxB]);
+		std::swap(mSphereY[idxA], mSphereY[idxB]);
+		std::swap(mSphereZ[idxA], mSphereZ[idxB]);
+		std::swap(mSphereRadius[idxA], mSphereRadius[idxB]);
+
+		std::swap(mBoxCenterX[idxA], mBoxCenterX[idxB]);
+		std::swap(mBoxCenterY[idxA], mBoxCenterY[idxB]);
+		std::swap(mBoxCenterZ[idxA], mBoxCenterZ[idxB]);
+		std::swap(mBoxExtentX[idxA], mBoxExtentX[idxB]);
+		std::swap(mBoxExtentY[idxA], mBoxExtentY[idxB]);
+		std::swap(mBoxExtentZ[idxA], mBoxExtentZ[idxB]);
+
+		std::swap(mLayers[idxA], mLayers[idxB]);
+		std::swap(mTreeLeaves[idxA], mTreeLeaves[idxB]);
+
+		bool isStaticA = mIsStatic[idxA];
+		mIsStatic[idxA] = mIsStatic[idxB];
+		mIsStatic[idxB] = isStaticA;
+
+		// Hierarchy leaves reference objects by index, so they need to be updated as well
+		(mIsStatic[idxA] ? mStaticTree : mDynamicTree).setUserData(mTreeLeaves[idxA], idxA);
+		(mIsStatic[idxB] ? mStaticTree : mDynamicTree).setUserData(mTreeLeaves[idxB], idxB);
+	}
+
+	void CullInfoArray::removeLast()
+	{
+		if (mIsStatic.back())
+		{
+			mStaticTree.remove(mTreeLeaves.back());
+			mStaticTreeDirty = true;
+		}
+		else
+			mDynamicTree.remove(mTreeLeaves.back());
+
+		mSphereX.pop_back();
+		mSphereY.pop_back();
+		mSphereZ.pop_back();
+		mSphereRadius.pop_back();
+
+		mBoxCenterX.pop_back();
+		mBoxCenterY.pop_back();
+		mBoxCenterZ.pop_back();
+		mBoxExtentX.pop_back();
+		mBoxExtentY.pop_back();
+		mBoxExtentZ.pop_back();
+
+		mLayers.pop_back();
+		mTreeLeaves.pop_back();
+		mIsStatic.pop_back();
+	}
+
+	void CullInfoArray::optimize()
+	{
+		if (!mStaticTreeDirty)
+			return;
+
+		mStaticTree.rebuild();
+		mStaticTreeDirty = false;
+	}
+
+	void CullInfoArray::cull(const ConvexVolume& frustum, UINT64 layers, Bitfield& visibility) const
+	{
+		assert(visibility.size() == size());
+
+		Vector<UINT32> intersecting;
+		Vector<UINT32> contained;
+		findCandidates(frustum, intersecting, contained);
+
+		// Objects fully inside the frustum only need the layer test
+		for (auto& idx : contained)
+		{
+			if ((mLayers[idx] & layers) != 0)
+				visibility.set(idx);
+		}
+
+		Vector<UINT8> visible;
+		cullObjects(frustum.getPlanes(), layers, intersecting, visible);
+
+		for (UINT32 i = 0; i < (UINT32)intersecting.size(); i++)
+		{
+			if (visible[i])
+				visibility.set(intersecting[i]);
+		}
+	}
+
+	void CullInfoArray::query(const ConvexVolume& volume, Vector<UINT32>& output) const
+	{
+		Vector<UINT32> intersecting;
+		findCandidates(volume, intersecting, output);
+
+		Vector<UINT8> visible;
+		cullObjects(volume.getPlanes(), (UINT64)-1, intersecting, visible);
+
+		for (UINT32 i = 0; i < (UINT32)intersecting.size(); i++)
+		{
+			if (visible[i])
+				output.push_back(intersecting[i]);
+		}
+	}
+
+	void CullInfoArray::findCandidates(const ConvexVolume& volume, Vector<UINT32>& intersecting, 
+		Vector<UINT32>& contained) const
+	{
+		mDynamicTree.query(volume, intersecting, contained);
+		mStaticTree.query(volume, intersecting, contained);
+	}
+
+	void CullInfoArray::cullObjects(const Vector<Plane>& planes, UINT64 layers, const Vector<UINT32>& indices, 
+		Vector<UINT8>& output) const
+	{
+		UINT32 count = (UINT32)indices.size();
+		output.resize(count);
+
+		if (count <= CULL_OBJECTS_PER_JOB)
+		{
+			cullObjectRange(planes, layers, indices.data(), count, output.data());
+			return;
+		}
+
+		// Each job writes to its own portion of the output array
+		TaskScheduler::instance().parallelFor(0, count, CULL_OBJECTS_PER_JOB, 
+			[&](UINT32 begin, UINT32 end)
+		{
+			cullObjectRange(planes, layers, indices.data() + begin, end - begin, output.data() + begin);
+		});
+	}
+
+	void CullInfoArray::cullObjectRange(const Vector<Plane>& planes, UINT64 layers, const UINT32* indices, 
+		UINT32 count, UINT8* output) const
+	{
+		UINT32 i = 0;
+
+#if BS_SSE2
+		// Test four objects at once
+		const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		for (; (i + 4) <= count; i += 4)
+		{
+			const UINT32* idx = &indices[i];
+
+			UINT32 layerMask = 0;
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if ((mLayers[idx[j]] & layers) != 0)
+					layerMask |= 1 << j;
+			}
+
+			UINT32 visibleMask = 0;
+			if (layerMask != 0)
+			{
+				// Sphere test
+				__m128 sphereX = _mm_setr_ps(mSphereX[idx[0]], mSphereX[idx[1]], mSphereX[idx[2]], mSphereX[idx[3]]);
+				__m128 sphereY = _mm_setr_ps(mSphereY[idx[0]], mSphereY[idx[1]], mSphereY[idx[2]], mSphereY[idx[3]]);
+				__m128 sphereZ = _mm_setr_ps(mSphereZ[idx[0]], mSphereZ[idx[1]], mSphereZ[idx[2]], mSphereZ[idx[3]]);
+				__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_setr_ps(mSphereRadius[idx[0]], 
+					mSphereRadius[idx[1]], mSphereRadius[idx[2]], mSphereRadius[idx[3]]));
+
+				__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (auto& plane : planes)
+				{
+					__m128 dist = _mm_mul_ps(sphereX, _mm_set1_ps(plane.normal.x));
+					dist = _mm_add_ps(dist, _mm_mul_ps(sphereY, _mm_set1_ps(plane.normal.y)));
+					dist = _mm_add_ps(dist, _mm_mul_ps(sphereZ, _mm_set1_ps(plane.normal.z)));
+					dist = _mm_sub_ps(dist, _mm_set1_ps(plane.d));
+
+					visible = _mm_and_ps(visible, _mm_cmpnlt_ps(dist, negRadius));
+				}
+
+				if (_mm_movemask_ps(visible) != 0)
+				{
+					// More precise with the box
+					__m128 centerX = _mm_setr_ps(mBoxCenterX[idx[0]], mBoxCenterX[idx[1]], mBoxCenterX[idx[2]], 
+						mBoxCenterX[idx[3]]);
+					__m128 centerY = _mm_setr_ps(mBoxCenterY[idx[0]], mBoxCenterY[idx[1]], mBoxCenterY[idx[2]], 
+						mBoxCenterY[idx[3]]);
+					__m128 centerZ = _mm_setr_ps(mBoxCenterZ[idx[0]], mBoxCenterZ[idx[1]], mBoxCenterZ[idx[2]], 
+						mBoxCenterZ[idx[3]]);
+					__m128 extentX = _mm_setr_ps(mBoxExtentX[idx[0]], mBoxExtentX[idx[1]], mBoxExtentX[idx[2]], 
+						mBoxExtentX[idx[3]]);
+					__m128 extentY = _mm_setr_ps(mBoxExtentY[idx[0]], mBoxExtentY[idx[1]], mBoxExtentY[idx[2]], 
+						mBoxExtentY[idx[3]]);
+					__m128 extentZ = _mm_setr_ps(mBoxExtentZ[idx[0]], mBoxExtentZ[idx[1]], mBoxExtentZ[idx[2]], 
+						mBoxExtentZ[idx[3]]);
+
+					for (auto& plane : planes)
+					{
+						__m128 normalX = _mm_set1_ps(plane.normal.x);
+						__m128 normalY = _mm_set1_ps(plane.normal.y);
+						__m128 normalZ = _mm_set1_ps(plane.normal.z);
+
+						__m128 dist = _mm_mul_ps(centerX, normalX);
+						dist = _mm_add_ps(dist, _mm_mul_ps(centerY, normalY));
+						dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, normalZ));
+						dist = _mm_sub_ps(dist, _mm_set1_ps(plane.d));
+
+						__m128 radius = _mm_mul_ps(extentX, _mm_and_ps(normalX, signMask));
+						radius = _mm_add_ps(radius, _mm_mul_ps(extentY, _mm_and_ps(normalY, signMask)));
+						radius = _mm_add_ps(radius, _mm_mul_ps(extentZ, _mm_and_ps(normalZ, signMask)));
+
+						__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+						visible = _mm_and_ps(visible, _mm_cmpnlt_ps(dist, negRadius));
+					}
+
+					visibleMask = (UINT32)_mm_movemask_ps(visible) & layerMask;
+				}
+			}
+
+			for (UINT32 j = 0; j < 4; j++)
+				output[i + j] = (visibleMask >> j) & 1;
+		}
+#endif
+
+		// Handle the remaining objects (or all of them if vector instructions are not available)
+		for (; i < count; i++)
+		{
+			UINT32 idx = indices[i];
+			output[i] = 0;
+
+			if ((mLayers[idx] & layers) == 0)
+				continue;
+
+			bool visible = true;
+			for (auto& plane : planes)
+			{
+				float dist = mSphereX[idx] * plane.normal.x + mSphereY[idx] * plane.normal.y + 
+					mSphereZ[idx] * plane.normal.z;
+				dist -= plane.d;
+
+				if (dist < -mSphereRadius[idx])
+				{
+					visible = false;
+					break;
+				}
+			}
+
+			if (!visible)
+				continue;
+
+			// More precise with the box
+			for (auto& plane : planes)
+			{
+				float dist = mBoxCenterX[idx] * plane.normal.x + mBoxCenterY[idx] * plane.normal.y + 
+					mBoxCenterZ[idx] * plane.normal.z;
+				dist -= plane.d;
+
+				float effectiveRadius = mBoxExtentX[idx] * Math::abs(plane.normal.x);
+				effectiveRadius += mBoxExtentY[idx] * Math::abs(plane.normal.y);
+				effectiveRadius += mBoxExtentZ[idx] * Math::abs(plane.normal.z);
+
+				if (dist < -effectiveRadius)
+				{
+					visible = false;
+					break;
+				}
+			}
+
+			if (visible)
+				output[i] = 1;
+		}
+	}
+
 	RendererView::RendererView()
 		: mCamera(nullptr), mRenderSettingsHash(0), mViewIdx(-1)
 	{
@@ -175,11 +513,10 @@ namespace bs { namespace ct
 		mTransparentQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
+		Bitfield* visibility)
 	{
-		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.renderables.assign((UINT32)renderables.size(), false);
 
 		if (mRenderSettings->overlayOnly)
 			return;
@@ -187,68 +524,62 @@ namespace bs { namespace ct
 		calculateVisibility(cullInfos, mVisibility.renderables);
 
 		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		const UINT64* visibilityWords = mVisibility.renderables.getWords();
+		UINT32 numWords = mVisibility.renderables.getNumWords();
+		for(UINT32 i = 0; i < numWords; i++)
 		{
-			if (!mVisibility.renderables[i])
-				continue;
-
-			const AABox& boundingBox = cullInfos[i].bounds.getBox();
-			float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
-
-			for (auto& renderElem : renderables[i]->elements)
+			UINT64 word = visibilityWords[i];
+			while(word != 0)
 			{
-				// Note: I could keep opaque and transparent renderables in two separate arrays, so I don't need to do the
-				// check here
-				bool isTransparent = (renderElem.material->getShader()->getFlags() & (UINT32)ShaderFlags::Transparent) != 0;
-
-				if (isTransparent)
-					mTransparentQueue->add(&renderElem, distanceToCamera);
-				else
-					mOpaqueQueue->add(&renderElem, distanceToCamera);
+				UINT32 bit = Bitwise::leastSignificantBitSet(word);
+				word &= word - 1;
+
+				UINT32 idx = i * Bitfield::BITS_PER_WORD + bit;
+
+				AABox boundingBox = cullInfos.getBox(idx);
+				float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
+
+				for (auto& renderElem : renderables[idx]->elements)
+				{
+					// Note: I could keep opaque and transparent renderables in two separate arrays, so I don't need to
+					// do the check here
+					bool isTransparent = 
+						(renderElem.material->getShader()->getFlags() & (UINT32)ShaderFlags::Transparent) != 0;
+
+					if (isTransparent)
+						mTransparentQueue->add(&renderElem, distanceToCamera);
+					else
+						mOpaqueQueue->add(&renderElem, distanceToCamera);
+				}
 			}
 		}
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
-		}
+			*visibility |= mVisibility.renderables;
 
 		mOpaqueQueue->sort();
 		mTransparentQueue->sort();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
-		LightType lightType, Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererLight>& lights, const CullInfoArray& bounds, 
+		LightType lightType, Bitfield* visibility)
 	{
 		// Special case for directional lights, they're always visible
 		if(lightType == LightType::Directional)
 		{
 			if (visibility)
-				visibility->assign(lights.size(), true);
+				visibility->assign((UINT32)lights.size(), true);
 
 			return;
 		}
 
-		Vector<bool>* perViewVisibility;
+		Bitfield* perViewVisibility;
 		if(lightType == LightType::Radial)
-		{
-			mVisibility.radialLights.clear();
-			mVisibility.radialLights.resize(lights.size(), false);
-
 			perViewVisibility = &mVisibility.radialLights;
-		}
 		else // Spot
-		{
-			mVisibility.spotLights.clear();
-			mVisibility.spotLights.resize(lights.size(), false);
-
 			perViewVisibility = &mVisibility.spotLights;
-		}
+
+		perViewVisibility->assign((UINT32)lights.size(), false);
 
 		if (mRenderSettings->overlayOnly)
 			return;
@@ -256,60 +587,36 @@ namespace bs { namespace ct
 		calculateVisibility(bounds, *perViewVisibility);
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)lights.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || (*perViewVisibility)[i];
-			}
-		}
+			*visibility |= *perViewVisibility;
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const CullInfoArray& cullInfos, Bitfield& visibility) const
 	{
 		UINT64 cameraLayers = mProperties.visibleLayers;
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
-		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
-
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
-
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
+		cullInfos.cull(worldFrustum, cameraLayers, visibility);
 	}
 
-	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Bitfield& visibility) const
 	{
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
 		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
 		{
 			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
+				visibility.set(i);
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Bitfield& visibility) const
 	{
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
 		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
 		{
 			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
+				visibility.set(i);
 		}
 	}
 
@@ -567,19 +874,16 @@ namespace bs { namespace ct
 			return;
 
 		// Generate render queues per camera
-		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
-		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
+		mVisibility.renderables.assign((UINT32)sceneInfo.renderables.size(), false);
 
 		for(UINT32 i = 0; i < numViews; i++)
 			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
 
 		// Calculate light visibility for all views
 		UINT32 numRadialLights = (UINT32)sceneInfo.radialLights.size();
-		mVisibility.radialLights.resize(numRadialLights, false);
 		mVisibility.radialLights.assign(numRadialLights, false);
 
 		UINT32 numSpotLights = (UINT32)sceneInfo.spotLights.size();
-		mVisibility.spotLights.resize(numSpotLights, false);
 		mVisibility.spotLights.assign(numSpotLights, false);
 
 		for (UINT32 i = 0; i < numViews; i++)
@@ -596,7 +900,6 @@ namespace bs { namespace ct
 
 		// Calculate refl. probe visibility for all views
 		UINT32 numProbes = (UINT32)sceneInfo.reflProbes.size();
-		mVisibility.reflProbes.resize(numProbes, false);
 		mVisibility.reflProbes.assign(numProbes, false);
 
 		// Note: Per-view visibility for refl. probes currently isn't calculated
@@ -9,6 +9,8 @@
 #include "BsRendererObject.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "Math/BsAABoxTree.h"
+#include "Utility/BsBitfield.h"
 #include "Renderer/BsLight.h"
 #include "BsLightGrid.h"
 #include "BsShadowRendering.h"
@@ -184,21 +186,121 @@ namespace bs { namespace ct
 	/** Information whether certain scene objects are visible in a view, per object type. */
 	struct VisibilityInfo
 	{
-		Vector<bool> renderables;
-		Vector<bool> radialLights;
-		Vector<bool> spotLights;
-		Vector<bool> reflProbes;
+		Bitfield renderables;
+		Bitfield radialLights;
+		Bitfield spotLights;
+		Bitfield reflProbes;
 	};
 
 	/** Information used for culling an object against a view. */
 	struct CullInfo
 	{
-		CullInfo(const Bounds& bounds, UINT64 layer = -1)
-			:bounds(bounds), layer(layer)
+		CullInfo(const Bounds& bounds, UINT64 layer = -1, ObjectMobility mobility = ObjectMobility::Movable)
+			:bounds(bounds), layer(layer), mobility(mobility)
 		{ }
 
 		Bounds bounds;
 		UINT64 layer;
+		ObjectMobility mobility;
+	};
+
+	/** 
+	 * Stores culling information for a set of objects. Each component of the bounds is stored in its own contiguous array
+	 * so the culling code can test multiple objects at once using vector instructions. Objects are additionally organized
+	 * in bounding volume hierarchies so that culling cost scales with the number of objects near the culling volume,
+	 * rather than with the total number of objects. Objects that can move are kept in an incrementally updated hierarchy,
+	 * while immovable and static objects are kept in a separate hierarchy that is rebuilt by calling optimize().
+	 */
+	class CullInfoArray
+	{
+	public:
+		CullInfoArray();
+
+		/** Appends culling information for a new object to the end of the array. */
+		void add(const CullInfo& cullInfo);
+
+		/** Updates the bounds of the object at the specified index. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
+
+		/** Swaps culling information of the objects at the two provided indices. */
+		void swap(UINT32 idxA, UINT32 idxB);
+
+		/** Removes the last entry in the array. */
+		void removeLast();
+
+		/** 
+		 * Rebuilds the hierarchy containing immovable and static objects, if any such objects were added, moved or
+		 * removed since the last call. Should be called once per frame, before culling.
+		 */
+		void optimize();
+
+		/** Returns the bounding sphere of the object at the specified index. */
+		Sphere getSphere(UINT32 idx) const
+		{
+			return Sphere(Vector3(mSphereX[idx], mSphereY[idx], mSphereZ[idx]), mSphereRadius[idx]);
+		}
+
+		/** Returns the bounding box of the object at the specified index. */
+		AABox getBox(UINT32 idx) const
+		{
+			Vector3 center(mBoxCenterX[idx], mBoxCenterY[idx], mBoxCenterZ[idx]);
+			Vector3 extents(mBoxExtentX[idx], mBoxExtentY[idx], mBoxExtentZ[idx]);
+
+			return AABox(center - extents, center + extents);
+		}
+
+		/** Returns the layer bitfield of the object at the specified index. */
+		UINT64 getLayer(UINT32 idx) const { return mLayers[idx]; }
+
+		/** Returns the number of objects in the array. */
+		UINT32 size() const { return (UINT32)mLayers.size(); }
+
+		/** 
+		 * Culls all objects against the provided frustum and layer mask, and sets the bits of visible objects in the
+		 * provided bitfield. Bits of culled objects are left unchanged. Bitfield must be of the same size as the array.
+		 */
+		void cull(const ConvexVolume& frustum, UINT64 layers, Bitfield& visibility) const;
+
+		/** Finds all objects intersecting the provided volume, ignoring layers, and outputs their indices. */
+		void query(const ConvexVolume& volume, Vector<UINT32>& output) const;
+
+	private:
+		/** 
+		 * Finds objects that potentially intersect the volume by querying the hierarchies. Objects fully inside the
+		 * volume are output in @p contained, while objects that need to be tested further are output in @p intersecting.
+		 */
+		void findCandidates(const ConvexVolume& volume, Vector<UINT32>& intersecting, Vector<UINT32>& contained) const;
+
+		/** 
+		 * Tests the objects with the provided indices against the planes and the layer mask. Writes one for each visible
+		 * object and zero for each culled object in the @p output array. Large sets of objects are tested in parallel.
+		 */
+		void cullObjects(const Vector<Plane>& planes, UINT64 layers, const Vector<UINT32>& indices, 
+			Vector<UINT8>& output) const;
+
+		/** Performs the work for cullObjects() on a range of indices, on the calling thread. */
+		void cullObjectRange(const Vector<Plane>& planes, UINT64 layers, const UINT32* indices, UINT32 count, 
+			UINT8* output) const;
+
+		Vector<float> mSphereX;
+		Vector<float> mSphereY;
+		Vector<float> mSphereZ;
+		Vector<float> mSphereRadius;
+
+		Vector<float> mBoxCenterX;
+		Vector<float> mBoxCenterY;
+		Vector<float> mBoxCenterZ;
+		Vector<float> mBoxExtentX;
+		Vector<float> mBoxExtentY;
+		Vector<float> mBoxExtentZ;
+
+		Vector<UINT64> mLayers;
+
+		Vector<UINT32> mTreeLeaves;
+		Vector<bool> mIsStatic;
+		AABoxTree mDynamicTree;
+		AABoxTree mStaticTree;
+		bool mStaticTreeDirty = false;
 	};
 
 	/**	Renderer information specific to a single render target. */
@@ -269,15 +371,15 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererObject*>& renderables, const CullInfoArray& cullInfos,
+			Bitfield* visibility = nullptr);
 
 		/**
 		 * Calculates the visibility masks for all the lights of the provided type.
 		 * 
 		 * @param[in]	lights				A set of lights to determine visibility for.
-		 * @param[in]	bounds				Bounding sphere for each provided light. Must be the same size as the @p lights
-		 *									array.
+		 * @param[in]	bounds				Culling information for each provided light. Must be the same size as the
+		 *									@p lights array.
 		 * @param[in]	type				Type of all the lights in the @p lights array.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible light. If the
 		 *									bit for a light is already set to true, the method will never change it to false
@@ -287,26 +389,27 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type, 
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererLight>& lights, const CullInfoArray& bounds, LightType type, 
+			Bitfield* visibility = nullptr);
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size. Only objects in the
+		 * vicinity of the frustum are tested, and large sets of such objects are culled in parallel on the task scheduler.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullInfoArray& cullInfos, Bitfield& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
 		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
 		 */
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const Vector<Sphere>& bounds, Bitfield& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
 		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
 		 */
-		void calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const Vector<AABox>& bounds, Bitfield& visibility) const;
 
 		/** Returns the visibility mask calculated with the last call to determineVisible(). */
 		const VisibilityInfo& getVisibilityMasks() const { return mVisibility; }
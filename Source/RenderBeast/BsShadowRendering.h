@@ -583,7 +583,7 @@ namespace bs { namespace ct
 		mutable SPtr<IndexBuffer> mFrustumIB;
 		mutable SPtr<VertexBuffer> mFrustumVB;
 
-		Vector<bool> mRenderableVisibility; // Transient
+		Vector<UINT32> mShadowCasters; // Transient
 		Vector<ShadowMapOptions> mSpotLightShadowOptions; // Transient
 		Vector<ShadowMapOptions> mRadialLightShadowOptions; // Transient
 	};
@@ -43,10 +43,22 @@ set(BS_RENDERBEAST_SRC_NOFILTER
 	"BsRenderBeastIBLUtility.cpp"
 )
 
+set(BS_RENDERBEAST_INC_TESTING
+	"Testing/BsCullBenchmarkSuite.h"
+)
+
+set(BS_RENDERBEAST_SRC_TESTING
+	"Testing/BsCullBenchmarkSuite.cpp"
+)
+
 source_group("Header Files" FILES ${BS_RENDERBEAST_INC_NOFILTER})
 source_group("Source Files" FILES ${BS_RENDERBEAST_SRC_NOFILTER})
+source_group("Header Files\\Testing" FILES ${BS_RENDERBEAST_INC_TESTING})
+source_group("Source Files\\Testing" FILES ${BS_RENDERBEAST_SRC_TESTING})
 
 set(BS_RENDERBEAST_SRC
 	${BS_RENDERBEAST_INC_NOFILTER}
 	${BS_RENDERBEAST_SRC_NOFILTER}
+	${BS_RENDERBEAST_INC_TESTING}
+	${BS_RENDERBEAST_SRC_TESTING}
 )
\ No newline at end of file
@@ -0,0 +1,128 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsCullBenchmarkSuite.h"
+#include "BsRendererView.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs { namespace ct
+{
+	/** Deterministic pseudo-random number generator, so all runs cull the same scene. */
+	class BenchmarkRandom
+	{
+	public:
+		BenchmarkRandom(UINT32 seed) :mState(seed) { }
+
+		/** Returns a value in range [min, max]. */
+		float get(float min, float max)
+		{
+			mState = mState * 1664525U + 1013904223U;
+			return min + (max - min) * ((mState >> 8) / (float)(1 << 24));
+		}
+
+	private:
+		UINT32 mState;
+	};
+
+	/**
+	 * Generates bounds of objects scattered in a 2000 units large cube around the origin. Roughly one in ten objects
+	 * ends up in the benchmark frustum.
+	 */
+	static Vector<Bounds> createBounds(UINT32 numObjects)
+	{
+		BenchmarkRandom random(numObjects);
+
+		Vector<Bounds> bounds(numObjects);
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			Vector3 center(random.get(-1000.0f, 1000.0f), random.get(-1000.0f, 1000.0f), random.get(-1000.0f, 1000.0f));
+			Vector3 extents(random.get(0.5f, 5.0f), random.get(0.5f, 5.0f), random.get(0.5f, 5.0f));
+
+			bounds[i] = Bounds(AABox(center - extents, center + extents), Sphere(center, extents.length()));
+		}
+
+		return bounds;
+	}
+
+	CullBenchmarkSuite::CullBenchmarkSuite()
+	{
+		BS_ADD_TEST(CullBenchmarkSuite::benchmark10k);
+		BS_ADD_TEST(CullBenchmarkSuite::benchmark100k);
+		BS_ADD_TEST(CullBenchmarkSuite::benchmark1M);
+	}
+
+	void CullBenchmarkSuite::benchmark10k()
+	{
+		benchmarkCull(10000, 100);
+	}
+
+	void CullBenchmarkSuite::benchmark100k()
+	{
+		benchmarkCull(100000, 20);
+	}
+
+	void CullBenchmarkSuite::benchmark1M()
+	{
+		benchmarkCull(1000000, 5);
+	}
+
+	void CullBenchmarkSuite::benchmarkCull(UINT32 numObjects, UINT32 numRuns)
+	{
+		// Camera at the origin looking down the negative Z axis, so world and view space match
+		Matrix4 projection = Matrix4::projectionPerspective(Degree(90.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+		ConvexVolume frustum(projection);
+
+		Vector<Bounds> bounds = createBounds(numObjects);
+
+		// Reference: every object tested against the frustum one by one, the way renderables were culled before
+		// CullInfoArray
+		Vector<CullInfo> cullInfos;
+		cullInfos.reserve(numObjects);
+		for (auto& entry : bounds)
+			cullInfos.push_back(CullInfo(entry));
+
+		Vector<bool> referenceVisibility;
+		measure("Per object", numRuns, numObjects, [&]()
+		{
+			for (UINT32 i = 0; i < numObjects; i++)
+			{
+				if (frustum.intersects(cullInfos[i].bounds.getSphere()))
+				{
+					if (frustum.intersects(cullInfos[i].bounds.getBox()))
+						referenceVisibility[i] = true;
+				}
+			}
+		}, [&]() { referenceVisibility.assign(numObjects, false); });
+
+		UINT32 numVisible = 0;
+		for (auto entry : referenceVisibility)
+			numVisible += entry ? 1 : 0;
+
+		report("Visible objects", toString(numVisible));
+
+		cullInfos.clear();
+		cullInfos.shrink_to_fit();
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			ObjectMobility mobility = i == 0 ? ObjectMobility::Movable : ObjectMobility::Static;
+
+			CullInfoArray cullInfoArray;
+			for (auto& entry : bounds)
+				cullInfoArray.add(CullInfo(entry, (UINT64)-1, mobility));
+
+			cullInfoArray.optimize();
+
+			Bitfield visibility;
+			measure(mobility == ObjectMobility::Movable ? "CullInfoArray, movable" : "CullInfoArray, static", numRuns,
+				numObjects, [&]() { cullInfoArray.cull(frustum, (UINT64)-1, visibility); },
+				[&]() { visibility.assign(numObjects, false); });
+
+			bool matches = true;
+			for (UINT32 j = 0; j < numObjects; j++)
+				matches &= visibility[j] == referenceVisibility[j];
+
+			BS_TEST_ASSERT_MSG(matches, "CullInfoArray visibility doesn't match the per object reference.");
+		}
+	}
+}}
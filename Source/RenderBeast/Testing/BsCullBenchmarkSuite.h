@@ -0,0 +1,33 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Measures frustum culling of synthetic objects scattered around a camera, comparing CullInfoArray against testing
+	 * each object's bounds against the frustum one by one.
+	 */
+	class CullBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		CullBenchmarkSuite();
+
+	private:
+		void benchmark10k();
+		void benchmark100k();
+		void benchmark1M();
+
+		/** Culls @p numObjects objects using all available methods and reports the timings. */
+		void benchmarkCull(UINT32 numObjects, UINT32 numRuns);
+	};
+
+	/** @} */
+}}
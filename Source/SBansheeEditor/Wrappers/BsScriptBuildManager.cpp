@@ -21,6 +21,7 @@
 #include "Scene/BsSceneObject.h"
 #include "Debug/BsDebug.h"
 #include "Resources/BsGameResourceManager.h"
+#include "Resources/BsResourceArchive.h"
 
 namespace bs
 {
@@ -300,6 +301,7 @@ namespace bs
 
 		FileSystem::createDir(outputPath);
 
+		Vector<std::pair<String, Path>> packagedResources;
 		Path libraryDir = gProjectLibrary().getResourcesFolder();
 		for (auto& entry : usedResources)
 		{
@@ -365,8 +367,27 @@ namespace bs
 			}
 			else
 				FileSystem::copy(entry, destPath);
+
+			packagedResources.push_back(std::make_pair(uuid, destPath));
 		}
 
+		// Pack the resources into a single archive, so the game doesn't need to open a file for each resource it loads
+		Path archivePath = outputPath;
+		archivePath.append(GAME_RESOURCE_ARCHIVE_NAME);
+
+		ResourceArchiveBuilder archiveBuilder;
+		for (auto& entry : packagedResources)
+			archiveBuilder.addFile(entry.first, entry.second);
+
+		if (archiveBuilder.build(archivePath))
+		{
+			// Resources in the archive are found through the manifest, so the standalone files are no longer needed
+			for (auto& entry : packagedResources)
+				FileSystem::remove(entry.second);
+		}
+		else
+			LOGWRN("Unable to pack resources into an archive. The game will load them from standalone files instead.");
+
 		// Save icon
 		Path iconFolder = BuiltinResources::getIconFolder();
 
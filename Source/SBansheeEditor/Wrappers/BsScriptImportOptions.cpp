@@ -208,6 +208,10 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_SetKeyFrameReduction", &ScriptMeshImportOptions::internal_SetKeyFrameReduction);
 		metaData.scriptClass->addInternalCall("Internal_GetRootMotion", &ScriptMeshImportOptions::internal_GetRootMotion);
 		metaData.scriptClass->addInternalCall("Internal_SetRootMotion", &ScriptMeshImportOptions::internal_SetRootMotion);
+		metaData.scriptClass->addInternalCall("Internal_GetAnimationCompression", &ScriptMeshImportOptions::internal_GetAnimationCompression);
+		metaData.scriptClass->addInternalCall("Internal_SetAnimationCompression", &ScriptMeshImportOptions::internal_SetAnimationCompression);
+		metaData.scriptClass->addInternalCall("Internal_GetAnimationCompressionTolerance", &ScriptMeshImportOptions::internal_GetAnimationCompressionTolerance);
+		metaData.scriptClass->addInternalCall("Internal_SetAnimationCompressionTolerance", &ScriptMeshImportOptions::internal_SetAnimationCompressionTolerance);
 		metaData.scriptClass->addInternalCall("Internal_GetScale", &ScriptMeshImportOptions::internal_GetScale);
 		metaData.scriptClass->addInternalCall("Internal_SetScale", &ScriptMeshImportOptions::internal_SetScale);
 		metaData.scriptClass->addInternalCall("Internal_GetCollisionMeshType", &ScriptMeshImportOptions::internal_GetCollisionMeshType);
@@ -322,6 +326,26 @@ namespace bs
 		thisPtr->getMeshImportOptions()->setImportRootMotion(value);
 	}
 
+	bool ScriptMeshImportOptions::internal_GetAnimationCompression(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getAnimationCompression();
+	}
+
+	void ScriptMeshImportOptions::internal_SetAnimationCompression(ScriptMeshImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getMeshImportOptions()->setAnimationCompression(value);
+	}
+
+	float ScriptMeshImportOptions::internal_GetAnimationCompressionTolerance(ScriptMeshImportOptions* thisPtr)
+	{
+		return thisPtr->getMeshImportOptions()->getAnimationCompressionTolerance();
+	}
+
+	void ScriptMeshImportOptions::internal_SetAnimationCompressionTolerance(ScriptMeshImportOptions* thisPtr, float value)
+	{
+		thisPtr->getMeshImportOptions()->setAnimationCompressionTolerance(value);
+	}
+
 	float ScriptMeshImportOptions::internal_GetScale(ScriptMeshImportOptions* thisPtr)
 	{
 		return thisPtr->getMeshImportOptions()->getImportScale();
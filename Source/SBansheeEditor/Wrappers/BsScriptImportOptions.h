@@ -120,6 +120,10 @@ namespace bs
 		static void internal_SetKeyFrameReduction(ScriptMeshImportOptions* thisPtr, bool value);
 		static bool internal_GetRootMotion(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetRootMotion(ScriptMeshImportOptions* thisPtr, bool value);
+		static bool internal_GetAnimationCompression(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetAnimationCompression(ScriptMeshImportOptions* thisPtr, bool value);
+		static float internal_GetAnimationCompressionTolerance(ScriptMeshImportOptions* thisPtr);
+		static void internal_SetAnimationCompressionTolerance(ScriptMeshImportOptions* thisPtr, float value);
 		static float internal_GetScale(ScriptMeshImportOptions* thisPtr);
 		static void internal_SetScale(ScriptMeshImportOptions* thisPtr, float value);
 		static int internal_GetCollisionMeshType(ScriptMeshImportOptions* thisPtr);
@@ -8,31 +8,64 @@ namespace bs
 {
 	Vector<TNamedAnimationCurve<Vector3>> AnimationCurvesEx::getPositionCurves(const SPtr<AnimationCurves>& thisPtr)
 	{
-		return thisPtr->position;
+		if (!thisPtr->isCompressed())
+			return thisPtr->position;
+
+		// Restore the keyframes into a copy, so the curves themselves remain compressed
+		AnimationCurves curves;
+		curves.position = thisPtr->position;
+		thisPtr->compressed.decompress(curves);
+
+		return curves.position;
 	}
 
 	void AnimationCurvesEx::setPositionCurves(const SPtr<AnimationCurves>& thisPtr, const Vector<TNamedAnimationCurve<Vector3>>& value)
 	{
+		// Compressed data references the curves by index, so it must be dropped once the curves change. Restore the
+		// other curves first, so they don't lose their keyframes.
+		thisPtr->decompress();
 		thisPtr->position = value;
 	}
 
 	Vector<TNamedAnimationCurve<Quaternion>> AnimationCurvesEx::getRotationCurves(const SPtr<AnimationCurves>& thisPtr)
 	{
-		return thisPtr->rotation;
+		if (!thisPtr->isCompressed())
+			return thisPtr->rotation;
+
+		// Restore the keyframes into a copy, so the curves themselves remain compressed
+		AnimationCurves curves;
+		curves.rotation = thisPtr->rotation;
+		thisPtr->compressed.decompress(curves);
+
+		return curves.rotation;
 	}
 
 	void AnimationCurvesEx::setRotationCurves(const SPtr<AnimationCurves>& thisPtr, const Vector<TNamedAnimationCurve<Quaternion>>& value)
 	{
+		// Compressed data references the curves by index, so it must be dropped once the curves change. Restore the
+		// other curves first, so they don't lose their keyframes.
+		thisPtr->decompress();
 		thisPtr->rotation = value;
 	}
 
 	Vector<TNamedAnimationCurve<Vector3>> AnimationCurvesEx::getScaleCurves(const SPtr<AnimationCurves>& thisPtr)
 	{
-		return thisPtr->scale;
+		if (!thisPtr->isCompressed())
+			return thisPtr->scale;
+
+		// Restore the keyframes into a copy, so the curves themselves remain compressed
+		AnimationCurves curves;
+		curves.scale = thisPtr->scale;
+		thisPtr->compressed.decompress(curves);
+
+		return curves.scale;
 	}
 
 	void AnimationCurvesEx::setScaleCurves(const SPtr<AnimationCurves>& thisPtr, const Vector<TNamedAnimationCurve<Vector3>>& value)
 	{
+		// Compressed data references the curves by index, so it must be dropped once the curves change. Restore the
+		// other curves first, so they don't lose their keyframes.
+		thisPtr->decompress();
 		thisPtr->scale = value;
 	}
 